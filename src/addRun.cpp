@@ -31,6 +31,10 @@
 #include "config.h"
 #endif
 
+#ifdef HAVE_GOMP
+#include <omp.h>
+#endif
+
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -253,6 +257,149 @@ UInt_t addRun_getPromptPeakPos(PDoubleVector *vec)
   return pos;
 }
 
+//--------------------------------------------------------------------------
+/**
+ * <p>Reads a single run.
+ *
+ * @param info run info of the run to be read
+ * @param startupHandler startup handler (used for the data path list), may be a nullptr
+ *
+ * @return pointer to the run data handler on success, nullptr otherwise.
+ */
+PRunDataHandler* addRun_readRun(const PAddRunInfo &info, PStartupHandler *startupHandler)
+{
+  PRunDataHandler *runDataHandler{nullptr};
+
+  if (startupHandler != nullptr)
+    runDataHandler = new PRunDataHandler(info.fPathFileName, info.fFileFormat, startupHandler->GetDataPathList());
+  else
+    runDataHandler = new PRunDataHandler(info.fPathFileName, info.fFileFormat);
+  if (runDataHandler == nullptr) {
+    std::cerr << std::endl;
+    std::cerr << "**ERROR** couldn't invoke PRunDataHandler for '" << info.fPathFileName << "'." << std::endl;
+    std::cerr << std::endl;
+    return nullptr;
+  }
+
+  runDataHandler->ReadData();
+  if (!runDataHandler->IsAllDataAvailable()) {
+    std::cerr << std::endl;
+    std::cerr << "**ERROR** couldn't read data for '" << info.fPathFileName << "'." << std::endl;
+    std::cerr << std::endl;
+    delete runDataHandler;
+    return nullptr;
+  }
+
+  return runDataHandler;
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Determines the t0's of a run. If no t0's are given, they are taken from
+ * the data file. A t0 value of 0 means take it from the data file, -1 means
+ * determine it from the prompt peak.
+ *
+ * @param info run info, on return fT0 holds the t0's of all the histos
+ * @param runData raw run data of the run
+ */
+void addRun_getT0s(PAddRunInfo &info, PRawRunData *runData)
+{
+  if (info.fT0.empty()) { // i.e. take t0's from data file
+    info.fT0.resize(runData->GetNoOfHistos());
+    for (UInt_t i=0; i<runData->GetNoOfHistos(); i++) {
+      info.fT0[i] = runData->GetT0Bin(i+1);
+    }
+  } else { // t0 vector present
+    // make sure that the number of t0's fit the number of histos
+    if (info.fT0.size() < runData->GetNoOfHistos()) {
+      UInt_t counts=runData->GetNoOfHistos()-info.fT0.size();
+      for (UInt_t i=0; i<counts; i++)
+        info.fT0.push_back(0);
+    }
+    // check t0 data
+    for (UInt_t i=0; i<info.fT0.size(); i++) {
+      if (info.fT0[i] == 0) { // get t0 from file
+        info.fT0[i] = runData->GetT0Bin(i+1);
+      } else if (info.fT0[i] == -1) { // get t0 from prompt peak
+        info.fT0[i] = addRun_getPromptPeakPos(runData->GetDataSet(i, false)->GetData());
+      }
+    }
+  }
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Adds a histogram to the accumulated histogram, taking into account the t0
+ * offset between the two. Only the bins for which the shifted index is within
+ * the histogram to be added contribute. The loop is free of branches such that
+ * the compiler can vectorize it.
+ *
+ * @param acc accumulated histogram
+ * @param data histogram to be added
+ * @param diff t0 offset: t0(data) - t0(acc)
+ */
+void addRun_addHisto(PDoubleVector &acc, const PDoubleVector &data, const Int_t diff)
+{
+  Int_t start = (diff < 0) ? -diff : 0;
+  Int_t end = static_cast<Int_t>(data.size()) - diff;
+  if (end > static_cast<Int_t>(acc.size()))
+    end = static_cast<Int_t>(acc.size());
+
+  Double_t *pAcc = acc.data();
+  const Double_t *pData = data.data();
+  #ifdef HAVE_GOMP
+  #pragma omp simd
+  #endif
+  for (Int_t k=start; k<end; k++) {
+    pAcc[k] += pData[k+diff];
+  }
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Adds a run to the reference run.
+ *
+ * @param refInfo run info of the reference run
+ * @param refData raw run data of the reference run, which accumulates the histograms
+ * @param info run info of the run to be added
+ * @param runDataHandler run data handler of the run to be added
+ *
+ * @return true on success, false otherwise.
+ */
+bool addRun_addRun(const PAddRunInfo &refInfo, PRawRunData *refData, PAddRunInfo &info, PRunDataHandler *runDataHandler)
+{
+  // make sure all the runs have the same number run data (==1 here)
+  if (runDataHandler->GetNoOfRunData() != 1) {
+    std::cerr << std::endl;
+    std::cerr << "**ERROR** can only handle same number of run data per run handler." << std::endl;
+    std::cerr << std::endl;
+    return false;
+  }
+
+  PRawRunData *runData = runDataHandler->GetRunData();
+
+  // check that all runs have the same number of histograms
+  if (runData->GetNoOfHistos() != refData->GetNoOfHistos()) {
+    std::cerr << std::endl;
+    std::cerr << "**ERROR** can only add runs with the same number of histograms." << std::endl;
+    std::cerr << std::endl;
+    return false;
+  }
+
+  // get the t0's for all the histos of the run to be added
+  addRun_getT0s(info, runData);
+
+  // add all the histos, taking into account the offset due to potential differences in t0's between runs
+  #ifdef HAVE_GOMP
+  #pragma omp parallel for default(shared) schedule(dynamic)
+  #endif
+  for (Int_t j=0; j<static_cast<Int_t>(runData->GetNoOfHistos()); j++) { // loop over all histos
+    addRun_addHisto(*refData->GetDataSet(j, false)->GetData(), *runData->GetDataSet(j, false)->GetData(), info.fT0[j] - refInfo.fT0[j]);
+  }
+
+  return true;
+}
+
 //--------------------------------------------------------------------------
 /**
  * <p>Filters the t0 arguments. Allowed is a comma separeted list of
@@ -638,63 +785,31 @@ int main(int argc, char *argv[])
     std::cout << std::endl;
   }
 
-  // load the files
-  std::vector<PRunDataHandler*> runDataHandler;
-  runDataHandler.resize(addRunInfo.size());
+  // load the reference run, i.e. the first run. All other runs will be added to it
+  // on the fly, i.e. at most two additional runs are kept in memory at any time,
+  // independent of the number of runs to be added.
+  PRunDataHandler *refRunDataHandler{nullptr};
   Bool_t isGood{true};
-  for (UInt_t i=0; i<runDataHandler.size(); i++) {
-    if (startupHandler != nullptr) {
-      runDataHandler[i] = new PRunDataHandler(addRunInfo[i].fPathFileName, addRunInfo[i].fFileFormat, startupHandler->GetDataPathList());
-      if (runDataHandler[i] == nullptr) {
-        isGood = false;
-        std::cerr << std::endl;
-        std::cerr << "**ERROR** couldn't invoke PRunDataHandler (i=" << i << ")." << std::endl;
-        std::cerr << std::endl;
-        break;
-      }
-      runDataHandler[i]->ReadData();
-      if (!runDataHandler[i]->IsAllDataAvailable()) {
-        isGood = false;
-        std::cerr << std::endl;
-        std::cerr << "**ERROR** couldn't read data for PRunDataHandler (i=" << i << ")." << std::endl;
-        std::cerr << std::endl;
-        break;
-      }
-    } else {
-      runDataHandler[i] = new PRunDataHandler(addRunInfo[i].fPathFileName, addRunInfo[i].fFileFormat);
-      if (runDataHandler[i] == nullptr) {
-        isGood = false;
-        std::cerr << std::endl;
-        std::cerr << "**ERROR** couldn't invoke PRunDataHandler (i=" << i << ")." << std::endl;
-        std::cerr << std::endl;
-        break;
-      }
-      runDataHandler[i]->ReadData();
-      if (!runDataHandler[i]->IsAllDataAvailable()) {
-        isGood = false;
-        std::cerr << std::endl;
-        std::cerr << "**ERROR** couldn't read data for PRunDataHandler (i=" << i << ")." << std::endl;
-        std::cerr << std::endl;
-        break;
-      }
+  if (addRunInfo.empty()) {
+    std::cerr << std::endl;
+    std::cerr << "**ERROR** no runs to be added found." << std::endl;
+    std::cerr << std::endl;
+    isGood = false;
+  } else {
+    refRunDataHandler = addRun_readRun(addRunInfo[0], startupHandler);
+    if (refRunDataHandler == nullptr) {
+      isGood = false;
+    } else if (refRunDataHandler->GetNoOfRunData() != 1) {
+      std::cerr << std::endl;
+      std::cerr << "**ERROR** can only handle same number of run data per run handler." << std::endl;
+      std::cerr << std::endl;
+      isGood = false;
     }
   }
 
-  // make sure that the number of provided t0's are matching the number of histos from the run-file
-
-  // 1st make sure all the runs have the same number run data (==1 here)
   PAny2ManyInfo *info{nullptr};
   PRunDataHandler *dataOut{nullptr};
   if (isGood) {
-    for (UInt_t i=1; i<runDataHandler.size(); i++) {
-      if (runDataHandler[0]->GetNoOfRunData() != runDataHandler[i]->GetNoOfRunData()) {
-        isGood = false;
-        std::cerr << std::endl;
-        std::cerr << "**ERROR** can only handle same number of run data per run handler." << std::endl;
-        std::cerr << std::endl;
-        break;
-      }
-    }
     info = new PAny2ManyInfo();
     if (info == nullptr) {
       std::cerr << std::endl;
@@ -719,115 +834,61 @@ int main(int argc, char *argv[])
   }
 
   if (isGood) {
-    // check that all runs have the same number of histograms
-    for (UInt_t i=1; i<runDataHandler.size(); i++) {
-      if (runDataHandler[0]->GetRunData()->GetNoOfHistos() != runDataHandler[0]->GetRunData()->GetNoOfHistos()) {
-        std::cerr << std::endl;
-        std::cerr << "**ERROR** can only add runs with the same number of histograms." << std::endl;
-        std::cerr << std::endl;
+    // take the first run as the reference for the data, and get the t0's for all the reference histos
+    PRawRunData *rawRunData = refRunDataHandler->GetRunData();
+    addRun_getT0s(addRunInfo[0], rawRunData);
+
+    // stream over the remaining runs: while run i is added, run i+1 is already read.
+    PRunDataHandler *current{nullptr}, *next{nullptr};
+    if (addRunInfo.size() > 1) {
+      current = addRun_readRun(addRunInfo[1], startupHandler);
+      if (current == nullptr)
         isGood = false;
-      }
     }
-  }
-
-  if (isGood) {
-    // add all the runs
-    // take first run as the reference for the data
-    std::vector<PDoubleVector*> addedHistos;
-    addedHistos.resize(runDataHandler[0]->GetRunData()->GetNoOfHistos());
-    for (UInt_t i=0; i<runDataHandler[0]->GetRunData()->GetNoOfHistos(); i++) {
-      addedHistos[i] = runDataHandler[0]->GetRunData()->GetDataSet(i, false)->GetData();
-    }
-    // get the t0's for all the reference histos
-    PIntVector t0Vec;
-    t0Vec.resize(runDataHandler[0]->GetRunData()->GetNoOfHistos());
-    if (addRunInfo[0].fT0.empty()) { // i.e. take t0's from data file
-      for (UInt_t i=0; i<runDataHandler[0]->GetRunData()->GetNoOfHistos(); i++) {
-        t0Vec[i] = runDataHandler[0]->GetRunData()->GetT0Bin(i+1);
-      }
-      addRunInfo[0].fT0 = t0Vec;
-    } else { // t0 vector present
-      // make sure that the number of t0's fit the number of histos
-      if (addRunInfo[0].fT0.size() < runDataHandler[0]->GetRunData()->GetNoOfHistos()) {
-        UInt_t counts=runDataHandler[0]->GetRunData()->GetNoOfHistos()-addRunInfo[0].fT0.size();
-        for (UInt_t i=0; i<counts; i++)
-          addRunInfo[0].fT0.push_back(0);
-      }
-      // check t0 data
-      for (UInt_t i=0; i<addRunInfo[0].fT0.size(); i++) {
-        if (addRunInfo[0].fT0[i] == 0) { // get t0 from file
-          addRunInfo[0].fT0[i] = runDataHandler[0]->GetRunData()->GetT0Bin(i+1);
-        } else if (addRunInfo[0].fT0[i] == -1) { // get t0 from prompt peak
-          addRunInfo[0].fT0[i] = addRun_getPromptPeakPos(runDataHandler[0]->GetRunData()->GetDataSet(i, false)->GetData());
-        }
-      }
-    }
-
-    // loop over the remaining runs, determine t0's if needed and add the data
-    for (int i=1; i<runDataHandler.size(); i++) {
-      // get the t0's for all the histos of a run to be added
-      PIntVector t0Vec;
-      t0Vec.resize(runDataHandler[i]->GetRunData()->GetNoOfHistos());
-      if (addRunInfo[i].fT0.empty()) { // i.e. take t0's from data file
-        for (UInt_t j=0; j<runDataHandler[i]->GetRunData()->GetNoOfHistos(); j++) {
-          t0Vec[j] = runDataHandler[i]->GetRunData()->GetT0Bin(j+1);
-        }
-        addRunInfo[i].fT0 = t0Vec;
-      } else { // t0 vector present
-        // make sure that the number of t0's fit the number of histos
-        if (addRunInfo[i].fT0.size() < runDataHandler[i]->GetRunData()->GetNoOfHistos()) {
-          UInt_t counts=runDataHandler[i]->GetRunData()->GetNoOfHistos()-addRunInfo[i].fT0.size();
-          for (UInt_t j=0; j<counts; j++)
-            addRunInfo[i].fT0.push_back(0);
-        }
-        // check t0 data
-        for (UInt_t j=0; j<addRunInfo[i].fT0.size(); j++) {
-          if (addRunInfo[i].fT0[j] == 0) { // get t0 from file
-            addRunInfo[i].fT0[j] = runDataHandler[i]->GetRunData()->GetT0Bin(j+1);
-          } else if (addRunInfo[i].fT0[j] == -1) { // get t0 from prompt peak
-            addRunInfo[i].fT0[j] = addRun_getPromptPeakPos(runDataHandler[i]->GetRunData()->GetDataSet(j, false)->GetData());
+    for (UInt_t i=1; (i<addRunInfo.size()) && isGood; i++) {
+      Bool_t readOk{true}, addOk{true};
+      #ifdef HAVE_GOMP
+      #pragma omp parallel sections default(shared)
+      #endif
+      {
+        #ifdef HAVE_GOMP
+        #pragma omp section
+        #endif
+        {
+          next = nullptr;
+          if (i+1 < addRunInfo.size()) {
+            next = addRun_readRun(addRunInfo[i+1], startupHandler);
+            readOk = (next != nullptr);
           }
         }
-      }
-
-      // calculate the offset due to potential differences in t0's between runs
-      PIntVector diff;
-      diff.resize(addRunInfo[i].fT0.size());
-      for (UInt_t j=0; j<diff.size(); j++) {
-        diff[j] = addRunInfo[i].fT0[j] - addRunInfo[0].fT0[j];
-      }
-
-      // add all the to be added histos of all remaining runs
-      PDoubleVector *addData{nullptr};
-      Int_t idx;
-      for (int j=0; j<runDataHandler[i]->GetRunData()->GetNoOfHistos(); j++) { // loop over all histos
-        addData = runDataHandler[i]->GetRunData()->GetDataSet(j, false)->GetData();
-        for (int k=0; k<addedHistos[j]->size(); k++) { // loop over all elements of a histo
-          idx = k + diff[j];
-          if ((idx >= 0) && (idx < addData->size())) {
-            addedHistos[j]->at(k) += addData->at(idx);
-          }
+        #ifdef HAVE_GOMP
+        #pragma omp section
+        #endif
+        {
+          addOk = addRun_addRun(addRunInfo[0], rawRunData, addRunInfo[i], current);
         }
       }
+      delete current;
+      current = next;
+      if (!readOk || !addOk)
+        isGood = false;
     }
+    if (current)
+      delete current;
 
-    // feed all the necessary information for the data file
-    PRawRunData *rawRunData = new PRawRunData();
-    rawRunData = runDataHandler[0]->GetRunData(); // copy all
-    rawRunData->SetGenerator("addRun");
-    // overwrite the t0 values with the new ones
-    for (UInt_t i=0; i<rawRunData->GetNoOfHistos(); i++) {
-      rawRunData->GetDataSet(i, false)->SetTimeZeroBin(addRunInfo[0].fT0[i]);
-    }
-    // write histos
-    for (UInt_t i=0; i<rawRunData->GetNoOfHistos(); i++) {
-      rawRunData->GetDataSet(i, false)->SetData(*addedHistos[i]);
-    }
+    if (isGood) {
+      // feed all the necessary information for the data file
+      rawRunData->SetGenerator("addRun");
+      // overwrite the t0 values with the new ones
+      for (UInt_t i=0; i<rawRunData->GetNoOfHistos(); i++) {
+        rawRunData->GetDataSet(i, false)->SetTimeZeroBin(addRunInfo[0].fT0[i]);
+      }
 
-    // feed run data handler with new data
-    if (dataOut->SetRunData(rawRunData)) {
-      // write output file
-      dataOut->WriteData();
+      // feed run data handler with new data
+      if (dataOut->SetRunData(rawRunData)) {
+        // write output file
+        dataOut->WriteData();
+      }
     }
   }
 
@@ -841,11 +902,9 @@ int main(int argc, char *argv[])
   if (dataOut) {
     delete dataOut;
   }
-  for (int i=0; i<runDataHandler.size(); i++) {
-    if (runDataHandler[i])
-      delete runDataHandler[i];
+  if (refRunDataHandler) {
+    delete refRunDataHandler;
   }
-  runDataHandler.clear();  
 
   return PMUSR_SUCCESS;
 }
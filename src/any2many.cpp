@@ -48,6 +48,7 @@
 #include "PMusr.h"
 #include "PStartupHandler.h"
 #include "PRunDataHandler.h"
+#include "PArchiveWriter.h"
 
 //--------------------------------------------------------------------------
 /**
@@ -100,9 +101,11 @@ void any2many_syntax()
   std::cout << std::endl << "                generation needs a year, this number will be used.";
   std::cout << std::endl << "          -s : with this option the output data file will be sent to the stdout.";
   std::cout << std::endl << "          -rebin <n> : where <n> is the number of bins to be packed";
-  std::cout << std::endl << "          -z [g|b] <compressed> : where <compressed> is the output file name";
+  std::cout << std::endl << "          -z [g|b|z] <compressed> : where <compressed> is the output file name";
   std::cout << std::endl << "                (without extension) of the compressed data collection, and";
-  std::cout << std::endl << "                'g' will result in .tar.gz, and 'b' in .tar.bz2 files.";
+  std::cout << std::endl << "                'g' will result in .tar.gz, 'b' in .tar.bz2, and 'z' in .tar.zst files.";
+  std::cout << std::endl << "                The archive is written while the conversion is ongoing ('z' is";
+  std::cout << std::endl << "                only available if musrfit was built with zstd support).";
   std::cout << std::endl;
   std::cout << std::endl << "          If the template option '-t' is absent, the output file name will be";
   std::cout << std::endl << "          generated according to the input data file name, and the output data";
@@ -422,9 +425,11 @@ int main(int argc, char *argv[])
           break;
         }
         if (argv[i+1][0] == 'g') {
-          info.compressionTag = 1;
+          info.compressionTag = PARCHIVE_GZIP;
         } else if (argv[i+1][0] == 'b') {
-          info.compressionTag = 2;
+          info.compressionTag = PARCHIVE_BZIP2;
+        } else if ((argv[i+1][0] == 'z') && PArchiveWriter::IsSupported(PARCHIVE_ZSTD)) {
+          info.compressionTag = PARCHIVE_ZSTD;
         } else {
           std::cerr << std::endl << ">> any2many **ERROR** found in option '-z' compression tag '" << argv[i+1] << "' which is not supported." << std::endl;
           show_syntax = true;
@@ -0,0 +1,487 @@
+/***************************************************************************
+
+  PArchiveWriter.cpp
+
+  Author: Andreas Suter
+  e-mail: andreas.suter@psi.ch
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2007-2023 by Andreas Suter                              *
+ *   andreas.suter@psi.ch                                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <iostream>
+
+#include <zlib.h>
+#include <bzlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef HAVE_GOMP
+#include <omp.h>
+#endif
+
+#include "PArchiveWriter.h"
+
+#define PARCHIVE_BLOCK_SIZE   512
+#define PARCHIVE_RECORD_SIZE  10240
+#define PARCHIVE_BUFFER_SIZE  1048576
+
+//--------------------------------------------------------------------------
+// Constructor
+//--------------------------------------------------------------------------
+/**
+ * <p>Constructor.
+ */
+PArchiveWriter::PArchiveWriter()
+{
+  fBuffer.resize(PARCHIVE_BUFFER_SIZE);
+}
+
+//--------------------------------------------------------------------------
+// Destructor
+//--------------------------------------------------------------------------
+/**
+ * <p>Destructor. Makes sure that an open archive is properly terminated.
+ */
+PArchiveWriter::~PArchiveWriter()
+{
+  if (fIsOpen)
+    Close();
+}
+
+//--------------------------------------------------------------------------
+// GetExtension (public, static)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns the archive file extension for a given compression tag.
+ *
+ * \param compressionTag 1=gzip, 2=bzip2, 3=zstd
+ */
+const char* PArchiveWriter::GetExtension(const Int_t compressionTag)
+{
+  switch (compressionTag) {
+  case PARCHIVE_GZIP:
+    return ".tar.gz";
+  case PARCHIVE_BZIP2:
+    return ".tar.bz2";
+  case PARCHIVE_ZSTD:
+    return ".tar.zst";
+  default:
+    break;
+  }
+
+  return ".tar";
+}
+
+//--------------------------------------------------------------------------
+// IsSupported (public, static)
+//--------------------------------------------------------------------------
+/**
+ * <p>Checks if a compression is supported by this build.
+ *
+ * \param compressionTag 1=gzip, 2=bzip2, 3=zstd
+ */
+Bool_t PArchiveWriter::IsSupported(const Int_t compressionTag)
+{
+  switch (compressionTag) {
+  case PARCHIVE_GZIP:
+  case PARCHIVE_BZIP2:
+    return true;
+  case PARCHIVE_ZSTD:
+#ifdef HAVE_ZSTD
+    return true;
+#else
+    return false;
+#endif
+  default:
+    break;
+  }
+
+  return false;
+}
+
+//--------------------------------------------------------------------------
+// Open (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Opens the compressed archive.
+ *
+ * <b>return:</b>
+ * - true on success
+ * - false otherwise
+ *
+ * \param fileName archive file name. If empty, the archive is streamed to stdout.
+ * \param compressionTag 1=gzip, 2=bzip2, 3=zstd
+ */
+Bool_t PArchiveWriter::Open(const TString fileName, const Int_t compressionTag)
+{
+  if (fIsOpen) {
+    std::cerr << std::endl << ">> PArchiveWriter::Open(): **ERROR** archive is already open." << std::endl;
+    return false;
+  }
+
+  if (!IsSupported(compressionTag)) {
+    std::cerr << std::endl << ">> PArchiveWriter::Open(): **ERROR** compression tag " << compressionTag << " not supported." << std::endl;
+    return false;
+  }
+
+  if (fileName.Length() == 0) {
+    fFile = stdout;
+    fOwnFile = false;
+  } else {
+    fFile = fopen(fileName.Data(), "wb");
+    if (fFile == nullptr) {
+      std::cerr << std::endl << ">> PArchiveWriter::Open(): **ERROR** couldn't open '" << fileName << "' for writing." << std::endl;
+      return false;
+    }
+    fOwnFile = true;
+  }
+
+  fCompressionTag = compressionTag;
+  fBytesWritten = 0;
+
+  switch (fCompressionTag) {
+  case PARCHIVE_GZIP:
+    {
+      // gzclose() closes the file descriptor, hence hand over a duplicate
+      Int_t fd = dup(fileno(fFile));
+      gzFile gz = (fd < 0) ? nullptr : gzdopen(fd, "wb6");
+      if (gz == nullptr) {
+        if (fd >= 0)
+          close(fd);
+        break;
+      }
+      gzbuffer(gz, PARCHIVE_BUFFER_SIZE);
+      fStream = gz;
+    }
+    break;
+  case PARCHIVE_BZIP2:
+    {
+      Int_t bzerr = BZ_OK;
+      BZFILE *bz = BZ2_bzWriteOpen(&bzerr, fFile, 9, 0, 0);
+      if (bzerr != BZ_OK) {
+        BZ2_bzWriteClose(&bzerr, bz, 1, nullptr, nullptr);
+        break;
+      }
+      fStream = bz;
+    }
+    break;
+  case PARCHIVE_ZSTD:
+#ifdef HAVE_ZSTD
+    {
+      ZSTD_CCtx *cctx = ZSTD_createCCtx();
+      if (cctx == nullptr)
+        break;
+      ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, 3);
+#ifdef HAVE_GOMP
+      // only has an effect if libzstd is built with multi-threading support
+      ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, omp_get_max_threads());
+#endif
+      fOutBuffer.resize(ZSTD_CStreamOutSize());
+      fStream = cctx;
+    }
+#endif
+    break;
+  default:
+    break;
+  }
+
+  if (fStream == nullptr) {
+    std::cerr << std::endl << ">> PArchiveWriter::Open(): **ERROR** couldn't initialize the compressor." << std::endl;
+    if (fOwnFile)
+      fclose(fFile);
+    fFile = nullptr;
+    return false;
+  }
+
+  fIsOpen = true;
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+// AddFile (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Appends a regular file to the archive.
+ *
+ * <b>return:</b>
+ * - true on success
+ * - false otherwise
+ *
+ * \param pathFileName path file name of the file to be added
+ * \param nameInArchive name under which the file is stored. If empty, the file name without path is used.
+ */
+Bool_t PArchiveWriter::AddFile(const TString pathFileName, const TString nameInArchive)
+{
+  if (!fIsOpen) {
+    std::cerr << std::endl << ">> PArchiveWriter::AddFile(): **ERROR** archive is not open." << std::endl;
+    return false;
+  }
+
+  struct stat st;
+  if ((stat(pathFileName.Data(), &st) != 0) || !S_ISREG(st.st_mode)) {
+    std::cerr << std::endl << ">> PArchiveWriter::AddFile(): **ERROR** '" << pathFileName << "' is not a regular file." << std::endl;
+    return false;
+  }
+
+  TString name = nameInArchive;
+  if (name.Length() == 0) {
+    name = pathFileName;
+    Ssiz_t idx = name.Last('/');
+    if (idx != kNPOS)
+      name.Remove(0, idx+1);
+  }
+
+  FILE *fp = fopen(pathFileName.Data(), "rb");
+  if (fp == nullptr) {
+    std::cerr << std::endl << ">> PArchiveWriter::AddFile(): **ERROR** couldn't open '" << pathFileName << "' for reading." << std::endl;
+    return false;
+  }
+
+  if (!WriteHeader(name, st.st_size, st.st_mtime, st.st_mode & 07777)) {
+    fclose(fp);
+    return false;
+  }
+
+  Long64_t count = 0;
+  size_t len;
+  while ((len = fread(fBuffer.data(), 1, fBuffer.size(), fp)) > 0) {
+    if (!Write(fBuffer.data(), len)) {
+      fclose(fp);
+      return false;
+    }
+    count += len;
+  }
+  fclose(fp);
+
+  if (count != st.st_size) {
+    std::cerr << std::endl << ">> PArchiveWriter::AddFile(): **ERROR** '" << pathFileName << "' changed while being archived." << std::endl;
+    return false;
+  }
+
+  // pad to the tar block size
+  Long64_t rest = count % PARCHIVE_BLOCK_SIZE;
+  if (rest > 0) {
+    char zeros[PARCHIVE_BLOCK_SIZE];
+    memset(zeros, 0, sizeof(zeros));
+    if (!Write(zeros, PARCHIVE_BLOCK_SIZE-rest))
+      return false;
+  }
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+// Close (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Terminates the tar archive (two zero blocks, padded to a full record),
+ * flushes the compressor and closes the archive.
+ *
+ * <b>return:</b>
+ * - true on success
+ * - false otherwise
+ */
+Bool_t PArchiveWriter::Close()
+{
+  if (!fIsOpen)
+    return false;
+
+  Bool_t result = true;
+
+  // end-of-archive marker
+  std::vector<char> zeros(2*PARCHIVE_BLOCK_SIZE, 0);
+  Long64_t total = fBytesWritten + zeros.size();
+  if (total % PARCHIVE_RECORD_SIZE)
+    zeros.resize(zeros.size() + PARCHIVE_RECORD_SIZE - total % PARCHIVE_RECORD_SIZE, 0);
+  result = Write(zeros.data(), zeros.size(), true);
+
+  switch (fCompressionTag) {
+  case PARCHIVE_GZIP:
+    if (gzclose(static_cast<gzFile>(fStream)) != Z_OK)
+      result = false;
+    break;
+  case PARCHIVE_BZIP2:
+    {
+      Int_t bzerr = BZ_OK;
+      BZ2_bzWriteClose(&bzerr, static_cast<BZFILE*>(fStream), 0, nullptr, nullptr);
+      if (bzerr != BZ_OK)
+        result = false;
+    }
+    break;
+  case PARCHIVE_ZSTD:
+#ifdef HAVE_ZSTD
+    ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(fStream));
+#endif
+    break;
+  default:
+    break;
+  }
+  fStream = nullptr;
+
+  if (fOwnFile) {
+    if (fclose(fFile) != 0)
+      result = false;
+  } else {
+    if (fflush(fFile) != 0)
+      result = false;
+  }
+  fFile = nullptr;
+  fIsOpen = false;
+
+  if (!result)
+    std::cerr << std::endl << ">> PArchiveWriter::Close(): **ERROR** couldn't properly terminate the archive." << std::endl;
+
+  return result;
+}
+
+//--------------------------------------------------------------------------
+// Write (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Feeds data to the compressor.
+ *
+ * \param data data to be written
+ * \param size number of bytes to be written
+ * \param flush if true, the compressor stream is terminated (only relevant for zstd)
+ */
+Bool_t PArchiveWriter::Write(const char *data, const size_t size, const Bool_t flush)
+{
+  Bool_t result = true;
+
+  switch (fCompressionTag) {
+  case PARCHIVE_GZIP:
+    if (size > 0)
+      result = (gzwrite(static_cast<gzFile>(fStream), data, size) == static_cast<Int_t>(size));
+    break;
+  case PARCHIVE_BZIP2:
+    {
+      Int_t bzerr = BZ_OK;
+      BZ2_bzWrite(&bzerr, static_cast<BZFILE*>(fStream), const_cast<char*>(data), size);
+      result = (bzerr == BZ_OK);
+    }
+    break;
+  case PARCHIVE_ZSTD:
+#ifdef HAVE_ZSTD
+    {
+      ZSTD_CCtx *cctx = static_cast<ZSTD_CCtx*>(fStream);
+      ZSTD_EndDirective mode = flush ? ZSTD_e_end : ZSTD_e_continue;
+      ZSTD_inBuffer in = {data, size, 0};
+      Bool_t done = false;
+      while (!done) {
+        ZSTD_outBuffer out = {fOutBuffer.data(), fOutBuffer.size(), 0};
+        size_t remaining = ZSTD_compressStream2(cctx, &out, &in, mode);
+        if (ZSTD_isError(remaining)) {
+          std::cerr << std::endl << ">> PArchiveWriter::Write(): **ERROR** " << ZSTD_getErrorName(remaining) << std::endl;
+          return false;
+        }
+        if (fwrite(fOutBuffer.data(), 1, out.pos, fFile) != out.pos)
+          return false;
+        done = flush ? (remaining == 0) : (in.pos == in.size);
+      }
+    }
+#endif
+    break;
+  default:
+    result = false;
+    break;
+  }
+
+  if (!result)
+    std::cerr << std::endl << ">> PArchiveWriter::Write(): **ERROR** couldn't write to the archive." << std::endl;
+  else
+    fBytesWritten += size;
+
+  return result;
+}
+
+//--------------------------------------------------------------------------
+// WriteHeader (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Writes a ustar header block for a regular file. Names longer than 100
+ * characters are split into prefix and name at a '/' as foreseen by POSIX.
+ * Sizes which do not fit into 11 octal digits are stored in base-256 (GNU).
+ *
+ * \param name name of the file within the archive
+ * \param size file size in bytes
+ * \param mtime modification time
+ * \param mode file permissions
+ */
+Bool_t PArchiveWriter::WriteHeader(const TString &name, const Long64_t size, const Long_t mtime, const Int_t mode)
+{
+  char hdr[PARCHIVE_BLOCK_SIZE];
+  memset(hdr, 0, sizeof(hdr));
+
+  // name (100) and prefix (155, at offset 345)
+  const Ssiz_t len = name.Length();
+  if (len <= 100) {
+    memcpy(hdr, name.Data(), len);
+  } else {
+    Ssiz_t idx = (len-1 < 155) ? len-1 : 155;
+    while ((idx > 0) && ((name[idx] != '/') || (len-idx-1 > 100)))
+      idx--;
+    if (idx <= 0) {
+      std::cerr << std::endl << ">> PArchiveWriter::WriteHeader(): **ERROR** file name '" << name << "' too long for a tar archive." << std::endl;
+      return false;
+    }
+    memcpy(hdr+345, name.Data(), idx);
+    memcpy(hdr, name.Data()+idx+1, len-idx-1);
+  }
+
+  snprintf(hdr+100, 8, "%07o", mode);
+  snprintf(hdr+108, 8, "%07o", 0); // uid
+  snprintf(hdr+116, 8, "%07o", 0); // gid
+  if (size < 077777777777LL) {
+    snprintf(hdr+124, 12, "%011llo", static_cast<unsigned long long>(size));
+  } else { // base-256
+    unsigned long long val = size;
+    for (Int_t i=11; i>0; i--) {
+      hdr[124+i] = static_cast<char>(val & 0xff);
+      val >>= 8;
+    }
+    hdr[124] = static_cast<char>(0x80);
+  }
+  snprintf(hdr+136, 12, "%011lo", static_cast<unsigned long>(mtime));
+  hdr[156] = '0'; // regular file
+  memcpy(hdr+257, "ustar", 6);
+  memcpy(hdr+263, "00", 2);
+
+  // checksum: computed with the checksum field filled with blanks
+  memset(hdr+148, ' ', 8);
+  UInt_t chksum = 0;
+  for (UInt_t i=0; i<PARCHIVE_BLOCK_SIZE; i++)
+    chksum += static_cast<unsigned char>(hdr[i]);
+  snprintf(hdr+148, 8, "%06o", chksum);
+  hdr[155] = ' ';
+
+  return Write(hdr, PARCHIVE_BLOCK_SIZE);
+}
@@ -0,0 +1,558 @@
+/***************************************************************************
+
+  PFFTPlanManager.cpp
+
+  Author: Andreas Suter
+  e-mail: andreas.suter@psi.ch
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2007-2023 by Andreas Suter                              *
+ *   andreas.suter@psi.ch                                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <cstdio>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <tuple>
+
+#include "PFFTPlanManager.h"
+#include "PPerfMonitor.h"
+
+//--------------------------------------------------------------------------
+// operator<
+//--------------------------------------------------------------------------
+/**
+ * <p>Strict weak ordering needed for the plan cache.
+ */
+bool PFFTPlanKey::operator<(const PFFTPlanKey &key) const
+{
+  return std::tie(fKind, fSinglePrecision, fDims, fLayout, fInPlace, fAlignIn, fAlignOut, fFlags, fThreads) <
+         std::tie(key.fKind, key.fSinglePrecision, key.fDims, key.fLayout, key.fInPlace, key.fAlignIn, key.fAlignOut, key.fFlags, key.fThreads);
+}
+
+//--------------------------------------------------------------------------
+// GetInstance (public, static)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns the process-wide FFT plan manager.
+ */
+PFFTPlanManager* PFFTPlanManager::GetInstance()
+{
+  static PFFTPlanManager instance;
+  return &instance;
+}
+
+//--------------------------------------------------------------------------
+// Constructor (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>By default the FFTW planner may use all available cores (as the user functions did so far).
+ */
+PFFTPlanManager::PFFTPlanManager()
+{
+  Int_t noOfCores = static_cast<Int_t>(std::thread::hardware_concurrency());
+  if (noOfCores > 0)
+    fNoOfThreads = noOfCores;
+
+  fPerfCache = PPerfMonitor::GetInstance()->GetCacheCounter("fftw_plans");
+}
+
+//--------------------------------------------------------------------------
+// Destructor (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Writes the accumulated wisdom back to the registered wisdom files and destroys all cached plans.
+ */
+PFFTPlanManager::~PFFTPlanManager()
+{
+  ExportWisdom();
+
+  for (auto &plans : fPlans) {
+    if (plans.second.fPlan)
+      fftw_destroy_plan(plans.second.fPlan);
+#ifdef HAVE_LIBFFTW3F
+    if (plans.second.fPlanF)
+      fftwf_destroy_plan(plans.second.fPlanF);
+#endif
+  }
+  fPlans.clear();
+}
+
+//--------------------------------------------------------------------------
+// MakeKey (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Collects the properties of a requested plan which are common to all kinds of transforms.
+ */
+PFFTPlanKey PFFTPlanManager::MakeKey(const EPlanKind kind, const Bool_t singlePrecision, const Int_t rank, const Int_t *n,
+                                     const void *in, const void *out, const Int_t alignIn, const Int_t alignOut, const UInt_t flags) const
+{
+  PFFTPlanKey key;
+
+  key.fKind = kind;
+  key.fSinglePrecision = singlePrecision;
+  key.fDims.assign(n, n+rank);
+  key.fInPlace = (in == out);
+  key.fAlignIn = alignIn;
+  key.fAlignOut = alignOut;
+  key.fFlags = flags;
+  key.fThreads = fNoOfThreads;
+
+  return key;
+}
+
+//--------------------------------------------------------------------------
+// PrepareThreads (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Sets the number of threads for the next plan to be created. Needs to be called with fMutex locked.
+ */
+void PFFTPlanManager::PrepareThreads(const Bool_t singlePrecision)
+{
+  if (singlePrecision) {
+#ifdef HAVE_LIBFFTW3F_THREADS
+    if (!fThreadsInitializedF)
+      fThreadsInitializedF = (fftwf_init_threads() != 0);
+    if (fThreadsInitializedF)
+      fftwf_plan_with_nthreads(fNoOfThreads);
+#endif
+  } else {
+#ifdef HAVE_LIBFFTW3_THREADS
+    if (!fThreadsInitialized)
+      fThreadsInitialized = (fftw_init_threads() != 0);
+    if (fThreadsInitialized)
+      fftw_plan_with_nthreads(fNoOfThreads);
+#endif
+  }
+}
+
+//--------------------------------------------------------------------------
+// SetNumberOfThreads (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Sets the number of threads used for plans created from now on (musrfit --use-no-of-threads).
+ *
+ * \param noOfThreads number of threads; values < 1 are ignored
+ */
+void PFFTPlanManager::SetNumberOfThreads(const Int_t noOfThreads)
+{
+  if (noOfThreads < 1)
+    return;
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  fNoOfThreads = noOfThreads;
+}
+
+//--------------------------------------------------------------------------
+// ImportWisdom (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Imports a wisdom file once per process. The file is remembered and the accumulated wisdom
+ * is written back to it when the process ends.
+ *
+ * <p><b>return:</b> true if wisdom from this file is available (imported now or earlier), false otherwise
+ *
+ * \param fileName path-file name of the wisdom file
+ * \param singlePrecision true for fftwf wisdom
+ */
+Bool_t PFFTPlanManager::ImportWisdom(const std::string &fileName, const Bool_t singlePrecision)
+{
+  if (fileName.empty())
+    return false;
+
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  std::set<std::string> &files = singlePrecision ? fWisdomFilesF : fWisdomFiles;
+  if (files.find(fileName) != files.end())
+    return true;
+
+  FILE *fp = fopen(fileName.c_str(), "r");
+  if (fp == nullptr)
+    return false;
+
+  Int_t loaded(0);
+  if (singlePrecision) {
+#ifdef HAVE_LIBFFTW3F
+    loaded = fftwf_import_wisdom_from_file(fp);
+#endif
+  } else {
+    loaded = fftw_import_wisdom_from_file(fp);
+  }
+  fclose(fp);
+
+  if (!loaded)
+    return false;
+
+  files.insert(fileName);
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+// ExportWisdom (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Writes the accumulated wisdom to all imported wisdom files, so that the plans do not have to
+ * be measured again next time.
+ */
+void PFFTPlanManager::ExportWisdom()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  FILE *fp;
+  for (auto &fileName : fWisdomFiles) {
+    fp = fopen(fileName.c_str(), "w");
+    if (fp == nullptr) {
+      std::cerr << std::endl << ">> PFFTPlanManager::ExportWisdom(): **WARNING** couldn't write wisdom file '" << fileName << "'." << std::endl;
+      continue;
+    }
+    fftw_export_wisdom_to_file(fp);
+    fclose(fp);
+  }
+#ifdef HAVE_LIBFFTW3F
+  for (auto &fileName : fWisdomFilesF) {
+    fp = fopen(fileName.c_str(), "w");
+    if (fp == nullptr) {
+      std::cerr << std::endl << ">> PFFTPlanManager::ExportWisdom(): **WARNING** couldn't write wisdom file '" << fileName << "'." << std::endl;
+      continue;
+    }
+    fftwf_export_wisdom_to_file(fp);
+    fclose(fp);
+  }
+#endif
+}
+
+//--------------------------------------------------------------------------
+// PrintStatistics (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Prints the number of created plans, cache hits and the time spent in the FFTW planner.
+ */
+void PFFTPlanManager::PrintStatistics() const
+{
+  std::cout << std::endl << ">> FFTW plans: " << fNoOfPlans << " created, " << fNoOfCacheHits << " reused, planning time: " << fPlanningTime << " (sec)";
+  std::cout << std::endl;
+}
+
+//--------------------------------------------------------------------------
+// GetPlanDft (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns a complex-to-complex plan of rank <i>rank</i> (double precision).
+ *
+ * \param rank rank of the transform
+ * \param n dimensions of the transform
+ * \param in input array
+ * \param out output array
+ * \param sign FFTW_FORWARD or FFTW_BACKWARD
+ * \param flags FFTW planner flags
+ */
+fftw_plan PFFTPlanManager::GetPlanDft(const Int_t rank, const Int_t *n, fftw_complex *in, fftw_complex *out, const Int_t sign, const UInt_t flags)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  PFFTPlanKey key = MakeKey(kDft, false, rank, n, in, out, fftw_alignment_of(&in[0][0]), fftw_alignment_of(&out[0][0]), flags);
+  key.fLayout.push_back(sign);
+
+  auto iter = fPlans.find(key);
+  if ((iter != fPlans.end()) && iter->second.fPlan) {
+    fNoOfCacheHits++;
+    fPerfCache->Hit();
+    return iter->second.fPlan;
+  }
+
+  PrepareThreads(false);
+  auto start = std::chrono::steady_clock::now();
+  fftw_plan plan = fftw_plan_dft(rank, n, in, out, sign, flags);
+  fPlanningTime += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+
+  if (plan) {
+    fPlans[key].fPlan = plan;
+    fNoOfPlans++;
+    fPerfCache->Miss();
+  }
+
+  return plan;
+}
+
+//--------------------------------------------------------------------------
+// GetPlanDftR2C (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns a real-to-complex plan of rank <i>rank</i> (double precision).
+ *
+ * \param rank rank of the transform
+ * \param n dimensions of the transform
+ * \param in input array
+ * \param out output array
+ * \param flags FFTW planner flags
+ */
+fftw_plan PFFTPlanManager::GetPlanDftR2C(const Int_t rank, const Int_t *n, Double_t *in, fftw_complex *out, const UInt_t flags)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  PFFTPlanKey key = MakeKey(kDftR2C, false, rank, n, in, out, fftw_alignment_of(in), fftw_alignment_of(&out[0][0]), flags);
+
+  auto iter = fPlans.find(key);
+  if ((iter != fPlans.end()) && iter->second.fPlan) {
+    fNoOfCacheHits++;
+    fPerfCache->Hit();
+    return iter->second.fPlan;
+  }
+
+  PrepareThreads(false);
+  auto start = std::chrono::steady_clock::now();
+  fftw_plan plan = fftw_plan_dft_r2c(rank, n, in, out, flags);
+  fPlanningTime += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+
+  if (plan) {
+    fPlans[key].fPlan = plan;
+    fNoOfPlans++;
+    fPerfCache->Miss();
+  }
+
+  return plan;
+}
+
+//--------------------------------------------------------------------------
+// GetPlanDftC2R (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns a complex-to-real plan of rank <i>rank</i> (double precision).
+ *
+ * \param rank rank of the transform
+ * \param n dimensions of the transform (of the real output)
+ * \param in input array
+ * \param out output array
+ * \param flags FFTW planner flags
+ */
+fftw_plan PFFTPlanManager::GetPlanDftC2R(const Int_t rank, const Int_t *n, fftw_complex *in, Double_t *out, const UInt_t flags)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  PFFTPlanKey key = MakeKey(kDftC2R, false, rank, n, in, out, fftw_alignment_of(&in[0][0]), fftw_alignment_of(out), flags);
+
+  auto iter = fPlans.find(key);
+  if ((iter != fPlans.end()) && iter->second.fPlan) {
+    fNoOfCacheHits++;
+    fPerfCache->Hit();
+    return iter->second.fPlan;
+  }
+
+  PrepareThreads(false);
+  auto start = std::chrono::steady_clock::now();
+  fftw_plan plan = fftw_plan_dft_c2r(rank, n, in, out, flags);
+  fPlanningTime += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+
+  if (plan) {
+    fPlans[key].fPlan = plan;
+    fNoOfPlans++;
+    fPerfCache->Miss();
+  }
+
+  return plan;
+}
+
+//--------------------------------------------------------------------------
+// GetPlanManyR2R (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns a real-to-real plan of rank <i>rank</i> for a single (howmany=1) strided transform (double precision).
+ *
+ * \param rank rank of the transform
+ * \param n dimensions of the transform
+ * \param in input array
+ * \param inembed dimensions of the array the input is embedded in
+ * \param istride stride of the input
+ * \param out output array
+ * \param onembed dimensions of the array the output is embedded in
+ * \param ostride stride of the output
+ * \param kind r2r kinds, one per dimension
+ * \param flags FFTW planner flags
+ */
+fftw_plan PFFTPlanManager::GetPlanManyR2R(const Int_t rank, const Int_t *n, Double_t *in, const Int_t *inembed, const Int_t istride,
+                                          Double_t *out, const Int_t *onembed, const Int_t ostride, const fftw_r2r_kind *kind, const UInt_t flags)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  PFFTPlanKey key = MakeKey(kManyR2R, false, rank, n, in, out, fftw_alignment_of(in), fftw_alignment_of(out), flags);
+  for (Int_t i=0; i<rank; i++) {
+    key.fLayout.push_back(kind[i]);
+    key.fLayout.push_back(inembed[i]);
+    key.fLayout.push_back(onembed[i]);
+  }
+  key.fLayout.push_back(istride);
+  key.fLayout.push_back(ostride);
+
+  auto iter = fPlans.find(key);
+  if ((iter != fPlans.end()) && iter->second.fPlan) {
+    fNoOfCacheHits++;
+    fPerfCache->Hit();
+    return iter->second.fPlan;
+  }
+
+  PrepareThreads(false);
+  auto start = std::chrono::steady_clock::now();
+  fftw_plan plan = fftw_plan_many_r2r(rank, n, 1, in, inembed, istride, 0, out, onembed, ostride, 0, kind, flags);
+  fPlanningTime += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+
+  if (plan) {
+    fPlans[key].fPlan = plan;
+    fNoOfPlans++;
+    fPerfCache->Miss();
+  }
+
+  return plan;
+}
+
+//--------------------------------------------------------------------------
+// GetPlanDft (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns a complex-to-complex plan of rank <i>rank</i> (single precision).
+ *
+ * \param rank rank of the transform
+ * \param n dimensions of the transform
+ * \param in input array
+ * \param out output array
+ * \param sign FFTW_FORWARD or FFTW_BACKWARD
+ * \param flags FFTW planner flags
+ */
+fftwf_plan PFFTPlanManager::GetPlanDft(const Int_t rank, const Int_t *n, fftwf_complex *in, fftwf_complex *out, const Int_t sign, const UInt_t flags)
+{
+#ifdef HAVE_LIBFFTW3F
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  PFFTPlanKey key = MakeKey(kDft, true, rank, n, in, out, fftwf_alignment_of(&in[0][0]), fftwf_alignment_of(&out[0][0]), flags);
+  key.fLayout.push_back(sign);
+
+  auto iter = fPlans.find(key);
+  if ((iter != fPlans.end()) && iter->second.fPlanF) {
+    fNoOfCacheHits++;
+    fPerfCache->Hit();
+    return iter->second.fPlanF;
+  }
+
+  PrepareThreads(true);
+  auto start = std::chrono::steady_clock::now();
+  fftwf_plan plan = fftwf_plan_dft(rank, n, in, out, sign, flags);
+  fPlanningTime += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+
+  if (plan) {
+    fPlans[key].fPlanF = plan;
+    fNoOfPlans++;
+    fPerfCache->Miss();
+  }
+
+  return plan;
+#else
+  std::cerr << std::endl << ">> PFFTPlanManager::GetPlanDft(): **ERROR** musrfit has been built without single precision FFTW." << std::endl;
+  return nullptr;
+#endif
+}
+
+//--------------------------------------------------------------------------
+// GetPlanDftR2C (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns a real-to-complex plan of rank <i>rank</i> (single precision).
+ *
+ * \param rank rank of the transform
+ * \param n dimensions of the transform
+ * \param in input array
+ * \param out output array
+ * \param flags FFTW planner flags
+ */
+fftwf_plan PFFTPlanManager::GetPlanDftR2C(const Int_t rank, const Int_t *n, Float_t *in, fftwf_complex *out, const UInt_t flags)
+{
+#ifdef HAVE_LIBFFTW3F
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  PFFTPlanKey key = MakeKey(kDftR2C, true, rank, n, in, out, fftwf_alignment_of(in), fftwf_alignment_of(&out[0][0]), flags);
+
+  auto iter = fPlans.find(key);
+  if ((iter != fPlans.end()) && iter->second.fPlanF) {
+    fNoOfCacheHits++;
+    fPerfCache->Hit();
+    return iter->second.fPlanF;
+  }
+
+  PrepareThreads(true);
+  auto start = std::chrono::steady_clock::now();
+  fftwf_plan plan = fftwf_plan_dft_r2c(rank, n, in, out, flags);
+  fPlanningTime += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+
+  if (plan) {
+    fPlans[key].fPlanF = plan;
+    fNoOfPlans++;
+    fPerfCache->Miss();
+  }
+
+  return plan;
+#else
+  std::cerr << std::endl << ">> PFFTPlanManager::GetPlanDftR2C(): **ERROR** musrfit has been built without single precision FFTW." << std::endl;
+  return nullptr;
+#endif
+}
+
+//--------------------------------------------------------------------------
+// GetPlanDftC2R (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns a complex-to-real plan of rank <i>rank</i> (single precision).
+ *
+ * \param rank rank of the transform
+ * \param n dimensions of the transform (of the real output)
+ * \param in input array
+ * \param out output array
+ * \param flags FFTW planner flags
+ */
+fftwf_plan PFFTPlanManager::GetPlanDftC2R(const Int_t rank, const Int_t *n, fftwf_complex *in, Float_t *out, const UInt_t flags)
+{
+#ifdef HAVE_LIBFFTW3F
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  PFFTPlanKey key = MakeKey(kDftC2R, true, rank, n, in, out, fftwf_alignment_of(&in[0][0]), fftwf_alignment_of(out), flags);
+
+  auto iter = fPlans.find(key);
+  if ((iter != fPlans.end()) && iter->second.fPlanF) {
+    fNoOfCacheHits++;
+    fPerfCache->Hit();
+    return iter->second.fPlanF;
+  }
+
+  PrepareThreads(true);
+  auto start = std::chrono::steady_clock::now();
+  fftwf_plan plan = fftwf_plan_dft_c2r(rank, n, in, out, flags);
+  fPlanningTime += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+
+  if (plan) {
+    fPlans[key].fPlanF = plan;
+    fNoOfPlans++;
+    fPerfCache->Miss();
+  }
+
+  return plan;
+#else
+  std::cerr << std::endl << ">> PFFTPlanManager::GetPlanDftC2R(): **ERROR** musrfit has been built without single precision FFTW." << std::endl;
+  return nullptr;
+#endif
+}
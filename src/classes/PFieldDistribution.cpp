@@ -0,0 +1,276 @@
+/***************************************************************************
+
+  PFieldDistribution.cpp
+
+  Author: Andreas Suter
+  e-mail: andreas.suter@psi.ch
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2007-2023 by Andreas Suter                              *
+ *   andreas.suter@psi.ch                                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "fftw3.h"
+
+#include "PFFTPlanManager.h"
+#include "PFieldDistribution.h"
+
+UInt_t PFieldDistribution::fMinChirpZSize = 64;
+
+//--------------------------------------------------------------------------
+// Clear (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Removes all frequencies.
+ */
+void PFieldDistribution::Clear()
+{
+  fSegment.clear();
+  fTotalWeight = 0.0;
+}
+
+//--------------------------------------------------------------------------
+// AddEquidistant (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Adds the frequencies omega0 + j*dOmega, j = 0, ..., ampl.size()-1, with the amplitudes ampl[j].
+ *
+ * \param omega0 first frequency
+ * \param dOmega frequency step (may be negative)
+ * \param ampl amplitudes
+ */
+void PFieldDistribution::AddEquidistant(const Double_t omega0, const Double_t dOmega, const std::vector<Double_t> &ampl)
+{
+  if (ampl.empty())
+    return;
+
+  PSegment seg;
+  seg.fOmega0 = omega0;
+  seg.fDOmega = dOmega;
+  seg.fAmpl = ampl;
+  fSegment.push_back(seg);
+
+  for (UInt_t i=0; i<ampl.size(); i++)
+    fTotalWeight += ampl[i];
+}
+
+//--------------------------------------------------------------------------
+// GetNoOfPoints (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns the number of frequencies of the distribution.
+ */
+UInt_t PFieldDistribution::GetNoOfPoints() const
+{
+  UInt_t count = 0;
+  for (UInt_t i=0; i<fSegment.size(); i++)
+    count += fSegment[i].fAmpl.size();
+  return count;
+}
+
+//--------------------------------------------------------------------------
+// Polarization (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Normalized cosine sum \f$\sum_j a_j \cos(\omega_j t + \varphi) / \sum_j a_j\f$ at a single time.
+ *
+ * <p><b>return:</b> polarization at time t, 0 if the distribution is empty or has vanishing weight
+ *
+ * \param t time
+ * \param phase phase (rad)
+ */
+Double_t PFieldDistribution::Polarization(const Double_t t, const Double_t phase) const
+{
+  if (fTotalWeight == 0.0)
+    return 0.0;
+
+  Double_t result = 0.0;
+  for (UInt_t i=0; i<fSegment.size(); i++) {
+    const PSegment &seg = fSegment[i];
+    const Int_t last = static_cast<Int_t>(seg.fAmpl.size())-1;
+    const std::complex<Double_t> z = std::polar(1.0, seg.fDOmega*t);
+    std::complex<Double_t> s(seg.fAmpl[last], 0.0);
+    for (Int_t j=last-1; j>=0; j--)
+      s = s*z + seg.fAmpl[j];
+    result += (std::polar(1.0, seg.fOmega0*t+phase)*s).real();
+  }
+
+  return result/fTotalWeight;
+}
+
+//--------------------------------------------------------------------------
+// Polarization (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Normalized cosine sum on the equidistant time grid t_k = tStart + k*dt, k = 0, ..., n-1.
+ * Large segments are calculated with the chirp-z transform, all others with the Horner recurrence.
+ *
+ * \param tStart first time
+ * \param dt time step
+ * \param n number of times
+ * \param phase phase (rad)
+ * \param pol polarization, resized to n
+ */
+void PFieldDistribution::Polarization(const Double_t tStart, const Double_t dt, const UInt_t n, const Double_t phase, std::vector<Double_t> &pol) const
+{
+  pol.assign(n, 0.0);
+  if ((n == 0) || (fTotalWeight == 0.0))
+    return;
+
+  std::vector<std::complex<Double_t> > sum;
+  for (UInt_t i=0; i<fSegment.size(); i++) {
+    const PSegment &seg = fSegment[i];
+    Bool_t done = false;
+    if ((seg.fAmpl.size() >= fMinChirpZSize) && (n >= fMinChirpZSize))
+      done = SumChirpZ(seg, tStart, dt, n, sum);
+    if (!done)
+      SumHorner(seg, tStart, dt, n, sum);
+    for (UInt_t k=0; k<n; k++) {
+      Double_t t = tStart + static_cast<Double_t>(k)*dt;
+      pol[k] += (std::polar(1.0, seg.fOmega0*t+phase)*sum[k]).real();
+    }
+  }
+
+  for (UInt_t k=0; k<n; k++)
+    pol[k] /= fTotalWeight;
+}
+
+//--------------------------------------------------------------------------
+// SumHorner (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculates \f$S_k = \sum_j a_j z_k^j\f$ with \f$z_k = e^{i\Delta\omega t_k}\f$ for the times
+ * t_k = tStart + k*dt by the Horner recurrence \f$S \to S z_k + a_j\f$.
+ *
+ * \param seg segment of the distribution
+ * \param tStart first time
+ * \param dt time step
+ * \param n number of times
+ * \param sum S_k, resized to n
+ */
+void PFieldDistribution::SumHorner(const PSegment &seg, const Double_t tStart, const Double_t dt, const UInt_t n, std::vector<std::complex<Double_t> > &sum) const
+{
+  sum.resize(n);
+
+  const Int_t last = static_cast<Int_t>(seg.fAmpl.size())-1;
+  for (UInt_t k=0; k<n; k++) {
+    const std::complex<Double_t> z = std::polar(1.0, seg.fDOmega*(tStart + static_cast<Double_t>(k)*dt));
+    std::complex<Double_t> s(seg.fAmpl[last], 0.0);
+    for (Int_t j=last-1; j>=0; j--)
+      s = s*z + seg.fAmpl[j];
+    sum[k] = s;
+  }
+}
+
+//--------------------------------------------------------------------------
+// SumChirpZ (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculates \f$S_k = \sum_j a_j e^{i j\Delta\omega t_k}\f$ for t_k = tStart + k*dt by Bluestein's
+ * chirp-z transform. With \f$\theta = \Delta\omega\,dt\f$ and \f$jk = (j^2 + k^2 - (k-j)^2)/2\f$ the sum
+ * becomes the convolution
+ * \f[ S_k = e^{i\theta k^2/2} \sum_j u_j v_{k-j},\quad u_j = a_j e^{i j\Delta\omega t_0} e^{i\theta j^2/2},\quad v_m = e^{-i\theta m^2/2}, \f]
+ * which is carried out with FFTs of length L >= N+n-1.
+ *
+ * <p><b>return:</b> true if the FFT could be carried out, otherwise false (then sum is undefined)
+ *
+ * \param seg segment of the distribution
+ * \param tStart first time
+ * \param dt time step
+ * \param n number of times
+ * \param sum S_k, resized to n
+ */
+Bool_t PFieldDistribution::SumChirpZ(const PSegment &seg, const Double_t tStart, const Double_t dt, const UInt_t n, std::vector<std::complex<Double_t> > &sum) const
+{
+  const Int_t noOfFreq = static_cast<Int_t>(seg.fAmpl.size());
+  const Int_t noOfTimes = static_cast<Int_t>(n);
+
+  // FFT length: power of 2 >= N+n-1
+  Int_t len = 1;
+  while (len < noOfFreq+noOfTimes-1)
+    len *= 2;
+
+  fftw_complex *uu = static_cast<fftw_complex*>(fftw_malloc(sizeof(fftw_complex)*len));
+  fftw_complex *vv = static_cast<fftw_complex*>(fftw_malloc(sizeof(fftw_complex)*len));
+  if ((uu == nullptr) || (vv == nullptr)) {
+    fftw_free(uu);
+    fftw_free(vv);
+    return false;
+  }
+
+  PFFTPlanManager *planManager = PFFTPlanManager::GetInstance();
+  fftw_plan forward  = planManager->GetPlanDft(1, &len, uu, uu, FFTW_FORWARD, FFTW_ESTIMATE);
+  fftw_plan backward = planManager->GetPlanDft(1, &len, uu, uu, FFTW_BACKWARD, FFTW_ESTIMATE);
+  if ((forward == nullptr) || (backward == nullptr)) {
+    fftw_free(uu);
+    fftw_free(vv);
+    return false;
+  }
+
+  const Double_t halfTheta = 0.5*seg.fDOmega*dt;
+  std::complex<Double_t> val;
+
+  // u_j, zero padded
+  for (Int_t j=0; j<len; j++) {
+    if (j < noOfFreq) {
+      Double_t jj = static_cast<Double_t>(j);
+      val = std::polar(seg.fAmpl[j], jj*seg.fDOmega*tStart + halfTheta*jj*jj);
+    } else {
+      val = 0.0;
+    }
+    uu[j][0] = val.real();
+    uu[j][1] = val.imag();
+  }
+
+  // v_m for m = -(N-1), ..., n-1, stored cyclically
+  for (Int_t m=0; m<len; m++) {
+    vv[m][0] = 0.0;
+    vv[m][1] = 0.0;
+  }
+  for (Int_t m=-(noOfFreq-1); m<noOfTimes; m++) {
+    Double_t mm = static_cast<Double_t>(m);
+    val = std::polar(1.0, -halfTheta*mm*mm);
+    Int_t idx = (m < 0) ? m+len : m;
+    vv[idx][0] = val.real();
+    vv[idx][1] = val.imag();
+  }
+
+  // convolution
+  fftw_execute_dft(forward, uu, uu);
+  fftw_execute_dft(forward, vv, vv);
+  for (Int_t i=0; i<len; i++) {
+    std::complex<Double_t> prod = std::complex<Double_t>(uu[i][0], uu[i][1]) * std::complex<Double_t>(vv[i][0], vv[i][1]);
+    uu[i][0] = prod.real();
+    uu[i][1] = prod.imag();
+  }
+  fftw_execute_dft(backward, uu, uu);
+
+  sum.resize(n);
+  const Double_t norm = 1.0/static_cast<Double_t>(len);
+  for (Int_t k=0; k<noOfTimes; k++) {
+    Double_t kk = static_cast<Double_t>(k);
+    sum[k] = std::polar(norm, halfTheta*kk*kk) * std::complex<Double_t>(uu[k][0], uu[k][1]);
+  }
+
+  fftw_free(uu);
+  fftw_free(vv);
+
+  return true;
+}
@@ -39,6 +39,7 @@
 #include <iomanip>
 #include <fstream>
 #include <limits>
+#include <algorithm>
 
 #include <cmath>
 
@@ -60,13 +61,18 @@
 #include <TCanvas.h>
 #include <TH2.h>
 #include <TFile.h>
+#include <TTree.h>
+#include <TRandom3.h>
 #include <TDatime.h>
 #include <TString.h>
 #include <TObjArray.h>
 #include <TObjString.h>
 
+#include "PPerfMonitor.h"
 #include "PFitter.h"
 
+extern std::vector<void*> gGlobalUserFcn;
+
 
 //+++ PSectorChisq class +++++++++++++++++++++++++++++++++++++++++++++++++++
 
@@ -252,6 +258,322 @@ UInt_t PSectorChisq::GetNDF(UInt_t idx)
   return fNDFRun[idx];
 }
 
+//+++ PBlockArrowMatrix class +++++++++++++++++++++++++++++++++++++++++++++++
+
+//--------------------------------------------------------------------------
+// Constructor
+//--------------------------------------------------------------------------
+/**
+ * <p>Constructor. All elements are set to zero.
+ *
+ * @param noOfGlobal number of global parameters
+ * @param noOfLocal number of local parameters of each block
+ */
+PBlockArrowMatrix::PBlockArrowMatrix(const UInt_t noOfGlobal, const PUIntVector &noOfLocal) :
+  fNoOfGlobal(noOfGlobal), fNoOfLocal(noOfLocal)
+{
+  fGlobalGlobal.resize(fNoOfGlobal*fNoOfGlobal);
+  fLocalLocal.resize(fNoOfLocal.size());
+  fLocalGlobal.resize(fNoOfLocal.size());
+  for (UInt_t i=0; i<fNoOfLocal.size(); i++) {
+    fLocalLocal[i].resize(fNoOfLocal[i]*fNoOfLocal[i]);
+    fLocalGlobal[i].resize(fNoOfLocal[i]*fNoOfGlobal);
+  }
+}
+
+//--------------------------------------------------------------------------
+// Zero
+//--------------------------------------------------------------------------
+/**
+ * <p>Sets all elements to zero.
+ */
+void PBlockArrowMatrix::Zero()
+{
+  std::fill(fGlobalGlobal.begin(), fGlobalGlobal.end(), 0.0);
+  for (UInt_t i=0; i<fNoOfLocal.size(); i++) {
+    std::fill(fLocalLocal[i].begin(), fLocalLocal[i].end(), 0.0);
+    std::fill(fLocalGlobal[i].begin(), fLocalGlobal[i].end(), 0.0);
+  }
+}
+
+//--------------------------------------------------------------------------
+// Factorize (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Factorizes the damped matrix M + lambda diag(M): Cholesky decomposition of the local blocks A,
+ * A^-1 B of the couplings B, and Cholesky decomposition of the Schur complement S = C - B^T A^-1 B
+ * of the global block C.
+ *
+ * <b>return:</b> true if the local blocks and the Schur complement are positive definite, false otherwise.
+ *
+ * @param lambda damping (Levenberg-Marquardt) parameter
+ * @param cholLocal Cholesky decompositions of the local blocks
+ * @param w A^-1 B for each block
+ * @param cholSchur Cholesky decomposition of the Schur complement
+ */
+Bool_t PBlockArrowMatrix::Factorize(const Double_t lambda, std::vector<PDoubleVector> &cholLocal, std::vector<PDoubleVector> &w, PDoubleVector &cholSchur)
+{
+  const UInt_t ng = fNoOfGlobal;
+
+  cholSchur = fGlobalGlobal;
+  for (UInt_t j=0; j<ng; j++)
+    cholSchur[j*ng+j] += lambda*std::fabs(fGlobalGlobal[j*ng+j]);
+
+  cholLocal.resize(fNoOfLocal.size());
+  w.resize(fNoOfLocal.size());
+  PDoubleVector col;
+  for (UInt_t blk=0; blk<fNoOfLocal.size(); blk++) {
+    const UInt_t n = fNoOfLocal[blk];
+    cholLocal[blk] = fLocalLocal[blk];
+    for (UInt_t i=0; i<n; i++)
+      cholLocal[blk][i*n+i] += lambda*std::fabs(fLocalLocal[blk][i*n+i]);
+    if (!CholeskyDecompose(cholLocal[blk], n))
+      return false;
+
+    // w = A^-1 B, column by column
+    w[blk].resize(n*ng);
+    col.resize(n);
+    for (UInt_t j=0; j<ng; j++) {
+      for (UInt_t i=0; i<n; i++)
+        col[i] = fLocalGlobal[blk][i*ng+j];
+      CholeskySolve(cholLocal[blk], n, col.data());
+      for (UInt_t i=0; i<n; i++)
+        w[blk][i*ng+j] = col[i];
+    }
+
+    // S -= B^T A^-1 B
+    for (UInt_t j=0; j<ng; j++) {
+      for (UInt_t k=0; k<ng; k++) {
+        Double_t sum = 0.0;
+        for (UInt_t i=0; i<n; i++)
+          sum += fLocalGlobal[blk][i*ng+j]*w[blk][i*ng+k];
+        cholSchur[j*ng+k] -= sum;
+      }
+    }
+  }
+
+  return CholeskyDecompose(cholSchur, ng);
+}
+
+//--------------------------------------------------------------------------
+// Solve
+//--------------------------------------------------------------------------
+/**
+ * <p>Solves (M + lambda diag(M)) x = rhs. The global part is obtained from the Schur complement,
+ * the local parts by back substitution into the local blocks.
+ *
+ * <b>return:</b> true if the damped matrix is positive definite, false otherwise (x is undefined in this case).
+ *
+ * @param rhsGlobal global part of the right hand side
+ * @param rhsLocal local parts of the right hand side
+ * @param lambda damping (Levenberg-Marquardt) parameter
+ * @param xGlobal global part of the solution
+ * @param xLocal local parts of the solution
+ */
+Bool_t PBlockArrowMatrix::Solve(const PDoubleVector &rhsGlobal, const std::vector<PDoubleVector> &rhsLocal, const Double_t lambda,
+                                PDoubleVector &xGlobal, std::vector<PDoubleVector> &xLocal)
+{
+  const UInt_t ng = fNoOfGlobal;
+  std::vector<PDoubleVector> cholLocal, w;
+  PDoubleVector cholSchur;
+
+  if (!Factorize(lambda, cholLocal, w, cholSchur))
+    return false;
+
+  // y = A^-1 rhs_l, x_g = S^-1 (rhs_g - B^T y)
+  xGlobal = rhsGlobal;
+  xLocal = rhsLocal;
+  for (UInt_t blk=0; blk<fNoOfLocal.size(); blk++) {
+    const UInt_t n = fNoOfLocal[blk];
+    CholeskySolve(cholLocal[blk], n, xLocal[blk].data());
+    for (UInt_t j=0; j<ng; j++) {
+      for (UInt_t i=0; i<n; i++)
+        xGlobal[j] -= fLocalGlobal[blk][i*ng+j]*xLocal[blk][i];
+    }
+  }
+  CholeskySolve(cholSchur, ng, xGlobal.data());
+
+  // x_l = y - A^-1 B x_g
+  for (UInt_t blk=0; blk<fNoOfLocal.size(); blk++) {
+    const UInt_t n = fNoOfLocal[blk];
+    for (UInt_t i=0; i<n; i++) {
+      for (UInt_t j=0; j<ng; j++)
+        xLocal[blk][i] -= w[blk][i*ng+j]*xGlobal[j];
+    }
+  }
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+// InverseDiagonal
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculates the diagonal of the inverse matrix, i.e. up to a factor the parameter variances.
+ * The global part is the diagonal of S^-1, which is identical to the corresponding part of the
+ * inverse of the full matrix. The local parts include the contributions of the global parameters,
+ * i.e. A^-1 + A^-1 B S^-1 B^T A^-1.
+ *
+ * <b>return:</b> true if the matrix is positive definite, false otherwise.
+ *
+ * @param diagGlobal global part of the diagonal
+ * @param diagLocal local parts of the diagonal
+ */
+Bool_t PBlockArrowMatrix::InverseDiagonal(PDoubleVector &diagGlobal, std::vector<PDoubleVector> &diagLocal)
+{
+  const UInt_t ng = fNoOfGlobal;
+  std::vector<PDoubleVector> cholLocal, w;
+  PDoubleVector cholSchur;
+
+  if (!Factorize(0.0, cholLocal, w, cholSchur))
+    return false;
+
+  // S^-1
+  PDoubleVector sInv(ng*ng, 0.0), col;
+  for (UInt_t j=0; j<ng; j++) {
+    col.assign(ng, 0.0);
+    col[j] = 1.0;
+    CholeskySolve(cholSchur, ng, col.data());
+    for (UInt_t k=0; k<ng; k++)
+      sInv[k*ng+j] = col[k];
+  }
+  diagGlobal.resize(ng);
+  for (UInt_t j=0; j<ng; j++)
+    diagGlobal[j] = sInv[j*ng+j];
+
+  diagLocal.resize(fNoOfLocal.size());
+  for (UInt_t blk=0; blk<fNoOfLocal.size(); blk++) {
+    const UInt_t n = fNoOfLocal[blk];
+    diagLocal[blk].resize(n);
+    for (UInt_t i=0; i<n; i++) {
+      col.assign(n, 0.0);
+      col[i] = 1.0;
+      CholeskySolve(cholLocal[blk], n, col.data());
+      Double_t val = col[i];
+      for (UInt_t j=0; j<ng; j++) {
+        for (UInt_t k=0; k<ng; k++)
+          val += w[blk][i*ng+j]*sInv[j*ng+k]*w[blk][i*ng+k];
+      }
+      diagLocal[blk][i] = val;
+    }
+  }
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+// CholeskyDecompose (static)
+//--------------------------------------------------------------------------
+/**
+ * <p>In place Cholesky decomposition A = L L^T of a symmetric n x n matrix (row major). On return the lower
+ * triangle holds L, the upper triangle is left untouched.
+ *
+ * <b>return:</b> true if A is positive definite, false otherwise.
+ *
+ * @param a matrix to be decomposed
+ * @param n dimension of the matrix
+ */
+Bool_t PBlockArrowMatrix::CholeskyDecompose(PDoubleVector &a, const UInt_t n)
+{
+  for (UInt_t j=0; j<n; j++) {
+    Double_t d = a[j*n+j];
+    for (UInt_t k=0; k<j; k++)
+      d -= a[j*n+k]*a[j*n+k];
+    if (!(d > 0.0)) // also catches nan's
+      return false;
+    a[j*n+j] = sqrt(d);
+    for (UInt_t i=j+1; i<n; i++) {
+      Double_t sum = a[i*n+j];
+      for (UInt_t k=0; k<j; k++)
+        sum -= a[i*n+k]*a[j*n+k];
+      a[i*n+j] = sum/a[j*n+j];
+    }
+  }
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+// CholeskySolve (static)
+//--------------------------------------------------------------------------
+/**
+ * <p>Solves L L^T x = b in place, where L is the Cholesky decomposition obtained from CholeskyDecompose.
+ *
+ * @param l Cholesky decomposition (lower triangle, row major)
+ * @param n dimension of the matrix
+ * @param x on input b, on return the solution x
+ */
+void PBlockArrowMatrix::CholeskySolve(const PDoubleVector &l, const UInt_t n, Double_t *x)
+{
+  for (UInt_t i=0; i<n; i++) {
+    for (UInt_t k=0; k<i; k++)
+      x[i] -= l[i*n+k]*x[k];
+    x[i] /= l[i*n+i];
+  }
+  for (Int_t i=static_cast<Int_t>(n)-1; i>=0; i--) {
+    for (UInt_t k=i+1; k<n; k++)
+      x[i] -= l[k*n+i]*x[k];
+    x[i] /= l[i*n+i];
+  }
+}
+
+//+++ PFitterWorker class +++++++++++++++++++++++++++++++++++++++++++++++++
+
+//--------------------------------------------------------------------------
+// Constructor
+//--------------------------------------------------------------------------
+/**
+ * <p>Constructor. Copies the in-memory msr-file handler of the main fit (current parameters,
+ * fit ranges, packing, etc.), such that functions and theories are independent of the ones of
+ * the main fit, and prepares all runs from the raw data of runListCollection with its current
+ * fit ranges.
+ *
+ * \param runInfo pointer of the msr-file handler of the main fit
+ * \param runListCollection pointer of the run list collection of the main fit
+ * \param useChi2 flag: true=chisq, false=log max-likelihood
+ */
+PFitterWorker::PFitterWorker(PMsrHandler *runInfo, PRunListCollection *runListCollection, const Bool_t useChi2) :
+  fValid(false), fRunInfo(nullptr), fRunListCollection(nullptr), fFitterFcn(nullptr)
+{
+  fRunInfo = new PMsrHandler(*runInfo);
+
+  fRunListCollection = new PRunListCollection(fRunInfo, runListCollection->GetDataHandler());
+  for (UInt_t i=0; i<fRunInfo->GetMsrRunList()->size(); i++) {
+    if (!fRunListCollection->Add(i, kFit)) {
+      std::cerr << std::endl << ">> PFitterWorker::PFitterWorker(): **ERROR** couldn't handle run no " << i+1;
+      std::cerr << std::endl;
+      return;
+    }
+  }
+  fRunListCollection->SetFitRange(runListCollection->GetFitRange());
+
+  fFitterFcn = new PFitterFcn(fRunListCollection, useChi2);
+
+  fValid = true;
+}
+
+//--------------------------------------------------------------------------
+// Destructor
+//--------------------------------------------------------------------------
+/**
+ * <p>Destructor.
+ */
+PFitterWorker::~PFitterWorker()
+{
+  if (fFitterFcn) {
+    delete fFitterFcn;
+    fFitterFcn = nullptr;
+  }
+  if (fRunListCollection) {
+    delete fRunListCollection;
+    fRunListCollection = nullptr;
+  }
+  if (fRunInfo) {
+    delete fRunInfo;
+    fRunInfo = nullptr;
+  }
+}
+
 //+++ PFitter class ++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 //--------------------------------------------------------------------------
@@ -753,6 +1075,15 @@ Bool_t PFitter::DoFit()
         std::cerr << std::endl << "**WARNING** from PFitter::DoFit() : the command INTERACTIVE is not yet implemented.";
         std::cerr << std::endl;
         break;
+      case PMN_BLOCK_MINIMIZE:
+        status = ExecuteBlockMinimize();
+        break;
+      case PMN_BOOTSTRAP:
+        status = ExecuteBootstrap(fCmdList[i].second);
+        break;
+      case PMN_MCMC:
+        status = ExecuteMcmc(fCmdList[i].second);
+        break;
       case PMN_CONTOURS:
         status = ExecuteContours();
         break;
@@ -766,6 +1097,9 @@ Bool_t PFitter::DoFit()
         std::cerr  << std::endl << "**WARNING** from PFitter::DoFit() : the command EIGEN is not yet implemented.";
         std::cerr  << std::endl;
         break;
+      case PMN_LEAST_SQUARES:
+        status = ExecuteLeastSquares();
+        break;
       case PMN_HESSE:
         status = ExecuteHesse();
         break;
@@ -886,6 +1220,15 @@ Bool_t PFitter::CheckCommands()
       cmd.first  = PMN_INTERACTIVE;
       cmd.second = cmdLineNo;
       fCmdList.push_back(cmd);
+    } else if (line.Contains("BOOTSTRAP", TString::kIgnoreCase)) {
+      cmd.first  = PMN_BOOTSTRAP;
+      cmd.second = cmdLineNo;
+      fCmdList.push_back(cmd);
+    } else if (line.Contains("MCMC", TString::kIgnoreCase)) {
+      fIsScanOnly = false; // the diagnostics go to the mlog-file
+      cmd.first  = PMN_MCMC;
+      cmd.second = cmdLineNo;
+      fCmdList.push_back(cmd);
     } else if (line.Contains("CONTOURS", TString::kIgnoreCase)) {
       cmd.first  = PMN_CONTOURS;
       cmd.second = cmdLineNo;
@@ -1139,6 +1482,11 @@ Bool_t PFitter::CheckCommands()
       cmd.first  = PMN_FIX;
       cmd.second = cmdLineNo;
       fCmdList.push_back(cmd);
+    } else if (line.Contains("LEAST_SQUARES", TString::kIgnoreCase)) {
+      fIsScanOnly = false;
+      cmd.first  = PMN_LEAST_SQUARES;
+      cmd.second = cmdLineNo;
+      fCmdList.push_back(cmd);
     } else if (line.Contains("HESSE", TString::kIgnoreCase)) {
       fIsScanOnly = false;
       cmd.first  = PMN_HESSE;
@@ -1153,6 +1501,11 @@ Bool_t PFitter::CheckCommands()
       cmd.first  = PMN_MIGRAD;
       cmd.second = cmdLineNo;
       fCmdList.push_back(cmd);
+    } else if (line.Contains("BLOCK_MINIMIZE", TString::kIgnoreCase)) { // has to be checked before MINIMIZE
+      fIsScanOnly = false;
+      cmd.first  = PMN_BLOCK_MINIMIZE;
+      cmd.second = cmdLineNo;
+      fCmdList.push_back(cmd);
     } else if (line.Contains("MINIMIZE", TString::kIgnoreCase)) {
       fIsScanOnly = false;
       cmd.first  = PMN_MINIMIZE;
@@ -1572,6 +1925,711 @@ Bool_t PFitter::SetParameters()
   return true;
 }
 
+//--------------------------------------------------------------------------
+// ExecuteBlockMinimize
+//--------------------------------------------------------------------------
+/**
+ * <p>Minimizer for global fits with many run blocks, as e.g. generated by msr2data in the global mode.
+ * The free parameters are split into local parameters, which are used by a single run block only
+ * (N0, background, asymmetry, ... of this run), and global parameters, which are shared by several
+ * run blocks. The Hessian of chisq/maxLH has then block-arrow structure, since local parameters of
+ * different run blocks do not couple. It is assembled from finite differences of the chisq/maxLH of
+ * the single run blocks, each with respect to its own parameters only, and the damped Newton
+ * (Levenberg-Marquardt) steps are obtained via the Schur complement (see PBlockArrowMatrix).
+ * Hence the effort per iteration grows linearly with the number of run blocks rather than quadratically
+ * as for MIGRAD. Parameter limits are handled with the minuit2 parameter transformations.
+ *
+ * <p>The errors are the parabolic errors from the inverse Hessian at the minimum. The errors of the global
+ * parameters include their correlations with all local parameters, i.e. they correspond to the HESSE errors.
+ * Since there is no minuit2 function minimum, MINOS, CONTOURS and SAVE are only available if another
+ * minimizer is called after BLOCK_MINIMIZE.
+ *
+ * <p>For LEAST_SQUARES the Hessian is taken in the Gauss-Newton approximation \f$ 2 J^T J \f$ instead,
+ * where \f$ J \f$ is the Jacobian of the normalized residuals of the run blocks (see ExecuteLeastSquares).
+ *
+ * <b>return:</b> true if the block minimizer converged, otherwise returns false.
+ *
+ * \param leastSquares if true, use the Gauss-Newton Hessian from the residual Jacobians (chisq only)
+ */
+Bool_t PFitter::ExecuteBlockMinimize(const Bool_t leastSquares)
+{
+  if (leastSquares)
+    std::cout << ">> PFitter::ExecuteBlockMinimize(): will call the Gauss-Newton least-squares minimizer ..." << std::endl;
+  else
+    std::cout << ">> PFitter::ExecuteBlockMinimize(): will call the block minimizer ..." << std::endl;
+
+  const UInt_t maxIter = 100;
+  const Double_t up = fFitterFcn->Up();
+  const Double_t edmTarget = 0.002*0.1*up; // as minuit2 for the default tolerance 0.1
+  const Double_t relStep = 0.1; // finite difference step in units of the parameter error
+  const UInt_t noOfRuns = fRunInfo->GetMsrRunList()->size();
+
+  // keep track of elapsed time
+  Double_t start=0.0, end=0.0;
+  static const std::string perfKeyBlock("fitter/block_minimize");
+  static const std::string perfKeyLeastSquares("fitter/least_squares");
+  PPerfTimer perfTimer(leastSquares ? perfKeyLeastSquares : perfKeyBlock);
+  start = MilliTime();
+
+  // sort the free parameters into local and global ones
+  std::vector<PUIntVector> runParams(noOfRuns);
+  PUIntVector useCount(fParams.size(), 0);
+  for (UInt_t i=0; i<noOfRuns; i++) {
+    runParams[i] = fRunInfo->GetRunBlockParameters(i);
+    for (UInt_t j=0; j<runParams[i].size(); j++)
+      useCount[runParams[i][j]-1]++;
+  }
+
+  PUIntVector freeParams;   // parameter indices of all free parameters
+  PUIntVector globalParams; // parameter indices of the global parameters
+  std::vector<PUIntVector> localParams(noOfRuns); // parameter indices of the local parameters of each run block
+  std::vector<PUIntVector> runGlobal(noOfRuns);   // positions in globalParams of the global parameters used by each run block
+  for (UInt_t i=0; i<fParams.size(); i++) {
+    if (fMnUserParams.Parameters().at(i).IsFixed() || fMnUserParams.Parameters().at(i).IsConst())
+      continue;
+    if (useCount[i] == 0) { // no run block depends on it, i.e. its Hessian row vanishes: fix it
+      fMnUserParams.Fix(i);
+      std::cerr << std::endl << ">> PFitter::ExecuteBlockMinimize(): **WARNING** Parameter No " << i+1 << " is not used in any run block, will fix it";
+      std::cerr << std::endl;
+      continue;
+    }
+    freeParams.push_back(i);
+    if (useCount[i] == 1) { // local parameter
+      for (UInt_t j=0; j<noOfRuns; j++) {
+        if (std::find(runParams[j].begin(), runParams[j].end(), i+1) != runParams[j].end()) {
+          localParams[j].push_back(i);
+          break;
+        }
+      }
+    } else { // global parameter
+      for (UInt_t j=0; j<noOfRuns; j++) {
+        if (std::find(runParams[j].begin(), runParams[j].end(), i+1) != runParams[j].end())
+          runGlobal[j].push_back(globalParams.size());
+      }
+      globalParams.push_back(i);
+    }
+  }
+
+  if (freeParams.empty()) {
+    std::cerr << std::endl << ">> PFitter::ExecuteBlockMinimize(): **WARNING** no free parameters, nothing to be minimized.";
+    std::cerr << std::endl;
+    return false;
+  }
+
+  PUIntVector noOfLocal(noOfRuns);
+  for (UInt_t i=0; i<noOfRuns; i++)
+    noOfLocal[i] = localParams[i].size();
+  std::cout << ">> PFitter::ExecuteBlockMinimize(): " << globalParams.size() << " global and " << freeParams.size()-globalParams.size();
+  std::cout << " local parameters in " << noOfRuns << " run blocks." << std::endl;
+
+  // internal (unbounded) parameter values and finite difference steps
+  PDoubleVector par = fMnUserParams.Params();
+  PDoubleVector intPar(fParams.size(), 0.0), intStep(fParams.size(), 0.0);
+  for (UInt_t k=0; k<freeParams.size(); k++) {
+    const UInt_t i = freeParams[k];
+    const Double_t dext = relStep*fMnUserParams.Error(i);
+    intPar[i] = Ext2Int(i, par[i]);
+    par[i] = Int2Ext(i, intPar[i]);
+    intStep[i] = 0.5*(std::fabs(Ext2Int(i, par[i]+dext)-intPar[i]) + std::fabs(Ext2Int(i, par[i]-dext)-intPar[i]));
+    if (!(intStep[i] > 1.0e-8*(1.0+std::fabs(intPar[i]))))
+      intStep[i] = 1.0e-8*(1.0+std::fabs(intPar[i]));
+  }
+
+  PBlockArrowMatrix hesse(globalParams.size(), noOfLocal);
+  PDoubleVector grad(fParams.size(), 0.0); // gradient with respect to the internal parameters
+  ULong64_t noOfEval = 0;
+
+  // chisq/maxLH of all run blocks
+  auto fcnValue = [&](const PDoubleVector &p) {
+    Double_t val = 0.0;
+    for (UInt_t r=0; r<noOfRuns; r++)
+      val += GetRunBlockFcnValue(p, r);
+    noOfEval += noOfRuns;
+    return val;
+  };
+
+  // adds the Hessian element of the a-th and b-th variable (b >= a) of run block r, where the variables
+  // of a run block are its global parameters followed by its local parameters
+  auto addHesse = [&](const UInt_t r, const UInt_t a, const UInt_t b, const Double_t h) {
+    const UInt_t ng = runGlobal[r].size();
+    if (b < ng) { // global/global
+      hesse.GlobalGlobal(runGlobal[r][a], runGlobal[r][b]) += h;
+      if (a != b)
+        hesse.GlobalGlobal(runGlobal[r][b], runGlobal[r][a]) += h;
+    } else if (a < ng) { // global/local
+      hesse.LocalGlobal(r, b-ng, runGlobal[r][a]) = h;
+    } else { // local/local
+      hesse.LocalLocal(r, a-ng, b-ng) = h;
+      hesse.LocalLocal(r, b-ng, a-ng) = h;
+    }
+  };
+
+  // gradient and block-arrow Hessian from the finite differences of the single run blocks, returns chisq/maxLH
+  auto derivatives = [&]() {
+    Double_t val = 0.0;
+    PDoubleVector x = par;
+    hesse.Zero();
+    std::fill(grad.begin(), grad.end(), 0.0);
+    for (UInt_t r=0; r<noOfRuns; r++) {
+      PUIntVector var;
+      for (UInt_t k=0; k<runGlobal[r].size(); k++)
+        var.push_back(globalParams[runGlobal[r][k]]);
+      var.insert(var.end(), localParams[r].begin(), localParams[r].end());
+      const UInt_t n = var.size();
+
+      Double_t f0 = GetRunBlockFcnValue(par, r);
+      val += f0;
+      noOfEval++;
+      if (n == 0)
+        continue;
+
+      // five-point stencil for the gradient, otherwise its truncation error summed over many parameters
+      // would dominate the estimated distance to the minimum
+      PDoubleVector fp(n), fm(n);
+      Double_t fpp, fmm;
+      for (UInt_t a=0; a<n; a++) {
+        const UInt_t ia = var[a];
+        x[ia] = Int2Ext(ia, intPar[ia]+intStep[ia]);
+        fp[a] = GetRunBlockFcnValue(x, r);
+        x[ia] = Int2Ext(ia, intPar[ia]-intStep[ia]);
+        fm[a] = GetRunBlockFcnValue(x, r);
+        x[ia] = Int2Ext(ia, intPar[ia]+2.0*intStep[ia]);
+        fpp = GetRunBlockFcnValue(x, r);
+        x[ia] = Int2Ext(ia, intPar[ia]-2.0*intStep[ia]);
+        fmm = GetRunBlockFcnValue(x, r);
+        x[ia] = par[ia];
+        grad[ia] += (fmm-8.0*fm[a]+8.0*fp[a]-fpp)/(12.0*intStep[ia]);
+      }
+      noOfEval += 4*n;
+
+      for (UInt_t a=0; a<n; a++) {
+        const UInt_t ia = var[a];
+        for (UInt_t b=a; b<n; b++) {
+          const UInt_t ib = var[b];
+          Double_t h;
+          if (a == b) {
+            h = (fp[a]+fm[a]-2.0*f0)/(intStep[ia]*intStep[ia]);
+          } else {
+            x[ia] = Int2Ext(ia, intPar[ia]+intStep[ia]);
+            x[ib] = Int2Ext(ib, intPar[ib]+intStep[ib]);
+            h = (GetRunBlockFcnValue(x, r)-fp[a]-fp[b]+f0)/(intStep[ia]*intStep[ib]);
+            x[ia] = par[ia];
+            x[ib] = par[ib];
+            noOfEval++;
+          }
+          addHesse(r, a, b, h);
+        }
+      }
+    }
+    return val;
+  };
+
+  // gradient 2 J^T res and Gauss-Newton Hessian 2 J^T J from the Jacobian J of the normalized residuals res
+  // of the single run blocks, returns chisq
+  auto gaussNewton = [&]() {
+    Double_t val = 0.0;
+    PDoubleVector x = par;
+    PDoubleVector res0, resm;
+    hesse.Zero();
+    std::fill(grad.begin(), grad.end(), 0.0);
+    for (UInt_t r=0; r<noOfRuns; r++) {
+      PUIntVector var;
+      for (UInt_t k=0; k<runGlobal[r].size(); k++)
+        var.push_back(globalParams[runGlobal[r][k]]);
+      var.insert(var.end(), localParams[r].begin(), localParams[r].end());
+      const Int_t n = var.size();
+
+      fRunListCollection->GetSingleRunResiduals(par, r, res0);
+      for (UInt_t j=0; j<res0.size(); j++)
+        val += res0[j]*res0[j];
+      noOfEval++;
+      if (n == 0)
+        continue;
+
+      // central differences of the residuals, column by column
+      std::vector<PDoubleVector> jac(n);
+      for (Int_t a=0; a<n; a++) {
+        const UInt_t ia = var[a];
+        x[ia] = Int2Ext(ia, intPar[ia]+intStep[ia]);
+        fRunListCollection->GetSingleRunResiduals(x, r, jac[a]);
+        x[ia] = Int2Ext(ia, intPar[ia]-intStep[ia]);
+        fRunListCollection->GetSingleRunResiduals(x, r, resm);
+        x[ia] = par[ia];
+        for (UInt_t j=0; j<res0.size(); j++)
+          jac[a][j] = (jac[a][j]-resm[j])/(2.0*intStep[ia]);
+      }
+      noOfEval += 2*n;
+
+      // J^T res and J^T J of the run block. Each column pair is written to its own matrix element.
+      Int_t a;
+      #ifdef HAVE_GOMP
+      #pragma omp parallel for default(shared) private(a) schedule(dynamic)
+      #endif
+      for (a=0; a<n; a++) {
+        Double_t sum = 0.0;
+        for (UInt_t j=0; j<res0.size(); j++)
+          sum += jac[a][j]*res0[j];
+        grad[var[a]] += 2.0*sum;
+        for (Int_t b=a; b<n; b++) {
+          sum = 0.0;
+          for (UInt_t j=0; j<res0.size(); j++)
+            sum += jac[a][j]*jac[b][j];
+          addHesse(r, a, b, 2.0*sum);
+        }
+      }
+    }
+    return val;
+  };
+
+  // splits a vector indexed by the parameter index into the global and local parts, and vice versa
+  auto split = [&](const PDoubleVector &v, PDoubleVector &vGlobal, std::vector<PDoubleVector> &vLocal) {
+    vGlobal.resize(globalParams.size());
+    for (UInt_t k=0; k<globalParams.size(); k++)
+      vGlobal[k] = v[globalParams[k]];
+    vLocal.resize(noOfRuns);
+    for (UInt_t r=0; r<noOfRuns; r++) {
+      vLocal[r].resize(localParams[r].size());
+      for (UInt_t k=0; k<localParams[r].size(); k++)
+        vLocal[r][k] = v[localParams[r][k]];
+    }
+  };
+  auto merge = [&](const PDoubleVector &vGlobal, const std::vector<PDoubleVector> &vLocal, PDoubleVector &v) {
+    v.assign(fParams.size(), 0.0);
+    for (UInt_t k=0; k<globalParams.size(); k++)
+      v[globalParams[k]] = vGlobal[k];
+    for (UInt_t r=0; r<noOfRuns; r++) {
+      for (UInt_t k=0; k<localParams[r].size(); k++)
+        v[localParams[r][k]] = vLocal[r][k];
+    }
+  };
+
+  // parabolic errors of the internal parameters, i.e. sqrt(2 up diag(H^-1))
+  auto internalErrors = [&](PDoubleVector &err) {
+    PDoubleVector diagGlobal;
+    std::vector<PDoubleVector> diagLocal;
+    if (!hesse.InverseDiagonal(diagGlobal, diagLocal))
+      return false;
+    merge(diagGlobal, diagLocal, err);
+    for (UInt_t k=0; k<freeParams.size(); k++)
+      err[freeParams[k]] = sqrt(2.0*up*err[freeParams[k]]);
+    return true;
+  };
+
+  // damped Newton iterations
+  Double_t fval = 0.0, edm = -1.0, lambda = 1.0e-3;
+  Bool_t converged = false;
+  UInt_t iter;
+  PDoubleVector rhsGlobal, stepGlobal, step, intErr;
+  std::vector<PDoubleVector> rhsLocal, stepLocal;
+  for (iter=0; iter<maxIter; iter++) {
+    if (leastSquares)
+      fval = gaussNewton();
+    else
+      fval = derivatives();
+
+    PDoubleVector negGrad(grad);
+    for (UInt_t i=0; i<negGrad.size(); i++)
+      negGrad[i] = -negGrad[i];
+    split(negGrad, rhsGlobal, rhsLocal);
+
+    // estimated distance to the minimum from the undamped Newton step
+    edm = -1.0;
+    if (hesse.Solve(rhsGlobal, rhsLocal, 0.0, stepGlobal, stepLocal)) {
+      merge(stepGlobal, stepLocal, step);
+      edm = 0.0;
+      for (UInt_t k=0; k<freeParams.size(); k++)
+        edm -= 0.5*grad[freeParams[k]]*step[freeParams[k]];
+      // adapt the finite difference steps to the current error estimates
+      if (internalErrors(intErr)) {
+        for (UInt_t k=0; k<freeParams.size(); k++) {
+          const UInt_t i = freeParams[k];
+          Double_t newStep = relStep*intErr[i];
+          if (newStep > 0.0) // limit the change per iteration, since far from the minimum the errors are poorly estimated
+            intStep[i] = std::min(std::max(newStep, 0.1*intStep[i]), 10.0*intStep[i]);
+        }
+      }
+    }
+
+    if (fPrintLevel >= 2) {
+      std::cout << ">> PFitter::ExecuteBlockMinimize(): iteration " << iter << ": fval = " << std::setprecision(10) << fval;
+      std::cout << ", edm = " << std::setprecision(3) << edm << ", lambda = " << lambda << std::endl;
+    }
+
+    if ((edm >= 0.0) && (edm < edmTarget)) {
+      converged = true;
+      break;
+    }
+
+    // damped step which reduces chisq/maxLH
+    Bool_t accepted = false;
+    while (lambda < 1.0e10) {
+      if (hesse.Solve(rhsGlobal, rhsLocal, lambda, stepGlobal, stepLocal)) {
+        merge(stepGlobal, stepLocal, step);
+        PDoubleVector trialIntPar(intPar), trialPar(par);
+        for (UInt_t k=0; k<freeParams.size(); k++) {
+          const UInt_t i = freeParams[k];
+          trialIntPar[i] += step[i];
+          trialPar[i] = Int2Ext(i, trialIntPar[i]);
+        }
+        if (fcnValue(trialPar) < fval) {
+          intPar = trialIntPar;
+          par = trialPar;
+          lambda = std::max(0.1*lambda, 1.0e-9);
+          accepted = true;
+          break;
+        }
+      }
+      lambda *= 10.0;
+    }
+
+    if (!accepted) { // chisq/maxLH cannot be reduced any further within the numerical precision
+      converged = (edm >= 0.0) && (edm < 10.0*edmTarget);
+      break;
+    }
+  }
+
+  if (converged && !internalErrors(intErr)) {
+    std::cerr << std::endl << ">> PFitter::ExecuteBlockMinimize(): **WARNING** Hessian is not positive definite, no errors available.";
+    converged = false;
+  }
+
+  end = MilliTime();
+  perfTimer.Stop();
+  std::cout << ">> PFitter::ExecuteBlockMinimize(): " << iter << " iterations, " << noOfEval << " run block evaluations." << std::endl;
+  std::cout << ">> PFitter::ExecuteBlockMinimize(): execution time for BlockMinimize = " << std::setprecision(3) << (end-start)/1.0e3 << " sec." << std::endl;
+  TString str = TString::Format("%s: %.3f sec", leastSquares ? "LeastSq" : "BlockMin", (end-start)/1.0e3);
+  fElapsedTime.push_back(str);
+  if (!converged) {
+    std::cerr << std::endl << ">> PFitter::ExecuteBlockMinimize(): **WARNING**: Fit did not converge (edm=" << edm << "), sorry ...";
+    std::cerr << std::endl;
+    fIsValid = false;
+    return false;
+  }
+
+  // the minuit2 function minimum does not belong to the current parameters anymore
+  if (fFcnMin) {
+    delete fFcnMin;
+    fFcnMin = nullptr;
+  }
+
+  // keep user parameters and fill run info
+  for (UInt_t k=0; k<freeParams.size(); k++) {
+    const UInt_t i = freeParams[k];
+    Double_t err = intErr[i]*std::fabs(DInt2Ext(i, intPar[i]));
+    fMnUserParams.SetValue(i, par[i]);
+    fMnUserParams.SetError(i, err);
+
+    Double_t dval = par[i];
+    if (fPhase[i]) {
+      Int_t m = (Int_t)(dval/360.0);
+      dval = dval - m*360.0;
+    }
+    fRunInfo->SetMsrParamValue(i, dval);
+    fRunInfo->SetMsrParamStep(i, err);
+    fRunInfo->SetMsrParamPosErrorPresent(i, false);
+  }
+
+  // handle statistics
+  Double_t minVal = (*fFitterFcn)(par);
+  UInt_t ndf = fFitterFcn->GetTotalNoOfFittedBins() - freeParams.size();
+
+  // feed run info with new statistics info
+  fRunInfo->SetMsrStatisticMin(minVal);
+  fRunInfo->SetMsrStatisticNdf(ndf);
+
+  fConverged = true;
+
+  if (fPrintLevel >= 2)
+    std::cout << fMnUserParams << std::endl;
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+// ExecuteLeastSquares
+//--------------------------------------------------------------------------
+/**
+ * <p>Levenberg-Marquardt least-squares fit. Rather than on the summed chisq, it works on the normalized
+ * residuals (data-theory)/error of all fitted bins of each run block (PRunBase::CalcResiduals), whose
+ * Jacobian is obtained from central differences with respect to the parameters of the run block only.
+ * The Gauss-Newton Hessian \f$ 2 J^T J \f$ needs no second derivatives, hence for well conditioned
+ * problems only a few residual passes per parameter and iteration are needed. The iterations, the
+ * local/global parameter split and the errors are the same as for BLOCK_MINIMIZE (see ExecuteBlockMinimize).
+ *
+ * <p>Only available for chisq fits.
+ *
+ * <b>return:</b> true if the least-squares fit converged, otherwise returns false.
+ */
+Bool_t PFitter::ExecuteLeastSquares()
+{
+  std::cout << ">> PFitter::ExecuteLeastSquares() ..." << std::endl;
+
+  if (!fUseChi2) {
+    std::cerr << std::endl << ">> PFitter::ExecuteLeastSquares(): **ERROR** LEAST_SQUARES is only available for chisq fits, not for MAX_LIKELIHOOD.";
+    std::cerr << std::endl;
+    return false;
+  }
+
+  return ExecuteBlockMinimize(true);
+}
+
+//--------------------------------------------------------------------------
+// ExecuteBootstrap
+//--------------------------------------------------------------------------
+/**
+ * <p>Bootstrap resp. Monte Carlo error estimate: BOOTSTRAP <n> [MC|RESAMPLE] [<seed>]
+ *
+ * <p>Fits (MIGRAD) n replicas of the data, starting from the best fit. Each replica is generated
+ * around the theory of the best fit (see PRunBase::ResampleData):
+ * - MC (default): counting data are drawn from a Poisson distribution, all others from a Gaussian.
+ * - RESAMPLE: residual bootstrap, i.e. the normalized residuals of the best fit are drawn with replacement.
+ *
+ * <p>Replica i uses the random seed <seed>+i+1, hence the result does not depend on the number of threads.
+ * The replicas are distributed over the threads. The first thread uses the run list collection of the fit,
+ * all others an own evaluation state (PFitterWorker) sharing the raw data. Only the data are replaced by a
+ * replica, the fit ranges etc. are unchanged. If a user function with a global part is present, the
+ * replicas are fitted serially, since the global part is shared by all theories. The same holds if a
+ * user function does not declare itself reentrant (see PUserFcnBase::IsReentrant).
+ *
+ * <p>Mean, standard deviation and percentiles of the free parameters are printed, and together with all
+ * replicas written to <msr-file-name>_bootstrap.root (trees 'replicas' and 'percentiles'). The best fit
+ * itself, i.e. parameters, errors and statistics, is not changed.
+ *
+ * \param lineNo the line number of the command block
+ *
+ * <b>return:</b> true if done, otherwise returns false.
+ */
+Bool_t PFitter::ExecuteBootstrap(UInt_t lineNo)
+{
+  std::cout << ">> PFitter::ExecuteBootstrap(): " << fCmdLines[lineNo].fLine.Data() << std::endl;
+
+  // the replicas are generated around the best fit, hence a converged fit is needed
+  if (!fConverged || !fFcnMin) {
+    std::cerr << std::endl << ">> PFitter::ExecuteBootstrap(): **ERROR** BOOTSTRAP needs a converged fit, i.e. MIGRAD, MINIMIZE, ... before.";
+    std::cerr << std::endl;
+    return false;
+  }
+
+  // get the number of replicas, the mode and the seed
+  TObjArray *tokens = nullptr;
+  TObjString *ostr;
+  TString str;
+  UInt_t noOfReplicas = 0;
+  UInt_t mode = PRUN_RESAMPLE_MC;
+  UInt_t seed = 0;
+  Bool_t syntaxOk = true;
+
+  tokens = fCmdLines[lineNo].fLine.Tokenize(", \t");
+  if (tokens->GetEntries() < 2)
+    syntaxOk = false;
+  for (Int_t i=1; syntaxOk && (i<tokens->GetEntries()); i++) {
+    ostr = (TObjString*)tokens->At(i);
+    str = ostr->GetString();
+    if (i == 1) {
+      if (str.IsDigit() && (str.Atoi() > 0))
+        noOfReplicas = str.Atoi();
+      else
+        syntaxOk = false;
+    } else if (!str.CompareTo("MC", TString::kIgnoreCase)) {
+      mode = PRUN_RESAMPLE_MC;
+    } else if (!str.CompareTo("RESAMPLE", TString::kIgnoreCase)) {
+      mode = PRUN_RESAMPLE_BINS;
+    } else if (str.IsDigit()) {
+      seed = static_cast<UInt_t>(str.Atoll());
+    } else {
+      syntaxOk = false;
+    }
+  }
+
+  // clean up
+  if (tokens) {
+    delete tokens;
+    tokens = nullptr;
+  }
+
+  if (!syntaxOk) {
+    std::cerr << std::endl << "**ERROR** from PFitter::ExecuteBootstrap(): SYNTAX: BOOTSTRAP <n> [MC|RESAMPLE] [<seed>], where <n> > 0 is the number of replicas";
+    std::cerr << std::endl << std::endl;
+    return false;
+  }
+
+  // keep track of elapsed time
+  Double_t start=0.0, end=0.0;
+  static const std::string perfKey("fitter/bootstrap");
+  PPerfTimer perfTimer(perfKey);
+  start=MilliTime();
+
+  // evaluation state of each thread: thread 0 uses the one of the fit
+  Int_t noOfThreads = 1;
+#ifdef HAVE_GOMP
+  noOfThreads = omp_get_max_threads();
+  if (noOfThreads > static_cast<Int_t>(noOfReplicas))
+    noOfThreads = noOfReplicas;
+  for (UInt_t i=0; i<gGlobalUserFcn.size(); i++) {
+    if (gGlobalUserFcn[i] != nullptr) {
+      std::cout << ">> PFitter::ExecuteBootstrap(): user function with global part present, will fit the replicas serially." << std::endl;
+      noOfThreads = 1;
+      break;
+    }
+  }
+  if ((noOfThreads > 1) && !fRunListCollection->IsTheoryReentrant()) {
+    std::cout << ">> PFitter::ExecuteBootstrap(): user function which is not reentrant present, will fit the replicas serially." << std::endl;
+    noOfThreads = 1;
+  }
+#endif
+  std::vector<PFitterWorker*> worker;
+  std::vector<PRunListCollection*> runList(1, fRunListCollection);
+  std::vector<PFitterFcn*> fcn(1, fFitterFcn);
+  for (Int_t i=1; i<noOfThreads; i++) {
+    PFitterWorker *w = new PFitterWorker(fRunInfo, fRunListCollection, fUseChi2);
+    if (!w->IsValid()) {
+      std::cerr << std::endl << ">> PFitter::ExecuteBootstrap(): **WARNING** couldn't create the evaluation state of thread " << i << ", will use " << i << " thread(s) only.";
+      std::cerr << std::endl;
+      delete w;
+      break;
+    }
+    worker.push_back(w);
+    runList.push_back(w->GetRunListCollection());
+    fcn.push_back(w->GetFitterFcn());
+  }
+  noOfThreads = fcn.size();
+  std::cout << ">> PFitter::ExecuteBootstrap(): will fit " << noOfReplicas << " replicas using " << noOfThreads << " thread(s) ..." << std::endl;
+
+  // fit the replicas
+  const std::vector<Double_t> bestPar = fMnUserParams.Params();
+  const UInt_t noOfParams = bestPar.size();
+  PDoubleVector replicaPar(noOfReplicas*noOfParams, 0.0);
+  PDoubleVector replicaFcn(noOfReplicas, 0.0);
+  PIntVector replicaValid(noOfReplicas, 0);
+  Int_t i;
+  #ifdef HAVE_GOMP
+  #pragma omp parallel for default(shared) private(i) schedule(dynamic) num_threads(noOfThreads)
+  #endif
+  for (i=0; i<static_cast<Int_t>(noOfReplicas); i++) {
+    Int_t tid = 0;
+    #ifdef HAVE_GOMP
+    tid = omp_get_thread_num();
+    #endif
+    TRandom3 rnd(seed+i+1);
+    runList[tid]->ResampleData(bestPar, mode, rnd);
+
+    ROOT::Minuit2::MnMigrad migrad((*fcn[tid]), fMnUserParams, fStrategy);
+    ROOT::Minuit2::FunctionMinimum min = migrad(std::numeric_limits<UInt_t>::max(), 0.1);
+    for (UInt_t j=0; j<noOfParams; j++)
+      replicaPar[i*noOfParams+j] = min.UserState().Value(j);
+    replicaFcn[i] = min.Fval();
+    replicaValid[i] = min.IsValid() ? 1 : 0;
+  }
+
+  // restore the data of the fit and clean up
+  fRunListCollection->RestoreData();
+  for (UInt_t j=0; j<worker.size(); j++)
+    delete worker[j];
+  worker.clear();
+
+  end=MilliTime();
+  perfTimer.Stop();
+  std::cout << ">> PFitter::ExecuteBootstrap(): execution time for Bootstrap = " << std::setprecision(3) << (end-start)/1.0e3 << " sec." << std::endl;
+  TString elapsed = TString::Format("Bootstrap: %.3f sec", (end-start)/1.0e3);
+  fElapsedTime.push_back(elapsed);
+
+  // statistics of the free parameters, taken from the converged replicas only
+  UInt_t noOfValid = 0;
+  for (UInt_t j=0; j<noOfReplicas; j++)
+    noOfValid += replicaValid[j];
+  std::cout << ">> PFitter::ExecuteBootstrap(): " << noOfValid << " of " << noOfReplicas << " replica fits converged." << std::endl;
+  if (noOfValid < 2) {
+    std::cerr << std::endl << ">> PFitter::ExecuteBootstrap(): **WARNING** not enough converged replicas, no statistics available.";
+    std::cerr << std::endl;
+    return false;
+  }
+
+  PUIntVector freePar;
+  for (UInt_t j=0; j<noOfParams; j++) {
+    if (!fMnUserParams.Parameters().at(j).IsFixed())
+      freePar.push_back(j);
+  }
+  std::vector<PDoubleVector> percentile(freePar.size(), PDoubleVector(5, 0.0));
+  PDoubleVector mean(freePar.size(), 0.0), sigma(freePar.size(), 0.0);
+  PDoubleVector val;
+  for (UInt_t k=0; k<freePar.size(); k++) {
+    val.clear();
+    for (UInt_t j=0; j<noOfReplicas; j++) {
+      if (replicaValid[j])
+        val.push_back(replicaPar[j*noOfParams+freePar[k]]);
+    }
+    GetSampleStatistics(val, mean[k], sigma[k], percentile[k]);
+  }
+
+  std::cout << std::endl << ">> bootstrap results (" << ((mode == PRUN_RESAMPLE_MC) ? "MC" : "RESAMPLE") << ", " << noOfValid << " replicas):";
+  std::cout << std::endl << ">>   no name           best fit     mean         sigma        2.5%         15.87%       50%          84.13%       97.5%";
+  for (UInt_t k=0; k<freePar.size(); k++) {
+    std::cout << std::endl << ">>   " << std::setw(2) << freePar[k]+1 << " " << std::left << std::setw(14) << fParams[freePar[k]].fName.Data() << std::right;
+    std::cout << std::setprecision(6) << " " << std::setw(12) << bestPar[freePar[k]] << " " << std::setw(12) << mean[k] << " " << std::setw(12) << sigma[k];
+    for (UInt_t l=0; l<5; l++)
+      std::cout << " " << std::setw(12) << percentile[k][l];
+  }
+  std::cout << std::endl << std::endl;
+
+  // write the replicas and the percentiles
+  TString fileName = fRunInfo->GetFileName();
+  Ssiz_t idx = fileName.Last('.');
+  if (idx != kNPOS)
+    fileName.Remove(idx);
+  fileName += "_bootstrap.root";
+
+  TFile ff(fileName.Data(), "recreate");
+  if (ff.IsZombie()) {
+    std::cerr << std::endl << ">> PFitter::ExecuteBootstrap(): **ERROR** couldn't open " << fileName.Data() << " for writing.";
+    std::cerr << std::endl;
+    return false;
+  }
+
+  // the trees are owned by the file, i.e. deleted by Close()
+  TTree *replicas = new TTree("replicas", "bootstrap replica fits");
+  PDoubleVector branchVal(freePar.size(), 0.0);
+  Double_t branchFcn = 0.0;
+  Int_t branchValid = 0, branchReplica = 0;
+  for (UInt_t k=0; k<freePar.size(); k++)
+    replicas->Branch(fParams[freePar[k]].fName.Data(), &branchVal[k], TString::Format("%s/D", fParams[freePar[k]].fName.Data()).Data());
+  replicas->Branch("fcn", &branchFcn, "fcn/D");
+  replicas->Branch("valid", &branchValid, "valid/I");
+  replicas->Branch("replica", &branchReplica, "replica/I");
+  for (UInt_t j=0; j<noOfReplicas; j++) {
+    for (UInt_t k=0; k<freePar.size(); k++)
+      branchVal[k] = replicaPar[j*noOfParams+freePar[k]];
+    branchFcn = replicaFcn[j];
+    branchValid = replicaValid[j];
+    branchReplica = j;
+    replicas->Fill();
+  }
+  replicas->Write();
+
+  TTree *stat = new TTree("percentiles", "bootstrap statistics of the free parameters, converged replicas only");
+  Int_t parNo = 0;
+  Double_t best = 0.0, mu = 0.0, sig = 0.0, p[5];
+  stat->Branch("parNo", &parNo, "parNo/I");
+  stat->Branch("bestFit", &best, "bestFit/D");
+  stat->Branch("mean", &mu, "mean/D");
+  stat->Branch("sigma", &sig, "sigma/D");
+  stat->Branch("percentile", p, "p2_5/D:p15_87/D:p50/D:p84_13/D:p97_5/D");
+  for (UInt_t k=0; k<freePar.size(); k++) {
+    parNo = freePar[k]+1;
+    best = bestPar[freePar[k]];
+    mu = mean[k];
+    sig = sigma[k];
+    for (UInt_t l=0; l<5; l++)
+      p[l] = percentile[k][l];
+    stat->Fill();
+  }
+  stat->Write();
+  ff.Close();
+
+  std::cout << ">> PFitter::ExecuteBootstrap(): replicas and percentiles written to " << fileName.Data() << std::endl;
+
+  return true;
+}
+
 //--------------------------------------------------------------------------
 // ExecuteContours
 //--------------------------------------------------------------------------
@@ -1600,6 +2658,8 @@ Bool_t PFitter::ExecuteContours()
 
   ROOT::Minuit2::MnContours contours((*fFitterFcn), *fFcnMin);
 
+  static const std::string perfKey("fitter/contours");
+  PPerfTimer perfTimer(perfKey);
   fScanData = contours(fScanParameter[0], fScanParameter[1], fScanNoPoints);
 
   return true;
@@ -1736,9 +2796,12 @@ Bool_t PFitter::ExecuteHesse()
 
   // call hesse
   Double_t start=0.0, end=0.0;
+  static const std::string perfKey("fitter/hesse");
+  PPerfTimer perfTimer(perfKey);
   start=MilliTime();
   ROOT::Minuit2::MnUserParameterState mnState = hesse((*fFitterFcn), fMnUserParams, maxfcn);
   end=MilliTime();
+  perfTimer.Stop();
   std::cout << ">> PFitter::ExecuteMinimize(): execution time for Hesse = " << std::setprecision(3) << (end-start)/1.0e3 << " sec." << std::endl;
   TString str = TString::Format("Hesse:    %.3f sec", (end-start)/1.0e3);
   fElapsedTime.push_back(str);
@@ -1765,6 +2828,472 @@ Bool_t PFitter::ExecuteHesse()
   return true;
 }
 
+//--------------------------------------------------------------------------
+// ExecuteMcmc
+//--------------------------------------------------------------------------
+/**
+ * <p>Samples the posterior of the free parameters with the affine-invariant ensemble sampler of
+ * Goodman and Weare (stretch move): MCMC <steps> [WALKERS <w>] [BURN <b>] [SEED <s>] [CHECKPOINT <k>] [RESUME]
+ *
+ * <p>The log-posterior is -fcn/2, i.e. chisq resp. the log max-likelihood of the fit with a flat prior
+ * within the parameter limits. Fixed parameters are kept at their current value. The walkers (default:
+ * max(4 x no of free parameters, 16)) are started in a small ball around the current parameter values.
+ * As in the parallel version of the stretch move, the ensemble is split into two halves, and all walkers
+ * of one half are updated concurrently using the positions of the other half. The first thread uses the
+ * run list collection of the fit, all others an own evaluation state (PFitterWorker). Each walker has its
+ * own random number generator, hence the chain does not depend on the number of threads. If a user function
+ * with a global part, or a user function which does not declare itself reentrant (see PUserFcnBase::IsReentrant)
+ * is present, the walkers are evaluated serially.
+ *
+ * <p>The chain is written to <msr-file-name>_mcmc.bin and flushed every <k> steps (default: 100), which
+ * serves as checkpoint: with RESUME the chain of this file is continued until it has <steps> steps. The
+ * file consists of a header: 'MUSRMCMC' (8 chars), version, no of parameters, no of free parameters d,
+ * no of walkers w, seed (UInt_t each), indices of the free parameters (d UInt_t); followed by one record
+ * per step: for each walker d parameter values, log-posterior and acceptance flag (Double_t each).
+ *
+ * <p>After the first <b> steps (burn-in, default: steps/4), the posterior median, 68% interval, mean and
+ * standard deviation, together with the convergence diagnostics acceptance fraction, integrated
+ * autocorrelation time tau (walker averaged, self-consistent window of 5 tau), effective sample size and
+ * Gelman-Rubin R-hat (walkers as chains), are written to the STATISTIC block of the mlog-file. The fit result
+ * itself is not changed.
+ *
+ * \param lineNo the line number of the command block
+ *
+ * <b>return:</b> true if done, otherwise returns false.
+ */
+Bool_t PFitter::ExecuteMcmc(UInt_t lineNo)
+{
+  std::cout << ">> PFitter::ExecuteMcmc(): " << fCmdLines[lineNo].fLine.Data() << std::endl;
+
+  // free parameters
+  const std::vector<Double_t> startPar = fMnUserParams.Params();
+  const UInt_t noOfParams = startPar.size();
+  PUIntVector freePar;
+  for (UInt_t i=0; i<noOfParams; i++) {
+    if (!fMnUserParams.Parameters().at(i).IsFixed())
+      freePar.push_back(i);
+  }
+  const UInt_t d = freePar.size();
+  if (d == 0) {
+    std::cerr << std::endl << ">> PFitter::ExecuteMcmc(): **ERROR** no free parameter present.";
+    std::cerr << std::endl;
+    return false;
+  }
+
+  // get the options
+  TObjArray *tokens = nullptr;
+  TObjString *ostr;
+  TString str;
+  UInt_t noOfSteps = 0, noOfWalkers = 0, noOfBurn = 0, seed = 0, checkpoint = 100;
+  Bool_t burnGiven = false, resume = false, syntaxOk = true;
+
+  tokens = fCmdLines[lineNo].fLine.Tokenize(", \t");
+  if (tokens->GetEntries() < 2)
+    syntaxOk = false;
+  for (Int_t i=1; syntaxOk && (i<tokens->GetEntries()); i++) {
+    ostr = (TObjString*)tokens->At(i);
+    str = ostr->GetString();
+    if (i == 1) {
+      if (str.IsDigit() && (str.Atoi() > 0))
+        noOfSteps = str.Atoi();
+      else
+        syntaxOk = false;
+    } else if (!str.CompareTo("RESUME", TString::kIgnoreCase)) {
+      resume = true;
+    } else if ((i+1 < tokens->GetEntries()) && ((TObjString*)tokens->At(i+1))->GetString().IsDigit()) {
+      UInt_t ival = static_cast<UInt_t>(((TObjString*)tokens->At(i+1))->GetString().Atoll());
+      if (!str.CompareTo("WALKERS", TString::kIgnoreCase)) {
+        noOfWalkers = ival;
+      } else if (!str.CompareTo("BURN", TString::kIgnoreCase)) {
+        noOfBurn = ival;
+        burnGiven = true;
+      } else if (!str.CompareTo("SEED", TString::kIgnoreCase)) {
+        seed = ival;
+      } else if (!str.CompareTo("CHECKPOINT", TString::kIgnoreCase) && (ival > 0)) {
+        checkpoint = ival;
+      } else {
+        syntaxOk = false;
+      }
+      i++;
+    } else {
+      syntaxOk = false;
+    }
+  }
+
+  // clean up
+  if (tokens) {
+    delete tokens;
+    tokens = nullptr;
+  }
+
+  if (!syntaxOk) {
+    std::cerr << std::endl << "**ERROR** from PFitter::ExecuteMcmc(): SYNTAX: MCMC <steps> [WALKERS <w>] [BURN <b>] [SEED <s>] [CHECKPOINT <k>] [RESUME]";
+    std::cerr << std::endl << std::endl;
+    return false;
+  }
+
+  if (noOfWalkers == 0)
+    noOfWalkers = (4*d > 16) ? 4*d : 16;
+  if (noOfWalkers % 2 == 1)
+    noOfWalkers++;
+  if (noOfWalkers < 2*d) {
+    std::cerr << std::endl << ">> PFitter::ExecuteMcmc(): **ERROR** at least 2 x (no of free parameters) = " << 2*d << " walkers are needed.";
+    std::cerr << std::endl;
+    return false;
+  }
+  if (!burnGiven)
+    noOfBurn = noOfSteps/4;
+  if (noOfBurn+2 > noOfSteps) {
+    std::cerr << std::endl << ">> PFitter::ExecuteMcmc(): **ERROR** the burn-in (" << noOfBurn << ") leaves no steps for the statistics.";
+    std::cerr << std::endl;
+    return false;
+  }
+  const UInt_t w = noOfWalkers;
+  const UInt_t rec = d+2; // per walker and step: parameters, log-posterior, acceptance flag
+
+  // keep track of elapsed time
+  Double_t start=0.0, end=0.0;
+  static const std::string perfKey("fitter/mcmc");
+  PPerfTimer perfTimer(perfKey);
+  start=MilliTime();
+
+  TString fileName = fRunInfo->GetFileName();
+  Ssiz_t idx = fileName.Last('.');
+  if (idx != kNPOS)
+    fileName.Remove(idx);
+  fileName += "_mcmc.bin";
+
+  // resume: read the chain of the previous run
+  const char magic[9] = "MUSRMCMC";
+  const UInt_t version = 1;
+  PDoubleVector chain;
+  if (resume) {
+    std::ifstream fin(fileName.Data(), std::ios::binary);
+    if (!fin.is_open()) {
+      std::cout << ">> PFitter::ExecuteMcmc(): " << fileName.Data() << " not found, will start a new chain." << std::endl;
+    } else {
+      char fmagic[8];
+      UInt_t head[5];
+      fin.read(fmagic, 8);
+      fin.read(reinterpret_cast<char*>(head), sizeof(head));
+      PUIntVector ffree(d, 0);
+      if (fin.good() && (head[2] == d))
+        fin.read(reinterpret_cast<char*>(ffree.data()), d*sizeof(UInt_t));
+      if (!fin.good() || (std::string(fmagic, 8) != magic) || (head[0] != version) || (head[1] != noOfParams) ||
+          (head[2] != d) || (head[3] != w) || (ffree != freePar)) {
+        std::cerr << std::endl << ">> PFitter::ExecuteMcmc(): **ERROR** " << fileName.Data() << " doesn't match the free parameters and walkers, cannot resume.";
+        std::cerr << std::endl;
+        return false;
+      }
+      seed = head[4];
+      PDoubleVector step(w*rec, 0.0);
+      while (fin.read(reinterpret_cast<char*>(step.data()), step.size()*sizeof(Double_t)))
+        chain.insert(chain.end(), step.begin(), step.end());
+      fin.close();
+    }
+  }
+  UInt_t stepsDone = chain.size()/(w*rec);
+  if (stepsDone > noOfSteps)
+    noOfSteps = stepsDone;
+
+  // evaluation state of each thread: thread 0 uses the one of the fit
+  Int_t noOfThreads = 1;
+#ifdef HAVE_GOMP
+  noOfThreads = omp_get_max_threads();
+  if (noOfThreads > static_cast<Int_t>(w/2))
+    noOfThreads = w/2;
+  for (UInt_t i=0; i<gGlobalUserFcn.size(); i++) {
+    if (gGlobalUserFcn[i] != nullptr) {
+      std::cout << ">> PFitter::ExecuteMcmc(): user function with global part present, will evaluate the walkers serially." << std::endl;
+      noOfThreads = 1;
+      break;
+    }
+  }
+  if ((noOfThreads > 1) && !fRunListCollection->IsTheoryReentrant()) {
+    std::cout << ">> PFitter::ExecuteMcmc(): user function which is not reentrant present, will evaluate the walkers serially." << std::endl;
+    noOfThreads = 1;
+  }
+#endif
+  std::vector<PFitterWorker*> worker;
+  std::vector<PFitterFcn*> fcn(1, fFitterFcn);
+  for (Int_t i=1; (i<noOfThreads) && (stepsDone<noOfSteps); i++) {
+    PFitterWorker *wk = new PFitterWorker(fRunInfo, fRunListCollection, fUseChi2);
+    if (!wk->IsValid()) {
+      std::cerr << std::endl << ">> PFitter::ExecuteMcmc(): **WARNING** couldn't create the evaluation state of thread " << i << ", will use " << i << " thread(s) only.";
+      std::cerr << std::endl;
+      delete wk;
+      break;
+    }
+    worker.push_back(wk);
+    fcn.push_back(wk->GetFitterFcn());
+  }
+  noOfThreads = fcn.size();
+
+  // log-posterior: flat prior within the parameter limits
+  auto lnPost = [&](const Double_t *y, const Int_t tid) -> Double_t {
+    std::vector<Double_t> x(startPar);
+    for (UInt_t k=0; k<d; k++) {
+      const ROOT::Minuit2::MinuitParameter &param = fMnUserParams.Parameters().at(freePar[k]);
+      if ((param.HasLowerLimit() && (y[k] < param.LowerLimit())) || (param.HasUpperLimit() && (y[k] > param.UpperLimit())))
+        return -std::numeric_limits<Double_t>::infinity();
+      x[freePar[k]] = y[k];
+    }
+    Double_t val = (*fcn[tid])(x);
+    if (!std::isfinite(val))
+      return -std::numeric_limits<Double_t>::infinity();
+    return -0.5*val;
+  };
+
+  // random number generator of each walker, which are reseeded on resume
+  std::vector<TRandom3*> rnd(w, nullptr);
+  for (UInt_t i=0; i<w; i++)
+    rnd[i] = new TRandom3(seed + i + 1 + w*stepsDone);
+
+  // current state of the walkers
+  PDoubleVector pos(w*d, 0.0), lnp(w, 0.0);
+  PIntVector accepted(w, 0);
+  Int_t i;
+  Bool_t initOk = true;
+  if (stepsDone > 0) {
+    const Double_t *last = &chain[(stepsDone-1)*w*rec];
+    for (UInt_t j=0; j<w; j++) {
+      for (UInt_t k=0; k<d; k++)
+        pos[j*d+k] = last[j*rec+k];
+      lnp[j] = last[j*rec+d];
+    }
+  } else if (stepsDone < noOfSteps) {
+    #ifdef HAVE_GOMP
+    #pragma omp parallel for default(shared) private(i) schedule(dynamic) num_threads(noOfThreads)
+    #endif
+    for (i=0; i<static_cast<Int_t>(w); i++) {
+      Int_t tid = 0;
+      #ifdef HAVE_GOMP
+      tid = omp_get_thread_num();
+      #endif
+      Double_t *y = &pos[i*d];
+      lnp[i] = -std::numeric_limits<Double_t>::infinity();
+      for (UInt_t attempt=0; (attempt<100) && !std::isfinite(lnp[i]); attempt++) {
+        for (UInt_t k=0; k<d; k++) {
+          Double_t err = fMnUserParams.Parameters().at(freePar[k]).Error();
+          if (err == 0.0)
+            err = 1.0e-3*((fabs(startPar[freePar[k]]) > 1.0) ? fabs(startPar[freePar[k]]) : 1.0);
+          y[k] = startPar[freePar[k]] + 0.1*err*rnd[i]->Gaus(0.0, 1.0);
+        }
+        lnp[i] = lnPost(y, tid);
+      }
+      if (!std::isfinite(lnp[i]))
+        initOk = false;
+    }
+  }
+
+  // (re-)write the chain file, i.e. a partially written step of a previous run is dropped
+  std::ofstream fout;
+  if (initOk && (stepsDone < noOfSteps)) {
+    fout.open(fileName.Data(), std::ios::binary | std::ios::trunc);
+    if (fout.is_open()) {
+      UInt_t head[5] = {version, noOfParams, d, w, seed};
+      fout.write(magic, 8);
+      fout.write(reinterpret_cast<const char*>(head), sizeof(head));
+      fout.write(reinterpret_cast<const char*>(freePar.data()), d*sizeof(UInt_t));
+      fout.write(reinterpret_cast<const char*>(chain.data()), chain.size()*sizeof(Double_t));
+      fout.flush();
+    } else {
+      std::cerr << std::endl << ">> PFitter::ExecuteMcmc(): **WARNING** couldn't open " << fileName.Data() << ", no checkpoints will be written.";
+      std::cerr << std::endl;
+    }
+  }
+
+  // sample
+  if (initOk && (stepsDone < noOfSteps)) {
+    std::cout << ">> PFitter::ExecuteMcmc(): will run " << w << " walkers from step " << stepsDone << " to " << noOfSteps << " using " << noOfThreads << " thread(s) ..." << std::endl;
+    const Double_t a = 2.0; // scale of the stretch move
+    UInt_t noOfAccepted = 0;
+    chain.reserve(static_cast<size_t>(noOfSteps)*w*rec);
+    for (UInt_t step=stepsDone; step<noOfSteps; step++) {
+      for (UInt_t half=0; half<2; half++) {
+        #ifdef HAVE_GOMP
+        #pragma omp parallel for default(shared) private(i) schedule(dynamic) num_threads(noOfThreads)
+        #endif
+        for (i=half; i<static_cast<Int_t>(w); i+=2) {
+          Int_t tid = 0;
+          #ifdef HAVE_GOMP
+          tid = omp_get_thread_num();
+          #endif
+          // stretch move towards/away from a walker of the other half
+          Double_t z = (a-1.0)*rnd[i]->Rndm() + 1.0;
+          z = z*z/a;
+          UInt_t j = 2*rnd[i]->Integer(w/2) + (1-half);
+          PDoubleVector y(d, 0.0);
+          for (UInt_t k=0; k<d; k++)
+            y[k] = pos[j*d+k] + z*(pos[i*d+k]-pos[j*d+k]);
+          Double_t lnpNew = lnPost(y.data(), tid);
+          Double_t lnq = (d-1.0)*log(z) + lnpNew - lnp[i];
+          accepted[i] = 0;
+          if (log(rnd[i]->Rndm()) < lnq) {
+            for (UInt_t k=0; k<d; k++)
+              pos[i*d+k] = y[k];
+            lnp[i] = lnpNew;
+            accepted[i] = 1;
+          }
+        }
+      }
+
+      // store the step
+      const size_t offset = chain.size();
+      for (UInt_t j=0; j<w; j++) {
+        chain.insert(chain.end(), &pos[j*d], &pos[j*d]+d);
+        chain.push_back(lnp[j]);
+        chain.push_back(accepted[j]);
+        noOfAccepted += accepted[j];
+      }
+      if (fout.is_open()) {
+        fout.write(reinterpret_cast<const char*>(&chain[offset]), w*rec*sizeof(Double_t));
+        if ((step+1-stepsDone) % checkpoint == 0)
+          fout.flush();
+      }
+      if ((step+1-stepsDone) % checkpoint == 0) {
+        std::cout << ">> PFitter::ExecuteMcmc(): step " << step+1 << "/" << noOfSteps << ", acceptance = " << std::setprecision(3) << static_cast<Double_t>(noOfAccepted)/(checkpoint*w) << std::endl;
+        noOfAccepted = 0;
+      }
+    }
+    fout.close();
+  }
+
+  // clean up
+  for (UInt_t j=0; j<worker.size(); j++)
+    delete worker[j];
+  worker.clear();
+  for (UInt_t j=0; j<w; j++)
+    delete rnd[j];
+  rnd.clear();
+
+  if (!initOk) {
+    std::cerr << std::endl << ">> PFitter::ExecuteMcmc(): **ERROR** couldn't find valid start positions of the walkers.";
+    std::cerr << std::endl;
+    return false;
+  }
+
+  // diagnostics of the steps after the burn-in
+  const UInt_t n = noOfSteps-noOfBurn;
+  auto sample = [&](const UInt_t s, const UInt_t j, const UInt_t k) -> Double_t { return chain[(static_cast<size_t>(noOfBurn+s)*w + j)*rec + k]; };
+
+  Double_t accMin = 1.0, accMax = 0.0, accTotal = 0.0;
+  for (UInt_t j=0; j<w; j++) {
+    Double_t acc = 0.0;
+    for (UInt_t s=0; s<n; s++)
+      acc += sample(s, j, d+1);
+    acc /= n;
+    accTotal += acc/w;
+    if (acc < accMin)
+      accMin = acc;
+    if (acc > accMax)
+      accMax = acc;
+  }
+
+  PDoubleVector mean(d, 0.0), sigma(d, 0.0), tau(d, 0.0), rHat(d, 0.0);
+  std::vector<PDoubleVector> percentile(d, PDoubleVector(5, 0.0));
+  PIntVector tauOk(d, 1); // no PBoolVector, since its bits cannot be written concurrently
+  Int_t k;
+  #ifdef HAVE_GOMP
+  #pragma omp parallel for default(shared) private(k) schedule(dynamic)
+  #endif
+  for (k=0; k<static_cast<Int_t>(d); k++) {
+    // mean and variance of each walker
+    PDoubleVector mw(w, 0.0), vw(w, 0.0);
+    for (UInt_t j=0; j<w; j++) {
+      for (UInt_t s=0; s<n; s++)
+        mw[j] += sample(s, j, k);
+      mw[j] /= n;
+      for (UInt_t s=0; s<n; s++)
+        vw[j] += (sample(s, j, k)-mw[j])*(sample(s, j, k)-mw[j]);
+      vw[j] /= n-1;
+    }
+
+    // Gelman-Rubin R-hat, walkers as chains
+    Double_t mAll = 0.0, b = 0.0, wv = 0.0;
+    for (UInt_t j=0; j<w; j++) {
+      mAll += mw[j]/w;
+      wv += vw[j]/w;
+    }
+    for (UInt_t j=0; j<w; j++)
+      b += (mw[j]-mAll)*(mw[j]-mAll);
+    b *= static_cast<Double_t>(n)/(w-1);
+    rHat[k] = (wv > 0.0) ? sqrt(((n-1.0)/n*wv + b/n)/wv) : 1.0;
+
+    // integrated autocorrelation time from the walker averaged autocorrelation function,
+    // summed up to the smallest window M >= 5 tau(M). Windows beyond n/10 are not searched,
+    // since such a chain fails the n >= 50 tau criterion anyway.
+    const UInt_t tMax = (n/10 > 1) ? n/10 : 1;
+    tauOk[k] = 0;
+    tau[k] = 1.0;
+    for (UInt_t t=1; t<=tMax; t++) {
+      Double_t rho = 0.0;
+      UInt_t noOfWalkersUsed = 0;
+      for (UInt_t j=0; j<w; j++) {
+        if (vw[j] <= 0.0) // stuck walker
+          continue;
+        Double_t sum = 0.0;
+        for (UInt_t s=0; s+t<n; s++)
+          sum += (sample(s, j, k)-mw[j])*(sample(s+t, j, k)-mw[j]);
+        rho += sum/((n-1)*vw[j]);
+        noOfWalkersUsed++;
+      }
+      if (noOfWalkersUsed == 0)
+        break;
+      tau[k] += 2.0*rho/noOfWalkersUsed;
+      if (t >= 5.0*tau[k]) {
+        tauOk[k] = 1;
+        break;
+      }
+    }
+
+    // posterior statistics of all walkers
+    PDoubleVector val;
+    val.reserve(n*w);
+    for (UInt_t s=0; s<n; s++) {
+      for (UInt_t j=0; j<w; j++)
+        val.push_back(sample(s, j, k));
+    }
+    GetSampleStatistics(val, mean[k], sigma[k], percentile[k]);
+  }
+
+  end=MilliTime();
+  perfTimer.Stop();
+  std::cout << ">> PFitter::ExecuteMcmc(): execution time for MCMC = " << std::setprecision(3) << (end-start)/1.0e3 << " sec." << std::endl;
+  TString elapsed = TString::Format("MCMC:     %.3f sec", (end-start)/1.0e3);
+  fElapsedTime.push_back(elapsed);
+
+  // summary, also written to the STATISTIC block of the mlog-file
+  PStringVector lines;
+  Double_t tauMax = 0.0, rHatMax = 0.0;
+  Bool_t allTauOk = true;
+  lines.push_back(TString::Format("  mcmc: walkers = %d, steps = %d, burn-in = %d, acceptance = %.3lf (min = %.3lf, max = %.3lf)",
+                                  w, noOfSteps, noOfBurn, accTotal, accMin, accMax));
+  for (UInt_t l=0; l<d; l++) {
+    lines.push_back(TString::Format("  mcmc %d %s: median = %lg, 68%% = [%lg, %lg], mean = %lg, sigma = %lg, tau = %.1lf%s, ESS = %.0lf, R-hat = %.4lf",
+                                    freePar[l]+1, fParams[freePar[l]].fName.Data(), percentile[l][2], percentile[l][1], percentile[l][3],
+                                    mean[l], sigma[l], tau[l], tauOk[l] ? "" : "(!)", w*n/tau[l], rHat[l]));
+    if (tau[l] > tauMax)
+      tauMax = tau[l];
+    if (rHat[l] > rHatMax)
+      rHatMax = rHat[l];
+    allTauOk = allTauOk && tauOk[l];
+  }
+  if (allTauOk && (n >= 50.0*tauMax) && (rHatMax <= 1.1))
+    lines.push_back(TString::Format("  mcmc: converged, steps/tau_max = %.1lf >= 50, R-hat_max = %.4lf <= 1.1", n/tauMax, rHatMax));
+  else
+    lines.push_back(TString::Format("  mcmc: **WARNING** chain might not be converged, steps/tau_max = %.1lf (>= 50 needed), R-hat_max = %.4lf (<= 1.1 needed)%s",
+                                    n/tauMax, rHatMax, allTauOk ? "" : ", tau(!) not reliable"));
+  fRunInfo->SetMsrStatisticMcmc(lines);
+
+  std::cout << std::endl;
+  for (UInt_t l=0; l<lines.size(); l++)
+    std::cout << ">>" << lines[l].Data() << std::endl;
+  std::cout << ">> PFitter::ExecuteMcmc(): chain written to " << fileName.Data() << std::endl << std::endl;
+
+  return true;
+}
+
 //--------------------------------------------------------------------------
 // ExecuteMigrad
 //--------------------------------------------------------------------------
@@ -1788,9 +3317,12 @@ Bool_t PFitter::ExecuteMigrad()
   Double_t tolerance = 0.1;
   // keep track of elapsed time
   Double_t start=0.0, end=0.0;
+  static const std::string perfKey("fitter/migrad");
+  PPerfTimer perfTimer(perfKey);
   start=MilliTime();
   ROOT::Minuit2::FunctionMinimum min = migrad(maxfcn, tolerance);
   end=MilliTime();
+  perfTimer.Stop();
   std::cout << ">> PFitter::ExecuteMinimize(): execution time for Migrad = " << std::setprecision(3) << (end-start)/1.0e3 << " sec." << std::endl;
   TString str = TString::Format("Migrad:   %.3f sec", (end-start)/1.0e3);
   fElapsedTime.push_back(str);
@@ -1869,9 +3401,12 @@ Bool_t PFitter::ExecuteMinimize()
   Double_t tolerance = 0.1;
   // keep track of elapsed time
   Double_t start=0.0, end=0.0;
+  static const std::string perfKey("fitter/minimize");
+  PPerfTimer perfTimer(perfKey);
   start = MilliTime();
   ROOT::Minuit2::FunctionMinimum min = minimize(maxfcn, tolerance);
   end = MilliTime();
+  perfTimer.Stop();
   std::cout << ">> PFitter::ExecuteMinimize(): execution time for Minimize = " << std::setprecision(3) << (end-start)/1.0e3 << " sec." << std::endl;
   TString str = TString::Format("Minimize: %.3f sec", (end-start)/1.0e3);
   fElapsedTime.push_back(str);
@@ -1954,6 +3489,8 @@ Bool_t PFitter::ExecuteMinos()
 
   // make minos analysis
   Double_t start=0.0, end=0.0;
+  static const std::string perfKey("fitter/minos");
+  PPerfTimer perfTimer(perfKey);
   start=MilliTime();
   ROOT::Minuit2::MnMinos minos((*fFitterFcn), (*fFcnMin));
 
@@ -1966,7 +3503,10 @@ Bool_t PFitter::ExecuteMinos()
       std::cout << ">> PFitter::ExecuteMinos(): calculate errors for " << fParams[i].fName << std::endl;
 
       // 1-sigma MINOS errors
+      std::string perfKeyParam = std::string("fitter/minos/") + fParams[i].fName.Data();
+      PPerfTimer perfTimerParam(perfKeyParam);
       ROOT::Minuit2::MinosError err = minos.Minos(i);
+      perfTimerParam.Stop();
 
       if (err.IsValid()) {
         // fill msr-file structure
@@ -1988,6 +3528,7 @@ Bool_t PFitter::ExecuteMinos()
   }
 
   end=MilliTime();
+  perfTimer.Stop();
   std::cout << ">> PFitter::ExecuteMinimize(): execution time for Minos = " << std::setprecision(3) << (end-start)/1.0e3 << " sec." << std::endl;
   TString str = TString::Format("Minos:    %.3f sec", (end-start)/1.0e3);
   fElapsedTime.push_back(str);
@@ -2153,7 +3694,9 @@ Bool_t PFitter::ExecuteScan()
 
   if (fScanAll) { // not clear at the moment what to be done here
     // TO BE IMPLEMENTED
-  } else { // single parameter scan
+  } else { // single parameter scan, the scan points show up as fcn calls within this section
+    static const std::string perfKey("fitter/scan");
+    PPerfTimer perfTimer(perfKey);
     fScanData = scan.Scan(fScanParameter[0], fScanNoPoints, fScanLow, fScanHigh);
   }
 
@@ -2582,9 +4125,12 @@ Bool_t PFitter::ExecuteSimplex()
   Double_t tolerance = 0.1;
   // keep track of elapsed time
   Double_t start=0.0, end=0.0;
+  static const std::string perfKey("fitter/simplex");
+  PPerfTimer perfTimer(perfKey);
   start=MilliTime();
   ROOT::Minuit2::FunctionMinimum min = simplex(maxfcn, tolerance);
   end=MilliTime();
+  perfTimer.Stop();
   std::cout << ">> PFitter::ExecuteMinimize(): execution time for Simplex = " << std::setprecision(3) << (end-start)/1.0e3 << " sec." << std::endl;
   TString str = TString::Format("Simplex:  %.3f sec", (end-start)/1.0e3);
   fElapsedTime.push_back(str);
@@ -2809,6 +4355,149 @@ Bool_t PFitter::ExecuteSector(std::ofstream &fout)
   return true;
 }
 
+//--------------------------------------------------------------------------
+// GetRunBlockFcnValue (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculates chisq or maxLH (depending on the fit) of a single run block.
+ *
+ * <b>return:</b> chisq/maxLH of the run block
+ *
+ * \param par parameter vector
+ * \param idx run block index
+ */
+Double_t PFitter::GetRunBlockFcnValue(const PDoubleVector &par, const UInt_t idx)
+{
+  if (fUseChi2)
+    return fRunListCollection->GetSingleRunChisq(par, idx);
+  else
+    return fRunListCollection->GetSingleRunMaximumLikelihood(par, idx);
+}
+
+//--------------------------------------------------------------------------
+// GetSampleStatistics (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Mean, standard deviation and the percentiles 2.5%, 15.87%, 50%, 84.13% and 97.5%, i.e. the
+ * median and the 1 and 2 sigma intervals, of a sample (bootstrap replicas, MCMC chain). The
+ * percentiles are linearly interpolated between the order statistics.
+ *
+ * \param val sample with at least 2 entries, will be sorted
+ * \param mean mean of the sample
+ * \param sigma standard deviation of the sample
+ * \param percentile percentiles of the sample
+ */
+void PFitter::GetSampleStatistics(PDoubleVector &val, Double_t &mean, Double_t &sigma, PDoubleVector &percentile)
+{
+  const Double_t prob[5] = {0.025, 0.1587, 0.5, 0.8413, 0.975};
+
+  mean = 0.0;
+  for (UInt_t j=0; j<val.size(); j++)
+    mean += val[j];
+  mean /= val.size();
+  sigma = 0.0;
+  for (UInt_t j=0; j<val.size(); j++)
+    sigma += (val[j]-mean)*(val[j]-mean);
+  sigma = sqrt(sigma/(val.size()-1));
+
+  std::sort(val.begin(), val.end());
+  percentile.resize(5);
+  for (UInt_t l=0; l<5; l++) {
+    Double_t pos = prob[l]*(val.size()-1);
+    UInt_t idx = static_cast<UInt_t>(pos);
+    if (idx+1 < val.size())
+      percentile[l] = val[idx] + (pos-idx)*(val[idx+1]-val[idx]);
+    else
+      percentile[l] = val[idx];
+  }
+}
+
+//--------------------------------------------------------------------------
+// Int2Ext (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Transforms an internal (unbounded) parameter value to the external one, using the same
+ * transformations as minuit2 for parameters with limits.
+ *
+ * <b>return:</b> external parameter value
+ *
+ * \param idx parameter index
+ * \param val internal parameter value
+ */
+Double_t PFitter::Int2Ext(const UInt_t idx, const Double_t val)
+{
+  const ROOT::Minuit2::MinuitParameter &param = fMnUserParams.Parameters().at(idx);
+
+  if (param.HasLowerLimit() && param.HasUpperLimit())
+    return param.LowerLimit() + 0.5*(param.UpperLimit()-param.LowerLimit())*(sin(val)+1.0);
+  else if (param.HasLowerLimit())
+    return param.LowerLimit() - 1.0 + sqrt(val*val+1.0);
+  else if (param.HasUpperLimit())
+    return param.UpperLimit() + 1.0 - sqrt(val*val+1.0);
+
+  return val;
+}
+
+//--------------------------------------------------------------------------
+// Ext2Int (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Transforms an external parameter value to the internal (unbounded) one. Values outside the
+ * limits are mapped onto the limits.
+ *
+ * <b>return:</b> internal parameter value
+ *
+ * \param idx parameter index
+ * \param val external parameter value
+ */
+Double_t PFitter::Ext2Int(const UInt_t idx, const Double_t val)
+{
+  const ROOT::Minuit2::MinuitParameter &param = fMnUserParams.Parameters().at(idx);
+  Double_t yy;
+
+  if (param.HasLowerLimit() && param.HasUpperLimit()) {
+    yy = 2.0*(val-param.LowerLimit())/(param.UpperLimit()-param.LowerLimit()) - 1.0;
+    if (yy > 1.0)
+      yy = 1.0;
+    else if (yy < -1.0)
+      yy = -1.0;
+    return asin(yy);
+  } else if (param.HasLowerLimit()) {
+    yy = val - param.LowerLimit() + 1.0;
+    return (yy > 1.0) ? sqrt(yy*yy-1.0) : 0.0;
+  } else if (param.HasUpperLimit()) {
+    yy = param.UpperLimit() - val + 1.0;
+    return (yy > 1.0) ? sqrt(yy*yy-1.0) : 0.0;
+  }
+
+  return val;
+}
+
+//--------------------------------------------------------------------------
+// DInt2Ext (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Derivative of the external parameter value with respect to the internal one.
+ *
+ * <b>return:</b> d(external)/d(internal)
+ *
+ * \param idx parameter index
+ * \param val internal parameter value
+ */
+Double_t PFitter::DInt2Ext(const UInt_t idx, const Double_t val)
+{
+  const ROOT::Minuit2::MinuitParameter &param = fMnUserParams.Parameters().at(idx);
+
+  if (param.HasLowerLimit() && param.HasUpperLimit())
+    return 0.5*(param.UpperLimit()-param.LowerLimit())*cos(val);
+  else if (param.HasLowerLimit())
+    return val/sqrt(val*val+1.0);
+  else if (param.HasUpperLimit())
+    return -val/sqrt(val*val+1.0);
+
+  return 1.0;
+}
+
 //--------------------------------------------------------------------------
 // MilliTime
 //--------------------------------------------------------------------------
@@ -27,6 +27,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include "PPerfMonitor.h"
 #include "PFitterFcn.h"
 
 //--------------------------------------------------------------------------
@@ -41,6 +42,7 @@
 PFitterFcn::PFitterFcn(PRunListCollection *runList, Bool_t useChi2)
 {
   fUseChi2 = useChi2;
+  fNoOfCalls = 0;
 
   if (fUseChi2)
     fUp = 1.0;
@@ -70,6 +72,11 @@ PFitterFcn::~PFitterFcn()
  */
 Double_t PFitterFcn::operator()(const std::vector<Double_t>& par) const
 {
+  static const std::string perfKey("fcn");
+  PPerfTimer timer(perfKey);
+
+  fNoOfCalls.fetch_add(1, std::memory_order_relaxed);
+
   Double_t value = 0.0;
 
   if (fUseChi2) { // chi square
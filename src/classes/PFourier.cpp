@@ -41,6 +41,7 @@
 
 #include "PMusr.h"
 #include "PFourier.h"
+#include "PFFTPlanManager.h"
 
 #define PI      3.14159265358979312
 #define PI_HALF 1.57079632679489656
@@ -359,8 +360,9 @@ PFourier::PFourier(TH1F *data, Int_t unitTag, Double_t startTime, Double_t endTi
     return;
   }
 
-  // get the FFTW3 plan (see FFTW3 manual)
-  fFFTwPlan = fftw_plan_dft_1d(static_cast<Int_t>(fNoOfBins), fIn, fOut, FFTW_FORWARD, FFTW_ESTIMATE);
+  // get the FFTW3 plan (see FFTW3 manual). The plan is shared and owned by the PFFTPlanManager.
+  const Int_t noOfBins = static_cast<Int_t>(fNoOfBins);
+  fFFTwPlan = PFFTPlanManager::GetInstance()->GetPlanDft(1, &noOfBins, fIn, fOut, FFTW_FORWARD, FFTW_ESTIMATE);
 
   // check if a valid plan has been generated
   if (!fFFTwPlan) {
@@ -376,8 +378,6 @@ PFourier::PFourier(TH1F *data, Int_t unitTag, Double_t startTime, Double_t endTi
  */
 PFourier::~PFourier()
 {
-  if (fFFTwPlan)
-    fftw_destroy_plan(fFFTwPlan);
   if (fIn)
     fftw_free(fIn);
   if (fOut)
@@ -402,7 +402,7 @@ void PFourier::Transform(UInt_t apodizationTag)
 
   PrepareFFTwInputData(apodizationTag);
 
-  fftw_execute(fFFTwPlan);
+  fftw_execute_dft(fFFTwPlan, fIn, fOut);
 
   // correct the phase for tstart != 0.0
   // find the first bin >= fStartTime
@@ -141,6 +141,31 @@ Bool_t PFunction::SetFuncNo()
   return success;
 }
 
+//-------------------------------------------------------------
+// FindRunBlockDependence (protected)
+//-------------------------------------------------------------
+/**
+ * <p>Recursive search for tree elements which differ from run block to run block, i.e. maps
+ * and meta data (field, energy, temperature).
+ *
+ * <b>return:</b> true if the (sub-)tree depends on the run block, otherwise false.
+ *
+ * \param node of the evaluation tree
+ */
+Bool_t PFunction::FindRunBlockDependence(const PFuncTreeNode &node)
+{
+  if ((node.fID == PFunctionGrammar::mapID) || (node.fID == PFunctionGrammar::constFieldID) ||
+      (node.fID == PFunctionGrammar::constEnergyID) || (node.fID == PFunctionGrammar::constTempID))
+    return true;
+
+  for (UInt_t i=0; i<node.children.size(); i++) {
+    if (FindRunBlockDependence(node.children[i]))
+      return true;
+  }
+
+  return false;
+}
+
 //-------------------------------------------------------------
 // GenerateFuncEvalTree (protected)
 //-------------------------------------------------------------
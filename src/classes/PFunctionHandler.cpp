@@ -208,6 +208,23 @@ Int_t PFunctionHandler::GetFuncIndex(Int_t funcNo)
   return index;
 }
 
+//-------------------------------------------------------------
+// IsRunBlockIndependent (public)
+//-------------------------------------------------------------
+/**
+ * <p>Checks if the function at index idx neither uses maps nor meta data, i.e. if it
+ * gives the same value in every run block.
+ *
+ * \param idx index of the function
+ */
+Bool_t PFunctionHandler::IsRunBlockIndependent(UInt_t idx)
+{
+  if (idx >= fFuncs.size())
+    return false;
+
+  return fFuncs[idx].IsRunBlockIndependent();
+}
+
 //-------------------------------------------------------------
 // GetFuncString (public)
 //-------------------------------------------------------------
@@ -505,6 +505,8 @@ int PMsr2Data::ReadRunDataFile()
   else
     fDataHandler = new PRunDataHandler(fMsrHandler);
 
+  // only the run header information (temperature, field, energy, ...) is needed
+  fDataHandler->SetHeaderOnly(true);
   fDataHandler->ReadData();
 
   bool success = fDataHandler->IsAllDataAvailable();
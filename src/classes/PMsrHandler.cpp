@@ -29,6 +29,7 @@
 
 #include <math.h>
 
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -39,6 +40,7 @@
 #include <TDatime.h>
 
 #include "PMusr.h"
+#include "PPerfMonitor.h"
 #include "PMsrHandler.h"
 
 //--------------------------------------------------------------------------
@@ -65,6 +67,7 @@ PMsrHandler::PMsrHandler(const Char_t *fileName, PStartupOptions *startupOptions
   fStatistic.fMinExpected = 0.0;
   fStatistic.fMinExpectedPerHisto.clear();
   fStatistic.fNdfPerHisto.clear();
+  fStatistic.fMcmc.clear();
 
   fFuncHandler = nullptr;
 
@@ -81,6 +84,34 @@ PMsrHandler::PMsrHandler(const Char_t *fileName, PStartupOptions *startupOptions
   }
 }
 
+//--------------------------------------------------------------------------
+// Copy Constructor
+//--------------------------------------------------------------------------
+/**
+ * <p>Copy constructor. Copies the current in-memory state of all blocks, i.e. including changed
+ * parameters and fit ranges, without re-reading the msr-file. The FUNCTIONS block is parsed anew,
+ * such that the functions of the copy are independent of the ones of msrHandler.
+ *
+ * \param msrHandler msr-file handler to be copied
+ */
+PMsrHandler::PMsrHandler(const PMsrHandler &msrHandler) :
+    fFourierOnly(msrHandler.fFourierOnly), fStartupOptions(msrHandler.fStartupOptions),
+    fFileName(msrHandler.fFileName), fMsrFileDirectoryPath(msrHandler.fMsrFileDirectoryPath),
+    fTitle(msrHandler.fTitle), fParam(msrHandler.fParam), fTheory(msrHandler.fTheory),
+    fFunctions(msrHandler.fFunctions), fGlobal(msrHandler.fGlobal), fRuns(msrHandler.fRuns),
+    fCommands(msrHandler.fCommands), fFourier(msrHandler.fFourier), fPlots(msrHandler.fPlots),
+    fStatistic(msrHandler.fStatistic), fMsrBlockCounter(msrHandler.fMsrBlockCounter),
+    fFuncHandler(nullptr), fParamInUse(msrHandler.fParamInUse),
+    fCopyStatisticsBlock(msrHandler.fCopyStatisticsBlock)
+{
+  if (msrHandler.fFuncHandler) {
+    fFuncHandler = new PFunctionHandler(fFunctions);
+    if (!fFuncHandler->DoParse()) {
+      std::cerr << std::endl << ">> PMsrHandler::PMsrHandler(): **ERROR** couldn't parse the FUNCTIONS block of the copy." << std::endl;
+    }
+  }
+}
+
 //--------------------------------------------------------------------------
 // Destructor
 //--------------------------------------------------------------------------
@@ -98,6 +129,7 @@ PMsrHandler::~PMsrHandler()
   fStatistic.fStatLines.clear();
   fStatistic.fMinExpectedPerHisto.clear();
   fStatistic.fNdfPerHisto.clear();
+  fStatistic.fMcmc.clear();
   fParamInUse.clear();
 
   if (fFuncHandler) {
@@ -118,6 +150,9 @@ PMsrHandler::~PMsrHandler()
  */
 Int_t PMsrHandler::ReadMsrFile()
 {
+  static const std::string perfKey("msr_parsing");
+  PPerfTimer perfTimer(perfKey);
+
   std::ifstream f;
   std::string str;
   TString line;
@@ -1305,6 +1340,7 @@ Int_t PMsrHandler::WriteMsrLogFile(const Bool_t messages)
            if (messages)
              std::cout << std::endl << "*** FIT DID NOT CONVERGE ***" << std::endl;
           }
+          WriteMcmcStatistic(fout, messages);
         } else if (sstr.BeginsWith("*** FIT DID NOT CONVERGE ***")) {
           partialStatisticBlockFound = false;
           if (fStatistic.fValid) { // valid fit result
@@ -1374,11 +1410,12 @@ Int_t PMsrHandler::WriteMsrLogFile(const Bool_t messages)
            if (messages)
              std::cout << std::endl << "*** FIT DID NOT CONVERGE ***" << std::endl;
           }
+          WriteMcmcStatistic(fout, messages);
         } else {
           if (str.Length() > 0) {
             sstr = str;
             sstr.Remove(TString::kLeading, ' ');
-            if (!sstr.BeginsWith("expected chisq") && !sstr.BeginsWith("expected maxLH") && !sstr.BeginsWith("run block"))
+            if (!sstr.BeginsWith("expected chisq") && !sstr.BeginsWith("expected maxLH") && !sstr.BeginsWith("run block") && !sstr.BeginsWith("mcmc"))
               fout << str.Data() << std::endl;
           } else { // only write endl if not eof is reached. This is preventing growing msr-files, i.e. more and more empty lines at the end of the file
             if (!fin.eof())
@@ -1465,6 +1502,7 @@ Int_t PMsrHandler::WriteMsrLogFile(const Bool_t messages)
       if (messages)
         std::cout << std::endl << "*** FIT DID NOT CONVERGE ***" << std::endl;
     }
+    WriteMcmcStatistic(fout, messages);
   }
 
   // there was only a partial statistic block present in the msr-input-file
@@ -1540,6 +1578,7 @@ Int_t PMsrHandler::WriteMsrLogFile(const Bool_t messages)
       if (messages)
         std::cout << std::endl << "*** FIT DID NOT CONVERGE ***" << std::endl;
     }
+    WriteMcmcStatistic(fout, messages);
   }
 
   // close files
@@ -5200,14 +5239,71 @@ Bool_t PMsrHandler::HandleStatisticEntry(PMsrLines &lines)
 // GetNoOfFitParameters (public)
 //--------------------------------------------------------------------------
 /**
- * <p>Calculate the number of fit parameters.
+ * <p>Calculate the number of fit parameters, i.e. the number of parameters with step != 0 on which
+ * the run block depends. The lifetime parameter is not counted, and the functions are scanned token
+ * by token (see CollectRunBlockParameters), which keeps the number of degrees of freedom of the
+ * single run blocks as before.
  *
  * \param idx run block index
  */
 UInt_t PMsrHandler::GetNoOfFitParameters(UInt_t idx)
 {
   UInt_t noOfFitParameters = 0;
-  PUIntVector paramVector;
+  PUIntVector param;
+
+  if (!CollectRunBlockParameters(idx, false, param))
+    return 0;
+
+  // calculate the number of fit parameters with step != 0
+  for (UInt_t i=0; i<param.size(); i++) {
+    if (fParam[param[i]-1].fStep != 0.0)
+      noOfFitParameters++;
+  }
+
+  return noOfFitParameters;
+}
+
+//--------------------------------------------------------------------------
+// GetRunBlockParameters (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Collects the parameters on which the run block depends: N0, background, alpha, beta, lifetime
+ * of the run block, the parameters of the THEORY block, and the parameters of all functions used
+ * by either of them. Maps are resolved with the maps of the run block.
+ *
+ * <p><b>return:</b> sorted list of parameter numbers (1, 2, ...) without duplicates. The list is
+ * empty if idx is out of range or a function cannot be found.
+ *
+ * \param idx run block index
+ */
+PUIntVector PMsrHandler::GetRunBlockParameters(UInt_t idx)
+{
+  PUIntVector param;
+
+  CollectRunBlockParameters(idx, true, param);
+
+  return param;
+}
+
+//--------------------------------------------------------------------------
+// CollectRunBlockParameters (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Collects the parameters on which the run block depends: N0, background, alpha, beta
+ * of the run block, the parameters of the THEORY block, and the parameters of all functions used
+ * by either of them. Maps are resolved with the maps of the run block.
+ *
+ * <p><b>return:</b> true on success, false if idx is out of range or a function cannot be found.
+ * In the latter case param is empty.
+ *
+ * \param idx run block index
+ * \param all if true, the lifetime parameter is collected as well, and the functions are searched
+ * for parameters and maps in the whole string rather than in white space separated tokens, since
+ * e.g. 'par1*par2' is a valid function. If false, only white space separated tokens are considered.
+ * \param param sorted list of parameter numbers (1, 2, ...) without duplicates
+ */
+Bool_t PMsrHandler::CollectRunBlockParameters(const UInt_t idx, const Bool_t all, PUIntVector &param)
+{
   PUIntVector funVector;
   PUIntVector mapVector;
   TObjArray  *tokens = nullptr;
@@ -5216,29 +5312,35 @@ UInt_t PMsrHandler::GetNoOfFitParameters(UInt_t idx)
   UInt_t      k, dval;
   Int_t       status, pos;
 
+  param.clear();
+
   // check that idx is valid
   if (idx >= fRuns.size()) {
-    std::cerr << std::endl << ">> PMsrHandler::GetNoOfFitParameters() **ERROR** idx=" << idx << ", out of range fRuns.size()=" << fRuns.size();
+    std::cerr << std::endl << ">> PMsrHandler::CollectRunBlockParameters() **ERROR** idx=" << idx << ", out of range fRuns.size()=" << fRuns.size();
     std::cerr << std::endl;
-    return 0;
+    return false;
   }
 
   // get N0 parameter, possible parameter number or function (single histo fit)
   if (fRuns[idx].GetNormParamNo() != -1) {
     if (fRuns[idx].GetNormParamNo() < MSR_PARAM_FUN_OFFSET) // parameter
-      paramVector.push_back(fRuns[idx].GetNormParamNo());
+      param.push_back(fRuns[idx].GetNormParamNo());
     else // function
       funVector.push_back(fRuns[idx].GetNormParamNo() - MSR_PARAM_FUN_OFFSET);
   }
 
   // get background parameter, for the case the background is fitted (single histo fit)
   if (fRuns[idx].GetBkgFitParamNo() != -1)
-    paramVector.push_back(fRuns[idx].GetBkgFitParamNo());
+    param.push_back(fRuns[idx].GetBkgFitParamNo());
+
+  // get lifetime parameter, for the case the lifetime is fitted (single histo fit)
+  if (all && (fRuns[idx].GetLifetimeParamNo() != -1))
+    param.push_back(fRuns[idx].GetLifetimeParamNo());
 
   // get alpha parameter if present (asymmetry fit)
   if (fRuns[idx].GetAlphaParamNo() != -1) {
     if (fRuns[idx].GetAlphaParamNo() < MSR_PARAM_FUN_OFFSET) // parameter
-      paramVector.push_back(fRuns[idx].GetAlphaParamNo());
+      param.push_back(fRuns[idx].GetAlphaParamNo());
     else // function
       funVector.push_back(fRuns[idx].GetAlphaParamNo() - MSR_PARAM_FUN_OFFSET);
   }
@@ -5246,7 +5348,7 @@ UInt_t PMsrHandler::GetNoOfFitParameters(UInt_t idx)
   // get beta parameter if present (asymmetry fit)
   if (fRuns[idx].GetBetaParamNo() != -1) {
     if (fRuns[idx].GetBetaParamNo() < MSR_PARAM_FUN_OFFSET) // parameter
-      paramVector.push_back(fRuns[idx].GetBetaParamNo());
+      param.push_back(fRuns[idx].GetBetaParamNo());
     else // function
       funVector.push_back(fRuns[idx].GetBetaParamNo() - MSR_PARAM_FUN_OFFSET);
   }
@@ -5262,10 +5364,8 @@ UInt_t PMsrHandler::GetNoOfFitParameters(UInt_t idx)
     // tokenize
     tokens = str.Tokenize(" \t");
     if (!tokens) {
-      mapVector.clear();
-      funVector.clear();
-      paramVector.clear();
-      return 0;
+      param.clear();
+      return false;
     }
 
     for (Int_t j=0; j<tokens->GetEntries(); j++) {
@@ -5274,7 +5374,7 @@ UInt_t PMsrHandler::GetNoOfFitParameters(UInt_t idx)
       // check for parameter number
       if (str.IsDigit()) {
         dval = str.Atoi();
-        paramVector.push_back(dval);
+        param.push_back(dval);
       }
 
       // check for map
@@ -5311,15 +5411,10 @@ UInt_t PMsrHandler::GetNoOfFitParameters(UInt_t idx)
 
     // check if everything has been found at all
     if (k == fFunctions.size()) {
-      std::cerr << std::endl << ">> PMsrHandler::GetNoOfFitParameters() **ERROR** couldn't find fun" << funVector[i];
+      std::cerr << std::endl << ">> PMsrHandler::CollectRunBlockParameters() **ERROR** couldn't find fun" << funVector[i];
       std::cerr << std::endl << std::endl;
-
-      // clean up
-      mapVector.clear();
-      funVector.clear();
-      paramVector.clear();
-
-      return 0;
+      param.clear();
+      return false;
     }
 
     // remove potential comments
@@ -5328,66 +5423,70 @@ UInt_t PMsrHandler::GetNoOfFitParameters(UInt_t idx)
     if (pos >= 0)
       str.Resize(pos);
 
-    // tokenize
-    tokens = str.Tokenize(" \t");
-    if (!tokens) {
-      mapVector.clear();
-      funVector.clear();
-      paramVector.clear();
-      return 0;
-    }
-
-    // filter out parameters and maps
-    for (Int_t j=0; j<tokens->GetEntries(); j++) {
-      ostr = dynamic_cast<TObjString*>(tokens->At(j));
-      str = ostr->GetString();
-
-      // check for parameter
-      if (str.BeginsWith("par")) {
-        status = sscanf(str.Data(), "par%d", &dval);
+    if (all) {
+      // filter out parameters and maps in the whole string
+      pos = str.Index("par");
+      while (pos != kNPOS) {
+        status = sscanf(str.Data()+pos, "par%d", &dval);
         if (status == 1)
-          paramVector.push_back(dval);
+          param.push_back(dval);
+        pos = str.Index("par", pos+3);
       }
-
-      // check for map
-      if (str.BeginsWith("map")) {
-        status = sscanf(str.Data(), "map%d", &dval);
+      pos = str.Index("map");
+      while (pos != kNPOS) {
+        status = sscanf(str.Data()+pos, "map%d", &dval);
         if (status == 1)
           mapVector.push_back(dval);
+        pos = str.Index("map", pos+3);
+      }
+    } else {
+      // tokenize
+      tokens = str.Tokenize(" \t");
+      if (!tokens) {
+        param.clear();
+        return false;
       }
-    }
-  }
 
-  // go through the map and collect parameters
-  for (UInt_t i=0; i<mapVector.size(); i++) {
-    paramVector.push_back(fRuns[idx].GetMap(mapVector[i]-1));
-  }
+      // filter out parameters and maps
+      for (Int_t j=0; j<tokens->GetEntries(); j++) {
+        ostr = dynamic_cast<TObjString*>(tokens->At(j));
+        str = ostr->GetString();
 
-  // eliminated multiple identical entries in paramVector
-  PUIntVector param;
-  param.push_back(paramVector[0]);
-  for (UInt_t i=0; i<paramVector.size(); i++) {
-    for (k=0; k<param.size(); k++) {
-      if (param[k] == paramVector[i])
-        break;
+        // check for parameter
+        if (str.BeginsWith("par")) {
+          status = sscanf(str.Data(), "par%d", &dval);
+          if (status == 1)
+            param.push_back(dval);
+        }
+
+        // check for map
+        if (str.BeginsWith("map")) {
+          status = sscanf(str.Data(), "map%d", &dval);
+          if (status == 1)
+            mapVector.push_back(dval);
+        }
+      }
+
+      delete tokens;
+      tokens = nullptr;
     }
-    if (k == param.size())
-      param.push_back(paramVector[i]);
   }
 
-  // calculate the number of fit parameters with step != 0
-  for (UInt_t i=0; i<param.size(); i++) {
-    if (fParam[param[i]-1].fStep != 0.0)
-      noOfFitParameters++;
+  // go through the map and collect parameters
+  for (UInt_t i=0; i<mapVector.size(); i++) {
+    if ((mapVector[i] > 0) && (mapVector[i] <= fRuns[idx].GetMap()->size()))
+      param.push_back(fRuns[idx].GetMap(mapVector[i]-1));
   }
 
-  // cleanup
-  param.clear();
-  mapVector.clear();
-  funVector.clear();
-  paramVector.clear();
+  // sort and eliminate multiple identical, and invalid entries
+  std::sort(param.begin(), param.end());
+  param.erase(std::unique(param.begin(), param.end()), param.end());
+  while (!param.empty() && (param[0] == 0))
+    param.erase(param.begin());
+  while (!param.empty() && (param.back() > fParam.size()))
+    param.pop_back();
 
-  return noOfFitParameters;
+  return true;
 }
 
 //--------------------------------------------------------------------------
@@ -6772,4 +6871,23 @@ void PMsrHandler::CheckLegacyLifetimecorrection()
   }
 }
 
+//--------------------------------------------------------------------------
+// WriteMcmcStatistic (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Writes the MCMC posterior summary and convergence diagnostics (see SetMsrStatisticMcmc)
+ * into the STATISTIC block of the mlog-file. Old 'mcmc' lines of the msr-file are not copied.
+ *
+ * \param fout output stream of the mlog-file
+ * \param messages flag, if true the lines are written to stdout as well
+ */
+void PMsrHandler::WriteMcmcStatistic(std::ofstream &fout, const Bool_t messages)
+{
+  for (UInt_t i=0; i<fStatistic.fMcmc.size(); i++) {
+    fout << fStatistic.fMcmc[i].Data() << std::endl;
+    if (messages)
+      std::cout << fStatistic.fMcmc[i].Data() << std::endl;
+  }
+}
+
 // end ---------------------------------------------------------------------
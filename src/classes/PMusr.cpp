@@ -105,6 +105,21 @@ void PRunData::ReplaceTheory(const PDoubleVector &theo)
   fTheory = theo;
 }
 
+//--------------------------------------------------------------------------
+// ReplaceData (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Replaces the data and error vectors, e.g. by a resampled replica of the data.
+ *
+ * \param value vector which is replacing the current data vector
+ * \param error vector which is replacing the current error vector
+ */
+void PRunData::ReplaceData(const PDoubleVector &value, const PDoubleVector &error)
+{
+  fValue = value;
+  fError = error;
+}
+
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // implementation PNonMusrRawRunData
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -566,6 +581,7 @@ PRawRunData::PRawRunData()
   fTransport = PMUSR_UNDEFINED;
   fTimeResolution = PMUSR_UNDEFINED;
   fRedGreenOffset.push_back(0);
+  fHeaderOnly = false;
 }
 
 //--------------------------------------------------------------------------
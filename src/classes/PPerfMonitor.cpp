@@ -0,0 +1,382 @@
+/***************************************************************************
+
+  PPerfMonitor.cpp
+
+  Author: Andreas Suter
+  e-mail: andreas.suter@psi.ch
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2007-2023 by Andreas Suter                              *
+ *   andreas.suter@psi.ch                                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "PPerfMonitor.h"
+
+Bool_t PPerfMonitor::fEnabled = false;
+Bool_t PPerfMonitor::fTracing = false;
+
+//--------------------------------------------------------------------------
+// Constructor (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Constructor. Use GetInstance() to get the monitor.
+ */
+PPerfMonitor::PPerfMonitor()
+{
+  fStart = std::chrono::steady_clock::now();
+}
+
+//--------------------------------------------------------------------------
+// GetInstance (public, static)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns the process-wide performance monitor.
+ */
+PPerfMonitor* PPerfMonitor::GetInstance()
+{
+  static PPerfMonitor instance;
+  return &instance;
+}
+
+//--------------------------------------------------------------------------
+// AddTime (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Adds the time spent in a section. Nothing is done if the monitor is disabled.
+ *
+ * \param name name of the section, e.g. "run_block_01/functions"
+ * \param sec time spent (sec)
+ * \param calls number of calls accounted for
+ */
+void PPerfMonitor::AddTime(const std::string &name, const Double_t sec, const ULong64_t calls)
+{
+  if (!fEnabled)
+    return;
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  AddTimeLocked(name, sec, calls);
+}
+
+//--------------------------------------------------------------------------
+// AddSpan (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Adds a timed section: its time is added to the report (if enabled) and the section is
+ * recorded as span of the calling thread on the timeline (if tracing). Nothing is done if the
+ * monitor is inactive.
+ *
+ * \param name name of the section, e.g. "fcn"
+ * \param start start of the section
+ * \param end end of the section
+ * \param calls number of calls accounted for
+ */
+void PPerfMonitor::AddSpan(const std::string &name, const std::chrono::steady_clock::time_point &start,
+                           const std::chrono::steady_clock::time_point &end, const ULong64_t calls)
+{
+  if (!IsActive())
+    return;
+
+  UInt_t thread = GetThreadId();
+
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  if (fEnabled)
+    AddTimeLocked(name, std::chrono::duration<Double_t>(end-start).count(), calls);
+
+  if (fTracing) {
+    PPerfSpan span;
+    span.fName = name;
+    span.fStart = std::chrono::duration<Double_t, std::micro>(start.time_since_epoch()).count();
+    span.fDur = std::chrono::duration<Double_t, std::micro>(end-start).count();
+    span.fThread = thread;
+    fSpan.push_back(span);
+  }
+}
+
+//--------------------------------------------------------------------------
+// AddTimeLocked (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Adds the time spent in a section. The mutex has to be held by the caller.
+ *
+ * \param name name of the section
+ * \param sec time spent (sec)
+ * \param calls number of calls accounted for
+ */
+void PPerfMonitor::AddTimeLocked(const std::string &name, const Double_t sec, const ULong64_t calls)
+{
+  PPerfTimerEntry &entry = fTimer[name];
+  entry.fTime += sec;
+  entry.fCalls += calls;
+  if ((entry.fMin < 0.0) || (sec < entry.fMin))
+    entry.fMin = sec;
+  if (sec > entry.fMax)
+    entry.fMax = sec;
+}
+
+//--------------------------------------------------------------------------
+// AddCount (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Increments a counter. Nothing is done if the monitor is disabled.
+ *
+ * \param name name of the counter
+ * \param n increment
+ */
+void PPerfMonitor::AddCount(const std::string &name, const ULong64_t n)
+{
+  if (!fEnabled)
+    return;
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  fCounter[name] += n;
+}
+
+//--------------------------------------------------------------------------
+// GetCacheCounter (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns the hit/miss counter of the cache with the given name, creating it if needed.
+ * Objects using a cache of the same kind share the counter. The pointer stays valid for
+ * the lifetime of the process, hence it is typically fetched once in the constructor.
+ *
+ * \param name name of the cache
+ */
+PPerfCacheCounter* PPerfMonitor::GetCacheCounter(const std::string &name)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return &fCache[name];
+}
+
+//--------------------------------------------------------------------------
+// SetInfo (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Sets general information written to the report, e.g. the msr-file name.
+ *
+ * \param key name of the information
+ * \param value value of the information
+ */
+void PPerfMonitor::SetInfo(const std::string &key, const std::string &value)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  fInfo[key] = value;
+}
+
+//--------------------------------------------------------------------------
+// Reset (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Clears all timers and counters and restarts the wall clock of the report.
+ */
+void PPerfMonitor::Reset()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  fStart = std::chrono::steady_clock::now();
+  fTimer.clear();
+  fCounter.clear();
+  fSpan.clear();
+  for (auto &cache : fCache)
+    cache.second.Reset();
+}
+
+//--------------------------------------------------------------------------
+// WriteJson (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Writes the report in JSON format:
+ * \code
+ * { "info": {...}, "wall_time_s": t,
+ *   "timers": { "<section>": {"time_s": t, "calls": n, "mean_s": t/n, "min_s": ..., "max_s": ...}, ... },
+ *   "counters": { "<name>": n, ... },
+ *   "caches": { "<name>": {"hits": h, "misses": m, "hit_rate": h/(h+m)}, ... } }
+ * \endcode
+ *
+ * <p><b>return:</b> true if the file could be written, false otherwise
+ *
+ * \param fileName name of the report file
+ */
+Bool_t PPerfMonitor::WriteJson(const std::string &fileName) const
+{
+  std::ofstream fout(fileName.c_str());
+  if (!fout.is_open()) {
+    std::cerr << std::endl << ">> PPerfMonitor::WriteJson(): **ERROR** couldn't open '" << fileName << "' for writing." << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  Double_t wallTime = std::chrono::duration<Double_t>(std::chrono::steady_clock::now()-fStart).count();
+
+  fout << std::setprecision(9);
+  fout << "{" << std::endl;
+
+  fout << "  \"info\": {";
+  Bool_t first = true;
+  for (auto &info : fInfo) {
+    fout << (first ? "" : ",") << std::endl << "    \"" << Escape(info.first) << "\": \"" << Escape(info.second) << "\"";
+    first = false;
+  }
+  fout << std::endl << "  }," << std::endl;
+
+  fout << "  \"wall_time_s\": " << wallTime << "," << std::endl;
+
+  fout << "  \"timers\": {";
+  first = true;
+  for (auto &timer : fTimer) {
+    const PPerfTimerEntry &entry = timer.second;
+    fout << (first ? "" : ",") << std::endl << "    \"" << Escape(timer.first) << "\": {";
+    fout << "\"time_s\": " << entry.fTime << ", \"calls\": " << entry.fCalls;
+    fout << ", \"mean_s\": " << ((entry.fCalls > 0) ? entry.fTime/static_cast<Double_t>(entry.fCalls) : 0.0);
+    fout << ", \"min_s\": " << ((entry.fMin < 0.0) ? 0.0 : entry.fMin) << ", \"max_s\": " << entry.fMax << "}";
+    first = false;
+  }
+  fout << std::endl << "  }," << std::endl;
+
+  fout << "  \"counters\": {";
+  first = true;
+  for (auto &counter : fCounter) {
+    fout << (first ? "" : ",") << std::endl << "    \"" << Escape(counter.first) << "\": " << counter.second;
+    first = false;
+  }
+  fout << std::endl << "  }," << std::endl;
+
+  fout << "  \"caches\": {";
+  first = true;
+  for (auto &cache : fCache) {
+    ULong64_t hits = cache.second.GetHits();
+    ULong64_t misses = cache.second.GetMisses();
+    fout << (first ? "" : ",") << std::endl << "    \"" << Escape(cache.first) << "\": {";
+    fout << "\"hits\": " << hits << ", \"misses\": " << misses;
+    fout << ", \"hit_rate\": " << ((hits+misses > 0) ? static_cast<Double_t>(hits)/static_cast<Double_t>(hits+misses) : 0.0) << "}";
+    first = false;
+  }
+  fout << std::endl << "  }" << std::endl;
+
+  fout << "}" << std::endl;
+
+  fout.close();
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+// WriteTrace (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Writes the recorded spans as timeline in the Chrome trace-event format ("X" events). The
+ * category of a span is the part of its name before the first '/', e.g. "run_block_01". The time
+ * stamps are taken from the monotonic clock, such that the timelines of several processes (e.g.
+ * msr2data and the musrfit calls it spawns) can be loaded together.
+ *
+ * <p><b>return:</b> true if the file could be written, false otherwise
+ *
+ * \param fileName name of the trace file
+ * \param processName name of the process shown on the timeline
+ */
+Bool_t PPerfMonitor::WriteTrace(const std::string &fileName, const std::string &processName) const
+{
+  std::ofstream fout(fileName.c_str());
+  if (!fout.is_open()) {
+    std::cerr << std::endl << ">> PPerfMonitor::WriteTrace(): **ERROR** couldn't open '" << fileName << "' for writing." << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(fMutex);
+
+  const Int_t pid = static_cast<Int_t>(getpid());
+
+  fout << std::fixed << std::setprecision(3);
+  fout << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << std::endl;
+  fout << "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << pid << ", \"tid\": 0, \"args\": {\"name\": \"" << Escape(processName) << "\"}}";
+  for (auto &span : fSpan) {
+    std::string cat = span.fName.substr(0, span.fName.find('/'));
+    fout << "," << std::endl << "  {\"name\": \"" << Escape(span.fName) << "\", \"cat\": \"" << Escape(cat) << "\", \"ph\": \"X\"";
+    fout << ", \"ts\": " << span.fStart << ", \"dur\": " << span.fDur << ", \"pid\": " << pid << ", \"tid\": " << span.fThread << "}";
+  }
+  fout << std::endl << "]}" << std::endl;
+
+  fout.close();
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+// GetThreadId (private, static)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns a small id of the calling thread, assigned in the order of the first span recorded
+ * by the thread (i.e. the main thread is typically 0).
+ */
+UInt_t PPerfMonitor::GetThreadId()
+{
+  static std::atomic<UInt_t> next(0);
+  thread_local UInt_t id = next++;
+  return id;
+}
+
+//--------------------------------------------------------------------------
+// Escape (private, static)
+//--------------------------------------------------------------------------
+/**
+ * <p>Escapes a string such that it can be written as JSON string.
+ *
+ * \param str string to be escaped
+ */
+std::string PPerfMonitor::Escape(const std::string &str)
+{
+  std::string result;
+  char buf[8];
+
+  for (unsigned char ch : str) {
+    switch (ch) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      default:
+        if (ch < 0x20) {
+          snprintf(buf, sizeof(buf), "\\u%04x", ch);
+          result += buf;
+        } else {
+          result += static_cast<char>(ch);
+        }
+        break;
+    }
+  }
+
+  return result;
+}
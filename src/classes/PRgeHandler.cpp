@@ -27,6 +27,8 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <vector>
@@ -430,8 +432,17 @@ PRgeHandler::PRgeHandler(const std::string fln)
         dataSet.nn[j] = dataSet.amplitude[j] / tot;
       }
 
+      // resample n(z) on a uniform grid for O(1) lookups
+      ResampleOnGrid(dataSet);
+
       fData.push_back(dataSet);
     }
+
+    // energy -> index hash. The stored index is the one the tolerance search
+    // delivers for the given energy, hence lookups via the hash are identical
+    // to the search.
+    for (int i=0; i<fData.size(); i++)
+      fEnergyIndex.emplace((Int_t)fData[i].energy, FindEnergyIndex(fData[i].energy));
   }
 
   delete saxParser;
@@ -560,16 +571,10 @@ bool PRgeHandler::ReadRgeFile(const std::string fln, PRgeData &data)
  * @param energy energy in (eV)
  * @return zMax if energy is found, -1 otherwise.
  */
-Double_t PRgeHandler::GetZmax(const Double_t energy)
+Double_t PRgeHandler::GetZmax(const Double_t energy) const
 {
-  int idx=-1;
-  for (int i=0; i<fData.size(); i++) {
-    if (fabs(fData[i].energy-energy)*0.001 < 0.9){
-      idx = i;
-      break;
-    }
-  }
-  
+  int idx = GetEnergyIndex(energy);
+
   if (idx != -1)
       return GetZmax(idx);
 
@@ -585,7 +590,7 @@ Double_t PRgeHandler::GetZmax(const Double_t energy)
  * @param idx index for which zMax is requested.
  * @return zMax if idx is in range, -1 otherwise.
  */
-Double_t PRgeHandler::GetZmax(const Int_t idx)
+Double_t PRgeHandler::GetZmax(const Int_t idx) const
 {
   if ((idx < 0) || (idx >= fData.size()))
     return -1.0;
@@ -603,15 +608,9 @@ Double_t PRgeHandler::GetZmax(const Int_t idx)
  * @param z (nm)
  * @return n(E,z) if energy and z are in proper range, -1.0 otherwise.
  */
-Double_t PRgeHandler::Get_n(const Double_t energy, const Double_t z)
+Double_t PRgeHandler::Get_n(const Double_t energy, const Double_t z) const
 {
-  int idx=-1;
-  for (int i=0; i<fData.size(); i++) {
-    if (fabs(fData[i].energy-energy)*0.001 < 0.90) {
-      idx = i;
-      break;
-    }
-  }
+  int idx = GetEnergyIndex(energy);
   if (idx == -1)
     return 0.0;
 
@@ -622,50 +621,107 @@ Double_t PRgeHandler::Get_n(const Double_t energy, const Double_t z)
 // Get_n via index
 //--------------------------------------------------------------------------
 /**
- * <p>Get the normalized n(idx,z) value.
+ * <p>Get the normalized n(idx,z) value. The value is linearly interpolated
+ * on the uniform grid set up at load time, i.e. no search is involved.
  *
  * @param idx index of the rge-dataset
  * @param z (nm)
- * @return n(idx,z) if idx and z are in proper range, -1.0 otherwise.
+ * @return n(idx,z) if idx and z are in proper range, 0.0 otherwise.
  */
-Double_t PRgeHandler::Get_n(const Int_t idx, const Double_t z)
+Double_t PRgeHandler::Get_n(const Int_t idx, const Double_t z) const
 {
   if ((idx < 0) || (idx >= fData.size()))
     return 0.0;
 
-  if ((z < 0.0) || (z > GetZmax(idx)))
+  const PRgeData &data = fData[idx];
+  if ((z < 0.0) || (z > data.depth.back()))
     return 0.0;
 
-  int pos=0;
-  for (int i=0; i<fData[idx].depth.size(); i++) {
-    if (z <= fData[idx].depth[i]) {
-      pos = i-1;
-      break;
+  const Double_t x = z/data.dzGrid;
+  const UInt_t k = (UInt_t)x;
+  if (k+1 >= data.nnGrid.size())
+    return data.nnGrid.back();
+  if (k+2 == data.nnGrid.size()) // last grid cell, which ends at zMax
+    return data.nnGrid[k] + (data.nnGrid[k+1]-data.nnGrid[k])*(z-k*data.dzGrid)/data.dzGridLast;
+
+  return data.nnGrid[k] + (data.nnGrid[k+1]-data.nnGrid[k])*(x-k);
+}
+
+//--------------------------------------------------------------------------
+// Get_n for a set of depths
+//--------------------------------------------------------------------------
+/**
+ * <p>Get the normalized n(idx,z_i) values for all depths z_i.
+ *
+ * @param idx index of the rge-dataset
+ * @param z depths (nm)
+ * @param nn n(idx,z_i), resized to the size of z. Set to 0.0 for all z_i if idx is out of range.
+ */
+void PRgeHandler::Get_n(const Int_t idx, const PDoubleVector &z, PDoubleVector &nn) const
+{
+  nn.resize(z.size());
+
+  if ((idx < 0) || (idx >= fData.size())) {
+    std::fill(nn.begin(), nn.end(), 0.0);
+    return;
+  }
+
+  const PRgeData &data = fData[idx];
+  const Double_t zMax = data.depth.back();
+  const Double_t invDz = 1.0/data.dzGrid;
+  const UInt_t last = data.nnGrid.size()-1;
+  Double_t x;
+  UInt_t k;
+  for (UInt_t i=0; i<z.size(); i++) {
+    if ((z[i] < 0.0) || (z[i] > zMax)) {
+      nn[i] = 0.0;
+      continue;
     }
+    x = z[i]*invDz;
+    k = (UInt_t)x;
+    if (k >= last)
+      nn[i] = data.nnGrid[last];
+    else if (k+1 == last) // last grid cell, which ends at zMax
+      nn[i] = data.nnGrid[k] + (data.nnGrid[k+1]-data.nnGrid[k])*(z[i]-k*data.dzGrid)/data.dzGridLast;
+    else
+      nn[i] = data.nnGrid[k] + (data.nnGrid[k+1]-data.nnGrid[k])*(x-k);
   }
+}
 
-  Double_t nn=0.0;
-  if (pos < 0) {
-    nn = fData[idx].nn[0] * z/(fData[idx].depth[1]-fData[idx].depth[0]);
-  } else { // linear interpolation
-    nn = fData[idx].nn[pos] +
-         (fData[idx].nn[pos+1] - fData[idx].nn[pos]) *
-         (z-fData[idx].depth[pos])/(fData[idx].depth[pos+1]-fData[idx].depth[pos]);
+//--------------------------------------------------------------------------
+// GetEnergyIndex
+//--------------------------------------------------------------------------
+/**
+ * <p>Get the energy index by providing an energy in (eV). Energies present
+ * in the rge-file list are resolved via hash lookup, all others by
+ * FindEnergyIndex.
+ *
+ * @param energy in (eV).
+ * @return energy index if energy was found, -1 otherwise.
+ */
+Int_t PRgeHandler::GetEnergyIndex(const Double_t energy) const
+{
+  const Int_t key = (Int_t)energy;
+  if ((Double_t)key == energy) {
+    auto it = fEnergyIndex.find(key);
+    if (it != fEnergyIndex.end())
+      return it->second;
   }
 
-  return nn;
+  return FindEnergyIndex(energy);
 }
 
 //--------------------------------------------------------------------------
-// GetEnergyIndex
+// FindEnergyIndex (private)
 //--------------------------------------------------------------------------
 /**
- * <p>Get the energy index by providing an energy in (eV).
+ * <p>Search the energy index by providing an energy in (eV). The first
+ * rge-dataset with an energy within 0.9 keV is returned.
  *
  * @param energy in (eV).
  * @return energy index if energy was found, -1 otherwise.
  */
-Int_t PRgeHandler::GetEnergyIndex(const Double_t energy)
+Int_t PRgeHandler::FindEnergyIndex(const Double_t energy) const
 {
   int idx=-1;
   for (int i=0; i<fData.size(); i++) {
@@ -677,3 +733,60 @@ Int_t PRgeHandler::GetEnergyIndex(const Double_t energy)
 
   return idx;
 }
+
+//--------------------------------------------------------------------------
+// ResampleOnGrid (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Resample n(z) on the uniform grid z_k = k dzGrid, k=0..K-1, and
+ * z_K = zMax. If zMax is not a multiple of dzGrid, the last cell is shorter;
+ * its width is kept in dzGridLast. dzGrid is the smallest depth step found
+ * in the rge-file (limited to at most 100000 grid points). TrimSP writes equidistant depths,
+ * hence the grid coincides with the rge-file depths and the resampling is
+ * exact.
+ *
+ * @param data rge-dataset for which the grid shall be set up.
+ */
+void PRgeHandler::ResampleOnGrid(PRgeData &data)
+{
+  const UInt_t maxNoOfGridPoints = 100000;
+
+  data.nnGrid.clear();
+  data.dzGrid = 1.0;
+  data.dzGridLast = 1.0;
+  if (data.depth.size() < 2)
+    return;
+
+  const Double_t zMax = data.depth.back();
+  Double_t dz = (data.depth[0] > 0.0) ? data.depth[0] : zMax;
+  for (UInt_t i=1; i<data.depth.size(); i++) {
+    if ((data.depth[i]-data.depth[i-1] > 0.0) && (data.depth[i]-data.depth[i-1] < dz))
+      dz = data.depth[i]-data.depth[i-1];
+  }
+  if ((dz <= 0.0) || (zMax/dz > maxNoOfGridPoints))
+    dz = zMax/maxNoOfGridPoints;
+
+  const UInt_t noOfGridPoints = (UInt_t)ceil(zMax/dz - 1.0e-6) + 1;
+  data.dzGrid = dz;
+  data.dzGridLast = zMax - (noOfGridPoints-2)*dz;
+  if (data.dzGridLast <= 0.0) // zMax/dz is an integer within rounding
+    data.dzGridLast = dz;
+  data.nnGrid.resize(noOfGridPoints);
+
+  // linear interpolation of the rge-file values. Since the z_k are increasing,
+  // the depth interval can be tracked instead of searched.
+  UInt_t pos=0;
+  Double_t zz;
+  for (UInt_t k=0; k<noOfGridPoints; k++) {
+    zz = std::min(k*dz, zMax);
+    while ((pos < data.depth.size()) && (zz > data.depth[pos]))
+      pos++;
+    if (pos == 0) {
+      data.nnGrid[k] = data.nn[0] * zz/(data.depth[1]-data.depth[0]);
+    } else {
+      data.nnGrid[k] = data.nn[pos-1] +
+                       (data.nn[pos] - data.nn[pos-1]) *
+                       (zz-data.depth[pos-1])/(data.depth[pos]-data.depth[pos-1]);
+    }
+  }
+}
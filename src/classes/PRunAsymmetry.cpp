@@ -179,6 +179,10 @@ PRunAsymmetry::~PRunAsymmetry()
   fForwardErr.clear();
   fBackward.clear();
   fBackwardErr.clear();
+  fForwardCum.Clear();
+  fForwardErr2Cum.Clear();
+  fBackwardCum.Clear();
+  fBackwardErr2Cum.Clear();
 }
 
 //--------------------------------------------------------------------------
@@ -200,15 +204,100 @@ Double_t PRunAsymmetry::CalcChiSquare(const std::vector<Double_t>& par)
   Double_t a, b, f;
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate chi square
   Double_t time(1.0);
   Int_t i;
 
   // determine alpha/beta
+  GetAlphaBeta(par, a, b);
+
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
+  // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
+  // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
+  // for a given set of parameters---which should be done outside of the parallelized loop.
+  // For all other functions it means a tiny and acceptable overhead.
+  asymFcnValue = fTheory->Func(time, par, fFuncValues);
+
+  #ifdef HAVE_GOMP
+  Int_t chunk = (fEndTimeBin - fStartTimeBin)/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(i,time,diff,asymFcnValue,f) schedule(dynamic,chunk) reduction(+:chisq)
+  #endif
+  for (i=fStartTimeBin; i<fEndTimeBin; ++i) {
+    time = fData.GetDataTimeStart() + static_cast<Double_t>(i)*fData.GetDataTimeStep();
+    f = fTheory->Func(time, par, fFuncValues);
+    asymFcnValue = (f*(a*b+1.0)-(a-1.0))/((a+1.0)-f*(a*b-1.0));
+    diff = fData.GetValue()->at(i) - asymFcnValue;
+    chisq += diff*diff / (fData.GetError()->at(i)*fData.GetError()->at(i));
+  }
+
+  return chisq;
+}
+
+//--------------------------------------------------------------------------
+// CalcResiduals (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculate the normalized residuals (data-theory)/error of all fitted bins, used by the
+ * least-squares fitter (LEAST_SQUARES). The sum of their squares is the chi-square of CalcChiSquare.
+ *
+ * \param par parameter vector iterated by the fitter
+ * \param residuals normalized residuals of the fitted bins
+ */
+void PRunAsymmetry::CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals)
+{
+  Double_t asymFcnValue = 0.0;
+  Double_t a, b, f;
+
+  // calculate functions
+  CalcFuncValues(par);
+
+  Double_t time(1.0);
+  Int_t i;
+
+  // determine alpha/beta
+  GetAlphaBeta(par, a, b);
+
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
+  // Calculate the theory function once to ensure one function evaluation for the current set of parameters,
+  // outside of the parallelized loop (see CalcChiSquare).
+  asymFcnValue = fTheory->Func(time, par, fFuncValues);
+
+  residuals.resize((fEndTimeBin > fStartTimeBin) ? fEndTimeBin-fStartTimeBin : 0);
+
+  #ifdef HAVE_GOMP
+  Int_t chunk = (fEndTimeBin - fStartTimeBin)/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(i,time,asymFcnValue,f) schedule(dynamic,chunk)
+  #endif
+  for (i=fStartTimeBin; i<fEndTimeBin; ++i) {
+    time = fData.GetDataTimeStart() + static_cast<Double_t>(i)*fData.GetDataTimeStep();
+    f = fTheory->Func(time, par, fFuncValues);
+    asymFcnValue = (f*(a*b+1.0)-(a-1.0))/((a+1.0)-f*(a*b-1.0));
+    residuals[i-fStartTimeBin] = (fData.GetValue()->at(i) - asymFcnValue) / fData.GetError()->at(i);
+  }
+}
+
+//--------------------------------------------------------------------------
+// GetAlphaBeta (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Determines alpha and beta for the given parameter set according to fAlphaBetaTag.
+ *
+ * \param par parameter vector iterated by the fitter
+ * \param a alpha
+ * \param b beta
+ */
+void PRunAsymmetry::GetAlphaBeta(const std::vector<Double_t>& par, Double_t &a, Double_t &b)
+{
   switch (fAlphaBetaTag) {
     case 1: // alpha == 1, beta == 1
       a = 1.0;
@@ -259,28 +348,6 @@ Double_t PRunAsymmetry::CalcChiSquare(const std::vector<Double_t>& par)
       b = 1.0;
       break;
   }
-
-  // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
-  // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
-  // for a given set of parameters---which should be done outside of the parallelized loop.
-  // For all other functions it means a tiny and acceptable overhead.
-  asymFcnValue = fTheory->Func(time, par, fFuncValues);
-
-  #ifdef HAVE_GOMP
-  Int_t chunk = (fEndTimeBin - fStartTimeBin)/omp_get_num_procs();
-  if (chunk < 10)
-    chunk = 10;
-  #pragma omp parallel for default(shared) private(i,time,diff,asymFcnValue,f) schedule(dynamic,chunk) reduction(+:chisq)
-  #endif
-  for (i=fStartTimeBin; i<fEndTimeBin; ++i) {
-    time = fData.GetDataTimeStart() + static_cast<Double_t>(i)*fData.GetDataTimeStep();
-    f = fTheory->Func(time, par, fFuncValues);
-    asymFcnValue = (f*(a*b+1.0)-(a-1.0))/((a+1.0)-f*(a*b-1.0));
-    diff = fData.GetValue()->at(i) - asymFcnValue;
-    chisq += diff*diff / (fData.GetError()->at(i)*fData.GetError()->at(i));
-  }
-
-  return chisq;
 }
 
 //--------------------------------------------------------------------------
@@ -456,9 +523,7 @@ void PRunAsymmetry::CalcTheory()
     par.push_back((*paramList)[i].fValue);
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate asymmetry
   Double_t asymFcnValue = 0.0;
@@ -723,6 +788,12 @@ Bool_t PRunAsymmetry::PrepareData()
       return false;
   }
 
+  // cumulative forms of the background corrected histos, used for the packing
+  fForwardCum.Set(fForward);
+  fForwardErr2Cum.Set(fForwardErr, true);
+  fBackwardCum.Set(fBackward);
+  fBackwardErr2Cum.Set(fBackwardErr, true);
+
   UInt_t histoNo[2] = {forwardHistoNo[0], backwardHistoNo[0]};
 
   // get the data range (fgb/lgb) for the current RUN block
@@ -958,52 +1029,11 @@ Bool_t PRunAsymmetry::PrepareFitData()
   // everything looks fine, hence fill packed forward and backward histo
   PRunData forwardPacked;
   PRunData backwardPacked;
-  Double_t value = 0.0;
   Double_t error = 0.0;
   // forward
-  for (Int_t i=fGoodBins[0]; i<fGoodBins[1]; i++) {
-    if (fPacking == 1) {
-      forwardPacked.AppendValue(fForward[i]);
-      forwardPacked.AppendErrorValue(fForwardErr[i]);
-    } else { // packed data, i.e. fPacking > 1
-      if (((i-fGoodBins[0]) % fPacking == 0) && (i != fGoodBins[0])) { // fill data
-        // in order that after rebinning the fit does not need to be redone (important for plots)
-        // the value is normalize to per bin
-        value /= fPacking;
-        forwardPacked.AppendValue(value);
-        if (value == 0.0)
-          forwardPacked.AppendErrorValue(1.0);
-        else
-          forwardPacked.AppendErrorValue(TMath::Sqrt(error)/fPacking);
-        value = 0.0;
-        error = 0.0;
-      }
-      value += fForward[i];
-      error += fForwardErr[i]*fForwardErr[i];
-    }
-  }
+  PackHisto(fForward, fForwardErr, fForwardCum, fForwardErr2Cum, fGoodBins[0], fGoodBins[1], fPacking, forwardPacked);
   // backward
-  for (Int_t i=fGoodBins[2]; i<fGoodBins[3]; i++) {
-    if (fPacking == 1) {
-      backwardPacked.AppendValue(fBackward[i]);
-      backwardPacked.AppendErrorValue(fBackwardErr[i]);
-    } else { // packed data, i.e. fPacking > 1
-      if (((i-fGoodBins[2]) % fPacking == 0) && (i != fGoodBins[2])) { // fill data
-        // in order that after rebinning the fit does not need to be redone (important for plots)
-        // the value is normalize to per bin
-        value /= fPacking;
-        backwardPacked.AppendValue(value);
-        if (value == 0.0)
-          backwardPacked.AppendErrorValue(1.0);
-        else
-          backwardPacked.AppendErrorValue(TMath::Sqrt(error)/fPacking);
-        value = 0.0;
-        error = 0.0;
-      }
-      value += fBackward[i];
-      error += fBackwardErr[i]*fBackwardErr[i];
-    }
-  }
+  PackHisto(fBackward, fBackwardErr, fBackwardCum, fBackwardErr2Cum, fGoodBins[2], fGoodBins[3], fPacking, backwardPacked);
 
   // check if packed forward and backward hist have the same size, otherwise take the minimum size
   UInt_t noOfBins = forwardPacked.GetValue()->size();
@@ -1046,6 +1076,10 @@ Bool_t PRunAsymmetry::PrepareFitData()
   fForwardErr.clear();
   fBackward.clear();
   fBackwardErr.clear();
+  fForwardCum.Clear();
+  fForwardErr2Cum.Clear();
+  fBackwardCum.Clear();
+  fBackwardErr2Cum.Clear();
 
   return true;
 }
@@ -1162,50 +1196,10 @@ Bool_t PRunAsymmetry::PrepareViewData(PRawRunData* runData, UInt_t histoNo[2])
   Double_t error = 0.0;
 
   // forward
-  for (Int_t i=start[0]; i<end[0]; i++) {
-    if (packing == 1) {
-      forwardPacked.AppendValue(fForward[i]);
-      forwardPacked.AppendErrorValue(fForwardErr[i]);
-    } else { // packed data, i.e. packing > 1
-      if (((i-start[0]) % packing == 0) && (i != start[0])) { // fill data
-        // in order that after rebinning the fit does not need to be redone (important for plots)
-        // the value is normalize to per bin
-        value /= packing;
-        forwardPacked.AppendValue(value);
-        if (value == 0.0)
-          forwardPacked.AppendErrorValue(1.0);
-        else
-          forwardPacked.AppendErrorValue(TMath::Sqrt(error)/packing);
-        value = 0.0;
-        error = 0.0;
-      }
-      value += fForward[i];
-      error += fForwardErr[i]*fForwardErr[i];
-    }
-  }
+  PackHisto(fForward, fForwardErr, fForwardCum, fForwardErr2Cum, start[0], end[0], packing, forwardPacked);
 
   // backward
-  for (Int_t i=start[1]; i<end[1]; i++) {
-    if (packing == 1) {
-      backwardPacked.AppendValue(fBackward[i]);
-      backwardPacked.AppendErrorValue(fBackwardErr[i]);
-    } else { // packed data, i.e. packing > 1
-      if (((i-start[1]) % packing == 0) && (i != start[1])) { // fill data
-        // in order that after rebinning the fit does not need to be redone (important for plots)
-        // the value is normalize to per bin
-        value /= packing;
-        backwardPacked.AppendValue(value);
-        if (value == 0.0)
-          backwardPacked.AppendErrorValue(1.0);
-        else
-          backwardPacked.AppendErrorValue(TMath::Sqrt(error)/packing);
-        value = 0.0;
-        error = 0.0;
-      }
-      value += fBackward[i];
-      error += fBackwardErr[i]*fBackwardErr[i];
-    }
-  }
+  PackHisto(fBackward, fBackwardErr, fBackwardCum, fBackwardErr2Cum, start[1], end[1], packing, backwardPacked);
 
   // check if packed forward and backward hist have the same size, otherwise take the minimum size
   UInt_t noOfBins = forwardPacked.GetValue()->size();
@@ -1299,12 +1293,14 @@ Bool_t PRunAsymmetry::PrepareViewData(PRawRunData* runData, UInt_t histoNo[2])
   fForwardErr.clear();
   fBackward.clear();
   fBackwardErr.clear();
+  fForwardCum.Clear();
+  fForwardErr2Cum.Clear();
+  fBackwardCum.Clear();
+  fBackwardErr2Cum.Clear();
 
   // fill theory vector for kView
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate theory
   Double_t time;
@@ -1540,6 +1536,10 @@ Bool_t PRunAsymmetry::PrepareRRFViewData(PRawRunData* runData, UInt_t histoNo[2]
   fForwardErr.clear();
   fBackward.clear();
   fBackwardErr.clear();
+  fForwardCum.Clear();
+  fForwardErr2Cum.Clear();
+  fBackwardCum.Clear();
+  fBackwardErr2Cum.Clear();
 
 
   // ------------------------------------------------------------
@@ -1610,9 +1610,7 @@ Bool_t PRunAsymmetry::PrepareRRFViewData(PRawRunData* runData, UInt_t histoNo[2]
   fData.SetTheoryTimeStep(TMath::Pi()/2.0/wRRF/rebinRRF); // = theory time resolution as close as possible to the data time resolution compatible with wRRF
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   Double_t theoryValue;
   for (UInt_t i=0; i<asymmetry.size(); i++) {
@@ -179,6 +179,14 @@ PRunAsymmetryBNMR::~PRunAsymmetryBNMR()
   fForwardmErr.clear();
   fBackwardm.clear();
   fBackwardmErr.clear();
+  fForwardpCum.Clear();
+  fForwardpErr2Cum.Clear();
+  fBackwardpCum.Clear();
+  fBackwardpErr2Cum.Clear();
+  fForwardmCum.Clear();
+  fForwardmErr2Cum.Clear();
+  fBackwardmCum.Clear();
+  fBackwardmErr2Cum.Clear();
 }
 
 //--------------------------------------------------------------------------
@@ -200,16 +208,102 @@ Double_t PRunAsymmetryBNMR::CalcChiSquare(const std::vector<Double_t>& par)
   Double_t a, b, f;
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate chi square
-  Double_t time(1.0),alphaest;
+  Double_t time(1.0);
   Int_t i;
 
   // determine alpha/beta
-  alphaest = fRunInfo->GetEstimatedAlpha();
+  GetAlphaBeta(par, a, b);
+
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
+  // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
+  // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
+  // for a given set of parameters---which should be done outside of the parallelized loop.
+  // For all other functions it means a tiny and acceptable overhead.
+  asymFcnValue = fTheory->Func(time, par, fFuncValues);
+
+  #ifdef HAVE_GOMP
+  Int_t chunk = (fEndTimeBin - fStartTimeBin)/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(i,time,diff,asymFcnValue,f) schedule(dynamic,chunk) reduction(+:chisq)
+  #endif
+  for (i=fStartTimeBin; i<fEndTimeBin; ++i) {
+    time = fData.GetDataTimeStart() + static_cast<Double_t>(i)*fData.GetDataTimeStep();
+    f = fTheory->Func(time, par, fFuncValues)/2.0;
+    asymFcnValue = (f*(a*b+1.0)-(a-1.0))/((a+1.0)-f*(a*b-1.0))-(-f*(a*b+1.0)-(a-1.0))/((a+1.0)+f*(a*b-1.0));
+    diff = fData.GetValue()->at(i) - asymFcnValue;
+    chisq += diff*diff / (fData.GetError()->at(i)*fData.GetError()->at(i));
+  }
+
+  return chisq;
+}
+
+//--------------------------------------------------------------------------
+// CalcResiduals (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculate the normalized residuals (data-theory)/error of all fitted bins, used by the
+ * least-squares fitter (LEAST_SQUARES). The sum of their squares is the chi-square of CalcChiSquare.
+ *
+ * \param par parameter vector iterated by the fitter
+ * \param residuals normalized residuals of the fitted bins
+ */
+void PRunAsymmetryBNMR::CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals)
+{
+  Double_t asymFcnValue = 0.0;
+  Double_t a, b, f;
+
+  // calculate functions
+  CalcFuncValues(par);
+
+  Double_t time(1.0);
+  Int_t i;
+
+  // determine alpha/beta
+  GetAlphaBeta(par, a, b);
+
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
+  // Calculate the theory function once to ensure one function evaluation for the current set of parameters,
+  // outside of the parallelized loop (see CalcChiSquare).
+  asymFcnValue = fTheory->Func(time, par, fFuncValues);
+
+  residuals.resize((fEndTimeBin > fStartTimeBin) ? fEndTimeBin-fStartTimeBin : 0);
+
+  #ifdef HAVE_GOMP
+  Int_t chunk = (fEndTimeBin - fStartTimeBin)/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(i,time,asymFcnValue,f) schedule(dynamic,chunk)
+  #endif
+  for (i=fStartTimeBin; i<fEndTimeBin; ++i) {
+    time = fData.GetDataTimeStart() + static_cast<Double_t>(i)*fData.GetDataTimeStep();
+    f = fTheory->Func(time, par, fFuncValues)/2.0;
+    asymFcnValue = (f*(a*b+1.0)-(a-1.0))/((a+1.0)-f*(a*b-1.0))-(-f*(a*b+1.0)-(a-1.0))/((a+1.0)+f*(a*b-1.0));
+    residuals[i-fStartTimeBin] = (fData.GetValue()->at(i) - asymFcnValue) / fData.GetError()->at(i);
+  }
+}
+
+//--------------------------------------------------------------------------
+// GetAlphaBeta (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Determines alpha and beta for the given parameter set according to fAlphaBetaTag.
+ *
+ * \param par parameter vector iterated by the fitter
+ * \param a alpha
+ * \param b beta
+ */
+void PRunAsymmetryBNMR::GetAlphaBeta(const std::vector<Double_t>& par, Double_t &a, Double_t &b)
+{
+  Double_t alphaest = fRunInfo->GetEstimatedAlpha();
+
   switch (fAlphaBetaTag) {
     case 1: // alpha == 1, beta == 1
       a = 1.0;
@@ -275,28 +369,6 @@ Double_t PRunAsymmetryBNMR::CalcChiSquare(const std::vector<Double_t>& par)
       b = 1.0;
       break;
   }
-
-  // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
-  // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
-  // for a given set of parameters---which should be done outside of the parallelized loop.
-  // For all other functions it means a tiny and acceptable overhead.
-  asymFcnValue = fTheory->Func(time, par, fFuncValues);
-
-  #ifdef HAVE_GOMP
-  Int_t chunk = (fEndTimeBin - fStartTimeBin)/omp_get_num_procs();
-  if (chunk < 10)
-    chunk = 10;
-  #pragma omp parallel for default(shared) private(i,time,diff,asymFcnValue,f) schedule(dynamic,chunk) reduction(+:chisq)
-  #endif
-  for (i=fStartTimeBin; i<fEndTimeBin; ++i) {
-    time = fData.GetDataTimeStart() + static_cast<Double_t>(i)*fData.GetDataTimeStep();
-    f = fTheory->Func(time, par, fFuncValues)/2.0;
-    asymFcnValue = (f*(a*b+1.0)-(a-1.0))/((a+1.0)-f*(a*b-1.0))-(-f*(a*b+1.0)-(a-1.0))/((a+1.0)+f*(a*b-1.0));
-    diff = fData.GetValue()->at(i) - asymFcnValue;
-    chisq += diff*diff / (fData.GetError()->at(i)*fData.GetError()->at(i));
-  }
-
-  return chisq;
 }
 
 //--------------------------------------------------------------------------
@@ -472,9 +544,7 @@ void PRunAsymmetryBNMR::CalcTheory()
     par.push_back((*paramList)[i].fValue);
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate asymmetry
   Double_t asymFcnValue = 0.0;
@@ -758,6 +828,16 @@ Bool_t PRunAsymmetryBNMR::PrepareData()
       return false;
   }
 
+  // cumulative forms of the background corrected histos, used for the packing
+  fForwardpCum.Set(fForwardp);
+  fForwardpErr2Cum.Set(fForwardpErr, true);
+  fBackwardpCum.Set(fBackwardp);
+  fBackwardpErr2Cum.Set(fBackwardpErr, true);
+  fForwardmCum.Set(fForwardm);
+  fForwardmErr2Cum.Set(fForwardmErr, true);
+  fBackwardmCum.Set(fBackwardm);
+  fBackwardmErr2Cum.Set(fBackwardmErr, true);
+
   UInt_t histoNo[2] = {forwardHistoNo[0], backwardHistoNo[0]};
 
   // get the data range (fgb/lgb) for the current RUN block
@@ -1028,84 +1108,16 @@ Bool_t PRunAsymmetryBNMR::PrepareFitData()
   PRunData backwardpPacked;
   PRunData forwardmPacked;
   PRunData backwardmPacked;
-  Double_t valuep = 0.0;
   Double_t errorp = 0.0;
-  Double_t valuem = 0.0;
   Double_t errorm = 0.0;
 
   // forward
-  for (Int_t i=fGoodBins[0]; i<fGoodBins[1]; i++) {
-    if (fPacking == 1) {
-      forwardpPacked.AppendValue(fForwardp[i]);
-      forwardpPacked.AppendErrorValue(fForwardpErr[i]);
-      forwardmPacked.AppendValue(fForwardm[i]);
-      forwardmPacked.AppendErrorValue(fForwardmErr[i]);
-    } else { // packed data, i.e. fPacking > 1
-      if (((i-fGoodBins[0]) % fPacking == 0) && (i != fGoodBins[0])) { // fill data
-        // in order that after rebinning the fit does not need to be redone (important for plots)
-        // the value is normalize to per bin
-        valuep /= fPacking;
-        valuem /= fPacking;
-        forwardpPacked.AppendValue(valuep);
-        forwardmPacked.AppendValue(valuem);
-        if (valuep == 0.0) {
-	  forwardpPacked.AppendErrorValue(1.0);
-        } else {
-          forwardpPacked.AppendErrorValue(TMath::Sqrt(errorp)/fPacking);
-	}
-	if (valuem == 0.0) {
-	  forwardmPacked.AppendErrorValue(1.0);
-        } else {
-          forwardmPacked.AppendErrorValue(TMath::Sqrt(errorm)/fPacking);
-	}
-        valuep = 0.0;
-        errorp = 0.0;
-        valuem = 0.0;
-        errorm = 0.0;
-      }
-      valuep += fForwardp[i];
-      errorp += fForwardpErr[i]*fForwardpErr[i];
-      valuem += fForwardm[i];
-      errorm += fForwardmErr[i]*fForwardmErr[i];
-    }
-  }
+  PackHisto(fForwardp, fForwardpErr, fForwardpCum, fForwardpErr2Cum, fGoodBins[0], fGoodBins[1], fPacking, forwardpPacked);
+  PackHisto(fForwardm, fForwardmErr, fForwardmCum, fForwardmErr2Cum, fGoodBins[0], fGoodBins[1], fPacking, forwardmPacked);
 
   // backward
-  for (Int_t i=fGoodBins[2]; i<fGoodBins[3]; i++) {
-    if (fPacking == 1) {
-      backwardpPacked.AppendValue(fBackwardp[i]);
-      backwardpPacked.AppendErrorValue(fBackwardpErr[i]);
-      backwardmPacked.AppendValue(fBackwardm[i]);
-      backwardmPacked.AppendErrorValue(fBackwardmErr[i]);
-    } else { // packed data, i.e. fPacking > 1
-      if (((i-fGoodBins[2]) % fPacking == 0) && (i != fGoodBins[2])) { // fill data
-        // in order that after rebinning the fit does not need to be redone (important for plots)
-        // the value is normalize to per bin
-        valuep /= fPacking;
-        valuem /= fPacking;
-        backwardpPacked.AppendValue(valuep);
-        backwardmPacked.AppendValue(valuem);
-        if (valuep == 0.0) {
-          backwardpPacked.AppendErrorValue(1.0);
-	} else {
-          backwardpPacked.AppendErrorValue(TMath::Sqrt(errorp)/fPacking);
-	}
-	if (valuem == 0.0) {
-          backwardmPacked.AppendErrorValue(1.0);
-	} else {
-          backwardmPacked.AppendErrorValue(TMath::Sqrt(errorm)/fPacking);
-	}
-        valuep = 0.0;
-        errorp = 0.0;
-        valuem = 0.0;
-        errorm = 0.0;
-      }
-      valuep += fBackwardp[i];
-      errorp += fBackwardpErr[i]*fBackwardpErr[i];
-      valuem += fBackwardm[i];
-      errorm += fBackwardmErr[i]*fBackwardmErr[i];
-    }
-  }
+  PackHisto(fBackwardp, fBackwardpErr, fBackwardpCum, fBackwardpErr2Cum, fGoodBins[2], fGoodBins[3], fPacking, backwardpPacked);
+  PackHisto(fBackwardm, fBackwardmErr, fBackwardmCum, fBackwardmErr2Cum, fGoodBins[2], fGoodBins[3], fPacking, backwardmPacked);
 
   // check if packed forward and backward hist have the same size, otherwise take the minimum size
   UInt_t noOfBins = forwardpPacked.GetValue()->size();
@@ -1163,6 +1175,14 @@ Bool_t PRunAsymmetryBNMR::PrepareFitData()
   fForwardmErr.clear();
   fBackwardm.clear();
   fBackwardmErr.clear();
+  fForwardpCum.Clear();
+  fForwardpErr2Cum.Clear();
+  fBackwardpCum.Clear();
+  fBackwardpErr2Cum.Clear();
+  fForwardmCum.Clear();
+  fForwardmErr2Cum.Clear();
+  fBackwardmCum.Clear();
+  fBackwardmErr2Cum.Clear();
 
   return true;
 }
@@ -1271,86 +1291,18 @@ Bool_t PRunAsymmetryBNMR::PrepareViewData(PRawRunData* runData, UInt_t histoNo[2
   PRunData backwardpPacked;
   PRunData forwardmPacked;
   PRunData backwardmPacked;
-  Double_t valuep = 0.0;
   Double_t errorp = 0.0;
-  Double_t valuem = 0.0;
   Double_t errorm = 0.0;
   Double_t value = 0.0;
   Double_t error = 0.0;
 
   // forward
-  for (Int_t i=start[0]; i<end[0]; i++) {
-    if (packing == 1) {
-      forwardpPacked.AppendValue(fForwardp[i]);
-      forwardpPacked.AppendErrorValue(fForwardpErr[i]);
-      forwardmPacked.AppendValue(fForwardm[i]);
-      forwardmPacked.AppendErrorValue(fForwardmErr[i]);
-    } else { // packed data, i.e. packing > 1
-      if (((i-start[0]) % packing == 0) && (i != start[0])) { // fill data
-        // in order that after rebinning the fit does not need to be redone (important for plots)
-        // the value is normalize to per bin
-        valuep /= packing;
-        forwardpPacked.AppendValue(valuep);
-        valuem /= packing;
-        forwardmPacked.AppendValue(valuem);
-        if (valuep == 0.0) {
-          forwardpPacked.AppendErrorValue(1.0);
-        } else {
-          forwardpPacked.AppendErrorValue(TMath::Sqrt(errorp)/packing);
-	}
-        if (valuem == 0.0) {
-          forwardmPacked.AppendErrorValue(1.0);
-        } else {
-          forwardmPacked.AppendErrorValue(TMath::Sqrt(errorm)/packing);
-	}
-        valuep = 0.0;
-        errorp = 0.0;
-        valuem = 0.0;
-        errorm = 0.0;
-      }
-      valuep += fForwardp[i];
-      errorp += fForwardpErr[i]*fForwardpErr[i];
-      valuem += fForwardm[i];
-      errorm += fForwardmErr[i]*fForwardmErr[i];
-    }
-  }
+  PackHisto(fForwardp, fForwardpErr, fForwardpCum, fForwardpErr2Cum, start[0], end[0], packing, forwardpPacked);
+  PackHisto(fForwardm, fForwardmErr, fForwardmCum, fForwardmErr2Cum, start[0], end[0], packing, forwardmPacked);
 
   // backward
-  for (Int_t i=start[1]; i<end[1]; i++) {
-    if (packing == 1) {
-      backwardpPacked.AppendValue(fBackwardp[i]);
-      backwardpPacked.AppendErrorValue(fBackwardpErr[i]);
-      backwardmPacked.AppendValue(fBackwardm[i]);
-      backwardmPacked.AppendErrorValue(fBackwardmErr[i]);
-    } else { // packed data, i.e. packing > 1
-      if (((i-start[1]) % packing == 0) && (i != start[1])) { // fill data
-        // in order that after rebinning the fit does not need to be redone (important for plots)
-        // the value is normalize to per bin
-        valuep /= packing;
-        valuem /= packing;
-        backwardpPacked.AppendValue(valuep);
-        backwardmPacked.AppendValue(valuem);
-        if (valuep == 0.0) {
-          backwardpPacked.AppendErrorValue(1.0);
-        } else {
-          backwardpPacked.AppendErrorValue(TMath::Sqrt(errorp)/packing);
-	}
-        if (valuem == 0.0) {
-          backwardmPacked.AppendErrorValue(1.0);
-        } else {
-          backwardmPacked.AppendErrorValue(TMath::Sqrt(errorm)/packing);
-	}
-        valuep = 0.0;
-        errorp = 0.0;
-        valuem = 0.0;
-        errorm = 0.0;
-      }
-      valuep += fBackwardp[i];
-      errorp += fBackwardpErr[i]*fBackwardpErr[i];
-      valuem += fBackwardm[i];
-      errorm += fBackwardmErr[i]*fBackwardmErr[i];
-    }
-  }
+  PackHisto(fBackwardp, fBackwardpErr, fBackwardpCum, fBackwardpErr2Cum, start[1], end[1], packing, backwardpPacked);
+  PackHisto(fBackwardm, fBackwardmErr, fBackwardmCum, fBackwardmErr2Cum, start[1], end[1], packing, backwardmPacked);
 
   // check if packed forward and backward hist have the same size, otherwise take the minimum size
   UInt_t noOfBins = forwardpPacked.GetValue()->size();
@@ -1476,12 +1428,18 @@ Bool_t PRunAsymmetryBNMR::PrepareViewData(PRawRunData* runData, UInt_t histoNo[2
   fForwardmErr.clear();
   fBackwardm.clear();
   fBackwardmErr.clear();
+  fForwardpCum.Clear();
+  fForwardpErr2Cum.Clear();
+  fBackwardpCum.Clear();
+  fBackwardpErr2Cum.Clear();
+  fForwardmCum.Clear();
+  fForwardmErr2Cum.Clear();
+  fBackwardmCum.Clear();
+  fBackwardmErr2Cum.Clear();
 
   // fill theory vector for kView
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate theory
   UInt_t size = runData->GetDataBin(histoNo[0])->size();
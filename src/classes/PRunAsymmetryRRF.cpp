@@ -182,15 +182,100 @@ Double_t PRunAsymmetryRRF::CalcChiSquare(const std::vector<Double_t>& par)
   Double_t a, b, f;
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate chi square
   Double_t time(1.0);
   Int_t i;
 
   // determine alpha/beta
+  GetAlphaBeta(par, a, b);
+
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
+  // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
+  // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
+  // for a given set of parameters---which should be done outside of the parallelized loop.
+  // For all other functions it means a tiny and acceptable overhead.
+  asymFcnValue = fTheory->Func(time, par, fFuncValues);
+
+  #ifdef HAVE_GOMP
+  Int_t chunk = (fEndTimeBin - fStartTimeBin)/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(i,time,diff,asymFcnValue,f) schedule(dynamic,chunk) reduction(+:chisq)
+  #endif
+  for (i=fStartTimeBin; i<fEndTimeBin; ++i) {
+    time = fData.GetDataTimeStart() + static_cast<Double_t>(i)*fData.GetDataTimeStep();
+    f = fTheory->Func(time, par, fFuncValues);
+    asymFcnValue = (f*(a*b+1.0)-(a-1.0))/((a+1.0)-f*(a*b-1.0));
+    diff = fData.GetValue()->at(i) - asymFcnValue;
+    chisq += diff*diff / (fData.GetError()->at(i)*fData.GetError()->at(i));
+  }
+
+  return chisq;
+}
+
+//--------------------------------------------------------------------------
+// CalcResiduals (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculate the normalized residuals (data-theory)/error of all fitted bins, used by the
+ * least-squares fitter (LEAST_SQUARES). The sum of their squares is the chi-square of CalcChiSquare.
+ *
+ * \param par parameter vector iterated by the fitter
+ * \param residuals normalized residuals of the fitted bins
+ */
+void PRunAsymmetryRRF::CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals)
+{
+  Double_t asymFcnValue = 0.0;
+  Double_t a, b, f;
+
+  // calculate functions
+  CalcFuncValues(par);
+
+  Double_t time(1.0);
+  Int_t i;
+
+  // determine alpha/beta
+  GetAlphaBeta(par, a, b);
+
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
+  // Calculate the theory function once to ensure one function evaluation for the current set of parameters,
+  // outside of the parallelized loop (see CalcChiSquare).
+  asymFcnValue = fTheory->Func(time, par, fFuncValues);
+
+  residuals.resize((fEndTimeBin > fStartTimeBin) ? fEndTimeBin-fStartTimeBin : 0);
+
+  #ifdef HAVE_GOMP
+  Int_t chunk = (fEndTimeBin - fStartTimeBin)/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(i,time,asymFcnValue,f) schedule(dynamic,chunk)
+  #endif
+  for (i=fStartTimeBin; i<fEndTimeBin; ++i) {
+    time = fData.GetDataTimeStart() + static_cast<Double_t>(i)*fData.GetDataTimeStep();
+    f = fTheory->Func(time, par, fFuncValues);
+    asymFcnValue = (f*(a*b+1.0)-(a-1.0))/((a+1.0)-f*(a*b-1.0));
+    residuals[i-fStartTimeBin] = (fData.GetValue()->at(i) - asymFcnValue) / fData.GetError()->at(i);
+  }
+}
+
+//--------------------------------------------------------------------------
+// GetAlphaBeta (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Determines alpha and beta for the given parameter set according to fAlphaBetaTag.
+ *
+ * \param par parameter vector iterated by the fitter
+ * \param a alpha
+ * \param b beta
+ */
+void PRunAsymmetryRRF::GetAlphaBeta(const std::vector<Double_t>& par, Double_t &a, Double_t &b)
+{
   switch (fAlphaBetaTag) {
     case 1: // alpha == 1, beta == 1
       a = 1.0;
@@ -241,28 +326,6 @@ Double_t PRunAsymmetryRRF::CalcChiSquare(const std::vector<Double_t>& par)
       b = 1.0;
       break;
   }
-
-  // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
-  // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
-  // for a given set of parameters---which should be done outside of the parallelized loop.
-  // For all other functions it means a tiny and acceptable overhead.
-  asymFcnValue = fTheory->Func(time, par, fFuncValues);
-
-  #ifdef HAVE_GOMP
-  Int_t chunk = (fEndTimeBin - fStartTimeBin)/omp_get_num_procs();
-  if (chunk < 10)
-    chunk = 10;
-  #pragma omp parallel for default(shared) private(i,time,diff,asymFcnValue,f) schedule(dynamic,chunk) reduction(+:chisq)
-  #endif
-  for (i=fStartTimeBin; i<fEndTimeBin; ++i) {
-    time = fData.GetDataTimeStart() + static_cast<Double_t>(i)*fData.GetDataTimeStep();
-    f = fTheory->Func(time, par, fFuncValues);
-    asymFcnValue = (f*(a*b+1.0)-(a-1.0))/((a+1.0)-f*(a*b-1.0));
-    diff = fData.GetValue()->at(i) - asymFcnValue;
-    chisq += diff*diff / (fData.GetError()->at(i)*fData.GetError()->at(i));
-  }
-
-  return chisq;
 }
 
 //--------------------------------------------------------------------------
@@ -438,9 +501,7 @@ void PRunAsymmetryRRF::CalcTheory()
     par.push_back((*paramList)[i].fValue);
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate asymmetry
   Double_t asymFcnValue = 0.0;
@@ -1219,9 +1280,7 @@ Bool_t PRunAsymmetryRRF::PrepareViewData(PRawRunData* runData, UInt_t histoNo[2]
 
   // fill theory vector for kView
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate theory
   UInt_t size = runData->GetDataBin(histoNo[0])->size();
@@ -35,7 +35,9 @@
 #include <TObjArray.h>
 #include <TObjString.h>
 #include <TFolder.h>
+#include <TMath.h>
 
+#include "PPerfMonitor.h"
 #include "PRunBase.h"
 
 //--------------------------------------------------------------------------
@@ -56,8 +58,12 @@ PRunBase::PRunBase()
   fFitStartTime = PMUSR_UNDEFINED;
   fFitEndTime   = PMUSR_UNDEFINED;
 
+  fSharedFuncValues = nullptr;
+
   fValid = true;
   fHandleTag = kEmpty;
+
+  InitPerfKeys();
 }
 
 //--------------------------------------------------------------------------
@@ -75,8 +81,10 @@ PRunBase::PRunBase(PMsrHandler *msrInfo, PRunDataHandler *rawData, UInt_t runNo,
     fHandleTag(tag), fMsrInfo(msrInfo), fRawData(rawData)
 {
   fValid = true;
+  fSharedFuncValues = nullptr;
 
   fRunNo = static_cast<Int_t>(runNo);
+  InitPerfKeys();
   if (runNo > fMsrInfo->GetMsrRunList()->size()) {
     fRunInfo = nullptr;
     return;
@@ -109,6 +117,14 @@ PRunBase::PRunBase(PMsrHandler *msrInfo, PRunDataHandler *rawData, UInt_t runNo,
     exit(0);
   }
 
+  // only the functions used by the theory need to be evaluated
+  PBoolVector used(fFuncValues.size(), false);
+  fTheory->GetUsedFuncs(used);
+  for (UInt_t i=0; i<used.size(); i++) {
+    if (used[i])
+      fRunFuncIdx.push_back(i);
+  }
+
   // set fit time ranges
   fFitStartTime = PMUSR_UNDEFINED;
   fFitEndTime   = PMUSR_UNDEFINED;
@@ -128,6 +144,8 @@ PRunBase::~PRunBase()
   fAddT0s.clear();
 
   fFuncValues.clear();
+  fRunFuncIdx.clear();
+  fSharedFuncIdx.clear();
 }
 
 
@@ -187,6 +205,267 @@ void PRunBase::CleanUp()
   }
 }
 
+//--------------------------------------------------------------------------
+// SetSharedFuncValues (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Sets the run block independent function values. The functions used by the theory which
+ * neither use maps nor meta data will be taken from there rather than being evaluated for this run.
+ *
+ * \param shared run block independent function values
+ */
+void PRunBase::SetSharedFuncValues(PRunSharedFuncValues *shared)
+{
+  fSharedFuncValues = shared;
+  if (shared == nullptr)
+    return;
+
+  std::vector<UInt_t> runFuncIdx;
+  for (UInt_t i=0; i<fRunFuncIdx.size(); i++) {
+    if (shared->IsShared(fRunFuncIdx[i])) {
+      shared->Request(fRunFuncIdx[i]);
+      fSharedFuncIdx.push_back(fRunFuncIdx[i]);
+    } else {
+      runFuncIdx.push_back(fRunFuncIdx[i]);
+    }
+  }
+  fRunFuncIdx = runFuncIdx;
+}
+
+//--------------------------------------------------------------------------
+// SampleTheoryTime (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Samples the time spent in the theory for the performance report. Timing every single theory
+ * call would cost more than the call itself, hence every PERF_THEORY_SAMPLING-th evaluation the theory
+ * is calculated once more (serially) on the time grid of the last evaluation and the time is accounted
+ * for with the number of time bins. Nothing is done if the performance monitor is disabled or the
+ * run type does not set up the time grid (see PrepareTheory).
+ *
+ * \param par fit parameter vector of the last evaluation
+ */
+void PRunBase::SampleTheoryTime(const std::vector<Double_t>& par)
+{
+  if (!PPerfMonitor::IsEnabled() || fTheoryTime.empty())
+    return;
+
+  if (fPerfNoOfEvals++ % PERF_THEORY_SAMPLING != 0)
+    return;
+
+  PPerfTimer timer(fPerfTheoryKey, fTheoryTime.size());
+  for (UInt_t i=0; i<fTheoryTime.size(); i++)
+    fTheory->Func(fTheoryTime[i], par, fFuncValues);
+}
+
+//--------------------------------------------------------------------------
+// ResampleData (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Replaces the data of the fit range by a resampled replica, used for bootstrap error estimates
+ * (BOOTSTRAP command). The replica is generated around the theory of the given (best fit) parameters,
+ * which is obtained from the normalized residuals (see CalcResiduals):
+ * - PRUN_RESAMPLE_MC: counting data (single histogram, mu minus) are drawn from a Poisson distribution,
+ *   and get new errors as in PrepareFitData. All other data are drawn from a Gaussian with the data errors.
+ * - PRUN_RESAMPLE_BINS: residual bootstrap, i.e. the theory plus the normalized residual of a randomly
+ *   drawn fitted bin (with replacement) times the error of the bin. The errors are kept.
+ *
+ * <p>The original data are kept and restored by RestoreData(). A replica is always generated from
+ * the original data.
+ *
+ * \param par parameters of the best fit
+ * \param mode PRUN_RESAMPLE_MC or PRUN_RESAMPLE_BINS
+ * \param rnd random number generator
+ */
+void PRunBase::ResampleData(const std::vector<Double_t>& par, const UInt_t mode, TRandom &rnd)
+{
+  RestoreData();
+
+  fOrigValue = *fData.GetValue();
+  fOrigError = *fData.GetError();
+
+  Int_t start=0, end=0;
+  GetFitBinRange(start, end);
+
+  PDoubleVector residuals;
+  CalcResiduals(par, residuals);
+  if ((end-start != static_cast<Int_t>(residuals.size())) || residuals.empty()) {
+    std::cerr << std::endl << ">> PRunBase::ResampleData(): **ERROR** fit range and residuals of run " << fRunNo << " do not match, data are not resampled." << std::endl;
+    return;
+  }
+
+  // the residuals of counting data are scaled by sqrt(normalizer), see PRunSingleHisto::CalcChiSquare
+  const Double_t normalizer = GetCountsNormalizer();
+  const Double_t scale = (normalizer > 0.0) ? TMath::Sqrt(normalizer) : 1.0;
+
+  PDoubleVector value(fOrigValue), error(fOrigError);
+  Double_t err, theo;
+  for (Int_t i=start; i<end; i++) {
+    err  = fOrigError[i]/scale;
+    theo = fOrigValue[i] - residuals[i-start]*err;
+    if (mode == PRUN_RESAMPLE_BINS) {
+      value[i] = theo + err*residuals[rnd.Integer(residuals.size())];
+    } else if (normalizer > 0.0) { // counting data
+      value[i] = static_cast<Double_t>(rnd.Poisson((theo > 0.0) ? theo*normalizer : 0.0))/normalizer;
+      if (value[i] == 0.0)
+        error[i] = 1.0/normalizer;
+      else
+        error[i] = TMath::Sqrt(value[i]);
+    } else {
+      value[i] = theo + err*rnd.Gaus(0.0, 1.0);
+    }
+  }
+
+  fData.ReplaceData(value, error);
+}
+
+//--------------------------------------------------------------------------
+// RestoreData (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Restores the original data after ResampleData. Nothing is done if the data are not resampled.
+ */
+void PRunBase::RestoreData()
+{
+  if (fOrigValue.empty())
+    return;
+
+  fData.ReplaceData(fOrigValue, fOrigError);
+  fOrigValue.clear();
+  fOrigError.clear();
+}
+
+//--------------------------------------------------------------------------
+// InitPerfKeys (protected)
+//--------------------------------------------------------------------------
+/**
+ * <p>Sets the section names of this run for the performance report, e.g. "run_block_01/functions".
+ */
+void PRunBase::InitPerfKeys()
+{
+  std::string prefix = TString::Format("run_block_%02d", fRunNo+1).Data();
+  fPerfFuncKey    = prefix + "/functions";
+  fPerfPrepareKey = prefix + "/theory_prepare";
+  fPerfTheoryKey  = prefix + "/theory_sampled";
+  fPerfEvalKey    = prefix + "/chisq";
+  fPerfNoOfEvals  = 0;
+}
+
+//--------------------------------------------------------------------------
+// CalcFuncValues (protected)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculates the values of the functions used by the theory for the given parameters.
+ * Run block independent functions are taken from the shared function values (if set),
+ * the others are evaluated with the map and meta data of this run.
+ *
+ * \param par fit parameter vector
+ */
+void PRunBase::CalcFuncValues(const std::vector<Double_t>& par)
+{
+  PPerfTimer timer(fPerfFuncKey);
+
+  if (fSharedFuncValues && !fSharedFuncIdx.empty()) {
+    const PDoubleVector &shared = fSharedFuncValues->GetValues(par);
+    for (UInt_t i=0; i<fSharedFuncIdx.size(); i++)
+      fFuncValues[fSharedFuncIdx[i]] = shared[fSharedFuncIdx[i]];
+  }
+
+  for (UInt_t i=0; i<fRunFuncIdx.size(); i++)
+    fFuncValues[fRunFuncIdx[i]] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(fRunFuncIdx[i]), *fRunInfo->GetMap(), par, fMetaData);
+}
+
+//--------------------------------------------------------------------------
+// PrepareTheory (protected)
+//--------------------------------------------------------------------------
+/**
+ * <p>Hands the times of the data bins [startBin, endBin) to the theory (see PTheory::Prepare), such that
+ * user functions can calculate the whole equidistant time grid in one go before the (parallel) loop
+ * over the bins. Needs to be called after CalcFuncValues.
+ *
+ * \param par fit parameter vector
+ * \param startBin first data bin of the fit range
+ * \param endBin data bin after the last one of the fit range
+ */
+void PRunBase::PrepareTheory(const std::vector<Double_t>& par, const Int_t startBin, const Int_t endBin)
+{
+  if (endBin <= startBin)
+    return;
+
+  PPerfTimer timer(fPerfPrepareKey);
+
+  fTheoryTime.resize(endBin-startBin);
+  for (Int_t i=startBin; i<endBin; i++)
+    fTheoryTime[i-startBin] = fData.GetDataTimeStart() + static_cast<Double_t>(i)*fData.GetDataTimeStep();
+
+  fTheory->Prepare(fTheoryTime, par, fFuncValues);
+}
+
+//--------------------------------------------------------------------------
+// GetNoOfPackedBins (protected)
+//--------------------------------------------------------------------------
+/**
+ * <p>Number of packed bins which are formed from the raw bin interval [start, end).
+ * As for the bin-by-bin accumulation used before, a packed bin is only taken if it is
+ * followed by further data, i.e. the number of bins is (end-start-1)/packing.
+ *
+ * \param start first raw bin
+ * \param end raw bin after the last one
+ * \param packing packing (rebinning) factor
+ */
+UInt_t PRunBase::GetNoOfPackedBins(const Int_t start, const Int_t end, const Int_t packing)
+{
+  if ((end <= start) || (packing < 1))
+    return 0;
+
+  return static_cast<UInt_t>((end-start-1)/packing);
+}
+
+//--------------------------------------------------------------------------
+// PackHisto (protected)
+//--------------------------------------------------------------------------
+/**
+ * <p>Packs the raw bin interval [start, end) of a histogram with errors. The packed
+ * values are normalized per raw bin, the errors are propagated as
+ * \f$ \sqrt{\sum_i \delta n_i^2}/p \f$, where \f$ p \f$ is the packing. The sums
+ * are taken from the cumulative histograms, which the run builds once per histogram,
+ * i.e. they are O(1) per packed bin. For packing == 1 the histogram is copied as is.
+ * A partially filled last packed bin is dropped.
+ *
+ * \param histo histogram
+ * \param histoErr errors of the histogram
+ * \param cumHisto cumulative form of histo
+ * \param cumErr2 cumulative form of the squared errors histoErr
+ * \param start first raw bin
+ * \param end raw bin after the last one
+ * \param packing packing (rebinning) factor
+ * \param packed packed histogram (values and errors are appended)
+ */
+void PRunBase::PackHisto(const PDoubleVector &histo, const PDoubleVector &histoErr, const PCumulativeHisto &cumHisto,
+                         const PCumulativeHisto &cumErr2, const Int_t start, const Int_t end, const Int_t packing,
+                         PRunData &packed)
+{
+  if (packing == 1) {
+    for (Int_t i=start; i<end; i++) {
+      packed.AppendValue(histo[i]);
+      packed.AppendErrorValue(histoErr[i]);
+    }
+    return;
+  }
+
+  Double_t value;
+  UInt_t noOfBins = GetNoOfPackedBins(start, end, packing);
+  for (UInt_t i=0; i<noOfBins; i++) {
+    // in order that after rebinning the fit does not need to be redone (important for plots)
+    // the value is normalize to per bin
+    value = cumHisto.GetPackedBin(start, packing, i) / packing;
+    packed.AppendValue(value);
+    if (value == 0.0)
+      packed.AppendErrorValue(1.0);
+    else
+      packed.AppendErrorValue(TMath::Sqrt(cumErr2.GetPackedBin(start, packing, i))/packing);
+  }
+}
+
 //--------------------------------------------------------------------------
 // CalculateKaiserFilterCoeff (protected)
 //--------------------------------------------------------------------------
@@ -265,3 +544,118 @@ void PRunBase::FilterTheo()
 
   theoFiltered.clear();
 }
+
+//--------------------------------------------------------------------------
+// Constructor
+//--------------------------------------------------------------------------
+/**
+ * <p>Constructor. Finds the functions of the FUNCTIONS block which neither use maps nor meta data.
+ *
+ * \param msrInfo pointer to the msr-file handler
+ */
+PRunSharedFuncValues::PRunSharedFuncValues(PMsrHandler *msrInfo) : fMsrInfo(msrInfo), fEvaluated(false)
+{
+  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++)
+    fShared.push_back(fMsrInfo->IsFuncRunBlockIndependent(i));
+  fValues.resize(fShared.size(), 0.0);
+}
+
+//--------------------------------------------------------------------------
+// Request (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Adds a shared function to the functions which are evaluated in GetValues.
+ *
+ * \param idx function index
+ */
+void PRunSharedFuncValues::Request(const UInt_t idx)
+{
+  if (!IsShared(idx))
+    return;
+
+  for (UInt_t i=0; i<fRequested.size(); i++) {
+    if (fRequested[i] == idx)
+      return;
+  }
+  fRequested.push_back(idx);
+  fEvaluated = false;
+}
+
+//--------------------------------------------------------------------------
+// GetValues (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns the values of the requested shared functions, indexed by the function index.
+ * They are only (re-)evaluated if the parameters differ from the ones of the last call.
+ * Not thread-safe, see the class description.
+ *
+ * \param par fit parameter vector
+ */
+const PDoubleVector& PRunSharedFuncValues::GetValues(const std::vector<Double_t>& par)
+{
+  if (fEvaluated && (par == fPar))
+    return fValues;
+
+  PIntVector noMap;
+  PMetaData noMetaData;
+  noMetaData.fField  = PMUSR_UNDEFINED;
+  noMetaData.fEnergy = PMUSR_UNDEFINED;
+  for (UInt_t i=0; i<fRequested.size(); i++)
+    fValues[fRequested[i]] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(fRequested[i]), noMap, par, noMetaData);
+
+  fPar = par;
+  fEvaluated = true;
+
+  return fValues;
+}
+
+//--------------------------------------------------------------------------
+// Set (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Builds the cumulative representation of a histogram.
+ *
+ * \param histo histogram
+ * \param squared if true, the cumulative sum of the squared bin values is formed (needed for error propagation)
+ */
+void PCumulativeHisto::Set(const PDoubleVector &histo, const Bool_t squared)
+{
+  fCumSum.resize(histo.size()+1);
+
+  long double sum = 0.0;
+  fCumSum[0] = sum;
+  if (squared) {
+    for (UInt_t i=0; i<histo.size(); i++) {
+      sum += static_cast<long double>(histo[i])*histo[i];
+      fCumSum[i+1] = sum;
+    }
+  } else {
+    for (UInt_t i=0; i<histo.size(); i++) {
+      sum += histo[i];
+      fCumSum[i+1] = sum;
+    }
+  }
+}
+
+//--------------------------------------------------------------------------
+// GetSum (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns the sum of the bins [start, end). The interval is clipped to the histogram.
+ *
+ * \param start first bin
+ * \param end bin after the last one
+ */
+Double_t PCumulativeHisto::GetSum(Int_t start, Int_t end) const
+{
+  const Int_t noOfBins = static_cast<Int_t>(GetNoOfBins());
+
+  if (start < 0)
+    start = 0;
+  if (end > noOfBins)
+    end = noOfBins;
+  if (end <= start)
+    return 0.0;
+
+  return static_cast<Double_t>(fCumSum[end]-fCumSum[start]);
+}
@@ -42,6 +42,10 @@
 #include <string>
 #include <sstream>
 
+#ifdef HAVE_GOMP
+#include <omp.h>
+#endif
+
 #include <TROOT.h>
 #include <TSystem.h>
 #include <TString.h>
@@ -61,6 +65,8 @@
 #include "PNeXus.h"
 #endif
 
+#include "PArchiveWriter.h"
+#include "PPerfMonitor.h"
 #include "PRunDataHandler.h"
 
 #define PRH_MUSR_ROOT  0
@@ -266,6 +272,11 @@ PRawRunData* PRunDataHandler::GetRunData(const UInt_t idx)
 /**
  * <p>Read data. Used to read data, either msr-file triggered, or a single
  * explicit data file should be read.
+ *
+ * <p>If the header only flag is set (see SetHeaderOnly()), only the run header
+ * information together with the t0's, and good bin ranges are read, the
+ * histogram data are skipped. This is much faster for large data files and is
+ * sufficient e.g. for msr2data or dump_header.
  */
 void PRunDataHandler::ReadData()
 {
@@ -329,7 +340,9 @@ void PRunDataHandler::ConvertData()
 // SetRunData
 //--------------------------------------------------------------------------
 /**
- * <p>Set a raw run data set.
+ * <p>Set a raw run data set. If idx equals the number of data sets present,
+ * the data set is appended, which allows to feed data which are not read from
+ * file (e.g. synthetic data).
  *
  * @param data pointer to the raw run data set
  * @param idx index to where to write it.
@@ -338,8 +351,8 @@ void PRunDataHandler::ConvertData()
  */
 Bool_t PRunDataHandler::SetRunData(PRawRunData *data, UInt_t idx)
 {
-  if ((idx == 0) && (fData.size() == 0)) {
-    fData.resize(1);
+  if (idx == fData.size()) {
+    fData.resize(idx+1);
   }
   if (idx >= fData.size()) {
     std::cerr << std::endl << ">>PRunDataHandler::SetRunData(): **ERROR** idx=" << idx << " is out-of-range (0.." << fData.size() << ")." << std::endl;
@@ -436,6 +449,7 @@ void PRunDataHandler::Init(const Int_t tag)
   if ((tag==PHR_INIT_ALL) || (tag==PHR_INIT_MSR))
     fAny2ManyInfo = nullptr;
   fAllDataAvailable = false;
+  fHeaderOnly = false;
   if (tag!=PHR_INIT_ALL)
     fFileFormat = TString("");
   fRunName = TString("");
@@ -516,6 +530,11 @@ Bool_t PRunDataHandler::ReadFilesMsr()
       if (FileAlreadyRead(*(runList->at(i).GetRunName(j))))
         continue;
       // everything looks fine, hence try to read the data file
+      std::string perfKey;
+      if (PPerfMonitor::IsActive())
+        perfKey = std::string("data_loading/") + fRunPathName.Data();
+      PPerfTimer perfTimer(perfKey);
+      PPerfMonitor::GetInstance()->AddCount("data_files_read");
       if (!runList->at(i).GetFileFormat(j)->CompareTo("root-npp")) { // not post pile up corrected histos
         success = ReadRootFile();
       } else if (!runList->at(i).GetFileFormat(j)->CompareTo("root-ppc")) { // post pile up corrected histos
@@ -556,7 +575,8 @@ Bool_t PRunDataHandler::ReadFilesMsr()
  * <p> The main read file routine which is filtering what read sub-routine
  * needs to be called. Called when the input is a list of runs. Used with
  * any2many. If the input data file is successfully read, it will write the
- * converted data file.
+ * converted data file. If compression is wished, the converted files are
+ * streamed into a compressed tar archive while the next run is converted.
  *
  * <b>return:</b>
  * - true if reading was successful,
@@ -618,290 +638,188 @@ Bool_t PRunDataHandler::ReadWriteFilesList()
     return false;
   }
 
-  if (fAny2ManyInfo->inFileName.size() != 0) { // file name list given
-
-    // loop over all runs of the run list
-    for (UInt_t i=0; i<fAny2ManyInfo->inFileName.size(); i++) {
-      if (!FileExistsCheck(true, i)) {
-        std::cerr << std::endl << ">> PRunDataHandler::ReadWriteFilesList(): **ERROR** Couldn't find file " << fAny2ManyInfo->inFileName[i].Data() << std::endl;
-        return false;
-      }
-
-      // read input file
-      Bool_t success = false;
-      switch (inTag) {
-      case A2M_ROOT:
-      case A2M_MUSR_ROOT:
-        success = ReadRootFile();
-        break;
-      case A2M_PSIBIN:
-      case A2M_PSIMDU:
-        success = ReadPsiBinFile();
-        break;
-      case A2M_NEXUS:
-        success = ReadNexusFile();
-        break;
-      case A2M_MUD:
-        success = ReadMudFile();
-        break;
-      case A2M_WKM:
-        success = ReadWkmFile();
-        break;
-      default:
-        break;
-      }
-
-      if (!success) {
-        std::cerr << std::endl << ">> PRunDataHandler::ReadWriteFilesList(): **ERROR** Couldn't read file " << fAny2ManyInfo->inFileName[i].Data() << std::endl;
-        return false;
-      }
-
-      // write 'converted' output data file
-      success = false;
-      switch (outTag) {
-      case A2M_ROOT:
-        if (fAny2ManyInfo->outFileName.Length() == 0)
-          success = WriteRootFile();
-        else
-          success = WriteRootFile(fAny2ManyInfo->outFileName);
-        break;
-      case A2M_MUSR_ROOT:
-        if (fAny2ManyInfo->outFileName.Length() == 0)
-          success = WriteMusrRootFile();
-        else
-          success = WriteMusrRootFile(fAny2ManyInfo->outFileName);
-        break;
-      case A2M_PSIBIN:
-        if (fAny2ManyInfo->outFileName.Length() == 0)
-          success = WritePsiBinFile();
-        else
-          success = WritePsiBinFile(fAny2ManyInfo->outFileName);
-        break;
-      case A2M_PSIMDU:
-        if (fAny2ManyInfo->outFileName.Length() == 0)
-          success = WritePsiBinFile();
-        else
-          success = WritePsiBinFile(fAny2ManyInfo->outFileName);
-        break;
-      case A2M_NEXUS:
-        if (fAny2ManyInfo->outFileName.Length() == 0)
-          success = WriteNexusFile();
-        else
-          success = WriteNexusFile(fAny2ManyInfo->outFileName);
-        break;
-      case A2M_MUD:
-        if (fAny2ManyInfo->outFileName.Length() == 0)
-          success = WriteMudFile();
-        else
-          success = WriteMudFile(fAny2ManyInfo->outFileName);
-        break;
-      case A2M_WKM:
-        if (fAny2ManyInfo->outFileName.Length() == 0)
-          success = WriteWkmFile();
-        else
-          success = WriteWkmFile(fAny2ManyInfo->outFileName);
-        break;
-      case A2M_ASCII:
-        if (fAny2ManyInfo->outFileName.Length() == 0)
-          success = WriteAsciiFile();
-        else
-          success = WriteAsciiFile(fAny2ManyInfo->outFileName);
-        break;
-      default:
-        break;
-      }
-
-      if (success == false) {
-        std::cerr << std::endl << ">> PRunDataHandler::ReadWriteFilesList(): **ERROR** Couldn't write converted output file." << std::endl;
-        return false;
-      }
-
-      // throw away the current data set
-      fData.clear();
+  // open the archive if compression is wished. The archive is compressed in-process
+  // and, if requested, directly streamed to stdout.
+  PArchiveWriter archive;
+  TString archiveFln("");
+  if (fAny2ManyInfo->compressionTag > 0) {
+    if (!fAny2ManyInfo->useStandardOutput)
+      archiveFln = fAny2ManyInfo->outPath + fAny2ManyInfo->compressFileName + PArchiveWriter::GetExtension(fAny2ManyInfo->compressionTag);
+    if (!archive.Open(archiveFln, fAny2ManyInfo->compressionTag)) {
+      std::cerr << std::endl << ">> PRunDataHandler::ReadWriteFilesList(): **ERROR** Couldn't open the archive." << std::endl;
+      return false;
     }
   }
 
-  if (fAny2ManyInfo->runList.size() != 0) { // run list given
-
-    // loop over all runs of the run list
-    for (UInt_t i=0; i<fAny2ManyInfo->runList.size(); i++) {
-      if (!FileExistsCheck(false, i)) {
-        std::cerr << std::endl << ">> PRunDataHandler::ReadWriteFilesList(): **ERROR** Couldn't find run " << fAny2ManyInfo->runList[i] << std::endl;
-        return false;
-      }
-
-      // read input file
-      Bool_t success = false;
-      switch (inTag) {
-      case A2M_ROOT:
-      case A2M_MUSR_ROOT:
-        success = ReadRootFile();
-        break;
-      case A2M_PSIBIN:
-      case A2M_PSIMDU:
-        success = ReadPsiBinFile();
-        break;
-      case A2M_NEXUS:
-        success = ReadNexusFile();
-        break;
-      case A2M_MUD:
-        success = ReadMudFile();
-        break;
-      case A2M_WKM:
-        success = ReadWkmFile();
-        break;
-      default:
-        break;
-      }
-
-      if (!success) {
-        std::cerr << std::endl << ">> PRunDataHandler::ReadWriteFilesList(): **ERROR** Couldn't read file " << fRunPathName.Data() << std::endl;
-        return false;
-      }
-
-      TString year("");
-      TDatime dt;
-      year += dt.GetYear();
-      if (fAny2ManyInfo->year.Length() > 0)
-        year = fAny2ManyInfo->year;
-      Bool_t ok;
-      TString fln = FileNameFromTemplate(fAny2ManyInfo->outTemplate, fAny2ManyInfo->runList[i], year, ok);
-      if (!ok) {
-        std::cerr << std::endl << ">> PRunDataHandler::ReadWriteFilesList(): **ERROR** Couldn't create necessary output file name." << std::endl;
-        return false;
-      }
-
-      // write 'converted' output data file
-      success = false;
-      switch (outTag) {
-      case A2M_ROOT:
-        success = WriteRootFile(fln);
-        break;
-      case A2M_MUSR_ROOT:
-        success = WriteMusrRootFile(fln);
-        break;
-      case A2M_PSIBIN:
-        success = WritePsiBinFile(fln);
-        break;
-      case A2M_PSIMDU:
-        success = WritePsiBinFile(fln);
-        break;
-      case A2M_NEXUS:
-        success = WriteNexusFile(fln);
-        break;
-      case A2M_MUD:
-        success = WriteMudFile(fln);
-        break;
-      case A2M_WKM:
-        success = WriteWkmFile(fln);
-        break;
-      case A2M_ASCII:
-        success = WriteAsciiFile(fln);
-        break;
-      default:
-        break;
+  // conversion pipeline: the data file libraries (ROOT, MUD, NeXus, ...) are not thread-safe,
+  // hence the runs are converted one after the other on the master thread. Archiving and
+  // compressing the output of the previous run only deals with plain files and is therefore
+  // done concurrently on a second thread.
+  const UInt_t noOfRuns = fAny2ManyInfo->inFileName.size() + fAny2ManyInfo->runList.size();
+  UInt_t noOfArchived = 0; // number of output files already handed over to the archive
+  Bool_t convertOk = true, archiveOk = true;
+  for (UInt_t i=0; (i<=noOfRuns) && convertOk && archiveOk; i++) {
+    PStringVector toBeArchived;
+    if (archive.IsOpen()) {
+      for (UInt_t j=noOfArchived; j<fAny2ManyInfo->outPathFileName.size(); j++)
+        toBeArchived.push_back(fAny2ManyInfo->outPathFileName[j]);
+      noOfArchived = fAny2ManyInfo->outPathFileName.size();
+    }
+
+    #ifdef HAVE_GOMP
+    #pragma omp parallel num_threads(2) default(shared) if(toBeArchived.size() > 0)
+    #endif
+    {
+      Int_t threadId = 0, noOfThreads = 1;
+      #ifdef HAVE_GOMP
+      threadId = omp_get_thread_num();
+      noOfThreads = omp_get_num_threads();
+      #endif
+
+      // convert the current run
+      if ((threadId == 0) && (i < noOfRuns)) {
+        if (i < fAny2ManyInfo->inFileName.size())
+          convertOk = ReadWriteRun(true, i, inTag, outTag);
+        else
+          convertOk = ReadWriteRun(false, i-fAny2ManyInfo->inFileName.size(), inTag, outTag);
       }
 
-      if (success == false) {
-        std::cerr << std::endl << ">> PRunDataHandler::ReadWriteFilesList(): **ERROR** Couldn't write converted output file." << std::endl;
-        return false;
+      // archive the output of the previous run
+      if ((threadId == 1) || (noOfThreads == 1)) {
+        for (UInt_t j=0; (j<toBeArchived.size()) && archiveOk; j++) {
+          archiveOk = archive.AddFile(toBeArchived[j]);
+          remove(toBeArchived[j].Data());
+        }
       }
-
-      // throw away the current data set
-      fData.clear();
     }
-
   }
 
-  // check if compression is wished
-  if (fAny2ManyInfo->compressionTag > 0) {
-    TString fln = fAny2ManyInfo->outPath + fAny2ManyInfo->compressFileName;
-
-    // currently system call is used, which means this is only running under Linux and Mac OS X but not under Windows
-    char cmd[256];
-    if (fAny2ManyInfo->outPathFileName.size() == 1) {
-      if (fAny2ManyInfo->compressionTag == 1) // gzip
-        fln += TString(".tar.gz");
-      else // bzip2
-        fln += TString(".tar.bz2");
-      if (fAny2ManyInfo->compressionTag == 1) // gzip
-        snprintf(cmd, sizeof(cmd), "tar -zcf %s %s", fln.Data(), fAny2ManyInfo->outPathFileName[0].Data());
-      else // bzip2
-        snprintf(cmd, sizeof(cmd), "tar -jcf %s %s", fln.Data(), fAny2ManyInfo->outPathFileName[0].Data());
-      if (system(cmd) == -1) {
-        std::cerr << "**ERROR** cmd: " << cmd << " failed." << std::endl;
-      }
-    } else {
-      fln += TString(".tar");
-      for (UInt_t i=0; i<fAny2ManyInfo->outPathFileName.size(); i++) {
-        if (i==0) {
-          snprintf(cmd, sizeof(cmd), "tar -cf %s %s", fln.Data(), fAny2ManyInfo->outPathFileName[i].Data());
-        } else {
-          snprintf(cmd, sizeof(cmd), "tar -rf %s %s", fln.Data(), fAny2ManyInfo->outPathFileName[i].Data());
-        }
-        if (system(cmd) == -1) {
-          std::cerr << "**ERROR** cmd: " << cmd << " failed." << std::endl;
-        }
-      }
-      if (fAny2ManyInfo->compressionTag == 1) { // gzip
-        snprintf(cmd, sizeof(cmd), "gzip %s", fln.Data());
-        fln += ".gz";
-      } else {
-        snprintf(cmd, sizeof(cmd), "bzip2 -z %s", fln.Data());
-        fln += ".bz2";
-      }
-      if (system(cmd) == -1) {
-        std::cerr << "**ERROR** cmd: " << cmd << " failed." << std::endl;
-      }
+  if (archive.IsOpen()) {
+    if (!archive.Close())
+      archiveOk = false;
+    if (!archiveOk) {
+      std::cerr << std::endl << ">> PRunDataHandler::ReadWriteFilesList(): **ERROR** Couldn't write the archive." << std::endl;
+      if (archiveFln.Length() > 0)
+        remove(archiveFln.Data());
     }
+    // remove converted files which did not make it into the archive
+    for (UInt_t i=noOfArchived; i<fAny2ManyInfo->outPathFileName.size(); i++)
+      remove(fAny2ManyInfo->outPathFileName[i].Data());
+  }
 
-    // check if the compressed file shall be streamed to the stdout
-    if (fAny2ManyInfo->useStandardOutput) {
-      // stream file to stdout
-      std::ifstream is;
-      int length=1024;
-      char *buffer;
-
-      is.open(fln.Data(), std::ios::binary);
-      if (!is.is_open()) {
-        std::cerr << std::endl << "PRunDataHandler::ReadWriteFilesList(): **ERROR** Couldn't open the file for streaming." << std::endl;
-        remove(fln.Data());
-        return false;
-      }
-
-      // get length of file
-      is.seekg(0, std::ios::end);
-      length = is.tellg();
-      is.seekg(0, std::ios::beg);
-
-      if (length == -1) {
-        std::cerr << std::endl << "PRunDataHandler::ReadWriteFilesList(): **ERROR** Couldn't determine the file size." << std::endl;
-        remove(fln.Data());
-        return false;
-      }
-
-      // allocate memory
-      buffer = new char [length];
+  return (convertOk && archiveOk);
+}
 
-      // read data as a block
-      while (!is.eof()) {
-        is.read(buffer, length);
-        std::cout.write(buffer, length);
-      }
+//--------------------------------------------------------------------------
+// ReadWriteRun (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Reads a single run of the any2many input list and writes the converted
+ * data file. Afterwards the data set is thrown away again.
+ *
+ * <b>return:</b>
+ * - true if reading and writing was successful,
+ * - false otherwise.
+ *
+ * \param fileNameList if true, idx refers to fAny2ManyInfo->inFileName, otherwise to fAny2ManyInfo->runList
+ * \param idx index of the run to be converted
+ * \param inTag input file format tag
+ * \param outTag output file format tag
+ */
+Bool_t PRunDataHandler::ReadWriteRun(const Bool_t fileNameList, const UInt_t idx, const Int_t inTag, const Int_t outTag)
+{
+  if (!FileExistsCheck(fileNameList, idx)) {
+    if (fileNameList)
+      std::cerr << std::endl << ">> PRunDataHandler::ReadWriteRun(): **ERROR** Couldn't find file " << fAny2ManyInfo->inFileName[idx].Data() << std::endl;
+    else
+      std::cerr << std::endl << ">> PRunDataHandler::ReadWriteRun(): **ERROR** Couldn't find run " << fAny2ManyInfo->runList[idx] << std::endl;
+    return false;
+  }
 
-      is.close();
+  // read input file
+  Bool_t success = false;
+  switch (inTag) {
+  case A2M_ROOT:
+  case A2M_MUSR_ROOT:
+    success = ReadRootFile();
+    break;
+  case A2M_PSIBIN:
+  case A2M_PSIMDU:
+    success = ReadPsiBinFile();
+    break;
+  case A2M_NEXUS:
+    success = ReadNexusFile();
+    break;
+  case A2M_MUD:
+    success = ReadMudFile();
+    break;
+  case A2M_WKM:
+    success = ReadWkmFile();
+    break;
+  default:
+    break;
+  }
 
-      delete [] buffer;
+  if (!success) {
+    std::cerr << std::endl << ">> PRunDataHandler::ReadWriteRun(): **ERROR** Couldn't read file " << fRunPathName.Data() << std::endl;
+    return false;
+  }
 
-      // delete temporary root file
-      remove(fln.Data());
+  // get the output file name. An empty name means that the write routines generate it.
+  TString fln("");
+  if (fileNameList) {
+    fln = fAny2ManyInfo->outFileName;
+  } else {
+    TString year("");
+    TDatime dt;
+    year += dt.GetYear();
+    if (fAny2ManyInfo->year.Length() > 0)
+      year = fAny2ManyInfo->year;
+    Bool_t ok;
+    fln = FileNameFromTemplate(fAny2ManyInfo->outTemplate, fAny2ManyInfo->runList[idx], year, ok);
+    if (!ok) {
+      std::cerr << std::endl << ">> PRunDataHandler::ReadWriteRun(): **ERROR** Couldn't create necessary output file name." << std::endl;
+      return false;
     }
+  }
 
-    // remove all the converted files
-    for (UInt_t i=0; i<fAny2ManyInfo->outPathFileName.size(); i++)
-      remove(fAny2ManyInfo->outPathFileName[i].Data());
+  // write 'converted' output data file
+  success = false;
+  switch (outTag) {
+  case A2M_ROOT:
+    success = WriteRootFile(fln);
+    break;
+  case A2M_MUSR_ROOT:
+    success = WriteMusrRootFile(fln);
+    break;
+  case A2M_PSIBIN:
+  case A2M_PSIMDU:
+    success = WritePsiBinFile(fln);
+    break;
+  case A2M_NEXUS:
+    success = WriteNexusFile(fln);
+    break;
+  case A2M_MUD:
+    success = WriteMudFile(fln);
+    break;
+  case A2M_WKM:
+    success = WriteWkmFile(fln);
+    break;
+  case A2M_ASCII:
+    success = WriteAsciiFile(fln);
+    break;
+  default:
+    break;
+  }
+
+  if (success == false) {
+    std::cerr << std::endl << ">> PRunDataHandler::ReadWriteRun(): **ERROR** Couldn't write converted output file." << std::endl;
+    return false;
   }
 
+  // throw away the current data set
+  fData.clear();
+
   return true;
 }
 
@@ -1636,6 +1554,24 @@ Bool_t PRunDataHandler::ReadRootFile()
 
     // read data ---------------------------------------------------------
 
+    if (fHeaderOnly) { // header only: t0's are part of the run header, the histos folder is not touched
+      for (Int_t i=0; i<noOfHistos; i++) {
+        dataSet.Clear();
+        dataSet.SetHistoNo(i+1);
+        dataSet.SetTimeZeroBin(t0[i]);
+        dataSet.SetFirstGoodBin(static_cast<Int_t>(t0[i]));
+        dataSet.SetLastGoodBin(runHeader->GetNChannels()-1); // the histos have GetNChannels() bins
+        runData.SetDataSet(dataSet);
+      }
+      f.Close();
+
+      runData.SetRunName(fRunName);
+      runData.SetHeaderOnly(true);
+      fData.push_back(runData);
+
+      return true;
+    }
+
     // check if histos folder is found
     f.GetObject("histos", folder);
     if (!folder) {
@@ -2029,29 +1965,41 @@ Bool_t PRunDataHandler::ReadRootFile()
 
     // read data ---------------------------------------------------------
 
-    // check if histos folder is found
-    f.GetObject("histos", folder);
-    if (!folder) {
-      std::cerr << std::endl << ">> PRunDataHandler::ReadRootFile: **ERROR** Couldn't obtain histos from " << fRunPathName.Data() << std::endl;
-      f.Close();
-      return false;
+    // check if histos folder is found (header only: t0's, etc. are taken from the DetectorInfo, i.e. the histos are not needed)
+    if (!fHeaderOnly) {
+      f.GetObject("histos", folder);
+      if (!folder) {
+        std::cerr << std::endl << ">> PRunDataHandler::ReadRootFile: **ERROR** Couldn't obtain histos from " << fRunPathName.Data() << std::endl;
+        f.Close();
+        return false;
+      }
     }
 
     // get all the data
     for (UInt_t i=0; i<redGreenOffsets.size(); i++) {
       for (Int_t j=0; j<noOfHistos; j++) {
-        str.Form("hDecay%03d", redGreenOffsets[i]+j+1);
-        TH1F *histo = dynamic_cast<TH1F*>(folder->FindObjectAny(str.Data()));
-        if (!histo) {
-          std::cerr << std::endl << ">> PRunDataHandler::ReadRootFile: **ERROR** Couldn't get histo " << str;
-          std::cerr << std::endl;
-          f.Close();
-          return false;
+        TH1F *histo = nullptr;
+        if (!fHeaderOnly) {
+          str.Form("hDecay%03d", redGreenOffsets[i]+j+1);
+          histo = dynamic_cast<TH1F*>(folder->FindObjectAny(str.Data()));
+          if (!histo) {
+            std::cerr << std::endl << ">> PRunDataHandler::ReadRootFile: **ERROR** Couldn't get histo " << str;
+            std::cerr << std::endl;
+            f.Close();
+            return false;
+          }
         }
 
         dataSet.Clear();
-        dataSet.SetName(histo->GetTitle());
         dataSet.SetHistoNo(redGreenOffsets[i]+j+1);
+        if (fHeaderOnly) {
+          path.Form("DetectorInfo/Detector%03d/Name", redGreenOffsets[i]+j+1);
+          header->Get(path, str, ok);
+          if (ok)
+            dataSet.SetName(str);
+        } else {
+          dataSet.SetName(histo->GetTitle());
+        }
 
         // get detector info
         path.Form("DetectorInfo/Detector%03d/", redGreenOffsets[i]+j+1);
@@ -2067,6 +2015,12 @@ Bool_t PRunDataHandler::ReadRootFile()
         header->Get(pathName, ival, ok);
         if (ok)
           dataSet.SetLastGoodBin(ival);
+
+        if (fHeaderOnly) {
+          runData.SetDataSet(dataSet);
+          continue;
+        }
+
         dataSet.SetTimeZeroBinEstimated(histo->GetMaximumBin());
 
         // fill data
@@ -2093,6 +2047,8 @@ Bool_t PRunDataHandler::ReadRootFile()
   // keep run name
   runData.SetRunName(fRunName);
 
+  runData.SetHeaderOnly(fHeaderOnly);
+
   // add run to the run list
   fData.push_back(runData);
 
@@ -2122,7 +2078,7 @@ Bool_t PRunDataHandler::ReadNexusFile()
   Double_t dval;
   bool ok;
 
-  PNeXus *nxs_file = new PNeXus(fRunPathName.Data());
+  PNeXus *nxs_file = new PNeXus(fRunPathName.Data(), fHeaderOnly);
   if (!nxs_file->IsValid()) {
     std::cerr << std::endl << ">> PRunDataHandler::ReadNexusFile(): Not a valid NeXus file.";
     std::cerr << std::endl << ">> Error Message: " << nxs_file->GetErrorMsg().data() << std::endl;
@@ -2263,6 +2219,8 @@ Bool_t PRunDataHandler::ReadNexusFile()
     // keep run name from the msr-file
     runData.SetRunName(fRunName);
 
+    runData.SetHeaderOnly(fHeaderOnly);
+
     // keep the information
     fData.push_back(runData);
   } else if (nxs_file->GetIdfVersion() == 2) {
@@ -2370,7 +2328,7 @@ Bool_t PRunDataHandler::ReadNexusFile()
     if (nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfPeriods() > 0) { // counts[][][]
       for (int i=0; i<nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfPeriods(); i++) {
         for (int j=0; j<nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfSpectra(); j++) {
-          for (int k=0; k<nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfBins(); k++) {
+          for (int k=0; (histos != nullptr) && (k<nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfBins()); k++) {
             data.push_back(*(histos+i*nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfSpectra()+j*nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfBins()+k));
           }
           dataSet.Clear();
@@ -2399,7 +2357,7 @@ Bool_t PRunDataHandler::ReadNexusFile()
     } else {
       if (nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfSpectra() > 0) { // counts[][]
         for (int i=0; i<nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfSpectra(); i++) {
-          for (int j=0; j<nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfBins(); j++) {
+          for (int j=0; (histos != nullptr) && (j<nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfBins()); j++) {
             data.push_back(*(histos+i*nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfBins()+j));
           }
           dataSet.Clear();
@@ -2425,7 +2383,7 @@ Bool_t PRunDataHandler::ReadNexusFile()
           data.clear();
         }
       } else { // counts[]
-        for (int i=0; i<nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfBins(); i++) {
+        for (int i=0; (histos != nullptr) && (i<nxs_file->GetEntryIdf2()->GetInstrument()->GetDetector()->GetNoOfBins()); i++) {
           data.push_back(*(histos+i));
         }
         dataSet.Clear();
@@ -2449,6 +2407,8 @@ Bool_t PRunDataHandler::ReadNexusFile()
     // keep run name from the msr-file
     runData.SetRunName(fRunName);
 
+    runData.SetHeaderOnly(fHeaderOnly);
+
     // keep the information
     fData.push_back(runData);
   } else {
@@ -2790,7 +2750,7 @@ Bool_t PRunDataHandler::ReadPsiBinFile()
   Bool_t success;
 
   // read psi bin file
-  status = psiBin.Read(fRunPathName.Data());
+  status = psiBin.Read(fRunPathName.Data(), fHeaderOnly);
   switch (status) {
     case 0: // everything perfect
       success = true;
@@ -2981,9 +2941,11 @@ Bool_t PRunDataHandler::ReadPsiBinFile()
   PDoubleVector histoData;
   std::vector<Int_t> histo;
   for (Int_t i=0; i<psiBin.GetNumberHistoInt(); i++) {
-    histo = psiBin.GetHistoArrayInt(i);
-    for (Int_t j=0; j<psiBin.GetHistoLengthBin(); j++) {
-      histoData.push_back(histo[j]);
+    if (!fHeaderOnly) { // header only: no histogram data available
+      histo = psiBin.GetHistoArrayInt(i);
+      for (Int_t j=0; j<psiBin.GetHistoLengthBin(); j++) {
+        histoData.push_back(histo[j]);
+      }
     }
 
     // estimate T0 from maximum of the data
@@ -3013,6 +2975,8 @@ Bool_t PRunDataHandler::ReadPsiBinFile()
     histoData.clear();
   }
 
+  runData.SetHeaderOnly(fHeaderOnly);
+
   // add run to the run list
   fData.push_back(runData);
 
@@ -3039,7 +3003,10 @@ Bool_t PRunDataHandler::ReadMudFile()
 
   PRawRunData runData;
 
-  fh = MUD_openRead((char*)fRunPathName.Data(), &type);
+  if (fHeaderOnly)
+    fh = MUD_openReadHeader((char*)fRunPathName.Data(), &type);
+  else
+    fh = MUD_openRead((char*)fRunPathName.Data(), &type);
   if (fh == -1) {
     std::cerr << std::endl << ">> **ERROR** Couldn't open mud-file " << fRunPathName.Data() << ", sorry.";
     std::cerr << std::endl;
@@ -3301,6 +3268,11 @@ Bool_t PRunDataHandler::ReadMudFile()
     }
     dataSet.SetLastGoodBin(static_cast<Int_t>(val));
 
+    if (fHeaderOnly) { // header only: the histogram data sections have been skipped
+      runData.SetDataSet(dataSet);
+      continue;
+    }
+
     // get number of bins
     success = MUD_getHistNumBins( fh, i, &val );
     if ( !success ) {
@@ -3356,6 +3328,8 @@ Bool_t PRunDataHandler::ReadMudFile()
 
   MUD_closeRead(fh);
 
+  runData.SetHeaderOnly(fHeaderOnly);
+
   // add run to the run list
   fData.push_back(runData);
 
@@ -4694,6 +4668,19 @@ Bool_t PRunDataHandler::WriteMusrRootFile(TString fln)
     runHeader->Write();
   histosFolder->Write();
   fout->Close();
+  delete fout;
+
+  // remove the folders from gROOT again, otherwise writing many files from the same process accumulates all histos
+  gROOT->GetListOfBrowsables()->Remove(histosFolder);
+  while (gROOT->GetListOfBrowsables()->Remove(runHeader) != nullptr) {}
+  gROOT->GetRootFolder()->Remove(histosFolder);
+  gROOT->GetRootFolder()->Remove(runHeader);
+  decayAnaModule->SetOwner(kTRUE);
+  histosFolder->SetOwner(kTRUE);
+  runHeader->SetOwner(kTRUE);
+  delete histosFolder;
+  delete runHeader;
+  delete header;
 
   // check if root file shall be streamed to stdout
   if (fAny2ManyInfo->useStandardOutput && (fAny2ManyInfo->compressionTag == 0)) {
@@ -29,6 +29,7 @@
 
 #include <iostream>
 
+#include "PPerfMonitor.h"
 #include "PRunListCollection.h"
 
 //--------------------------------------------------------------------------
@@ -43,6 +44,7 @@
 PRunListCollection::PRunListCollection(PMsrHandler *msrInfo, PRunDataHandler *data, Bool_t theoAsData) :
   fMsrInfo(msrInfo), fData(data), fTheoAsData(theoAsData)
 {
+  fSharedFuncValues = new PRunSharedFuncValues(fMsrInfo);
 }
 
 //--------------------------------------------------------------------------
@@ -94,6 +96,11 @@ PRunListCollection::~PRunListCollection()
     fRunNonMusrList[i]->~PRunNonMusr();
   }
   fRunNonMusrList.clear();
+
+  if (fSharedFuncValues) {
+    delete fSharedFuncValues;
+    fSharedFuncValues = nullptr;
+  }
 }
 
 //--------------------------------------------------------------------------
@@ -119,41 +126,54 @@ Bool_t PRunListCollection::Add(Int_t runNo, EPMusrHandleTag tag)
     fitType = (*fMsrInfo->GetMsrGlobal()).GetFitType();
   }
 
+  // time the data preparation of the run block
+  std::string perfKey;
+  if (PPerfMonitor::IsActive())
+    perfKey = TString::Format("run_block_%02d/prepare_data", runNo+1).Data();
+  PPerfTimer perfTimer(perfKey);
+
   switch (fitType) {
     case PRUN_SINGLE_HISTO:
       fRunSingleHistoList.push_back(new PRunSingleHisto(fMsrInfo, fData, runNo, tag, fTheoAsData));
       if (!fRunSingleHistoList[fRunSingleHistoList.size()-1]->IsValid())
         success = false;
+      fRunSingleHistoList[fRunSingleHistoList.size()-1]->SetSharedFuncValues(fSharedFuncValues);
       break;
     case PRUN_SINGLE_HISTO_RRF:
       fRunSingleHistoRRFList.push_back(new PRunSingleHistoRRF(fMsrInfo, fData, runNo, tag, fTheoAsData));
       if (!fRunSingleHistoRRFList[fRunSingleHistoRRFList.size()-1]->IsValid())
         success = false;
+      fRunSingleHistoRRFList[fRunSingleHistoRRFList.size()-1]->SetSharedFuncValues(fSharedFuncValues);
       break;
     case PRUN_ASYMMETRY:
       fRunAsymmetryList.push_back(new PRunAsymmetry(fMsrInfo, fData, runNo, tag, fTheoAsData));
       if (!fRunAsymmetryList[fRunAsymmetryList.size()-1]->IsValid())
         success = false;
+      fRunAsymmetryList[fRunAsymmetryList.size()-1]->SetSharedFuncValues(fSharedFuncValues);
       break;
     case PRUN_ASYMMETRY_RRF:
       fRunAsymmetryRRFList.push_back(new PRunAsymmetryRRF(fMsrInfo, fData, runNo, tag, fTheoAsData));
       if (!fRunAsymmetryRRFList[fRunAsymmetryRRFList.size()-1]->IsValid())
         success = false;
+      fRunAsymmetryRRFList[fRunAsymmetryRRFList.size()-1]->SetSharedFuncValues(fSharedFuncValues);
       break;
     case PRUN_ASYMMETRY_BNMR:
       fRunAsymmetryBNMRList.push_back(new PRunAsymmetryBNMR(fMsrInfo, fData, runNo, tag, fTheoAsData));
       if (!fRunAsymmetryBNMRList[fRunAsymmetryBNMRList.size()-1]->IsValid())
         success = false;
+      fRunAsymmetryBNMRList[fRunAsymmetryBNMRList.size()-1]->SetSharedFuncValues(fSharedFuncValues);
       break;
     case PRUN_MU_MINUS:
       fRunMuMinusList.push_back(new PRunMuMinus(fMsrInfo, fData, runNo, tag, fTheoAsData));
       if (!fRunMuMinusList[fRunMuMinusList.size()-1]->IsValid())
         success = false;
+      fRunMuMinusList[fRunMuMinusList.size()-1]->SetSharedFuncValues(fSharedFuncValues);
       break;
     case PRUN_NON_MUSR:
       fRunNonMusrList.push_back(new PRunNonMusr(fMsrInfo, fData, runNo, tag, fTheoAsData));
       if (!fRunNonMusrList[fRunNonMusrList.size()-1]->IsValid())
         success = false;
+      fRunNonMusrList[fRunNonMusrList.size()-1]->SetSharedFuncValues(fSharedFuncValues);
       break;
     default:
       success = false;
@@ -235,6 +255,126 @@ void PRunListCollection::SetFitRange(const PDoublePairVector fitRange)
     fRunNonMusrList[i]->SetFitRange(fitRange);
 }
 
+//--------------------------------------------------------------------------
+// GetFitRange (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns the current fit ranges in time of all runs, such that SetFitRange(GetFitRange())
+ * reproduces them, e.g. on another run list collection of the same msr-file.
+ *
+ * <b>return:</b> vector holding the fit ranges, indexed by the run block index of the msr-file.
+ */
+PDoublePairVector PRunListCollection::GetFitRange() const
+{
+  PDoublePairVector fitRange(fMsrInfo->GetMsrRunList()->size(), PDoublePair(0.0, 0.0));
+
+  for (UInt_t i=0; i<fRunSingleHistoList.size(); i++)
+    fitRange[fRunSingleHistoList[i]->GetRunNo()] = fRunSingleHistoList[i]->GetFitRange();
+  for (UInt_t i=0; i<fRunSingleHistoRRFList.size(); i++)
+    fitRange[fRunSingleHistoRRFList[i]->GetRunNo()] = fRunSingleHistoRRFList[i]->GetFitRange();
+  for (UInt_t i=0; i<fRunAsymmetryList.size(); i++)
+    fitRange[fRunAsymmetryList[i]->GetRunNo()] = fRunAsymmetryList[i]->GetFitRange();
+  for (UInt_t i=0; i<fRunAsymmetryRRFList.size(); i++)
+    fitRange[fRunAsymmetryRRFList[i]->GetRunNo()] = fRunAsymmetryRRFList[i]->GetFitRange();
+  for (UInt_t i=0; i<fRunAsymmetryBNMRList.size(); i++)
+    fitRange[fRunAsymmetryBNMRList[i]->GetRunNo()] = fRunAsymmetryBNMRList[i]->GetFitRange();
+  for (UInt_t i=0; i<fRunMuMinusList.size(); i++)
+    fitRange[fRunMuMinusList[i]->GetRunNo()] = fRunMuMinusList[i]->GetFitRange();
+  for (UInt_t i=0; i<fRunNonMusrList.size(); i++)
+    fitRange[fRunNonMusrList[i]->GetRunNo()] = fRunNonMusrList[i]->GetFitRange();
+
+  return fitRange;
+}
+
+//--------------------------------------------------------------------------
+// ResampleData (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Replaces the fitted data of <em>all</em> runs by a resampled replica (see PRunBase::ResampleData).
+ *
+ * \param par parameters of the best fit
+ * \param mode PRUN_RESAMPLE_MC or PRUN_RESAMPLE_BINS
+ * \param rnd random number generator
+ */
+void PRunListCollection::ResampleData(const std::vector<Double_t>& par, const UInt_t mode, TRandom &rnd)
+{
+  for (UInt_t i=0; i<fRunSingleHistoList.size(); i++)
+    fRunSingleHistoList[i]->ResampleData(par, mode, rnd);
+  for (UInt_t i=0; i<fRunSingleHistoRRFList.size(); i++)
+    fRunSingleHistoRRFList[i]->ResampleData(par, mode, rnd);
+  for (UInt_t i=0; i<fRunAsymmetryList.size(); i++)
+    fRunAsymmetryList[i]->ResampleData(par, mode, rnd);
+  for (UInt_t i=0; i<fRunAsymmetryRRFList.size(); i++)
+    fRunAsymmetryRRFList[i]->ResampleData(par, mode, rnd);
+  for (UInt_t i=0; i<fRunAsymmetryBNMRList.size(); i++)
+    fRunAsymmetryBNMRList[i]->ResampleData(par, mode, rnd);
+  for (UInt_t i=0; i<fRunMuMinusList.size(); i++)
+    fRunMuMinusList[i]->ResampleData(par, mode, rnd);
+  for (UInt_t i=0; i<fRunNonMusrList.size(); i++)
+    fRunNonMusrList[i]->ResampleData(par, mode, rnd);
+}
+
+//--------------------------------------------------------------------------
+// RestoreData (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Restores the original data of <em>all</em> runs after ResampleData.
+ */
+void PRunListCollection::RestoreData()
+{
+  for (UInt_t i=0; i<fRunSingleHistoList.size(); i++)
+    fRunSingleHistoList[i]->RestoreData();
+  for (UInt_t i=0; i<fRunSingleHistoRRFList.size(); i++)
+    fRunSingleHistoRRFList[i]->RestoreData();
+  for (UInt_t i=0; i<fRunAsymmetryList.size(); i++)
+    fRunAsymmetryList[i]->RestoreData();
+  for (UInt_t i=0; i<fRunAsymmetryRRFList.size(); i++)
+    fRunAsymmetryRRFList[i]->RestoreData();
+  for (UInt_t i=0; i<fRunAsymmetryBNMRList.size(); i++)
+    fRunAsymmetryBNMRList[i]->RestoreData();
+  for (UInt_t i=0; i<fRunMuMinusList.size(); i++)
+    fRunMuMinusList[i]->RestoreData();
+  for (UInt_t i=0; i<fRunNonMusrList.size(); i++)
+    fRunNonMusrList[i]->RestoreData();
+}
+
+//--------------------------------------------------------------------------
+// IsTheoryReentrant (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Checks if the theories of <em>all</em> runs can be evaluated concurrently to the ones of
+ * another run list collection, i.e. if all their user functions are reentrant (see
+ * PUserFcnBase::IsReentrant).
+ *
+ * <b>return:</b> true if all theories are reentrant, false otherwise
+ */
+Bool_t PRunListCollection::IsTheoryReentrant() const
+{
+  for (UInt_t i=0; i<fRunSingleHistoList.size(); i++)
+    if (!fRunSingleHistoList[i]->IsTheoryReentrant())
+      return false;
+  for (UInt_t i=0; i<fRunSingleHistoRRFList.size(); i++)
+    if (!fRunSingleHistoRRFList[i]->IsTheoryReentrant())
+      return false;
+  for (UInt_t i=0; i<fRunAsymmetryList.size(); i++)
+    if (!fRunAsymmetryList[i]->IsTheoryReentrant())
+      return false;
+  for (UInt_t i=0; i<fRunAsymmetryRRFList.size(); i++)
+    if (!fRunAsymmetryRRFList[i]->IsTheoryReentrant())
+      return false;
+  for (UInt_t i=0; i<fRunAsymmetryBNMRList.size(); i++)
+    if (!fRunAsymmetryBNMRList[i]->IsTheoryReentrant())
+      return false;
+  for (UInt_t i=0; i<fRunMuMinusList.size(); i++)
+    if (!fRunMuMinusList[i]->IsTheoryReentrant())
+      return false;
+  for (UInt_t i=0; i<fRunNonMusrList.size(); i++)
+    if (!fRunNonMusrList[i]->IsTheoryReentrant())
+      return false;
+
+  return true;
+}
+
 //--------------------------------------------------------------------------
 // GetSingleHistoChisq (public)
 //--------------------------------------------------------------------------
@@ -251,7 +391,7 @@ Double_t PRunListCollection::GetSingleHistoChisq(const std::vector<Double_t>& pa
   Double_t chisq = 0.0;
 
   for (UInt_t i=0; i<fRunSingleHistoList.size(); i++)
-    chisq += fRunSingleHistoList[i]->CalcChiSquare(par);
+    chisq += EvalRun(fRunSingleHistoList[i], par, true);
 
   return chisq;
 }
@@ -272,7 +412,7 @@ Double_t PRunListCollection::GetSingleHistoRRFChisq(const std::vector<Double_t>&
   Double_t chisq = 0.0;
 
   for (UInt_t i=0; i<fRunSingleHistoRRFList.size(); i++)
-    chisq += fRunSingleHistoRRFList[i]->CalcChiSquare(par);
+    chisq += EvalRun(fRunSingleHistoRRFList[i], par, true);
 
   return chisq;
 }
@@ -293,7 +433,7 @@ Double_t PRunListCollection::GetAsymmetryChisq(const std::vector<Double_t>& par)
   Double_t chisq = 0.0;
 
   for (UInt_t i=0; i<fRunAsymmetryList.size(); i++)
-    chisq += fRunAsymmetryList[i]->CalcChiSquare(par);
+    chisq += EvalRun(fRunAsymmetryList[i], par, true);
 
   return chisq;
 }
@@ -314,7 +454,7 @@ Double_t PRunListCollection::GetAsymmetryRRFChisq(const std::vector<Double_t>& p
   Double_t chisq = 0.0;
 
   for (UInt_t i=0; i<fRunAsymmetryRRFList.size(); i++)
-    chisq += fRunAsymmetryRRFList[i]->CalcChiSquare(par);
+    chisq += EvalRun(fRunAsymmetryRRFList[i], par, true);
 
   return chisq;
 }
@@ -335,7 +475,7 @@ Double_t PRunListCollection::GetAsymmetryBNMRChisq(const std::vector<Double_t>&
   Double_t chisq = 0.0;
 
   for (UInt_t i=0; i<fRunAsymmetryBNMRList.size(); i++)
-    chisq += fRunAsymmetryBNMRList[i]->CalcChiSquare(par);
+    chisq += EvalRun(fRunAsymmetryBNMRList[i], par, true);
 
   return chisq;
 }
@@ -356,7 +496,7 @@ Double_t PRunListCollection::GetMuMinusChisq(const std::vector<Double_t>& par) c
   Double_t chisq = 0.0;
 
   for (UInt_t i=0; i<fRunMuMinusList.size(); i++)
-    chisq += fRunMuMinusList[i]->CalcChiSquare(par);
+    chisq += EvalRun(fRunMuMinusList[i], par, true);
 
   return chisq;
 }
@@ -377,7 +517,7 @@ Double_t PRunListCollection::GetNonMusrChisq(const std::vector<Double_t>& par) c
   Double_t chisq = 0.0;
 
   for (UInt_t i=0; i<fRunNonMusrList.size(); i++)
-    chisq += fRunNonMusrList[i]->CalcChiSquare(par);
+    chisq += EvalRun(fRunNonMusrList[i], par, true);
 
   return chisq;
 }
@@ -511,6 +651,67 @@ Double_t PRunListCollection::GetSingleRunChisq(const std::vector<Double_t>& par,
   return chisq;
 }
 
+//--------------------------------------------------------------------------
+// GetSingleRunResiduals (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculates the normalized residuals (data-theory)/error of all fitted bins of a single
+ * run-block entry of the msr-file. The sum of their squares is GetSingleRunChisq.
+ *
+ * \param par fit parameter vector
+ * \param idx run block index
+ * \param residuals normalized residuals of the run-block entry with index idx
+ */
+void PRunListCollection::GetSingleRunResiduals(const std::vector<Double_t>& par, const UInt_t idx, PDoubleVector& residuals) const
+{
+  residuals.clear();
+
+  if (idx >= fMsrInfo->GetMsrRunList()->size()) {
+    std::cerr << ">> PRunListCollection::GetSingleRunResiduals() **ERROR** idx=" << idx << " is out of range [0.." << fMsrInfo->GetMsrRunList()->size() << "[" << std::endl << std::endl;
+    return;
+  }
+
+  Int_t subIdx = 0;
+  Int_t type = fMsrInfo->GetMsrRunList()->at(idx).GetFitType();
+  if (type == -1) { // i.e. not found in the RUN block, try the GLOBAL block
+    type = fMsrInfo->GetMsrGlobal()->GetFitType();
+    subIdx = idx;
+  } else { // found in the RUN block
+    // count how many entries of this fit-type are present up to idx
+    for (UInt_t i=0; i<idx; i++) {
+      if (fMsrInfo->GetMsrRunList()->at(i).GetFitType() == type)
+        subIdx++;
+    }
+  }
+
+  // get the residuals of the single run
+  switch (type) {
+  case PRUN_SINGLE_HISTO:
+    fRunSingleHistoList[subIdx]->CalcResiduals(par, residuals);
+    break;
+  case PRUN_SINGLE_HISTO_RRF:
+    fRunSingleHistoRRFList[subIdx]->CalcResiduals(par, residuals);
+    break;
+  case PRUN_ASYMMETRY:
+    fRunAsymmetryList[subIdx]->CalcResiduals(par, residuals);
+    break;
+  case PRUN_ASYMMETRY_RRF:
+    fRunAsymmetryRRFList[subIdx]->CalcResiduals(par, residuals);
+    break;
+  case PRUN_ASYMMETRY_BNMR:
+    fRunAsymmetryBNMRList[subIdx]->CalcResiduals(par, residuals);
+    break;
+  case PRUN_MU_MINUS:
+    fRunMuMinusList[subIdx]->CalcResiduals(par, residuals);
+    break;
+  case PRUN_NON_MUSR:
+    fRunNonMusrList[subIdx]->CalcResiduals(par, residuals);
+    break;
+  default:
+    break;
+  }
+}
+
 //--------------------------------------------------------------------------
 // GetSingleHistoMaximumLikelihood (public)
 //--------------------------------------------------------------------------
@@ -527,7 +728,7 @@ Double_t PRunListCollection::GetSingleHistoMaximumLikelihood(const std::vector<D
   Double_t mlh = 0.0;
 
   for (UInt_t i=0; i<fRunSingleHistoList.size(); i++)
-    mlh += fRunSingleHistoList[i]->CalcMaxLikelihood(par);
+    mlh += EvalRun(fRunSingleHistoList[i], par, false);
 
   return mlh;
 }
@@ -548,7 +749,7 @@ Double_t PRunListCollection::GetSingleHistoRRFMaximumLikelihood(const std::vecto
   Double_t mlh = 0.0;
 
   for (UInt_t i=0; i<fRunSingleHistoRRFList.size(); i++)
-    mlh += fRunSingleHistoRRFList[i]->CalcMaxLikelihood(par);
+    mlh += EvalRun(fRunSingleHistoRRFList[i], par, false);
 
   return mlh;
 }
@@ -570,7 +771,7 @@ Double_t PRunListCollection::GetAsymmetryMaximumLikelihood(const std::vector<Dou
   Double_t mlh = 0.0;
 
   for (UInt_t i=0; i<fRunAsymmetryList.size(); i++)
-    mlh += fRunAsymmetryList[i]->CalcChiSquare(par);
+    mlh += EvalRun(fRunAsymmetryList[i], par, true);
 
   return mlh;
 }
@@ -592,7 +793,7 @@ Double_t PRunListCollection::GetAsymmetryRRFMaximumLikelihood(const std::vector<
   Double_t mlh = 0.0;
 
   for (UInt_t i=0; i<fRunAsymmetryRRFList.size(); i++)
-    mlh += fRunAsymmetryRRFList[i]->CalcChiSquare(par);
+    mlh += EvalRun(fRunAsymmetryRRFList[i], par, true);
 
   return mlh;
 }
@@ -614,7 +815,7 @@ Double_t PRunListCollection::GetAsymmetryBNMRMaximumLikelihood(const std::vector
   Double_t mlh = 0.0;
 
   for (UInt_t i=0; i<fRunAsymmetryBNMRList.size(); i++)
-    mlh += fRunAsymmetryBNMRList[i]->CalcChiSquare(par);
+    mlh += EvalRun(fRunAsymmetryBNMRList[i], par, true);
 
   return mlh;
 }
@@ -635,7 +836,7 @@ Double_t PRunListCollection::GetMuMinusMaximumLikelihood(const std::vector<Doubl
   Double_t mlh = 0.0;
 
   for (UInt_t i=0; i<fRunMuMinusList.size(); i++)
-    mlh += fRunMuMinusList[i]->CalcMaxLikelihood(par);
+    mlh += EvalRun(fRunMuMinusList[i], par, false);
 
   return mlh;
 }
@@ -657,7 +858,7 @@ Double_t PRunListCollection::GetNonMusrMaximumLikelihood(const std::vector<Doubl
   Double_t mlh = 0.0;
 
   for (UInt_t i=0; i<fRunNonMusrList.size(); i++)
-    mlh += fRunNonMusrList[i]->CalcChiSquare(par);
+    mlh += EvalRun(fRunNonMusrList[i], par, true);
 
   return mlh;
 }
@@ -754,6 +955,36 @@ Double_t PRunListCollection::GetSingleRunMaximumLikelihood(const std::vector<Dou
   return mlh;
 }
 
+//--------------------------------------------------------------------------
+// EvalRun (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculates chi-square or maximum log likelihood of a single run. If the performance monitor
+ * is active, the evaluation is timed per run block and, for the report, the theory time is sampled
+ * (see PRunBase::SampleTheoryTime).
+ *
+ * <b>return:</b>
+ * - chi-square or maximum log likelihood of the run
+ *
+ * \param run run to be evaluated
+ * \param par fit parameter vector
+ * \param chisq if true chi-square is calculated, otherwise the maximum log likelihood
+ */
+Double_t PRunListCollection::EvalRun(PRunBase *run, const std::vector<Double_t>& par, const Bool_t chisq) const
+{
+  if (!PPerfMonitor::IsActive())
+    return chisq ? run->CalcChiSquare(par) : run->CalcMaxLikelihood(par);
+
+  Double_t result;
+  {
+    PPerfTimer timer(run->GetPerfEvalKey());
+    result = chisq ? run->CalcChiSquare(par) : run->CalcMaxLikelihood(par);
+  }
+  run->SampleTheoryTime(par);
+
+  return result;
+}
+
 //--------------------------------------------------------------------------
 // GetNoOfBinsFitted (public)
 //--------------------------------------------------------------------------
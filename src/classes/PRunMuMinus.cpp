@@ -138,15 +138,15 @@ Double_t PRunMuMinus::CalcChiSquare(const std::vector<Double_t>& par)
   Double_t diff = 0.0;
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    Int_t funcNo = fMsrInfo->GetFuncNo(i);
-    fFuncValues[i] = fMsrInfo->EvalFunc(funcNo, *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate chi square
   Double_t time(1.0);
   Int_t i;
 
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
   // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
   // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
   // for a given set of parameters---which should be done outside of the parallelized loop.
@@ -168,6 +168,45 @@ Double_t PRunMuMinus::CalcChiSquare(const std::vector<Double_t>& par)
   return chisq;
 }
 
+//--------------------------------------------------------------------------
+// CalcResiduals (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculate the normalized residuals (data-theory)/error of all fitted bins, used by the
+ * least-squares fitter (LEAST_SQUARES). The sum of their squares is the chi-square of CalcChiSquare.
+ *
+ * \param par parameter vector iterated by the fitter
+ * \param residuals normalized residuals of the fitted bins
+ */
+void PRunMuMinus::CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals)
+{
+  // calculate functions
+  CalcFuncValues(par);
+
+  Double_t time(1.0);
+  Int_t i;
+
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
+  // Calculate the theory function once to ensure one function evaluation for the current set of parameters,
+  // outside of the parallelized loop (see CalcChiSquare).
+  time = fTheory->Func(time, par, fFuncValues);
+
+  residuals.resize((fEndTimeBin > fStartTimeBin) ? fEndTimeBin-fStartTimeBin : 0);
+
+  #ifdef HAVE_GOMP
+  Int_t chunk = (fEndTimeBin - fStartTimeBin)/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(i,time) schedule(dynamic,chunk)
+  #endif
+  for (i=fStartTimeBin; i<fEndTimeBin; ++i) {
+    time = fData.GetDataTimeStart() + static_cast<Double_t>(i)*fData.GetDataTimeStep();
+    residuals[i-fStartTimeBin] = (fData.GetValue()->at(i) - fTheory->Func(time, par, fFuncValues)) / fData.GetError()->at(i);
+  }
+}
+
 //--------------------------------------------------------------------------
 // CalcChiSquareExpected (public)
 //--------------------------------------------------------------------------
@@ -186,15 +225,15 @@ Double_t PRunMuMinus::CalcChiSquareExpected(const std::vector<Double_t>& par)
   Double_t theo  = 0.0;
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    Int_t funcNo = fMsrInfo->GetFuncNo(i);
-    fFuncValues[i] = fMsrInfo->EvalFunc(funcNo, *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate chi square
   Double_t time(1.0);
   Int_t i;
 
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
   // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
   // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
   // for a given set of parameters---which should be done outside of the parallelized loop.
@@ -233,10 +272,7 @@ Double_t PRunMuMinus::CalcMaxLikelihood(const std::vector<Double_t>& par)
   Double_t mllh = 0.0; // maximum log likelihood assuming poisson distribution for the single bin
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    Int_t funcNo = fMsrInfo->GetFuncNo(i);
-    fFuncValues[i] = fMsrInfo->EvalFunc(funcNo, *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate maximum log likelihood
   Double_t theo;
@@ -244,6 +280,9 @@ Double_t PRunMuMinus::CalcMaxLikelihood(const std::vector<Double_t>& par)
   Double_t time(1.0);
   Int_t i;
 
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
   // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
   // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
   // for a given set of parameters---which should be done outside of the parallelized loop.
@@ -420,9 +459,7 @@ void PRunMuMinus::CalcTheory()
     par.push_back((*paramList)[i].fValue);
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate theory
   UInt_t size = fData.GetValue()->size();
@@ -559,6 +596,9 @@ Bool_t PRunMuMinus::PrepareData()
     }
   }
 
+  // cumulative form of the grouped forward histo, used for packing
+  fForwardCum.Set(fForward);
+
   // get the data range (fgb/lgb) for the current RUN block
   if (!GetProperDataRange()) {
     return false;
@@ -610,26 +650,20 @@ Bool_t PRunMuMinus::PrepareFitData(PRawRunData* runData, const UInt_t histoNo)
   // data start time = (binStart - 0.5) + pack/2 - t0, with pack and binStart used as double
   fData.SetDataTimeStart(fTimeResolution*((static_cast<Double_t>(fGoodBins[0])-0.5) + static_cast<Double_t>(fPacking)/2.0 - static_cast<Double_t>(t0)));
   fData.SetDataTimeStep(fTimeResolution*fPacking);
-  for (Int_t i=fGoodBins[0]; i<fGoodBins[1]; i++) {
-    if (fPacking == 1) {
-      value = fForward[i];
-      fData.AppendValue(value);
-      if (value == 0.0)
-        fData.AppendErrorValue(1.0);
-      else
-        fData.AppendErrorValue(TMath::Sqrt(value));
-    } else { // packed data, i.e. fPacking > 1
-      if (((i-fGoodBins[0]) % fPacking == 0) && (i != fGoodBins[0])) { // fill data
-        fData.AppendValue(value);
-        if (value == 0.0)
-          fData.AppendErrorValue(1.0);
-        else
-          fData.AppendErrorValue(TMath::Sqrt(value));
-        // reset values
-        value = 0.0;
-      }
-      value += fForward[i];
-    }
+  // packed bins are taken from the cumulative histogram, i.e. O(1) per packed bin
+  UInt_t noOfBins = GetNoOfPackedBins(fGoodBins[0], fGoodBins[1], fPacking);
+  if ((fPacking == 1) && (fGoodBins[1] > fGoodBins[0])) // unpacked: all bins of the fit range are taken
+    noOfBins = fGoodBins[1]-fGoodBins[0];
+  for (UInt_t i=0; i<noOfBins; i++) {
+    if (fPacking == 1)
+      value = fForward[fGoodBins[0]+i];
+    else // packed data, i.e. fPacking > 1
+      value = fForwardCum.GetPackedBin(fGoodBins[0], fPacking, i);
+    fData.AppendValue(value);
+    if (value == 0.0)
+      fData.AppendErrorValue(1.0);
+    else
+      fData.AppendErrorValue(TMath::Sqrt(value));
   }
 
   CalcNoOfFitBins();
@@ -717,17 +751,14 @@ Bool_t PRunMuMinus::PrepareRawViewData(PRawRunData* runData, const UInt_t histoN
   fData.SetDataTimeStart(fTimeResolution*((static_cast<Double_t>(start)-0.5) + static_cast<Double_t>(packing)/2.0 - static_cast<Double_t>(t0)));
   fData.SetDataTimeStep(fTimeResolution*packing);
 
-  for (Int_t i=start; i<end; i++) {
-    if (((i-start) % packing == 0) && (i != start)) { // fill data
-      fData.AppendValue(value);
-      if (value == 0.0)
-        fData.AppendErrorValue(1.0);
-      else
-        fData.AppendErrorValue(TMath::Sqrt(value));
-      // reset values
-      value = 0.0;
-    }
-    value += fForward[i];
+  UInt_t noOfBins = GetNoOfPackedBins(start, end, packing);
+  for (UInt_t i=0; i<noOfBins; i++) {
+    value = fForwardCum.GetPackedBin(start, packing, i);
+    fData.AppendValue(value);
+    if (value == 0.0)
+      fData.AppendErrorValue(1.0);
+    else
+      fData.AppendErrorValue(TMath::Sqrt(value));
   }
 
   CalcNoOfFitBins();
@@ -740,9 +771,7 @@ Bool_t PRunMuMinus::PrepareRawViewData(PRawRunData* runData, const UInt_t histoN
     par.push_back((*paramList)[i].fValue);
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate theory
   UInt_t size = fForward.size();
@@ -29,6 +29,7 @@
 
 #include <iostream>
 
+#include "PPerfMonitor.h"
 #include "PRunNonMusr.h"
 
 //--------------------------------------------------------------------------
@@ -103,9 +104,14 @@ Double_t PRunNonMusr::CalcChiSquare(const std::vector<Double_t>& par)
   Double_t diff = 0.0;
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
+
+  // let user functions calculate all x-values of the data set in one go
+  fTheory->Prepare(*fData.GetX(), par, fFuncValues);
+
+  // x-values of the fit range, needed for the theory time sampling of the performance report (see PRunBase::SampleTheoryTime)
+  if (PPerfMonitor::IsEnabled() && (fEndTimeBin >= fStartTimeBin))
+    fTheoryTime.assign(fData.GetX()->begin()+fStartTimeBin, fData.GetX()->begin()+fEndTimeBin+1);
 
   // calculate chi square
   Double_t x(1.0);
@@ -118,6 +124,33 @@ Double_t PRunNonMusr::CalcChiSquare(const std::vector<Double_t>& par)
   return chisq;
 }
 
+//--------------------------------------------------------------------------
+// CalcResiduals (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculate the normalized residuals (data-theory)/error of all fitted bins, used by the
+ * least-squares fitter (LEAST_SQUARES). The sum of their squares is the chi-square of CalcChiSquare.
+ *
+ * \param par parameter vector iterated by the fitter
+ * \param residuals normalized residuals of the fitted bins
+ */
+void PRunNonMusr::CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals)
+{
+  // calculate functions
+  CalcFuncValues(par);
+
+  // let user functions calculate all x-values of the data set in one go
+  fTheory->Prepare(*fData.GetX(), par, fFuncValues);
+
+  residuals.resize((fEndTimeBin >= fStartTimeBin) ? fEndTimeBin-fStartTimeBin+1 : 0);
+
+  Double_t x(1.0);
+  for (UInt_t i=fStartTimeBin; i<=fEndTimeBin; i++) {
+    x = fData.GetX()->at(i);
+    residuals[i-fStartTimeBin] = (fData.GetValue()->at(i) - fTheory->Func(x, par, fFuncValues)) / fData.GetError()->at(i);
+  }
+}
+
 //--------------------------------------------------------------------------
 // CalcChiSquareExpected (public)
 //--------------------------------------------------------------------------
@@ -348,9 +381,7 @@ Bool_t PRunNonMusr::PrepareViewData()
   for (UInt_t i=0; i<paramList->size(); i++)
     par.push_back((*paramList)[i].fValue);
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // get plot range
   PMsrPlotList *plotList;
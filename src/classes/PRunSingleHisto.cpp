@@ -142,47 +142,20 @@ Double_t PRunSingleHisto::CalcChiSquare(const std::vector<Double_t>& par)
   Double_t chisq     = 0.0;
   Double_t diff      = 0.0;
 
-  Double_t N0 = 0.0;
-
-  // check if norm is a parameter or a function
-  if (fRunInfo->GetNormParamNo() < MSR_PARAM_FUN_OFFSET) { // norm is a parameter
-    N0 = par[fRunInfo->GetNormParamNo()-1];
-  } else { // norm is a function
-    // get function number
-    UInt_t funNo = fRunInfo->GetNormParamNo()-MSR_PARAM_FUN_OFFSET;
-    // evaluate function
-    N0 = fMsrInfo->EvalFunc(funNo, *fRunInfo->GetMap(), par, fMetaData);
-  }
-
-  // get tau
-  Double_t tau;
-  if (fRunInfo->GetLifetimeParamNo() != -1)
-    tau = par[fRunInfo->GetLifetimeParamNo()-1];
-  else
-    tau = PMUON_LIFETIME;
-
-  // get background
-  Double_t bkg;
-  if (fRunInfo->GetBkgFitParamNo() == -1) { // bkg not fitted
-    if (fRunInfo->GetBkgFix(0) == PMUSR_UNDEFINED) { // no fixed background given (background interval)
-      bkg = fBackground;
-    } else { // fixed bkg given
-      bkg = fRunInfo->GetBkgFix(0);
-    }
-  } else { // bkg fitted
-    bkg = par[fRunInfo->GetBkgFitParamNo()-1];
-  }
+  // get N0, tau, and background
+  Double_t N0, tau, bkg;
+  GetN0TauBkg(par, N0, tau, bkg);
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    UInt_t funcNo = fMsrInfo->GetFuncNo(i);
-    fFuncValues[i] = fMsrInfo->EvalFunc(funcNo, *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate chi square
   Double_t time(1.0);
   Int_t i;
 
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
   // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
   // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
   // for a given set of parameters---which should be done outside of the parallelized loop.
@@ -210,6 +183,55 @@ Double_t PRunSingleHisto::CalcChiSquare(const std::vector<Double_t>& par)
   return chisq;
 }
 
+//--------------------------------------------------------------------------
+// CalcResiduals (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculate the normalized residuals (data-theory)/error of all fitted bins, used by the
+ * least-squares fitter (LEAST_SQUARES). The sum of their squares is the chi-square of CalcChiSquare.
+ *
+ * \param par parameter vector iterated by the fitter
+ * \param residuals normalized residuals of the fitted bins
+ */
+void PRunSingleHisto::CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals)
+{
+  // get N0, tau, and background
+  Double_t N0, tau, bkg;
+  GetN0TauBkg(par, N0, tau, bkg);
+
+  // calculate functions
+  CalcFuncValues(par);
+
+  // the correction factor of the chi-square (see CalcChiSquare) applies to the residuals as square root
+  Double_t scale = 1.0;
+  if (fScaleN0AndBkg)
+    scale = TMath::Sqrt(fPacking * (fTimeResolution * 1.0e3));
+
+  Double_t time(1.0);
+  Int_t i;
+
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
+  // Calculate the theory function once to ensure one function evaluation for the current set of parameters,
+  // outside of the parallelized loop (see CalcChiSquare).
+  time = fTheory->Func(time, par, fFuncValues);
+
+  residuals.resize((fEndTimeBin > fStartTimeBin) ? fEndTimeBin-fStartTimeBin : 0);
+
+  #ifdef HAVE_GOMP
+  Int_t chunk = (fEndTimeBin - fStartTimeBin)/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(i,time) schedule(dynamic,chunk)
+  #endif
+  for (i=fStartTimeBin; i<fEndTimeBin; ++i) {
+    time = fData.GetDataTimeStart() + static_cast<Double_t>(i)*fData.GetDataTimeStep();
+    residuals[i-fStartTimeBin] = scale * (fData.GetValue()->at(i) -
+          (N0*TMath::Exp(-time/tau)*(1.0+fTheory->Func(time, par, fFuncValues))+bkg)) / fData.GetError()->at(i);
+  }
+}
+
 //--------------------------------------------------------------------------
 // CalcChiSquareExpected (public)
 //--------------------------------------------------------------------------
@@ -227,47 +249,20 @@ Double_t PRunSingleHisto::CalcChiSquareExpected(const std::vector<Double_t>& par
   Double_t diff  = 0.0;
   Double_t theo  = 0.0;
 
-  Double_t N0 = 0.0;
-
-  // check if norm is a parameter or a function
-  if (fRunInfo->GetNormParamNo() < MSR_PARAM_FUN_OFFSET) { // norm is a parameter
-    N0 = par[fRunInfo->GetNormParamNo()-1];
-  } else { // norm is a function
-    // get function number
-    UInt_t funNo = fRunInfo->GetNormParamNo()-MSR_PARAM_FUN_OFFSET;
-    // evaluate function
-    N0 = fMsrInfo->EvalFunc(funNo, *fRunInfo->GetMap(), par, fMetaData);
-  }
-
-  // get tau
-  Double_t tau;
-  if (fRunInfo->GetLifetimeParamNo() != -1)
-    tau = par[fRunInfo->GetLifetimeParamNo()-1];
-  else
-    tau = PMUON_LIFETIME;
-
-  // get background
-  Double_t bkg;
-  if (fRunInfo->GetBkgFitParamNo() == -1) { // bkg not fitted
-    if (fRunInfo->GetBkgFix(0) == PMUSR_UNDEFINED) { // no fixed background given (background interval)
-      bkg = fBackground;
-    } else { // fixed bkg given
-      bkg = fRunInfo->GetBkgFix(0);
-    }
-  } else { // bkg fitted
-    bkg = par[fRunInfo->GetBkgFitParamNo()-1];
-  }
+  // get N0, tau, and background
+  Double_t N0, tau, bkg;
+  GetN0TauBkg(par, N0, tau, bkg);
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    Int_t funcNo = fMsrInfo->GetFuncNo(i);
-    fFuncValues[i] = fMsrInfo->EvalFunc(funcNo, *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate chi square
   Double_t time(1.0);
   Int_t i;
 
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
   // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
   // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
   // for a given set of parameters---which should be done outside of the parallelized loop.
@@ -310,42 +305,12 @@ Double_t PRunSingleHisto::CalcMaxLikelihood(const std::vector<Double_t>& par)
 {
   Double_t mllh = 0.0; // maximum log likelihood assuming poisson distribution for the single bin
 
-  Double_t N0;
-
-  // check if norm is a parameter or a function
-  if (fRunInfo->GetNormParamNo() < MSR_PARAM_FUN_OFFSET) { // norm is a parameter
-    N0 = par[fRunInfo->GetNormParamNo()-1];
-  } else { // norm is a function
-    // get function number
-    Int_t funNo = fRunInfo->GetNormParamNo()-MSR_PARAM_FUN_OFFSET;
-    // evaluate function
-    N0 = fMsrInfo->EvalFunc(funNo, *fRunInfo->GetMap(), par, fMetaData);
-  }
-
-  // get tau
-  Double_t tau;
-  if (fRunInfo->GetLifetimeParamNo() != -1)
-    tau = par[fRunInfo->GetLifetimeParamNo()-1];
-  else
-    tau = PMUON_LIFETIME;
-
-  // get background
-  Double_t bkg;
-  if (fRunInfo->GetBkgFitParamNo() == -1) { // bkg not fitted
-    if (fRunInfo->GetBkgFix(0) == PMUSR_UNDEFINED) { // no fixed background given (background interval)
-      bkg = fBackground;
-    } else { // fixed bkg given
-      bkg = fRunInfo->GetBkgFix(0);
-    }
-  } else { // bkg fitted
-    bkg = par[fRunInfo->GetBkgFitParamNo()-1];
-  }
+  // get N0, tau, and background
+  Double_t N0, tau, bkg;
+  GetN0TauBkg(par, N0, tau, bkg);
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    UInt_t funcNo = fMsrInfo->GetFuncNo(i);
-    fFuncValues[i] = fMsrInfo->EvalFunc(funcNo, *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate maximum log likelihood
   Double_t theo;
@@ -359,6 +324,9 @@ Double_t PRunSingleHisto::CalcMaxLikelihood(const std::vector<Double_t>& par)
   if (fScaleN0AndBkg)
     normalizer = fPacking * (fTimeResolution * 1.0e3);
 
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
   // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
   // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
   // for a given set of parameters---which should be done outside of the parallelized loop.
@@ -408,42 +376,12 @@ Double_t PRunSingleHisto::CalcMaxLikelihoodExpected(const std::vector<Double_t>&
 {
   Double_t mllh = 0.0; // maximum log likelihood assuming poisson distribution for the single bin
 
-  Double_t N0;
-
-  // check if norm is a parameter or a function
-  if (fRunInfo->GetNormParamNo() < MSR_PARAM_FUN_OFFSET) { // norm is a parameter
-    N0 = par[fRunInfo->GetNormParamNo()-1];
-  } else { // norm is a function
-    // get function number
-    Int_t funNo = fRunInfo->GetNormParamNo()-MSR_PARAM_FUN_OFFSET;
-    // evaluate function
-    N0 = fMsrInfo->EvalFunc(funNo, *fRunInfo->GetMap(), par, fMetaData);
-  }
-
-  // get tau
-  Double_t tau;
-  if (fRunInfo->GetLifetimeParamNo() != -1)
-    tau = par[fRunInfo->GetLifetimeParamNo()-1];
-  else
-    tau = PMUON_LIFETIME;
-
-  // get background
-  Double_t bkg;
-  if (fRunInfo->GetBkgFitParamNo() == -1) { // bkg not fitted
-    if (fRunInfo->GetBkgFix(0) == PMUSR_UNDEFINED) { // no fixed background given (background interval)
-      bkg = fBackground;
-    } else { // fixed bkg given
-      bkg = fRunInfo->GetBkgFix(0);
-    }
-  } else { // bkg fitted
-    bkg = par[fRunInfo->GetBkgFitParamNo()-1];
-  }
+  // get N0, tau, and background
+  Double_t N0, tau, bkg;
+  GetN0TauBkg(par, N0, tau, bkg);
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    UInt_t funcNo = fMsrInfo->GetFuncNo(i);
-    fFuncValues[i] = fMsrInfo->EvalFunc(funcNo, *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate maximum log likelihood
   Double_t theo;
@@ -457,6 +395,9 @@ Double_t PRunSingleHisto::CalcMaxLikelihoodExpected(const std::vector<Double_t>&
   if (fScaleN0AndBkg)
     normalizer = fPacking * (fTimeResolution * 1.0e3);
 
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
   // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
   // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
   // for a given set of parameters---which should be done outside of the parallelized loop.
@@ -535,9 +476,7 @@ void PRunSingleHisto::CalcTheory()
   }
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate theory
   UInt_t size = fData.GetValue()->size();
@@ -801,6 +740,9 @@ Bool_t PRunSingleHisto::PrepareData()
     }
   }
 
+  // cumulative form of the grouped forward histo, used for packing
+  fForwardCum.Set(fForward);
+
   // get the data range (fgb/lgb) for the current RUN block
   if (!GetProperDataRange()) {
     return false;
@@ -878,6 +820,7 @@ Bool_t PRunSingleHisto::PrepareFitData(PRawRunData* runData, const UInt_t histoN
       for (UInt_t i=0; i<fForward.size(); i++) {
         fForward[i] -= fRunInfo->GetBkgFix(0);
       }
+      fForwardCum.Set(fForward); // keep the cumulative histo in sync with the background corrected one
     }
   }
 
@@ -893,28 +836,21 @@ Bool_t PRunSingleHisto::PrepareFitData(PRawRunData* runData, const UInt_t histoN
   // time shifted so that packing is included correctly, i.e. t0 == t0 after packing
   fData.SetDataTimeStart(fTimeResolution*((static_cast<Double_t>(fGoodBins[0])-0.5) + static_cast<Double_t>(fPacking)/2.0 - static_cast<Double_t>(t0)));
   fData.SetDataTimeStep(fTimeResolution*fPacking);
-  for (Int_t i=fGoodBins[0]; i<fGoodBins[1]; i++) {
-    if (fPacking == 1) {
-      value = fForward[i];
-      value /= normalizer;
-      fData.AppendValue(value);
-      if (value == 0.0)
-        fData.AppendErrorValue(1.0/normalizer);
-      else
-        fData.AppendErrorValue(TMath::Sqrt(value));
-    } else { // packed data, i.e. fPacking > 1
-      if (((i-fGoodBins[0]) % fPacking == 0) && (i != fGoodBins[0])) { // fill data
-        value /= normalizer;
-        fData.AppendValue(value);
-        if (value == 0.0)
-          fData.AppendErrorValue(1.0/normalizer);
-        else
-          fData.AppendErrorValue(TMath::Sqrt(value));
-        // reset values
-        value = 0.0;
-      }
-      value += fForward[i];
-    }
+  // packed bins are taken from the cumulative histogram, i.e. O(1) per packed bin
+  UInt_t noOfBins = GetNoOfPackedBins(fGoodBins[0], fGoodBins[1], fPacking);
+  if ((fPacking == 1) && (fGoodBins[1] > fGoodBins[0])) // unpacked: all bins of the fit range are taken
+    noOfBins = fGoodBins[1]-fGoodBins[0];
+  for (UInt_t i=0; i<noOfBins; i++) {
+    if (fPacking == 1)
+      value = fForward[fGoodBins[0]+i];
+    else // packed data, i.e. fPacking > 1
+      value = fForwardCum.GetPackedBin(fGoodBins[0], fPacking, i);
+    value /= normalizer;
+    fData.AppendValue(value);
+    if (value == 0.0)
+      fData.AppendErrorValue(1.0/normalizer);
+    else
+      fData.AppendErrorValue(TMath::Sqrt(value));
   }
 
   CalcNoOfFitBins();
@@ -998,18 +934,15 @@ Bool_t PRunSingleHisto::PrepareRawViewData(PRawRunData* runData, const UInt_t hi
   fData.SetDataTimeStart(fTimeResolution*((static_cast<Double_t>(start)-0.5) + static_cast<Double_t>(packing)/2.0 - static_cast<Double_t>(t0)));
   fData.SetDataTimeStep(fTimeResolution*packing);
 
-  for (Int_t i=start; i<end; i++) {
-    if (((i-start) % packing == 0) && (i != start)) { // fill data
-      value *= dataNorm;
-      fData.AppendValue(value);
-      if (value == 0.0)
-        fData.AppendErrorValue(1.0);
-      else
-        fData.AppendErrorValue(TMath::Sqrt(value*dataNorm));
-      // reset values
-      value = 0.0;
-    }
-    value += fForward[i];
+  UInt_t noOfBins = GetNoOfPackedBins(start, end, packing);
+  for (UInt_t i=0; i<noOfBins; i++) {
+    value = fForwardCum.GetPackedBin(start, packing, i);
+    value *= dataNorm;
+    fData.AppendValue(value);
+    if (value == 0.0)
+      fData.AppendErrorValue(1.0);
+    else
+      fData.AppendErrorValue(TMath::Sqrt(value*dataNorm));
   }
 
   CalcNoOfFitBins();
@@ -1068,9 +1001,7 @@ Bool_t PRunSingleHisto::PrepareRawViewData(PRawRunData* runData, const UInt_t hi
   bkg *= theoryNorm;
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate theory
   UInt_t size = fForward.size();
@@ -1256,17 +1187,14 @@ Bool_t PRunSingleHisto::PrepareViewData(PRawRunData* runData, const UInt_t histo
   // data is always normalized to (per nsec!!)
   Double_t gammaRRF = 0.0, wRRF = 0.0, phaseRRF = 0.0;
   if (fMsrInfo->GetMsrPlotList()->at(0).fRRFFreq == 0.0) { // normal Data representation
-    for (Int_t i=start; i<end; i++) {
-      if (((i-start) % packing == 0) && (i != start)) { // fill data
-        value *= dataNorm;
-        // since the packing counter is already at the end of the bin, the time needs be shifted back by pack*time_resolution
-        time = (((static_cast<Double_t>(i)-0.5) + static_cast<Double_t>(packing)/2.0 - static_cast<Double_t>(t0)))*fTimeResolution - static_cast<Double_t>(packing)*fTimeResolution;
-        expval = TMath::Exp(+time/tau)/N0;
-        fData.AppendValue(-1.0+expval*(value-bkg));
-        fData.AppendErrorValue(expval*TMath::Sqrt(value*dataNorm));
-        value = 0.0;
-      }
-      value += fForward[i];
+    UInt_t noOfBins = GetNoOfPackedBins(start, end, packing);
+    for (UInt_t i=0; i<noOfBins; i++) {
+      value = fForwardCum.GetPackedBin(start, packing, i);
+      value *= dataNorm;
+      time = (((static_cast<Double_t>(start+i*packing)-0.5) + static_cast<Double_t>(packing)/2.0 - static_cast<Double_t>(t0)))*fTimeResolution;
+      expval = TMath::Exp(+time/tau)/N0;
+      fData.AppendValue(-1.0+expval*(value-bkg));
+      fData.AppendErrorValue(expval*TMath::Sqrt(value*dataNorm));
     }
   } else { // RRF representation
     // check which units shall be used
@@ -1312,9 +1240,7 @@ Bool_t PRunSingleHisto::PrepareViewData(PRawRunData* runData, const UInt_t histo
   CalcNoOfFitBins();
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate theory
   Double_t theoryValue;
@@ -1379,6 +1305,48 @@ Bool_t PRunSingleHisto::PrepareViewData(PRawRunData* runData, const UInt_t histo
   return true;
 }
 
+//--------------------------------------------------------------------------
+// GetN0TauBkg (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Determines N0, the muon lifetime, and the background for the given parameter set, as needed
+ * by the chisq, maxLH, and residual calculations.
+ *
+ * \param par parameter vector iterated by the fitter
+ * \param N0 normalization, either a parameter or a function
+ * \param tau muon lifetime, either a fit parameter or PMUON_LIFETIME
+ * \param bkg background, either fitted, fixed, or estimated from the background range
+ */
+void PRunSingleHisto::GetN0TauBkg(const std::vector<Double_t>& par, Double_t &N0, Double_t &tau, Double_t &bkg)
+{
+  // check if norm is a parameter or a function
+  if (fRunInfo->GetNormParamNo() < MSR_PARAM_FUN_OFFSET) { // norm is a parameter
+    N0 = par[fRunInfo->GetNormParamNo()-1];
+  } else { // norm is a function
+    // get function number
+    UInt_t funNo = fRunInfo->GetNormParamNo()-MSR_PARAM_FUN_OFFSET;
+    // evaluate function
+    N0 = fMsrInfo->EvalFunc(funNo, *fRunInfo->GetMap(), par, fMetaData);
+  }
+
+  // get tau
+  if (fRunInfo->GetLifetimeParamNo() != -1)
+    tau = par[fRunInfo->GetLifetimeParamNo()-1];
+  else
+    tau = PMUON_LIFETIME;
+
+  // get background
+  if (fRunInfo->GetBkgFitParamNo() == -1) { // bkg not fitted
+    if (fRunInfo->GetBkgFix(0) == PMUSR_UNDEFINED) { // no fixed background given (background interval)
+      bkg = fBackground;
+    } else { // fixed bkg given
+      bkg = fRunInfo->GetBkgFix(0);
+    }
+  } else { // bkg fitted
+    bkg = par[fRunInfo->GetBkgFitParamNo()-1];
+  }
+}
+
 //--------------------------------------------------------------------------
 // GetProperT0 (private)
 //--------------------------------------------------------------------------
@@ -154,15 +154,15 @@ Double_t PRunSingleHistoRRF::CalcChiSquare(const std::vector<Double_t>& par)
   Double_t diff      = 0.0;
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    UInt_t funcNo = fMsrInfo->GetFuncNo(i);
-    fFuncValues[i] = fMsrInfo->EvalFunc(funcNo, *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate chi square
   Double_t time(1.0);
   Int_t i;
 
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
   // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
   // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
   // for a given set of parameters---which should be done outside of the parallelized loop.
@@ -184,6 +184,45 @@ Double_t PRunSingleHistoRRF::CalcChiSquare(const std::vector<Double_t>& par)
   return chisq;
 }
 
+//--------------------------------------------------------------------------
+// CalcResiduals (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculate the normalized residuals (data-theory)/error of all fitted bins, used by the
+ * least-squares fitter (LEAST_SQUARES). The sum of their squares is the chi-square of CalcChiSquare.
+ *
+ * \param par parameter vector iterated by the fitter
+ * \param residuals normalized residuals of the fitted bins
+ */
+void PRunSingleHistoRRF::CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals)
+{
+  // calculate functions
+  CalcFuncValues(par);
+
+  Double_t time(1.0);
+  Int_t i;
+
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
+  // Calculate the theory function once to ensure one function evaluation for the current set of parameters,
+  // outside of the parallelized loop (see CalcChiSquare).
+  time = fTheory->Func(time, par, fFuncValues);
+
+  residuals.resize((fEndTimeBin > fStartTimeBin) ? fEndTimeBin-fStartTimeBin : 0);
+
+  #ifdef HAVE_GOMP
+  Int_t chunk = (fEndTimeBin - fStartTimeBin)/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(i,time) schedule(dynamic,chunk)
+  #endif
+  for (i=fStartTimeBin; i<fEndTimeBin; ++i) {
+    time = fData.GetDataTimeStart() + static_cast<Double_t>(i)*fData.GetDataTimeStep();
+    residuals[i-fStartTimeBin] = (fData.GetValue()->at(i) - fTheory->Func(time, par, fFuncValues)) / fData.GetError()->at(i);
+  }
+}
+
 //--------------------------------------------------------------------------
 // CalcChiSquareExpected (public)
 //--------------------------------------------------------------------------
@@ -202,15 +241,15 @@ Double_t PRunSingleHistoRRF::CalcChiSquareExpected(const std::vector<Double_t>&
   Double_t theo  = 0.0;
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    UInt_t funcNo = fMsrInfo->GetFuncNo(i);
-    fFuncValues[i] = fMsrInfo->EvalFunc(funcNo, *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate chi square
   Double_t time(1.0);
   Int_t i;
 
+  // let user functions calculate all times of the fit range in one go
+  PrepareTheory(par, fStartTimeBin, fEndTimeBin);
+
   // Calculate the theory function once to ensure one function evaluation for the current set of parameters.
   // This is needed for the LF and user functions where some non-thread-save calculations only need to be calculated once
   // for a given set of parameters---which should be done outside of the parallelized loop.
@@ -266,9 +305,7 @@ void PRunSingleHistoRRF::CalcTheory()
     par.push_back((*paramList)[i].fValue);
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // calculate theory
   UInt_t size = fData.GetValue()->size();
@@ -670,33 +707,23 @@ Bool_t PRunSingleHistoRRF::PrepareFitData(PRawRunData* runData, const UInt_t his
     fForward[i] *= 2.0*cos(wRRF * time + phaseRRF);
   }
 
-  // 6) RRF packing
-  Double_t dval=0.0;
-  for (Int_t i=fGoodBins[0]; i<=fGoodBins[1]; i++) {
-    if (fRRFPacking == 1) {
+  // 6) RRF packing. The packed bins are taken from the cumulative histogram, i.e. O(1) per packed bin
+  UInt_t noOfBins = GetNoOfPackedBins(fGoodBins[0], fGoodBins[1]+1, fRRFPacking);
+  if (fRRFPacking == 1) {
+    for (Int_t i=fGoodBins[0]; i<=fGoodBins[1]; i++)
       fData.AppendValue(fForward[i]);
-    } else { // RRF packing > 1
-      if (((i-fGoodBins[0]) % fRRFPacking == 0) && (i != fGoodBins[0])) { // fill data
-        dval /= fRRFPacking;
-        fData.AppendValue(dval);
-        // reset dval
-        dval = 0.0;
-      }
-      dval += fForward[i];
-    }
+  } else { // RRF packing > 1
+    PCumulativeHisto cumForward(fForward);
+    for (UInt_t i=0; i<noOfBins; i++)
+      fData.AppendValue(cumForward.GetPackedBin(fGoodBins[0], fRRFPacking, i)/fRRFPacking);
   }
 
   // 7) estimate packed RRF errors (see log-book p.204)
   //    the error estimate of the unpacked RRF asymmetry is: errA_RRF(t) \simeq exp(t/tau)/N0 sqrt( [N(t) + ((N(t)-N_bkg)/N0)^2 errN0^2] )
-  dval = 0.0;
   // the packed RRF asymmetry error
-  for (Int_t i=fGoodBins[0]; i<=fGoodBins[1]; i++) {
-    if (((i-fGoodBins[0]) % fRRFPacking == 0) && (i != fGoodBins[0])) { // fill data
-      fData.AppendErrorValue(sqrt(2.0*dval)/fRRFPacking); // the factor 2.0 is needed since the high frequency part is suppressed.
-      dval = 0.0;
-    }
-    dval += fAerr[i-fGoodBins[0]]*fAerr[i-fGoodBins[0]];
-  }
+  PCumulativeHisto cumAerr2(fAerr, true);
+  for (UInt_t i=0; i<noOfBins; i++)
+    fData.AppendErrorValue(sqrt(2.0*cumAerr2.GetPackedBin(0, fRRFPacking, i))/fRRFPacking); // the factor 2.0 is needed since the high frequency part is suppressed.
 
   // set start time and time step
   fData.SetDataTimeStart(fTimeResolution*(static_cast<Double_t>(fGoodBins[0])-static_cast<Double_t>(t0)+static_cast<Double_t>(fRRFPacking-1)/2.0));
@@ -757,9 +784,7 @@ Bool_t PRunSingleHistoRRF::PrepareViewData(PRawRunData* runData, const UInt_t hi
     par.push_back((*paramList)[i].fValue);
 
   // calculate functions
-  for (Int_t i=0; i<fMsrInfo->GetNoOfFuncs(); i++) {
-    fFuncValues[i] = fMsrInfo->EvalFunc(fMsrInfo->GetFuncNo(i), *fRunInfo->GetMap(), par, fMetaData);
-  }
+  CalcFuncValues(par);
 
   // check if a finer binning for the theory is needed
   UInt_t size = fForward.size();
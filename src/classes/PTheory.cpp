@@ -41,6 +41,7 @@
 #include <Math/SpecFuncMathMore.h>
 
 #include "PMsrHandler.h"
+#include "PPerfMonitor.h"
 #include "PTheory.h"
 
 #define SQRT_TWO 1.41421356237
@@ -303,6 +304,7 @@ PTheory::PTheory(PMsrHandler *msrInfo, UInt_t runNo, const Bool_t hasParent) : f
       return;
     } else { // user function valid, hence expand the fUserParam vector to the proper size
       fUserParam.resize(fParamNo.size());
+      fPerfPrepareKey = std::string("user_function/") + fUserFcnClassName.Data() + "/prepare";
     }
 
     // check if the global part of the user function is needed
@@ -694,6 +696,76 @@ Double_t PTheory::Func(Double_t t, const PDoubleVector& paramValues, const PDoub
   }
 }
 
+//--------------------------------------------------------------------------
+/**
+ * <p>Hands all x-values at which the theory will be evaluated for the given parameters
+ * to the user functions of the theory tree (see PUserFcnBase::Prepare), such that they
+ * can do their expensive parts in one batch. Other theory functions are not affected.
+ *
+ * \param t x-values at which Func will be called next
+ * \param paramValues vector with the parameters
+ * \param funcValues vector with the functions (i.e. functions of the parameters)
+ */
+void PTheory::Prepare(const PDoubleVector& t, const PDoubleVector& paramValues, const PDoubleVector& funcValues) const
+{
+  if (fUserFcn) {
+    for (UInt_t i=0; i<fUserParam.size(); i++) {
+      if (fParamNo[i] < MSR_PARAM_FUN_OFFSET) { // parameter or resolved map
+        fUserParam[i] = paramValues[fParamNo[i]];
+      } else { // function
+        fUserParam[i] = funcValues[fParamNo[i]-MSR_PARAM_FUN_OFFSET];
+      }
+    }
+    PPerfTimer timer(fPerfPrepareKey);
+    fUserFcn->Prepare(t, fUserParam);
+  }
+
+  if (fMul)
+    fMul->Prepare(t, paramValues, funcValues);
+  if (fAdd)
+    fAdd->Prepare(t, paramValues, funcValues);
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Marks (recursively) the functions of the FUNCTIONS block which are used within the theory.
+ *
+ * \param used flags indexed by the function index; entries of used functions are set to true.
+ */
+void PTheory::GetUsedFuncs(PBoolVector& used) const
+{
+  for (UInt_t i=0; i<fParamNo.size(); i++) {
+    if ((fParamNo[i] >= MSR_PARAM_FUN_OFFSET) && (fParamNo[i]-MSR_PARAM_FUN_OFFSET < used.size()))
+      used[fParamNo[i]-MSR_PARAM_FUN_OFFSET] = true;
+  }
+
+  if (fMul)
+    fMul->GetUsedFuncs(used);
+  if (fAdd)
+    fAdd->GetUsedFuncs(used);
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Checks (recursively) if independent instances of the theory can be evaluated concurrently.
+ * This is the case if all user functions of the theory declare themselves reentrant
+ * (see PUserFcnBase::IsReentrant).
+ *
+ * <b>return:</b> true if the theory is reentrant, false otherwise
+ */
+Bool_t PTheory::IsReentrant() const
+{
+  if (fUserFcn && !fUserFcn->IsReentrant())
+    return false;
+
+  if (fMul && !fMul->IsReentrant())
+    return false;
+  if (fAdd && !fAdd->IsReentrant())
+    return false;
+
+  return true;
+}
+
 //--------------------------------------------------------------------------
 /**
  * <p> Recursively clean up theory
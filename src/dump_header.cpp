@@ -406,8 +406,8 @@ int dump_header_psi_bin(const std::string fileName, const std::string fileFormat
   int status;
   bool success = false;
 
-  // read psi bin file
-  status = psiBin.Read(fileName.c_str());
+  // read psi bin file (the histograms are only needed if the counts are requested)
+  status = psiBin.Read(fileName.c_str(), !counts);
   switch (status) {
     case 0: // everything perfect
       success = true;
@@ -517,7 +517,7 @@ int dump_header_mud(const std::string fileName, const bool counts)
 
   char fln[256];
   strncpy(fln, fileName.c_str(), sizeof(fln));
-  fh = MUD_openRead(fln, &type);
+  fh = MUD_openReadHeader(fln, &type); // the number of events are part of the histogram header, i.e. no data needed
   if (fh == -1) {
     std::cerr << std::endl << "**ERROR** Couldn't open mud-file " << fileName << ", sorry." << std::endl;
     return 1;
@@ -26,279 +26,240 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <mutex>
+
+#ifdef HAVE_GOMP
+#include <omp.h>
+#endif
+
 #include "BMWIntegrator.h"
 
 #include "cuba.h"
 
-#define USERDATA NULL
 #define SPIN NULL
 #define SEED 0
 #define STATEFILE NULL
 
+int TCubaIntegrator::fParallelBatchSize = 256;
 
-//-----------------------------------------------------------------------------
-
-std::vector<double> TPointPWaveGapIntegralCuhre::fPar;
-
-//-----------------------------------------------------------------------------
-/**
- * <p>Integrate the function using the Cuhre interface
- *
- * <p><b>return:</b>
- * - value of the integral
- */
-double TPointPWaveGapIntegralCuhre::IntegrateFunc(int tag)
-{
-  const unsigned int NCOMP(1);
-  const unsigned int NVEC(1);
-  const double EPSREL (1e-4);
-  const double EPSABS (1e-6);
-  const unsigned int VERBOSE (0);
-  const unsigned int LAST (4);
-  const unsigned int MINEVAL (0);
-  const unsigned int MAXEVAL (50000);
-
-  const unsigned int KEY (13);
-
-  int nregions, neval, fail;
-  double integral[NCOMP], error[NCOMP], prob[NCOMP];
-
-  if (tag == 0)
-    Cuhre(fNDim, NCOMP, Integrand_aa, USERDATA, NVEC,
-      EPSREL, EPSABS, VERBOSE | LAST, MINEVAL, MAXEVAL,
-      KEY, STATEFILE, SPIN,
-      &nregions, &neval, &fail, integral, error, prob);
-  else
-    Cuhre(fNDim, NCOMP, Integrand_cc, USERDATA, NVEC,
-      EPSREL, EPSABS, VERBOSE | LAST, MINEVAL, MAXEVAL,
-      KEY, STATEFILE, SPIN,
-      &nregions, &neval, &fail, integral, error, prob);
+namespace {
+  /**
+   * <p>User data handed to Cuba: the integrator instance and the tag of the integrand
+   */
+  struct TCubaUserData {
+    const TCubaIntegrator *fIntegrator;
+    int fTag;
+  };
 
-  return integral[0];
+  std::once_flag gCubaCoresFlag; ///< Cuba's worker processes are switched off once per process
 }
 
 //-----------------------------------------------------------------------------
 /**
- * <p>Calculate the function value for the use with Cuhre---actual implementation of the function
- * for p-wave point, aa==bb component
- *
- * <p><b>return:</b>
- * - 0
+ * <p>Constructor
  *
- * \param ndim number of dimensions of the integral (2 here)
- * \param x point where the function should be evaluated
- * \param ncomp number of components of the integrand (1 here)
- * \param f function value
- * \param userdata additional user parameters (required by the interface, NULL here)
+ * \param ndim dimension of the integral
+ * \param algorithm Cuba algorithm to be used
  */
-int TPointPWaveGapIntegralCuhre::Integrand_aa(const int *ndim, const double x[],
-                      const int *ncomp, double f[], void *userdata) // x = {E, z}, fPar = {twokBT, Delta(T), Ec, zc}
+TCubaIntegrator::TCubaIntegrator(const unsigned int ndim, const EAlgorithm algorithm) : fNDim(ndim), fAlgorithm(algorithm),
+  fEpsRel(1e-4), fEpsAbs(1e-6), fMinEval(0), fMaxEval(50000)
 {
-  double z = x[1]*fPar[3];
-  double deltasq(pow(sqrt(1.0-z*z)*fPar[1],2.0));
-  f[0] = (1.0-z*z)/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[2]*fPar[2]+deltasq)/fPar[0]),2.0);
-  return 0;
+  // The integrands are evaluated by threads (see Integrand). Cuba's forked workers would duplicate this
+  // and cannot be used if several integrations run concurrently.
+  std::call_once(gCubaCoresFlag, [](){ cubacores(0, 0); });
 }
 
 //-----------------------------------------------------------------------------
 /**
- * <p>Calculate the function value for the use with Cuhre---actual implementation of the function
- * for p-wave point, cc component
- *
- * <p><b>return:</b>
- * - 0
+ * <p>Set the accuracy goals and the limits of the number of integrand evaluations
  *
- * \param ndim number of dimensions of the integral (2 here)
- * \param x point where the function should be evaluated
- * \param ncomp number of components of the integrand (1 here)
- * \param f function value
- * \param userdata additional user parameters (required by the interface, NULL here)
+ * \param epsrel requested relative accuracy
+ * \param epsabs requested absolute accuracy
+ * \param mineval minimum number of integrand evaluations
+ * \param maxeval maximum number of integrand evaluations
  */
-int TPointPWaveGapIntegralCuhre::Integrand_cc(const int *ndim, const double x[],
-                      const int *ncomp, double f[], void *userdata) // x = {E, z}, fPar = {twokBT, Delta(T), Ec, zc}
+void TCubaIntegrator::SetAccuracy(const double epsrel, const double epsabs, const int mineval, const int maxeval)
 {
-  double z = x[1]*fPar[3];
-  double deltasq(pow(sqrt(1.0-z*z)*fPar[1],2.0));
-  f[0] = (z*z)/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[2]*fPar[2]+deltasq)/fPar[0]),2.0);
-  return 0;
+  fEpsRel = epsrel;
+  fEpsAbs = epsabs;
+  fMinEval = mineval;
+  fMaxEval = maxeval;
 }
 
-//-----------------------------------------------------------------------------
-
-std::vector<double> TLinePWaveGapIntegralCuhre::fPar;
-
 //-----------------------------------------------------------------------------
 /**
- * <p>Integrate the function using the Cuhre interface
+ * <p>Integrate the function over the unit hypercube using the chosen Cuba algorithm
  *
  * <p><b>return:</b>
  * - value of the integral
+ *
+ * \param tag selects the integrand if a derived class implements more than one
  */
-double TLinePWaveGapIntegralCuhre::IntegrateFunc(int tag)
+double TCubaIntegrator::IntegrateFunc(const int tag) const
 {
-  const unsigned int NCOMP(1);
-  const unsigned int NVEC(1);
-  const double EPSREL (1e-4);
-  const double EPSABS (1e-6);
-  const unsigned int VERBOSE (0);
-  const unsigned int LAST (4);
-  const unsigned int MINEVAL (0);
-  const unsigned int MAXEVAL (50000);
+  const int NCOMP(1);
+  const int NVEC(1024);
+  const int VERBOSE(0);
+  const int LAST(4);
 
-  const unsigned int KEY (13);
+  TCubaUserData userdata = {this, tag};
+  integrand_t integrand(reinterpret_cast<integrand_t>(&TCubaIntegrator::Integrand));
 
   int nregions, neval, fail;
   double integral[NCOMP], error[NCOMP], prob[NCOMP];
 
-  if (tag == 0)
-    Cuhre(fNDim, NCOMP, Integrand_aa, USERDATA, NVEC,
-      EPSREL, EPSABS, VERBOSE | LAST, MINEVAL, MAXEVAL,
-      KEY, STATEFILE, SPIN,
-      &nregions, &neval, &fail, integral, error, prob);
-  else
-    Cuhre(fNDim, NCOMP, Integrand_cc, USERDATA, NVEC,
-      EPSREL, EPSABS, VERBOSE | LAST, MINEVAL, MAXEVAL,
-      KEY, STATEFILE, SPIN,
-      &nregions, &neval, &fail, integral, error, prob);
+  switch (fAlgorithm) {
+    case kDivonne:
+      {
+        const int KEY1(47);
+        const int KEY2(1);
+        const int KEY3(1);
+        const int MAXPASS(5);
+        const double BORDER(0.);
+        const double MAXCHISQ(10.);
+        const double MINDEVIATION(.25);
+        const int NGIVEN(0);
+        const int LDXGIVEN(fNDim);
+        const int NEXTRA(0);
+
+        Divonne(fNDim, NCOMP, integrand, &userdata, NVEC,
+          fEpsRel, fEpsAbs, VERBOSE, SEED,
+          fMinEval, fMaxEval, KEY1, KEY2, KEY3, MAXPASS,
+          BORDER, MAXCHISQ, MINDEVIATION,
+          NGIVEN, LDXGIVEN, NULL, NEXTRA, NULL,
+          STATEFILE, SPIN,
+          &nregions, &neval, &fail, integral, error, prob);
+      }
+      break;
+    case kSuave:
+      {
+        const int NNEW(1000);
+        const int NMIN(2);
+        const double FLATNESS(25.);
+
+        Suave(fNDim, NCOMP, integrand, &userdata, NVEC,
+          fEpsRel, fEpsAbs, VERBOSE | LAST, SEED,
+          fMinEval, fMaxEval, NNEW, NMIN, FLATNESS,
+          STATEFILE, SPIN,
+          &nregions, &neval, &fail, integral, error, prob);
+      }
+      break;
+    default:
+      {
+        const int KEY(13);
+
+        Cuhre(fNDim, NCOMP, integrand, &userdata, NVEC,
+          fEpsRel, fEpsAbs, VERBOSE | LAST, fMinEval, fMaxEval,
+          KEY, STATEFILE, SPIN,
+          &nregions, &neval, &fail, integral, error, prob);
+      }
+      break;
+  }
 
   return integral[0];
 }
 
 //-----------------------------------------------------------------------------
 /**
- * <p>Calculate the function value for the use with Cuhre---actual implementation of the function
- * for p-wave line, aa==bb component
+ * <p>Integrand in the form needed by Cuba. Evaluates a batch of points (stored one after the other in x),
+ * splitting large batches among threads.
  *
  * <p><b>return:</b>
  * - 0
  *
- * \param ndim number of dimensions of the integral (2 here)
- * \param x point where the function should be evaluated
+ * \param ndim number of dimensions of the integral
+ * \param x points where the function should be evaluated
  * \param ncomp number of components of the integrand (1 here)
- * \param f function value
- * \param userdata additional user parameters (required by the interface, NULL here)
+ * \param f function values
+ * \param userdata integrator and tag, see TCubaUserData
+ * \param nvec number of points in the batch
+ * \param core index of the Cuba worker (not used)
  */
-int TLinePWaveGapIntegralCuhre::Integrand_aa(const int *ndim, const double x[],
-                      const int *ncomp, double f[], void *userdata) // x = {E, z}, fPar = {twokBT, Delta(T), Ec, zc}
+int TCubaIntegrator::Integrand(const int *ndim, const double x[], const int *ncomp, double f[], void *userdata,
+                               const int *nvec, const int *core)
 {
-  double z = x[1]*fPar[3];
-  double deltasq(pow(z*fPar[1],2.0));
-  f[0] = (1.0-z*z)/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[2]*fPar[2]+deltasq)/fPar[0]),2.0);
+  const TCubaUserData *data(static_cast<const TCubaUserData*>(userdata));
+  const TCubaIntegrator *integrator(data->fIntegrator);
+  const int tag(data->fTag);
+  const int n(*nvec), dx(*ndim), df(*ncomp);
+
+#ifdef HAVE_GOMP
+  if ((n >= fParallelBatchSize) && !omp_in_parallel()) {
+    #pragma omp parallel for default(shared) schedule(static)
+    for (int i = 0; i < n; i++) {
+      f[i*df] = integrator->FuncAtX(x + i*dx, tag);
+    }
+    return 0;
+  }
+#endif
+
+  for (int i = 0; i < n; i++) {
+    f[i*df] = integrator->FuncAtX(x + i*dx, tag);
+  }
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * <p>Constructor
+ */
+TPointPWaveGapIntegralCuhre::TPointPWaveGapIntegralCuhre() : TCubaIntegrator(2)
+{
+  SetAccuracy(1e-4, 1e-6, 0, 50000);
+}
+
 //-----------------------------------------------------------------------------
 /**
  * <p>Calculate the function value for the use with Cuhre---actual implementation of the function
- * for p-wave line, cc component
+ * for p-wave point
  *
  * <p><b>return:</b>
- * - 0
+ * - function value
  *
- * \param ndim number of dimensions of the integral (2 here)
- * \param x point where the function should be evaluated
- * \param ncomp number of components of the integrand (1 here)
- * \param f function value
- * \param userdata additional user parameters (required by the interface, NULL here)
+ * \param x point where the function should be evaluated: x = {E, z}, fPar = {twokBT, Delta(T), Ec, zc}
+ * \param tag 0: aa==bb component, 1: cc component
  */
-int TLinePWaveGapIntegralCuhre::Integrand_cc(const int *ndim, const double x[],
-                      const int *ncomp, double f[], void *userdata) // x = {E, z}, fPar = {twokBT, Delta(T), Ec, zc}
+double TPointPWaveGapIntegralCuhre::FuncAtX(const double *x, const int tag) const
 {
   double z = x[1]*fPar[3];
-  double deltasq(pow(z*fPar[1],2.0));
-  f[0] = (z*z)/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[2]*fPar[2]+deltasq)/fPar[0]),2.0);
-  return 0;
+  double deltasq(pow(sqrt(1.0-z*z)*fPar[1],2.0));
+  return ((tag == 0) ? (1.0-z*z) : (z*z))/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[2]*fPar[2]+deltasq)/fPar[0]),2.0);
 }
 
-//-----------------------------------------------------------------------------
-
-std::vector<double> TDWaveGapIntegralCuhre::fPar;
-
 //-----------------------------------------------------------------------------
 /**
- * <p>Integrate the function using the Cuhre interface
- *
- * <p><b>return:</b>
- * - value of the integral
+ * <p>Constructor
  */
-double TDWaveGapIntegralCuhre::IntegrateFunc()
+TLinePWaveGapIntegralCuhre::TLinePWaveGapIntegralCuhre() : TCubaIntegrator(2)
 {
-  const unsigned int NCOMP(1);
-  const unsigned int NVEC(1);
-  const double EPSREL (1e-4);
-  const double EPSABS (1e-6);
-  const unsigned int VERBOSE (0);
-  const unsigned int LAST (4);
-  const unsigned int MINEVAL (0);
-  const unsigned int MAXEVAL (50000);
-
-  const unsigned int KEY (13);
-
-  int nregions, neval, fail;
-  double integral[NCOMP], error[NCOMP], prob[NCOMP];
-
-  Cuhre(fNDim, NCOMP, Integrand, USERDATA, NVEC,
-    EPSREL, EPSABS, VERBOSE | LAST, MINEVAL, MAXEVAL,
-    KEY, STATEFILE, SPIN,
-    &nregions, &neval, &fail, integral, error, prob);
-
-  return integral[0];
+  SetAccuracy(1e-4, 1e-6, 0, 50000);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * <p>Calculate the function value for the use with Cuhre---actual implementation of the function
+ * for p-wave line
  *
  * <p><b>return:</b>
- * - 0
+ * - function value
  *
- * \param ndim number of dimensions of the integral (2 here)
- * \param x point where the function should be evaluated
- * \param ncomp number of components of the integrand (1 here)
- * \param f function value
- * \param userdata additional user parameters (required by the interface, NULL here)
+ * \param x point where the function should be evaluated: x = {E, z}, fPar = {twokBT, Delta(T), Ec, zc}
+ * \param tag 0: aa==bb component, 1: cc component
  */
-int TDWaveGapIntegralCuhre::Integrand(const int *ndim, const double x[],
-                      const int *ncomp, double f[], void *userdata) // x = {E, phi}, fPar = {twokBT, Delta(T), Ec, phic}
+double TLinePWaveGapIntegralCuhre::FuncAtX(const double *x, const int tag) const
 {
-  double deltasq(TMath::Power(fPar[1]*TMath::Cos(2.0*x[1]*fPar[3]),2.0));
-  f[0] = 1.0/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[2]*fPar[2]+deltasq)/fPar[0]),2.0);
-  return 0;
+  double z = x[1]*fPar[3];
+  double deltasq(pow(z*fPar[1],2.0));
+  return ((tag == 0) ? (1.0-z*z) : (z*z))/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[2]*fPar[2]+deltasq)/fPar[0]),2.0);
 }
 
-//-----------------------------------------------------------------------------
-
-std::vector<double> TCosSqDWaveGapIntegralCuhre::fPar;
-
 //-----------------------------------------------------------------------------
 /**
- * <p>Integrate the function using the Cuhre interface
- *
- * <p><b>return:</b>
- * - value of the integral
+ * <p>Constructor
  */
-double TCosSqDWaveGapIntegralCuhre::IntegrateFunc()
+TDWaveGapIntegralCuhre::TDWaveGapIntegralCuhre() : TCubaIntegrator(2)
 {
-  const unsigned int NCOMP(1);
-  const unsigned int NVEC(1);
-  const double EPSREL (1e-8);
-  const double EPSABS (1e-6);
-  const unsigned int VERBOSE (0);
-  const unsigned int LAST (4);
-  const unsigned int MINEVAL (0);
-  const unsigned int MAXEVAL (500000);
-
-  const unsigned int KEY (13);
-
-  int nregions, neval, fail;
-  double integral[NCOMP], error[NCOMP], prob[NCOMP];
-
-  Cuhre(fNDim, NCOMP, Integrand, USERDATA, NVEC,
-    EPSREL, EPSABS, VERBOSE | LAST, MINEVAL, MAXEVAL,
-    KEY, STATEFILE, SPIN,
-    &nregions, &neval, &fail, integral, error, prob);
-
-  return integral[0];
+  SetAccuracy(1e-4, 1e-6, 0, 50000);
 }
 
 //-----------------------------------------------------------------------------
@@ -306,55 +267,24 @@ double TCosSqDWaveGapIntegralCuhre::IntegrateFunc()
  * <p>Calculate the function value for the use with Cuhre---actual implementation of the function
  *
  * <p><b>return:</b>
- * - 0
+ * - function value
  *
- * \param ndim number of dimensions of the integral (2 here)
- * \param x point where the function should be evaluated
- * \param ncomp number of components of the integrand (1 here)
- * \param f function value
- * \param userdata additional user parameters (required by the interface, NULL here)
+ * \param x point where the function should be evaluated: x = {E, phi}, fPar = {twokBT, Delta(T), Ec, phic}
+ * \param tag not used
  */
-int TCosSqDWaveGapIntegralCuhre::Integrand(const int *ndim, const double x[],
-                      const int *ncomp, double f[], void *userdata) // x = {E, phi}, fPar = {twokBT, DeltaD(T), Ec, phic, DeltaS(T)}
+double TDWaveGapIntegralCuhre::FuncAtX(const double *x, const int tag) const
 {
-  double deltasq(TMath::Power(fPar[1]*TMath::Cos(2.0*x[1]*fPar[3]) + fPar[4], 2.0));
-  f[0] = TMath::Power(TMath::Cos(x[1]*fPar[3])/TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[2]*fPar[2]+deltasq)/fPar[0]),2.0);
-  return 0;
+  double deltasq(TMath::Power(fPar[1]*TMath::Cos(2.0*x[1]*fPar[3]),2.0));
+  return 1.0/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[2]*fPar[2]+deltasq)/fPar[0]),2.0);
 }
 
-//-----------------------------------------------------------------------------
-
-std::vector<double> TSinSqDWaveGapIntegralCuhre::fPar;
-
 //-----------------------------------------------------------------------------
 /**
- * <p>Integrate the function using the Cuhre interface
- *
- * <p><b>return:</b>
- * - value of the integral
+ * <p>Constructor
  */
-double TSinSqDWaveGapIntegralCuhre::IntegrateFunc()
+TCosSqDWaveGapIntegralCuhre::TCosSqDWaveGapIntegralCuhre() : TCubaIntegrator(2)
 {
-  const unsigned int NCOMP(1);
-  const unsigned int NVEC(1);
-  const double EPSREL (1e-8);
-  const double EPSABS (1e-10);
-  const unsigned int VERBOSE (0);
-  const unsigned int LAST (4);
-  const unsigned int MINEVAL (0);
-  const unsigned int MAXEVAL (500000);
-
-  const unsigned int KEY (13);
-
-  int nregions, neval, fail;
-  double integral[NCOMP], error[NCOMP], prob[NCOMP];
-
-  Cuhre(fNDim, NCOMP, Integrand, USERDATA, NVEC,
-    EPSREL, EPSABS, VERBOSE | LAST, MINEVAL, MAXEVAL,
-    KEY, STATEFILE, SPIN,
-    &nregions, &neval, &fail, integral, error, prob);
-
-  return integral[0];
+  SetAccuracy(1e-8, 1e-6, 0, 500000);
 }
 
 //-----------------------------------------------------------------------------
@@ -362,55 +292,24 @@ double TSinSqDWaveGapIntegralCuhre::IntegrateFunc()
  * <p>Calculate the function value for the use with Cuhre---actual implementation of the function
  *
  * <p><b>return:</b>
- * - 0
+ * - function value
  *
- * \param ndim number of dimensions of the integral (2 here)
- * \param x point where the function should be evaluated
- * \param ncomp number of components of the integrand (1 here)
- * \param f function value
- * \param userdata additional user parameters (required by the interface, NULL here)
+ * \param x point where the function should be evaluated: x = {E, phi}, fPar = {twokBT, DeltaD(T), Ec, phic, DeltaS(T)}
+ * \param tag not used
  */
-int TSinSqDWaveGapIntegralCuhre::Integrand(const int *ndim, const double x[],
-                      const int *ncomp, double f[], void *userdata) // x = {E, phi}, fPar = {twokBT, DeltaD(T), Ec, phic, DeltaS(T)}
+double TCosSqDWaveGapIntegralCuhre::FuncAtX(const double *x, const int tag) const
 {
   double deltasq(TMath::Power(fPar[1]*TMath::Cos(2.0*x[1]*fPar[3]) + fPar[4], 2.0));
-  f[0] = TMath::Power(TMath::Sin(x[1]*fPar[3]),2.0)/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[2]*fPar[2]+deltasq)/fPar[0]),2.0);
-  return 0;
+  return TMath::Power(TMath::Cos(x[1]*fPar[3])/TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[2]*fPar[2]+deltasq)/fPar[0]),2.0);
 }
 
-//-----------------------------------------------------------------------------
-
-std::vector<double> TAnSWaveGapIntegralCuhre::fPar;
-
 //-----------------------------------------------------------------------------
 /**
- * <p>Integrate the function using the Cuhre interface
- *
- * <p><b>return:</b>
- * - value of the integral
+ * <p>Constructor
  */
-double TAnSWaveGapIntegralCuhre::IntegrateFunc()
+TSinSqDWaveGapIntegralCuhre::TSinSqDWaveGapIntegralCuhre() : TCubaIntegrator(2)
 {
-  const unsigned int NCOMP(1);
-  const unsigned int NVEC(1);
-  const double EPSREL (1e-4);
-  const double EPSABS (1e-6);
-  const unsigned int VERBOSE (0);
-  const unsigned int LAST (4);
-  const unsigned int MINEVAL (100);
-  const unsigned int MAXEVAL (1000000);
-
-  const unsigned int KEY (13);
-
-  int nregions, neval, fail;
-  double integral[NCOMP], error[NCOMP], prob[NCOMP];
-
-  Cuhre(fNDim, NCOMP, Integrand, USERDATA, NVEC,
-    EPSREL, EPSABS, VERBOSE | LAST, MINEVAL, MAXEVAL,
-    KEY, STATEFILE, SPIN,
-    &nregions, &neval, &fail, integral, error, prob);
-
-  return integral[0];
+  SetAccuracy(1e-8, 1e-10, 0, 500000);
 }
 
 //-----------------------------------------------------------------------------
@@ -418,177 +317,69 @@ double TAnSWaveGapIntegralCuhre::IntegrateFunc()
  * <p>Calculate the function value for the use with Cuhre---actual implementation of the function
  *
  * <p><b>return:</b>
- * - 0
+ * - function value
  *
- * \param ndim number of dimensions of the integral (2 here)
- * \param x point where the function should be evaluated
- * \param ncomp number of components of the integrand (1 here)
- * \param f function value
- * \param userdata additional user parameters (required by the interface, NULL here)
+ * \param x point where the function should be evaluated: x = {E, phi}, fPar = {twokBT, DeltaD(T), Ec, phic, DeltaS(T)}
+ * \param tag not used
  */
-int TAnSWaveGapIntegralCuhre::Integrand(const int *ndim, const double x[],
-                      const int *ncomp, double f[], void *userdata) // x = {E, phi}, fPar = {twokBT, Delta(T),a, Ec, phic}
+double TSinSqDWaveGapIntegralCuhre::FuncAtX(const double *x, const int tag) const
 {
-  double deltasq(TMath::Power(fPar[1]*(1.0+fPar[2]*TMath::Cos(4.0*x[1]*fPar[4])),2.0));
-  f[0] = 1.0/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[3]*fPar[3]+deltasq)/fPar[0]),2.0);
-  return 0;
+  double deltasq(TMath::Power(fPar[1]*TMath::Cos(2.0*x[1]*fPar[3]) + fPar[4], 2.0));
+  return TMath::Power(TMath::Sin(x[1]*fPar[3]),2.0)/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[2]*fPar[2]+deltasq)/fPar[0]),2.0);
 }
 
-//-----------------------------------------------------------------------------
-
-std::vector<double> TAnSWaveGapIntegralDivonne::fPar;
-
 //-----------------------------------------------------------------------------
 /**
- * <p>Integrate the function using the Divonne interface
+ * <p>Constructor
  *
- * <p><b>return:</b>
- * - value of the integral
+ * \param algorithm Cuba algorithm to be used
  */
-double TAnSWaveGapIntegralDivonne::IntegrateFunc()
+TAnSWaveGapIntegralCuhre::TAnSWaveGapIntegralCuhre(const EAlgorithm algorithm) : TCubaIntegrator(2, algorithm)
 {
-  const unsigned int NCOMP(1);
-  const unsigned int NVEC(1);
-  const double EPSREL (1e-4);
-  const double EPSABS (1e-6);
-  const unsigned int VERBOSE (0);
-  const unsigned int MINEVAL (1000);
-  const unsigned int MAXEVAL (1000000);
-  const unsigned int KEY1 (47);
-  const unsigned int KEY2 (1);
-  const unsigned int KEY3 (1);
-  const unsigned int MAXPASS (5);
-  const double BORDER (0.);
-  const double MAXCHISQ (10.);
-  const double MINDEVIATION (.25);
-  const unsigned int NGIVEN (0);
-  const unsigned int LDXGIVEN (fNDim);
-  const unsigned int NEXTRA (0);
-
-  int nregions, neval, fail;
-  double integral[NCOMP], error[NCOMP], prob[NCOMP];
-
-  Divonne(fNDim, NCOMP, Integrand, USERDATA, NVEC,
-    EPSREL, EPSABS, VERBOSE, SEED, MINEVAL, MAXEVAL,
-    KEY1, KEY2, KEY3, MAXPASS, BORDER, MAXCHISQ, MINDEVIATION,
-    NGIVEN, LDXGIVEN, NULL, NEXTRA, NULL, STATEFILE, SPIN,
-    &nregions, &neval, &fail, integral, error, prob);
-
-  return integral[0];
+  SetAccuracy(1e-4, 1e-6, 100, 1000000);
 }
 
 //-----------------------------------------------------------------------------
 /**
- * <p>Calculate the function value for the use with Divonne---actual implementation of the function
+ * <p>Calculate the function value for the use with Cuba---actual implementation of the function
  *
  * <p><b>return:</b>
- * - 0
+ * - function value
  *
- * \param ndim number of dimensions of the integral (2 here)
- * \param x point where the function should be evaluated
- * \param ncomp number of components of the integrand (1 here)
- * \param f function value
- * \param userdata additional user parameters (required by the interface, NULL here)
+ * \param x point where the function should be evaluated: x = {E, phi}, fPar = {twokBT, Delta(T),a, Ec, phic}
+ * \param tag not used
  */
-int TAnSWaveGapIntegralDivonne::Integrand(const int *ndim, const double x[],
-                      const int *ncomp, double f[], void *userdata) // x = {E, phi}, fPar = {twokBT, Delta(T),a, Ec, phic}
+double TAnSWaveGapIntegralCuhre::FuncAtX(const double *x, const int tag) const
 {
   double deltasq(TMath::Power(fPar[1]*(1.0+fPar[2]*TMath::Cos(4.0*x[1]*fPar[4])),2.0));
-  f[0] = 1.0/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[3]*fPar[3]+deltasq)/fPar[0]),2.0);
-  return 0;
+  return 1.0/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[3]*fPar[3]+deltasq)/fPar[0]),2.0);
 }
 
-//-----------------------------------------------------------------------------
-
-std::vector<double> TAnSWaveGapIntegralSuave::fPar;
-
 //-----------------------------------------------------------------------------
 /**
- * <p>Integrate the function using the Suave interface
- *
- * <p><b>return:</b>
- * - value of the integral
+ * <p>Constructor
  */
-double TAnSWaveGapIntegralSuave::IntegrateFunc()
+TAnSWaveGapIntegralDivonne::TAnSWaveGapIntegralDivonne() : TAnSWaveGapIntegralCuhre(kDivonne)
 {
-  const unsigned int NCOMP(1);
-  const unsigned int NVEC(1);
-  const double EPSREL (1e-4);
-  const double EPSABS (1e-6);
-  const unsigned int VERBOSE (0);
-  const unsigned int LAST (4);
-  const unsigned int MINEVAL (1000);
-  const unsigned int MAXEVAL (1000000);
-
-  const unsigned int NNEW (1000);
-  const unsigned int NMIN (2);
-  const double FLATNESS (25.);
-
-  int nregions, neval, fail;
-  double integral[NCOMP], error[NCOMP], prob[NCOMP];
-
-  Suave(fNDim, NCOMP, Integrand, USERDATA, NVEC,
-    EPSREL, EPSABS, VERBOSE | LAST, SEED, MINEVAL, MAXEVAL,
-    NNEW, NMIN, FLATNESS, STATEFILE, SPIN,
-    &nregions, &neval, &fail, integral, error, prob);
-
-  return integral[0];
+  SetAccuracy(1e-4, 1e-6, 1000, 1000000);
 }
 
 //-----------------------------------------------------------------------------
 /**
- * <p>Calculate the function value for the use with Suave---actual implementation of the function
- *
- * <p><b>return:</b>
- * - 0
- *
- * \param ndim number of dimensions of the integral (2 here)
- * \param x point where the function should be evaluated
- * \param ncomp number of components of the integrand (1 here)
- * \param f function value
- * \param userdata additional user parameters (required by the interface, NULL here)
+ * <p>Constructor
  */
-int TAnSWaveGapIntegralSuave::Integrand(const int *ndim, const double x[],
-                      const int *ncomp, double f[], void *userdata) // x = {E, phi}, fPar = {twokBT, Delta(T),a, Ec, phic}
+TAnSWaveGapIntegralSuave::TAnSWaveGapIntegralSuave() : TAnSWaveGapIntegralCuhre(kSuave)
 {
-  double deltasq(TMath::Power(fPar[1]*(1.0+fPar[2]*TMath::Cos(4.0*x[1]*fPar[4])),2.0));
-  f[0] = 1.0/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[3]*fPar[3]+deltasq)/fPar[0]),2.0);
-  return 0;
+  SetAccuracy(1e-4, 1e-6, 1000, 1000000);
 }
 
-//-----------------------------------------------------------------------------
-
-std::vector<double> TNonMonDWave1GapIntegralCuhre::fPar;
-
 //-----------------------------------------------------------------------------
 /**
- * <p>Integrate the function using the Cuhre interface
- *
- * <p><b>return:</b>
- * - value of the integral
+ * <p>Constructor
  */
-double TNonMonDWave1GapIntegralCuhre::IntegrateFunc()
+TNonMonDWave1GapIntegralCuhre::TNonMonDWave1GapIntegralCuhre() : TCubaIntegrator(2)
 {
-  const unsigned int NCOMP(1);
-  const unsigned int NVEC(1);
-  const double EPSREL (1e-4);
-  const double EPSABS (1e-6);
-  const unsigned int VERBOSE (0);
-  const unsigned int LAST (4);
-  const unsigned int MINEVAL (100);
-  const unsigned int MAXEVAL (1000000);
-
-  const unsigned int KEY (13);
-
-  int nregions, neval, fail;
-  double integral[NCOMP], error[NCOMP], prob[NCOMP];
-
-  Cuhre(fNDim, NCOMP, Integrand, USERDATA, NVEC,
-    EPSREL, EPSABS, VERBOSE | LAST, MINEVAL, MAXEVAL,
-    KEY, STATEFILE, SPIN,
-    &nregions, &neval, &fail, integral, error, prob);
-
-  return integral[0];
+  SetAccuracy(1e-4, 1e-6, 100, 1000000);
 }
 
 //-----------------------------------------------------------------------------
@@ -596,55 +387,24 @@ double TNonMonDWave1GapIntegralCuhre::IntegrateFunc()
  * <p>Calculate the function value for the use with Cuhre---actual implementation of the function
  *
  * <p><b>return:</b>
- * - 0
+ * - function value
  *
- * \param ndim number of dimensions of the integral (2 here)
- * \param x point where the function should be evaluated
- * \param ncomp number of components of the integrand (1 here)
- * \param f function value
- * \param userdata additional user parameters (required by the interface, NULL here)
+ * \param x point where the function should be evaluated: x = {E, phi}, fPar = {twokBT, Delta(T), a, Ec, phic}
+ * \param tag not used
  */
-int TNonMonDWave1GapIntegralCuhre::Integrand(const int *ndim, const double x[],
-                      const int *ncomp, double f[], void *userdata) // x = {E, phi}, fPar = {twokBT, Delta(T),a, Ec, phic}
+double TNonMonDWave1GapIntegralCuhre::FuncAtX(const double *x, const int tag) const
 {
   double deltasq(TMath::Power(fPar[1]*(fPar[2]*TMath::Cos(2.0*x[1]*fPar[4])+(1.0-fPar[2])*TMath::Cos(6.0*x[1]*fPar[4])),2.0));
-  f[0] = 1.0/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[3]*fPar[3]+deltasq)/fPar[0]),2.0);
-  return 0;
+  return 1.0/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[3]*fPar[3]+deltasq)/fPar[0]),2.0);
 }
 
-//-----------------------------------------------------------------------------
-
-std::vector<double> TNonMonDWave2GapIntegralCuhre::fPar;
-
 //-----------------------------------------------------------------------------
 /**
- * <p>Integrate the function using the Cuhre interface
- *
- * <p><b>return:</b>
- * - value of the integral
+ * <p>Constructor
  */
-double TNonMonDWave2GapIntegralCuhre::IntegrateFunc()
+TNonMonDWave2GapIntegralCuhre::TNonMonDWave2GapIntegralCuhre() : TCubaIntegrator(2)
 {
-  const unsigned int NCOMP(1);
-  const unsigned int NVEC(1);
-  const double EPSREL (1e-4);
-  const double EPSABS (1e-6);
-  const unsigned int VERBOSE (0);
-  const unsigned int LAST (4);
-  const unsigned int MINEVAL (100);
-  const unsigned int MAXEVAL (1000000);
-
-  const unsigned int KEY (13);
-
-  int nregions, neval, fail;
-  double integral[NCOMP], error[NCOMP], prob[NCOMP];
-
-  Cuhre(fNDim, NCOMP, Integrand, USERDATA, NVEC,
-    EPSREL, EPSABS, VERBOSE | LAST, MINEVAL, MAXEVAL,
-    KEY, STATEFILE, SPIN,
-    &nregions, &neval, &fail, integral, error, prob);
-
-  return integral[0];
+  SetAccuracy(1e-4, 1e-6, 100, 1000000);
 }
 
 //-----------------------------------------------------------------------------
@@ -652,19 +412,14 @@ double TNonMonDWave2GapIntegralCuhre::IntegrateFunc()
  * <p>Calculate the function value for the use with Cuhre---actual implementation of the function
  *
  * <p><b>return:</b>
- * - 0
+ * - function value
  *
- * \param ndim number of dimensions of the integral (2 here)
- * \param x point where the function should be evaluated
- * \param ncomp number of components of the integrand (1 here)
- * \param f function value
- * \param userdata additional user parameters (required by the interface, NULL here)
+ * \param x point where the function should be evaluated: x = {E, phi}, fPar = {twokBT, Delta(T), a, Ec, phic}
+ * \param tag not used
  */
-int TNonMonDWave2GapIntegralCuhre::Integrand(const int *ndim, const double x[],
-                      const int *ncomp, double f[], void *userdata) // x = {E, phi}, fPar = {twokBT, Delta(T),a, Ec, phic}
+double TNonMonDWave2GapIntegralCuhre::FuncAtX(const double *x, const int tag) const
 {
   double deltasq(4.0*fPar[2]/27.0*TMath::Power(fPar[1]*TMath::Cos(2.0*x[1]*fPar[4]), 2.0) \
     / TMath::Power(1.0 + fPar[2]*TMath::Cos(2.0*x[1]*fPar[4])*TMath::Cos(2.0*x[1]*fPar[4]), 3.0));
-  f[0] = 1.0/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[3]*fPar[3]+deltasq)/fPar[0]),2.0);
-  return 0;
+  return 1.0/TMath::Power(TMath::CosH(TMath::Sqrt(x[0]*x[0]*fPar[3]*fPar[3]+deltasq)/fPar[0]),2.0);
 }
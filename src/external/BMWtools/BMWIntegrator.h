@@ -96,6 +96,94 @@ inline double T2Integrator::IntegrateFunc(double x1, double x2, const std::vecto
   return value;
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * <p>Base class for running (cumulative) 1D integrals F(x) = int_x0^x f(x') dx'.
+ *    F is calculated once on a uniform grid (3-point Gauss-Legendre per panel) and afterwards
+ *    evaluated by cubic Hermite interpolation using F and F' = f on the grid points.
+ *    This is meant for integrals whose upper boundary is the time, i.e. which are needed for
+ *    a whole time grid for a given set of parameters.
+ *    The function which should be integrated has to be implemented in a derived class.
+ *    Note: GetIntegral is const and can therefore be called in parallel once IntegrateFunc has been called.
+ */
+class TCumulativeIntegrator {
+  public:
+    TCumulativeIntegrator() : fX0(0.0), fDx(1.0) {} ///< default constructor
+    virtual ~TCumulativeIntegrator() {} ///< default destructor
+    virtual double FuncAtX(double, const std::vector<double> &par) const = 0;
+    virtual void IntegrateFunc(double, double, double, const std::vector<double> &par);
+    double GetIntegral(double) const;
+    double GetXmin() const { return fX0; } ///< lower boundary of the integration
+    double GetXmax() const { return fF.empty() ? fX0 : fX0 + fDx*static_cast<double>(fF.size()-1); } ///< largest x for which F(x) is available
+
+  private:
+    double fX0; ///< lower boundary of the integration
+    double fDx; ///< grid spacing
+    std::vector<double> fF; ///< F(x_i) on the grid points
+    std::vector<double> fFx; ///< f(x_i) on the grid points
+};
+
+//-----------------------------------------------------------------------------
+/**
+ * <p>Calculate the running integral on the grid x_i = x1 + i dx' with dx' <= dx such that the grid ends at x2.
+ *
+ * \param x1 lower boundary
+ * \param x2 upper boundary
+ * \param dx maximal grid spacing
+ * \param par additional parameters for the integration
+ */
+inline void TCumulativeIntegrator::IntegrateFunc(double x1, double x2, double dx, const std::vector<double> &par)
+{
+  const double xi(sqrt(0.6)), w0(8.0/9.0), w1(5.0/9.0);
+
+  unsigned int n(1);
+  if ((x2 > x1) && (dx > 0.0))
+    n = static_cast<unsigned int>(ceil((x2-x1)/dx));
+  if (n == 0)
+    n = 1;
+
+  fX0 = x1;
+  fDx = (x2-x1)/static_cast<double>(n);
+  fF.resize(n+1);
+  fFx.resize(n+1);
+
+  double xm, hh(0.5*fDx);
+  fF[0] = 0.0;
+  fFx[0] = FuncAtX(fX0, par);
+  for (unsigned int i(0); i<n; ++i) {
+    xm = fX0 + (static_cast<double>(i)+0.5)*fDx;
+    fF[i+1] = fF[i] + hh*(w0*FuncAtX(xm, par) + w1*(FuncAtX(xm-hh*xi, par) + FuncAtX(xm+hh*xi, par)));
+    fFx[i+1] = FuncAtX(fX0 + static_cast<double>(i+1)*fDx, par);
+  }
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * <p>Get the running integral F(x) = int_x1^x f(x') dx', where x1 is the lower boundary given to IntegrateFunc.
+ *
+ * <p><b>return:</b>
+ * - value of the integral, where x is clamped to [GetXmin(), GetXmax()]
+ *
+ * \param x upper boundary
+ */
+inline double TCumulativeIntegrator::GetIntegral(double x) const
+{
+  if (fF.size() < 2)
+    return 0.0;
+
+  double u((x-fX0)/fDx);
+  if (u <= 0.0)
+    return 0.0;
+  unsigned int i(static_cast<unsigned int>(u));
+  if (i >= fF.size()-1)
+    return fF.back();
+  u -= static_cast<double>(i);
+
+  // cubic Hermite interpolation
+  double u2(u*u), u3(u2*u);
+  return (2.0*u3-3.0*u2+1.0)*fF[i] + (u3-2.0*u2+u)*fDx*fFx[i] + (3.0*u2-2.0*u3)*fF[i+1] + (u3-u2)*fDx*fFx[i+1];
+}
+
 //-----------------------------------------------------------------------------
 /**
  * <p>Base class for 1D integrations using the GNU Scientific Library integrator.
@@ -250,42 +338,73 @@ inline double TMCIntegrator::IntegrateFunc(size_t dim, double *x1, double *x2)
 
 //-----------------------------------------------------------------------------
 /**
- * <p>Two-dimensional integrator class for the efficient calculation of the superfluid density within the semi-classical model
- *    assuming a cylindrical Fermi surface and a point p symmetry of the superconducting order parameter.
- *    The integration uses the Cuhre algorithm of the Cuba library.
+ * <p>Base class for multidimensional integrations using the Cuba library (Cuhre, Divonne or Suave).
+ *    The parameters of the integrand belong to the instance and are handed to Cuba as user data---no static
+ *    state is involved. Hence, different instances can integrate concurrently, e.g. one per thread.
+ *    Cuba requests the integrand in batches of points (nvec > 1). Batches of at least GetParallelBatchSize() points
+ *    are evaluated by several threads, unless the integration itself already runs in a parallel region.
+ *    Cuba's own (fork based) parallelization is switched off in favour of this.
+ *    The function which should be integrated has to be implemented in a derived class.
  */
-class TPointPWaveGapIntegralCuhre {
+class TCubaIntegrator {
   public:
-    TPointPWaveGapIntegralCuhre() : fNDim(2) {}
-    ~TPointPWaveGapIntegralCuhre() { fPar.clear(); }
+    enum EAlgorithm {kCuhre, kDivonne, kSuave};
+
+    TCubaIntegrator(const unsigned int ndim, const EAlgorithm algorithm = kCuhre);
+    virtual ~TCubaIntegrator() { fPar.clear(); }
     void SetParameters(const std::vector<double> &par) { fPar=par; }
-    static int Integrand_aa(const int*, const double[], const int*, double[], void*);
-    static int Integrand_cc(const int*, const double[], const int*, double[], void*);
-    double IntegrateFunc(int tag);
+    void SetAccuracy(const double epsrel, const double epsabs, const int mineval, const int maxeval);
+    double IntegrateFunc(const int tag = 0) const;
+
+    static void SetParallelBatchSize(const int n) { fParallelBatchSize = n; }
+    static int GetParallelBatchSize() { return fParallelBatchSize; } ///< smallest batch of integrand evaluations which is split among threads
 
   protected:
-    static std::vector<double> fPar; ///< parameters of the integrand
+    virtual double FuncAtX(const double *x, const int tag) const = 0;
+
+    std::vector<double> fPar; ///< parameters of the integrand
     unsigned int fNDim; ///< dimension of the integral
+
+  private:
+    static int Integrand(const int *ndim, const double x[], const int *ncomp, double f[], void *userdata, const int *nvec, const int *core);
+
+    EAlgorithm fAlgorithm; ///< Cuba algorithm used for the integration
+    double fEpsRel; ///< requested relative accuracy
+    double fEpsAbs; ///< requested absolute accuracy
+    int fMinEval; ///< minimum number of integrand evaluations
+    int fMaxEval; ///< maximum number of integrand evaluations
+
+    static int fParallelBatchSize; ///< smallest batch of integrand evaluations which is split among threads
+};
+
+//-----------------------------------------------------------------------------
+/**
+ * <p>Two-dimensional integrator class for the efficient calculation of the superfluid density within the semi-classical model
+ *    assuming a cylindrical Fermi surface and a point p symmetry of the superconducting order parameter.
+ *    The integration uses the Cuhre algorithm of the Cuba library. tag 0: aa (==bb) component, tag 1: cc component
+ */
+class TPointPWaveGapIntegralCuhre : public TCubaIntegrator {
+  public:
+    TPointPWaveGapIntegralCuhre();
+    ~TPointPWaveGapIntegralCuhre() {}
+
+  protected:
+    double FuncAtX(const double *x, const int tag) const;
 };
 
 //-----------------------------------------------------------------------------
 /**
  * <p>Two-dimensional integrator class for the efficient calculation of the superfluid density within the semi-classical model
  *    assuming a cylindrical Fermi surface and a line p symmetry of the superconducting order parameter.
- *    The integration uses the Cuhre algorithm of the Cuba library.
+ *    The integration uses the Cuhre algorithm of the Cuba library. tag 0: aa (==bb) component, tag 1: cc component
  */
-class TLinePWaveGapIntegralCuhre {
+class TLinePWaveGapIntegralCuhre : public TCubaIntegrator {
   public:
-    TLinePWaveGapIntegralCuhre() : fNDim(2) {}
-    ~TLinePWaveGapIntegralCuhre() { fPar.clear(); }
-    void SetParameters(const std::vector<double> &par) { fPar=par; }
-    static int Integrand_aa(const int*, const double[], const int*, double[], void*);
-    static int Integrand_cc(const int*, const double[], const int*, double[], void*);
-    double IntegrateFunc(int tag);
+    TLinePWaveGapIntegralCuhre();
+    ~TLinePWaveGapIntegralCuhre() {}
 
   protected:
-    static std::vector<double> fPar; ///< parameters of the integrand
-    unsigned int fNDim; ///< dimension of the integral
+    double FuncAtX(const double *x, const int tag) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -294,17 +413,13 @@ class TLinePWaveGapIntegralCuhre {
  *    assuming a cylindrical Fermi surface and a d_{x^2-y^2} symmetry of the superconducting order parameter.
  *    The integration uses the Cuhre algorithm of the Cuba library.
  */
-class TDWaveGapIntegralCuhre {
+class TDWaveGapIntegralCuhre : public TCubaIntegrator {
   public:
-    TDWaveGapIntegralCuhre() : fNDim(2) {}
-    ~TDWaveGapIntegralCuhre() { fPar.clear(); }
-    void SetParameters(const std::vector<double> &par) { fPar=par; }
-    static int Integrand(const int*, const double[], const int*, double[], void*);
-    double IntegrateFunc();
+    TDWaveGapIntegralCuhre();
+    ~TDWaveGapIntegralCuhre() {}
 
   protected:
-    static std::vector<double> fPar; ///< parameters of the integrand
-    unsigned int fNDim; ///< dimension of the integral
+    double FuncAtX(const double *x, const int tag) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -314,17 +429,13 @@ class TDWaveGapIntegralCuhre {
  *    superconducting order parameter (effectively: d_{x^2-y^2} with shifted nodes and a-b-anisotropy).
  *    The integration uses the Cuhre algorithm of the Cuba library.
  */
-class TCosSqDWaveGapIntegralCuhre {
+class TCosSqDWaveGapIntegralCuhre : public TCubaIntegrator {
   public:
-    TCosSqDWaveGapIntegralCuhre() : fNDim(2) {}
-    ~TCosSqDWaveGapIntegralCuhre() { fPar.clear(); }
-    void SetParameters(const std::vector<double> &par) { fPar=par; }
-    static int Integrand(const int*, const double[], const int*, double[], void*);
-    double IntegrateFunc();
+    TCosSqDWaveGapIntegralCuhre();
+    ~TCosSqDWaveGapIntegralCuhre() {}
 
   protected:
-    static std::vector<double> fPar; ///< parameters of the integrand
-    unsigned int fNDim; ///< dimension of the integral
+    double FuncAtX(const double *x, const int tag) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -334,17 +445,13 @@ class TCosSqDWaveGapIntegralCuhre {
  *    superconducting order parameter (effectively: d_{x^2-y^2} with shifted nodes and a-b-anisotropy).
  *    The integration uses the Cuhre algorithm of the Cuba library.
  */
-class TSinSqDWaveGapIntegralCuhre {
+class TSinSqDWaveGapIntegralCuhre : public TCubaIntegrator {
   public:
-    TSinSqDWaveGapIntegralCuhre() : fNDim(2) {}
-    ~TSinSqDWaveGapIntegralCuhre() { fPar.clear(); }
-    void SetParameters(const std::vector<double> &par) { fPar=par; }
-    static int Integrand(const int*, const double[], const int*, double[], void*);
-    double IntegrateFunc();
+    TSinSqDWaveGapIntegralCuhre();
+    ~TSinSqDWaveGapIntegralCuhre() {}
 
   protected:
-    static std::vector<double> fPar; ///< parameters of the integrand
-    unsigned int fNDim; ///< dimension of the integral
+    double FuncAtX(const double *x, const int tag) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -353,17 +460,13 @@ class TSinSqDWaveGapIntegralCuhre {
  *    assuming a cylindrical Fermi surface and an "anisotropic s-wave" symmetry of the superconducting order parameter.
  *    The integration uses the Cuhre algorithm of the Cuba library.
  */
-class TAnSWaveGapIntegralCuhre {
+class TAnSWaveGapIntegralCuhre : public TCubaIntegrator {
   public:
-    TAnSWaveGapIntegralCuhre() : fNDim(2) {}
-    ~TAnSWaveGapIntegralCuhre() { fPar.clear(); }
-    void SetParameters(const std::vector<double> &par) { fPar=par; }
-    static int Integrand(const int*, const double[], const int*, double[], void*);
-    double IntegrateFunc();
+    TAnSWaveGapIntegralCuhre(const EAlgorithm algorithm = kCuhre);
+    ~TAnSWaveGapIntegralCuhre() {}
 
   protected:
-    static std::vector<double> fPar; ///< parameters of the integrand
-    unsigned int fNDim; ///< dimension of the integral
+    double FuncAtX(const double *x, const int tag) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -372,17 +475,10 @@ class TAnSWaveGapIntegralCuhre {
  *    assuming a cylindrical Fermi surface and an "anisotropic s-wave" symmetry of the superconducting order parameter.
  *    The integration uses the Divonne algorithm of the Cuba library.
  */
-class TAnSWaveGapIntegralDivonne {
+class TAnSWaveGapIntegralDivonne : public TAnSWaveGapIntegralCuhre {
   public:
-    TAnSWaveGapIntegralDivonne() : fNDim(2) {}
-    ~TAnSWaveGapIntegralDivonne() { fPar.clear(); }
-    void SetParameters(const std::vector<double> &par) { fPar=par; }
-    static int Integrand(const int*, const double[], const int*, double[], void*);
-    double IntegrateFunc();
-
-  protected:
-    static std::vector<double> fPar; ///< parameters of the integrand
-    unsigned int fNDim; ///< dimension of the integral
+    TAnSWaveGapIntegralDivonne();
+    ~TAnSWaveGapIntegralDivonne() {}
 };
 
 //-----------------------------------------------------------------------------
@@ -391,17 +487,10 @@ class TAnSWaveGapIntegralDivonne {
  *    assuming a cylindrical Fermi surface and an "anisotropic s-wave" symmetry of the superconducting order parameter.
  *    The integration uses the Suave algorithm of the Cuba library.
  */
-class TAnSWaveGapIntegralSuave {
+class TAnSWaveGapIntegralSuave : public TAnSWaveGapIntegralCuhre {
   public:
-    TAnSWaveGapIntegralSuave() : fNDim(2) {}
-    ~TAnSWaveGapIntegralSuave() { fPar.clear(); }
-    void SetParameters(const std::vector<double> &par) { fPar=par; }
-    static int Integrand(const int*, const double[], const int*, double[], void*);
-    double IntegrateFunc();
-
-  protected:
-    static std::vector<double> fPar; ///< parameters of the integrand
-    unsigned int fNDim; ///< dimension of the integral
+    TAnSWaveGapIntegralSuave();
+    ~TAnSWaveGapIntegralSuave() {}
 };
 
 //-----------------------------------------------------------------------------
@@ -410,17 +499,13 @@ class TAnSWaveGapIntegralSuave {
  *    assuming a cylindrical Fermi surface and an "non-monotonic d-wave" symmetry of the superconducting order parameter.
  *    The integration uses the Cuhre algorithm of the Cuba library.
  */
-class TNonMonDWave1GapIntegralCuhre {
+class TNonMonDWave1GapIntegralCuhre : public TCubaIntegrator {
   public:
-    TNonMonDWave1GapIntegralCuhre() : fNDim(2) {}
-    ~TNonMonDWave1GapIntegralCuhre() { fPar.clear(); }
-    void SetParameters(const std::vector<double> &par) { fPar=par; }
-    static int Integrand(const int*, const double[], const int*, double[], void*);
-    double IntegrateFunc();
+    TNonMonDWave1GapIntegralCuhre();
+    ~TNonMonDWave1GapIntegralCuhre() {}
 
   protected:
-    static std::vector<double> fPar; ///< parameters of the integrand
-    unsigned int fNDim; ///< dimension of the integral
+    double FuncAtX(const double *x, const int tag) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -429,17 +514,13 @@ class TNonMonDWave1GapIntegralCuhre {
  *    assuming a cylindrical Fermi surface and an "non-monotonic d-wave" symmetry of the superconducting order parameter.
  *    The integration uses the Cuhre algorithm of the Cuba library.
  */
-class TNonMonDWave2GapIntegralCuhre {
+class TNonMonDWave2GapIntegralCuhre : public TCubaIntegrator {
   public:
-    TNonMonDWave2GapIntegralCuhre() : fNDim(2) {}
-    ~TNonMonDWave2GapIntegralCuhre() { fPar.clear(); }
-    void SetParameters(const std::vector<double> &par) { fPar=par; }
-    static int Integrand(const int*, const double[], const int*, double[], void*);
-    double IntegrateFunc();
+    TNonMonDWave2GapIntegralCuhre();
+    ~TNonMonDWave2GapIntegralCuhre() {}
 
   protected:
-    static std::vector<double> fPar; ///< parameters of the integrand
-    unsigned int fNDim; ///< dimension of the integral
+    double FuncAtX(const double *x, const int tag) const;
 };
 
 //-----------------------------------------------------------------------------
@@ -46,7 +46,7 @@ ClassImpQ(BMWStartupHandler)
  * <p>Constructor. Check if the BMW_startup.xml file is found in the local directory
  */
 BMWStartupHandler::BMWStartupHandler() :
- fDebug(false), fLEM(false), fVortex(false), fLF(false), fDataPath(""), fDeltat(0.), fDeltaB(0.), fWisdomFile(""), fWisdomFileFloat(""), fNSteps(0), fGridSteps(0), fDeltatLF(0.), fNStepsLF(0)
+ fDebug(false), fLEM(false), fVortex(false), fLF(false), fDataPath(""), fDeltat(0.), fDeltaB(0.), fWisdomFile(""), fWisdomFileFloat(""), fNSteps(0), fGridSteps(0), fNGLTolerance(0.), fNGLWarmStartCache(-1), fNGLWarmStartMaxDiff(0.), fNGLStatistics(false), fDeltatLF(0.), fNStepsLF(0), fLFTableGssKT(""), fLFTableExpKT("")
 {
 }
 
@@ -125,10 +125,22 @@ void BMWStartupHandler::OnStartElement(const char *str, const TList *attributes)
     fKey = eNSteps;
   } else if (!strcmp(str, "N_VortexGrid")) {
     fKey = eGridSteps;
+  } else if (!strcmp(str, "NGL_tolerance")) {
+    fKey = eNGLTolerance;
+  } else if (!strcmp(str, "NGL_warm_start_cache")) {
+    fKey = eNGLWarmStartCache;
+  } else if (!strcmp(str, "NGL_warm_start_max_diff")) {
+    fKey = eNGLWarmStartMaxDiff;
+  } else if (!strcmp(str, "NGL_statistics")) {
+    fKey = eNGLStatistics;
   } else if (!strcmp(str, "delta_t_LF")) {
     fKey = eDeltatLF;
   } else if (!strcmp(str, "N_LF")) {
     fKey = eNStepsLF;
+  } else if (!strcmp(str, "table_GssKT_LF")) {
+    fKey = eLFTableGssKT;
+  } else if (!strcmp(str, "table_ExpKT_LF")) {
+    fKey = eLFTableExpKT;
   }
 }
 
@@ -208,6 +220,24 @@ void BMWStartupHandler::OnCharacters(const char *str)
       // convert str to int and assign it to the GridSteps-member
       fGridSteps = atoi(str);
       break;
+    case eNGLTolerance:
+      // convert str to double and assign it to the NGL convergence tolerance
+      fNGLTolerance = atof(str);
+      break;
+    case eNGLWarmStartCache:
+      // convert str to int and assign it to the NGL warm-start cache size
+      fNGLWarmStartCache = atoi(str);
+      break;
+    case eNGLWarmStartMaxDiff:
+      // convert str to double and assign it to the maximum relative parameter difference of NGL warm starts
+      fNGLWarmStartMaxDiff = atof(str);
+      break;
+    case eNGLStatistics:
+      if (!strcmp(str, "1"))
+        fNGLStatistics = true;
+      else
+        fNGLStatistics = false;
+      break;
     case eDeltatLF:
       // convert str to double and assign it to the deltatLF-member
       fDeltatLF = atof(str);
@@ -216,6 +246,14 @@ void BMWStartupHandler::OnCharacters(const char *str)
       // convert str to int and assign it to the NStepsLF-member
       fNStepsLF = atoi(str);
       break;
+    case eLFTableGssKT:
+      // set the table of the dynamic Gaussian LF Kubo-Toyabe function
+      fLFTableGssKT = str;
+      break;
+    case eLFTableExpKT:
+      // set the table of the dynamic exponential LF Kubo-Toyabe function
+      fLFTableExpKT = str;
+      break;
     default:
       break;
   }
@@ -443,6 +481,18 @@ void BMWStartupHandler::CheckLists()
       if(fDebug)
         std::cout << fGridSteps << std::endl;
     }
+
+    // the NGL settings are optional, if not given the defaults of the field calculators are used
+    if(fDebug) {
+      std::cout << std::endl << "BMWStartupHandler::CheckLists: NGL vortex lattice settings ..." << std::endl;
+      if (fNGLTolerance > 0.0)
+        std::cout << "convergence tolerance: " << fNGLTolerance << std::endl;
+      if (fNGLWarmStartCache >= 0)
+        std::cout << "warm-start cache size: " << fNGLWarmStartCache << std::endl;
+      if (fNGLWarmStartMaxDiff > 0.0)
+        std::cout << "warm-start max. rel. parameter difference: " << fNGLWarmStartMaxDiff << std::endl;
+      std::cout << "statistics: " << fNGLStatistics << std::endl;
+    }
   }
 }
 
@@ -46,7 +46,9 @@
  * - paths to FFTW3 wisdom files (double and float)
  * - number of steps for one-dimensional theory functions (where needed)
  * - number of steps for two-dimensional grids when calculating spatial field distributions in vortex lattices
+ * - convergence tolerance, warm-start settings, and statistics flag of the iterative (NGL) vortex lattice calculations
  * - time resolutions and lengths of Laplace transforms used in the calculation of LF-relaxation functions
+ * - paths to precomputed tables of the dynamic LF-relaxation functions
  * - flag for debugging the information contained in the startup file
  */
 class BMWStartupHandler : public TQObject {
@@ -75,14 +77,21 @@ class BMWStartupHandler : public TQObject {
     virtual const std::string GetWisdomFileFloat() const { return fWisdomFileFloat; } ///< returns the path to the FFTW3 float-wisdom file
     virtual const unsigned int GetNSteps() const { return fNSteps; } ///< returns the number of steps in one-dimensional theory functions
     virtual const unsigned int GetGridSteps() const { return fGridSteps; } ///< returns the number of steps in each direction when calculating two-dimensional spatial field distributions
+    virtual const double GetNGLTolerance() const { return fNGLTolerance; } ///< returns the relative convergence tolerance of the NGL vortex lattice iterations (0 = not given)
+    virtual const int GetNGLWarmStartCache() const { return fNGLWarmStartCache; } ///< returns the number of converged NGL states kept for warm starts (-1 = not given, 0 = no warm starts)
+    virtual const double GetNGLWarmStartMaxDiff() const { return fNGLWarmStartMaxDiff; } ///< returns the maximum relative parameter difference for an NGL warm start (0 = not given)
+    virtual const bool GetNGLStatistics() const { return fNGLStatistics; } ///< true = report the iterations and solve time of every NGL vortex lattice calculation
     virtual const double GetDeltatLF() const { return fDeltatLF; } ///< returns the time resolution of P(t) when using Laplace transforms for the calculation of LF-relaxation functions
     virtual const unsigned int GetNStepsLF() const { return fNStepsLF; } ///< returns the length of the Laplace transforms for the calculation of LF-relaxation functions
+    virtual const std::string GetLFTableGssKT() const { return fLFTableGssKT; } ///< returns the path to the table of the dynamic Gaussian LF Kubo-Toyabe function
+    virtual const std::string GetLFTableExpKT() const { return fLFTableExpKT; } ///< returns the path to the table of the dynamic exponential LF Kubo-Toyabe function
     virtual const bool GetDebug() const { return fDebug; } ///< true = debug the xml-entries
 
   private:
     enum EKeyWords {eEmpty, eComment, eDebug, eLEM, eVortex, eLF, eDataPath, eEnergyLabel, \
                     eEnergy, eEnergyList, eDeltat, eDeltaB, eWisdomFile, eWisdomFileFloat, \
-                    eNSteps, eGridSteps, eDeltatLF, eNStepsLF};
+                    eNSteps, eGridSteps, eNGLTolerance, eNGLWarmStartCache, eNGLWarmStartMaxDiff, \
+                    eNGLStatistics, eDeltatLF, eNStepsLF, eLFTableGssKT, eLFTableExpKT};
 
     EKeyWords       fKey; ///< xml filter key
 
@@ -100,8 +109,14 @@ class BMWStartupHandler : public TQObject {
     std::string     fWisdomFileFloat; ///< FFTW3 float-wisdom file
     unsigned int    fNSteps;          ///< number of steps in one-dimensional theory functions
     unsigned int    fGridSteps;       ///< number of steps in each direction when calculating two-dimensional spatial field distributions
+    double          fNGLTolerance;    ///< relative convergence tolerance of the NGL vortex lattice iterations
+    int             fNGLWarmStartCache;   ///< number of converged NGL states kept for warm starts
+    double          fNGLWarmStartMaxDiff; ///< maximum relative parameter difference for which a cached NGL state is used
+    bool            fNGLStatistics;   ///< flag for reporting the NGL iterations and solve times
     double          fDeltatLF;        ///< time resolution of P(t) when using Laplace transforms for the calculation of LF-relaxation functions
     unsigned int    fNStepsLF;        ///< length of the Laplace transforms for the calculation of LF-relaxation functions
+    std::string     fLFTableGssKT;    ///< table of the dynamic Gaussian LF Kubo-Toyabe function
+    std::string     fLFTableExpKT;    ///< table of the dynamic exponential LF Kubo-Toyabe function
 
   ClassDef(BMWStartupHandler, 1)
 };
@@ -117,28 +117,26 @@ TTrimSPData::TTrimSPData(const string &path, map<double, string> &energies, bool
 
   fOrigDataNZ = fDataNZ;
 
-  fEnergyIter = fEnergy.end();
 }
 
 // Method checking if an implantation profile is available for a given energy
 // The behavior is the similar to the find-algorithm but more robust (tiny deviations in the energies are allowed).
-// If the given energy is found the methods sets the internal energy iterator to the element of the energy vector.
-// If it is not found the energy iterator will point to the end() of the energy vector.
-
-void TTrimSPData::FindEnergy(double e) const {
-  for(fEnergyIter = fEnergy.begin(); fEnergyIter != fEnergy.end(); ++fEnergyIter) {
-    if(fabs(*fEnergyIter - e) < 0.05)
-      return;
-  }
-  return;
+// Since the energies are stored in ascending order, a binary search is used.
+// If the given energy is found the method returns its index which can be used as a handle for the NofZ-methods,
+// otherwise -1 is returned. No internal state is changed, i.e. the method can be called concurrently.
+
+int TTrimSPData::FindEnergy(double e) const {
+  vector<double>::const_iterator iter(lower_bound(fEnergy.begin(), fEnergy.end(), e - 0.05));
+  if ((iter != fEnergy.end()) && (fabs(*iter - e) < 0.05))
+    return static_cast<int>(iter - fEnergy.begin());
+  return -1;
 }
 
 void TTrimSPData::UseHighResolution(double e) {
 
-  FindEnergy(e);
+  int i(FindEnergy(e));
 
-  if(fEnergyIter != fEnergy.end()) {
-    unsigned int i(fEnergyIter - fEnergy.begin());
+  if(i >= 0) {
     vector<double> vecZ;
     vector<double> vecNZ;
     for(double zz(1.); zz<2100.; zz+=1.) {
@@ -163,10 +161,9 @@ void TTrimSPData::UseHighResolution(double e) {
 
 vector<double> TTrimSPData::DataZ(double e) const {
 
-  FindEnergy(e);
+  int i(FindEnergy(e));
 
-  if(fEnergyIter != fEnergy.end()) {
-    unsigned int i(fEnergyIter - fEnergy.begin());
+  if(i >= 0) {
     return fDataZ[i];
   }
   // default
@@ -181,10 +178,9 @@ vector<double> TTrimSPData::DataZ(double e) const {
 
 vector<double> TTrimSPData::DataNZ(double e) const {
 
-  FindEnergy(e);
+  int i(FindEnergy(e));
 
-  if(fEnergyIter != fEnergy.end()) {
-    unsigned int i(fEnergyIter - fEnergy.begin());
+  if(i >= 0) {
     return fDataNZ[i];
   }
   // default
@@ -199,10 +195,9 @@ vector<double> TTrimSPData::DataNZ(double e) const {
 
 vector<double> TTrimSPData::OrigDataNZ(double e) const {
 
-  FindEnergy(e);
+  int i(FindEnergy(e));
 
-  if(fEnergyIter != fEnergy.end()) {
-    unsigned int i(fEnergyIter - fEnergy.begin());
+  if(i >= 0) {
     return fOrigDataNZ[i];
   }
   // default
@@ -213,10 +208,9 @@ vector<double> TTrimSPData::OrigDataNZ(double e) const {
 
 double TTrimSPData::DataDZ(double e) const {
 
-  FindEnergy(e);
+  int i(FindEnergy(e));
 
-  if(fEnergyIter != fEnergy.end()) {
-    unsigned int i(fEnergyIter - fEnergy.begin());
+  if(i >= 0) {
     return fDZ[i];
   }
   // default
@@ -237,10 +231,9 @@ double TTrimSPData::LayerFraction(double e, unsigned int layno, const vector<dou
     return 0.0;
   }
 
-  FindEnergy(e);
+  int i(FindEnergy(e));
 
-  if (fEnergyIter != fEnergy.end()) {
-    unsigned int i(fEnergyIter - fEnergy.begin());
+  if (i >= 0) {
     // Because we do not know if the implantation profile is normalized or not, do not care about this and calculate the fraction from the beginning
     // Total "number of muons"
     double totalNumber(0.0);
@@ -308,15 +301,15 @@ void TTrimSPData::WeightLayers(double e, const vector<double>& interface, const
     }
   }
 
-  FindEnergy(e);
+  int eIdx(FindEnergy(e));
 
   // If all weights are equal to one, use the original n(z) vector
   for(unsigned int i(0); i<weight.size(); i++) {
     if(weight[i]-1.0)
       break;
     if(i == weight.size() - 1) {
-      if(fEnergyIter != fEnergy.end()) {
-        unsigned int j(fEnergyIter - fEnergy.begin());
+      if(eIdx >= 0) {
+        unsigned int j(eIdx);
         fDataNZ[j] = fOrigDataNZ[j];
         fIsNormalized[j] = false;
         return;
@@ -324,8 +317,8 @@ void TTrimSPData::WeightLayers(double e, const vector<double>& interface, const
     }
   }
 
-  if(fEnergyIter != fEnergy.end()) {
-    unsigned int i(fEnergyIter - fEnergy.begin());
+  if(eIdx >= 0) {
+    unsigned int i(eIdx);
     unsigned int k(0);
     for(unsigned int j(0); j<fDataZ[i].size(); j++) {
       if(k<interface.size()) {
@@ -353,32 +346,49 @@ void TTrimSPData::WeightLayers(double e, const vector<double>& interface, const
 
 double TTrimSPData::GetNofZ(double zz, double e) const {
 
-  vector<double> z, nz;
-
-  FindEnergy(e);
+  int i(FindEnergy(e));
 
-  if(fEnergyIter != fEnergy.end()) {
-    unsigned int i(fEnergyIter - fEnergy.begin());
-    z = fDataZ[i];
-    nz = fDataNZ[i];
-  } else {
+  if(i < 0) {
       cout << "TTrimSPData::GetNofZ: No implantation profile available for the specified energy " << e << " keV... Quitting!" << endl;
       exit(-1);
   }
 
-  if(zz < 0)
+  return NofZ(i, zz);
+}
+
+//---------------------
+// Method returning n(z) for given z[nm] and the energy index (as obtained from FindEnergy)
+// The z-grid of the profiles is (nearly) uniform, therefore the grid point is first estimated from the
+// step size and then only corrected locally, i.e. the lookup is O(1) and does not copy any data.
+//---------------------
+
+double TTrimSPData::NofZ(int eIdx, double zz) const {
+
+  if((eIdx < 0) || (eIdx >= static_cast<int>(fDataZ.size())))
     return 0.0;
 
-  bool found = false;
-  unsigned int i;
-  for (i=0; i<z.size(); i++) {
-    if (z[i]/10.0 >= zz) {
-     found = true;
-     break;
-    }
+  if(!(zz >= 0.0)) // negative (or invalid) z
+    return 0.0;
+
+  const vector<double> &z(fDataZ[eIdx]);
+  const vector<double> &nz(fDataNZ[eIdx]);
+  const int n(z.size());
+
+  if(!n)
+    return 0.0;
+
+  // first index i with z[i] >= zz
+  int i(0);
+  if(fDZ[eIdx] > 0.0) {
+    double guess(ceil((10.0*zz - z[0])/fDZ[eIdx]));
+    i = (guess < 0.0) ? 0 : ((guess > n) ? n : static_cast<int>(guess));
   }
+  while ((i > 0) && (z[i-1]/10.0 >= zz))
+    --i;
+  while ((i < n) && (z[i]/10.0 < zz))
+    ++i;
 
-  if (!found)
+  if (i == n)
     return 0.0;
 
   if (i == 0)
@@ -393,10 +403,9 @@ double TTrimSPData::GetNofZ(double zz, double e) const {
 
 void TTrimSPData::Normalize(double e) const {
 
-  FindEnergy(e);
+  int i(FindEnergy(e));
 
-  if(fEnergyIter != fEnergy.end()) {
-    unsigned int i(fEnergyIter - fEnergy.begin());
+  if(i >= 0) {
     double nZsum = 0.0;
     for (unsigned int j(0); j<fDataZ[i].size(); j++)
       nZsum += fDataNZ[i][j];
@@ -418,10 +427,9 @@ void TTrimSPData::Normalize(double e) const {
 //---------------------
 
 bool TTrimSPData::IsNormalized(double e) const {
-  FindEnergy(e);
+  int i(FindEnergy(e));
 
-  if(fEnergyIter != fEnergy.end()) {
-    unsigned int i(fEnergyIter - fEnergy.begin());
+  if(i >= 0) {
     return fIsNormalized[i];
   }
 
@@ -434,10 +442,9 @@ bool TTrimSPData::IsNormalized(double e) const {
 //---------------------
 
 double TTrimSPData::MeanRange(double e) const {
-  FindEnergy(e);
+  int i(FindEnergy(e));
 
-  if(fEnergyIter != fEnergy.end()) {
-    unsigned int i(fEnergyIter - fEnergy.begin());
+  if(i >= 0) {
     if (!fIsNormalized[i])
       Normalize(e);
     double mean(0.0);
@@ -458,10 +465,9 @@ double TTrimSPData::MeanRange(double e) const {
 
 double TTrimSPData::PeakRange(double e) const {
 
-  FindEnergy(e);
+  int i(FindEnergy(e));
 
-  if(fEnergyIter != fEnergy.end()) {
-    unsigned int i(fEnergyIter - fEnergy.begin());
+  if(i >= 0) {
 
     vector<double>::const_iterator nziter;
     nziter = max_element(fDataNZ[i].begin(),fDataNZ[i].end());
@@ -490,10 +496,9 @@ void TTrimSPData::ConvolveGss(double w, double e) const {
   vector<double> z, nz, gss;
   double nn;
 
-  FindEnergy(e);
+  int i(FindEnergy(e));
 
-  if(fEnergyIter != fEnergy.end()) {
-    unsigned int i(fEnergyIter - fEnergy.begin());
+  if(i >= 0) {
     z = fDataZ[i];
     nz = fDataNZ[i];
 
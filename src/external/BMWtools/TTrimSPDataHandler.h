@@ -61,7 +61,9 @@ public:
   void SetOriginal() {fOrigDataNZ = fDataNZ;}
   void WeightLayers(double, const vector<double>&, const vector<double>&) const;
   double LayerFraction(double, unsigned int, const vector<double>&) const;
+  int FindEnergy(double) const;
   double GetNofZ(double, double) const;
+  double NofZ(int, double) const;
   void Normalize(double) const;
   bool IsNormalized(double) const;
   void ConvolveGss(double, double) const;
@@ -69,15 +71,12 @@ public:
   double PeakRange(double) const;
 
 private:
-  void FindEnergy(double) const;
-
   vector<double> fEnergy; ///< vector holding all available muon energies
   vector<double> fDZ; ///< vector holding the spatial resolution of the TRIM.SP output for all energies
   vector< vector<double> > fDataZ; ///< discrete points in real space for which n(z) has been calculated for all energies
   mutable vector< vector<double> > fDataNZ; ///< n(z) for all energies
   vector< vector<double> > fOrigDataNZ; ///< original (unmodified) implantation profiles for all energies as read in from rge-files
   mutable vector<bool> fIsNormalized; ///< tag indicating if the implantation profiles are normalized (for each energy separately)
-  mutable vector<double>::const_iterator fEnergyIter; ///< iterator traversing the vector of available energies
 };
 
 #endif // _TTrimSPDataHandler_H_
@@ -56,7 +56,7 @@ PDepthProfileGlobal::PDepthProfileGlobal() {
   }
 
   // calculate cumulative frequency distribution of all the rge-files
-  PRgeDataList rgeData = fRgeHandler->GetRgeData();
+  const PRgeDataList &rgeData = fRgeHandler->GetRgeData();
   fCfd.resize(fRgeHandler->GetNoOfRgeDataSets());
   for (unsigned int i=0; i<fCfd.size(); i++) {
     fCfd[i].energy = rgeData[i].energy;
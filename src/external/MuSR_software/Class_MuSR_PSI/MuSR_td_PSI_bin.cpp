@@ -75,10 +75,11 @@ MuSR_td_PSI_bin::MuSR_td_PSI_bin()
  *    - 6 if reading data failed
  *
  *  The parameter of the method is a const char * representing the name of the file to 
- *  be opened.
+ *  be opened. If headerOnly is true, only the header is read and the histogram
+ *  payload is not touched (see ReadBin() and ReadMdu()).
  */
 
- int MuSR_td_PSI_bin::Read(const char * fileName)
+ int MuSR_td_PSI_bin::Read(const char * fileName, bool headerOnly)
  {
    std::ifstream  file_name;
 
@@ -126,14 +127,14 @@ MuSR_td_PSI_bin::MuSR_td_PSI_bin()
    // file may either be PSI binary format
    if (strncmp(fFormatId,"1N",2) == 0)
    {
-     return ReadBin(fileName);  // then read it as PSI bin
+     return ReadBin(fileName, headerOnly);  // then read it as PSI bin
    }
 
    // or MDU format (pTA, TDC or 32 channel TDC)
    else if ((strncmp(fFormatId,"M3",2) == 0) ||(strncmp(fFormatId,"T4",2) == 0) ||
             (strncmp(fFormatId,"T5",2) == 0))
    {
-     return ReadMdu(fileName); // else read it as MDU
+     return ReadMdu(fileName, headerOnly); // else read it as MDU
    }
    else
    {
@@ -239,10 +240,12 @@ typedef                 float   Float32;
  *    - 6 if reading data failed
  *
  *  The parameter of the method is a const char * representing the name of the file to 
- *  be opened.
+ *  be opened. If headerOnly is true, reading stops after the 1024 byte header,
+ *  i.e. the histogram records are never read. In this case ReadingOK() stays
+ *  false (no histogram access possible), whereas all header getters are valid.
  */
 
-int MuSR_td_PSI_bin::ReadBin(const char * fileName)
+int MuSR_td_PSI_bin::ReadBin(const char * fileName, bool headerOnly)
 {
   std::ifstream  file_name;
   Int16     *dum_Int16;
@@ -477,6 +480,13 @@ int MuSR_td_PSI_bin::ReadBin(const char * fileName)
     return 5;                                // ERROR number of histograms < 1
   }
 
+  if (headerOnly) {                          // stop before touching the histogram records
+    file_name.close();
+    fHeaderOnly = true;
+    fReadStatus = "SUCCESS (header only)";
+    return 0;
+  }
+
   // allocate histograms
   fHisto.resize(fNumberHisto);
 
@@ -999,10 +1009,12 @@ typedef struct _pTATDC32StatisticRec {
  *    - 6 if reading data failed
  *
  *  The parameter of the method is a const char * representing the name of the 
- *  file to be opened.
+ *  file to be opened. If headerOnly is true, reading stops after the settings
+ *  and statistics records, i.e. before the histogram records. The number of
+ *  events per histogram is therefore not available in this case.
  */
 
-int MuSR_td_PSI_bin::ReadMdu(const char * fileName)
+int MuSR_td_PSI_bin::ReadMdu(const char * fileName, bool headerOnly)
 {
   std::ifstream  file_name;
   int       i, j;
@@ -1470,6 +1482,13 @@ int MuSR_td_PSI_bin::ReadMdu(const char * fileName)
 
   fDefaultBinning = resolutionfactor;
 
+  if (headerOnly) {                          // stop before touching the histogram records
+    file_name.close();
+    fHeaderOnly = true;
+    fReadStatus = "SUCCESS (header only)";
+    return 0;
+  }
+
   // allocate histograms
   fHisto.resize(int(fNumberHisto));
 
@@ -4301,6 +4320,7 @@ std::vector<double> MuSR_td_PSI_bin::GetHistoArray(int histo_num, int binning)
    // init other member variables
    fFilename  = "?";
    fReadingOk = false;
+   fHeaderOnly = false;
    fWritingOk = false;
    fConsistencyOk = false;
    fReadStatus = "";
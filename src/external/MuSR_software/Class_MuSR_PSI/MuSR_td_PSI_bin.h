@@ -61,6 +61,7 @@ class MuSR_td_PSI_bin {
     std::string fWriteStatus;
     std::string fConsistencyStatus;
     bool     fReadingOk;
+    bool     fHeaderOnly;
     bool     fWritingOk;
     bool     fConsistencyOk;
 
@@ -122,15 +123,16 @@ class MuSR_td_PSI_bin {
 
   public:
 
-    int            Read(const char* fileName);      // generic read
+    int            Read(const char* fileName, bool headerOnly=false);    // generic read
     int            Write(const char *fileName);     // generic write
 
-    int            ReadBin(const char* fileName);   // read MuSR PSI bin format
+    int            ReadBin(const char* fileName, bool headerOnly=false); // read MuSR PSI bin format
     int            WriteBin(const char *fileName);  // write MuSR PSI bin format
-    int            ReadMdu(const char* fileName);   // read MuSR mdu format
+    int            ReadMdu(const char* fileName, bool headerOnly=false); // read MuSR mdu format
     int            WriteMdu(const char* fileName);  // write MuSR mdu format
 
     bool           ReadingOK()     const;
+    bool           HeaderOnly()    const { return fHeaderOnly; }
     bool           WritingOK()     const;
     bool           CheckDataConsistency(int tag=0); // tag: 0=reasonable, 1=strict
     std::string    ReadStatus()    const;
@@ -28,6 +28,8 @@
  ***************************************************************************/
 
 #include <cstdlib>
+#include <cstring>
+#include <cctype>
 #include <ctime>
 #include <iostream>
 #include <iomanip>
@@ -41,6 +43,45 @@
 #include <TString.h>
 #include <TList.h>
 #include <TMap.h>
+#include <TNamed.h>
+#include <TBase64.h>
+
+//--------------------------------------------------------------------------
+// helper functions for the binary header representation
+//--------------------------------------------------------------------------
+namespace {
+  template <class T> void MrhWriteBinary(std::string &buffer, const T value)
+  {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void MrhWriteBinary(std::string &buffer, const TString &str)
+  {
+    MrhWriteBinary(buffer, static_cast<UInt_t>(str.Length()));
+    buffer.append(str.Data(), str.Length());
+  }
+
+  template <class T> bool MrhReadBinary(const char *&ptr, const char *end, T &value)
+  {
+    if (ptr + sizeof(T) > end)
+      return false;
+    memcpy(&value, ptr, sizeof(T));
+    ptr += sizeof(T);
+    return true;
+  }
+
+  bool MrhReadBinary(const char *&ptr, const char *end, TString &str)
+  {
+    UInt_t len=0;
+    if (!MrhReadBinary(ptr, end, len))
+      return false;
+    if (ptr + len > end)
+      return false;
+    str = TString(ptr, len);
+    ptr += len;
+    return true;
+  }
+}
 
 ClassImp(TMusrRunPhysicalQuantity)
 
@@ -213,7 +254,7 @@ ClassImp(TMusrRunHeader)
   *
   * \param quiet if set to true, warnings will be omited. Default is false.
   */
-TMusrRunHeader::TMusrRunHeader(bool quiet) : TObject(), fQuiet(quiet)
+TMusrRunHeader::TMusrRunHeader(bool quiet) : TObject(), fQuiet(quiet), fWriteBinaryHeader(false)
 {
   Init();
 }
@@ -230,6 +271,7 @@ TMusrRunHeader::TMusrRunHeader(bool quiet) : TObject(), fQuiet(quiet)
 TMusrRunHeader::TMusrRunHeader(const char *fileName, bool quiet) : TObject()
 {
   fQuiet = quiet;
+  fWriteBinaryHeader = false;
   Init(TString(fileName));
 }
 
@@ -322,6 +364,7 @@ void TMusrRunHeader::CleanUp()
   fDoubleVectorObj.clear();
 
   fPathNameOrder.clear();
+  fPathIndex.clear();
 }
 
 //--------------------------------------------------------------------------
@@ -391,6 +434,21 @@ Bool_t TMusrRunHeader::FillFolder(TFolder *folder)
     }
   }
 
+  // add the compact binary representation of the header if requested
+  if (fWriteBinaryHeader) {
+    std::string buffer;
+    if (!Serialize(buffer)) {
+      std::cerr << std::endl << ">> TMusrRunHeader::FillFolder(): **ERROR** couldn't serialize the header!!" << std::endl;
+      return false;
+    }
+    TString encoded = TBase64::Encode(buffer.data(), buffer.size());
+    TNamed *binHeader = dynamic_cast<TNamed*>(folder->FindObject(MRH_BINARY_HEADER_NAME));
+    if (binHeader)
+      binHeader->SetTitle(encoded);
+    else
+      folder->Add(new TNamed(MRH_BINARY_HEADER_NAME, encoded.Data()));
+  }
+
   return true;
 }
 
@@ -407,51 +465,30 @@ Bool_t TMusrRunHeader::FillFolder(TFolder *folder)
 TString TMusrRunHeader::GetTypeOfPath(TString pathName)
 {
   TString type("undef");
+  Int_t idx;
 
   // find pathName
-  for (Int_t i=0; i<fStringObj.size(); i++) {
-    if (fStringObj[i].GetPathName() == pathName) {
-      type = fStringObj[i].GetType();
-      return type;
-    }
-  }
-  for (Int_t i=0; i<fIntObj.size(); i++) {
-    if (fIntObj[i].GetPathName() == pathName) {
-      type = fIntObj[i].GetType();
-      return type;
-    }
-  }
-  for (Int_t i=0; i<fDoubleObj.size(); i++) {
-    if (fDoubleObj[i].GetPathName() == pathName) {
-      type = fDoubleObj[i].GetType();
-      return type;
-    }
-  }
-  for (Int_t i=0; i<fMusrRunPhysQuantityObj.size(); i++) {
-    if (fMusrRunPhysQuantityObj[i].GetPathName() == pathName) {
-      type = fMusrRunPhysQuantityObj[i].GetType();
-      return type;
-    }
-  }
-  for (Int_t i=0; i<fStringVectorObj.size(); i++) {
-    if (fStringVectorObj[i].GetPathName() == pathName) {
-      type = fStringVectorObj[i].GetType();
-      return type;
-    }
-  }
-  for (Int_t i=0; i<fIntVectorObj.size(); i++) {
-    if (fIntVectorObj[i].GetPathName() == pathName) {
-      type = fIntVectorObj[i].GetType();
-      return type;
-    }
-  }
-  for (Int_t i=0; i<fDoubleVectorObj.size(); i++) {
-    if (fDoubleVectorObj[i].GetPathName() == pathName) {
-      type = fDoubleVectorObj[i].GetType();
-      return type;
-    }
-  }
-
+  idx = FindIndex(MRH_TSTRING, pathName.Data());
+  if ((idx != -1) && (fStringObj[idx].GetPathName() == pathName))
+    return fStringObj[idx].GetType();
+  idx = FindIndex(MRH_INT, pathName.Data());
+  if ((idx != -1) && (fIntObj[idx].GetPathName() == pathName))
+    return fIntObj[idx].GetType();
+  idx = FindIndex(MRH_DOUBLE, pathName.Data());
+  if ((idx != -1) && (fDoubleObj[idx].GetPathName() == pathName))
+    return fDoubleObj[idx].GetType();
+  idx = FindIndex(MRH_TMUSR_RUN_PHYSICAL_QUANTITY, pathName.Data());
+  if ((idx != -1) && (fMusrRunPhysQuantityObj[idx].GetPathName() == pathName))
+    return fMusrRunPhysQuantityObj[idx].GetType();
+  idx = FindIndex(MRH_TSTRING_VECTOR, pathName.Data());
+  if ((idx != -1) && (fStringVectorObj[idx].GetPathName() == pathName))
+    return fStringVectorObj[idx].GetType();
+  idx = FindIndex(MRH_INT_VECTOR, pathName.Data());
+  if ((idx != -1) && (fIntVectorObj[idx].GetPathName() == pathName))
+    return fIntVectorObj[idx].GetType();
+  idx = FindIndex(MRH_DOUBLE_VECTOR, pathName.Data());
+  if ((idx != -1) && (fDoubleVectorObj[idx].GetPathName() == pathName))
+    return fDoubleVectorObj[idx].GetType();
 
   return type;
 }
@@ -466,15 +503,14 @@ TString TMusrRunHeader::GetTypeOfPath(TString pathName)
  * \param value TString return value
  * \param ok flag telling if the TString value was found
  */
-void TMusrRunHeader::Get(TString pathName, TString &value, Bool_t &ok)
+void TMusrRunHeader::Get(const char *pathName, TString &value, Bool_t &ok)
 {
-  ok = false;
+  Int_t idx = FindIndex(MRH_TSTRING, pathName);
 
-  for (UInt_t i=0; i<fStringObj.size(); i++) {
-    if (fStringObj[i].GetPathName() == pathName) {
-      value = fStringObj[i].GetValue();
-      ok = true;
-    }
+  ok = false;
+  if ((idx != -1) && (fStringObj[idx].GetPathName() == pathName)) {
+    value = fStringObj[idx].GetValue();
+    ok = true;
   }
 }
 
@@ -488,15 +524,14 @@ void TMusrRunHeader::Get(TString pathName, TString &value, Bool_t &ok)
  * \param value Int_t return value
  * \param ok flag telling if the Int_t value was found
  */
-void TMusrRunHeader::Get(TString pathName, Int_t &value, Bool_t &ok)
+void TMusrRunHeader::Get(const char *pathName, Int_t &value, Bool_t &ok)
 {
-  ok = false;
+  Int_t idx = FindIndex(MRH_INT, pathName);
 
-  for (UInt_t i=0; i<fIntObj.size(); i++) {
-    if (fIntObj[i].GetPathName() == pathName) {
-      value = fIntObj[i].GetValue();
-      ok = true;
-    }
+  ok = false;
+  if ((idx != -1) && (fIntObj[idx].GetPathName() == pathName)) {
+    value = fIntObj[idx].GetValue();
+    ok = true;
   }
 }
 
@@ -510,15 +545,14 @@ void TMusrRunHeader::Get(TString pathName, Int_t &value, Bool_t &ok)
  * \param value Double_t return value
  * \param ok flag telling if the Double_t value was found
  */
-void TMusrRunHeader::Get(TString pathName, Double_t &value, Bool_t &ok)
+void TMusrRunHeader::Get(const char *pathName, Double_t &value, Bool_t &ok)
 {
-  ok = false;
+  Int_t idx = FindIndex(MRH_DOUBLE, pathName);
 
-  for (UInt_t i=0; i<fDoubleObj.size(); i++) {
-    if (fDoubleObj[i].GetPathName() == pathName) {
-      value = fDoubleObj[i].GetValue();
-      ok = true;
-    }
+  ok = false;
+  if ((idx != -1) && (fDoubleObj[idx].GetPathName() == pathName)) {
+    value = fDoubleObj[idx].GetValue();
+    ok = true;
   }
 }
 
@@ -532,15 +566,14 @@ void TMusrRunHeader::Get(TString pathName, Double_t &value, Bool_t &ok)
  * \param value TMusrRunPhysicalQuantity return value
  * \param ok flag telling if the TMusrRunPhysicalQuantity value was found
  */
-void TMusrRunHeader::Get(TString pathName, TMusrRunPhysicalQuantity &value, Bool_t &ok)
+void TMusrRunHeader::Get(const char *pathName, TMusrRunPhysicalQuantity &value, Bool_t &ok)
 {
-  ok = false;
+  Int_t idx = FindIndex(MRH_TMUSR_RUN_PHYSICAL_QUANTITY, pathName);
 
-  for (UInt_t i=0; i<fMusrRunPhysQuantityObj.size(); i++) {
-    if (fMusrRunPhysQuantityObj[i].GetPathName() == pathName) {
-      value = fMusrRunPhysQuantityObj[i].GetValue();
-      ok = true;
-    }
+  ok = false;
+  if ((idx != -1) && (fMusrRunPhysQuantityObj[idx].GetPathName() == pathName)) {
+    value = fMusrRunPhysQuantityObj[idx].GetValue();
+    ok = true;
   }
 }
 
@@ -554,15 +587,14 @@ void TMusrRunHeader::Get(TString pathName, TMusrRunPhysicalQuantity &value, Bool
  * \param value TStringVector return value
  * \param ok flag telling if the TStringVector value was found
  */
-void TMusrRunHeader::Get(TString pathName, TStringVector &value, Bool_t &ok)
+void TMusrRunHeader::Get(const char *pathName, TStringVector &value, Bool_t &ok)
 {
-  ok = false;
+  Int_t idx = FindIndex(MRH_TSTRING_VECTOR, pathName);
 
-  for (UInt_t i=0; i<fStringVectorObj.size(); i++) {
-    if (fStringVectorObj[i].GetPathName() == pathName) {
-      value = fStringVectorObj[i].GetValue();
-      ok = true;
-    }
+  ok = false;
+  if ((idx != -1) && (fStringVectorObj[idx].GetPathName() == pathName)) {
+    value = fStringVectorObj[idx].GetValue();
+    ok = true;
   }
 }
 
@@ -576,15 +608,14 @@ void TMusrRunHeader::Get(TString pathName, TStringVector &value, Bool_t &ok)
  * \param value TIntVector return value
  * \param ok flag telling if the TIntVector value was found
  */
-void TMusrRunHeader::Get(TString pathName, TIntVector &value, Bool_t &ok)
+void TMusrRunHeader::Get(const char *pathName, TIntVector &value, Bool_t &ok)
 {
-  ok = false;
+  Int_t idx = FindIndex(MRH_INT_VECTOR, pathName);
 
-  for (UInt_t i=0; i<fIntVectorObj.size(); i++) {
-    if (fIntVectorObj[i].GetPathName() == pathName) {
-      value = fIntVectorObj[i].GetValue();
-      ok = true;
-    }
+  ok = false;
+  if ((idx != -1) && (fIntVectorObj[idx].GetPathName() == pathName)) {
+    value = fIntVectorObj[idx].GetValue();
+    ok = true;
   }
 }
 
@@ -598,15 +629,14 @@ void TMusrRunHeader::Get(TString pathName, TIntVector &value, Bool_t &ok)
  * \param value TDoubleVector return value
  * \param ok flag telling if the TDoubleVector value was found
  */
-void TMusrRunHeader::Get(TString pathName, TDoubleVector &value, Bool_t &ok)
+void TMusrRunHeader::Get(const char *pathName, TDoubleVector &value, Bool_t &ok)
 {
-  ok = false;
+  Int_t idx = FindIndex(MRH_DOUBLE_VECTOR, pathName);
 
-  for (UInt_t i=0; i<fDoubleVectorObj.size(); i++) {
-    if (fDoubleVectorObj[i].GetPathName() == pathName) {
-      value = fDoubleVectorObj[i].GetValue();
-      ok = true;
-    }
+  ok = false;
+  if ((idx != -1) && (fDoubleVectorObj[idx].GetPathName() == pathName)) {
+    value = fDoubleVectorObj[idx].GetValue();
+    ok = true;
   }
 }
 
@@ -622,21 +652,16 @@ void TMusrRunHeader::Get(TString pathName, TDoubleVector &value, Bool_t &ok)
 void TMusrRunHeader::Set(TString pathName, TString value)
 {
   // check if pathName is already set, if not add it as a new entry, otherwise replace it
-  UInt_t i=0;
-  for (i=0; i<fStringObj.size(); i++) {
-    if (!fStringObj[i].GetPathName().CompareTo(pathName, TString::kIgnoreCase)) {
-      if (!fQuiet)
-        std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
-      fStringObj[i].SetType("TString");
-      fStringObj[i].SetValue(value);
-      break;
-    }
-  }
-
-  // if not found in the previous loop, it is a new object
-  if (i == fStringObj.size()) {
+  Int_t idx = FindIndex(MRH_TSTRING, pathName.Data());
+  if (idx != -1) {
+    if (!fQuiet)
+      std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
+    fStringObj[idx].SetType("TString");
+    fStringObj[idx].SetValue(value);
+  } else { // new object
     // feed object
     TMusrRunObject<TString> obj(pathName, "TString", value);
+    fPathIndex[GetIndexKey(MRH_TSTRING, pathName.Data())] = fStringObj.size();
     fStringObj.push_back(obj);
 
     // feed path-name to keep track of the order
@@ -656,21 +681,16 @@ void TMusrRunHeader::Set(TString pathName, TString value)
 void TMusrRunHeader::Set(TString pathName, Int_t value)
 {
   // check if pathName is already set, if not add it as a new entry, otherwise replace it
-  UInt_t i=0;
-  for (i=0; i<fIntObj.size(); i++) {
-    if (!fIntObj[i].GetPathName().CompareTo(pathName, TString::kIgnoreCase)) {
-      if (!fQuiet)
-        std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
-      fIntObj[i].SetType("Int_t");
-      fIntObj[i].SetValue(value);
-      break;
-    }
-  }
-
-  // if not found in the previous loop, it is a new object
-  if (i == fIntObj.size()) {
+  Int_t idx = FindIndex(MRH_INT, pathName.Data());
+  if (idx != -1) {
+    if (!fQuiet)
+      std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
+    fIntObj[idx].SetType("Int_t");
+    fIntObj[idx].SetValue(value);
+  } else { // new object
     // feed object
     TMusrRunObject<Int_t> obj(pathName, "Int_t", value);
+    fPathIndex[GetIndexKey(MRH_INT, pathName.Data())] = fIntObj.size();
     fIntObj.push_back(obj);
 
     // feed path-name to keep track of the order
@@ -690,21 +710,16 @@ void TMusrRunHeader::Set(TString pathName, Int_t value)
 void TMusrRunHeader::Set(TString pathName, Double_t value)
 {
   // check if pathName is already set, if not add it as a new entry, otherwise replace it
-  UInt_t i=0;
-  for (i=0; i<fDoubleObj.size(); i++) {
-    if (!fDoubleObj[i].GetPathName().CompareTo(pathName, TString::kIgnoreCase)) {
-      if (!fQuiet)
-        std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
-      fDoubleObj[i].SetType("Double_t");
-      fDoubleObj[i].SetValue(value);
-      break;
-    }
-  }
-
-  // if not found in the previous loop, it is a new object
-  if (i == fDoubleObj.size()) {
+  Int_t idx = FindIndex(MRH_DOUBLE, pathName.Data());
+  if (idx != -1) {
+    if (!fQuiet)
+      std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
+    fDoubleObj[idx].SetType("Double_t");
+    fDoubleObj[idx].SetValue(value);
+  } else { // new object
     // feed object
     TMusrRunObject<Double_t> obj(pathName, "Double_t", value);
+    fPathIndex[GetIndexKey(MRH_DOUBLE, pathName.Data())] = fDoubleObj.size();
     fDoubleObj.push_back(obj);
 
     // feed path-name to keep track of the order
@@ -724,21 +739,16 @@ void TMusrRunHeader::Set(TString pathName, Double_t value)
 void TMusrRunHeader::Set(TString pathName, TMusrRunPhysicalQuantity value)
 {
   // check if pathName is already set, if not add it as a new entry, otherwise replace it
-  UInt_t i=0;
-  for (i=0; i<fMusrRunPhysQuantityObj.size(); i++) {
-    if (!fMusrRunPhysQuantityObj[i].GetPathName().CompareTo(pathName, TString::kIgnoreCase)) {
-      if (!fQuiet)
-        std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
-      fMusrRunPhysQuantityObj[i].SetType("TMusrRunHeader");
-      fMusrRunPhysQuantityObj[i].SetValue(value);
-      break;
-    }
-  }
-
-  // if not found in the previous loop, it is a new object
-  if (i == fMusrRunPhysQuantityObj.size()) {
+  Int_t idx = FindIndex(MRH_TMUSR_RUN_PHYSICAL_QUANTITY, pathName.Data());
+  if (idx != -1) {
+    if (!fQuiet)
+      std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
+    fMusrRunPhysQuantityObj[idx].SetType("TMusrRunHeader");
+    fMusrRunPhysQuantityObj[idx].SetValue(value);
+  } else { // new object
     // feed object
     TMusrRunObject<TMusrRunPhysicalQuantity> obj(pathName, "TMusrRunPhysicalQuantity", value);
+    fPathIndex[GetIndexKey(MRH_TMUSR_RUN_PHYSICAL_QUANTITY, pathName.Data())] = fMusrRunPhysQuantityObj.size();
     fMusrRunPhysQuantityObj.push_back(obj);
 
     // feed path-name to keep track of the order
@@ -758,21 +768,16 @@ void TMusrRunHeader::Set(TString pathName, TMusrRunPhysicalQuantity value)
 void TMusrRunHeader::Set(TString pathName, TStringVector value)
 {
   // check if pathName is already set, if not add it as a new entry, otherwise replace it
-  UInt_t i=0;
-  for (i=0; i<fStringVectorObj.size(); i++) {
-    if (!fStringVectorObj[i].GetPathName().CompareTo(pathName, TString::kIgnoreCase)) {
-      if (!fQuiet)
-        std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
-      fStringVectorObj[i].SetType("TStringVector");
-      fStringVectorObj[i].SetValue(value);
-      break;
-    }
-  }
-
-  // if not found in the previous loop, it is a new object
-  if (i == fStringVectorObj.size()) {
+  Int_t idx = FindIndex(MRH_TSTRING_VECTOR, pathName.Data());
+  if (idx != -1) {
+    if (!fQuiet)
+      std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
+    fStringVectorObj[idx].SetType("TStringVector");
+    fStringVectorObj[idx].SetValue(value);
+  } else { // new object
     // feed object
     TMusrRunObject<TStringVector> obj(pathName, "TStringVector", value);
+    fPathIndex[GetIndexKey(MRH_TSTRING_VECTOR, pathName.Data())] = fStringVectorObj.size();
     fStringVectorObj.push_back(obj);
 
     // feed path-name to keep track of the order
@@ -792,21 +797,16 @@ void TMusrRunHeader::Set(TString pathName, TStringVector value)
 void TMusrRunHeader::Set(TString pathName, TIntVector value)
 {
   // check if pathName is already set, if not add it as a new entry, otherwise replace it
-  UInt_t i=0;
-  for (i=0; i<fIntVectorObj.size(); i++) {
-    if (!fIntVectorObj[i].GetPathName().CompareTo(pathName, TString::kIgnoreCase)) {
-      if (!fQuiet)
-        std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
-      fIntVectorObj[i].SetType("TIntVector");
-      fIntVectorObj[i].SetValue(value);
-      break;
-    }
-  }
-
-  // if not found in the previous loop, it is a new object
-  if (i == fIntVectorObj.size()) {
+  Int_t idx = FindIndex(MRH_INT_VECTOR, pathName.Data());
+  if (idx != -1) {
+    if (!fQuiet)
+      std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
+    fIntVectorObj[idx].SetType("TIntVector");
+    fIntVectorObj[idx].SetValue(value);
+  } else { // new object
     // feed object
     TMusrRunObject<TIntVector> obj(pathName, "TIntVector", value);
+    fPathIndex[GetIndexKey(MRH_INT_VECTOR, pathName.Data())] = fIntVectorObj.size();
     fIntVectorObj.push_back(obj);
 
     // feed path-name to keep track of the order
@@ -826,21 +826,16 @@ void TMusrRunHeader::Set(TString pathName, TIntVector value)
 void TMusrRunHeader::Set(TString pathName, TDoubleVector value)
 {
   // check if pathName is already set, if not add it as a new entry, otherwise replace it
-  UInt_t i=0;
-  for (i=0; i<fDoubleVectorObj.size(); i++) {
-    if (!fDoubleVectorObj[i].GetPathName().CompareTo(pathName, TString::kIgnoreCase)) {
-      if (!fQuiet)
-        std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
-      fDoubleVectorObj[i].SetType("TDoubleVector");
-      fDoubleVectorObj[i].SetValue(value);
-      break;
-    }
-  }
-
-  // if not found in the previous loop, it is a new object
-  if (i == fDoubleVectorObj.size()) {
+  Int_t idx = FindIndex(MRH_DOUBLE_VECTOR, pathName.Data());
+  if (idx != -1) {
+    if (!fQuiet)
+      std::cerr << std::endl << ">> **WARNING** " << pathName.Data() << " already exists, will replace it." << std::endl;
+    fDoubleVectorObj[idx].SetType("TDoubleVector");
+    fDoubleVectorObj[idx].SetValue(value);
+  } else { // new object
     // feed object
     TMusrRunObject<TDoubleVector> obj(pathName, "TDoubleVector", value);
+    fPathIndex[GetIndexKey(MRH_DOUBLE_VECTOR, pathName.Data())] = fDoubleVectorObj.size();
     fDoubleVectorObj.push_back(obj);
 
     // feed path-name to keep track of the order
@@ -861,12 +856,27 @@ void TMusrRunHeader::Set(TString pathName, TDoubleVector value)
 Bool_t TMusrRunHeader::ExtractAll(TFolder *folder)
 {
   TIter next(folder->GetListOfFolders());
+  TObject* obj;
   TObjArray* entry;
 
   // clean up all internal structures - just in case this is called multiple times
   CleanUp();
 
-  while ((entry = dynamic_cast<TObjArray*>(next()))) {
+  // if present, use the binary header which avoids parsing all the header strings
+  TNamed *binHeader = dynamic_cast<TNamed*>(folder->FindObject(MRH_BINARY_HEADER_NAME));
+  if (binHeader) {
+    TString decoded = TBase64::Decode(binHeader->GetTitle());
+    if (Deserialize(decoded.Data(), decoded.Length()))
+      return true;
+    if (!fQuiet)
+      std::cerr << std::endl << ">> TMusrRunHeader::ExtractAll(): **WARNING** corrupted binary header, will use the string header instead." << std::endl;
+    CleanUp();
+  }
+
+  while ((obj = next())) {
+    entry = dynamic_cast<TObjArray*>(obj);
+    if (entry == nullptr) // e.g. the binary header
+      continue;
     ExtractHeaderInformation(entry, entry->GetName());
   }
   return true;
@@ -1089,6 +1099,191 @@ Bool_t TMusrRunHeader::ExtractHeaderInformation(TObjArray *headerInfo, TString r
   return true;
 }
 
+//--------------------------------------------------------------------------
+// Serialize (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Writes the header into a compact binary buffer. The entries are written
+ * in the order they were created (fPathNameOrder), each given as
+ * <type><path-name><value>, where strings are stored as <length><characters>,
+ * and vectors as <number of elements><elements>. The buffer starts with a magic
+ * number and a version tag. Numbers are stored in native byte order.
+ *
+ * <p><b>return:</b> true on success, false otherwise.
+ *
+ * \param buffer on return, holds the binary representation of the header
+ */
+Bool_t TMusrRunHeader::Serialize(std::string &buffer)
+{
+  Int_t idx;
+
+  buffer.clear();
+  MrhWriteBinary(buffer, static_cast<UInt_t>(MRH_BINARY_HEADER_MAGIC));
+  MrhWriteBinary(buffer, static_cast<UInt_t>(MRH_BINARY_HEADER_VERSION));
+  MrhWriteBinary(buffer, static_cast<UInt_t>(fPathNameOrder.size()));
+
+  for (UInt_t i=0; i<fPathNameOrder.size(); i++) {
+    const char *pathName = fPathNameOrder[i].Data();
+    if ((idx = FindIndex(MRH_TSTRING, pathName)) != -1) {
+      MrhWriteBinary(buffer, static_cast<UChar_t>(MRH_TSTRING));
+      MrhWriteBinary(buffer, fPathNameOrder[i]);
+      MrhWriteBinary(buffer, fStringObj[idx].GetValue());
+    } else if ((idx = FindIndex(MRH_INT, pathName)) != -1) {
+      MrhWriteBinary(buffer, static_cast<UChar_t>(MRH_INT));
+      MrhWriteBinary(buffer, fPathNameOrder[i]);
+      MrhWriteBinary(buffer, fIntObj[idx].GetValue());
+    } else if ((idx = FindIndex(MRH_DOUBLE, pathName)) != -1) {
+      MrhWriteBinary(buffer, static_cast<UChar_t>(MRH_DOUBLE));
+      MrhWriteBinary(buffer, fPathNameOrder[i]);
+      MrhWriteBinary(buffer, fDoubleObj[idx].GetValue());
+    } else if ((idx = FindIndex(MRH_TMUSR_RUN_PHYSICAL_QUANTITY, pathName)) != -1) {
+      const TMusrRunPhysicalQuantity &prop = fMusrRunPhysQuantityObj[idx].GetValue();
+      MrhWriteBinary(buffer, static_cast<UChar_t>(MRH_TMUSR_RUN_PHYSICAL_QUANTITY));
+      MrhWriteBinary(buffer, fPathNameOrder[i]);
+      MrhWriteBinary(buffer, prop.GetLabel());
+      MrhWriteBinary(buffer, prop.GetDemand());
+      MrhWriteBinary(buffer, prop.GetValue());
+      MrhWriteBinary(buffer, prop.GetError());
+      MrhWriteBinary(buffer, prop.GetUnit());
+      MrhWriteBinary(buffer, prop.GetDescription());
+    } else if ((idx = FindIndex(MRH_TSTRING_VECTOR, pathName)) != -1) {
+      const TStringVector &svec = fStringVectorObj[idx].GetValue();
+      MrhWriteBinary(buffer, static_cast<UChar_t>(MRH_TSTRING_VECTOR));
+      MrhWriteBinary(buffer, fPathNameOrder[i]);
+      MrhWriteBinary(buffer, static_cast<UInt_t>(svec.size()));
+      for (UInt_t j=0; j<svec.size(); j++)
+        MrhWriteBinary(buffer, svec[j]);
+    } else if ((idx = FindIndex(MRH_INT_VECTOR, pathName)) != -1) {
+      const TIntVector &ivec = fIntVectorObj[idx].GetValue();
+      MrhWriteBinary(buffer, static_cast<UChar_t>(MRH_INT_VECTOR));
+      MrhWriteBinary(buffer, fPathNameOrder[i]);
+      MrhWriteBinary(buffer, static_cast<UInt_t>(ivec.size()));
+      for (UInt_t j=0; j<ivec.size(); j++)
+        MrhWriteBinary(buffer, ivec[j]);
+    } else if ((idx = FindIndex(MRH_DOUBLE_VECTOR, pathName)) != -1) {
+      const TDoubleVector &dvec = fDoubleVectorObj[idx].GetValue();
+      MrhWriteBinary(buffer, static_cast<UChar_t>(MRH_DOUBLE_VECTOR));
+      MrhWriteBinary(buffer, fPathNameOrder[i]);
+      MrhWriteBinary(buffer, static_cast<UInt_t>(dvec.size()));
+      for (UInt_t j=0; j<dvec.size(); j++)
+        MrhWriteBinary(buffer, dvec[j]);
+    } else {
+      std::cerr << std::endl << ">> TMusrRunHeader::Serialize(): **ERROR** couldn't find path-name '" << pathName << "'" << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+// Deserialize (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Feeds the header from a binary buffer as generated by Serialize().
+ * All present header information will be replaced.
+ *
+ * <p><b>return:</b> true on success, false otherwise.
+ *
+ * \param buffer binary header buffer
+ * \param size of the buffer in bytes
+ */
+Bool_t TMusrRunHeader::Deserialize(const char *buffer, const UInt_t size)
+{
+  const char *ptr = buffer;
+  const char *end = buffer + size;
+  UInt_t magic=0, version=0, noOfEntries=0, len=0;
+  UChar_t type=0;
+  TString pathName(""), str("");
+  Int_t ival;
+  Double_t dval;
+
+  if ((buffer == nullptr) || !MrhReadBinary(ptr, end, magic) || !MrhReadBinary(ptr, end, version) ||
+      !MrhReadBinary(ptr, end, noOfEntries))
+    return false;
+
+  if ((magic != MRH_BINARY_HEADER_MAGIC) || (version != MRH_BINARY_HEADER_VERSION))
+    return false;
+
+  CleanUp();
+
+  for (UInt_t i=0; i<noOfEntries; i++) {
+    if (!MrhReadBinary(ptr, end, type) || !MrhReadBinary(ptr, end, pathName))
+      return false;
+
+    switch (type) {
+    case MRH_TSTRING:
+      if (!MrhReadBinary(ptr, end, str))
+        return false;
+      Set(pathName, str);
+      break;
+    case MRH_INT:
+      if (!MrhReadBinary(ptr, end, ival))
+        return false;
+      Set(pathName, ival);
+      break;
+    case MRH_DOUBLE:
+      if (!MrhReadBinary(ptr, end, dval))
+        return false;
+      Set(pathName, dval);
+      break;
+    case MRH_TMUSR_RUN_PHYSICAL_QUANTITY:
+      {
+        TMusrRunPhysicalQuantity prop;
+        TString label(""), unit(""), description("");
+        Double_t demand, value, error;
+        if (!MrhReadBinary(ptr, end, label) || !MrhReadBinary(ptr, end, demand) ||
+            !MrhReadBinary(ptr, end, value) || !MrhReadBinary(ptr, end, error) ||
+            !MrhReadBinary(ptr, end, unit) || !MrhReadBinary(ptr, end, description))
+          return false;
+        prop.Set(label, demand, value, error, unit, description);
+        Set(pathName, prop);
+      }
+      break;
+    case MRH_TSTRING_VECTOR:
+      {
+        if (!MrhReadBinary(ptr, end, len) || (len > size)) // len > size: corrupted buffer
+          return false;
+        TStringVector svec(len);
+        for (UInt_t j=0; j<len; j++) {
+          if (!MrhReadBinary(ptr, end, svec[j]))
+            return false;
+        }
+        Set(pathName, svec);
+      }
+      break;
+    case MRH_INT_VECTOR:
+      {
+        if (!MrhReadBinary(ptr, end, len) || (len > size)) // len > size: corrupted buffer
+          return false;
+        TIntVector ivec(len);
+        for (UInt_t j=0; j<len; j++) {
+          if (!MrhReadBinary(ptr, end, ivec[j]))
+            return false;
+        }
+        Set(pathName, ivec);
+      }
+      break;
+    case MRH_DOUBLE_VECTOR:
+      {
+        if (!MrhReadBinary(ptr, end, len) || (len > size)) // len > size: corrupted buffer
+          return false;
+        TDoubleVector dvec(len);
+        for (UInt_t j=0; j<len; j++) {
+          if (!MrhReadBinary(ptr, end, dvec[j]))
+            return false;
+        }
+        Set(pathName, dvec);
+      }
+      break;
+    default:
+      return false;
+    }
+  }
+
+  return true;
+}
+
 //--------------------------------------------------------------------------
 // DumpHeader (public)
 //--------------------------------------------------------------------------
@@ -1710,6 +1905,49 @@ TObjString TMusrRunHeader::GetHeaderString(UInt_t idx)
   return tostr;
 }
 
+//--------------------------------------------------------------------------
+// GetIndexKey (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Generates the key for the path-name index, i.e. <type><lower case path-name>.
+ * Lower case is used since Set() treats path-names case insensitive.
+ *
+ * <p><b>return:</b> index key
+ *
+ * \param type of the header entry, e.g. MRH_INT
+ * \param pathName path/name within the header, e.g. RunInfo/Run Number
+ */
+std::string TMusrRunHeader::GetIndexKey(const Int_t type, const char *pathName) const
+{
+  std::string key(1, static_cast<char>('0'+type));
+  key.append(pathName);
+  for (UInt_t i=1; i<key.length(); i++)
+    key[i] = static_cast<char>(tolower(static_cast<unsigned char>(key[i])));
+
+  return key;
+}
+
+//--------------------------------------------------------------------------
+// FindIndex (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Looks up the path-name in the index. The comparison is case insensitive,
+ * i.e. the caller has to check for an exact match if needed.
+ *
+ * <p><b>return:</b> index in the typed object vector, or -1 if not found.
+ *
+ * \param type of the header entry, e.g. MRH_INT
+ * \param pathName path/name within the header, e.g. RunInfo/Run Number
+ */
+Int_t TMusrRunHeader::FindIndex(const Int_t type, const char *pathName) const
+{
+  auto it = fPathIndex.find(GetIndexKey(type, pathName));
+  if (it == fPathIndex.end())
+    return -1;
+
+  return static_cast<Int_t>(it->second);
+}
+
 //--------------------------------------------------------------------------
 // RemoveFirst (private)
 //--------------------------------------------------------------------------
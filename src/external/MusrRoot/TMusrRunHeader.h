@@ -31,6 +31,8 @@
 #define TMUSRRUNHEADER_H
 
 #include <vector>
+#include <string>
+#include <unordered_map>
 
 #include <TDatime.h>
 #include <TObject.h>
@@ -51,6 +53,10 @@
 #define MRH_INT_VECTOR                  5
 #define MRH_DOUBLE_VECTOR               6
 
+#define MRH_BINARY_HEADER_NAME  "BinaryHeader"
+#define MRH_BINARY_HEADER_MAGIC 0x4d524842 // 'MRHB'
+#define MRH_BINARY_HEADER_VERSION 1
+
 typedef std::vector<Int_t> TIntVector;
 typedef std::vector<Double_t> TDoubleVector;
 typedef std::vector<TString> TStringVector;
@@ -63,9 +69,9 @@ public:
   TMusrRunObject(TString pathName, TString type, T value) : TObject(), fPathName(pathName), fType(type), fValue(value) {}
   virtual ~TMusrRunObject() {}
 
-  virtual TString GetPathName() { return fPathName; }
-  virtual TString GetType() { return fType; }
-  virtual T GetValue() { return fValue; }
+  virtual const TString& GetPathName() const { return fPathName; }
+  virtual const TString& GetType() const { return fType; }
+  virtual const T& GetValue() const { return fValue; }
 
   virtual void SetPathName(TString pathName) { fPathName = pathName; }
   virtual void SetType(TString type) { fType = type; }
@@ -133,17 +139,29 @@ public:
   virtual Bool_t ExtractAll(TFolder *folder);
   virtual Bool_t ExtractHeaderInformation(TObjArray *headerInfo, TString path);
 
+  virtual Bool_t Serialize(std::string &buffer);
+  virtual Bool_t Deserialize(const char *buffer, const UInt_t size);
+
   virtual TString GetTypeOfPath(TString pathName);
 
-  virtual void Get(TString pathName, TString &value, Bool_t &ok);
-  virtual void Get(TString pathName, Int_t &value, Bool_t &ok);
-  virtual void Get(TString pathName, Double_t &value, Bool_t &ok);
-  virtual void Get(TString pathName, TMusrRunPhysicalQuantity &value, Bool_t &ok);
-  virtual void Get(TString pathName, TStringVector &value, Bool_t &ok);
-  virtual void Get(TString pathName, TIntVector &value, Bool_t &ok);
-  virtual void Get(TString pathName, TDoubleVector &value, Bool_t &ok);
+  virtual void Get(TString pathName, TString &value, Bool_t &ok) { Get(pathName.Data(), value, ok); }
+  virtual void Get(TString pathName, Int_t &value, Bool_t &ok) { Get(pathName.Data(), value, ok); }
+  virtual void Get(TString pathName, Double_t &value, Bool_t &ok) { Get(pathName.Data(), value, ok); }
+  virtual void Get(TString pathName, TMusrRunPhysicalQuantity &value, Bool_t &ok) { Get(pathName.Data(), value, ok); }
+  virtual void Get(TString pathName, TStringVector &value, Bool_t &ok) { Get(pathName.Data(), value, ok); }
+  virtual void Get(TString pathName, TIntVector &value, Bool_t &ok) { Get(pathName.Data(), value, ok); }
+  virtual void Get(TString pathName, TDoubleVector &value, Bool_t &ok) { Get(pathName.Data(), value, ok); }
+
+  virtual void Get(const char *pathName, TString &value, Bool_t &ok);
+  virtual void Get(const char *pathName, Int_t &value, Bool_t &ok);
+  virtual void Get(const char *pathName, Double_t &value, Bool_t &ok);
+  virtual void Get(const char *pathName, TMusrRunPhysicalQuantity &value, Bool_t &ok);
+  virtual void Get(const char *pathName, TStringVector &value, Bool_t &ok);
+  virtual void Get(const char *pathName, TIntVector &value, Bool_t &ok);
+  virtual void Get(const char *pathName, TDoubleVector &value, Bool_t &ok);
 
   virtual void SetFileName(TString fln) { fFileName = fln; }
+  virtual void SetWriteBinaryHeader(Bool_t flag) { fWriteBinaryHeader = flag; }
 
   virtual void Set(TString pathName, TString value);
   virtual void Set(TString pathName, Int_t value);
@@ -171,9 +189,15 @@ private:
 
   std::vector< TString > fPathNameOrder; ///< keeps the path-name as they were created in ordered to keep ordering
 
+  std::unordered_map<std::string, UInt_t> fPathIndex; //! <type><lower case path-name> -> index in the corresponding typed object vector
+  Bool_t fWriteBinaryHeader; //! if true, FillFolder() adds a compact binary copy of the header
+
   virtual void Init(TString str="n/a");
   virtual void CleanUp();
 
+  virtual std::string GetIndexKey(const Int_t type, const char *pathName) const;
+  virtual Int_t FindIndex(const Int_t type, const char *pathName) const;
+
   virtual UInt_t GetDecimalPlace(Double_t val);
   virtual UInt_t GetLeastSignificantDigit(Double_t val) const;
   virtual void SplitPathName(TString pathName, TString &path, TString &name);
@@ -35,11 +35,18 @@
 #include <TSAXParser.h>
 #include <TMath.h>
 
+#include "PFFTPlanManager.h"
 #include "PNL_PippardFitter.h"
 
 #define GAMMA_MU   0.0851615503527
 #define DEGREE2RAD 0.0174532925199
 
+// P(B) mode: time window (us) for which P(t) is taken from the Fourier transform,
+// frequency resolution as dOmega*tMax, and Fourier oversampling (Omega dt = 2pi/oversampling)
+#define PNL_POFB_TMAX         20.0
+#define PNL_POFB_EPS          0.05
+#define PNL_POFB_OVERSAMPLING 32
+
 ClassImp(PNL_PippardFitterGlobal)
 
 //--------------------------------------------------------------------------
@@ -82,6 +89,7 @@ PNL_PippardFitterGlobal::PNL_PippardFitterGlobal()
   }
 
   fFourierPoints = fStartupHandler->GetFourierPoints();
+  fPofBMode = fStartupHandler->IsPofBMode();
 
   // load all the TRIM.SP rge-files
   fRgeHandler = new PRgeHandler("./nonlocal_startup.xml");
@@ -112,9 +120,7 @@ PNL_PippardFitterGlobal::~PNL_PippardFitterGlobal()
 {
   fPreviousParam.clear();
 
-  if (fPlanPresent) {
-    fftw_destroy_plan(fPlan);
-  }
+  // fPlan is owned by the PFFTPlanManager
   if (fFieldq) {
     fftw_free(fFieldq);
     fFieldq = 0;
@@ -208,11 +214,11 @@ void PNL_PippardFitterGlobal::CalculateField(const std::vector<Double_t> &param)
 
   // Fourier transform
   if (!fPlanPresent) {
-    fPlan = fftw_plan_dft_1d(fFourierPoints, fFieldq, fFieldB, FFTW_FORWARD, FFTW_ESTIMATE);
+    fPlan = PFFTPlanManager::GetInstance()->GetPlanDft(1, &fFourierPoints, fFieldq, fFieldB, FFTW_FORWARD, FFTW_ESTIMATE);
     fPlanPresent = true;
   }
 
-  fftw_execute(fPlan);
+  fftw_execute_dft(fPlan, fFieldq, fFieldB);
 
   // normalize fFieldB
   Double_t norm = 0.0;
@@ -352,6 +358,13 @@ ClassImp(PNL_PippardFitter)
  */
 PNL_PippardFitter::~PNL_PippardFitter()
 {
+  if (fPofTPoints > 0) {
+    fftw_free(fPofB);
+    fftw_free(fPofT);
+    fPofB = 0;
+    fPofT = 0;
+  }
+
   if ((fPippardFitterGlobal != 0) && fInvokedGlobal) {
     delete fPippardFitterGlobal;
     fPippardFitterGlobal = 0;
@@ -433,6 +446,10 @@ Double_t PNL_PippardFitter::operator()(Double_t t, const std::vector<Double_t> &
     assert(0);
   }
 
+  // P(B) mode: P(t) is interpolated from the Fourier transform of the field distribution
+  if (fPippardFitterGlobal->IsPofBMode() && (t <= PNL_POFB_TMAX))
+    return PolarizationPofB(t, param, energyIndex);
+
   // calcualte polarization
   Bool_t done = false;
   Double_t pol = 0.0, dPol = 0.0;
@@ -462,3 +479,125 @@ Double_t PNL_PippardFitter::operator()(Double_t t, const std::vector<Double_t> &
 
   return pol*dz;
 }
+
+//--------------------------------------------------------------------------
+// PolarizationPofB (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Polarization P(t) = sum_k p(B_k) cos(gamma_mu B_k t + phase), where p(B)
+ * is the stopping weighted field distribution. The demodulated complex
+ * polarization G(t) = sum_k p(B_k) exp(i (omega_k - omega_0) t) is calculated
+ * once per parameter set (see CalculatePofT), and interpolated (cubic) here,
+ * hence P(t) = Re[exp(i (omega_0 t + phase)) G(t)].
+ *
+ * \param t time (us)
+ * \param param see operator()
+ * \param energyIndex index of the rge-data set
+ */
+Double_t PNL_PippardFitter::PolarizationPofB(const Double_t t, const std::vector<Double_t> &param, const Int_t energyIndex) const
+{
+  // check if P(t) needs to be recalculated. All parameters but the phase enter p(B).
+  Bool_t newParams = (fPofBParam.size() != param.size());
+  for (UInt_t i=0; (i<param.size()) && !newParams; i++) {
+    if ((i != 7) && (param[i] != fPofBParam[i]))
+      newParams = true;
+  }
+  if (newParams)
+    CalculatePofT(param, energyIndex);
+
+  // cubic Lagrange interpolation of G(t). G_{-1} = G_{N-1} due to the periodicity of the DFT.
+  const Double_t x = t/fPofTDt;
+  const Int_t m = (Int_t)x;
+  const Double_t u = x - m;
+  const Double_t w[4] = {-u*(u-1.0)*(u-2.0)/6.0, (u+1.0)*(u-1.0)*(u-2.0)/2.0,
+                         -(u+1.0)*u*(u-2.0)/2.0, (u+1.0)*u*(u-1.0)/6.0};
+  Double_t re=0.0, im=0.0;
+  Int_t idx;
+  for (Int_t i=0; i<4; i++) {
+    idx = (m-1+i+fPofTPoints) % fPofTPoints;
+    re += w[i]*fPofT[idx][0];
+    im += w[i]*fPofT[idx][1];
+  }
+
+  const Double_t phase = fOmega0*t + param[7]*DEGREE2RAD;
+
+  return cos(phase)*re - sin(phase)*im;
+}
+
+//--------------------------------------------------------------------------
+// CalculatePofT (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Sets up the stopping weighted field distribution p(B) by sampling
+ * n(z) B(z) on the same 1 nm depth grid as the depth integration in
+ * operator(). The weights are distributed linearly onto a uniform frequency
+ * grid omega_k = omega_0 + k dOmega (dOmega = PNL_POFB_EPS/PNL_POFB_TMAX)
+ * which is Fourier transformed into the demodulated complex polarization on
+ * the time grid t_m = m dt, dt = 2pi/(N dOmega).
+ *
+ * \param param see operator()
+ * \param energyIndex index of the rge-data set
+ */
+void PNL_PippardFitter::CalculatePofT(const std::vector<Double_t> &param, const Int_t energyIndex) const
+{
+  fPofBParam = param;
+
+  // sample the stopping weighted Larmor frequencies
+  const Double_t dz = 1.0;
+  const Double_t zMax = fPippardFitterGlobal->GetZmax(energyIndex);
+  std::vector<Double_t> weight, omega;
+  Double_t nn, bb;
+  Double_t omegaMin = 0.0, omegaMax = 0.0;
+  for (Double_t z=0.0; z<=zMax; z+=dz) {
+    nn = fPippardFitterGlobal->GetMuonStoppingDensity(energyIndex, z);
+    if (nn == 0.0)
+      continue;
+    if (z < param[8]) // z < dead-layer
+      bb = 1.0;
+    else
+      bb = fPippardFitterGlobal->GetMagneticField(z-param[8]);
+    weight.push_back(nn*dz);
+    omega.push_back(GAMMA_MU * param[6] * bb);
+    if ((omega.size() == 1) || (omega.back() < omegaMin))
+      omegaMin = omega.back();
+    if ((omega.size() == 1) || (omega.back() > omegaMax))
+      omegaMax = omega.back();
+  }
+
+  // number of frequency bins and Fourier points
+  const Double_t dOmega = PNL_POFB_EPS/PNL_POFB_TMAX;
+  const Int_t noOfBins = (Int_t)ceil((omegaMax-omegaMin)/dOmega) + 2;
+  Int_t noOfPoints = 1024;
+  while (noOfPoints < PNL_POFB_OVERSAMPLING*noOfBins)
+    noOfPoints *= 2;
+
+  if (noOfPoints != fPofTPoints) {
+    if (fPofTPoints > 0) {
+      fftw_free(fPofB);
+      fftw_free(fPofT);
+    }
+    fPofTPoints = noOfPoints;
+    fPofB = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * fPofTPoints);
+    fPofT = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * fPofTPoints);
+    fPofTPlan = PFFTPlanManager::GetInstance()->GetPlanDft(1, &fPofTPoints, fPofB, fPofT, FFTW_BACKWARD, FFTW_ESTIMATE);
+  }
+
+  // p(B): distribute each weight linearly onto its two neighbouring frequency bins
+  for (Int_t i=0; i<fPofTPoints; i++) {
+    fPofB[i][0] = 0.0;
+    fPofB[i][1] = 0.0;
+  }
+  Double_t x;
+  Int_t k;
+  for (UInt_t i=0; i<weight.size(); i++) {
+    x = (omega[i]-omegaMin)/dOmega;
+    k = (Int_t)x;
+    fPofB[k][0] += weight[i]*(1.0-(x-k));
+    fPofB[k+1][0] += weight[i]*(x-k);
+  }
+
+  fftw_execute_dft(fPofTPlan, fPofB, fPofT);
+
+  fOmega0 = omegaMin;
+  fPofTDt = TMath::TwoPi()/(fPofTPoints*dOmega);
+}
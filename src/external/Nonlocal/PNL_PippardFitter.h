@@ -53,9 +53,13 @@ class PNL_PippardFitterGlobal
     virtual Int_t GetEnergyIndex(const Double_t energy) { return fRgeHandler->GetEnergyIndex(energy); }
     virtual Double_t GetMuonStoppingDensity(const Int_t energyIndex, const Double_t z) const { return fRgeHandler->Get_n(energyIndex, z); }
     virtual Double_t GetMagneticField(const Double_t z) const;    
+    virtual Double_t GetZmax(const Int_t energyIndex) const { return fRgeHandler->GetZmax(energyIndex); }
+    virtual Bool_t IsPofBMode() const { return fPofBMode; }
+    virtual void SetPofBMode(const Bool_t pofbMode) { fPofBMode = pofbMode; }
 
   private:
     Bool_t fValid{true};
+    Bool_t fPofBMode{false}; // true: polarization is calculated via the field distribution P(B)
 
     PNL_StartupHandler *fStartupHandler{nullptr};
     PRgeHandler *fRgeHandler{nullptr};
@@ -102,6 +106,18 @@ class PNL_PippardFitter : public PUserFcnBase
 
     PNL_PippardFitterGlobal *fPippardFitterGlobal{nullptr};
 
+    // P(B) mode
+    mutable std::vector<Double_t> fPofBParam; // parameters for which fPofT has been calculated
+    mutable Int_t fPofTPoints{0};             // number of Fourier points of fPofB and fPofT
+    mutable fftw_plan     fPofTPlan;
+    mutable fftw_complex *fPofB{nullptr};     // stopping weighted field distribution on a uniform frequency grid
+    mutable fftw_complex *fPofT{nullptr};     // complex polarization, demodulated by the carrier fOmega0
+    mutable Double_t fOmega0{0.0};            // lowest Larmor frequency (1/us) of P(B), used as carrier
+    mutable Double_t fPofTDt{0.0};            // time step (us) of fPofT
+
+    virtual Double_t PolarizationPofB(const Double_t t, const std::vector<Double_t> &param, const Int_t energyIndex) const;
+    virtual void CalculatePofT(const std::vector<Double_t> &param, const Int_t energyIndex) const;
+
   ClassDef(PNL_PippardFitter, 1)
 };
 
@@ -106,6 +106,8 @@ void PNL_StartupHandler::OnStartElement(const char *str, const TList *attributes
 {
   if (!strcmp(str, "fourier_points")) {
     fKey = eFourierPoints;
+  } else if (!strcmp(str, "polarization_mode")) {
+    fKey = ePolarizationMode;
   }
 }
 
@@ -145,6 +147,19 @@ void PNL_StartupHandler::OnCharacters(const char *str)
         std::cout << std::endl;
       }
       break;
+    case ePolarizationMode:
+      tstr = str;
+      tstr.ToLower();
+      if (tstr == "pofb") {
+        fPofBMode = true;
+      } else if (tstr == "depth") {
+        fPofBMode = false;
+      } else {
+        std::cout << std::endl << "PNL_StartupHandler::OnCharacters: **ERROR** when finding polarization_mode:";
+        std::cout << std::endl << "\"" << str << "\" is neither 'depth' nor 'pofb', will ignore it and use 'depth'.";
+        std::cout << std::endl;
+      }
+      break;
     default:
       break;
   }
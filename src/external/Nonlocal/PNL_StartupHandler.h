@@ -54,10 +54,11 @@ class PNL_StartupHandler : public TObject
     virtual bool IsValid() { return fIsValid; }
     virtual TString GetStartupFilePath() { return fStartupFilePath; }
     virtual const Int_t GetFourierPoints() const { return fFourierPoints; }
+    virtual const Bool_t IsPofBMode() const { return fPofBMode; }
     virtual bool StartupFileFound() { return fStartupFileFound; }
 
   private:
-    enum EKeyWords {eEmpty, eFourierPoints};
+    enum EKeyWords {eEmpty, eFourierPoints, ePolarizationMode};
     EKeyWords      fKey;
 
     bool fIsValid{true};
@@ -66,6 +67,7 @@ class PNL_StartupHandler : public TObject
     TString fStartupFilePath{""};
 
     Int_t fFourierPoints{0};
+    Bool_t fPofBMode{false}; // polarization_mode: 'depth' (default) or 'pofb'
 
   ClassDef(PNL_StartupHandler, 1)
 };
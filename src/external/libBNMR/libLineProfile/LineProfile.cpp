@@ -88,6 +88,28 @@ Double_t IAsym_high(Double_t omega, Double_t omega_center,  Double_t omega_min,D
     }
 
 
+//sample a powder pattern at the midpoints of M equidistant steps between omin and omax, such that the
+//line shape of the given width is resolved (M >= 20*(omax-omin)/width, but at most maxSteps)
+void SamplePowderPattern(PFieldDistribution &dist, Double_t omin, Double_t omax, Double_t width, UInt_t maxSteps, const std::function<Double_t(Double_t)> &pattern){
+    dist.Clear();
+    if(!(omax>omin)) return;
+
+    UInt_t steps=maxSteps;
+    if(width>0){
+        Double_t needed=ceil(20*(omax-omin)/width);
+        if(needed<steps) steps=static_cast<UInt_t>(needed);
+        if(steps<2000) steps=2000;
+    }
+
+    Double_t h=(omax-omin)/steps;
+    vector<Double_t> ampl(steps);
+    for(UInt_t j=0;j<steps;j++){
+        ampl[j]=pattern(omin+(j+0.5)*h)*h;
+    }
+    dist.AddEquidistant(omin+0.5*h,h,ampl);
+}
+
+
 //Implement Userfunctions
 ClassImp(LineGauss)  // for the ROOT dictionary
 
@@ -195,7 +217,7 @@ Double_t omega_per=param[1]; //middle of the line
 Double_t width=param[2];//width of the Lorentzian
 
 //symmetric lineshape is normalized by default:
-if(omega_par==omega_per){ return;}
+if(omega_par==omega_per){ fDistribution.Clear(); return;}
 
 //ensure width>0
 if(width<0) {width=-width;}
@@ -204,21 +226,11 @@ Double_t omin=min(omega_par,omega_per);
 Double_t omax=max(omega_par,omega_per);
 Double_t x=omega_per;
 
-//Lorentzian window: maximally +- 15*width
-//Lineshape Window [omin omax]
-//Determine necessary convolution window
-Double_t convmin=-15*width;
-Double_t convmax=-convmin;
-if(x-convmax>omin){convmax=x-omin;}
-if(x-convmin<omax){convmin=x-omax;}
-
-//convolution
-Double_t result=0;
-UInt_t steps=GetSteps();
-for(Double_t y=convmin;y<convmax;y+=(convmax-convmin)/steps){
-  result+=LorentzianShape(y,0,width)*IAxial(x-y,omega_par,omega_per);
-}
-fNormalization=result*(convmax-convmin)/steps;
+//sample the powder pattern once per parameter set
+SamplePowderPattern(fDistribution,omin,omax,width,GetSteps(),[omega_par,omega_per](Double_t omega){return IAxial(omega,omega_par,omega_per);});
+
+//convolution of the sampled powder pattern with the line shape
+fNormalization=fDistribution.Convolve(x,[width](Double_t y){return LorentzianShape(y,0,width);});
 if(!(fNormalization>0)) fNormalization=1;
 return;
 }
@@ -289,24 +301,8 @@ Double_t PowderLineAxialLor::operator()(Double_t x, const vector<Double_t> &par)
       cout<<endl<<"Using a Lorentzian line shape";
       return LorentzianShape(x,omega_par,width);}
 
-  Double_t omin=min(omega_par,omega_per);
-  Double_t omax=max(omega_par,omega_per);
-
-  //Lorentzian window: maximally +- 15*width
-  //Lineshape Window [omin omax]
-  //Determine necessary convolution window
-  Double_t convmin=-15*width;
-  Double_t convmax=-convmin;
-  if(x-convmax>omin){convmax=x-omin;}
-  if(x-convmin<omax){convmin=x-omax;}
-
-  //convolution
-  Double_t result=0;
-  UInt_t steps=fGlobalUserFcn->GetSteps();
-  for(Double_t y=convmin;y<convmax;y+=(convmax-convmin)/steps){
-    result+=LorentzianShape(y,0,width)*IAxial(x-y,omega_par,omega_per);
-  }
-  result=result*(convmax-convmin)/steps;
+  //convolution of the sampled powder pattern with the line shape
+  Double_t result=fGlobalUserFcn->GetDistribution().Convolve(x,[width](Double_t y){return LorentzianShape(y,0,width);});
   return result/Norm;
 
 }
@@ -351,7 +347,7 @@ Double_t omega_per=param[1]; //middle of the line
 Double_t width=param[2];//width of the Lorentzian
 
 //symmetric lineshape is normalized by default:
-if(omega_par==omega_per){ return;}
+if(omega_par==omega_per){ fDistribution.Clear(); return;}
 
 
 //ensure width>0
@@ -362,21 +358,11 @@ Double_t omin=min(omega_par,omega_per);
 Double_t omax=max(omega_par,omega_per);
 Double_t x=omega_per;
 
-//Gaussian window: maximally +- 15*width
-//Lineshape Window [omin omax]
-//Determine necessary convolution window
-Double_t convmin=-15*width;
-Double_t convmax=-convmin;
-if(x-convmax>omin){convmax=x-omin;}
-if(x-convmin<omax){convmin=x-omax;}
-
-//convolution
-Double_t result=0;
-UInt_t steps=GetSteps();
-for(Double_t y=convmin;y<convmax;y+=(convmax-convmin)/steps){
-  result+=GaussianShape(y,0,width)*IAxial(x-y,omega_par,omega_per);
-}
-fNormalization=result*(convmax-convmin)/steps;
+//sample the powder pattern once per parameter set
+SamplePowderPattern(fDistribution,omin,omax,width,GetSteps(),[omega_par,omega_per](Double_t omega){return IAxial(omega,omega_par,omega_per);});
+
+//convolution of the sampled powder pattern with the line shape
+fNormalization=fDistribution.Convolve(x,[width](Double_t y){return GaussianShape(y,0,width);},15*width);
 if(!(fNormalization>0)) fNormalization=1;
 return;
 }
@@ -447,24 +433,8 @@ Double_t PowderLineAxialGss::operator()(Double_t x, const vector<Double_t> &par)
       cout<<endl<<"Using a Gaussian line shape";
       return GaussianShape(x,omega_par,width);}
 
-  Double_t omin=min(omega_par,omega_per);
-  Double_t omax=max(omega_par,omega_per);
-
-  //Gaussian window: maximally +- 15*width
-  //Lineshape Window [omin omax]
-  //Determine necessary convolution window
-  Double_t convmin=-15*width;
-  Double_t convmax=-convmin;
-  if(x-convmax>omin){convmax=x-omin;}
-  if(x-convmin<omax){convmin=x-omax;}
-
-  //convolution
-  Double_t result=0;
-  UInt_t steps=fGlobalUserFcn->GetSteps();
-  for(Double_t y=convmin;y<convmax;y+=(convmax-convmin)/steps){
-    result+=GaussianShape(y,0,width)*IAxial(x-y,omega_par,omega_per);
-  }
-  result=result*(convmax-convmin)/steps;
+  //convolution of the sampled powder pattern with the line shape
+  Double_t result=fGlobalUserFcn->GetDistribution().Convolve(x,[width](Double_t y){return GaussianShape(y,0,width);},15*width);
   return result/Norm;
 
 }
@@ -549,21 +519,11 @@ if(omega1>=omega2){
 //calculate normalization
 Double_t x=fOmegaCenter;
 
-//Lorentzian window: maximally +- 15*width
-//Lineshape Window [fOmegaMin fOmegaMax]
-//Determine necessary convolution window
-Double_t convmin=-15*width;
-Double_t convmax=-convmin;
-if(x-convmax>fOmegaMin){convmax=x-fOmegaMin;}
-if(x-convmin<fOmegaMax){convmin=x-fOmegaMax;}
-
-//convolution
-Double_t result=0;
-UInt_t steps=GetSteps();
-for(Double_t y=convmin;y<convmax;y+=(convmax-convmin)/steps){
-  result+=LorentzianShape(y,0,width)* IAsym(x-y,fOmegaCenter,fOmegaMin,fOmegaMax);
-}
-fNormalization=result*(convmax-convmin)/steps;
+//sample the powder pattern once per parameter set
+SamplePowderPattern(fDistribution,fOmegaMin,fOmegaMax,width,GetSteps(),[this](Double_t omega){return IAsym(omega,fOmegaCenter,fOmegaMin,fOmegaMax);});
+
+//convolution of the sampled powder pattern with the line shape
+fNormalization=fDistribution.Convolve(x,[width](Double_t y){return LorentzianShape(y,0,width);});
 if(!(fNormalization>0)) fNormalization=1;
 return;
 }
@@ -637,21 +597,8 @@ Double_t PowderLineAsymLor::operator()(Double_t x, const vector<Double_t> &par)
       return LorentzianShape(x,omega_center,width);}
 
 
-  //Lorentzian window: maximally +- 15*width
-  //Lineshape Window [omega_min omega_max]
-  //Determine necessary convolution window
-  Double_t convmin=-15*width;
-  Double_t convmax=-convmin;
-  if(x-convmax>omega_min){convmax=x-omega_min;}
-  if(x-convmin<omega_max){convmin=x-omega_max;}
-
-  //convolution
-  Double_t result=0;
-  UInt_t steps=fGlobalUserFcn->GetSteps();
-  for(Double_t y=convmin;y<convmax;y+=(convmax-convmin)/steps){
-    result+=LorentzianShape(y,0,width)* IAsym(x-y,omega_center,omega_min,omega_max);
-  }
-  result=result*(convmax-convmin)/steps;
+  //convolution of the sampled powder pattern with the line shape
+  Double_t result=fGlobalUserFcn->GetDistribution().Convolve(x,[width](Double_t y){return LorentzianShape(y,0,width);});
   return result/Norm;
 
 }
@@ -736,21 +683,11 @@ if(omega1>=omega2){
 //calculate normalization
 Double_t x=fOmegaCenter;
 
-//Lorentzian window: maximally +- 15*width
-//Lineshape Window [fOmegaMin fOmegaMax]
-//Determine necessary convolution window
-Double_t convmin=-15*width;
-Double_t convmax=-convmin;
-if(x-convmax>fOmegaMin){convmax=x-fOmegaMin;}
-if(x-convmin<fOmegaMax){convmin=x-fOmegaMax;}
-
-//convolution
-Double_t result=0;
-UInt_t steps=GetSteps();
-for(Double_t y=convmin;y<convmax;y+=(convmax-convmin)/steps){
-  result+=GaussianShape(y,0,width)* IAsym(x-y,fOmegaCenter,fOmegaMin,fOmegaMax);
-}
-fNormalization=result*(convmax-convmin)/steps;
+//sample the powder pattern once per parameter set
+SamplePowderPattern(fDistribution,fOmegaMin,fOmegaMax,width,GetSteps(),[this](Double_t omega){return IAsym(omega,fOmegaCenter,fOmegaMin,fOmegaMax);});
+
+//convolution of the sampled powder pattern with the line shape
+fNormalization=fDistribution.Convolve(x,[width](Double_t y){return GaussianShape(y,0,width);},15*width);
 if(!(fNormalization>0)) fNormalization=1;
 return;
 }
@@ -824,21 +761,8 @@ Double_t PowderLineAsymGss::operator()(Double_t x, const vector<Double_t> &par)
       return GaussianShape(x,omega_center,width);}
 
 
-  //Lorentzian window: maximally +- 15*width
-  //Lineshape Window [omega_min omega_max]
-  //Determine necessary convolution window
-  Double_t convmin=-15*width;
-  Double_t convmax=-convmin;
-  if(x-convmax>omega_min){convmax=x-omega_min;}
-  if(x-convmin<omega_max){convmin=x-omega_max;}
-
-  //convolution
-  Double_t result=0;
-  UInt_t steps=fGlobalUserFcn->GetSteps();
-  for(Double_t y=convmin;y<convmax;y+=(convmax-convmin)/steps){
-    result+=GaussianShape(y,0,width)* IAsym(x-y,omega_center,omega_min,omega_max);
-  }
-  result=result*(convmax-convmin)/steps;
+  //convolution of the sampled powder pattern with the line shape
+  Double_t result=fGlobalUserFcn->GetDistribution().Convolve(x,[width](Double_t y){return GaussianShape(y,0,width);},15*width);
   return result/Norm;
 
 }
@@ -21,10 +21,12 @@
 ***************************************************************************/
 
 #include "PUserFcnBase.h"
+#include "PFieldDistribution.h"
 #include <cassert>
 #include <cmath>
 #include <vector>
 #include <algorithm>
+#include <functional>
 #include <boost/math/special_functions/ellint_1.hpp>
 
 
@@ -45,6 +47,7 @@ Double_t IAxial(Double_t, Double_t, Double_t);
 Double_t IAsym(Double_t, Double_t, Double_t,Double_t);
 Double_t IAsym_low(Double_t, Double_t, Double_t, Double_t);
 Double_t IAsym_high(Double_t, Double_t, Double_t, Double_t);
+void SamplePowderPattern(PFieldDistribution&, Double_t, Double_t, Double_t, UInt_t, const std::function<Double_t(Double_t)>&);
 
 
 //
@@ -121,12 +124,14 @@ public:
   // this routine returns the globally calculated values
   Double_t GetNormalization() const {return fNormalization;}
   UInt_t GetSteps() const {return 1e5;}
+  const PFieldDistribution& GetDistribution() const {return fDistribution;}
 
 private:
   Bool_t fValid=true;
   vector<Double_t> fPrevParam;
 
   Double_t fNormalization;
+  PFieldDistribution fDistribution; //! sampled powder pattern, weights include the step width
   // definition of the class for the ROOT-dictionary
   ClassDef(PowderLineAxialLorGlobal,1)
 };
@@ -173,12 +178,14 @@ public:
   // this routine returns the globally calculated values
   Double_t GetNormalization() const {return fNormalization;}
   UInt_t GetSteps() const {return 1e5;}
+  const PFieldDistribution& GetDistribution() const {return fDistribution;}
 
 private:
   Bool_t fValid=true;
   vector<Double_t> fPrevParam;
 
   Double_t fNormalization;
+  PFieldDistribution fDistribution; //! sampled powder pattern, weights include the step width
   // definition of the class for the ROOT-dictionary
   ClassDef(PowderLineAxialGssGlobal,1)
 };
@@ -229,11 +236,13 @@ public:
   Double_t GetMin() const {return fOmegaMin;}
   Double_t GetMax() const {return fOmegaMax;}
   UInt_t GetSteps() const {return 1e5;}
+  const PFieldDistribution& GetDistribution() const {return fDistribution;}
 
 private:
   Bool_t fValid=true;
   vector<Double_t> fPrevParam;
   Double_t fNormalization;
+  PFieldDistribution fDistribution; //! sampled powder pattern, weights include the step width
   Double_t fOmegaCenter;
   Double_t fOmegaMin;
   Double_t fOmegaMax;
@@ -286,11 +295,13 @@ public:
   Double_t GetMin() const {return fOmegaMin;}
   Double_t GetMax() const {return fOmegaMax;}
   UInt_t GetSteps() const {return 1e5;}
+  const PFieldDistribution& GetDistribution() const {return fDistribution;}
 
 private:
   Bool_t fValid=true;
   vector<Double_t> fPrevParam;
   Double_t fNormalization;
+  PFieldDistribution fDistribution; //! sampled powder pattern, weights include the step width
   Double_t fOmegaCenter;
   Double_t fOmegaMin;
   Double_t fOmegaMax;
@@ -31,9 +31,12 @@
 #endif
 
 #include "TBulkTriVortexFieldCalc.h"
+#include "PFFTPlanManager.h"
 
 #include <cstdlib>
 #include <cmath>
+#include <chrono>
+#include <algorithm>
 
 #ifdef HAVE_GOMP
 #include <omp.h>
@@ -67,29 +70,46 @@ double getHc2(const double &xi) { // get Hc2 given xi in nm
 }
 
 TBulkVortexFieldCalc::~TBulkVortexFieldCalc() {
-  // if a wisdom file is used export the wisdom so it has not to be checked for the FFT-plan next time
-  if (fUseWisdom) {
-    FILE *wordsOfWisdomW;
-    wordsOfWisdomW = fopen(fWisdom.c_str(), "w");
-    if (wordsOfWisdomW == NULL) {
-      std::cout << "TBulkVortexFieldCalc::~TBulkVortexFieldCalc(): Could not open file ... No wisdom is exported..." << std::endl;
-    } else {
-      fftw_export_wisdom_to_file(wordsOfWisdomW);
-      fclose(wordsOfWisdomW);
-    }
-  }
+  // clean up - the FFT plans are owned by the PFFTPlanManager which also exports the wisdom
 
-  // clean up
-
-  fftw_destroy_plan(fFFTplan);
   delete[] fFFTin; fFFTin = 0;
   delete[] fFFTout; fFFTout = 0;
   //fftw_cleanup();
   //fftw_cleanup_threads();
 }
 
+/**
+ * <p>Create the FFT plan for a reduced grid: B(x,y) of a lattice which is mirror symmetric in x and y is given by
+ * sum_K B_K cos(Kx*x) cos(Ky*y), i.e. it is completely determined by the first quadrant of the unit cell and can be obtained by
+ * a two-dimensional DCT-I (REDFT00) of the quadrant 0 <= Kx, Ky <= fSteps/2 of the Fourier coefficients.
+ * The coefficients are taken from the real parts of fFFTin (layout as for the c2r-transform, but only fSteps/2+1 rows),
+ * the result is written to fFFTout with fSteps/2+1 entries per row.
+ *
+ * \param flags FFTW planner flags
+ */
+void TBulkVortexFieldCalc::CreateReducedGridPlan(const unsigned int flags) {
+  const int n(fSteps/2 + 1);
+  const int dims[2] = {n, n};
+  const fftw_r2r_kind kinds[2] = {FFTW_REDFT00, FFTW_REDFT00};
+
+  fReducedGrid = true;
+  fFFTplan = PFFTPlanManager::GetInstance()->GetPlanManyR2R(2, dims, &fFFTin[0][0], dims, 2, fFFTout, dims, 1, kinds, flags);
+}
+
 double TBulkVortexFieldCalc::GetBmin() const {
-  if (fGridExists) {
+  if (fGridExists && fReducedGrid) {
+    const unsigned int gridSize((fSteps/2 + 1)*(fSteps/2 + 1));
+    double min(fFFTout[0]);
+    for (unsigned int j(0); j < gridSize; ++j) {
+      if (fFFTout[j] <= 0.0) {
+        return 0.0;
+      }
+      if (fFFTout[j] < min) {
+        min = fFFTout[j];
+      }
+    }
+    return min;
+  } else if (fGridExists) {
     double min(fFFTout[0]);
     unsigned int minindex(0), counter(0);
     for (unsigned int j(0); j < fSteps * fSteps / 2; j++) {
@@ -132,42 +152,22 @@ TBulkTriVortexLondonFieldCalc::TBulkTriVortexLondonFieldCalc(const std::string&
   fParam.resize(3);
   fGridExists = false;
 
-#if !defined(_WIN32GCC) && defined(HAVE_LIBFFTW3_THREADS) && defined(HAVE_GOMP)
-  int init_threads(fftw_init_threads());
-  if (init_threads) {
-    fftw_plan_with_nthreads(omp_get_num_procs());
-  }
-#endif
-
-  fFFTin = new fftw_complex[(fSteps/2 + 1) * fSteps];
-  fFFTout = new double[fSteps*fSteps];
+  // only the first quadrant of the Fourier coefficients and of B(x,y) is needed (see CreateReducedGridPlan)
+  fFFTin = new fftw_complex[(fSteps/2 + 1) * (fSteps/2 + 1)];
+  fFFTout = new double[(fSteps/2 + 1) * (fSteps/2 + 1)];
 
 //  std::cout << "Check for the FFT plan..." << std::endl;
 
 // Load wisdom from file if it exists and should be used
 
-  fUseWisdom = true;
-  int wisdomLoaded(0);
-
-  FILE *wordsOfWisdomR;
-  wordsOfWisdomR = fopen(fWisdom.c_str(), "r");
-  if (wordsOfWisdomR == NULL) {
-    fUseWisdom = false;
-  } else {
-    wisdomLoaded = fftw_import_wisdom_from_file(wordsOfWisdomR);
-    fclose(wordsOfWisdomR);
-  }
-
-  if (!wisdomLoaded) {
-    fUseWisdom = false;
-  }
+  fUseWisdom = PFFTPlanManager::GetInstance()->ImportWisdom(fWisdom);
 
 // create the FFT plan
 
   if (fUseWisdom)
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_EXHAUSTIVE);
+    CreateReducedGridPlan(FFTW_EXHAUSTIVE);
   else
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_ESTIMATE);
+    CreateReducedGridPlan(FFTW_ESTIMATE);
 }
 
 void TBulkTriVortexLondonFieldCalc::CalculateGrid() const {
@@ -187,12 +187,11 @@ void TBulkTriVortexLondonFieldCalc::CalculateGrid() const {
   double latConstTr(sqrt(2.0*fluxQuantum/(field*sqrt3)));
   double xisq_2_scaled(2.0/3.0*pow(xi*PI/latConstTr,2.0)), lambdasq_scaled(4.0/3.0*pow(lambda*PI/latConstTr,2.0));
 
-  const int NFFT(fSteps);
   const int NFFT_2(fSteps/2);
-  const int NFFTsq(fSteps*fSteps);
+  const int NGrid((NFFT_2 + 1)*(NFFT_2 + 1)); // size of the reduced grid
 
   #ifdef HAVE_GOMP
-  int chunk = NFFTsq/omp_get_num_procs();
+  int chunk = NGrid/omp_get_num_procs();
   if (chunk < 10)
     chunk = 10;
   #endif
@@ -205,7 +204,7 @@ void TBulkTriVortexLondonFieldCalc::CalculateGrid() const {
     #ifdef HAVE_GOMP
     #pragma omp parallel for default(shared) private(m) schedule(dynamic,chunk)
     #endif
-    for (m = 0; m < NFFTsq; ++m) {
+    for (m = 0; m < NGrid; ++m) {
       fFFTout[m] = field;
     }
     // Set the flag which shows that the calculation has been done
@@ -217,7 +216,7 @@ void TBulkTriVortexLondonFieldCalc::CalculateGrid() const {
   double Gsq, ll;
   int k, l, lNFFT_2;
 
-  for (l = 0; l < NFFT_2; l += 2) {
+  for (l = 0; l <= NFFT_2; l += 2) {
     lNFFT_2 = l*(NFFT_2 + 1);
     ll = 3.0*static_cast<double>(l*l);
     for (k = 0; k < NFFT_2; k += 2) {
@@ -234,25 +233,10 @@ void TBulkTriVortexLondonFieldCalc::CalculateGrid() const {
   }
 
 
-  for (l = NFFT_2; l < NFFT; l += 2) {
-    lNFFT_2 = l*(NFFT_2 + 1);
-    ll = 3.0*static_cast<double>((NFFT-l)*(NFFT-l));
-    for (k = 0; k < NFFT_2; k += 2) {
-      Gsq = static_cast<double>(k*k) + ll;
-      fFFTin[lNFFT_2 + k][0] = exp(-xisq_2_scaled*Gsq)/(1.0+lambdasq_scaled*Gsq);
-      fFFTin[lNFFT_2 + k][1] = 0.0;
-      fFFTin[lNFFT_2 + k + 1][0] = 0.0;
-      fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-    }
-    k = NFFT_2;
-    Gsq = static_cast<double>(k*k) + ll;
-    fFFTin[lNFFT_2 + k][0] = exp(-xisq_2_scaled*Gsq)/(1.0+lambdasq_scaled*Gsq);
-    fFFTin[lNFFT_2 + k][1] = 0.0;
-  }
 
   // intermediate rows
 
-  for (l = 1; l < NFFT_2; l += 2) {
+  for (l = 1; l <= NFFT_2; l += 2) {
     lNFFT_2 = l*(NFFT_2 + 1);
     ll = 3.0*static_cast<double>(l*l);
     for (k = 0; k < NFFT_2; k += 2) {
@@ -267,30 +251,16 @@ void TBulkTriVortexLondonFieldCalc::CalculateGrid() const {
     fFFTin[lNFFT_2 + k][1] = 0.0;
   }
 
-  for (l = NFFT_2 + 1; l < NFFT; l += 2) {
-    lNFFT_2 = l*(NFFT_2 + 1);
-    ll = 3.0*static_cast<double>((NFFT-l)*(NFFT-l));
-    for (k = 0; k < NFFT_2; k += 2) {
-      Gsq = static_cast<double>((k+1)*(k+1)) + ll;
-      fFFTin[lNFFT_2 + k][0] = 0.0;
-      fFFTin[lNFFT_2 + k][1] = 0.0;
-      fFFTin[lNFFT_2 + k + 1][0] = exp(-xisq_2_scaled*Gsq)/(1.0+lambdasq_scaled*Gsq);
-      fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-    }
-    k = NFFT_2;
-    fFFTin[lNFFT_2 + k][0] = 0.0;
-    fFFTin[lNFFT_2 + k][1] = 0.0;
-  }
 
   // Do the Fourier transform to get B(x,y)
 
-  fftw_execute(fFFTplan);
+  fftw_execute_r2r(fFFTplan, &fFFTin[0][0], fFFTout);
 
   // Multiply by the applied field
   #ifdef HAVE_GOMP
   #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
   #endif
-  for (l = 0; l < NFFTsq; l++) {
+  for (l = 0; l < NGrid; l++) {
     fFFTout[l] *= field;
   }
 
@@ -311,42 +281,22 @@ TBulkSqVortexLondonFieldCalc::TBulkSqVortexLondonFieldCalc(const std::string& wi
   fParam.resize(3);
   fGridExists = false;
 
-#if !defined(_WIN32GCC) && defined(HAVE_LIBFFTW3_THREADS) && defined(HAVE_GOMP)
-  int init_threads(fftw_init_threads());
-  if (init_threads) {
-    fftw_plan_with_nthreads(omp_get_num_procs());
-  }
-#endif
-
-  fFFTin = new fftw_complex[(fSteps/2 + 1) * fSteps];
-  fFFTout = new double[fSteps*fSteps];
+  // only the first quadrant of the Fourier coefficients and of B(x,y) is needed (see CreateReducedGridPlan)
+  fFFTin = new fftw_complex[(fSteps/2 + 1) * (fSteps/2 + 1)];
+  fFFTout = new double[(fSteps/2 + 1) * (fSteps/2 + 1)];
 
 //  std::cout << "Check for the FFT plan..." << std::endl;
 
 // Load wisdom from file if it exists and should be used
 
-  fUseWisdom = true;
-  int wisdomLoaded(0);
-
-  FILE *wordsOfWisdomR;
-  wordsOfWisdomR = fopen(fWisdom.c_str(), "r");
-  if (wordsOfWisdomR == NULL) {
-    fUseWisdom = false;
-  } else {
-    wisdomLoaded = fftw_import_wisdom_from_file(wordsOfWisdomR);
-    fclose(wordsOfWisdomR);
-  }
-
-  if (!wisdomLoaded) {
-    fUseWisdom = false;
-  }
+  fUseWisdom = PFFTPlanManager::GetInstance()->ImportWisdom(fWisdom);
 
 // create the FFT plan
 
   if (fUseWisdom)
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_EXHAUSTIVE);
+    CreateReducedGridPlan(FFTW_EXHAUSTIVE);
   else
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_ESTIMATE);
+    CreateReducedGridPlan(FFTW_ESTIMATE);
 }
 
 void TBulkSqVortexLondonFieldCalc::CalculateGrid() const {
@@ -366,12 +316,11 @@ void TBulkSqVortexLondonFieldCalc::CalculateGrid() const {
   double latConstSq(sqrt(fluxQuantum/field));
   double xisq_2_scaled(2.0*pow(xi*PI/latConstSq,2.0)), lambdasq_scaled(4.0*pow(lambda*PI/latConstSq,2.0));
 
-  const int NFFT(fSteps);
   const int NFFT_2(fSteps/2);
-  const int NFFTsq(fSteps*fSteps);
+  const int NGrid((NFFT_2 + 1)*(NFFT_2 + 1)); // size of the reduced grid
 
   #ifdef HAVE_GOMP
-  int chunk = NFFTsq/omp_get_num_procs();
+  int chunk = NGrid/omp_get_num_procs();
   if (chunk < 10)
     chunk = 10;
   #endif
@@ -384,7 +333,7 @@ void TBulkSqVortexLondonFieldCalc::CalculateGrid() const {
     #ifdef HAVE_GOMP
     #pragma omp parallel for default(shared) private(m) schedule(dynamic,chunk)
     #endif
-    for (m = 0; m < NFFTsq; m++) {
+    for (m = 0; m < NGrid; m++) {
       fFFTout[m] = field;
     }
     // Set the flag which shows that the calculation has been done
@@ -401,7 +350,7 @@ void TBulkSqVortexLondonFieldCalc::CalculateGrid() const {
   {
     #pragma omp section
   #endif
-    for (l = 0; l < NFFT_2; ++l) {
+    for (l = 0; l <= NFFT_2; ++l) {
       lNFFT_2 = l*(NFFT_2 + 1);
       ll = static_cast<double>(l*l);
       for (k = 0; k <= NFFT_2; ++k) {
@@ -411,31 +360,19 @@ void TBulkSqVortexLondonFieldCalc::CalculateGrid() const {
       }
     }
 
-    #ifdef HAVE_GOMP
-    #pragma omp section
-    #endif
-    for (l = NFFT_2; l < NFFT; ++l) {
-      lNFFT_2 = l*(NFFT_2 + 1);
-      ll = static_cast<double>((NFFT-l)*(NFFT-l));
-      for (k = 0; k <= NFFT_2; ++k) {
-        Gsq = static_cast<double>(k*k) + ll;
-        fFFTin[lNFFT_2 + k][0] = exp(-xisq_2_scaled*Gsq)/(1.0+lambdasq_scaled*Gsq);
-        fFFTin[lNFFT_2 + k][1] = 0.0;
-      }
-    }
   #ifdef HAVE_GOMP
   }
   #endif
 
   // Do the Fourier transform to get B(x,y)
 
-  fftw_execute(fFFTplan);
+  fftw_execute_r2r(fFFTplan, &fFFTin[0][0], fFFTout);
 
   // Multiply by the applied field
   #ifdef HAVE_GOMP
   #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
   #endif
-  for (l = 0; l < NFFTsq; ++l) {
+  for (l = 0; l < NGrid; ++l) {
     fFFTout[l] *= field;
   }
 
@@ -458,42 +395,22 @@ TBulkTriVortexMLFieldCalc::TBulkTriVortexMLFieldCalc(const std::string& wisdom,
   fParam.resize(3);
   fGridExists = false;
 
-#if !defined(_WIN32GCC) && defined(HAVE_LIBFFTW3_THREADS) && defined(HAVE_GOMP)
-  int init_threads(fftw_init_threads());
-  if (init_threads) {
-    fftw_plan_with_nthreads(omp_get_num_procs());
-  }
-#endif
-
-  fFFTin = new fftw_complex[(fSteps/2 + 1) * fSteps];
-  fFFTout = new double[fSteps*fSteps];
+  // only the first quadrant of the Fourier coefficients and of B(x,y) is needed (see CreateReducedGridPlan)
+  fFFTin = new fftw_complex[(fSteps/2 + 1) * (fSteps/2 + 1)];
+  fFFTout = new double[(fSteps/2 + 1) * (fSteps/2 + 1)];
 
 //  std::cout << "Check for the FFT plan..." << std::endl;
 
 // Load wisdom from file if it exists and should be used
 
-  fUseWisdom = true;
-  int wisdomLoaded(0);
-
-  FILE *wordsOfWisdomR;
-  wordsOfWisdomR = fopen(fWisdom.c_str(), "r");
-  if (wordsOfWisdomR == NULL) {
-    fUseWisdom = false;
-  } else {
-    wisdomLoaded = fftw_import_wisdom_from_file(wordsOfWisdomR);
-    fclose(wordsOfWisdomR);
-  }
-
-  if (!wisdomLoaded) {
-    fUseWisdom = false;
-  }
+  fUseWisdom = PFFTPlanManager::GetInstance()->ImportWisdom(fWisdom);
 
 // create the FFT plan
 
   if (fUseWisdom)
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_EXHAUSTIVE);
+    CreateReducedGridPlan(FFTW_EXHAUSTIVE);
   else
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_ESTIMATE);
+    CreateReducedGridPlan(FFTW_ESTIMATE);
 }
 
 void TBulkTriVortexMLFieldCalc::CalculateGrid() const {
@@ -510,12 +427,11 @@ void TBulkTriVortexMLFieldCalc::CalculateGrid() const {
   double field(fabs(fParam[0])), lambda(fabs(fParam[1])), xi(fabs(fParam[2]));
   double Hc2(getHc2(xi));
 
-  const int NFFT(fSteps);
   const int NFFT_2(fSteps/2);
-  const int NFFTsq(fSteps*fSteps);
+  const int NGrid((NFFT_2 + 1)*(NFFT_2 + 1)); // size of the reduced grid
 
   #ifdef HAVE_GOMP
-  int chunk = NFFTsq/omp_get_num_procs();
+  int chunk = NGrid/omp_get_num_procs();
   if (chunk < 10)
     chunk = 10;
   #endif
@@ -528,7 +444,7 @@ void TBulkTriVortexMLFieldCalc::CalculateGrid() const {
     #ifdef HAVE_GOMP
     #pragma omp parallel for default(shared) private(m) schedule(dynamic,chunk)
     #endif
-    for (m = 0; m < NFFTsq; ++m) {
+    for (m = 0; m < NGrid; ++m) {
       fFFTout[m] = field;
     }
     // Set the flag which shows that the calculation has been done
@@ -549,7 +465,7 @@ void TBulkTriVortexMLFieldCalc::CalculateGrid() const {
   {
     #pragma omp section
   #endif
-    for (l = 0; l < NFFT_2; l += 2) {
+    for (l = 0; l <= NFFT_2; l += 2) {
       lNFFT_2 = l*(NFFT_2 + 1);
       ll = 3.0*static_cast<double>(l*l);
       for (k = 0; k < NFFT_2; k += 2) {
@@ -565,30 +481,12 @@ void TBulkTriVortexMLFieldCalc::CalculateGrid() const {
       fFFTin[lNFFT_2 + k][1] = 0.0;
     }
 
-    #ifdef HAVE_GOMP
-    #pragma omp section
-    #endif
-    for (l = NFFT_2; l < NFFT; l += 2) {
-      lNFFT_2 = l*(NFFT_2 + 1);
-      ll = 3.0*static_cast<double>((NFFT-l)*(NFFT-l));
-      for (k = 0; k < NFFT_2; k += 2) {
-        Gsq = static_cast<double>(k*k) + ll;
-        fFFTin[lNFFT_2 + k][0] = exp(-xisq_2_scaled*Gsq)/(1.0+lambdasq_scaled*Gsq);
-        fFFTin[lNFFT_2 + k][1] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][0] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-      }
-      k = NFFT_2;
-      Gsq = static_cast<double>(k*k) + ll;
-      fFFTin[lNFFT_2 + k][0] = exp(-xisq_2_scaled*Gsq)/(1.0+lambdasq_scaled*Gsq);
-      fFFTin[lNFFT_2 + k][1] = 0.0;
-    }
 
     // intermediate rows
     #ifdef HAVE_GOMP
     #pragma omp section
     #endif
-    for (l = 1; l < NFFT_2; l += 2) {
+    for (l = 1; l <= NFFT_2; l += 2) {
       lNFFT_2 = l*(NFFT_2 + 1);
       ll = 3.0*static_cast<double>(l*l);
       for (k = 0; k < NFFT_2; k += 2) {
@@ -603,36 +501,19 @@ void TBulkTriVortexMLFieldCalc::CalculateGrid() const {
       fFFTin[lNFFT_2 + k][1] = 0.0;
     }
 
-    #ifdef HAVE_GOMP
-    #pragma omp section
-    #endif
-    for (l = NFFT_2 + 1; l < NFFT; l += 2) {
-      lNFFT_2 = l*(NFFT_2 + 1);
-      ll = 3.0*static_cast<double>((NFFT-l)*(NFFT-l));
-      for (k = 0; k < NFFT_2; k += 2) {
-        Gsq = static_cast<double>((k+1)*(k+1)) + ll;
-        fFFTin[lNFFT_2 + k][0] = 0.0;
-        fFFTin[lNFFT_2 + k][1] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][0] = exp(-xisq_2_scaled*Gsq)/(1.0+lambdasq_scaled*Gsq);
-        fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-      }
-      k = NFFT_2;
-      fFFTin[lNFFT_2 + k][0] = 0.0;
-      fFFTin[lNFFT_2 + k][1] = 0.0;
-    }
   #ifdef HAVE_GOMP
   }
   #endif
 
   // Do the Fourier transform to get B(x,y)
 
-  fftw_execute(fFFTplan);
+  fftw_execute_r2r(fFFTplan, &fFFTin[0][0], fFFTout);
 
   // Multiply by the applied field
   #ifdef HAVE_GOMP
   #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
   #endif
-  for (l = 0; l < NFFTsq; ++l) {
+  for (l = 0; l < NGrid; ++l) {
     fFFTout[l] *= field;
   }
 
@@ -654,42 +535,22 @@ TBulkTriVortexAGLFieldCalc::TBulkTriVortexAGLFieldCalc(const std::string& wisdom
   fParam.resize(3);
   fGridExists = false;
 
-#if !defined(_WIN32GCC) && defined(HAVE_LIBFFTW3_THREADS) && defined(HAVE_GOMP)
-  int init_threads(fftw_init_threads());
-  if (init_threads) {
-    fftw_plan_with_nthreads(omp_get_num_procs());
-  }
-#endif
-
-  fFFTin = new fftw_complex[(fSteps/2 + 1) * fSteps];
-  fFFTout = new double[fSteps*fSteps];
+  // only the first quadrant of the Fourier coefficients and of B(x,y) is needed (see CreateReducedGridPlan)
+  fFFTin = new fftw_complex[(fSteps/2 + 1) * (fSteps/2 + 1)];
+  fFFTout = new double[(fSteps/2 + 1) * (fSteps/2 + 1)];
 
 //  std::cout << "Check for the FFT plan..." << std::endl;
 
 // Load wisdom from file if it exists and should be used
 
-  fUseWisdom = true;
-  int wisdomLoaded(0);
-
-  FILE *wordsOfWisdomR;
-  wordsOfWisdomR = fopen(fWisdom.c_str(), "r");
-  if (wordsOfWisdomR == NULL) {
-    fUseWisdom = false;
-  } else {
-    wisdomLoaded = fftw_import_wisdom_from_file(wordsOfWisdomR);
-    fclose(wordsOfWisdomR);
-  }
-
-  if (!wisdomLoaded) {
-    fUseWisdom = false;
-  }
+  fUseWisdom = PFFTPlanManager::GetInstance()->ImportWisdom(fWisdom);
 
 // create the FFT plan
 
   if (fUseWisdom)
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_EXHAUSTIVE);
+    CreateReducedGridPlan(FFTW_EXHAUSTIVE);
   else
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_ESTIMATE);
+    CreateReducedGridPlan(FFTW_ESTIMATE);
 }
 
 void TBulkTriVortexAGLFieldCalc::CalculateGrid() const {
@@ -706,12 +567,11 @@ void TBulkTriVortexAGLFieldCalc::CalculateGrid() const {
   double field(fabs(fParam[0])), lambda(fabs(fParam[1])), xi(fabs(fParam[2]));
   double Hc2(getHc2(xi));
 
-  const int NFFT(fSteps);
   const int NFFT_2(fSteps/2);
-  const int NFFTsq(fSteps*fSteps);
+  const int NGrid((NFFT_2 + 1)*(NFFT_2 + 1)); // size of the reduced grid
 
   #ifdef HAVE_GOMP
-  int chunk = NFFTsq/omp_get_num_procs();
+  int chunk = NGrid/omp_get_num_procs();
   if (chunk < 10)
     chunk = 10;
   #endif
@@ -724,7 +584,7 @@ void TBulkTriVortexAGLFieldCalc::CalculateGrid() const {
     #ifdef HAVE_GOMP
     #pragma omp parallel for default(shared) private(m) schedule(dynamic,chunk)
     #endif
-    for (m = 0; m < NFFTsq; ++m) {
+    for (m = 0; m < NGrid; ++m) {
       fFFTout[m] = field;
     }
     // Set the flag which shows that the calculation has been done
@@ -745,7 +605,7 @@ void TBulkTriVortexAGLFieldCalc::CalculateGrid() const {
   {
     #pragma omp section
   #endif
-    for (l = 0; l < NFFT_2; l += 2) {
+    for (l = 0; l <= NFFT_2; l += 2) {
       lNFFT_2 = l*(NFFT_2 + 1);
       ll = 3.0*static_cast<double>(l*l);
       for (k = 0; k < NFFT_2; k += 2) {
@@ -764,33 +624,13 @@ void TBulkTriVortexAGLFieldCalc::CalculateGrid() const {
       fFFTin[lNFFT_2 + k][1] = 0.0;
     }
 
-    #ifdef HAVE_GOMP
-    #pragma omp section
-    #endif
-    for (l = NFFT_2; l < NFFT; l += 2) {
-      lNFFT_2 = l*(NFFT_2 + 1);
-      ll = 3.0*static_cast<double>((NFFT-l)*(NFFT-l));
-      for (k = 0; k < NFFT_2; k += 2) {
-        Gsq = static_cast<double>(k*k) + ll;
-        sqrtfInfSqPlusLsqGsq = sqrt(fInf*fInf + lambdasq_scaled*Gsq);
-        fFFTin[lNFFT_2 + k][0] = fInf*TMath::BesselK1(xiV/lambda*sqrtfInfSqPlusLsqGsq)/(sqrtfInfSqPlusLsqGsq*TMath::BesselK1(xiV/lambda*fInf));
-        fFFTin[lNFFT_2 + k][1] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][0] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-      }
-      k = NFFT_2;
-      Gsq = static_cast<double>(k*k) + ll;
-      sqrtfInfSqPlusLsqGsq = sqrt(fInf*fInf + lambdasq_scaled*Gsq);
-      fFFTin[lNFFT_2 + k][0] = fInf*TMath::BesselK1(xiV/lambda*sqrtfInfSqPlusLsqGsq)/(sqrtfInfSqPlusLsqGsq*TMath::BesselK1(xiV/lambda*fInf));
-      fFFTin[lNFFT_2 + k][1] = 0.0;
-    }
 
     // intermediate rows
 
     #ifdef HAVE_GOMP
     #pragma omp section
     #endif
-    for (l = 1; l < NFFT_2; l += 2) {
+    for (l = 1; l <= NFFT_2; l += 2) {
       lNFFT_2 = l*(NFFT_2 + 1);
       ll = 3.0*static_cast<double>(l*l);
       for (k = 0; k < NFFT_2; k += 2) {
@@ -806,37 +646,19 @@ void TBulkTriVortexAGLFieldCalc::CalculateGrid() const {
       fFFTin[lNFFT_2 + k][1] = 0.0;
     }
 
-    #ifdef HAVE_GOMP
-    #pragma omp section
-    #endif
-    for (l = NFFT_2 + 1; l < NFFT; l += 2) {
-      lNFFT_2 = l*(NFFT_2 + 1);
-      ll = 3.0*static_cast<double>((NFFT-l)*(NFFT-l));
-      for (k = 0; k < NFFT_2; k += 2) {
-        Gsq = static_cast<double>((k+1)*(k+1)) + ll;
-        sqrtfInfSqPlusLsqGsq = sqrt(fInf*fInf + lambdasq_scaled*Gsq);
-        fFFTin[lNFFT_2 + k][0] = 0.0;
-        fFFTin[lNFFT_2 + k][1] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][0] = fInf*TMath::BesselK1(xiV/lambda*sqrtfInfSqPlusLsqGsq)/(sqrtfInfSqPlusLsqGsq*TMath::BesselK1(xiV/lambda*fInf));
-        fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-      }
-      k = NFFT_2;
-      fFFTin[lNFFT_2 + k][0] = 0.0;
-      fFFTin[lNFFT_2 + k][1] = 0.0;
-    }
   #ifdef HAVE_GOMP
   }
   #endif
 
   // Do the Fourier transform to get B(x,y)
 
-  fftw_execute(fFFTplan);
+  fftw_execute_r2r(fFFTplan, &fFFTin[0][0], fFFTout);
 
   // Multiply by the applied field
   #ifdef HAVE_GOMP
   #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
   #endif
-  for (l = 0; l < NFFTsq; ++l) {
+  for (l = 0; l < NGrid; ++l) {
     fFFTout[l] *= field;
   }
 
@@ -859,42 +681,22 @@ TBulkTriVortexAGLIIFieldCalc::TBulkTriVortexAGLIIFieldCalc(const std::string& wi
   fParam.resize(3);
   fGridExists = false;
 
-#if !defined(_WIN32GCC) && defined(HAVE_LIBFFTW3_THREADS) && defined(HAVE_GOMP)
-  int init_threads(fftw_init_threads());
-  if (init_threads) {
-    fftw_plan_with_nthreads(omp_get_num_procs());
-  }
-#endif
-
-  fFFTin = new fftw_complex[(fSteps/2 + 1) * fSteps];
-  fFFTout = new double[fSteps*fSteps];
+  // only the first quadrant of the Fourier coefficients and of B(x,y) is needed (see CreateReducedGridPlan)
+  fFFTin = new fftw_complex[(fSteps/2 + 1) * (fSteps/2 + 1)];
+  fFFTout = new double[(fSteps/2 + 1) * (fSteps/2 + 1)];
 
 //  std::cout << "Check for the FFT plan..." << std::endl;
 
 // Load wisdom from file if it exists and should be used
 
-  fUseWisdom = true;
-  int wisdomLoaded(0);
-
-  FILE *wordsOfWisdomR;
-  wordsOfWisdomR = fopen(fWisdom.c_str(), "r");
-  if (wordsOfWisdomR == NULL) {
-    fUseWisdom = false;
-  } else {
-    wisdomLoaded = fftw_import_wisdom_from_file(wordsOfWisdomR);
-    fclose(wordsOfWisdomR);
-  }
-
-  if (!wisdomLoaded) {
-    fUseWisdom = false;
-  }
+  fUseWisdom = PFFTPlanManager::GetInstance()->ImportWisdom(fWisdom);
 
 // create the FFT plan
 
   if (fUseWisdom)
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_EXHAUSTIVE);
+    CreateReducedGridPlan(FFTW_EXHAUSTIVE);
   else
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_ESTIMATE);
+    CreateReducedGridPlan(FFTW_ESTIMATE);
 }
 
 void TBulkTriVortexAGLIIFieldCalc::CalculateGrid() const {
@@ -911,12 +713,11 @@ void TBulkTriVortexAGLIIFieldCalc::CalculateGrid() const {
   double field(fabs(fParam[0])), lambda(fabs(fParam[1])), xiV(fabs(fParam[2]));
   double Hc2(getHc2(xiV)); // use the vortex-core radius for Hc2-calculation (which is wrong since xi_GL should be used instead: one would therefore need one more parameter)
 
-  const int NFFT(fSteps);
   const int NFFT_2(fSteps/2);
-  const int NFFTsq(fSteps*fSteps);
+  const int NGrid((NFFT_2 + 1)*(NFFT_2 + 1)); // size of the reduced grid
 
   #ifdef HAVE_GOMP
-  int chunk = NFFTsq/omp_get_num_procs();
+  int chunk = NGrid/omp_get_num_procs();
   if (chunk < 10)
     chunk = 10;
   #endif
@@ -929,7 +730,7 @@ void TBulkTriVortexAGLIIFieldCalc::CalculateGrid() const {
     #ifdef HAVE_GOMP
     #pragma omp parallel for default(shared) private(m) schedule(dynamic,chunk)
     #endif
-    for (m = 0; m < NFFTsq; ++m) {
+    for (m = 0; m < NGrid; ++m) {
       fFFTout[m] = field;
     }
     // Set the flag which shows that the calculation has been done
@@ -951,7 +752,7 @@ void TBulkTriVortexAGLIIFieldCalc::CalculateGrid() const {
   {
     #pragma omp section
   #endif
-    for (l = 0; l < NFFT_2; l += 2) {
+    for (l = 0; l <= NFFT_2; l += 2) {
       lNFFT_2 = l*(NFFT_2 + 1);
       ll = 3.0*static_cast<double>(l*l);
       for (k = 0; k < NFFT_2; k += 2) {
@@ -970,32 +771,12 @@ void TBulkTriVortexAGLIIFieldCalc::CalculateGrid() const {
       fFFTin[lNFFT_2 + k][1] = 0.0;
     }
 
-    #ifdef HAVE_GOMP
-    #pragma omp section
-    #endif
-    for (l = NFFT_2; l < NFFT; l += 2) {
-      lNFFT_2 = l*(NFFT_2 + 1);
-      ll = 3.0*static_cast<double>((NFFT-l)*(NFFT-l));
-      for (k = 0; k < NFFT_2; k += 2) {
-        Gsq = static_cast<double>(k*k) + ll;
-        sqrtfInfSqPlusLsqGsq = sqrt(fInf*fInf + lambdasq_scaled*Gsq);
-        fFFTin[lNFFT_2 + k][0] = fInf*TMath::BesselK1(xiV/lambda*sqrtfInfSqPlusLsqGsq)/(sqrtfInfSqPlusLsqGsq*TMath::BesselK1(xiV/lambda*fInf));
-        fFFTin[lNFFT_2 + k][1] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][0] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-      }
-      k = NFFT_2;
-      Gsq = static_cast<double>(k*k) + ll;
-      sqrtfInfSqPlusLsqGsq = sqrt(fInf*fInf + lambdasq_scaled*Gsq);
-      fFFTin[lNFFT_2 + k][0] = fInf*TMath::BesselK1(xiV/lambda*sqrtfInfSqPlusLsqGsq)/(sqrtfInfSqPlusLsqGsq*TMath::BesselK1(xiV/lambda*fInf));
-      fFFTin[lNFFT_2 + k][1] = 0.0;
-    }
 
     // intermediate rows
     #ifdef HAVE_GOMP
     #pragma omp section
     #endif
-    for (l = 1; l < NFFT_2; l += 2) {
+    for (l = 1; l <= NFFT_2; l += 2) {
       lNFFT_2 = l*(NFFT_2 + 1);
       ll = 3.0*static_cast<double>(l*l);
       for (k = 0; k < NFFT_2; k += 2) {
@@ -1011,37 +792,19 @@ void TBulkTriVortexAGLIIFieldCalc::CalculateGrid() const {
       fFFTin[lNFFT_2 + k][1] = 0.0;
     }
 
-    #ifdef HAVE_GOMP
-    #pragma omp section
-    #endif
-    for (l = NFFT_2 + 1; l < NFFT; l += 2) {
-      lNFFT_2 = l*(NFFT_2 + 1);
-      ll = 3.0*static_cast<double>((NFFT-l)*(NFFT-l));
-      for (k = 0; k < NFFT_2; k += 2) {
-        Gsq = static_cast<double>((k+1)*(k+1)) + ll;
-        sqrtfInfSqPlusLsqGsq = sqrt(fInf*fInf + lambdasq_scaled*Gsq);
-        fFFTin[lNFFT_2 + k][0] = 0.0;
-        fFFTin[lNFFT_2 + k][1] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][0] = fInf*TMath::BesselK1(xiV/lambda*sqrtfInfSqPlusLsqGsq)/(sqrtfInfSqPlusLsqGsq*TMath::BesselK1(xiV/lambda*fInf));
-        fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-      }
-      k = NFFT_2;
-      fFFTin[lNFFT_2 + k][0] = 0.0;
-      fFFTin[lNFFT_2 + k][1] = 0.0;
-    }
   #ifdef HAVE_GOMP
   }
   #endif
 
   // Do the Fourier transform to get B(x,y)
 
-  fftw_execute(fFFTplan);
+  fftw_execute_r2r(fFFTplan, &fFFTin[0][0], fFFTout);
 
   // Multiply by the applied field
   #ifdef HAVE_GOMP
   #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
   #endif
-  for (l = 0; l < NFFTsq; ++l) {
+  for (l = 0; l < NGrid; ++l) {
     fFFTout[l] *= field;
   }
 
@@ -1054,7 +817,9 @@ void TBulkTriVortexAGLIIFieldCalc::CalculateGrid() const {
 
 
 TBulkTriVortexNGLFieldCalc::TBulkTriVortexNGLFieldCalc(const std::string& wisdom, const unsigned int steps)
- : fLatticeConstant(0.0), fKappa(0.0), fSumAk(0.0), fSumOmegaSq(0.0), fSumSum(0.0)
+ : fLatticeConstant(0.0), fKappa(0.0), fSumAk(0.0), fSumOmegaSq(0.0), fSumSum(0.0), fConvergenceTolerance(1.0E-3),
+   fWarmStartCacheSize(2), fWarmStartMaxRelDiff(0.01), fWarmStartNext(0), fNumberOfIterations(0), fSolveTime(0.0),
+   fWarmStarted(false)
 {
   fWisdom = wisdom;
   switch (steps % 4) {
@@ -1077,13 +842,6 @@ TBulkTriVortexNGLFieldCalc::TBulkTriVortexNGLFieldCalc(const std::string& wisdom
   fParam.resize(3);
   fGridExists = false;
 
-#if !defined(_WIN32GCC) && defined(HAVE_LIBFFTW3_THREADS) && defined(HAVE_GOMP)
-  int init_threads(fftw_init_threads());
-  if (init_threads) {
-    fftw_plan_with_nthreads(omp_get_num_procs());
-  }
-#endif
-
   const unsigned int stepsSq(fSteps*fSteps);
 
   fFFTout = new double[stepsSq];  // field B(x,y)
@@ -1102,37 +860,24 @@ TBulkTriVortexNGLFieldCalc::TBulkTriVortexNGLFieldCalc(const std::string& wisdom
 
 // Load wisdom from file if it exists and should be used
 
-  fUseWisdom = true;
-  int wisdomLoaded(0);
+  fUseWisdom = PFFTPlanManager::GetInstance()->ImportWisdom(fWisdom);
 
-  FILE *wordsOfWisdomR;
-  wordsOfWisdomR = fopen(fWisdom.c_str(), "r");
-  if (wordsOfWisdomR == NULL) {
-    fUseWisdom = false;
-  } else {
-    wisdomLoaded = fftw_import_wisdom_from_file(wordsOfWisdomR);
-    fclose(wordsOfWisdomR);
-  }
-
-  if (!wisdomLoaded) {
-    fUseWisdom = false;
-  }
+// get the (shared) FFT plans - they are owned by the PFFTPlanManager
 
-// create the FFT plans
+  PFFTPlanManager *planManager(PFFTPlanManager::GetInstance());
+  const int dims[2] = {static_cast<int>(fSteps), static_cast<int>(fSteps)};
 
   if (fUseWisdom) {
-    // use the first plan from the base class here - it will be destroyed by the base class destructor
-    fFFTplan = fftw_plan_dft_2d(fSteps, fSteps, fFFTin, fRealSpaceMatrix, FFTW_BACKWARD, FFTW_EXHAUSTIVE);
-    fFFTplanBkToBandQ = fftw_plan_dft_2d(fSteps, fSteps, fBkMatrix, fBkMatrix, FFTW_BACKWARD, FFTW_EXHAUSTIVE);
-    fFFTplanOmegaToAk = fftw_plan_dft_2d(fSteps, fSteps, fRealSpaceMatrix, fFFTin, FFTW_FORWARD, FFTW_EXHAUSTIVE);
-    fFFTplanOmegaToBk = fftw_plan_dft_2d(fSteps, fSteps, fBkMatrix, fBkMatrix, FFTW_FORWARD, FFTW_EXHAUSTIVE);
+    fFFTplan = planManager->GetPlanDft(2, dims, fFFTin, fRealSpaceMatrix, FFTW_BACKWARD, FFTW_EXHAUSTIVE);
+    fFFTplanBkToBandQ = planManager->GetPlanDft(2, dims, fBkMatrix, fBkMatrix, FFTW_BACKWARD, FFTW_EXHAUSTIVE);
+    fFFTplanOmegaToAk = planManager->GetPlanDft(2, dims, fRealSpaceMatrix, fFFTin, FFTW_FORWARD, FFTW_EXHAUSTIVE);
+    fFFTplanOmegaToBk = planManager->GetPlanDft(2, dims, fBkMatrix, fBkMatrix, FFTW_FORWARD, FFTW_EXHAUSTIVE);
   }
   else {
-    // use the first plan from the base class here - it will be destroyed by the base class destructor
-    fFFTplan = fftw_plan_dft_2d(fSteps, fSteps, fFFTin, fRealSpaceMatrix, FFTW_BACKWARD, FFTW_ESTIMATE);
-    fFFTplanBkToBandQ = fftw_plan_dft_2d(fSteps, fSteps, fBkMatrix, fBkMatrix, FFTW_BACKWARD, FFTW_ESTIMATE);
-    fFFTplanOmegaToAk = fftw_plan_dft_2d(fSteps, fSteps, fRealSpaceMatrix, fFFTin, FFTW_FORWARD, FFTW_ESTIMATE);
-    fFFTplanOmegaToBk = fftw_plan_dft_2d(fSteps, fSteps, fBkMatrix, fBkMatrix, FFTW_FORWARD, FFTW_ESTIMATE);
+    fFFTplan = planManager->GetPlanDft(2, dims, fFFTin, fRealSpaceMatrix, FFTW_BACKWARD, FFTW_ESTIMATE);
+    fFFTplanBkToBandQ = planManager->GetPlanDft(2, dims, fBkMatrix, fBkMatrix, FFTW_BACKWARD, FFTW_ESTIMATE);
+    fFFTplanOmegaToAk = planManager->GetPlanDft(2, dims, fRealSpaceMatrix, fFFTin, FFTW_FORWARD, FFTW_ESTIMATE);
+    fFFTplanOmegaToBk = planManager->GetPlanDft(2, dims, fBkMatrix, fBkMatrix, FFTW_FORWARD, FFTW_ESTIMATE);
   }
 }
 
@@ -1140,10 +885,6 @@ TBulkTriVortexNGLFieldCalc::~TBulkTriVortexNGLFieldCalc() {
 
   // clean up
 
-  fftw_destroy_plan(fFFTplanBkToBandQ);
-  fftw_destroy_plan(fFFTplanOmegaToAk);
-  fftw_destroy_plan(fFFTplanOmegaToBk);
-
   delete[] fOmegaMatrix; fOmegaMatrix = 0;
   delete[] fOmegaDiffMatrix; fOmegaDiffMatrix = 0;
 
@@ -1156,6 +897,116 @@ TBulkTriVortexNGLFieldCalc::~TBulkTriVortexNGLFieldCalc() {
   delete[] fCheckBkConvergence; fCheckBkConvergence = 0;
 }
 
+void TBulkTriVortexNGLFieldCalc::SetWarmStartCacheSize(const unsigned int size) {
+  fWarmStartCacheSize = size;
+  if (fWarmStartCache.size() > size)
+    fWarmStartCache.resize(size);
+  if (fWarmStartNext >= size)
+    fWarmStartNext = 0;
+  return;
+}
+
+/**
+ * <p>Search the cached converged states for the one calculated with the parameters closest to the present ones.
+ *
+ * <p><b>return:</b>
+ * - index of the cached state, if its largest relative parameter difference does not exceed fWarmStartMaxRelDiff
+ * - -1 otherwise
+ */
+int TBulkTriVortexNGLFieldCalc::FindWarmStartState() const {
+  int best(-1);
+  double bestDiff(fWarmStartMaxRelDiff), diff;
+  for (unsigned int i(0); i < fWarmStartCache.size(); ++i) {
+    diff = 0.0;
+    for (unsigned int j(0); j < 3; ++j) {
+      diff = std::max(diff, fabs(fabs(fParam[j]) - fWarmStartCache[i].fParam[j])/fabs(fParam[j]));
+    }
+    if (diff <= bestDiff) {
+      bestDiff = diff;
+      best = i;
+    }
+  }
+  return best;
+}
+
+void TBulkTriVortexNGLFieldCalc::RestoreWarmStartState(const int idx) const {
+  const TWarmStartState &state(fWarmStartCache[idx]);
+  const int NFFT(fSteps);
+  const int NFFTsq(fSteps*fSteps);
+  int l;
+
+  #ifdef HAVE_GOMP
+  int chunk = NFFTsq/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
+  #endif
+  for (l = 0; l < NFFTsq; ++l) {
+    fOmegaMatrix[l] = state.fOmega[l];
+    fOmegaDiffMatrix[l][0] = state.fOmegaDiff[2*l];
+    fOmegaDiffMatrix[l][1] = state.fOmegaDiff[2*l+1];
+    fQMatrix[l][0] = state.fQ[2*l];
+    fQMatrix[l][1] = state.fQ[2*l+1];
+    fFFTout[l] = state.fB[l];
+  }
+
+  for (l = 0; l < NFFT; ++l) {
+    fCheckAkConvergence[l] = state.fCheckAk[l];
+    fCheckBkConvergence[l] = state.fCheckBk[l];
+  }
+
+  return;
+}
+
+void TBulkTriVortexNGLFieldCalc::StoreWarmStartState() const {
+  if (!fWarmStartCacheSize)
+    return;
+
+  if (fWarmStartCache.size() < fWarmStartCacheSize) {
+    fWarmStartNext = fWarmStartCache.size();
+    fWarmStartCache.push_back(TWarmStartState());
+  }
+
+  TWarmStartState &state(fWarmStartCache[fWarmStartNext]);
+  const int NFFT(fSteps);
+  const int NFFTsq(fSteps*fSteps);
+  int l;
+
+  state.fParam.resize(3);
+  for (l = 0; l < 3; ++l)
+    state.fParam[l] = fabs(fParam[l]);
+  state.fOmega.resize(NFFTsq);
+  state.fOmegaDiff.resize(2*NFFTsq);
+  state.fQ.resize(2*NFFTsq);
+  state.fB.resize(NFFTsq);
+  state.fCheckAk.resize(NFFT);
+  state.fCheckBk.resize(NFFT);
+
+  #ifdef HAVE_GOMP
+  int chunk = NFFTsq/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
+  #endif
+  for (l = 0; l < NFFTsq; ++l) {
+    state.fOmega[l] = fOmegaMatrix[l];
+    state.fOmegaDiff[2*l] = fOmegaDiffMatrix[l][0];
+    state.fOmegaDiff[2*l+1] = fOmegaDiffMatrix[l][1];
+    state.fQ[2*l] = fQMatrix[l][0];
+    state.fQ[2*l+1] = fQMatrix[l][1];
+    state.fB[l] = fFFTout[l];
+  }
+
+  for (l = 0; l < NFFT; ++l) {
+    state.fCheckAk[l] = fCheckAkConvergence[l];
+    state.fCheckBk[l] = fCheckBkConvergence[l];
+  }
+
+  fWarmStartNext = (fWarmStartNext + 1) % fWarmStartCacheSize;
+
+  return;
+}
+
 void TBulkTriVortexNGLFieldCalc::CalculateGradient() const {
 
   // Calculate the gradient of omega stored in a fftw_complex array (dw/dx, dw/dy)
@@ -1221,7 +1072,7 @@ void TBulkTriVortexNGLFieldCalc::CalculateGradient() const {
   }
   #endif
 
-  fftw_execute(fFFTplan);
+  fftw_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
   // Copy the results to the gradient matrix and restore the original aK-matrix
   #ifdef HAVE_GOMP
@@ -1291,7 +1142,7 @@ void TBulkTriVortexNGLFieldCalc::CalculateGradient() const {
   }
   #endif
 
-  fftw_execute(fFFTplan);
+  fftw_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
   // Copy the results to the gradient matrix and restore the original aK-matrix
   #ifdef HAVE_GOMP
@@ -1916,6 +1767,10 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
     return;
   }
 
+  const std::chrono::steady_clock::time_point solveStart(std::chrono::steady_clock::now());
+  fNumberOfIterations = 0;
+  fWarmStarted = false;
+
   double field(fabs(fParam[0])), lambda(fabs(fParam[1])), xi(fabs(fParam[2]));
   fKappa = lambda/xi;
   double Hc2(getHc2(xi)), Hc2_kappa(Hc2/fKappa), scaledB(field/Hc2_kappa);  // field in Brandt's reduced units
@@ -1943,6 +1798,7 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
     for (m = 0; m < NFFTsq; ++m) {
       fFFTout[m] = field;
     }
+    fSolveTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count();
     // Set the flag which shows that the calculation has been done
     fGridExists = true;
     return;
@@ -1970,7 +1826,7 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
 
   // Do the Fourier transform to get omega(x,y) - Abrikosov
 
-  fftw_execute(fFFTplan);
+  fftw_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
   #ifdef HAVE_GOMP
   chunk = NFFTsq/omp_get_num_procs();
@@ -2027,8 +1883,21 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
   bool akConverged(false), bkConverged(false), akInitiallyConverged(false), firstBkCalculation(true);
   double fourKappaSq(4.0*fKappa*fKappa), sumSum, sumOmegaSq;
 
+  // If a previous calculation with similar parameters converged, start from its omega, Q and B instead of Abrikosov's solution.
+  // Q-Abrikosov is still needed for the Q-updates below.
+
+  const int warmStart(FindWarmStartState());
+  if (warmStart >= 0) {
+    RestoreWarmStartState(warmStart);
+    akInitiallyConverged = true;
+    firstBkCalculation = false;
+    fWarmStarted = true;
+  }
+
   while (!akConverged || !bkConverged) {
 
+    ++fNumberOfIterations;
+
     // First iteration step for aK
     #ifdef HAVE_GOMP
     chunk = NFFTsq/omp_get_num_procs();
@@ -2051,7 +1920,7 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
     fRealSpaceMatrix[0][0] = fRealSpaceMatrix[NFFT][0];
     fRealSpaceMatrix[(NFFT+1)*NFFT_2][0] = fRealSpaceMatrix[0][0];
 
-    fftw_execute(fFFTplanOmegaToAk);
+    fftw_execute_dft(fFFTplanOmegaToAk, fRealSpaceMatrix, fFFTin);
 
     ManipulateFourierCoefficientsA();
 
@@ -2075,7 +1944,7 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
 
     // Do the Fourier transform to get omega(x,y)
 
-    fftw_execute(fFFTplan);
+    fftw_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
     #ifdef HAVE_GOMP
     chunk = NFFTsq/omp_get_num_procs();
@@ -2130,7 +1999,7 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
 
     for (l = 0; l < NFFT; ++l) {
       if (fFFTin[l][0]){
-        if (((fabs(fFFTin[l][0]) > 1.0E-6) && (fabs(fCheckAkConvergence[l] - fFFTin[l][0])/fFFTin[l][0] > 1.0E-3)) || \
+        if (((fabs(fFFTin[l][0]) > 1.0E-6) && (fabs(fCheckAkConvergence[l] - fFFTin[l][0])/fFFTin[l][0] > fConvergenceTolerance)) || \
         (fCheckAkConvergence[l]/fFFTin[l][0] < 0.0)) {
           //std::cout << "old: " << fCheckAkConvergence[l] << ", new: " << fFFTin[l][0] << std::endl;
           akConverged = false;
@@ -2165,7 +2034,7 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
 
     // Do the Fourier transform to get omega(x,y)
 
-    fftw_execute(fFFTplan);
+    fftw_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
     #ifdef HAVE_GOMP
     chunk = NFFTsq/omp_get_num_procs();
@@ -2195,7 +2064,7 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
       fBkMatrix[0][0] = fBkMatrix[NFFT][0];
       fBkMatrix[(NFFT+1)*NFFT_2][0] = fBkMatrix[0][0];
 
-      fftw_execute(fFFTplanOmegaToBk);
+      fftw_execute_dft(fFFTplanOmegaToBk, fBkMatrix, fBkMatrix);
 
       ManipulateFourierCoefficientsB();
 
@@ -2219,7 +2088,7 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
 
       for (l = 0; l < NFFT; ++l) {
         if (fBkMatrix[l][0]) {
-          if (((fabs(fBkMatrix[l][0]) > 1.0E-6) && (fabs(fCheckBkConvergence[l] - fBkMatrix[l][0])/fabs(fBkMatrix[l][0]) > 1.0E-3)) || \
+          if (((fabs(fBkMatrix[l][0]) > 1.0E-6) && (fabs(fCheckBkConvergence[l] - fBkMatrix[l][0])/fabs(fBkMatrix[l][0]) > fConvergenceTolerance)) || \
           (fCheckBkConvergence[l]/fBkMatrix[l][0] < 0.0)) {
             // std::cout << "old: " << fCheckBkConvergence[l] << ", new: " << fBkMatrix[l][0] << std::endl;
             bkConverged = false;
@@ -2259,7 +2128,7 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
 
       // Fourier transform to get B(x,y)
 
-      fftw_execute(fFFTplanBkToBandQ);
+      fftw_execute_dft(fFFTplanBkToBandQ, fBkMatrix, fBkMatrix);
 
       #ifdef HAVE_GOMP
       #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
@@ -2284,7 +2153,7 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
 
       ManipulateFourierCoefficientsForQx();
 
-      fftw_execute(fFFTplanBkToBandQ);
+      fftw_execute_dft(fFFTplanBkToBandQ, fBkMatrix, fBkMatrix);
 
       #ifdef HAVE_GOMP
       #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
@@ -2307,7 +2176,7 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
 
       ManipulateFourierCoefficientsForQy();
 
-      fftw_execute(fFFTplanBkToBandQ);
+      fftw_execute_dft(fFFTplanBkToBandQ, fBkMatrix, fBkMatrix);
 
       #ifdef HAVE_GOMP
       #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
@@ -2318,6 +2187,8 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
     } // end if (akInitiallyConverged)
   } // end while
 
+  StoreWarmStartState();
+
   // If the iterations have converged, rescale the field from Brandt's units to Gauss
 
   #ifdef HAVE_GOMP
@@ -2330,6 +2201,8 @@ void TBulkTriVortexNGLFieldCalc::CalculateGrid() const {
     fFFTout[l] *= Hc2_kappa;
   }
 
+  fSolveTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count();
+
   // Set the flag which shows that the calculation has been done
 
   fGridExists = true;
@@ -2347,42 +2220,22 @@ TBulkAnisotropicTriVortexLondonFieldCalc::TBulkAnisotropicTriVortexLondonFieldCa
   fParam.resize(3);
   fGridExists = false;
 
-#if !defined(_WIN32GCC) && defined(HAVE_LIBFFTW3_THREADS) && defined(HAVE_GOMP)
-  int init_threads(fftw_init_threads());
-  if (init_threads) {
-    fftw_plan_with_nthreads(omp_get_num_procs());
-  }
-#endif
-
-  fFFTin = new fftw_complex[(fSteps/2 + 1) * fSteps];
-  fFFTout = new double[fSteps*fSteps];
+  // only the first quadrant of the Fourier coefficients and of B(x,y) is needed (see CreateReducedGridPlan)
+  fFFTin = new fftw_complex[(fSteps/2 + 1) * (fSteps/2 + 1)];
+  fFFTout = new double[(fSteps/2 + 1) * (fSteps/2 + 1)];
 
 //  std::cout << "Check for the FFT plan..." << std::endl;
 
 // Load wisdom from file if it exists and should be used
 
-  fUseWisdom = true;
-  int wisdomLoaded(0);
-
-  FILE *wordsOfWisdomR;
-  wordsOfWisdomR = fopen(fWisdom.c_str(), "r");
-  if (wordsOfWisdomR == NULL) {
-    fUseWisdom = false;
-  } else {
-    wisdomLoaded = fftw_import_wisdom_from_file(wordsOfWisdomR);
-    fclose(wordsOfWisdomR);
-  }
-
-  if (!wisdomLoaded) {
-    fUseWisdom = false;
-  }
+  fUseWisdom = PFFTPlanManager::GetInstance()->ImportWisdom(fWisdom);
 
 // create the FFT plan
 
   if (fUseWisdom)
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_EXHAUSTIVE);
+    CreateReducedGridPlan(FFTW_EXHAUSTIVE);
   else
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_ESTIMATE);
+    CreateReducedGridPlan(FFTW_ESTIMATE);
 }
 
 void TBulkAnisotropicTriVortexLondonFieldCalc::CalculateGrid() const {
@@ -2406,10 +2259,8 @@ void TBulkAnisotropicTriVortexLondonFieldCalc::CalculateGrid() const {
   double lambdaXsq_scaled(2.0*coeff*lambdaX*lambdaY);
   double lambdaYsq_scaled(3.0*lambdaXsq_scaled);
 
-  const int NFFT(fSteps);
   const int NFFT_2(fSteps/2);
-  const int NFFTsq(fSteps*fSteps);
-  const int NFFTsq_2((fSteps/2 + 1) * fSteps);
+  const int NGrid((NFFT_2 + 1)*(NFFT_2 + 1)); // size of the reduced grid
 
   #ifdef HAVE_GOMP
   int chunk;
@@ -2421,12 +2272,12 @@ void TBulkAnisotropicTriVortexLondonFieldCalc::CalculateGrid() const {
   if ((field >= Hc2) || (sqrt(lambdaX*lambdaY) < sqrt(xiX*xiY)/sqrt(2.0))) {
     int m;
     #ifdef HAVE_GOMP
-    chunk = NFFTsq/omp_get_num_procs();
+    chunk = NGrid/omp_get_num_procs();
     if (chunk < 10)
       chunk = 10;
     #pragma omp parallel for default(shared) private(m) schedule(dynamic,chunk)
     #endif
-    for (m = 0; m < NFFTsq; ++m) {
+    for (m = 0; m < NGrid; ++m) {
       fFFTout[m] = field;
     }
     // Set the flag which shows that the calculation has been done
@@ -2440,12 +2291,12 @@ void TBulkAnisotropicTriVortexLondonFieldCalc::CalculateGrid() const {
 
   // zero first everything since the r2c FFT changes the input, too
   #ifdef HAVE_GOMP
-  chunk = NFFTsq_2/omp_get_num_procs();
+  chunk = NGrid/omp_get_num_procs();
   if (chunk < 10)
     chunk = 10;
   #pragma omp parallel for default(shared) private(k) schedule(dynamic,chunk)
   #endif
-  for (k = 0; k < NFFTsq_2; ++k) {
+  for (k = 0; k < NGrid; ++k) {
     fFFTin[k][0] = 0.0;
     fFFTin[k][1] = 0.0;
   }
@@ -2455,7 +2306,7 @@ void TBulkAnisotropicTriVortexLondonFieldCalc::CalculateGrid() const {
   {
     #pragma omp section
   #endif
-    for (l = 0; l < NFFT_2; l += 2) {
+    for (l = 0; l <= NFFT_2; l += 2) {
       lNFFT_2 = l*(NFFT_2 + 1);
       ll = static_cast<double>(l*l);
       for (k = 0; k < NFFT_2; k += 2) {
@@ -2472,31 +2323,12 @@ void TBulkAnisotropicTriVortexLondonFieldCalc::CalculateGrid() const {
 //      fFFTin[lNFFT_2 + k][1] = 0.0;
     }
 
-    #ifdef HAVE_GOMP
-    #pragma omp section
-    #endif
-    for (l = NFFT_2; l < NFFT; l += 2) {
-      lNFFT_2 = l*(NFFT_2 + 1);
-      ll = static_cast<double>((NFFT-l)*(NFFT-l));
-      for (k = 0; k < NFFT_2; k += 2) {
-        kk = static_cast<double>(k*k);
-        fFFTin[lNFFT_2 + k][0] = exp(-(xiXsq_2_scaled*kk + xiYsq_2_scaled*ll))/(1.0+lambdaXsq_scaled*ll+lambdaYsq_scaled*kk);
-//            fFFTin[lNFFT_2 + k][1] = 0.0;
-//            fFFTin[lNFFT_2 + k + 1][0] = 0.0;
-//            fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-      }
-
-      k = NFFT_2;
-      kk = static_cast<double>(k*k);
-      fFFTin[lNFFT_2 + k][0] = exp(-(xiXsq_2_scaled*kk + xiYsq_2_scaled*ll))/(1.0+lambdaXsq_scaled*ll+lambdaYsq_scaled*kk);
-//          fFFTin[lNFFT_2 + k][1] = 0.0;
-    }
 
     // intermediate rows
     #ifdef HAVE_GOMP
     #pragma omp section
     #endif
-    for (l = 1; l < NFFT_2; l += 2) {
+    for (l = 1; l <= NFFT_2; l += 2) {
       lNFFT_2 = l*(NFFT_2 + 1);
       ll = static_cast<double>(l*l);
       for (k = 0; k < NFFT_2; k += 2) {
@@ -2511,39 +2343,22 @@ void TBulkAnisotropicTriVortexLondonFieldCalc::CalculateGrid() const {
 //          fFFTin[lNFFT_2 + k][1] = 0.0;
     }
 
-    #ifdef HAVE_GOMP
-    #pragma omp section
-    #endif
-    for (l = NFFT_2 + 1; l < NFFT; l += 2) {
-      lNFFT_2 = l*(NFFT_2 + 1);
-      ll = static_cast<double>((NFFT-l)*(NFFT-l));
-      for (k = 0; k < NFFT_2; k += 2) {
-        kk = static_cast<double>((k+1)*(k+1));
-//            fFFTin[lNFFT_2 + k][0] = 0.0;
-//            fFFTin[lNFFT_2 + k][1] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][0] = exp(-(xiXsq_2_scaled*kk + xiYsq_2_scaled*ll))/(1.0+lambdaXsq_scaled*ll+lambdaYsq_scaled*kk);
-//           fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-      }
-      k = NFFT_2;
-//          fFFTin[lNFFT_2 + k][0] = 0.0;
-//          fFFTin[lNFFT_2 + k][1] = 0.0;
-    }
   #ifdef HAVE_GOMP
   }
   #endif
 
   // Do the Fourier transform to get B(x,y)
 
-  fftw_execute(fFFTplan);
+  fftw_execute_r2r(fFFTplan, &fFFTin[0][0], fFFTout);
 
   // Multiply by the applied field
   #ifdef HAVE_GOMP
-  chunk = NFFTsq/omp_get_num_procs();
+  chunk = NGrid/omp_get_num_procs();
   if (chunk < 10)
     chunk = 10;
   #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
   #endif
-  for (l = 0; l < NFFTsq; ++l) {
+  for (l = 0; l < NGrid; ++l) {
     fFFTout[l] *= field;
   }
 
@@ -2564,42 +2379,22 @@ TBulkAnisotropicTriVortexMLFieldCalc::TBulkAnisotropicTriVortexMLFieldCalc(const
   fParam.resize(3);
   fGridExists = false;
 
-#if !defined(_WIN32GCC) && defined(HAVE_LIBFFTW3_THREADS) && defined(HAVE_GOMP)
-  int init_threads(fftw_init_threads());
-  if (init_threads) {
-    fftw_plan_with_nthreads(omp_get_num_procs());
-  }
-#endif
-
-  fFFTin = new fftw_complex[(fSteps/2 + 1) * fSteps];
-  fFFTout = new double[fSteps*fSteps];
+  // only the first quadrant of the Fourier coefficients and of B(x,y) is needed (see CreateReducedGridPlan)
+  fFFTin = new fftw_complex[(fSteps/2 + 1) * (fSteps/2 + 1)];
+  fFFTout = new double[(fSteps/2 + 1) * (fSteps/2 + 1)];
 
 //  std::cout << "Check for the FFT plan..." << std::endl;
 
 // Load wisdom from file if it exists and should be used
 
-  fUseWisdom = true;
-  int wisdomLoaded(0);
-
-  FILE *wordsOfWisdomR;
-  wordsOfWisdomR = fopen(fWisdom.c_str(), "r");
-  if (wordsOfWisdomR == NULL) {
-    fUseWisdom = false;
-  } else {
-    wisdomLoaded = fftw_import_wisdom_from_file(wordsOfWisdomR);
-    fclose(wordsOfWisdomR);
-  }
-
-  if (!wisdomLoaded) {
-    fUseWisdom = false;
-  }
+  fUseWisdom = PFFTPlanManager::GetInstance()->ImportWisdom(fWisdom);
 
 // create the FFT plan
 
   if (fUseWisdom)
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_EXHAUSTIVE);
+    CreateReducedGridPlan(FFTW_EXHAUSTIVE);
   else
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_ESTIMATE);
+    CreateReducedGridPlan(FFTW_ESTIMATE);
 }
 
 void TBulkAnisotropicTriVortexMLFieldCalc::CalculateGrid() const {
@@ -2624,12 +2419,11 @@ void TBulkAnisotropicTriVortexMLFieldCalc::CalculateGrid() const {
   double lambdaXsq_scaled(2.0*coeff*lambdaX*lambdaY);
   double lambdaYsq_scaled(3.0*lambdaXsq_scaled);
 
-  const int NFFT(fSteps);
   const int NFFT_2(fSteps/2);
-  const int NFFTsq(fSteps*fSteps);
+  const int NGrid((NFFT_2 + 1)*(NFFT_2 + 1)); // size of the reduced grid
 
   #ifdef HAVE_GOMP
-  int chunk = NFFTsq/omp_get_num_procs();
+  int chunk = NGrid/omp_get_num_procs();
   if (chunk < 10)
     chunk = 10;
   #endif
@@ -2642,7 +2436,7 @@ void TBulkAnisotropicTriVortexMLFieldCalc::CalculateGrid() const {
     #ifdef HAVE_GOMP
     #pragma omp parallel for default(shared) private(m) schedule(dynamic,chunk)
     #endif
-    for (m = 0; m < NFFTsq; ++m) {
+    for (m = 0; m < NGrid; ++m) {
       fFFTout[m] = field;
     }
     // Set the flag which shows that the calculation has been done
@@ -2659,7 +2453,7 @@ void TBulkAnisotropicTriVortexMLFieldCalc::CalculateGrid() const {
   {
     #pragma omp section
   #endif
-    for (l = 0; l < NFFT_2; l += 2) {
+    for (l = 0; l <= NFFT_2; l += 2) {
       lNFFT_2 = l*(NFFT_2 + 1);
       ll = static_cast<double>(l*l);
       for (k = 0; k < NFFT_2; k += 2) {
@@ -2675,30 +2469,12 @@ void TBulkAnisotropicTriVortexMLFieldCalc::CalculateGrid() const {
       fFFTin[lNFFT_2 + k][1] = 0.0;
     }
 
-    #ifdef HAVE_GOMP
-    #pragma omp section
-    #endif
-    for (l = NFFT_2; l < NFFT; l += 2) {
-      lNFFT_2 = l*(NFFT_2 + 1);
-      ll = static_cast<double>((NFFT-l)*(NFFT-l));
-      for (k = 0; k < NFFT_2; k += 2) {
-        kk = static_cast<double>(k*k);
-        fFFTin[lNFFT_2 + k][0] = exp(-(xiXsq_2_scaled*kk + xiYsq_2_scaled*ll))/(1.0+lambdaXsq_scaled*ll+lambdaYsq_scaled*kk);
-        fFFTin[lNFFT_2 + k][1] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][0] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-      }
-      k = NFFT_2;
-      kk = static_cast<double>(k*k);
-      fFFTin[lNFFT_2 + k][0] = exp(-(xiXsq_2_scaled*kk + xiYsq_2_scaled*ll))/(1.0+lambdaXsq_scaled*ll+lambdaYsq_scaled*kk);
-      fFFTin[lNFFT_2 + k][1] = 0.0;
-    }
 
     // intermediate rows
     #ifdef HAVE_GOMP
     #pragma omp section
     #endif
-    for (l = 1; l < NFFT_2; l += 2) {
+    for (l = 1; l <= NFFT_2; l += 2) {
       lNFFT_2 = l*(NFFT_2 + 1);
       ll = static_cast<double>(l*l);
       for (k = 0; k < NFFT_2; k += 2) {
@@ -2713,36 +2489,19 @@ void TBulkAnisotropicTriVortexMLFieldCalc::CalculateGrid() const {
       fFFTin[lNFFT_2 + k][1] = 0.0;
     }
 
-    #ifdef HAVE_GOMP
-    #pragma omp section
-    #endif
-    for (l = NFFT_2 + 1; l < NFFT; l += 2) {
-      lNFFT_2 = l*(NFFT_2 + 1);
-      ll = static_cast<double>((NFFT-l)*(NFFT-l));
-      for (k = 0; k < NFFT_2; k += 2) {
-        kk = static_cast<double>((k+1)*(k+1));
-        fFFTin[lNFFT_2 + k][0] = 0.0;
-        fFFTin[lNFFT_2 + k][1] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][0] = exp(-(xiXsq_2_scaled*kk + xiYsq_2_scaled*ll))/(1.0+lambdaXsq_scaled*ll+lambdaYsq_scaled*kk);
-        fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-      }
-      k = NFFT_2;
-      fFFTin[lNFFT_2 + k][0] = 0.0;
-      fFFTin[lNFFT_2 + k][1] = 0.0;
-    }
   #ifdef HAVE_GOMP
   }
   #endif
 
   // Do the Fourier transform to get B(x,y)
 
-  fftw_execute(fFFTplan);
+  fftw_execute_r2r(fFFTplan, &fFFTin[0][0], fFFTout);
 
   // Multiply by the applied field
   #ifdef HAVE_GOMP
   #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
   #endif
-  for (l = 0; l < NFFTsq; ++l) {
+  for (l = 0; l < NGrid; ++l) {
     fFFTout[l] *= field;
   }
 
@@ -2763,42 +2522,22 @@ TBulkAnisotropicTriVortexAGLFieldCalc::TBulkAnisotropicTriVortexAGLFieldCalc(con
   fParam.resize(3);
   fGridExists = false;
 
-#if !defined(_WIN32GCC) && defined(HAVE_LIBFFTW3_THREADS) && defined(HAVE_GOMP)
-  int init_threads(fftw_init_threads());
-  if (init_threads) {
-    fftw_plan_with_nthreads(omp_get_num_procs());
-  }
-#endif
-
-  fFFTin = new fftw_complex[(fSteps/2 + 1) * fSteps];
-  fFFTout = new double[fSteps*fSteps];
+  // only the first quadrant of the Fourier coefficients and of B(x,y) is needed (see CreateReducedGridPlan)
+  fFFTin = new fftw_complex[(fSteps/2 + 1) * (fSteps/2 + 1)];
+  fFFTout = new double[(fSteps/2 + 1) * (fSteps/2 + 1)];
 
 //  std::cout << "Check for the FFT plan..." << std::endl;
 
 // Load wisdom from file if it exists and should be used
 
-  fUseWisdom = true;
-  int wisdomLoaded(0);
-
-  FILE *wordsOfWisdomR;
-  wordsOfWisdomR = fopen(fWisdom.c_str(), "r");
-  if (wordsOfWisdomR == NULL) {
-    fUseWisdom = false;
-  } else {
-    wisdomLoaded = fftw_import_wisdom_from_file(wordsOfWisdomR);
-    fclose(wordsOfWisdomR);
-  }
-
-  if (!wisdomLoaded) {
-    fUseWisdom = false;
-  }
+  fUseWisdom = PFFTPlanManager::GetInstance()->ImportWisdom(fWisdom);
 
 // create the FFT plan
 
   if (fUseWisdom)
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_EXHAUSTIVE);
+    CreateReducedGridPlan(FFTW_EXHAUSTIVE);
   else
-    fFFTplan = fftw_plan_dft_c2r_2d(fSteps, fSteps, fFFTin, fFFTout, FFTW_ESTIMATE);
+    CreateReducedGridPlan(FFTW_ESTIMATE);
 }
 
 void TBulkAnisotropicTriVortexAGLFieldCalc::CalculateGrid() const {
@@ -2826,12 +2565,11 @@ void TBulkAnisotropicTriVortexAGLFieldCalc::CalculateGrid() const {
   double lambdaXsq_scaled(coeff*lambdaX*lambdaY);
   double lambdaYsq_scaled(3.0*lambdaXsq_scaled);
 
-  const int NFFT(fSteps);
   const int NFFT_2(fSteps/2);
-  const int NFFTsq(fSteps*fSteps);
+  const int NGrid((NFFT_2 + 1)*(NFFT_2 + 1)); // size of the reduced grid
 
   #ifdef HAVE_GOMP
-  int chunk = NFFTsq/omp_get_num_procs();
+  int chunk = NGrid/omp_get_num_procs();
   if (chunk < 10)
     chunk = 10;
   #endif
@@ -2844,7 +2582,7 @@ void TBulkAnisotropicTriVortexAGLFieldCalc::CalculateGrid() const {
     #ifdef HAVE_GOMP
     #pragma omp parallel for default(shared) private(m) schedule(dynamic,chunk)
     #endif
-    for (m = 0; m < NFFTsq; ++m) {
+    for (m = 0; m < NGrid; ++m) {
       fFFTout[m] = field;
     }
     // Set the flag which shows that the calculation has been done
@@ -2861,7 +2599,7 @@ void TBulkAnisotropicTriVortexAGLFieldCalc::CalculateGrid() const {
   {
     #pragma omp section
   #endif
-    for (l = 0; l < NFFT_2; l += 2) {
+    for (l = 0; l <= NFFT_2; l += 2) {
       lNFFT_2 = l*(NFFT_2 + 1);
       ll = static_cast<double>(l*l);
       for (k = 0; k < NFFT_2; k += 2) {
@@ -2879,32 +2617,12 @@ void TBulkAnisotropicTriVortexAGLFieldCalc::CalculateGrid() const {
       fFFTin[lNFFT_2 + k][1] = 0.0;
     }
 
-    #ifdef HAVE_GOMP
-    #pragma omp section
-    #endif
-    for (l = NFFT_2; l < NFFT; l += 2) {
-      lNFFT_2 = l*(NFFT_2 + 1);
-      ll = static_cast<double>((NFFT-l)*(NFFT-l));
-      for (k = 0; k < NFFT_2; k += 2) {
-        kk = static_cast<double>(k*k);
-        u = sqrt(xiXsq_scaled*kk + xiYsq_scaled*ll);
-        fFFTin[lNFFT_2 + k][0] = coeff1*u*TMath::BesselK1(u)/(lambdaXsq_scaled*ll+lambdaYsq_scaled*kk);
-        fFFTin[lNFFT_2 + k][1] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][0] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-      }
-      k = NFFT_2;
-      kk = static_cast<double>(k*k);
-      u = sqrt(xiXsq_scaled*kk + xiYsq_scaled*ll);
-      fFFTin[lNFFT_2 + k][0] = coeff1*u*TMath::BesselK1(u)/(lambdaXsq_scaled*ll+lambdaYsq_scaled*kk);
-      fFFTin[lNFFT_2 + k][1] = 0.0;
-    }
 
     // intermediate rows
     #ifdef HAVE_GOMP
     #pragma omp section
     #endif
-    for (l = 1; l < NFFT_2; l += 2) {
+    for (l = 1; l <= NFFT_2; l += 2) {
       lNFFT_2 = l*(NFFT_2 + 1);
       ll = static_cast<double>(l*l);
       for (k = 0; k < NFFT_2; k += 2) {
@@ -2920,37 +2638,19 @@ void TBulkAnisotropicTriVortexAGLFieldCalc::CalculateGrid() const {
       fFFTin[lNFFT_2 + k][1] = 0.0;
     }
 
-    #ifdef HAVE_GOMP
-    #pragma omp section
-    #endif
-    for (l = NFFT_2 + 1; l < NFFT; l += 2) {
-      lNFFT_2 = l*(NFFT_2 + 1);
-      ll = static_cast<double>((NFFT-l)*(NFFT-l));
-      for (k = 0; k < NFFT_2; k += 2) {
-        kk = static_cast<double>((k+1)*(k+1));
-        u = sqrt(xiXsq_scaled*kk + xiYsq_scaled*ll);
-        fFFTin[lNFFT_2 + k][0] = 0.0;
-        fFFTin[lNFFT_2 + k][1] = 0.0;
-        fFFTin[lNFFT_2 + k + 1][0] = coeff1*u*TMath::BesselK1(u)/(lambdaXsq_scaled*ll+lambdaYsq_scaled*kk);
-        fFFTin[lNFFT_2 + k + 1][1] = 0.0;
-      }
-      k = NFFT_2;
-      fFFTin[lNFFT_2 + k][0] = 0.0;
-      fFFTin[lNFFT_2 + k][1] = 0.0;
-    }
   #ifdef HAVE_GOMP
   }
   #endif
 
   // Do the Fourier transform to get B(x,y)
 
-  fftw_execute(fFFTplan);
+  fftw_execute_r2r(fFFTplan, &fFFTin[0][0], fFFTout);
 
   // Multiply by the applied field
   #ifdef HAVE_GOMP
   #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
   #endif
-  for (l = 0; l < NFFTsq; ++l) {
+  for (l = 0; l < NGrid; ++l) {
     fFFTout[l] *= field;
   }
 
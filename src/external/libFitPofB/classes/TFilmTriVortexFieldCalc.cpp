@@ -32,9 +32,12 @@
 #endif
 
 #include "TFilmTriVortexFieldCalc.h"
+#include "PFFTPlanManager.h"
 
 #include <cstdlib>
 #include <cmath>
+#include <chrono>
+#include <algorithm>
 
 #ifdef HAVE_GOMP
 #include <omp.h>
@@ -54,21 +57,7 @@ const float pi_4sqrt3(0.25f*PI/sqrt(3.0f));
 
 
 TFilmVortexFieldCalc::~TFilmVortexFieldCalc() {
-  // if a wisdom file is used export the wisdom so it has not to be checked for the FFT-plan next time
-  if (fUseWisdom) {
-    FILE *wordsOfWisdomW;
-    wordsOfWisdomW = fopen(fWisdom.c_str(), "w");
-    if (wordsOfWisdomW == NULL) {
-      std::cout << "TFilmVortexFieldCalc::~TFilmVortexFieldCalc(): Could not open file ... No wisdom is exported..." << std::endl;
-    } else {
-      fftwf_export_wisdom_to_file(wordsOfWisdomW);
-      fclose(wordsOfWisdomW);
-    }
-  }
-
-  // clean up
-
-  fftwf_destroy_plan(fFFTplan);
+  // clean up - the FFT plans are owned by the PFFTPlanManager which also exports the wisdom
 
   delete[] fFFTin; fFFTin = nullptr;
 
@@ -117,7 +106,9 @@ float TFilmVortexFieldCalc::GetBmax() const {
 
 
 TFilmTriVortexNGLFieldCalc::TFilmTriVortexNGLFieldCalc(const std::string& wisdom, const unsigned int steps, const unsigned int stepsZ)
- : fLatticeConstant(0.0), fKappa(0.0), fSumOmegaSq(0.0), fSumSum(0.0), fFind3dSolution(false)
+ : fLatticeConstant(0.0), fKappa(0.0), fSumOmegaSq(0.0), fSumSum(0.0), fFind3dSolution(false), fConvergenceTolerance(5.0E-3f),
+   fWarmStartCacheSize(2), fWarmStartMaxRelDiff(0.01f), fWarmStartNext(0), fNumberOfIterations(0), fSolveTime(0.0),
+   fWarmStarted(false)
 {
 //  std::cout << "TFilmTriVortexNGLFieldCalc::TFilmTriVortexNGLFieldCalc... ";
 
@@ -152,13 +143,6 @@ TFilmTriVortexNGLFieldCalc::TFilmTriVortexNGLFieldCalc(const std::string& wisdom
   fParam.resize(3);
   fGridExists = false;
 
-#if !defined(_WIN32GCC) && defined(HAVE_LIBFFTW3F_THREADS) && defined(HAVE_GOMP)
-  int init_threads(fftwf_init_threads());
-  if (init_threads) {
-    fftwf_plan_with_nthreads(omp_get_num_procs());
-  }
-#endif
-
   const unsigned int stepsSqStZ(fSteps*fSteps*fStepsZ);
 
   float* temp;
@@ -195,45 +179,33 @@ TFilmTriVortexNGLFieldCalc::TFilmTriVortexNGLFieldCalc(const std::string& wisdom
 
 // Load wisdom from file if it exists and should be used
 
-  fUseWisdom = true;
-  int wisdomLoaded(0);
+  PFFTPlanManager *planManager(PFFTPlanManager::GetInstance());
+  fUseWisdom = planManager->ImportWisdom(fWisdom, true);
 
-  FILE *wordsOfWisdomR;
-  wordsOfWisdomR = fopen(fWisdom.c_str(), "r");
-  if (wordsOfWisdomR == nullptr) {
-    fUseWisdom = false;
-  } else {
-    wisdomLoaded = fftwf_import_wisdom_from_file(wordsOfWisdomR);
-    fclose(wordsOfWisdomR);
-  }
-
-  if (!wisdomLoaded) {
-    fUseWisdom = false;
-  }
+// get the (shared) FFT plans - they are owned by the PFFTPlanManager
 
-// create the FFT plans
+  const int dims[3] = {static_cast<int>(fSteps), static_cast<int>(fSteps), static_cast<int>(fStepsZ)};
+  const int dimsZ(static_cast<int>(fStepsZ));
 
   if (fUseWisdom) {
 //    std::cout << "use wisdom ... ";
-    // use the first plan from the base class here - it will be destroyed by the base class destructor
-    fFFTplan = fftwf_plan_dft_3d(fSteps, fSteps, fStepsZ, fFFTin, fRealSpaceMatrix, FFTW_BACKWARD, FFTW_EXHAUSTIVE);
-    fFFTplanBkToBandQ = fftwf_plan_dft_3d(fSteps, fSteps, fStepsZ, fBkMatrix, fBkMatrix, FFTW_BACKWARD, FFTW_EXHAUSTIVE);
-    fFFTplanOmegaToAk = fftwf_plan_dft_3d(fSteps, fSteps, fStepsZ, fRealSpaceMatrix, fFFTin, FFTW_FORWARD, FFTW_EXHAUSTIVE);
-    fFFTplanForSumAk = fftwf_plan_dft_1d(fStepsZ, fSumAkFFTin, fSumAk, FFTW_FORWARD, FFTW_EXHAUSTIVE);
-    fFFTplanForPk1 = fftwf_plan_dft_3d(fSteps, fSteps, fStepsZ, fPkMatrix, fPkMatrix, FFTW_FORWARD, FFTW_EXHAUSTIVE);
-    fFFTplanForPk2 = fftwf_plan_dft_3d(fSteps, fSteps, fStepsZ, fQMatrix, fQMatrix, FFTW_BACKWARD, FFTW_EXHAUSTIVE);
-    fFFTplanForBatSurf = fftwf_plan_dft_2d(fSteps, fSteps, fBkS, fBkS, FFTW_FORWARD, FFTW_EXHAUSTIVE);
+    fFFTplan = planManager->GetPlanDft(3, dims, fFFTin, fRealSpaceMatrix, FFTW_BACKWARD, FFTW_EXHAUSTIVE);
+    fFFTplanBkToBandQ = planManager->GetPlanDft(3, dims, fBkMatrix, fBkMatrix, FFTW_BACKWARD, FFTW_EXHAUSTIVE);
+    fFFTplanOmegaToAk = planManager->GetPlanDft(3, dims, fRealSpaceMatrix, fFFTin, FFTW_FORWARD, FFTW_EXHAUSTIVE);
+    fFFTplanForSumAk = planManager->GetPlanDft(1, &dimsZ, fSumAkFFTin, fSumAk, FFTW_FORWARD, FFTW_EXHAUSTIVE);
+    fFFTplanForPk1 = planManager->GetPlanDft(3, dims, fPkMatrix, fPkMatrix, FFTW_FORWARD, FFTW_EXHAUSTIVE);
+    fFFTplanForPk2 = planManager->GetPlanDft(3, dims, fQMatrix, fQMatrix, FFTW_BACKWARD, FFTW_EXHAUSTIVE);
+    fFFTplanForBatSurf = planManager->GetPlanDft(2, dims, fBkS, fBkS, FFTW_FORWARD, FFTW_EXHAUSTIVE);
   }
   else {
 //    std::cout << "do not use wisdom ... ";
-    // use the first plan from the base class here - it will be destroyed by the base class destructor
-    fFFTplan = fftwf_plan_dft_3d(fSteps, fSteps, fStepsZ, fFFTin, fRealSpaceMatrix, FFTW_BACKWARD, FFTW_ESTIMATE);
-    fFFTplanBkToBandQ = fftwf_plan_dft_3d(fSteps, fSteps, fStepsZ, fBkMatrix, fBkMatrix, FFTW_BACKWARD, FFTW_ESTIMATE);
-    fFFTplanOmegaToAk = fftwf_plan_dft_3d(fSteps, fSteps, fStepsZ, fRealSpaceMatrix, fFFTin, FFTW_FORWARD, FFTW_ESTIMATE);
-    fFFTplanForSumAk = fftwf_plan_dft_1d(fStepsZ, fSumAkFFTin, fSumAk, FFTW_FORWARD, FFTW_ESTIMATE);
-    fFFTplanForPk1 = fftwf_plan_dft_3d(fSteps, fSteps, fStepsZ, fPkMatrix, fPkMatrix, FFTW_FORWARD, FFTW_ESTIMATE);
-    fFFTplanForPk2 = fftwf_plan_dft_3d(fSteps, fSteps, fStepsZ, fQMatrix, fQMatrix, FFTW_BACKWARD, FFTW_ESTIMATE);
-    fFFTplanForBatSurf = fftwf_plan_dft_2d(fSteps, fSteps, fBkS, fBkS, FFTW_FORWARD, FFTW_ESTIMATE);
+    fFFTplan = planManager->GetPlanDft(3, dims, fFFTin, fRealSpaceMatrix, FFTW_BACKWARD, FFTW_ESTIMATE);
+    fFFTplanBkToBandQ = planManager->GetPlanDft(3, dims, fBkMatrix, fBkMatrix, FFTW_BACKWARD, FFTW_ESTIMATE);
+    fFFTplanOmegaToAk = planManager->GetPlanDft(3, dims, fRealSpaceMatrix, fFFTin, FFTW_FORWARD, FFTW_ESTIMATE);
+    fFFTplanForSumAk = planManager->GetPlanDft(1, &dimsZ, fSumAkFFTin, fSumAk, FFTW_FORWARD, FFTW_ESTIMATE);
+    fFFTplanForPk1 = planManager->GetPlanDft(3, dims, fPkMatrix, fPkMatrix, FFTW_FORWARD, FFTW_ESTIMATE);
+    fFFTplanForPk2 = planManager->GetPlanDft(3, dims, fQMatrix, fQMatrix, FFTW_BACKWARD, FFTW_ESTIMATE);
+    fFFTplanForBatSurf = planManager->GetPlanDft(2, dims, fBkS, fBkS, FFTW_FORWARD, FFTW_ESTIMATE);
   }
 //  std::cout << "done" << endl;
 }
@@ -241,12 +213,6 @@ TFilmTriVortexNGLFieldCalc::TFilmTriVortexNGLFieldCalc(const std::string& wisdom
 TFilmTriVortexNGLFieldCalc::~TFilmTriVortexNGLFieldCalc() {
 
   // clean up
-  fftwf_destroy_plan(fFFTplanBkToBandQ);
-  fftwf_destroy_plan(fFFTplanOmegaToAk);
-  fftwf_destroy_plan(fFFTplanForSumAk);
-  fftwf_destroy_plan(fFFTplanForPk1);
-  fftwf_destroy_plan(fFFTplanForPk2);
-  fftwf_destroy_plan(fFFTplanForBatSurf);
 
   for (unsigned int i(0); i < 3; ++i) {
     delete[] fOmegaDiffMatrix[i]; fOmegaDiffMatrix[i] = 0;
@@ -268,6 +234,114 @@ TFilmTriVortexNGLFieldCalc::~TFilmTriVortexNGLFieldCalc() {
   delete[] fCheckBkConvergence; fCheckBkConvergence = nullptr;
 }
 
+void TFilmTriVortexNGLFieldCalc::SetWarmStartCacheSize(const unsigned int size) {
+  fWarmStartCacheSize = size;
+  if (fWarmStartCache.size() > size)
+    fWarmStartCache.resize(size);
+  if (fWarmStartNext >= size)
+    fWarmStartNext = 0;
+  return;
+}
+
+// Returns the index of the cached state calculated with the parameters closest to the present ones
+// or -1 if none of them lies within fWarmStartMaxRelDiff
+int TFilmTriVortexNGLFieldCalc::FindWarmStartState() const {
+  int best(-1);
+  float bestDiff(fWarmStartMaxRelDiff), diff;
+  for (unsigned int i(0); i < fWarmStartCache.size(); ++i) {
+    diff = 0.0f;
+    for (unsigned int j(0); j < 4; ++j) {
+      diff = std::max(diff, static_cast<float>(fabs(fabs(fParam[j]) - fWarmStartCache[i].fParam[j])/fabs(fParam[j])));
+    }
+    if (diff <= bestDiff) {
+      bestDiff = diff;
+      best = i;
+    }
+  }
+  return best;
+}
+
+void TFilmTriVortexNGLFieldCalc::RestoreWarmStartState(const int idx) const {
+  const TWarmStartState &state(fWarmStartCache[idx]);
+  const int NFFTsqStZ(fSteps*fSteps*fStepsZ);
+  const int NFFTStZ(fSteps*fStepsZ);
+  int l;
+
+  #ifdef HAVE_GOMP
+  int chunk = NFFTsqStZ/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
+  #endif
+  for (l = 0; l < NFFTsqStZ; ++l) {
+    fOmegaMatrix[l] = state.fOmega[l];
+    fOmegaDiffMatrix[0][l] = state.fOmegaDiff[l];
+    fOmegaDiffMatrix[1][l] = state.fOmegaDiff[l + NFFTsqStZ];
+    fOmegaDiffMatrix[2][l] = state.fOmegaDiff[l + 2*NFFTsqStZ];
+    fQMatrix[l][0] = state.fQ[2*l];
+    fQMatrix[l][1] = state.fQ[2*l+1];
+    fBkMatrix[l][0] = state.fBk[l];
+    fBkMatrix[l][1] = 0.0f;
+  }
+
+  for (l = 0; l < NFFTStZ; ++l) {
+    fCheckAkConvergence[l] = state.fCheckAk[l];
+    fCheckBkConvergence[l] = state.fCheckBk[l];
+  }
+
+  return;
+}
+
+void TFilmTriVortexNGLFieldCalc::StoreWarmStartState() const {
+  if (!fWarmStartCacheSize)
+    return;
+
+  if (fWarmStartCache.size() < fWarmStartCacheSize) {
+    fWarmStartNext = fWarmStartCache.size();
+    fWarmStartCache.push_back(TWarmStartState());
+  }
+
+  TWarmStartState &state(fWarmStartCache[fWarmStartNext]);
+  const int NFFTsqStZ(fSteps*fSteps*fStepsZ);
+  const int NFFTStZ(fSteps*fStepsZ);
+  int l;
+
+  state.fParam.resize(4);
+  for (l = 0; l < 4; ++l)
+    state.fParam[l] = fabs(fParam[l]);
+  state.fOmega.resize(NFFTsqStZ);
+  state.fOmegaDiff.resize(3*NFFTsqStZ);
+  state.fQ.resize(2*NFFTsqStZ);
+  state.fBk.resize(NFFTsqStZ);
+  state.fCheckAk.resize(NFFTStZ);
+  state.fCheckBk.resize(NFFTStZ);
+
+  #ifdef HAVE_GOMP
+  int chunk = NFFTsqStZ/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
+  #endif
+  for (l = 0; l < NFFTsqStZ; ++l) {
+    state.fOmega[l] = fOmegaMatrix[l];
+    state.fOmegaDiff[l] = fOmegaDiffMatrix[0][l];
+    state.fOmegaDiff[l + NFFTsqStZ] = fOmegaDiffMatrix[1][l];
+    state.fOmegaDiff[l + 2*NFFTsqStZ] = fOmegaDiffMatrix[2][l];
+    state.fQ[2*l] = fQMatrix[l][0];
+    state.fQ[2*l+1] = fQMatrix[l][1];
+    state.fBk[l] = fBkMatrix[l][0];
+  }
+
+  for (l = 0; l < NFFTStZ; ++l) {
+    state.fCheckAk[l] = fCheckAkConvergence[l];
+    state.fCheckBk[l] = fCheckBkConvergence[l];
+  }
+
+  fWarmStartNext = (fWarmStartNext + 1) % fWarmStartCacheSize;
+
+  return;
+}
+
 void TFilmTriVortexNGLFieldCalc::CalculateGatVortexCore() const {
 
   const int NFFT(fSteps);
@@ -376,7 +450,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGatVortexCore() const {
   } // end omp parallel
   #endif
 
-  fftwf_execute(fFFTplan);
+  fftwf_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
   // Copy the results to the gradient matrix and restore the original aK-matrix
   for (k = 0; k < NFFTz; ++k) {
@@ -487,7 +561,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGatVortexCore() const {
     }
   } // else do nothing since the other aK are already zero since the former aK manipulation
 
-  fftwf_execute(fFFTplan);
+  fftwf_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
   // Copy the results to the gradient matrix and restore the original aK-matrix
   for (k = 0; k < NFFTz; ++k) {
@@ -597,7 +671,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGatVortexCore() const {
     }
   } // else do nothing since the other aK are already zero since the former aK manipulation
 
-  fftwf_execute(fFFTplan);
+  fftwf_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
   // Copy the results to the gradient matrix and restore the original aK-matrix
   for (k = 0; k < NFFTz; ++k) {
@@ -709,7 +783,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGradient() const {
     }
   } // else do nothing since the other aK are already zero since the former aK manipulation
 
-  fftwf_execute(fFFTplan);
+  fftwf_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
   // Copy the results to the gradient matrix and restore the original aK-matrix
   #ifdef HAVE_GOMP
@@ -799,7 +873,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGradient() const {
     }
   } // else do nothing since the other aK are already zero since the former aK manipulation
 
-  fftwf_execute(fFFTplan);
+  fftwf_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
   // Copy the results to the gradient matrix and restore the original aK-matrix
   #ifdef HAVE_GOMP
@@ -859,10 +933,10 @@ void TFilmTriVortexNGLFieldCalc::CalculateGradient() const {
       fSumAkFFTin[k][1] = 0.0;
     }
 
-    fftwf_execute(fFFTplanForSumAk);
+    fftwf_execute_dft(fFFTplanForSumAk, fSumAkFFTin, fSumAk);
 
     // 3D transform
-    fftwf_execute(fFFTplan);
+    fftwf_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
     #ifdef HAVE_GOMP
     chunk = NFFTsq/omp_get_num_procs();
@@ -2603,7 +2677,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateSumAk() const {
     fSumAkFFTin[k][1] = 0.0;
   }
 
-  fftwf_execute(fFFTplanForSumAk);
+  fftwf_execute_dft(fFFTplanForSumAk, fSumAkFFTin, fSumAk);
 
   return;
 }
@@ -2619,6 +2693,10 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
     return;
   }
 
+  const std::chrono::steady_clock::time_point solveStart(std::chrono::steady_clock::now());
+  fNumberOfIterations = 0;
+  fWarmStarted = false;
+
   float field(fabs(fParam[0])), lambda(fabs(fParam[1])), xi(fabs(fParam[2]));
   fKappa = lambda/xi;
   fThickness = fParam[3]/lambda;
@@ -2657,6 +2735,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
       fBout[1][m] = 0.0f;
       fBout[2][m] = field;
     }
+    fSolveTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count();
     // Set the flag which shows that the calculation has been done
     fGridExists = true;
     return;
@@ -2695,7 +2774,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
 
   // Do the 3D-Fourier transform to get omega(x,y) - Abrikosov
 
-  fftwf_execute(fFFTplan);
+  fftwf_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
   for (k = 0; k < NFFTz; ++k) {
     for (j = 0; j < NFFT; ++j) {
@@ -2773,7 +2852,20 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
   bool akConverged(false), bkConverged(false), firstBkCalculation(true);
   float fourKappaSq(4.0*fKappa*fKappa), meanAk(0.0f);
 
+  // If a previous (3D) calculation with similar parameters converged, start from its omega, Q and bK
+  // instead of Abrikosov's solution. Q-Abrikosov is still needed for the Q-updates below.
+
+  if (fFind3dSolution) {
+    const int warmStart(FindWarmStartState());
+    if (warmStart >= 0) {
+      RestoreWarmStartState(warmStart);
+      firstBkCalculation = false;
+      fWarmStarted = true;
+    }
+  }
+
   int count(0);
+  bool converged3d(false);
 
   while (!akConverged || !bkConverged) {
 
@@ -2814,7 +2906,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
       fRealSpaceMatrix[k + NFFTz*(NFFT+1)*NFFT_2][0] = fRealSpaceMatrix[k][0];//fGstorage[k];
     }
 
-    fftwf_execute(fFFTplanOmegaToAk);
+    fftwf_execute_dft(fFFTplanOmegaToAk, fRealSpaceMatrix, fFFTin);
 
     ManipulateFourierCoefficientsA();
 
@@ -2825,7 +2917,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
 
     // Do the Fourier transform to get omega(x,y,z)
 
-    fftwf_execute(fFFTplan);
+    fftwf_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
     #ifdef HAVE_GOMP
     chunk = NFFTsq/omp_get_num_procs();
@@ -2895,7 +2987,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
       for (j = 0; j < NFFT; ++j) {
         index = k + NFFTz*j;
         if (fFFTin[index][0]) {
-          if (((fabs(fFFTin[index][0]) > 1.0E-5f) && (fabs(fCheckAkConvergence[index] - fFFTin[index][0])/fFFTin[index][0] > 5.0E-3f)) \
+          if (((fabs(fFFTin[index][0]) > 1.0E-5f) && (fabs(fCheckAkConvergence[index] - fFFTin[index][0])/fFFTin[index][0] > fConvergenceTolerance)) \
              || ((fabs(fFFTin[index][0]) > 1.0E-10f) && (fCheckAkConvergence[index]/fFFTin[index][0] < 0.0))) {
             //std::cout << "old: " << fCheckAkConvergence[index] << ", new: " << fFFTin[index][0] << std::endl;
             akConverged = false;
@@ -2945,7 +3037,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
 
     // Do the Fourier transform to get omega
 
-    fftwf_execute(fFFTplan);
+    fftwf_execute_dft(fFFTplan, fFFTin, fRealSpaceMatrix);
 
     #ifdef HAVE_GOMP
     chunk = NFFTsq/omp_get_num_procs();
@@ -2978,8 +3070,8 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
       fQMatrix[l][1] = 0.0;
     }
 
-    fftwf_execute(fFFTplanForPk1);
-    fftwf_execute(fFFTplanForPk2);
+    fftwf_execute_dft(fFFTplanForPk1, fPkMatrix, fPkMatrix);
+    fftwf_execute_dft(fFFTplanForPk2, fQMatrix, fQMatrix);
 
     // calculate bKS
     float sign;
@@ -3024,7 +3116,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
         index = k + NFFTz*j;
         if (fBkMatrix[index][0]) {
           if (((fabs(fBkMatrix[index][0]) > 1.0E-5f) && \
-              (fabs(fCheckBkConvergence[index] - fBkMatrix[index][0])/fBkMatrix[index][0] > 5.0E-3f)) \
+              (fabs(fCheckBkConvergence[index] - fBkMatrix[index][0])/fBkMatrix[index][0] > fConvergenceTolerance)) \
             || ((fabs(fBkMatrix[index][0]) > 1.0E-10f) && (fCheckBkConvergence[index]/fBkMatrix[index][0] < 0.0))) {
             //std::cout << "old: " << fCheckBkConvergence[index] << ", new: " << fBkMatrix[index][0] << std::endl;
             bkConverged = false;
@@ -3087,6 +3179,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
         fFind3dSolution = true;
       } else {
         std::cout << "3D iterations converged after " << count << " steps" << std::endl;
+        converged3d = true;
         break;
       }
     }
@@ -3095,7 +3188,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
 
     ManipulateFourierCoefficientsForQx();
 
-    fftwf_execute(fFFTplanBkToBandQ);
+    fftwf_execute_dft(fFFTplanBkToBandQ, fBkMatrix, fBkMatrix);
 
     #ifdef HAVE_GOMP
     chunk = NFFTsq/omp_get_num_procs();
@@ -3126,7 +3219,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
 
     ManipulateFourierCoefficientsForQy();
 
-    fftwf_execute(fFFTplanBkToBandQ);
+    fftwf_execute_dft(fFFTplanBkToBandQ, fBkMatrix, fBkMatrix);
 
     #ifdef HAVE_GOMP
     chunk = NFFTsq/omp_get_num_procs();
@@ -3156,11 +3249,17 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
     }
   } // end while
 
+  fNumberOfIterations = count;
+
+  // only converged solutions are good starting points for the following calculations
+  if (converged3d)
+    StoreWarmStartState();
+
   // If the iterations have finished, calculate the magnetic field components
 
   ManipulateFourierCoefficientsForBperpXFirst();
 
-  fftwf_execute(fFFTplanBkToBandQ);
+  fftwf_execute_dft(fFFTplanBkToBandQ, fBkMatrix, fBkMatrix);
 
   // Fill in the B-Matrix and restore the bKs for the second part of the Bx-calculation
   #ifdef HAVE_GOMP
@@ -3177,7 +3276,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
 
   ManipulateFourierCoefficientsForBperpXSecond();
 
-  fftwf_execute(fFFTplanBkToBandQ);
+  fftwf_execute_dft(fFFTplanBkToBandQ, fBkMatrix, fBkMatrix);
 
   // Fill in the B-Matrix and restore the bKs for the By-calculation
 
@@ -3192,7 +3291,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
 
   ManipulateFourierCoefficientsForBperpYFirst();
 
-  fftwf_execute(fFFTplanBkToBandQ);
+  fftwf_execute_dft(fFFTplanBkToBandQ, fBkMatrix, fBkMatrix);
 
   // Fill in the B-Matrix and restore the bKs for the second part of the By-calculation
   #ifdef HAVE_GOMP
@@ -3206,7 +3305,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
 
   ManipulateFourierCoefficientsForBperpYSecond();
 
-  fftwf_execute(fFFTplanBkToBandQ);
+  fftwf_execute_dft(fFFTplanBkToBandQ, fBkMatrix, fBkMatrix);
 
   // Fill in the B-Matrix and restore the bKs for the second part of the By-calculation
   #ifdef HAVE_GOMP
@@ -3218,7 +3317,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
     fBkMatrix[l][1] = 0.0f;
   }
 
-  fftwf_execute(fFFTplanBkToBandQ);
+  fftwf_execute_dft(fFFTplanBkToBandQ, fBkMatrix, fBkMatrix);
 
   #ifdef HAVE_GOMP
   #pragma omp parallel for default(shared) private(l) schedule(dynamic,chunk)
@@ -3242,7 +3341,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
 
   ManipulateFourierCoefficientsForBperpXatSurface();
 
-  fftwf_execute(fFFTplanForBatSurf);
+  fftwf_execute_dft(fFFTplanForBatSurf, fBkS, fBkS);
 
   // Write the surface fields to the field-Matrix and restore the BkS for the By-calculation
 
@@ -3257,7 +3356,7 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
 
   ManipulateFourierCoefficientsForBperpYatSurface();
 
-  fftwf_execute(fFFTplanForBatSurf);
+  fftwf_execute_dft(fFFTplanForBatSurf, fBkS, fBkS);
 
   // Write the surface fields to the field-Matrix
 
@@ -3283,6 +3382,8 @@ void TFilmTriVortexNGLFieldCalc::CalculateGrid() const {
   }
 */
 
+  fSolveTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count();
+
   // Set the flag which shows that the calculation has been done
 
   fGridExists = true;
@@ -31,6 +31,7 @@
 #endif
 
 #include "TPofTCalc.h"
+#include "PFFTPlanManager.h"
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -257,15 +258,28 @@ void TPofBCalc::Calculate(const TBofZCalcInverse *BofZ, const TTrimSPData *dataT
 
   unsigned int i;
 
-  // calculate p(B) from the inverse of B(z)
+  // resolve the implantation profile once for all field bins
+  int eIdx(dataTrimSP->FindEnergy(para[2]));
+  if (eIdx < 0) {
+    std::cout << "TPofBCalc::Calculate: No implantation profile available for the specified energy " << para[2] << " keV... Quitting!" << std::endl;
+    exit(-1);
+  }
+
+  // calculate p(B) from the inverse of B(z) -- the field bins are independent and the n(z) lookup is reentrant
 
+  #ifdef HAVE_GOMP
+  int chunk = (lastZerosStart-firstZerosEnd)/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(i) schedule(dynamic,chunk)
+  #endif
   for (i = firstZerosEnd; i <= lastZerosStart; ++i) {
 
     std::vector< std::pair<double, double> > inv;
     inv = BofZ->GetInverseAndDerivative(fB[i]);
 
     for (unsigned int j(0); j < inv.size(); ++j) {
-      fPB[i] += dataTrimSP->GetNofZ(inv[j].first, para[2])*fabs(inv[j].second);
+      fPB[i] += dataTrimSP->NofZ(eIdx, inv[j].first)*fabs(inv[j].second);
     }
 //    if (fPB[i])
 //      cout << fB[i] << " " << fPB[i] << endl;
@@ -369,6 +383,13 @@ void TPofBCalc::Calculate(const TBofZCalc *BofZ, const TTrimSPData *dataTrimSP,
 
   unsigned int i;
 
+  // resolve the implantation profile once for all field bins
+  int eIdx(dataTrimSP->FindEnergy(para[2]));
+  if (eIdx < 0) {
+    std::cout << "TPofBCalc::Calculate: No implantation profile available for the specified energy " << para[2] << " keV... Quitting!" << std::endl;
+    exit(-1);
+  }
+
   for (i = 0; i <= lastZerosStart; i++) {
     BB = fB[i];
     BBnext = fB[i+1];
@@ -390,7 +411,7 @@ void TPofBCalc::Calculate(const TBofZCalc *BofZ, const TTrimSPData *dataTrimSP,
           zNextFound = false;
 
           dz = zNext-zm;
-          nn = dataTrimSP->GetNofZ(zm, para[2]);
+          nn = dataTrimSP->NofZ(eIdx, zm);
           if (nn != -1.0) {
 //          cout << "zNext = " << zNextm << ", zm = " << zm << ", dz = " << dz << endl;
             fPB[i] += nn*fabs(dz/fDB);
@@ -413,7 +434,7 @@ void TPofBCalc::Calculate(const TBofZCalc *BofZ, const TTrimSPData *dataTrimSP,
           zNextFound = false;
 
           dz = zNext-zp;
-          nn = dataTrimSP->GetNofZ(zp, para[2]);
+          nn = dataTrimSP->NofZ(eIdx, zp);
           if (nn != -1.0) {
 //            cout << "zNext = " << zNextp << ", zp = " << zp << ", dz = " << dz << endl;
             fPB[i] += nn*fabs(dz/fDB);
@@ -458,6 +479,7 @@ void TPofBCalc::Calculate(const TBulkVortexFieldCalc *vortexLattice, const std::
   unsigned int numberOfStepsSq(numberOfSteps*numberOfSteps);
   unsigned int numberOfSteps_2(numberOfSteps/2);
   //unsigned int numberOfStepsSq_2(numberOfStepsSq/2);
+  unsigned int stride(vortexLattice->GetGridStride());
 
   if (lastZerosStart >= fPBSize)
     lastZerosStart = fPBSize - 1;
@@ -476,7 +498,7 @@ void TPofBCalc::Calculate(const TBulkVortexFieldCalc *vortexLattice, const std::
     double Rsq1, Rsq2, Rsq3, Rsq4, Rsq5, Rsq6, sigmaSq(-0.5*para[5]*para[5]);
     for (unsigned int j(0); j < numberOfSteps_2; ++j) {
       for (unsigned int i(0); i < numberOfSteps_2; ++i) {
-        fill_index = static_cast<unsigned int>(ceil(fabs((vortexFields[i + numberOfSteps*j]/fDB))));
+        fill_index = static_cast<unsigned int>(ceil(fabs((vortexFields[i + stride*j]/fDB))));
         if (fill_index < fPBSize) {
           Rsq1 = static_cast<double>(3*i*i + j*j)/static_cast<double>(numberOfStepsSq);
           Rsq2 = static_cast<double>(3*(numberOfSteps_2 - i)*(numberOfSteps_2 - i) \
@@ -500,7 +522,7 @@ void TPofBCalc::Calculate(const TBulkVortexFieldCalc *vortexLattice, const std::
 //    ofstream of("LorentzWeight.dat");
     for (unsigned int j(0); j < numberOfSteps_2; ++j) {
       for (unsigned int i(0); i < numberOfSteps_2; ++i) {
-        fill_index = static_cast<unsigned int>(ceil(fabs((vortexFields[i + numberOfSteps*j]/fDB))));
+        fill_index = static_cast<unsigned int>(ceil(fabs((vortexFields[i + stride*j]/fDB))));
         if (fill_index < fPBSize) {
           Rsq1 = static_cast<double>(3*i*i + j*j)/static_cast<double>(numberOfStepsSq);
           Rsq2 = static_cast<double>(3*(numberOfSteps_2 - i)*(numberOfSteps_2 - i) \
@@ -542,7 +564,7 @@ void TPofBCalc::Calculate(const TBulkVortexFieldCalc *vortexLattice, const std::
         Rsq6 = static_cast<double>(3*(numberOfSteps_2 + i)*(numberOfSteps_2 + i) \
              + (numberOfSteps_2 - j)*(numberOfSteps_2 - j))/static_cast<double>(numberOfStepsSq);
 
-        field = vortexFields[i + numberOfSteps*j] \
+        field = vortexFields[i + stride*j] \
               + para[5]*(exp(Rsq1*one_xiSq) + exp(Rsq2*one_xiSq) + exp(Rsq3*one_xiSq) \
                         +exp(Rsq4*one_xiSq) + exp(Rsq5*one_xiSq) + exp(Rsq6*one_xiSq));
 /*
@@ -560,40 +582,38 @@ void TPofBCalc::Calculate(const TBulkVortexFieldCalc *vortexLattice, const std::
     }
 //    of.close();
   } else {
+    // On a reduced grid (first quadrant of the unit cell including its borders) every point stands for its mirror images
+    // in the full cell: interior points count four times, points on the borders twice and the corners once.
+    // Otherwise only the first quadrant (without the borders) of the full grid is used.
+    const bool reducedGrid(vortexLattice->IsReducedGrid());
+    const int numberOfRows(reducedGrid ? numberOfSteps_2 + 1 : numberOfSteps_2);
+    std::vector<unsigned int> weight(numberOfRows, 1);
+    if (reducedGrid) {
+      for (unsigned int i(1); i < numberOfSteps_2; ++i)
+        weight[i] = 2;
+    }
+
     int i,j;
     #ifdef HAVE_GOMP
     // cannot use a reduction clause here (like e.g. in Normalize()), since pBvec[] is not a scalar variable
     // therefore, we need to work on it a bit more
-    int n(omp_get_num_procs()), tid, offset;
+    int n(omp_get_num_procs()), tid;
     int chunk = fPBSize/n;
     if (chunk < 10)
       chunk = 10;
 
     std::vector< std::vector<unsigned int> > pBvec(n, std::vector<unsigned int>(fPBSize, 0));
 
-    int indexStep(static_cast<int>(floor(static_cast<float>(numberOfSteps_2)/static_cast<float>(n))));
-
-    #pragma omp parallel private(tid, i, j, offset, fill_index) num_threads(n)
+    #pragma omp parallel private(tid, i, j, fill_index) num_threads(n)
     {
       tid = omp_get_thread_num();
-      offset = tid*indexStep;
-
-      if (tid == n-1) {
-        for (j = offset; j < static_cast<int>(numberOfSteps_2); ++j) {
-          for (i = 0; i < static_cast<int>(numberOfSteps_2); ++i) {
-            fill_index = static_cast<unsigned int>(ceil(fabs((vortexFields[i + numberOfSteps*j]/fDB))));
-            if (fill_index < fPBSize) {
-              pBvec[tid][fill_index] += 1;
-            }
-          }
-        }
-      } else {
-        for (j = 0; j < indexStep; ++j) {
-          for (i = 0; i < static_cast<int>(numberOfSteps_2); ++i) {
-            fill_index = static_cast<unsigned int>(ceil(fabs((vortexFields[offset + i + numberOfSteps*j]/fDB))));
-            if (fill_index < fPBSize) {
-              pBvec[tid][fill_index] += 1;
-            }
+
+      #pragma omp for schedule(static)
+      for (j = 0; j < numberOfRows; ++j) {
+        for (i = 0; i < numberOfRows; ++i) {
+          fill_index = static_cast<unsigned int>(ceil(fabs((vortexFields[i + stride*j]/fDB))));
+          if (fill_index < fPBSize) {
+            pBvec[tid][fill_index] += weight[i]*weight[j];
           }
         }
       }
@@ -610,11 +630,11 @@ void TPofBCalc::Calculate(const TBulkVortexFieldCalc *vortexLattice, const std::
 
     #else
 
-    for (j = 0; j < static_cast<int>(numberOfSteps_2); ++j) {
-      for (i = 0; i < static_cast<int>(numberOfSteps_2); ++i) {
-        fill_index = static_cast<unsigned int>(ceil(fabs((vortexFields[i + numberOfSteps*j]/fDB))));
+    for (j = 0; j < numberOfRows; ++j) {
+      for (i = 0; i < numberOfRows; ++i) {
+        fill_index = static_cast<unsigned int>(ceil(fabs((vortexFields[i + stride*j]/fDB))));
         if (fill_index < fPBSize) {
-          fPB[fill_index] += 1.0;
+          fPB[fill_index] += static_cast<double>(weight[i]*weight[j]);
         }
       }
     }
@@ -694,7 +714,7 @@ void TPofBCalc::ConvolveGss(double w) {
   if(!w)
     return;
 
-  unsigned int NFFT(fPBSize);
+  int NFFT(fPBSize);
   double TBin;
   fftw_plan FFTplanToTimeDomain;
   fftw_plan FFTplanToFieldDomain;
@@ -704,11 +724,11 @@ void TPofBCalc::ConvolveGss(double w) {
 
   FFTout = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * (NFFT/2+1));//new fftw_complex[NFFT/2 + 1];
 
-  // do the FFT to time domain
+  // do the FFT to time domain (the plans are created only once and then reused from the plan manager)
 
-  FFTplanToTimeDomain = fftw_plan_dft_r2c_1d(NFFT, fPB, FFTout, FFTW_ESTIMATE);
+  FFTplanToTimeDomain = PFFTPlanManager::GetInstance()->GetPlanDftR2C(1, &NFFT, fPB, FFTout, FFTW_ESTIMATE);
 
-  fftw_execute(FFTplanToTimeDomain);
+  fftw_execute_dft_r2c(FFTplanToTimeDomain, fPB, FFTout);
 
   // multiply everything by a gaussian
 
@@ -730,14 +750,12 @@ void TPofBCalc::ConvolveGss(double w) {
 
   // FFT back to the field domain
 
-  FFTplanToFieldDomain = fftw_plan_dft_c2r_1d(NFFT, FFTout, fPB, FFTW_ESTIMATE);
+  FFTplanToFieldDomain = PFFTPlanManager::GetInstance()->GetPlanDftC2R(1, &NFFT, FFTout, fPB, FFTW_ESTIMATE);
 
-  fftw_execute(FFTplanToFieldDomain);
+  fftw_execute_dft_c2r(FFTplanToFieldDomain, FFTout, fPB);
 
   // cleanup
 
-  fftw_destroy_plan(FFTplanToTimeDomain);
-  fftw_destroy_plan(FFTplanToFieldDomain);
   fftw_free(FFTout);//delete[] FFTout; FFTout = 0;
 //  fftw_cleanup();
 
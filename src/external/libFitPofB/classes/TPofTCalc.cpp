@@ -38,6 +38,7 @@
 
 #include "TPofTCalc.h"
 #include "fftw3.h"
+#include "PFFTPlanManager.h"
 #include <cmath>
 #include <iostream>
 #include <cstdio>
@@ -68,14 +69,6 @@
 
 TPofTCalc::TPofTCalc (const TPofBCalc *PofB, const std::string &wisdom, const std::vector<double> &par) : fWisdom(wisdom) {
 
-#if !defined(_WIN32GCC) && defined(HAVE_LIBFFTW3_THREADS) && defined(HAVE_GOMP)
-  int init_threads(fftw_init_threads());
-  if (!init_threads)
-    std::cout << "TPofTCalc::TPofTCalc: Couldn't initialize multiple FFTW-threads ..." << std::endl;
-  else
-    fftw_plan_with_nthreads(omp_get_num_procs());
-#endif
-
   fNFFT = static_cast<int>(1.0/(gBar*par[1]*par[2]));
   if (fNFFT % 2) {
     fNFFT += 1;
@@ -105,56 +98,32 @@ TPofTCalc::TPofTCalc (const TPofBCalc *PofB, const std::string &wisdom, const st
   }
 
   fFFTin = PofB->DataPB();
-  fFFTout = new fftw_complex[NFFT_2p1]; //static_cast<fftw_complex *>(fftw_malloc(sizeof(fftw_complex) * NFFT_2p1));
+  fFFTout = static_cast<fftw_complex *>(fftw_malloc(sizeof(fftw_complex) * NFFT_2p1));
 
-  // Load wisdom from file if it exists and should be used
+  // Load wisdom from file if it exists and should be used (the plan manager imports each file only once
+  // and writes the wisdom back at the end of the process)
 
-  fUseWisdom = true;
-  int wisdomLoaded(0);
+  PFFTPlanManager *planManager(PFFTPlanManager::GetInstance());
+  fUseWisdom = planManager->ImportWisdom(wisdom);
 
-  FILE *wordsOfWisdomR;
-  wordsOfWisdomR = fopen(wisdom.c_str(), "r");
-  if (wordsOfWisdomR == NULL) {
-    fUseWisdom = false;
-  } else {
-    wisdomLoaded = fftw_import_wisdom_from_file(wordsOfWisdomR);
-    fclose(wordsOfWisdomR);
-  }
-
-  if (!wisdomLoaded) {
-    fUseWisdom = false;
-  }
-
-// create the FFT plan
+// get the (shared) FFT plan
 
   if (fUseWisdom)
-    fFFTplan = fftw_plan_dft_r2c_1d(fNFFT, fFFTin, fFFTout, FFTW_EXHAUSTIVE);
+    fFFTplan = planManager->GetPlanDftR2C(1, &fNFFT, fFFTin, fFFTout, FFTW_EXHAUSTIVE);
   else
-    fFFTplan = fftw_plan_dft_r2c_1d(fNFFT, fFFTin, fFFTout, FFTW_ESTIMATE);
+    fFFTplan = planManager->GetPlanDftR2C(1, &fNFFT, fFFTin, fFFTout, FFTW_ESTIMATE);
 
 }
 
 //---------------------
-// Destructor of the TPofTCalc class - it saves the FFT plan and cleans up
+// Destructor of the TPofTCalc class - it cleans up
+// (the FFT plan is owned by the PFFTPlanManager which also exports the wisdom)
 //---------------------
 
 TPofTCalc::~TPofTCalc() {
-  // if a wisdom file is used export the wisdom so it has not to be checked for the FFT-plan next time
-  if (fUseWisdom) {
-    FILE *wordsOfWisdomW;
-    wordsOfWisdomW = fopen(fWisdom.c_str(), "w");
-    if (wordsOfWisdomW == NULL) {
-      std::cout << "TPofTCalc::~TPofTCalc(): Could not open file ... No wisdom is exported..." << std::endl;
-    } else {
-      fftw_export_wisdom_to_file(wordsOfWisdomW);
-      fclose(wordsOfWisdomW);
-    }
-  }
-
   // clean up
 
-  fftw_destroy_plan(fFFTplan);
-  delete[] fFFTout; //fftw_free(fFFTout);
+  fftw_free(fFFTout);
   fFFTout = 0;
 //  fftw_cleanup();
 //  fftw_cleanup_threads();
@@ -171,7 +140,7 @@ TPofTCalc::~TPofTCalc() {
 
 void TPofTCalc::DoFFT() {
 
-  fftw_execute(fFFTplan);
+  fftw_execute_dft_r2c(fFFTplan, fFFTin, fFFTout);
 
 }
 
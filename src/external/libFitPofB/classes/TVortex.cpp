@@ -137,6 +137,10 @@ TBulkTriVortexAGLII::~TBulkTriVortexAGLII() {
 //------------------
 
 TBulkTriVortexNGL::~TBulkTriVortexNGL() {
+    if (fNoOfSolves) {
+      cout << "TBulkTriVortexNGL: " << fNoOfSolves << " calculations of B(x,y) (" << fNoOfWarmStarts << " warm-started), " \
+           << fNoOfIterations << " iterations, " << fSolveTime << " s in total" << endl;
+    }
     delete fPofT;
     fPofT = 0;
     delete fPofB;
@@ -872,7 +876,8 @@ double TBulkTriVortexAGLII::operator()(double t, const std::vector<double> &par)
 // creates (a pointer to) the TPofTCalc object (with the FFT plan)
 //------------------
 
-TBulkTriVortexNGL::TBulkTriVortexNGL() : fCalcNeeded(true), fFirstCall(true) {
+TBulkTriVortexNGL::TBulkTriVortexNGL() : fCalcNeeded(true), fFirstCall(true), fStatistics(false), fNoOfSolves(0), fNoOfWarmStarts(0),
+    fNoOfIterations(0), fSolveTime(0.0) {
 
     // read startup file
     std::string startup_path_name("BMW_startup.xml");
@@ -910,6 +915,15 @@ TBulkTriVortexNGL::TBulkTriVortexNGL() : fCalcNeeded(true), fFirstCall(true) {
 
     fVortex = new TBulkTriVortexNGLFieldCalc(fWisdom, fGridSteps);
 
+    // optional settings of the iterations, otherwise the defaults of TBulkTriVortexNGLFieldCalc are kept
+    if (startupHandler->GetNGLTolerance() > 0.0)
+      fVortex->SetConvergenceTolerance(startupHandler->GetNGLTolerance());
+    if (startupHandler->GetNGLWarmStartCache() >= 0)
+      fVortex->SetWarmStartCacheSize(static_cast<unsigned int>(startupHandler->GetNGLWarmStartCache()));
+    if (startupHandler->GetNGLWarmStartMaxDiff() > 0.0)
+      fVortex->SetWarmStartMaxRelDiff(startupHandler->GetNGLWarmStartMaxDiff());
+    fStatistics = startupHandler->GetNGLStatistics();
+
     fPofB = new TPofBCalc(fParForPofB);
 
     fPofT = new TPofTCalc(fPofB, fWisdom, fParForPofT);
@@ -988,6 +1002,18 @@ double TBulkTriVortexNGL::operator()(double t, const std::vector<double> &par) c
 
       fVortex->SetParameters(fParForVortex);
       fVortex->CalculateGrid();
+
+      fNoOfSolves++;
+      if (fVortex->IsWarmStarted())
+        fNoOfWarmStarts++;
+      fNoOfIterations += fVortex->GetNumberOfIterations();
+      fSolveTime += fVortex->GetSolveTime();
+      if (fStatistics) {
+        cout << "TBulkTriVortexNGL: B(x,y) for (" << fParForVortex[0] << ", " << fParForVortex[1] << ", " << fParForVortex[2] << "): " \
+             << fVortex->GetNumberOfIterations() << " iterations" << (fVortex->IsWarmStarted() ? " (warm start)" : "") << ", " \
+             << fVortex->GetSolveTime() << " s" << endl;
+      }
+
       fPofB->UnsetPBExists();
       fPofB->Calculate(fVortex, fParForPofB);
       fPofT->DoFFT();
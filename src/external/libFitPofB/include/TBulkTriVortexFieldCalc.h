@@ -45,7 +45,7 @@ class TBulkVortexFieldCalc {
 
 public:
 
-  TBulkVortexFieldCalc() {}
+  TBulkVortexFieldCalc() : fReducedGrid(false) {}
 
   virtual ~TBulkVortexFieldCalc();
 
@@ -57,9 +57,13 @@ public:
   virtual bool GridExists() const {return fGridExists;}
   virtual void UnsetGridExists() const {fGridExists = false;}
   virtual unsigned int GetNumberOfSteps() const {return fSteps;}
+  virtual bool IsReducedGrid() const {return fReducedGrid;}
+  virtual unsigned int GetGridStride() const {return fReducedGrid ? fSteps/2 + 1 : fSteps;}
   virtual bool IsTriangular() const = 0;
 
 protected:
+  void CreateReducedGridPlan(const unsigned int);
+
   std::vector<double> fParam; ///< parameters used to calculate B(x,y)
   unsigned int fSteps;  ///< number of steps in which the "unit cell" of the vortex lattice is devided in (in each direction)
   mutable fftw_complex *fFFTin; ///< Fourier components of the field
@@ -68,6 +72,7 @@ protected:
   bool fUseWisdom; ///< tag determining if FFTW wisdom is used
   std::string fWisdom; ///< file name of the FFTW wisdom-file
   mutable bool fGridExists; ///< tag determining if B(x,y) has been calculated for the given set of parameters
+  bool fReducedGrid; ///< tag determining if only the first quadrant (fSteps/2+1)x(fSteps/2+1) of B(x,y) is stored (mirror symmetric lattices)
 };
 
 /**
@@ -222,8 +227,35 @@ public:
   fftw_complex* GetQMatrix() const {return fQMatrix;}
   bool IsTriangular() const {return true;}
 
+  void SetConvergenceTolerance(const double tol) {fConvergenceTolerance = tol;}
+  double GetConvergenceTolerance() const {return fConvergenceTolerance;}
+  void SetWarmStartCacheSize(const unsigned int);
+  unsigned int GetWarmStartCacheSize() const {return fWarmStartCacheSize;}
+  void SetWarmStartMaxRelDiff(const double diff) {fWarmStartMaxRelDiff = diff;}
+  double GetWarmStartMaxRelDiff() const {return fWarmStartMaxRelDiff;}
+  unsigned int GetNumberOfIterations() const {return fNumberOfIterations;}
+  double GetSolveTime() const {return fSolveTime;}
+  bool IsWarmStarted() const {return fWarmStarted;}
+
 private:
 
+  /**
+   * <p>Converged state of the iterations for one parameter set, used as starting point for the following calculations
+   */
+  struct TWarmStartState {
+    std::vector<double> fParam; ///< parameters (field, lambda, xi) the state has been calculated for
+    std::vector<double> fOmega; ///< omega(x,y)
+    std::vector<double> fOmegaDiff; ///< gradient of omega(x,y), interleaved (d/dx, d/dy)
+    std::vector<double> fQ; ///< supervelocity, interleaved (Qx, Qy)
+    std::vector<double> fB; ///< field B(x,y) in reduced units
+    std::vector<double> fCheckAk; ///< aK used for the convergence check
+    std::vector<double> fCheckBk; ///< bK used for the convergence check
+  };
+
+  int FindWarmStartState() const;
+  void RestoreWarmStartState(const int) const;
+  void StoreWarmStartState() const;
+
   void CalculateGradient() const;
   void CalculateSumAk() const;
   void FillAbrikosovCoefficients() const;
@@ -251,6 +283,14 @@ private:
   fftw_plan fFFTplanOmegaToAk; ///< FFTW plan for the 2D-Fourier transform from real space to Fourier space
   fftw_plan fFFTplanOmegaToBk; ///< FFTW plan for the 2D-Fourier transform from real space to Fourier space
 
+  double fConvergenceTolerance; ///< relative change of the checked aK and bK below which the iterations are considered converged
+  unsigned int fWarmStartCacheSize; ///< maximum number of converged states kept for warm starts (0: no warm starts)
+  double fWarmStartMaxRelDiff; ///< maximum relative parameter difference for which a cached state is used as starting point
+  mutable std::vector<TWarmStartState> fWarmStartCache; ///< converged states of the last calculations
+  mutable unsigned int fWarmStartNext; ///< cache slot which is overwritten next
+  mutable unsigned int fNumberOfIterations; ///< number of iterations needed in the last calculation
+  mutable double fSolveTime; ///< wall-clock time (s) spent in the last calculation
+  mutable bool fWarmStarted; ///< tag showing if the last calculation started from a cached state
 };
 
 #endif // _TBulkTriVortexFieldCalc_H_
@@ -94,8 +94,33 @@ public:
   fftwf_complex* GetQMatrix() const {return fQMatrix;}
   fftwf_complex* GetPMatrix() const {return fPkMatrix;}
 
+  void SetConvergenceTolerance(const float tol) {fConvergenceTolerance = tol;}
+  float GetConvergenceTolerance() const {return fConvergenceTolerance;}
+  void SetWarmStartCacheSize(const unsigned int);
+  unsigned int GetWarmStartCacheSize() const {return fWarmStartCacheSize;}
+  void SetWarmStartMaxRelDiff(const float diff) {fWarmStartMaxRelDiff = diff;}
+  float GetWarmStartMaxRelDiff() const {return fWarmStartMaxRelDiff;}
+  unsigned int GetNumberOfIterations() const {return fNumberOfIterations;}
+  double GetSolveTime() const {return fSolveTime;}
+  bool IsWarmStarted() const {return fWarmStarted;}
+
 private:
 
+  // converged state of the iterations for one parameter set, used as starting point for the following calculations
+  struct TWarmStartState {
+    std::vector<float> fParam; // field, lambda, xi, thickness
+    std::vector<float> fOmega;
+    std::vector<float> fOmegaDiff; // (dw/dx, dw/dy, dw/dz), one block each
+    std::vector<float> fQ; // (Qx, Qy) interleaved
+    std::vector<float> fBk;
+    std::vector<float> fCheckAk;
+    std::vector<float> fCheckBk;
+  };
+
+  int FindWarmStartState() const;
+  void RestoreWarmStartState(const int) const;
+  void StoreWarmStartState() const;
+
   void CalculateGradient() const;
   void CalculateSumAk() const;
   void FillAbrikosovCoefficients(const float) const;
@@ -135,6 +160,15 @@ private:
 
   mutable bool fFind3dSolution;
 
+  float fConvergenceTolerance; // relative change of the checked aK and bK below which the iterations are considered converged
+  unsigned int fWarmStartCacheSize; // maximum number of converged states kept for warm starts (0: no warm starts)
+  float fWarmStartMaxRelDiff; // maximum relative parameter difference for which a cached state is used as starting point
+  mutable std::vector<TWarmStartState> fWarmStartCache;
+  mutable unsigned int fWarmStartNext; // cache slot which is overwritten next
+  mutable unsigned int fNumberOfIterations; // number of iterations needed in the last calculation
+  mutable double fSolveTime; // wall-clock time (s) spent in the last calculation
+  mutable bool fWarmStarted; // true if the last calculation started from a cached state
+
   fftwf_plan fFFTplanBkToBandQ;
   fftwf_plan fFFTplanOmegaToAk;
   fftwf_plan fFFTplanOmegaToBk;
@@ -202,6 +202,11 @@ private:
   mutable std::vector<double> fParForPofT; ///< parameters for the calculation of p(t)
   std::string fWisdom; ///< file name of the FFTW wisdom file
   unsigned int fGridSteps; ///< number of points in x- and y-direction for which B(x,y) is calculated
+  bool fStatistics; ///< tag for reporting the iterations and solve time of every calculation of B(x,y)
+  mutable unsigned int fNoOfSolves; ///< number of calculations of B(x,y)
+  mutable unsigned int fNoOfWarmStarts; ///< number of calculations of B(x,y) started from a cached solution
+  mutable unsigned int fNoOfIterations; ///< total number of iterations of all calculations of B(x,y)
+  mutable double fSolveTime; ///< total wall-clock time (s) of all calculations of B(x,y)
 
   ClassDef(TBulkTriVortexNGL,1)
 };
@@ -0,0 +1,72 @@
+/***************************************************************************
+
+  TGapIntegralCache.cpp
+
+  Author: Bastian M. Wojek
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2009 by Bastian M. Wojek                                *
+ *   bastian.wojek@psi.ch                                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#ifdef HAVE_GOMP
+#include <omp.h>
+#endif
+
+#include "TGapIntegralCache.h"
+
+//--------------------------------------------------------------------
+/**
+ * <p>Number of threads which can be used for the calculation of the integrals.
+ * Inside an already parallel region (e.g. several runs evaluated concurrently) this is 1.
+ */
+unsigned int TGapIntegralCacheBase::GetNoOfThreads()
+{
+#ifdef HAVE_GOMP
+  if (omp_in_parallel())
+    return 1;
+  return static_cast<unsigned int>(omp_get_max_threads());
+#else
+  return 1;
+#endif
+}
+
+//--------------------------------------------------------------------
+/**
+ * <p>Execute body(i, thread) for i = 0...n-1, distributed over the available threads.
+ *
+ * \param n number of iterations
+ * \param body loop body, getting the iteration index and the thread number (0...GetNoOfThreads()-1)
+ */
+void TGapIntegralCacheBase::ParallelFor(const int n, const std::function<void(int, unsigned int)> &body)
+{
+  int i;
+#ifdef HAVE_GOMP
+  #pragma omp parallel for default(shared) private(i) schedule(dynamic)
+  for (i = 0; i < n; i++) {
+    body(i, static_cast<unsigned int>(omp_get_thread_num()));
+  }
+#else
+  for (i = 0; i < n; i++) {
+    body(i, 0);
+  }
+#endif
+}
@@ -0,0 +1,234 @@
+/***************************************************************************
+
+  TGapIntegralCache.h
+
+  Author: Bastian M. Wojek
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2009 by Bastian M. Wojek                                *
+ *   bastian.wojek@psi.ch                                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef _TGapIntegralCache_H_
+#define _TGapIntegralCache_H_
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+#include "PPerfMonitor.h"
+
+//--------------------------------------------------------------------
+/**
+ * <p>Thread handling of TGapIntegralCache, kept out of the header such that OpenMP is only needed to build the library.
+ */
+class TGapIntegralCacheBase {
+
+protected:
+  static unsigned int GetNoOfThreads();
+  static void ParallelFor(const int n, const std::function<void(int, unsigned int)> &body);
+};
+
+//--------------------------------------------------------------------
+/**
+ * <p>Cache of the superfluid-density integrals of one gap function.
+ *
+ * <p>The values are stored in a hash table with the temperature as key and are valid for one set of parameters.
+ * When the parameters change, all temperatures requested with the previous parameters---i.e. typically all
+ * temperatures of the data set---are calculated at once. If the integrator is reentrant this is done in parallel,
+ * using one integrator object per thread.
+ */
+template <class TIntegral>
+class TGapIntegralCache : private TGapIntegralCacheBase {
+
+public:
+  typedef std::function<double(double, TIntegral*)> TCalcFunc; ///< calculates the integral at a given temperature using the given integrator
+
+  TGapIntegralCache(const bool reentrant);
+  ~TGapIntegralCache();
+
+  bool SetParameters(const std::vector<double> &par);
+  void Update(const double tc, const TCalcFunc &calc);
+  void Calculate(const std::vector<double> &temp, const double tc, const TCalcFunc &calc);
+  double GetValue(const double t, const TCalcFunc &calc);
+
+private:
+  TGapIntegralCache(const TGapIntegralCache&) = delete;
+  TGapIntegralCache& operator=(const TGapIntegralCache&) = delete;
+
+  TIntegral* GetIntegral(const unsigned int i);
+
+  bool fReentrant;                             ///< true if several integrator objects may be used concurrently
+  std::vector<TIntegral*> fIntegral;           ///< integrator objects, one per thread
+  std::vector<double> fPar;                    ///< parameters the cached values belong to
+  std::unordered_map<double, double> fValues;  ///< integral values for the current parameters, key: temperature
+  std::vector<double> fTemp;                   ///< temperatures requested with the current parameters
+  std::vector<double> fLastTemp;               ///< temperatures requested with the previous parameters
+  PPerfCacheCounter *fPerfCache;               ///< hit/miss statistics for the performance report
+};
+
+//--------------------------------------------------------------------
+/**
+ * <p>Constructor
+ *
+ * \param reentrant true if the integrations can be carried out concurrently with different integrator objects
+ */
+template <class TIntegral>
+TGapIntegralCache<TIntegral>::TGapIntegralCache(const bool reentrant) : fReentrant(reentrant)
+{
+  fPerfCache = PPerfMonitor::GetInstance()->GetCacheCounter("TGapIntegralCache");
+  fIntegral.push_back(new TIntegral());
+}
+
+//--------------------------------------------------------------------
+/**
+ * <p>Destructor
+ */
+template <class TIntegral>
+TGapIntegralCache<TIntegral>::~TGapIntegralCache()
+{
+  for (unsigned int i(0); i<fIntegral.size(); i++) {
+    delete fIntegral[i];
+    fIntegral[i] = nullptr;
+  }
+  fIntegral.clear();
+}
+
+//--------------------------------------------------------------------
+/**
+ * <p>Returns the i-th integrator object, creating it if needed.
+ * Must not be called from within a parallel region.
+ *
+ * \param i index of the integrator
+ */
+template <class TIntegral>
+TIntegral* TGapIntegralCache<TIntegral>::GetIntegral(const unsigned int i)
+{
+  while (fIntegral.size() <= i)
+    fIntegral.push_back(new TIntegral());
+  return fIntegral[i];
+}
+
+//--------------------------------------------------------------------
+/**
+ * <p>Checks if the parameters have changed. If so, the cached values are dropped and the temperatures
+ * requested so far are remembered for the next call of Update.
+ *
+ * <p><b>return:</b> true if the parameters have changed, false otherwise
+ *
+ * \param par parameters of the gap function
+ */
+template <class TIntegral>
+bool TGapIntegralCache<TIntegral>::SetParameters(const std::vector<double> &par)
+{
+  if (par == fPar)
+    return false;
+
+  fPar = par;
+  fValues.clear();
+  if (!fTemp.empty()) // keep the temperatures of the last evaluation if the parameters change several times without being evaluated
+    fLastTemp.swap(fTemp);
+  fTemp.clear();
+
+  return true;
+}
+
+//--------------------------------------------------------------------
+/**
+ * <p>Calculates the integrals for all temperatures which have been requested with the previous parameters.
+ *
+ * \param tc critical temperature: only temperatures 0 < T < Tc are calculated
+ * \param calc function calculating the integral at a given temperature
+ */
+template <class TIntegral>
+void TGapIntegralCache<TIntegral>::Update(const double tc, const TCalcFunc &calc)
+{
+  Calculate(fLastTemp, tc, calc);
+}
+
+//--------------------------------------------------------------------
+/**
+ * <p>Calculates the integrals for all given temperatures which are not cached yet.
+ *
+ * \param temp temperatures, may contain duplicates
+ * \param tc critical temperature: only temperatures 0 < T < Tc are calculated
+ * \param calc function calculating the integral at a given temperature
+ */
+template <class TIntegral>
+void TGapIntegralCache<TIntegral>::Calculate(const std::vector<double> &temp, const double tc, const TCalcFunc &calc)
+{
+  std::vector<double> newTemp;
+  newTemp.reserve(temp.size());
+  for (unsigned int i(0); i<temp.size(); i++) {
+    if ((temp[i] > 0.0) && (temp[i] < tc) && (fValues.find(temp[i]) == fValues.end())) {
+      fValues[temp[i]] = 0.0;
+      newTemp.push_back(temp[i]);
+    }
+  }
+
+  if (newTemp.empty())
+    return;
+
+  PPerfMonitor::GetInstance()->AddCount("TGapIntegralCache/batch_calculated", newTemp.size());
+
+  std::vector<double> value(newTemp.size());
+  int n(static_cast<int>(newTemp.size()));
+  unsigned int nThreads(fReentrant ? GetNoOfThreads() : 1);
+
+  if ((nThreads > 1) && (n > 1)) {
+    GetIntegral(nThreads-1); // make sure every thread has its own integrator
+    ParallelFor(n, [&](int i, unsigned int thread) { value[i] = calc(newTemp[i], fIntegral[thread]); });
+  } else {
+    for (int i = 0; i < n; i++) {
+      value[i] = calc(newTemp[i], fIntegral[0]);
+    }
+  }
+
+  for (int i = 0; i < n; i++) {
+    fValues[newTemp[i]] = value[i];
+    fTemp.push_back(newTemp[i]);
+  }
+}
+
+//--------------------------------------------------------------------
+/**
+ * <p>Returns the integral at the given temperature, calculating it if it is not cached yet.
+ *
+ * \param t temperature (0 < t < Tc)
+ * \param calc function calculating the integral at a given temperature
+ */
+template <class TIntegral>
+double TGapIntegralCache<TIntegral>::GetValue(const double t, const TCalcFunc &calc)
+{
+  std::unordered_map<double, double>::const_iterator iter(fValues.find(t));
+  if (iter != fValues.end()) {
+    fPerfCache->Hit();
+    return iter->second;
+  }
+
+  fPerfCache->Miss();
+  double value(calc(t, fIntegral[0]));
+  fValues[t] = value;
+  fTemp.push_back(t);
+
+  return value;
+}
+
+#endif //_TGapIntegralCache_H_
@@ -71,144 +71,63 @@ ClassImp(TFilmMagnetizationDWave)
 /**
  * <p> s wave  gap integral
  */
-TGapSWave::TGapSWave() {
-  TGapIntegral *gapint = new TGapIntegral();
-  fGapIntegral = gapint;
-  gapint = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
+TGapSWave::TGapSWave() : fCache(true) {
 }
 
 //--------------------------------------------------------------------
 /**
  * <p> point p wave  gap integral
  */
-TGapPointPWave::TGapPointPWave() {
-  TPointPWaveGapIntegralCuhre *gapint = new TPointPWaveGapIntegralCuhre();
-  fGapIntegral = gapint;
-  gapint = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
+TGapPointPWave::TGapPointPWave() : fCache(true) {
 }
 
 //--------------------------------------------------------------------
 /**
  * <p> line p wave  gap integral
  */
-TGapLinePWave::TGapLinePWave() {
-  TLinePWaveGapIntegralCuhre *gapint = new TLinePWaveGapIntegralCuhre();
-  fGapIntegral = gapint;
-  gapint = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
+TGapLinePWave::TGapLinePWave() : fCache(true) {
 }
 
 //--------------------------------------------------------------------
 /**
  * <p>
  */
-TGapDWave::TGapDWave() {
-  TDWaveGapIntegralCuhre *gapint = new TDWaveGapIntegralCuhre();
-  fGapIntegral = gapint;
-  gapint = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
+TGapDWave::TGapDWave() : fCache(true) {
 }
 
 //--------------------------------------------------------------------
 /**
  * <p>
  */
-TGapCosSqDWave::TGapCosSqDWave() {
-  TCosSqDWaveGapIntegralCuhre *gapint = new TCosSqDWaveGapIntegralCuhre();
-  fGapIntegral = gapint;
-  gapint = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
+TGapCosSqDWave::TGapCosSqDWave() : fCache(true) {
 }
 
 //--------------------------------------------------------------------
 /**
  * <p>
  */
-TGapSinSqDWave::TGapSinSqDWave() {
-  TSinSqDWaveGapIntegralCuhre *gapint = new TSinSqDWaveGapIntegralCuhre();
-  fGapIntegral = gapint;
-  gapint = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
+TGapSinSqDWave::TGapSinSqDWave() : fCache(true) {
 }
 
 //--------------------------------------------------------------------
 /**
  * <p>
  */
-TGapAnSWave::TGapAnSWave() {
-  TAnSWaveGapIntegralCuhre *gapint = new TAnSWaveGapIntegralCuhre();
-  fGapIntegral = gapint;
-  gapint = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
+TGapAnSWave::TGapAnSWave() : fCache(true) {
 }
 
 //--------------------------------------------------------------------
 /**
  * <p>
  */
-TGapNonMonDWave1::TGapNonMonDWave1() {
-  TNonMonDWave1GapIntegralCuhre *gapint = new TNonMonDWave1GapIntegralCuhre();
-  fGapIntegral = gapint;
-  gapint = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
+TGapNonMonDWave1::TGapNonMonDWave1() : fCache(true) {
 }
 
 //--------------------------------------------------------------------
 /**
  * <p>
  */
-TGapNonMonDWave2::TGapNonMonDWave2() {
-  TNonMonDWave2GapIntegralCuhre *gapint = new TNonMonDWave2GapIntegralCuhre();
-  fGapIntegral = gapint;
-  gapint = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
+TGapNonMonDWave2::TGapNonMonDWave2() : fCache(true) {
 }
 
 //--------------------------------------------------------------------
@@ -328,14 +247,6 @@ TLambdaInvNonMonDWave2::TLambdaInvNonMonDWave2() {
  * <p>
  */
 TGapSWave::~TGapSWave() {
-  delete fGapIntegral;
-  fGapIntegral = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
 }
 
 //--------------------------------------------------------------------
@@ -343,14 +254,6 @@ TGapSWave::~TGapSWave() {
  * <p>
  */
 TGapPointPWave::~TGapPointPWave() {
-  delete fGapIntegral;
-  fGapIntegral = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
 }
 
 //--------------------------------------------------------------------
@@ -358,14 +261,6 @@ TGapPointPWave::~TGapPointPWave() {
  * <p>
  */
 TGapLinePWave::~TGapLinePWave() {
-  delete fGapIntegral;
-  fGapIntegral = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
 }
 
 //--------------------------------------------------------------------
@@ -373,14 +268,6 @@ TGapLinePWave::~TGapLinePWave() {
  * <p>
  */
 TGapDWave::~TGapDWave() {
-  delete fGapIntegral;
-  fGapIntegral = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
 }
 
 //--------------------------------------------------------------------
@@ -388,14 +275,6 @@ TGapDWave::~TGapDWave() {
  * <p>
  */
 TGapCosSqDWave::~TGapCosSqDWave() {
-  delete fGapIntegral;
-  fGapIntegral = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
 }
 
 //--------------------------------------------------------------------
@@ -403,14 +282,6 @@ TGapCosSqDWave::~TGapCosSqDWave() {
  * <p>
  */
 TGapSinSqDWave::~TGapSinSqDWave() {
-  delete fGapIntegral;
-  fGapIntegral = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
 }
 
 //--------------------------------------------------------------------
@@ -418,14 +289,6 @@ TGapSinSqDWave::~TGapSinSqDWave() {
  * <p>
  */
 TGapAnSWave::~TGapAnSWave() {
-  delete fGapIntegral;
-  fGapIntegral = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
 }
 
 //--------------------------------------------------------------------
@@ -433,14 +296,6 @@ TGapAnSWave::~TGapAnSWave() {
  * <p>
  */
 TGapNonMonDWave1::~TGapNonMonDWave1() {
-  delete fGapIntegral;
-  fGapIntegral = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
 }
 
 //--------------------------------------------------------------------
@@ -448,14 +303,6 @@ TGapNonMonDWave1::~TGapNonMonDWave1() {
  * <p>
  */
 TGapNonMonDWave2::~TGapNonMonDWave2() {
-  delete fGapIntegral;
-  fGapIntegral = nullptr;
-
-  fTemp.clear();
-  fTempIter = fTemp.end();
-  fIntegralValues.clear();
-  fCalcNeeded.clear();
-  fPar.clear();
 }
 
 //--------------------------------------------------------------------
@@ -603,65 +450,54 @@ double TGapSWave::operator()(double t, const std::vector<double> &par) const {
   else if (t >= par[0])
     return 0.0;
 
-  bool integralParChanged(false);
-
-  if (fPar.empty()) { // first time calling this routine
-    fPar = par;
-    integralParChanged = true;
-  } else { // check if Tc or Delta0 have changed
-    for (unsigned int i(0); i<par.size(); i++) {
-      if (par[i] != fPar[i]) {
-        fPar[i] = par[i];
-        integralParChanged = true;
-      }
-    }
-  }
+  TGapIntegralCache<TGapIntegral>::TCalcFunc calc([this, &par](double tt, TGapIntegral *integral) { return CalcIntegral(tt, par, integral); });
 
-  bool newTemp(false);
-  unsigned int vectorIndex;
+  if (fCache.SetParameters(par)) // parameters changed: calculate the integrals for all temperatures of the data set at once
+    fCache.Update(par[0], calc);
 
-  if (integralParChanged) {
-    fCalcNeeded.clear();
-    fCalcNeeded.resize(fTemp.size(), true);
-  }
-
-  fTempIter = find(fTemp.begin(), fTemp.end(), t);
-  if(fTempIter == fTemp.end()) {
-    fTemp.push_back(t);
-    vectorIndex = fTemp.size() - 1;
-    fCalcNeeded.push_back(true);
-    newTemp = true;
-  } else {
-    vectorIndex = fTempIter - fTemp.begin();
-  }
-
-  if (fCalcNeeded[vectorIndex]) {
+  return fCache.GetValue(t, calc);
+}
 
-    double ds;
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integral at one temperature 0 < t < Tc. Only the integrator given is used, hence this can be
+ * called concurrently with different integrators.
+ *
+ * \param t temperature (K)
+ * \param par parameters of the function, see operator()
+ * \param integral integrator to be used
+ */
+double TGapSWave::CalcIntegral(double t, const std::vector<double> &par, TGapIntegral *integral) const {
 
-    std::vector<double> intPar; // parameters for the integral, T & Delta(T)
-    intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
-    if (par.size() == 2) { // Carrington/Manzano
-      intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
-    } else { // Prozorov/Giannetta
-      intPar.push_back(par[1]*tanh(par[2]*sqrt(par[3]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
-    }
+  double ds;
 
-    fGapIntegral->SetParameters(intPar);
-    ds = 1.0-1.0/intPar[0]*fGapIntegral->IntegrateFunc(0.0, 2.0*(t+intPar[1]));
+  std::vector<double> intPar; // parameters for the integral, T & Delta(T)
+  intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
+  if (par.size() == 2) { // Carrington/Manzano
+    intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
+  } else { // Prozorov/Giannetta
+    intPar.push_back(par[1]*tanh(par[2]*sqrt(par[3]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
+  }
 
-    intPar.clear();
+  integral->SetParameters(intPar);
+  ds = 1.0-1.0/intPar[0]*integral->IntegrateFunc(0.0, 2.0*(t+intPar[1]));
 
-    if (newTemp)
-      fIntegralValues.push_back(ds);
-    else
-      fIntegralValues[vectorIndex] = ds;
+  return ds;
+}
 
-    fCalcNeeded[vectorIndex] = false;
-  }
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integrals for all temperatures of a data set in one go (in parallel if the integrator allows it).
+ *
+ * \param t temperatures (K)
+ * \param par parameters of the function, see operator()
+ */
+void TGapSWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const {
 
-  return fIntegralValues[vectorIndex];
+  TGapIntegralCache<TGapIntegral>::TCalcFunc calc([this, &par](double tt, TGapIntegral *integral) { return CalcIntegral(tt, par, integral); });
 
+  fCache.SetParameters(par);
+  fCache.Calculate(t, par[0], calc);
 }
 
 //--------------------------------------------------------------------
@@ -683,77 +519,68 @@ double TGapPointPWave::operator()(double t, const std::vector<double> &par) cons
   else if (t >= par[0])
     return 0.0;
 
+  TGapIntegralCache<TPointPWaveGapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TPointPWaveGapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
+
+  if (fCache.SetParameters(par)) // parameters changed: calculate the integrals for all temperatures of the data set at once
+    fCache.Update(par[0], calc);
+
+  return fCache.GetValue(t, calc);
+}
+
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integral at one temperature 0 < t < Tc. Only the integrator given is used, hence this can be
+ * called concurrently with different integrators.
+ *
+ * \param t temperature (K)
+ * \param par parameters of the function, see operator()
+ * \param integral integrator to be used
+ */
+double TGapPointPWave::CalcIntegral(double t, const std::vector<double> &par, TPointPWaveGapIntegralCuhre *integral) const {
+
   // check if orientation tag is given
   int orientation_tag(2);
   if ((par.size()==3) || (par.size()==5))
     orientation_tag = static_cast<int>(par[2]);
 
-  bool integralParChanged(false);
-
-  if (fPar.empty()) { // first time calling this routine
-    fPar = par;
-    integralParChanged = true;
-  } else { // check if Tc or Delta0 have changed
-    for (unsigned int i(0); i<par.size(); i++) {
-      if (par[i] != fPar[i]) {
-        fPar[i] = par[i];
-        integralParChanged = true;
-      }
-    }
+  double ds, ds1;
+  std::vector<double> intPar; // parameters for the integral, T & Delta(T)
+  intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
+  if ((par.size() == 2) || (par.size() == 3)) { // Carrington/Manzano
+    intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
+  } else { // Prozorov/Giannetta
+    intPar.push_back(par[1]*tanh(par[2]*sqrt(par[3]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
   }
-
-  bool newTemp(false);
-  unsigned int vectorIndex;
-
-  if (integralParChanged) {
-    fCalcNeeded.clear();
-    fCalcNeeded.resize(fTemp.size(), true);
+  intPar.push_back(4.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
+  intPar.push_back(1.0); // upper limit of theta-integration
+
+  integral->SetParameters(intPar);
+  if (orientation_tag == 0) // aa,bb
+    ds = 1.0-(intPar[2]*3.0)/(2.0*intPar[0])*integral->IntegrateFunc(0); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
+  else if (orientation_tag == 1) // cc
+    ds = 1.0-(intPar[2]*3.0)/(intPar[0])*integral->IntegrateFunc(1); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
+  else { // average
+    ds = 1.0-(intPar[2]*3.0)/(2.0*intPar[0])*integral->IntegrateFunc(0); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
+    ds1 = 1.0-(intPar[2]*3.0)/(intPar[0])*integral->IntegrateFunc(1); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
+    ds = (ds + 2.0 * sqrt(ds*ds1))/3.0; // since aa==bb the avg looks like this
   }
 
-  fTempIter = find(fTemp.begin(), fTemp.end(), t);
-  if(fTempIter == fTemp.end()) {
-    fTemp.push_back(t);
-    vectorIndex = fTemp.size() - 1;
-    fCalcNeeded.push_back(true);
-    newTemp = true;
-  } else {
-    vectorIndex = fTempIter - fTemp.begin();
-  }
+  return ds;
+}
 
-  if (fCalcNeeded[vectorIndex]) {
-    double ds, ds1;
-    std::vector<double> intPar; // parameters for the integral, T & Delta(T)
-    intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
-    if ((par.size() == 2) || (par.size() == 3)) { // Carrington/Manzano
-      intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
-    } else { // Prozorov/Giannetta
-      intPar.push_back(par[1]*tanh(par[2]*sqrt(par[3]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
-    }
-    intPar.push_back(4.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
-    intPar.push_back(1.0); // upper limit of theta-integration
-
-    fGapIntegral->SetParameters(intPar);
-    if (orientation_tag == 0) // aa,bb
-      ds = 1.0-(intPar[2]*3.0)/(2.0*intPar[0])*fGapIntegral->IntegrateFunc(0); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
-    else if (orientation_tag == 1) // cc
-      ds = 1.0-(intPar[2]*3.0)/(intPar[0])*fGapIntegral->IntegrateFunc(1); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
-    else { // average
-      ds = 1.0-(intPar[2]*3.0)/(2.0*intPar[0])*fGapIntegral->IntegrateFunc(0); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
-      ds1 = 1.0-(intPar[2]*3.0)/(intPar[0])*fGapIntegral->IntegrateFunc(1); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
-      ds = (ds + 2.0 * sqrt(ds*ds1))/3.0; // since aa==bb the avg looks like this
-    }
-
-    intPar.clear();
-
-    if (newTemp)
-      fIntegralValues.push_back(ds);
-    else
-      fIntegralValues[vectorIndex] = ds;
-
-    fCalcNeeded[vectorIndex] = false;
-  }
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integrals for all temperatures of a data set in one go (in parallel if the integrator allows it).
+ *
+ * \param t temperatures (K)
+ * \param par parameters of the function, see operator()
+ */
+void TGapPointPWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const {
 
-  return fIntegralValues[vectorIndex];
+  TGapIntegralCache<TPointPWaveGapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TPointPWaveGapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
+
+  fCache.SetParameters(par);
+  fCache.Calculate(t, par[0], calc);
 }
 
 //--------------------------------------------------------------------
@@ -775,78 +602,68 @@ double TGapLinePWave::operator()(double t, const std::vector<double> &par) const
   else if (t >= par[0])
     return 0.0;
 
+  TGapIntegralCache<TLinePWaveGapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TLinePWaveGapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
+
+  if (fCache.SetParameters(par)) // parameters changed: calculate the integrals for all temperatures of the data set at once
+    fCache.Update(par[0], calc);
+
+  return fCache.GetValue(t, calc);
+}
+
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integral at one temperature 0 < t < Tc. Only the integrator given is used, hence this can be
+ * called concurrently with different integrators.
+ *
+ * \param t temperature (K)
+ * \param par parameters of the function, see operator()
+ * \param integral integrator to be used
+ */
+double TGapLinePWave::CalcIntegral(double t, const std::vector<double> &par, TLinePWaveGapIntegralCuhre *integral) const {
 
   // check if orientation tag is given
   int orientation_tag(2);
   if ((par.size()==3) || (par.size()==5))
     orientation_tag = static_cast<int>(par[2]);
 
-  bool integralParChanged(false);  
-
-  if (fPar.empty()) { // first time calling this routine
-    fPar = par;
-    integralParChanged = true;
-  } else { // check if parameter have changed
-    for (unsigned int i(0); i<par.size(); i++) {
-      if (par[i] != fPar[i]) {
-        fPar[i] = par[i];
-        integralParChanged = true;
-      }
-    }
+  double ds, ds1;
+  std::vector<double> intPar; // parameters for the integral, T & Delta(T)
+  intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
+  if ((par.size() == 2) || (par.size() == 3)) { // Carrington/Manzano
+    intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
+  } else { // Prozorov/Giannetta
+    intPar.push_back(par[1]*tanh(par[3]*sqrt(par[4]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
   }
-
-  bool newTemp(false);
-  unsigned int vectorIndex;
-
-  if (integralParChanged) {
-    fCalcNeeded.clear();
-    fCalcNeeded.resize(fTemp.size(), true);
+  intPar.push_back(4.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
+  intPar.push_back(1.0); // upper limit of z-integration
+
+  integral->SetParameters(intPar);
+  if (orientation_tag == 0) // aa,bb
+    ds = 1.0-(intPar[2]*3.0)/(2.0*intPar[0])*integral->IntegrateFunc(0); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
+  else if (orientation_tag == 1) // cc
+    ds = 1.0-(intPar[2]*3.0)/(intPar[0])*integral->IntegrateFunc(1); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
+  else { // average
+    ds = 1.0-(intPar[2]*3.0)/(2.0*intPar[0])*integral->IntegrateFunc(0); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
+    ds1 = 1.0-(intPar[2]*3.0)/(intPar[0])*integral->IntegrateFunc(1); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
+    ds = (ds + 2.0 * sqrt(ds*ds1))/3.0; // since aa==bb the avg looks like this
   }
 
-  fTempIter = find(fTemp.begin(), fTemp.end(), t);
-  if(fTempIter == fTemp.end()) {
-    fTemp.push_back(t);
-    vectorIndex = fTemp.size() - 1;
-    fCalcNeeded.push_back(true);
-    newTemp = true;
-  } else {
-    vectorIndex = fTempIter - fTemp.begin();
-  }
+  return ds;
+}
 
-  if (fCalcNeeded[vectorIndex]) {
-    double ds, ds1;
-    std::vector<double> intPar; // parameters for the integral, T & Delta(T)
-    intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
-    if ((par.size() == 2) || (par.size() == 3)) { // Carrington/Manzano
-      intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
-    } else { // Prozorov/Giannetta
-      intPar.push_back(par[1]*tanh(par[3]*sqrt(par[4]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
-    }
-    intPar.push_back(4.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
-    intPar.push_back(1.0); // upper limit of z-integration
-
-    fGapIntegral->SetParameters(intPar);
-    if (orientation_tag == 0) // aa,bb
-      ds = 1.0-(intPar[2]*3.0)/(2.0*intPar[0])*fGapIntegral->IntegrateFunc(0); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
-    else if (orientation_tag == 1) // cc
-      ds = 1.0-(intPar[2]*3.0)/(intPar[0])*fGapIntegral->IntegrateFunc(1); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
-    else { // average
-      ds = 1.0-(intPar[2]*3.0)/(2.0*intPar[0])*fGapIntegral->IntegrateFunc(0); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
-      ds1 = 1.0-(intPar[2]*3.0)/(intPar[0])*fGapIntegral->IntegrateFunc(1); // integral prefactor is by 2 lower [Eqs.(19,20)] since intPar[0]==2kB T!
-      ds = (ds + 2.0 * sqrt(ds*ds1))/3.0; // since aa==bb the avg looks like this
-    }
-
-    intPar.clear();
-
-    if (newTemp)
-      fIntegralValues.push_back(ds);
-    else
-      fIntegralValues[vectorIndex] = ds;
-
-    fCalcNeeded[vectorIndex] = false;
-  }
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integrals for all temperatures of a data set in one go (in parallel if the integrator allows it).
+ *
+ * \param t temperatures (K)
+ * \param par parameters of the function, see operator()
+ */
+void TGapLinePWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const {
 
-  return fIntegralValues[vectorIndex];
+  TGapIntegralCache<TLinePWaveGapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TLinePWaveGapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
+
+  fCache.SetParameters(par);
+  fCache.Calculate(t, par[0], calc);
 }
 
 //--------------------------------------------------------------------
@@ -867,69 +684,59 @@ double TGapDWave::operator()(double t, const std::vector<double> &par) const {
   else if (t >= par[0])
     return 0.0;
 
-  bool integralParChanged(false);
-
-  if (fPar.empty()) { // first time calling this routine
-    fPar = par;
-    integralParChanged = true;
-  } else { // check if Tc or Delta0 have changed
-    for (unsigned int i(0); i<par.size(); i++) {
-      if (par[i] != fPar[i]) {
-        fPar[i] = par[i];
-        integralParChanged = true;
-      }
-    }
-  }
+  TGapIntegralCache<TDWaveGapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TDWaveGapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
 
-  bool newTemp(false);
-  unsigned int vectorIndex;
+  if (fCache.SetParameters(par)) // parameters changed: calculate the integrals for all temperatures of the data set at once
+    fCache.Update(par[0], calc);
 
-  if (integralParChanged) {
-    fCalcNeeded.clear();
-    fCalcNeeded.resize(fTemp.size(), true);
-  }
-
-  fTempIter = find(fTemp.begin(), fTemp.end(), t);
-  if(fTempIter == fTemp.end()) {
-    fTemp.push_back(t);
-    vectorIndex = fTemp.size() - 1;
-    fCalcNeeded.push_back(true);
-    newTemp = true;
-  } else {
-    vectorIndex = fTempIter - fTemp.begin();
-  }
+  return fCache.GetValue(t, calc);
+}
 
-  if (fCalcNeeded[vectorIndex]) {
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integral at one temperature 0 < t < Tc. Only the integrator given is used, hence this can be
+ * called concurrently with different integrators.
+ *
+ * \param t temperature (K)
+ * \param par parameters of the function, see operator()
+ * \param integral integrator to be used
+ */
+double TGapDWave::CalcIntegral(double t, const std::vector<double> &par, TDWaveGapIntegralCuhre *integral) const {
 
-    double ds;
-    std::vector<double> intPar; // parameters for the integral, T & Delta(T)
-    intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
-    if (par.size() == 2) { // Carrington/Manzano
-      intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
-    } else { // Prozorov/Giannetta
-      intPar.push_back(par[1]*tanh(par[2]*sqrt(par[3]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
-    }
-    intPar.push_back(4.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
-    intPar.push_back(TMath::PiOver2()); // upper limit of phi-integration
+  double ds;
+  std::vector<double> intPar; // parameters for the integral, T & Delta(T)
+  intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
+  if (par.size() == 2) { // Carrington/Manzano
+    intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
+  } else { // Prozorov/Giannetta
+    intPar.push_back(par[1]*tanh(par[2]*sqrt(par[3]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
+  }
+  intPar.push_back(4.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
+  intPar.push_back(TMath::PiOver2()); // upper limit of phi-integration
 
 //    double xl[] = {0.0, 0.0}; // lower bound E, phi
 //    double xu[] = {4.0*(t+intPar[1]), 0.5*PI}; // upper bound E, phi
 
-    fGapIntegral->SetParameters(intPar);
-//    ds = 1.0+4.0/PI*fGapIntegral->IntegrateFunc(2, xl, xu);
-    ds = 1.0-intPar[2]/intPar[0]*fGapIntegral->IntegrateFunc();
+  integral->SetParameters(intPar);
+//    ds = 1.0+4.0/PI*integral->IntegrateFunc(2, xl, xu);
+  ds = 1.0-intPar[2]/intPar[0]*integral->IntegrateFunc();
 
-    intPar.clear();
+  return ds;
+}
 
-    if (newTemp)
-      fIntegralValues.push_back(ds);
-    else
-      fIntegralValues[vectorIndex] = ds;
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integrals for all temperatures of a data set in one go (in parallel if the integrator allows it).
+ *
+ * \param t temperatures (K)
+ * \param par parameters of the function, see operator()
+ */
+void TGapDWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const {
 
-    fCalcNeeded[vectorIndex] = false;
-  }
+  TGapIntegralCache<TDWaveGapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TDWaveGapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
 
-  return fIntegralValues[vectorIndex];
+  fCache.SetParameters(par);
+  fCache.Calculate(t, par[0], calc);
 }
 
 //--------------------------------------------------------------------
@@ -949,75 +756,64 @@ double TGapCosSqDWave::operator()(double t, const std::vector<double> &par) cons
   else if (t >= par[0])
     return 0.0;
 
-  bool integralParChanged(false);
-
-  if (fPar.empty()) { // first time calling this routine
-    fPar = par;
-    integralParChanged = true;
-  } else { // check if Tc or Delta0 have changed
-    for (unsigned int i(0); i<par.size(); i++) {
-      if (par[i] != fPar[i]) {
-        fPar[i] = par[i];
-        integralParChanged = true;
-      }
-    }
-  }
+  TGapIntegralCache<TCosSqDWaveGapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TCosSqDWaveGapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
 
-  bool newTemp(false);
-  unsigned int vectorIndex;
+  if (fCache.SetParameters(par)) // parameters changed: calculate the integrals for all temperatures of the data set at once
+    fCache.Update(par[0], calc);
 
-  if (integralParChanged) {
-    fCalcNeeded.clear();
-    fCalcNeeded.resize(fTemp.size(), true);
-  }
+  return fCache.GetValue(t, calc);
+}
 
-  fTempIter = find(fTemp.begin(), fTemp.end(), t);
-  if(fTempIter == fTemp.end()) {
-    fTemp.push_back(t);
-    vectorIndex = fTemp.size() - 1;
-    fCalcNeeded.push_back(true);
-    newTemp = true;
-  } else {
-    vectorIndex = fTempIter - fTemp.begin();
-  }
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integral at one temperature 0 < t < Tc. Only the integrator given is used, hence this can be
+ * called concurrently with different integrators.
+ *
+ * \param t temperature (K)
+ * \param par parameters of the function, see operator()
+ * \param integral integrator to be used
+ */
+double TGapCosSqDWave::CalcIntegral(double t, const std::vector<double> &par, TCosSqDWaveGapIntegralCuhre *integral) const {
 
-  if (fCalcNeeded[vectorIndex]) {
-
-    double ds;
-    std::vector<double> intPar; // parameters for the integral, T & Delta(T)
-    intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
-    if (par.size() == 3) { // Carrington/Manzano
-      intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
-    } else { // Prozorov/Giannetta
-      intPar.push_back(par[1]*tanh(par[3]*sqrt(par[4]*(par[0]/t-1.0)))); // Delta0_D*tanh(c0_D*sqrt(aG_D*(Tc/T-1)))
-    }
-    intPar.push_back(1.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
-    intPar.push_back(TMath::Pi()); // upper limit of phi-integration
-    if (par.size() == 3) { // Carrington/Manzano
-      intPar.push_back(par[2]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
-    } else { // Prozorov/Giannetta
-      intPar.push_back(par[2]*tanh(par[5]*sqrt(par[6]*(par[0]/t-1.0)))); // Delta0_S*tanh(c0_S*sqrt(aG_S*(Tc/T-1)))
-    }
+  double ds;
+  std::vector<double> intPar; // parameters for the integral, T & Delta(T)
+  intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
+  if (par.size() == 3) { // Carrington/Manzano
+    intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
+  } else { // Prozorov/Giannetta
+    intPar.push_back(par[1]*tanh(par[3]*sqrt(par[4]*(par[0]/t-1.0)))); // Delta0_D*tanh(c0_D*sqrt(aG_D*(Tc/T-1)))
+  }
+  intPar.push_back(1.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
+  intPar.push_back(TMath::Pi()); // upper limit of phi-integration
+  if (par.size() == 3) { // Carrington/Manzano
+    intPar.push_back(par[2]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
+  } else { // Prozorov/Giannetta
+    intPar.push_back(par[2]*tanh(par[5]*sqrt(par[6]*(par[0]/t-1.0)))); // Delta0_S*tanh(c0_S*sqrt(aG_S*(Tc/T-1)))
+  }
 
 //    double xl[] = {0.0, 0.0}; // lower bound E, phi
 //    double xu[] = {4.0*(t+intPar[1]), 0.5*PI}; // upper bound E, phi
 
-    fGapIntegral->SetParameters(intPar);
-//    ds = 1.0+4.0/PI*fGapIntegral->IntegrateFunc(2, xl, xu);
-    ds = 1.0-2.0*intPar[2]/intPar[0]*fGapIntegral->IntegrateFunc();
-
-    intPar.clear();
+  integral->SetParameters(intPar);
+//    ds = 1.0+4.0/PI*integral->IntegrateFunc(2, xl, xu);
+  ds = 1.0-2.0*intPar[2]/intPar[0]*integral->IntegrateFunc();
 
-    if (newTemp)
-      fIntegralValues.push_back(ds);
-    else
-      fIntegralValues[vectorIndex] = ds;
+  return ds;
+}
 
-    fCalcNeeded[vectorIndex] = false;
-  }
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integrals for all temperatures of a data set in one go (in parallel if the integrator allows it).
+ *
+ * \param t temperatures (K)
+ * \param par parameters of the function, see operator()
+ */
+void TGapCosSqDWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const {
 
-  return fIntegralValues[vectorIndex];
+  TGapIntegralCache<TCosSqDWaveGapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TCosSqDWaveGapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
 
+  fCache.SetParameters(par);
+  fCache.Calculate(t, par[0], calc);
 }
 
 //--------------------------------------------------------------------
@@ -1038,75 +834,64 @@ double TGapSinSqDWave::operator()(double t, const std::vector<double> &par) cons
   else if (t >= par[0])
     return 0.0;
 
-  bool integralParChanged(false);
-
-  if (fPar.empty()) { // first time calling this routine
-    fPar = par;
-    integralParChanged = true;
-  } else { // check if Tc or Delta0 have changed
-    for (unsigned int i(0); i<par.size(); i++) {
-      if (par[i] != fPar[i]) {
-        fPar[i] = par[i];
-        integralParChanged = true;
-      }
-    }
-  }
+  TGapIntegralCache<TSinSqDWaveGapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TSinSqDWaveGapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
 
-  bool newTemp(false);
-  unsigned int vectorIndex;
+  if (fCache.SetParameters(par)) // parameters changed: calculate the integrals for all temperatures of the data set at once
+    fCache.Update(par[0], calc);
 
-  if (integralParChanged) {
-    fCalcNeeded.clear();
-    fCalcNeeded.resize(fTemp.size(), true);
-  }
+  return fCache.GetValue(t, calc);
+}
 
-  fTempIter = find(fTemp.begin(), fTemp.end(), t);
-  if(fTempIter == fTemp.end()) {
-    fTemp.push_back(t);
-    vectorIndex = fTemp.size() - 1;
-    fCalcNeeded.push_back(true);
-    newTemp = true;
-  } else {
-    vectorIndex = fTempIter - fTemp.begin();
-  }
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integral at one temperature 0 < t < Tc. Only the integrator given is used, hence this can be
+ * called concurrently with different integrators.
+ *
+ * \param t temperature (K)
+ * \param par parameters of the function, see operator()
+ * \param integral integrator to be used
+ */
+double TGapSinSqDWave::CalcIntegral(double t, const std::vector<double> &par, TSinSqDWaveGapIntegralCuhre *integral) const {
 
-  if (fCalcNeeded[vectorIndex]) {
-
-    double ds;
-    std::vector<double> intPar; // parameters for the integral, T & Delta(T)
-    intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
-    if (par.size() == 3) { // Carrington/Manzano
-      intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
-    } else { // Prozorov/Giannetta
-      intPar.push_back(par[1]*tanh(par[3]*sqrt(par[4]*(par[0]/t-1.0)))); // Delta0_D*tanh(c0_D*sqrt(aG_D*(Tc/T-1)))
-    }
-    intPar.push_back(1.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
-    intPar.push_back(TMath::Pi()); // upper limit of phi-integration
-    if (par.size() == 3) { // Carrington/Manzano
-      intPar.push_back(par[2]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
-    } else { // Prozorov/Giannetta
-      intPar.push_back(par[2]*tanh(par[5]*sqrt(par[6]*(par[0]/t-1.0)))); // Delta0_S*tanh(c0_S*sqrt(aG_S*(Tc/T-1)))
-    }
+  double ds;
+  std::vector<double> intPar; // parameters for the integral, T & Delta(T)
+  intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
+  if (par.size() == 3) { // Carrington/Manzano
+    intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
+  } else { // Prozorov/Giannetta
+    intPar.push_back(par[1]*tanh(par[3]*sqrt(par[4]*(par[0]/t-1.0)))); // Delta0_D*tanh(c0_D*sqrt(aG_D*(Tc/T-1)))
+  }
+  intPar.push_back(1.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
+  intPar.push_back(TMath::Pi()); // upper limit of phi-integration
+  if (par.size() == 3) { // Carrington/Manzano
+    intPar.push_back(par[2]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
+  } else { // Prozorov/Giannetta
+    intPar.push_back(par[2]*tanh(par[5]*sqrt(par[6]*(par[0]/t-1.0)))); // Delta0_S*tanh(c0_S*sqrt(aG_S*(Tc/T-1)))
+  }
 
 //    double xl[] = {0.0, 0.0}; // lower bound E, phi
 //    double xu[] = {4.0*(t+intPar[1]), 0.5*PI}; // upper bound E, phi
 
-    fGapIntegral->SetParameters(intPar);
-//    ds = 1.0+4.0/PI*fGapIntegral->IntegrateFunc(2, xl, xu);
-    ds = 1.0-2.0*intPar[2]/intPar[0]*fGapIntegral->IntegrateFunc();
+  integral->SetParameters(intPar);
+//    ds = 1.0+4.0/PI*integral->IntegrateFunc(2, xl, xu);
+  ds = 1.0-2.0*intPar[2]/intPar[0]*integral->IntegrateFunc();
 
-    intPar.clear();
-
-    if (newTemp)
-      fIntegralValues.push_back(ds);
-    else
-      fIntegralValues[vectorIndex] = ds;
+  return ds;
+}
 
-    fCalcNeeded[vectorIndex] = false;
-  }
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integrals for all temperatures of a data set in one go (in parallel if the integrator allows it).
+ *
+ * \param t temperatures (K)
+ * \param par parameters of the function, see operator()
+ */
+void TGapSinSqDWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const {
 
-  return fIntegralValues[vectorIndex];
+  TGapIntegralCache<TSinSqDWaveGapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TSinSqDWaveGapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
 
+  fCache.SetParameters(par);
+  fCache.Calculate(t, par[0], calc);
 }
 
 //--------------------------------------------------------------------
@@ -1128,71 +913,60 @@ double TGapAnSWave::operator()(double t, const std::vector<double> &par) const {
   else if (t >= par[0])
     return 0.0;
 
-  bool integralParChanged(false);
-
-  if (fPar.empty()) { // first time calling this routine
-    fPar = par;
-    integralParChanged = true;
-  } else { // check if Tc or Delta0 have changed
-    for (unsigned int i(0); i<par.size(); i++) {
-      if (par[i] != fPar[i]) {
-        fPar[i] = par[i];
-        integralParChanged = true;
-      }
-    }
-  }
-
-  bool newTemp(false);
-  unsigned int vectorIndex;
+  TGapIntegralCache<TAnSWaveGapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TAnSWaveGapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
 
-  if (integralParChanged) {
-    fCalcNeeded.clear();
-    fCalcNeeded.resize(fTemp.size(), true);
-  }
+  if (fCache.SetParameters(par)) // parameters changed: calculate the integrals for all temperatures of the data set at once
+    fCache.Update(par[0], calc);
 
-  fTempIter = find(fTemp.begin(), fTemp.end(), t);
-  if(fTempIter == fTemp.end()) {
-    fTemp.push_back(t);
-    vectorIndex = fTemp.size() - 1;
-    fCalcNeeded.push_back(true);
-    newTemp = true;
-  } else {
-    vectorIndex = fTempIter - fTemp.begin();
-  }
+  return fCache.GetValue(t, calc);
+}
 
-  if (fCalcNeeded[vectorIndex]) {
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integral at one temperature 0 < t < Tc. Only the integrator given is used, hence this can be
+ * called concurrently with different integrators.
+ *
+ * \param t temperature (K)
+ * \param par parameters of the function, see operator()
+ * \param integral integrator to be used
+ */
+double TGapAnSWave::CalcIntegral(double t, const std::vector<double> &par, TAnSWaveGapIntegralCuhre *integral) const {
 
-    double ds;
-    std::vector<double> intPar; // parameters for the integral, T & Delta(T)
-    intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
-    if (par.size() == 3) { // Carrington/Manzano
-      intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
-    } else { // Prozorov/Giannetta
-      intPar.push_back(par[1]*tanh(par[3]*sqrt(par[4]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
-    }
-    intPar.push_back(par[2]);
-    intPar.push_back(4.0*(t+(1.0+par[2])*intPar[1])); // upper limit of energy-integration: cutoff energy
-    intPar.push_back(TMath::PiOver2()); // upper limit of phi-integration
+  double ds;
+  std::vector<double> intPar; // parameters for the integral, T & Delta(T)
+  intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
+  if (par.size() == 3) { // Carrington/Manzano
+    intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
+  } else { // Prozorov/Giannetta
+    intPar.push_back(par[1]*tanh(par[3]*sqrt(par[4]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
+  }
+  intPar.push_back(par[2]);
+  intPar.push_back(4.0*(t+(1.0+par[2])*intPar[1])); // upper limit of energy-integration: cutoff energy
+  intPar.push_back(TMath::PiOver2()); // upper limit of phi-integration
 
 //    double xl[] = {0.0, 0.0}; // lower bound E, phi
 //    double xu[] = {4.0*(t+intPar[1]), 0.5*PI}; // upper bound E, phi
 
-    fGapIntegral->SetParameters(intPar);
-//    ds = 1.0+4.0/PI*fGapIntegral->IntegrateFunc(2, xl, xu);
-    ds = 1.0-intPar[3]/intPar[0]*fGapIntegral->IntegrateFunc();
-
-    intPar.clear();
+  integral->SetParameters(intPar);
+//    ds = 1.0+4.0/PI*integral->IntegrateFunc(2, xl, xu);
+  ds = 1.0-intPar[3]/intPar[0]*integral->IntegrateFunc();
 
-    if (newTemp)
-      fIntegralValues.push_back(ds);
-    else
-      fIntegralValues[vectorIndex] = ds;
+  return ds;
+}
 
-    fCalcNeeded[vectorIndex] = false;
-  }
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integrals for all temperatures of a data set in one go (in parallel if the integrator allows it).
+ *
+ * \param t temperatures (K)
+ * \param par parameters of the function, see operator()
+ */
+void TGapAnSWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const {
 
-  return fIntegralValues[vectorIndex];
+  TGapIntegralCache<TAnSWaveGapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TAnSWaveGapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
 
+  fCache.SetParameters(par);
+  fCache.Calculate(t, par[0], calc);
 }
 
 //--------------------------------------------------------------------
@@ -1213,68 +987,57 @@ double TGapNonMonDWave1::operator()(double t, const std::vector<double> &par) co
   else if (t >= par[0])
     return 0.0;
 
-  bool integralParChanged(false);
-
-  if (fPar.empty()) { // first time calling this routine
-    fPar = par;
-    integralParChanged = true;
-  } else { // check if Tc or Delta0 have changed
-    for (unsigned int i(0); i<par.size(); i++) {
-      if (par[i] != fPar[i]) {
-        fPar[i] = par[i];
-        integralParChanged = true;
-      }
-    }
-  }
+  TGapIntegralCache<TNonMonDWave1GapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TNonMonDWave1GapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
 
-  bool newTemp(false);
-  unsigned int vectorIndex;
-
-  if (integralParChanged) {
-    fCalcNeeded.clear();
-    fCalcNeeded.resize(fTemp.size(), true);
-  }
+  if (fCache.SetParameters(par)) // parameters changed: calculate the integrals for all temperatures of the data set at once
+    fCache.Update(par[0], calc);
 
-  fTempIter = find(fTemp.begin(), fTemp.end(), t);
-  if(fTempIter == fTemp.end()) {
-    fTemp.push_back(t);
-    vectorIndex = fTemp.size() - 1;
-    fCalcNeeded.push_back(true);
-    newTemp = true;
-  } else {
-    vectorIndex = fTempIter - fTemp.begin();
-  }
-
-  if (fCalcNeeded[vectorIndex]) {
+  return fCache.GetValue(t, calc);
+}
 
-    double ds;
-    std::vector<double> intPar; // parameters for the integral: 2 k_B T, Delta(T), a, E_c, phi_c
-    intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
-    if (par.size() == 3) { // Carrington/Manzano
-      intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
-    } else { // Prozorov/Giannetta
-      intPar.push_back(par[1]*tanh(par[3]*sqrt(par[4]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
-    }
-    intPar.push_back(par[2]);
-    intPar.push_back(4.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
-    intPar.push_back(TMath::PiOver2()); // upper limit of phi-integration
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integral at one temperature 0 < t < Tc. Only the integrator given is used, hence this can be
+ * called concurrently with different integrators.
+ *
+ * \param t temperature (K)
+ * \param par parameters of the function, see operator()
+ * \param integral integrator to be used
+ */
+double TGapNonMonDWave1::CalcIntegral(double t, const std::vector<double> &par, TNonMonDWave1GapIntegralCuhre *integral) const {
 
-    fGapIntegral->SetParameters(intPar);
+  double ds;
+  std::vector<double> intPar; // parameters for the integral: 2 k_B T, Delta(T), a, E_c, phi_c
+  intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
+  if (par.size() == 3) { // Carrington/Manzano
+    intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
+  } else { // Prozorov/Giannetta
+    intPar.push_back(par[1]*tanh(par[3]*sqrt(par[4]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
+  }
+  intPar.push_back(par[2]);
+  intPar.push_back(4.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
+  intPar.push_back(TMath::PiOver2()); // upper limit of phi-integration
 
-    ds = 1.0-intPar[3]/intPar[0]*fGapIntegral->IntegrateFunc();
+  integral->SetParameters(intPar);
 
-    intPar.clear();
+  ds = 1.0-intPar[3]/intPar[0]*integral->IntegrateFunc();
 
-    if (newTemp)
-      fIntegralValues.push_back(ds);
-    else
-      fIntegralValues[vectorIndex] = ds;
+  return ds;
+}
 
-    fCalcNeeded[vectorIndex] = false;
-  }
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integrals for all temperatures of a data set in one go (in parallel if the integrator allows it).
+ *
+ * \param t temperatures (K)
+ * \param par parameters of the function, see operator()
+ */
+void TGapNonMonDWave1::Prepare(const std::vector<double> &t, const std::vector<double> &par) const {
 
-  return fIntegralValues[vectorIndex];
+  TGapIntegralCache<TNonMonDWave1GapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TNonMonDWave1GapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
 
+  fCache.SetParameters(par);
+  fCache.Calculate(t, par[0], calc);
 }
 
 //--------------------------------------------------------------------
@@ -1295,68 +1058,57 @@ double TGapNonMonDWave2::operator()(double t, const std::vector<double> &par) co
   else if (t >= par[0])
     return 0.0;
 
-  bool integralParChanged(false);
-
-  if (fPar.empty()) { // first time calling this routine
-    fPar = par;
-    integralParChanged = true;
-  } else { // check if Tc or Delta0 have changed
-    for (unsigned int i(0); i<par.size(); i++) {
-      if (par[i] != fPar[i]) {
-        fPar[i] = par[i];
-        integralParChanged = true;
-      }
-    }
-  }
+  TGapIntegralCache<TNonMonDWave2GapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TNonMonDWave2GapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
 
-  bool newTemp(false);
-  unsigned int vectorIndex;
-
-  if (integralParChanged) {
-    fCalcNeeded.clear();
-    fCalcNeeded.resize(fTemp.size(), true);
-  }
-
-  fTempIter = find(fTemp.begin(), fTemp.end(), t);
-  if(fTempIter == fTemp.end()) {
-    fTemp.push_back(t);
-    vectorIndex = fTemp.size() - 1;
-    fCalcNeeded.push_back(true);
-    newTemp = true;
-  } else {
-    vectorIndex = fTempIter - fTemp.begin();
-  }
+  if (fCache.SetParameters(par)) // parameters changed: calculate the integrals for all temperatures of the data set at once
+    fCache.Update(par[0], calc);
 
-  if (fCalcNeeded[vectorIndex]) {
+  return fCache.GetValue(t, calc);
+}
 
-    double ds;
-    std::vector<double> intPar; // parameters for the integral: 2 k_B T, Delta(T), a, E_c, phi_c
-    intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
-    if (par.size() == 3) { // Carrington/Manzano
-      intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
-    } else { // Prozorov/Giannetta
-      intPar.push_back(par[1]*tanh(par[3]*sqrt(par[4]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
-    }
-    intPar.push_back(par[2]);
-    intPar.push_back(4.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
-    intPar.push_back(TMath::PiOver2()); // upper limit of phi-integration
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integral at one temperature 0 < t < Tc. Only the integrator given is used, hence this can be
+ * called concurrently with different integrators.
+ *
+ * \param t temperature (K)
+ * \param par parameters of the function, see operator()
+ * \param integral integrator to be used
+ */
+double TGapNonMonDWave2::CalcIntegral(double t, const std::vector<double> &par, TNonMonDWave2GapIntegralCuhre *integral) const {
 
-    fGapIntegral->SetParameters(intPar);
+  double ds;
+  std::vector<double> intPar; // parameters for the integral: 2 k_B T, Delta(T), a, E_c, phi_c
+  intPar.push_back(0.172346648*t); // 2 kB T, kB in meV/K = 0.086173324 meV/K
+  if (par.size() == 3) { // Carrington/Manzano
+    intPar.push_back(par[1]*tanh(1.82*pow(1.018*(par[0]/t-1.0),0.51)));
+  } else { // Prozorov/Giannetta
+    intPar.push_back(par[1]*tanh(par[3]*sqrt(par[4]*(par[0]/t-1.0)))); // Delta0*tanh(c0*sqrt(aG*(Tc/T-1)))
+  }
+  intPar.push_back(par[2]);
+  intPar.push_back(4.0*(t+intPar[1])); // upper limit of energy-integration: cutoff energy
+  intPar.push_back(TMath::PiOver2()); // upper limit of phi-integration
 
-    ds = 1.0-intPar[3]/intPar[0]*fGapIntegral->IntegrateFunc();
+  integral->SetParameters(intPar);
 
-    intPar.clear();
+  ds = 1.0-intPar[3]/intPar[0]*integral->IntegrateFunc();
 
-    if (newTemp)
-      fIntegralValues.push_back(ds);
-    else
-      fIntegralValues[vectorIndex] = ds;
+  return ds;
+}
 
-    fCalcNeeded[vectorIndex] = false;
-  }
+//--------------------------------------------------------------------
+/**
+ * <p>calculate the integrals for all temperatures of a data set in one go (in parallel if the integrator allows it).
+ *
+ * \param t temperatures (K)
+ * \param par parameters of the function, see operator()
+ */
+void TGapNonMonDWave2::Prepare(const std::vector<double> &t, const std::vector<double> &par) const {
 
-  return fIntegralValues[vectorIndex];
+  TGapIntegralCache<TNonMonDWave2GapIntegralCuhre>::TCalcFunc calc([this, &par](double tt, TNonMonDWave2GapIntegralCuhre *integral) { return CalcIntegral(tt, par, integral); });
 
+  fCache.SetParameters(par);
+  fCache.Calculate(t, par[0], calc);
 }
 
 //--------------------------------------------------------------------
@@ -1425,6 +1177,15 @@ double TLambdaSWave::operator()(double t, const std::vector<double> &par) const
   return 1.0/sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaSWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1442,6 +1203,15 @@ double TLambdaPointPWave::operator()(double t, const std::vector<double> &par) c
   return 1.0/sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaPointPWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1459,6 +1229,15 @@ double TLambdaLinePWave::operator()(double t, const std::vector<double> &par) co
   return 1.0/sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaLinePWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1476,6 +1255,15 @@ double TLambdaDWave::operator()(double t, const std::vector<double> &par) const
   return 1.0/sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaDWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1493,6 +1281,15 @@ double TLambdaAnSWave::operator()(double t, const std::vector<double> &par) cons
   return 1.0/sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaAnSWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1510,6 +1307,15 @@ double TLambdaNonMonDWave1::operator()(double t, const std::vector<double> &par)
   return 1.0/sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaNonMonDWave1::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1527,6 +1333,15 @@ double TLambdaNonMonDWave2::operator()(double t, const std::vector<double> &par)
   return 1.0/sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaNonMonDWave2::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1561,6 +1376,15 @@ double TLambdaInvSWave::operator()(double t, const std::vector<double> &par) con
   return sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaInvSWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1578,6 +1402,15 @@ double TLambdaInvPointPWave::operator()(double t, const std::vector<double> &par
   return sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaInvPointPWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1595,6 +1428,15 @@ double TLambdaInvLinePWave::operator()(double t, const std::vector<double> &par)
   return sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaInvLinePWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1612,6 +1454,15 @@ double TLambdaInvDWave::operator()(double t, const std::vector<double> &par) con
   return sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaInvDWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1629,6 +1480,15 @@ double TLambdaInvAnSWave::operator()(double t, const std::vector<double> &par) c
   return sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaInvAnSWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1646,6 +1506,15 @@ double TLambdaInvNonMonDWave1::operator()(double t, const std::vector<double> &p
   return sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaInvNonMonDWave1::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1663,6 +1532,15 @@ double TLambdaInvNonMonDWave2::operator()(double t, const std::vector<double> &p
   return sqrt((*fLambdaInvSq)(t, par));
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TLambdaInvNonMonDWave2::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  fLambdaInvSq->Prepare(t, par);
+}
+
 //--------------------------------------------------------------------
 /**
  * <p>
@@ -1725,4 +1603,17 @@ double TFilmMagnetizationDWave::operator()(double t, const std::vector<double> &
 
 }
 
+//--------------------------------------------------------------------
+/**
+ * <p>
+ */
+void TFilmMagnetizationDWave::Prepare(const std::vector<double> &t, const std::vector<double> &par) const
+{
+  std::vector<double> parForGapIntegral;
+  parForGapIntegral.push_back(par[0]);
+  parForGapIntegral.push_back(par[1]);
+
+  fLambdaInvSq->Prepare(t, parForGapIntegral);
+}
+
 
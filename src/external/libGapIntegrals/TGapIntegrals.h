@@ -34,6 +34,7 @@
 
 #include "PUserFcnBase.h"
 #include "BMWIntegrator.h"
+#include "TGapIntegralCache.h"
 
 //--------------------------------------------------------------------
 /**
@@ -46,17 +47,14 @@ public:
   virtual ~TGapSWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
-  TGapIntegral *fGapIntegral;
-  mutable std::vector<double> fTemp;
-  mutable std::vector<double>::const_iterator fTempIter;
-  mutable std::vector<double> fIntegralValues;
-  mutable std::vector<bool> fCalcNeeded;
+  double CalcIntegral(double, const std::vector<double>&, TGapIntegral*) const;
 
-  mutable std::vector<double> fPar;
+  mutable TGapIntegralCache<TGapIntegral> fCache; //! integral values and integrators
 
-  ClassDef(TGapSWave,1)
+  ClassDef(TGapSWave,2)
 };
 
 //--------------------------------------------------------------------
@@ -70,17 +68,14 @@ public:
   virtual ~TGapPointPWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
-  TPointPWaveGapIntegralCuhre *fGapIntegral;
-  mutable std::vector<double> fTemp;
-  mutable std::vector<double>::const_iterator fTempIter;
-  mutable std::vector<double> fIntegralValues;
-  mutable std::vector<bool> fCalcNeeded;
+  double CalcIntegral(double, const std::vector<double>&, TPointPWaveGapIntegralCuhre*) const;
 
-  mutable std::vector<double> fPar;
+  mutable TGapIntegralCache<TPointPWaveGapIntegralCuhre> fCache; //! integral values and integrators
 
-  ClassDef(TGapPointPWave,1)
+  ClassDef(TGapPointPWave,2)
 };
 
 //--------------------------------------------------------------------
@@ -94,17 +89,14 @@ public:
   virtual ~TGapLinePWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
-  TLinePWaveGapIntegralCuhre *fGapIntegral;
-  mutable std::vector<double> fTemp;
-  mutable std::vector<double>::const_iterator fTempIter;
-  mutable std::vector<double> fIntegralValues;
-  mutable std::vector<bool> fCalcNeeded;
+  double CalcIntegral(double, const std::vector<double>&, TLinePWaveGapIntegralCuhre*) const;
 
-  mutable std::vector<double> fPar;
+  mutable TGapIntegralCache<TLinePWaveGapIntegralCuhre> fCache; //! integral values and integrators
 
-  ClassDef(TGapLinePWave,1)
+  ClassDef(TGapLinePWave,2)
 };
 
 //--------------------------------------------------------------------
@@ -118,17 +110,14 @@ public:
   virtual ~TGapDWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
-  TDWaveGapIntegralCuhre *fGapIntegral;
-  mutable std::vector<double> fTemp;
-  mutable std::vector<double>::const_iterator fTempIter;
-  mutable std::vector<double> fIntegralValues;
-  mutable std::vector<bool> fCalcNeeded;
+  double CalcIntegral(double, const std::vector<double>&, TDWaveGapIntegralCuhre*) const;
 
-  mutable std::vector<double> fPar;
+  mutable TGapIntegralCache<TDWaveGapIntegralCuhre> fCache; //! integral values and integrators
 
-  ClassDef(TGapDWave,1)
+  ClassDef(TGapDWave,2)
 };
 
 //--------------------------------------------------------------------
@@ -142,17 +131,14 @@ public:
   virtual ~TGapCosSqDWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
-  TCosSqDWaveGapIntegralCuhre *fGapIntegral;
-  mutable std::vector<double> fTemp;
-  mutable std::vector<double>::const_iterator fTempIter;
-  mutable std::vector<double> fIntegralValues;
-  mutable std::vector<bool> fCalcNeeded;
+  double CalcIntegral(double, const std::vector<double>&, TCosSqDWaveGapIntegralCuhre*) const;
 
-  mutable std::vector<double> fPar;
+  mutable TGapIntegralCache<TCosSqDWaveGapIntegralCuhre> fCache; //! integral values and integrators
 
-  ClassDef(TGapCosSqDWave,1)
+  ClassDef(TGapCosSqDWave,2)
 };
 
 //--------------------------------------------------------------------
@@ -166,17 +152,14 @@ public:
   virtual ~TGapSinSqDWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
-  TSinSqDWaveGapIntegralCuhre *fGapIntegral;
-  mutable std::vector<double> fTemp;
-  mutable std::vector<double>::const_iterator fTempIter;
-  mutable std::vector<double> fIntegralValues;
-  mutable std::vector<bool> fCalcNeeded;
+  double CalcIntegral(double, const std::vector<double>&, TSinSqDWaveGapIntegralCuhre*) const;
 
-  mutable std::vector<double> fPar;
+  mutable TGapIntegralCache<TSinSqDWaveGapIntegralCuhre> fCache; //! integral values and integrators
 
-  ClassDef(TGapSinSqDWave,1)
+  ClassDef(TGapSinSqDWave,2)
 };
 
 //--------------------------------------------------------------------
@@ -190,17 +173,14 @@ public:
   virtual ~TGapAnSWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
-  TAnSWaveGapIntegralCuhre *fGapIntegral;
-  mutable std::vector<double> fTemp;
-  mutable std::vector<double>::const_iterator fTempIter;
-  mutable std::vector<double> fIntegralValues;
-  mutable std::vector<bool> fCalcNeeded;
+  double CalcIntegral(double, const std::vector<double>&, TAnSWaveGapIntegralCuhre*) const;
 
-  mutable std::vector<double> fPar;
+  mutable TGapIntegralCache<TAnSWaveGapIntegralCuhre> fCache; //! integral values and integrators
 
-  ClassDef(TGapAnSWave,1)
+  ClassDef(TGapAnSWave,2)
 };
 
 //--------------------------------------------------------------------
@@ -214,17 +194,14 @@ public:
   virtual ~TGapNonMonDWave1();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
-  TNonMonDWave1GapIntegralCuhre *fGapIntegral;
-  mutable std::vector<double> fTemp;
-  mutable std::vector<double>::const_iterator fTempIter;
-  mutable std::vector<double> fIntegralValues;
-  mutable std::vector<bool> fCalcNeeded;
+  double CalcIntegral(double, const std::vector<double>&, TNonMonDWave1GapIntegralCuhre*) const;
 
-  mutable std::vector<double> fPar;
+  mutable TGapIntegralCache<TNonMonDWave1GapIntegralCuhre> fCache; //! integral values and integrators
 
-  ClassDef(TGapNonMonDWave1,1)
+  ClassDef(TGapNonMonDWave1,2)
 };
 
 //--------------------------------------------------------------------
@@ -238,17 +215,14 @@ public:
   virtual ~TGapNonMonDWave2();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
-  TNonMonDWave2GapIntegralCuhre *fGapIntegral;
-  mutable std::vector<double> fTemp;
-  mutable std::vector<double>::const_iterator fTempIter;
-  mutable std::vector<double> fIntegralValues;
-  mutable std::vector<bool> fCalcNeeded;
+  double CalcIntegral(double, const std::vector<double>&, TNonMonDWave2GapIntegralCuhre*) const;
 
-  mutable std::vector<double> fPar;
+  mutable TGapIntegralCache<TNonMonDWave2GapIntegralCuhre> fCache; //! integral values and integrators
 
-  ClassDef(TGapNonMonDWave2,1)
+  ClassDef(TGapNonMonDWave2,2)
 };
 
 
@@ -298,6 +272,7 @@ public:
   virtual ~TLambdaSWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapSWave *fLambdaInvSq;
@@ -316,6 +291,7 @@ public:
   virtual ~TLambdaPointPWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapPointPWave *fLambdaInvSq;
@@ -334,6 +310,7 @@ public:
   virtual ~TLambdaLinePWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapLinePWave *fLambdaInvSq;
@@ -352,6 +329,7 @@ public:
   virtual ~TLambdaDWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapDWave *fLambdaInvSq;
@@ -370,6 +348,7 @@ public:
   virtual ~TLambdaAnSWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapAnSWave *fLambdaInvSq;
@@ -388,6 +367,7 @@ public:
   virtual ~TLambdaNonMonDWave1();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapNonMonDWave1 *fLambdaInvSq;
@@ -406,6 +386,7 @@ public:
   virtual ~TLambdaNonMonDWave2();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapNonMonDWave2 *fLambdaInvSq;
@@ -441,6 +422,7 @@ public:
   virtual ~TLambdaInvSWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapSWave *fLambdaInvSq;
@@ -459,6 +441,7 @@ public:
   virtual ~TLambdaInvPointPWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapPointPWave *fLambdaInvSq;
@@ -477,6 +460,7 @@ public:
   virtual ~TLambdaInvLinePWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapLinePWave *fLambdaInvSq;
@@ -495,6 +479,7 @@ public:
   virtual ~TLambdaInvDWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapDWave *fLambdaInvSq;
@@ -513,6 +498,7 @@ public:
   virtual ~TLambdaInvAnSWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapAnSWave *fLambdaInvSq;
@@ -531,6 +517,7 @@ public:
   virtual ~TLambdaInvNonMonDWave1();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapNonMonDWave1 *fLambdaInvSq;
@@ -549,6 +536,7 @@ public:
   virtual ~TLambdaInvNonMonDWave2();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapNonMonDWave2 *fLambdaInvSq;
@@ -584,6 +572,7 @@ public:
   virtual ~TFilmMagnetizationDWave();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
 
 private:
   TGapDWave *fLambdaInvSq;
@@ -36,12 +36,79 @@
 #include <cmath>
 
 #include "PMusr.h"
+#include "BMWIntegrator.h"
 #include "PGbGLF.h"
 
 #define TWO_PI 6.28318530717958647692528676656
 
+// upper time limit (us) of the running integral of the non-analytic part
+#define PGBGLF_TMAX 32.0
+// maximal number of panels of the running integral
+#define PGBGLF_MAX_PANELS 16384
+// the running integral is skipped if its analytic bound is below this tolerance
+#define PGBGLF_TOLERANCE 1.0e-7
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Running integral of the non-analytic part of the GbG LF polarization.
+ */
+class PGbGLFIntegral : public TCumulativeIntegrator {
+  public:
+    PGbGLFIntegral() {}
+    virtual ~PGbGLFIntegral() {}
+
+    virtual double FuncAtX(double t, const std::vector<double> &par) const;
+};
+
+//--------------------------------------------------------------------------
+// FuncAtX
+//--------------------------------------------------------------------------
+/**
+ * <p>Integrand of the non-analytic part
+ *
+ * \param t time
+ * \param par parameters, see PGbGLF::operator()
+ */
+double PGbGLFIntegral::FuncAtX(double t, const std::vector<double> &par) const
+{
+  Double_t wExt = TWO_PI * GAMMA_BAR_MUON * par[0];
+  Double_t s0   = par[1];
+  Double_t s1   = s0*par[2]; // sigma0 * Rb
+
+  Double_t s02   = s0*s0;
+  Double_t s12   = s1*s1;
+  Double_t t2    = t*t;
+  Double_t aa = 1.0+t2*s12;
+
+  return 2.0*(s02*s02+3.0*s12*s12*aa*aa+6.0*s02*s12*aa)/(pow(wExt,3.0)*pow(aa,4.5))*exp(-0.5*s02*t2/aa)*sin(wExt*t);
+}
+
 ClassImp(PGbGLF)
 
+//--------------------------------------------------------------------------
+// Constructor
+//--------------------------------------------------------------------------
+/**
+ * <p>Constructor
+ */
+PGbGLF::PGbGLF()
+{
+  fIntegralNegligible = false;
+  fIntegral = new PGbGLFIntegral();
+}
+
+//--------------------------------------------------------------------------
+// Destructor
+//--------------------------------------------------------------------------
+/**
+ * <p>Destructor
+ */
+PGbGLF::~PGbGLF()
+{
+  delete fIntegral;
+  fIntegral = nullptr;
+}
+
 //--------------------------------------------------------------------------
 // operator()
 //--------------------------------------------------------------------------
@@ -77,48 +144,67 @@ Double_t PGbGLF::operator()(Double_t t, const std::vector<Double_t> &par) const
     Double_t aa = 1.0+t2*s12;
     dval = 1.0 - 2.0*(s02+s12)/wExt2 + 2.0*(s02+s12*aa)/(wExt2*pow(aa,2.5))*cos(wExt*t)*exp(-0.5*s02*t2/aa);
 
-    // P_z^LF (GbG, 2nd part)
-    Double_t dt = t;
-    Int_t n=1;
-    Double_t sumT = dt * pz_GbG_2(t, par) * 0.5;
-    Double_t sumM = 0.0;
-    Double_t tt = 0.0;
-    do {
-      sumM = 0.0;
-      for (Int_t i=0; i<n-1; i++) {
-        tt = (static_cast<Double_t>(i) + 0.5) * dt;
-        sumM += pz_GbG_2(tt, par);
+    // P_z^LF (GbG, 2nd part). The running integral is calculated once per parameter set,
+    // the time step resolves the Larmor precession as well as the Gaussian damping.
+    // Since aa >= 1, the integrand is bounded by 2(s0^4+3s1^4+6s0^2s1^2)/wExt^3, hence
+    // at high fields the integral up to PGBGLF_TMAX is negligible and is skipped. Otherwise
+    // the number of panels is limited to PGBGLF_MAX_PANELS.
+    if (par != fPrevParam) {
+      fPrevParam = par;
+      Double_t bound = 2.0*(s02*s02+3.0*s12*s12+6.0*s02*s12)/fabs(wExt*wExt2)*PGBGLF_TMAX;
+      fIntegralNegligible = (bound < PGBGLF_TOLERANCE);
+      if (!fIntegralNegligible) {
+        Double_t scale = wExt;
+        if (fabs(s0) > scale)
+          scale = fabs(s0);
+        if (fabs(s1) > scale)
+          scale = fabs(s1);
+        Double_t dt = 0.1/scale;
+        if (dt < PGBGLF_TMAX/PGBGLF_MAX_PANELS)
+          dt = PGBGLF_TMAX/PGBGLF_MAX_PANELS;
+        fIntegral->IntegrateFunc(0.0, PGBGLF_TMAX, dt, par);
       }
-      sumM *= dt;
-      sumT = (sumT + sumM)*0.5;
-      dt /= 2.0;
-      n *= 2;
-    } while ((fabs(sumT-sumM) > 1.0e-5) && (n < 8192));
-
-    dval += sumT;
+    }
+
+    if (t <= PGBGLF_TMAX) {
+      if (!fIntegralNegligible)
+        dval += fIntegral->GetIntegral(t);
+    } else {
+      dval += pz_GbG_2_Adaptive(t, par);
+    }
   }
 
   return dval;
 }
 
 //--------------------------------------------------------------------------
-// pz_GbG_2 (private)
+// pz_GbG_2_Adaptive (private)
 //--------------------------------------------------------------------------
 /**
- * <p>Integrand of the non-analytic part
+ * <p>Non-analytic part, integrated from 0 to t by adaptive midpoint/trapezoid refinement.
+ * Only used for times beyond the running integral.
  *
  * \param t time
+ * \param par parameters, see operator()
  */
-Double_t PGbGLF::pz_GbG_2(Double_t t, const std::vector<Double_t> &par) const
+Double_t PGbGLF::pz_GbG_2_Adaptive(Double_t t, const std::vector<Double_t> &par) const
 {
-  Double_t wExt = TWO_PI * GAMMA_BAR_MUON * par[0];
-  Double_t s0   = par[1];
-  Double_t s1   = s0*par[2]; // sigma0 * Rb
-
-  Double_t s02   = s0*s0;
-  Double_t s12   = s1*s1;
-  Double_t t2    = t*t;
-  Double_t aa = 1.0+t2*s12;
-
-  return 2.0*(s02*s02+3.0*s12*s12*aa*aa+6.0*s02*s12*aa)/(pow(wExt,3.0)*pow(aa,4.5))*exp(-0.5*s02*t2/aa)*sin(wExt*t);
+  Double_t dt = t;
+  Int_t n=1;
+  Double_t sumT = dt * fIntegral->FuncAtX(t, par) * 0.5;
+  Double_t sumM = 0.0;
+  Double_t tt = 0.0;
+  do {
+    sumM = 0.0;
+    for (Int_t i=0; i<n-1; i++) {
+      tt = (static_cast<Double_t>(i) + 0.5) * dt;
+      sumM += fIntegral->FuncAtX(tt, par);
+    }
+    sumM *= dt;
+    sumT = (sumT + sumM)*0.5;
+    dt /= 2.0;
+    n *= 2;
+  } while ((fabs(sumT-sumM) > 1.0e-5) && (n < 8192));
+
+  return sumT;
 }
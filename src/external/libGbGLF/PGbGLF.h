@@ -34,6 +34,8 @@
 
 #include "PUserFcnBase.h"
 
+class PGbGLFIntegral;
+
 //--------------------------------------------------------------------------------------------
 /**
  * <p>Interface class for the user function.
@@ -41,13 +43,18 @@
 class PGbGLF : public PUserFcnBase
 {
   public:
-    PGbGLF() {}
-    virtual ~PGbGLF() {}
+    PGbGLF();
+    virtual ~PGbGLF();
 
+    virtual Bool_t IsReentrant() const { return true; } ///< the running integral is kept in the instance
     virtual Double_t operator()(Double_t t, const std::vector<Double_t> &param) const;
 
   private:
-    Double_t pz_GbG_2(Double_t t, const std::vector<Double_t> &par) const;
+    mutable std::vector<Double_t> fPrevParam; ///< parameters for which fIntegral has been calculated
+    PGbGLFIntegral *fIntegral; //! running integral of the non-analytic LF part
+    mutable Bool_t fIntegralNegligible; ///< true if the analytic bound of the running integral is below tolerance
+
+    Double_t pz_GbG_2_Adaptive(Double_t t, const std::vector<Double_t> &par) const;
 
     ClassDef(PGbGLF, 1)
 };
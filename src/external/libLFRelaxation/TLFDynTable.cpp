@@ -0,0 +1,337 @@
+/***************************************************************************
+
+  TLFDynTable.cpp
+
+  Author: Bastian M. Wojek
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2009 by Bastian M. Wojek                                *
+ *                                                                         *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#define LFDYNTABLE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "TLFDynTable.h"
+
+#define LFDYNTABLE_MAGIC "LFDYNTB"
+#define LFDYNTABLE_VERSION 1
+
+//--------------------------------------------------------------------------
+// Constructor
+//--------------------------------------------------------------------------
+/**
+ * <p>Constructor
+ */
+TLFDynTable::TLFDynTable() : fData(nullptr), fMap(nullptr), fMapSize(0) {
+  memset(&fHeader, 0, sizeof(fHeader));
+}
+
+//--------------------------------------------------------------------------
+// Destructor
+//--------------------------------------------------------------------------
+/**
+ * <p>Destructor: unmap the table
+ */
+TLFDynTable::~TLFDynTable() {
+  Close();
+}
+
+//--------------------------------------------------------------------------
+// Open
+//--------------------------------------------------------------------------
+/**
+ * <p>Map a table file into memory and check that it is consistent.
+ *
+ * <p><b>return:</b> true if the table can be used, false otherwise
+ *
+ * \param fileName path to the table file
+ * \param function function the table has to describe, see ELFDynTableFunction
+ */
+bool TLFDynTable::Open(const std::string &fileName, const unsigned int function) {
+  Close();
+
+  if (fileName.empty())
+    return false;
+
+  std::ifstream fin(fileName.c_str(), std::ios::binary);
+  if (!fin.is_open())
+    return false;
+
+  TLFDynTableHeader header;
+  fin.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!fin.good() || strncmp(header.fMagic, LFDYNTABLE_MAGIC, sizeof(header.fMagic)) || (header.fVersion != LFDYNTABLE_VERSION)) {
+    std::cerr << "TLFDynTable::Open: " << fileName << " is not a valid LF-relaxation table." << std::endl;
+    return false;
+  }
+  if (header.fFunction != function) {
+    std::cerr << "TLFDynTable::Open: " << fileName << " has been generated for another function." << std::endl;
+    return false;
+  }
+  if ((header.fNx < 2) || (header.fNy < 2) || (header.fNt < 2) || (header.fXmax <= 0.0) || (header.fYmax <= 0.0) || (header.fTmax <= 0.0)) {
+    std::cerr << "TLFDynTable::Open: " << fileName << " contains an invalid grid." << std::endl;
+    return false;
+  }
+
+  const size_t noOfValues(static_cast<size_t>(header.fNx)*header.fNy*header.fNt);
+  fin.seekg(0, std::ios::end);
+  if (static_cast<size_t>(fin.tellg()) != sizeof(header) + noOfValues*sizeof(float)) {
+    std::cerr << "TLFDynTable::Open: " << fileName << " is truncated." << std::endl;
+    return false;
+  }
+
+#ifdef LFDYNTABLE_MMAP
+  int fd(open(fileName.c_str(), O_RDONLY));
+  if (fd >= 0) {
+    fMapSize = sizeof(header) + noOfValues*sizeof(float);
+    fMap = mmap(nullptr, fMapSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (fMap == MAP_FAILED) {
+      fMap = nullptr;
+      fMapSize = 0;
+    } else {
+      fData = reinterpret_cast<const float*>(static_cast<const char*>(fMap) + sizeof(header));
+    }
+  }
+#endif
+
+  if (!fData) { // read the table if it could not be mapped
+    fBuffer.resize(noOfValues);
+    fin.seekg(sizeof(header), std::ios::beg);
+    fin.read(reinterpret_cast<char*>(&fBuffer[0]), noOfValues*sizeof(float));
+    if (!fin.good()) {
+      fBuffer.clear();
+      return false;
+    }
+    fData = &fBuffer[0];
+  }
+
+  fHeader = header;
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+// Close
+//--------------------------------------------------------------------------
+/**
+ * <p>Release the table
+ */
+void TLFDynTable::Close() {
+#ifdef LFDYNTABLE_MMAP
+  if (fMap)
+    munmap(fMap, fMapSize);
+#endif
+  fMap = nullptr;
+  fMapSize = 0;
+  fData = nullptr;
+  fBuffer.clear();
+  memset(&fHeader, 0, sizeof(fHeader));
+}
+
+//--------------------------------------------------------------------------
+// Interpolate
+//--------------------------------------------------------------------------
+/**
+ * <p>Trilinear interpolation of the table.
+ *
+ * <p><b>return:</b> false if the point lies outside the table (value is not touched in this case), true otherwise
+ *
+ * \param x nu_L/sigma
+ * \param y nu/sigma
+ * \param tau sigma*t
+ * \param value interpolated polarization
+ */
+bool TLFDynTable::Interpolate(const double x, const double y, const double tau, double &value) const {
+  if (!fData)
+    return false;
+  return Interpolate(fHeader, fData, x, y, tau, value);
+}
+
+//--------------------------------------------------------------------------
+// Interpolate (static)
+//--------------------------------------------------------------------------
+/**
+ * <p>Trilinear interpolation on a given table.
+ *
+ * <p><b>return:</b> false if the point lies outside the table, true otherwise
+ *
+ * \param header table header
+ * \param data table values
+ * \param x nu_L/sigma
+ * \param y nu/sigma
+ * \param tau sigma*t
+ * \param value interpolated polarization
+ */
+bool TLFDynTable::Interpolate(const TLFDynTableHeader &header, const float *data, const double x, const double y, const double tau, double &value) {
+  if ((x < 0.0) || (x > header.fXmax) || (y < 0.0) || (y > header.fYmax) || (tau < 0.0) || (tau > header.fTmax))
+    return false;
+
+  const double fx(x/header.fXmax*static_cast<double>(header.fNx - 1));
+  const double fy(y/header.fYmax*static_cast<double>(header.fNy - 1));
+  const double ft(tau/header.fTmax*static_cast<double>(header.fNt - 1));
+
+  unsigned int i(static_cast<unsigned int>(fx)), j(static_cast<unsigned int>(fy)), k(static_cast<unsigned int>(ft));
+  if (i > header.fNx - 2)
+    i = header.fNx - 2;
+  if (j > header.fNy - 2)
+    j = header.fNy - 2;
+  if (k > header.fNt - 2)
+    k = header.fNt - 2;
+
+  const double wx(fx - static_cast<double>(i)), wy(fy - static_cast<double>(j)), wt(ft - static_cast<double>(k));
+  const size_t nt(header.fNt), nyt(static_cast<size_t>(header.fNy)*header.fNt);
+  const float *p00(data + i*nyt + j*nt + k); // (i, j)
+  const float *p01(p00 + nt);                // (i, j+1)
+  const float *p10(p00 + nyt);               // (i+1, j)
+  const float *p11(p10 + nt);                // (i+1, j+1)
+
+  const double v00((1.0-wt)*p00[0] + wt*p00[1]);
+  const double v01((1.0-wt)*p01[0] + wt*p01[1]);
+  const double v10((1.0-wt)*p10[0] + wt*p10[1]);
+  const double v11((1.0-wt)*p11[0] + wt*p11[1]);
+
+  value = (1.0-wx)*((1.0-wy)*v00 + wy*v01) + wx*((1.0-wy)*v10 + wy*v11);
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+// SetDefaultGrid (static)
+//--------------------------------------------------------------------------
+/**
+ * <p>Default grids: the tables cover the parameter ranges where the user functions do not use
+ * analytic approximations, i.e. omega_L < 10 sigma (resp. 30 a) and nu < 5 sigma (resp. 5 a).
+ *
+ * \param function tabulated function, see ELFDynTableFunction
+ * \param grid header to be filled
+ */
+void TLFDynTable::SetDefaultGrid(const unsigned int function, TLFDynTableHeader &grid) {
+  memset(&grid, 0, sizeof(grid));
+  grid.fFunction = function;
+  grid.fNx = 41;
+  grid.fNy = 51;
+  grid.fNt = 1001;
+  grid.fXmax = ((function == kLFDynExpKT) ? 30.0 : 10.0)/(2.0*M_PI);
+  grid.fYmax = 5.0;
+  grid.fTmax = 10.0;
+}
+
+//--------------------------------------------------------------------------
+// Generate (static)
+//--------------------------------------------------------------------------
+/**
+ * <p>Fill a table from the exact function, estimate the interpolation error at all cell centres and write it to a file.
+ *
+ * <p><b>return:</b> true if the table has been written, false otherwise
+ *
+ * \param fileName path of the table file
+ * \param grid header describing the grid; the error estimates are filled in
+ * \param exact function P(x, y, tau) with x = nu_L/sigma, y = nu/sigma and tau = sigma*t. It is evaluated with all tau
+ *              values for fixed (x, y) in a row, so that the Laplace transform has to be done only once per (x, y)
+ * \param verbose print progress information
+ */
+bool TLFDynTable::Generate(const std::string &fileName, TLFDynTableHeader &grid,
+                           const std::function<double(double, double, double)> &exact, const bool verbose) {
+  if ((grid.fNx < 2) || (grid.fNy < 2) || (grid.fNt < 2) || (grid.fXmax <= 0.0) || (grid.fYmax <= 0.0) || (grid.fTmax <= 0.0)) {
+    std::cerr << "TLFDynTable::Generate: invalid grid." << std::endl;
+    return false;
+  }
+
+  strncpy(grid.fMagic, LFDYNTABLE_MAGIC, sizeof(grid.fMagic));
+  grid.fVersion = LFDYNTABLE_VERSION;
+  grid.fReserved = 0;
+
+  const double dx(grid.fXmax/static_cast<double>(grid.fNx - 1));
+  const double dy(grid.fYmax/static_cast<double>(grid.fNy - 1));
+  const double dt(grid.fTmax/static_cast<double>(grid.fNt - 1));
+
+  std::vector<float> data(static_cast<size_t>(grid.fNx)*grid.fNy*grid.fNt);
+
+  // fill the table
+  size_t idx(0);
+  for (unsigned int i(0); i < grid.fNx; ++i) {
+    if (verbose)
+      std::cout << "TLFDynTable::Generate: nu_L/sigma = " << static_cast<double>(i)*dx << " (" << i+1 << "/" << grid.fNx << ")" << std::endl;
+    for (unsigned int j(0); j < grid.fNy; ++j) {
+      for (unsigned int k(0); k < grid.fNt; ++k) {
+        data[idx++] = static_cast<float>(exact(static_cast<double>(i)*dx, static_cast<double>(j)*dy, static_cast<double>(k)*dt));
+      }
+    }
+  }
+
+  // estimate the interpolation error at the cell centres
+  double x, y, tau, value, diff;
+  double maxError(0.0), sumError(0.0);
+  size_t noOfChecks(0);
+  for (unsigned int i(0); i < grid.fNx - 1; ++i) {
+    if (verbose)
+      std::cout << "TLFDynTable::Generate: check interpolation error (" << i+1 << "/" << grid.fNx - 1 << ")" << std::endl;
+    x = (static_cast<double>(i)+0.5)*dx;
+    for (unsigned int j(0); j < grid.fNy - 1; ++j) {
+      y = (static_cast<double>(j)+0.5)*dy;
+      for (unsigned int k(0); k < grid.fNt - 1; ++k) {
+        tau = (static_cast<double>(k)+0.5)*dt;
+        Interpolate(grid, &data[0], x, y, tau, value);
+        diff = fabs(value - exact(x, y, tau));
+        if (diff > maxError)
+          maxError = diff;
+        sumError += diff;
+        ++noOfChecks;
+      }
+    }
+  }
+  grid.fMaxError = maxError;
+  grid.fMeanError = sumError/static_cast<double>(noOfChecks);
+
+  // write the table - first to a temporary file, so that a table in use is never overwritten partially
+  const std::string tmpFileName(fileName + ".tmp");
+  std::ofstream fout(tmpFileName.c_str(), std::ios::binary | std::ios::trunc);
+  if (!fout.is_open()) {
+    std::cerr << "TLFDynTable::Generate: couldn't open " << tmpFileName << " for writing." << std::endl;
+    return false;
+  }
+  fout.write(reinterpret_cast<const char*>(&grid), sizeof(grid));
+  fout.write(reinterpret_cast<const char*>(&data[0]), data.size()*sizeof(float));
+  fout.close();
+  if (!fout.good() || std::rename(tmpFileName.c_str(), fileName.c_str())) {
+    std::cerr << "TLFDynTable::Generate: couldn't write " << fileName << "." << std::endl;
+    std::remove(tmpFileName.c_str());
+    return false;
+  }
+
+  if (verbose) {
+    std::cout << "TLFDynTable::Generate: " << fileName << " written, interpolation error: max = " << grid.fMaxError
+              << ", mean = " << grid.fMeanError << std::endl;
+  }
+
+  return true;
+}
@@ -0,0 +1,104 @@
+/***************************************************************************
+
+  TLFDynTable.h
+
+  Author: Bastian M. Wojek
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2009 by Bastian M. Wojek                                *
+ *                                                                         *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef _TLFDynTable_H_
+#define _TLFDynTable_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * <p>Functions which can be tabulated
+ */
+enum ELFDynTableFunction {
+  kLFDynGssKT = 0, ///< dynamic Gaussian Kubo-Toyabe function in a longitudinal field
+  kLFDynExpKT = 1  ///< dynamic exponential Kubo-Toyabe function in a longitudinal field
+};
+
+/**
+ * <p>Header of a LF-relaxation table file. It is followed by fNx*fNy*fNt float values P(x_i, y_j, tau_k),
+ * where the index k runs fastest. All grids start at zero and are equidistant:
+ * - x = nu_L/sigma (resp. nu_L/a)
+ * - y = nu/sigma (resp. nu/a)
+ * - tau = sigma*t (resp. a*t)
+ */
+struct TLFDynTableHeader {
+  char fMagic[8];       ///< "LFDYNTB"
+  uint32_t fVersion;    ///< version of the file format
+  uint32_t fFunction;   ///< tabulated function, see ELFDynTableFunction
+  uint32_t fNx;         ///< number of points in nu_L/sigma
+  uint32_t fNy;         ///< number of points in nu/sigma
+  uint32_t fNt;         ///< number of points in sigma*t
+  uint32_t fReserved;   ///< padding
+  double fXmax;         ///< upper end of the nu_L/sigma grid
+  double fYmax;         ///< upper end of the nu/sigma grid
+  double fTmax;         ///< upper end of the sigma*t grid
+  double fDt;           ///< time resolution of the Laplace transforms used to fill the table (us, at sigma = 1/us)
+  double fMaxError;     ///< largest absolute interpolation error found at the cell centres
+  double fMeanError;    ///< mean absolute interpolation error at the cell centres
+};
+
+//-----------------------------------------------------------------------------------------------------------------
+/**
+ * <p>Precomputed, memory-mapped table of a dynamic LF-relaxation function in dimensionless units.
+ * The user functions interpolate (trilinear) from the table if the parameters are within its range
+ * and fall back to the exact numerical Laplace transform otherwise.
+ * Tables are written by the program lf_table_generator.
+ */
+class TLFDynTable {
+
+public:
+  TLFDynTable();
+  ~TLFDynTable();
+
+  bool Open(const std::string &fileName, const unsigned int function);
+  void Close();
+  bool IsOpen() const { return (fData != nullptr); } ///< true if a valid table is available
+  const TLFDynTableHeader& GetHeader() const { return fHeader; } ///< returns the table header
+  double GetMaxError() const { return fHeader.fMaxError; } ///< returns the largest interpolation error found when generating the table
+
+  bool Interpolate(const double x, const double y, const double tau, double &value) const;
+
+  static void SetDefaultGrid(const unsigned int function, TLFDynTableHeader &grid);
+  static bool Generate(const std::string &fileName, TLFDynTableHeader &grid,
+                       const std::function<double(double, double, double)> &exact, const bool verbose=true);
+
+private:
+  TLFDynTableHeader fHeader;        ///< header of the opened table
+  const float *fData;               ///< table values (memory-mapped or from fBuffer)
+  void *fMap;                       ///< start of the memory-mapped file
+  size_t fMapSize;                  ///< size of the memory-mapped file
+  std::vector<float> fBuffer;       ///< table values if the file cannot be memory-mapped
+
+  static bool Interpolate(const TLFDynTableHeader &header, const float *data, const double x, const double y, const double tau, double &value);
+};
+
+#endif //_TLFDynTable_H_
@@ -42,6 +42,9 @@
 #include <TSAXParser.h>
 #include "BMWIntegrator.h"
 #include "BMWStartupHandler.h"
+#include "PFFTPlanManager.h"
+#include "PPerfMonitor.h"
+#include "TLFDynTable.h"
 #include "TLFRelaxation.h"
 
 #define PI 3.14159265358979323846
@@ -177,19 +180,15 @@ double TLFStatExpKT::operator()(double t, const std::vector<double> &par) const
  * <p>Constructor
  * - read XML startup file
  * - initialize variables
- * - read FFTW3 wisdom if desired
+ * - read FFTW3 wisdom if desired (via the PFFTPlanManager)
  * - allocate memory for the Laplace transform
  * - create FFTW3 plans for the Laplace transform
+ * - open the precomputed table of the function if one is given in the startup file
  */
-TLFDynGssKT::TLFDynGssKT() : fCalcNeeded(true), fFirstCall(true), fCounter(0) {
+TLFDynGssKT::TLFDynGssKT() : fCalcNeeded(true), fFirstCall(true), fUseTable(false), fCounter(0), fTable(nullptr) {
 
-#if !defined(_WIN32GCC) && defined(HAVE_LIBFFTW3F_THREADS) && defined(HAVE_GOMP)
-  int init_threads(fftwf_init_threads());
-  if (!init_threads)
-    std::cout << "TLFDynGssKT::TLFDynGssKT: Couldn't initialize multiple FFTW-threads ..." << std::endl;
-  else
-    fftwf_plan_with_nthreads(omp_get_num_procs());
-#endif
+  fPerfTable = PPerfMonitor::GetInstance()->GetCacheCounter("TLFDynTable");
+  fPerfLaplace = PPerfMonitor::GetInstance()->GetCacheCounter("TLFDynGssKT/laplace");
 
   // read startup file
   std::string startup_path_name("BMW_startup.xml");
@@ -217,33 +216,37 @@ TLFDynGssKT::TLFDynGssKT() : fCalcNeeded(true), fFirstCall(true), fCounter(0) {
   fDw = PI/(fNSteps*fDt);
   fC = 2.0*TMath::Log(double(fNSteps))/(double(fNSteps-1)*fDt);
 
-  fUseWisdom = true;
-  int wisdomLoaded(0);
-
-  FILE *wordsOfWisdomR;
-  wordsOfWisdomR = fopen(fWisdom.c_str(), "r");
-  if (wordsOfWisdomR == NULL) {
-    fUseWisdom = false;
-  } else {
-    wisdomLoaded = fftwf_import_wisdom_from_file(wordsOfWisdomR);
-    fclose(wordsOfWisdomR);
-  }
-
-  if (!wisdomLoaded) {
-    fUseWisdom = false;
-  }
+  PFFTPlanManager *planManager(PFFTPlanManager::GetInstance());
+  fUseWisdom = planManager->ImportWisdom(fWisdom, true);
 
-  // allocating memory for the FFtransform pairs and create the FFT plans
+  // allocating memory for the FFtransform pairs and get the (shared) FFT plans
 
-  fFFTtime = (float *)malloc(sizeof(float) * fNSteps);
+  fFFTtime = (float *)fftwf_malloc(sizeof(float) * fNSteps);
   fFFTfreq = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex) * (fNSteps/2+1));
 
+  const int nSteps(static_cast<int>(fNSteps));
   if (fUseWisdom) {
-    fFFTplanFORW = fftwf_plan_dft_r2c_1d(fNSteps, fFFTtime, fFFTfreq, FFTW_EXHAUSTIVE);
-    fFFTplanBACK = fftwf_plan_dft_c2r_1d(fNSteps, fFFTfreq, fFFTtime, FFTW_EXHAUSTIVE);
+    fFFTplanFORW = planManager->GetPlanDftR2C(1, &nSteps, fFFTtime, fFFTfreq, FFTW_EXHAUSTIVE);
+    fFFTplanBACK = planManager->GetPlanDftC2R(1, &nSteps, fFFTfreq, fFFTtime, FFTW_EXHAUSTIVE);
   } else {
-    fFFTplanFORW = fftwf_plan_dft_r2c_1d(fNSteps, fFFTtime, fFFTfreq, FFTW_ESTIMATE);
-    fFFTplanBACK = fftwf_plan_dft_c2r_1d(fNSteps, fFFTfreq, fFFTtime, FFTW_ESTIMATE);
+    fFFTplanFORW = planManager->GetPlanDftR2C(1, &nSteps, fFFTtime, fFFTfreq, FFTW_ESTIMATE);
+    fFFTplanBACK = planManager->GetPlanDftC2R(1, &nSteps, fFFTfreq, fFFTtime, FFTW_ESTIMATE);
+  }
+
+  // precomputed table of the function (if any)
+  fTable = new TLFDynTable();
+  if (fTable->Open(startupHandler->GetLFTableGssKT(), kLFDynGssKT)) {
+    static bool reported(false);
+    if (!reported) {
+      const TLFDynTableHeader &header(fTable->GetHeader());
+      std::cout << "TLFDynGssKT::TLFDynGssKT: using table " << startupHandler->GetLFTableGssKT() << " for nu_L/sigma <= " << header.fXmax
+                << ", nu/sigma <= " << header.fYmax << ", sigma*t <= " << header.fTmax
+                << " (max. interpolation error " << header.fMaxError << ", mean " << header.fMeanError << ")" << std::endl;
+      reported = true;
+    }
+  } else {
+    delete fTable;
+    fTable = nullptr;
   }
 }
 
@@ -252,31 +255,27 @@ TLFDynGssKT::TLFDynGssKT() : fCalcNeeded(true), fFirstCall(true), fCounter(0) {
 //--------------------------------------------------------------------------
 /**
  * <p>Destructor
- * - write FFTW3 wisdom if desired
  * - free memory used for the Laplace transform
  */
 TLFDynGssKT::~TLFDynGssKT() {
-  // export FFTW Wisdom so it has not to be checked for the FFT-plan next time
-  if (fUseWisdom) {
-    FILE *wordsOfWisdomW;
-    wordsOfWisdomW = fopen(fWisdom.c_str(), "w");
-    if (wordsOfWisdomW == NULL) {
-      std::cout << "TLFDynGssKT::~TLFDynGssKT(): Could not open file ... No wisdom is exported..." << std::endl;
-    } else {
-      fftwf_export_wisdom_to_file(wordsOfWisdomW);
-      fclose(wordsOfWisdomW);
-    }
-  }
-  // END of Wisdom Export
-
-  // clean up
-  fftwf_destroy_plan(fFFTplanFORW);
-  fftwf_destroy_plan(fFFTplanBACK);
-  free(fFFTtime);
+  // clean up - the FFT plans are owned by the PFFTPlanManager which also exports the wisdom
+  DisableTable();
+  fftwf_free(fFFTtime);
   fftwf_free(fFFTfreq);
   std::cout << "TLFDynGssKT::~TLFDynGssKT(): " << fCounter << " full FFT cycles needed..." << std::endl;
 }
 
+//--------------------------------------------------------------------------
+// DisableTable
+//--------------------------------------------------------------------------
+/**
+ * <p>Release the precomputed table, i.e. always use the Laplace transform (used to generate the tables).
+ */
+void TLFDynGssKT::DisableTable() {
+  delete fTable;
+  fTable = nullptr;
+}
+
 //--------------------------------------------------------------------------
 // operator()
 //--------------------------------------------------------------------------
@@ -296,17 +295,7 @@ double TLFDynGssKT::operator()(double t, const std::vector<double> &par) const {
   if(t>20.0)
     return 0.0;
 
-  if(fFirstCall){
-    fPar = par;
-    fFirstCall=false;
-  }
-
-  for (unsigned int i(0); i<3; ++i) {
-    if( fPar[i]-par[i] ) {
-      fPar[i] = par[i];
-      fCalcNeeded=true;
-    }
-  }
+  CheckParameters(par);
 
   double sigsq(par[1]*par[1]); // sigma^2
   double omegaL(TWOPI*par[0]); // Larmor frequency
@@ -330,97 +319,189 @@ double TLFDynGssKT::operator()(double t, const std::vector<double> &par) const {
     return exp(-2.0*sigsq/(omegaLnusqp*omegaLnusqp)*(omegaLnusqp*nut+omegaLnusqm*(1.0-enut*cos(wt))-2.0*par[2]*omegaL*enut*sin(wt))); // Keren
   }
 
-  if(fCalcNeeded) {
+  // interpolate from the precomputed table if the dimensionless parameters are covered by it. For a
+  // parameter set handed to Prepare, either the table or the Laplace transform is used for all times.
+  double value;
+  if (fTable && (par[1] > 0.0) && (fUseTable || (par != fTablePar)) &&
+      fTable->Interpolate(fabs(par[0])/par[1], par[2]/par[1], par[1]*t, value)) {
+    fPerfTable->Hit();
+    return value;
+  }
+  if (fTable)
+    fPerfTable->Miss();
+
+  if (fCalcNeeded)
+    fPerfLaplace->Miss();
+  else
+    fPerfLaplace->Hit();
 
-/*    double t1,t2;
-    // get start time
-    struct timeval tv_start, tv_stop;
-    gettimeofday(&tv_start, 0);
-*/
-    double tt(0.), sigsqtsq(0.);
-    int i;
-    #ifdef HAVE_GOMP
-    int chunk = fNSteps/omp_get_num_procs();
-    if (chunk < 10)
-      chunk = 10;
-    #endif
+  if(fCalcNeeded)
+    CalcLaplaceTransform(par);
 
-    if(fabs(par[0])<0.00135538817) {
-      double mcplusnu(-(fC+par[2]));
-      #ifdef HAVE_GOMP
-      #pragma omp parallel for default(shared) private(i,tt) schedule(dynamic, chunk)
-      #endif
-      for(i = 0; i < static_cast<int>(fNSteps); ++i) {
-        tt=static_cast<double>(i)*fDt;
-        sigsqtsq=sigsq*tt*tt;
-        fFFTtime[i]=(0.33333333333333333333+0.66666666666666666667*(1.0-sigsqtsq)*exp(-0.5*sigsqtsq))*exp(mcplusnu*tt)*fDt;
-      }
-    } else {
-      double mcplusnu(-(fC+par[2]));
-      double coeff1(2.0*sigsq/omegaLsq);
-      double coeff2(coeff1*sigsq/omegaL);
-
-      fFFTtime[0] = fDt;
-
-      #ifdef HAVE_GOMP
-      #pragma omp parallel for default(shared) private(i,tt) schedule(dynamic, chunk)
-      #endif
-      for(i = 1; i < static_cast<int>(fNSteps); ++i) {
-        tt=(static_cast<double>(i)-0.5)*fDt;
-        fFFTtime[i]=(sin(omegaL*tt) * exp(-0.5*sigsq*tt*tt))*fDt;
-      }
-
-      double totoIntegrale(0.);
-
-      for(i = 1; i < static_cast<int>(fNSteps); ++i) {
-        tt=static_cast<double>(i)*fDt;
-        totoIntegrale+=fFFTtime[i];
-        fFFTtime[i]=(1.0-(coeff1*(1.0-exp(-0.5*sigsq*tt*tt)*cos(omegaL*tt)))+(coeff2*totoIntegrale))*exp(mcplusnu*tt)*fDt;
-      }
+//  return fFFTtime[int(t/fDt)];
+  return fDw*exp(fC*t)/PI*fFFTtime[static_cast<int>(t/fDt)];
+}
+
+//--------------------------------------------------------------------------
+// Prepare
+//--------------------------------------------------------------------------
+/**
+ * <p>Called serially with all times of the fit range before the (parallel) evaluation. Decides once for the
+ * parameter set if the precomputed table (if it covers all times) or the Laplace transform is used, such
+ * that the function has no jump at the table edge, and performs the Laplace transform if needed. Hence
+ * the parallel evaluation neither changes fPar nor the transform arrays.
+ *
+ * \param t times \htmlonly (&#956;s) \endhtmlonly \latexonly ($\mu\mathrm{s}$) \endlatexonly
+ * \param par parameters, see operator()
+ */
+void TLFDynGssKT::Prepare(const std::vector<double> &t, const std::vector<double> &par) const {
+
+  assert(par.size() == 3);
+
+  CheckParameters(par);
+
+  // analytic cases of operator(), i.e. neither table nor Laplace transform needed
+  double omegaL(TWOPI*par[0]);
+  if (((fabs(par[0])<0.00135538817) && !par[2]) || (par[2] >= 5.0*par[1]) || (omegaL >= 10.0*par[1]))
+    return;
+
+  double tMax(0.0);
+  for (unsigned int i(0); i<t.size(); ++i) {
+    if ((t[i] > tMax) && (t[i] <= 20.0))
+      tMax = t[i];
+  }
+
+  double value;
+  fTablePar = par;
+  fUseTable = (fTable && (par[1] > 0.0) && fTable->Interpolate(fabs(par[0])/par[1], par[2]/par[1], par[1]*tMax, value));
+
+  if (!fUseTable && fCalcNeeded)
+    CalcLaplaceTransform(par);
+}
+
+//--------------------------------------------------------------------------
+// CheckParameters (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Keeps the parameters and flags the Laplace transform as needed if they have changed.
+ *
+ * \param par parameters, see operator()
+ */
+void TLFDynGssKT::CheckParameters(const std::vector<double> &par) const {
+  if(fFirstCall){
+    fPar = par;
+    fFirstCall=false;
+  }
+
+  for (unsigned int i(0); i<3; ++i) {
+    if( fPar[i]-par[i] ) {
+      fPar[i] = par[i];
+      fCalcNeeded=true;
     }
-/*
-    gettimeofday(&tv_stop, 0);
-    t1 = (tv_stop.tv_sec - tv_start.tv_sec)*1000.0 + (tv_stop.tv_usec - tv_start.tv_usec)/1000.0;
-*/
-    // Transform to frequency domain
+  }
+}
+
+//--------------------------------------------------------------------------
+// CalcLaplaceTransform (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculates the polarization on the time grid of the Laplace transform.
+ *
+ * \param par parameters, see operator()
+ */
+void TLFDynGssKT::CalcLaplaceTransform(const std::vector<double> &par) const {
 
-    fftwf_execute(fFFTplanFORW);
+  double sigsq(par[1]*par[1]); // sigma^2
+  double omegaL(TWOPI*par[0]); // Larmor frequency
+  double nusq(par[2]*par[2]); // nu^2
+  double omegaLsq(omegaL*omegaL); // omega^2
 
-    // calculate F(s)
+/*  double t1,t2;
+  // get start time
+  struct timeval tv_start, tv_stop;
+  gettimeofday(&tv_start, 0);
+*/
+  double tt(0.), sigsqtsq(0.);
+  int i;
+  #ifdef HAVE_GOMP
+  int chunk = fNSteps/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #endif
+
+  if(fabs(par[0])<0.00135538817) {
+    double mcplusnu(-(fC+par[2]));
+    #ifdef HAVE_GOMP
+    #pragma omp parallel for default(shared) private(i,tt) schedule(dynamic, chunk)
+    #endif
+    for(i = 0; i < static_cast<int>(fNSteps); ++i) {
+      tt=static_cast<double>(i)*fDt;
+      sigsqtsq=sigsq*tt*tt;
+      fFFTtime[i]=(0.33333333333333333333+0.66666666666666666667*(1.0-sigsqtsq)*exp(-0.5*sigsqtsq))*exp(mcplusnu*tt)*fDt;
+    }
+  } else {
+    double mcplusnu(-(fC+par[2]));
+    double coeff1(2.0*sigsq/omegaLsq);
+    double coeff2(coeff1*sigsq/omegaL);
 
-    double denom(1.0), imagsq(0.0), oneMINrealnu(1.0);
+    fFFTtime[0] = fDt;
 
     #ifdef HAVE_GOMP
-    chunk = (fNSteps/2+1)/omp_get_num_procs();
-    if (chunk < 10)
-      chunk = 10;
-    #pragma omp parallel for default(shared) private(i, imagsq, oneMINrealnu, denom) schedule(dynamic, chunk)
+    #pragma omp parallel for default(shared) private(i,tt) schedule(dynamic, chunk)
     #endif
-    for (i = 0; i < static_cast<int>(fNSteps)/2+1; ++i) {
-      imagsq=fFFTfreq[i][1]*fFFTfreq[i][1];
-      oneMINrealnu=1.0-(par[2]*fFFTfreq[i][0]);
-      denom=oneMINrealnu*oneMINrealnu + (nusq*imagsq);
-      fFFTfreq[i][0] = (oneMINrealnu*fFFTfreq[i][0]-(par[2]*imagsq))/denom;
-      fFFTfreq[i][1] /= denom;
+    for(i = 1; i < static_cast<int>(fNSteps); ++i) {
+      tt=(static_cast<double>(i)-0.5)*fDt;
+      fFFTtime[i]=(sin(omegaL*tt) * exp(-0.5*sigsq*tt*tt))*fDt;
     }
 
-    // Transform back to time domain
+    double totoIntegrale(0.);
 
-    fftwf_execute(fFFTplanBACK);
+    for(i = 1; i < static_cast<int>(fNSteps); ++i) {
+      tt=static_cast<double>(i)*fDt;
+      totoIntegrale+=fFFTtime[i];
+      fFFTtime[i]=(1.0-(coeff1*(1.0-exp(-0.5*sigsq*tt*tt)*cos(omegaL*tt)))+(coeff2*totoIntegrale))*exp(mcplusnu*tt)*fDt;
+    }
+  }
+/*
+  gettimeofday(&tv_stop, 0);
+  t1 = (tv_stop.tv_sec - tv_start.tv_sec)*1000.0 + (tv_stop.tv_usec - tv_start.tv_usec)/1000.0;
+*/
+  // Transform to frequency domain
+
+  fftwf_execute_dft_r2c(fFFTplanFORW, fFFTtime, fFFTfreq);
+
+  // calculate F(s)
+
+  double denom(1.0), imagsq(0.0), oneMINrealnu(1.0);
+
+  #ifdef HAVE_GOMP
+  chunk = (fNSteps/2+1)/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(i, imagsq, oneMINrealnu, denom) schedule(dynamic, chunk)
+  #endif
+  for (i = 0; i < static_cast<int>(fNSteps)/2+1; ++i) {
+    imagsq=fFFTfreq[i][1]*fFFTfreq[i][1];
+    oneMINrealnu=1.0-(par[2]*fFFTfreq[i][0]);
+    denom=oneMINrealnu*oneMINrealnu + (nusq*imagsq);
+    fFFTfreq[i][0] = (oneMINrealnu*fFFTfreq[i][0]-(par[2]*imagsq))/denom;
+    fFFTfreq[i][1] /= denom;
+  }
+
+  // Transform back to time domain
+
+  fftwf_execute_dft_c2r(fFFTplanBACK, fFFTfreq, fFFTtime);
 
 //    for (unsigned int i(0); i<fNSteps; i++) {
 //      fFFTtime[i]=(fDw*TMath::Exp(fC*i*fDt)/TMath::Pi()*fFFTtime[i]);
 //    }
-    fCalcNeeded=false;
-    ++fCounter;
+  fCalcNeeded=false;
+  ++fCounter;
 /*
-    gettimeofday(&tv_stop, 0);
-    t2 = (tv_stop.tv_sec - tv_start.tv_sec)*1000.0 + (tv_stop.tv_usec - tv_start.tv_usec)/1000.0;
-    cout << "# Calculation times: " << t1 << " (ms), " << t2 << " (ms)" << endl;
+  gettimeofday(&tv_stop, 0);
+  t2 = (tv_stop.tv_sec - tv_start.tv_sec)*1000.0 + (tv_stop.tv_usec - tv_start.tv_usec)/1000.0;
+  cout << "# Calculation times: " << t1 << " (ms), " << t2 << " (ms)" << endl;
 */
-  }
-//  return fFFTtime[int(t/fDt)];
-  return fDw*exp(fC*t)/PI*fFFTtime[static_cast<int>(t/fDt)];
 }
 
 //--------------------------------------------------------------------------
@@ -502,19 +583,15 @@ double TLFDynSG::operator()(double t, const std::vector<double> &par) const {
  * <p>Constructor
  * - read XML startup file
  * - initialize variables
- * - read FFTW3 wisdom if desired
+ * - read FFTW3 wisdom if desired (via the PFFTPlanManager)
  * - allocate memory for the Laplace transform
  * - create FFTW3 plans for the Laplace transform
+ * - open the precomputed table of the function if one is given in the startup file
  */
-TLFDynExpKT::TLFDynExpKT() : fCalcNeeded(true), fFirstCall(true), fCounter(0), fL1(0.0), fL2(0.0) {
+TLFDynExpKT::TLFDynExpKT() : fCalcNeeded(true), fFirstCall(true), fUseTable(false), fCounter(0), fL1(0.0), fL2(0.0), fTable(nullptr) {
 
-#if !defined(_WIN32GCC) && defined(HAVE_LIBFFTW3F_THREADS) && defined(HAVE_GOMP)
-  int init_threads(fftwf_init_threads());
-  if (!init_threads)
-    std::cout << "TLFDynExpKT::TLFDynExpKT: Couldn't initialize multiple FFTW-threads ..." << std::endl;
-  else
-    fftwf_plan_with_nthreads(omp_get_num_procs());
-#endif
+  fPerfTable = PPerfMonitor::GetInstance()->GetCacheCounter("TLFDynTable");
+  fPerfLaplace = PPerfMonitor::GetInstance()->GetCacheCounter("TLFDynExpKT/laplace");
 
   // read startup file
   std::string startup_path_name("BMW_startup.xml");
@@ -542,33 +619,37 @@ TLFDynExpKT::TLFDynExpKT() : fCalcNeeded(true), fFirstCall(true), fCounter(0), f
   fDw = PI/(fNSteps*fDt);
   fC = 2.0*TMath::Log(double(fNSteps))/(double(fNSteps-1)*fDt);
 
-  fUseWisdom = true;
-  int wisdomLoaded(0);
-
-  FILE *wordsOfWisdomR;
-  wordsOfWisdomR = fopen(fWisdom.c_str(), "r");
-  if (wordsOfWisdomR == NULL) {
-    fUseWisdom = false;
-  } else {
-    wisdomLoaded = fftwf_import_wisdom_from_file(wordsOfWisdomR);
-    fclose(wordsOfWisdomR);
-  }
-
-  if (!wisdomLoaded) {
-    fUseWisdom = false;
-  }
+  PFFTPlanManager *planManager(PFFTPlanManager::GetInstance());
+  fUseWisdom = planManager->ImportWisdom(fWisdom, true);
 
-  // allocating memory for the FFtransform pairs and create the FFT plans
+  // allocating memory for the FFtransform pairs and get the (shared) FFT plans
 
-  fFFTtime = (float *)malloc(sizeof(float) * fNSteps);
+  fFFTtime = (float *)fftwf_malloc(sizeof(float) * fNSteps);
   fFFTfreq = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex) * (fNSteps/2+1));
 
+  const int nSteps(static_cast<int>(fNSteps));
   if (fUseWisdom) {
-    fFFTplanFORW = fftwf_plan_dft_r2c_1d(fNSteps, fFFTtime, fFFTfreq, FFTW_EXHAUSTIVE);
-    fFFTplanBACK = fftwf_plan_dft_c2r_1d(fNSteps, fFFTfreq, fFFTtime, FFTW_EXHAUSTIVE);
+    fFFTplanFORW = planManager->GetPlanDftR2C(1, &nSteps, fFFTtime, fFFTfreq, FFTW_EXHAUSTIVE);
+    fFFTplanBACK = planManager->GetPlanDftC2R(1, &nSteps, fFFTfreq, fFFTtime, FFTW_EXHAUSTIVE);
   } else {
-    fFFTplanFORW = fftwf_plan_dft_r2c_1d(fNSteps, fFFTtime, fFFTfreq, FFTW_ESTIMATE);
-    fFFTplanBACK = fftwf_plan_dft_c2r_1d(fNSteps, fFFTfreq, fFFTtime, FFTW_ESTIMATE);
+    fFFTplanFORW = planManager->GetPlanDftR2C(1, &nSteps, fFFTtime, fFFTfreq, FFTW_ESTIMATE);
+    fFFTplanBACK = planManager->GetPlanDftC2R(1, &nSteps, fFFTfreq, fFFTtime, FFTW_ESTIMATE);
+  }
+
+  // precomputed table of the function (if any)
+  fTable = new TLFDynTable();
+  if (fTable->Open(startupHandler->GetLFTableExpKT(), kLFDynExpKT)) {
+    static bool reported(false);
+    if (!reported) {
+      const TLFDynTableHeader &header(fTable->GetHeader());
+      std::cout << "TLFDynExpKT::TLFDynExpKT: using table " << startupHandler->GetLFTableExpKT() << " for nu_L/a <= " << header.fXmax
+                << ", nu/a <= " << header.fYmax << ", a*t <= " << header.fTmax
+                << " (max. interpolation error " << header.fMaxError << ", mean " << header.fMeanError << ")" << std::endl;
+      reported = true;
+    }
+  } else {
+    delete fTable;
+    fTable = nullptr;
   }
 }
 
@@ -577,31 +658,27 @@ TLFDynExpKT::TLFDynExpKT() : fCalcNeeded(true), fFirstCall(true), fCounter(0), f
 //--------------------------------------------------------------------------
 /**
  * <p>Destructor
- * - write FFTW3 wisdom if desired
  * - free memory used for the Laplace transform
  */
 TLFDynExpKT::~TLFDynExpKT() {
-  // export FFTW Wisdom so it has not to be checked for the FFT-plan next time
-  if (fUseWisdom) {
-    FILE *wordsOfWisdomW;
-    wordsOfWisdomW = fopen(fWisdom.c_str(), "w");
-    if (wordsOfWisdomW == NULL) {
-      std::cout << "TLFDynExpKT::~TLFDynExpKT(): Could not open file ... No wisdom is exported..." << std::endl;
-    } else {
-      fftwf_export_wisdom_to_file(wordsOfWisdomW);
-      fclose(wordsOfWisdomW);
-    }
-  }
-  // END of Wisdom Export
-
-  // clean up
-  fftwf_destroy_plan(fFFTplanFORW);
-  fftwf_destroy_plan(fFFTplanBACK);
-  free(fFFTtime);
+  // clean up - the FFT plans are owned by the PFFTPlanManager which also exports the wisdom
+  DisableTable();
+  fftwf_free(fFFTtime);
   fftwf_free(fFFTfreq);
   std::cout << "TLFDynExpKT::~TLFDynExpKT(): " << fCounter << " full FFT cyles needed..." << std::endl;
 }
 
+//--------------------------------------------------------------------------
+// DisableTable
+//--------------------------------------------------------------------------
+/**
+ * <p>Release the precomputed table, i.e. always use the Laplace transform (used to generate the tables).
+ */
+void TLFDynExpKT::DisableTable() {
+  delete fTable;
+  fTable = nullptr;
+}
+
 //--------------------------------------------------------------------------
 // operator()
 //--------------------------------------------------------------------------
@@ -621,17 +698,7 @@ double TLFDynExpKT::operator()(double t, const std::vector<double> &par) const {
   if(t>20.0)
     return 0.0;
 
-  if(fFirstCall){
-    fPar = par;
-    fFirstCall=false;
-  }
-
-  for (unsigned int i(0); i<par.size(); i++) {
-    if( fPar[i]-par[i] ) {
-      fPar[i] = par[i];
-      fCalcNeeded=true;
-    }
-  }
+  CheckParameters(par);
 
   double omegaL(TWOPI*par[0]); // Larmor frequency
   double a(par[1]);  // static width
@@ -648,25 +715,8 @@ double TLFDynExpKT::operator()(double t, const std::vector<double> &par) const {
 
   // check if hopping > 5 * damping, of Larmor angular frequency is > 30 * damping (BMW limit)
   if((par[2] > 5.0*par[1]) || (omegaL > 30.0*par[1])){
-    if(fCalcNeeded){
-
-      // 'c' and 'd' are parameters BMW obtained by fitting large parameter space LF-curves to the model below
-      const double c[7] = {1.15331, 1.64826, -0.71763, 3.0, 0.386683, -5.01876, 2.41854};
-      const double d[4] = {2.44056, 2.92063, 1.69581, 0.667277};
-      double w0N[4];
-      double nuN[4];
-      w0N[0] = omegaL;
-      nuN[0] = nu;
-      for (unsigned int i=1; i<4; ++i) {
-        w0N[i] = omegaL * w0N[i-1];
-        nuN[i] = nu * nuN[i-1];
-      }
-      double denom(w0N[3]+d[0]*w0N[2]*nuN[0]+d[1]*w0N[1]*nuN[1]+d[2]*w0N[0]*nuN[2]+d[3]*nuN[3]);
-      fL1 = (c[0]*w0N[2]+c[1]*w0N[1]*nuN[0]+c[2]*w0N[0]*nuN[1])/denom;
-      fL2 = (c[3]*w0N[2]+c[4]*w0N[1]*nuN[0]+c[5]*w0N[0]*nuN[1]+c[6]*nuN[2])/denom;
-
-      fCalcNeeded=false;
-    }
+    if(fCalcNeeded)
+      CalcApproximation(par);
 
     double w0t(omegaL*t);
     double j1, j0;
@@ -683,88 +733,215 @@ double TLFDynExpKT::operator()(double t, const std::vector<double> &par) const {
     return TMath::Exp(Gamma_t);
   }
 
-  // if no approximation can be used -> Laplace transform
+  // interpolate from the precomputed table if the dimensionless parameters are covered by it. For a
+  // parameter set handed to Prepare, either the table or the Laplace transform is used for all times.
+  double value;
+  if (fTable && (a > 0.0) && (fUseTable || (par != fTablePar)) && fTable->Interpolate(fabs(par[0])/a, nu/a, a*t, value)) {
+    fPerfTable->Hit();
+    return value;
+  }
+  if (fTable)
+    fPerfTable->Miss();
 
-  if(fCalcNeeded){
+  // if no approximation can be used and no table is available -> Laplace transform
 
-    double tt(0.);
-    int i;
-    #ifdef HAVE_GOMP
-    int chunk = fNSteps/omp_get_num_procs();
-    if (chunk < 10)
-      chunk = 10;
-    #endif
+  if (fCalcNeeded)
+    fPerfLaplace->Miss();
+  else
+    fPerfLaplace->Hit();
 
-    if(TMath::Abs(par[0])<0.00135538817){
-      #ifdef HAVE_GOMP
-      #pragma omp parallel for default(shared) private(i, tt) schedule(dynamic, chunk)
-      #endif
-      for(i = 0; i < static_cast<int>(fNSteps); ++i) {
-        tt=static_cast<double>(i)*fDt;
-        fFFTtime[i]=(0.33333333333333333333+0.66666666666666666667*(1.0-par[1]*tt)*TMath::Exp(-par[1]*tt))*TMath::Exp(-(fC+par[2])*tt)*fDt;
-      }
-    } else {
+  if(fCalcNeeded)
+    CalcLaplaceTransform(par);
+
+//  return fFFTtime[int(t/fDt)];
+  return fDw*TMath::Exp(fC*t)/TMath::Pi()*fFFTtime[static_cast<int>(t/fDt)];
+}
 
-      double coeff1(par[1]/omegaL);
-      double coeff2(coeff1*coeff1);
-      double coeff3((1.0+coeff2)*par[1]);
-
-      fFFTtime[0] = 1.0*fDt;
-
-      #ifdef HAVE_GOMP
-      #pragma omp parallel for default(shared) private(i, tt) schedule(dynamic, chunk)
-      #endif
-      for(i = 1; i < static_cast<int>(fNSteps); ++i) {
-        tt=(double(i)-0.5)*fDt;
-        fFFTtime[i]=TMath::Sin(omegaL*tt)/(omegaL*tt)*TMath::Exp(-par[1]*tt)*fDt;
-      }
-
-      double totoIntegrale(0.);
-      double w0t(1.0);
-
-      for(i = 1; i < static_cast<int>(fNSteps); ++i) {
-        tt=double(i)*fDt;
-        totoIntegrale+=fFFTtime[i];
-        w0t = omegaL*tt;
-        fFFTtime[i]=(1.0-(coeff1*TMath::Exp(-par[1]*tt)*(TMath::Sin(w0t)-w0t*TMath::Cos(w0t))/(w0t*w0t))-(coeff2*(TMath::Sin(w0t)/(w0t)*TMath::Exp(-par[1]*tt)-1.0))-coeff3*totoIntegrale)*TMath::Exp(-(fC+par[2])*tt)*fDt;
-      }
+//--------------------------------------------------------------------------
+// Prepare
+//--------------------------------------------------------------------------
+/**
+ * <p>Called serially with all times of the fit range before the (parallel) evaluation. Calculates the
+ * coefficients of the semi-analytical approximation, or decides once for the parameter set if the
+ * precomputed table (if it covers all times) or the Laplace transform is used, such that the function
+ * has no jump at the table edge, and performs the Laplace transform if needed. Hence the parallel
+ * evaluation neither changes fPar nor the cached coefficients or transform arrays.
+ *
+ * \param t times \htmlonly (&#956;s) \endhtmlonly \latexonly ($\mu\mathrm{s}$) \endlatexonly
+ * \param par parameters, see operator()
+ */
+void TLFDynExpKT::Prepare(const std::vector<double> &t, const std::vector<double> &par) const {
+
+  assert(par.size() == 3);
+
+  CheckParameters(par);
+
+  // analytic cases of operator()
+  double omegaL(TWOPI*par[0]);
+  if ((fabs(par[0])<0.00135538817) && !par[2])
+    return;
+  if ((par[2] > 5.0*par[1]) || (omegaL > 30.0*par[1])) {
+    if (fCalcNeeded)
+      CalcApproximation(par);
+    return;
+  }
+
+  double tMax(0.0);
+  for (unsigned int i(0); i<t.size(); ++i) {
+    if ((t[i] > tMax) && (t[i] <= 20.0))
+      tMax = t[i];
+  }
+
+  double value;
+  fTablePar = par;
+  fUseTable = (fTable && (par[1] > 0.0) && fTable->Interpolate(fabs(par[0])/par[1], par[2]/par[1], par[1]*tMax, value));
+
+  if (!fUseTable && fCalcNeeded)
+    CalcLaplaceTransform(par);
+}
+
+//--------------------------------------------------------------------------
+// CheckParameters (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Keeps the parameters and flags the cached coefficients, resp. Laplace transform as needed if they have changed.
+ *
+ * \param par parameters, see operator()
+ */
+void TLFDynExpKT::CheckParameters(const std::vector<double> &par) const {
+  if(fFirstCall){
+    fPar = par;
+    fFirstCall=false;
+  }
+
+  for (unsigned int i(0); i<par.size(); i++) {
+    if( fPar[i]-par[i] ) {
+      fPar[i] = par[i];
+      fCalcNeeded=true;
     }
+  }
+}
 
-    // Transform to frequency domain
+//--------------------------------------------------------------------------
+// CalcApproximation (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculates the coefficients of the semi-analytical approximation for {nu >= 5a} and {omegaL >= 30a}.
+ *
+ * \param par parameters, see operator()
+ */
+void TLFDynExpKT::CalcApproximation(const std::vector<double> &par) const {
 
-    fftwf_execute(fFFTplanFORW);
+  double omegaL(TWOPI*par[0]); // Larmor frequency
+  double nu(par[2]); // hopping rate
 
-    // calculate F(s)
+  // 'c' and 'd' are parameters BMW obtained by fitting large parameter space LF-curves to the model below
+  const double c[7] = {1.15331, 1.64826, -0.71763, 3.0, 0.386683, -5.01876, 2.41854};
+  const double d[4] = {2.44056, 2.92063, 1.69581, 0.667277};
+  double w0N[4];
+  double nuN[4];
+  w0N[0] = omegaL;
+  nuN[0] = nu;
+  for (unsigned int i=1; i<4; ++i) {
+    w0N[i] = omegaL * w0N[i-1];
+    nuN[i] = nu * nuN[i-1];
+  }
+  double denom(w0N[3]+d[0]*w0N[2]*nuN[0]+d[1]*w0N[1]*nuN[1]+d[2]*w0N[0]*nuN[2]+d[3]*nuN[3]);
+  fL1 = (c[0]*w0N[2]+c[1]*w0N[1]*nuN[0]+c[2]*w0N[0]*nuN[1])/denom;
+  fL2 = (c[3]*w0N[2]+c[4]*w0N[1]*nuN[0]+c[5]*w0N[0]*nuN[1]+c[6]*nuN[2])/denom;
 
-    double nusq(par[2]*par[2]); // nu^2
-    double denom(1.0), imagsq(0.0), oneMINrealnu(1.0);
+
+  fCalcNeeded=false;
+}
+
+//--------------------------------------------------------------------------
+// CalcLaplaceTransform (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculates the polarization on the time grid of the Laplace transform.
+ *
+ * \param par parameters, see operator()
+ */
+void TLFDynExpKT::CalcLaplaceTransform(const std::vector<double> &par) const {
+
+  double omegaL(TWOPI*par[0]); // Larmor frequency
+
+
+  double tt(0.);
+  int i;
+  #ifdef HAVE_GOMP
+  int chunk = fNSteps/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #endif
+
+  if(TMath::Abs(par[0])<0.00135538817){
+    #ifdef HAVE_GOMP
+    #pragma omp parallel for default(shared) private(i, tt) schedule(dynamic, chunk)
+    #endif
+    for(i = 0; i < static_cast<int>(fNSteps); ++i) {
+      tt=static_cast<double>(i)*fDt;
+      fFFTtime[i]=(0.33333333333333333333+0.66666666666666666667*(1.0-par[1]*tt)*TMath::Exp(-par[1]*tt))*TMath::Exp(-(fC+par[2])*tt)*fDt;
+    }
+  } else {
+
+    double coeff1(par[1]/omegaL);
+    double coeff2(coeff1*coeff1);
+    double coeff3((1.0+coeff2)*par[1]);
+
+    fFFTtime[0] = 1.0*fDt;
 
     #ifdef HAVE_GOMP
-    chunk = (fNSteps/2+1)/omp_get_num_procs();
-    if (chunk < 10)
-      chunk = 10;
-    #pragma omp parallel for default(shared) private(i, imagsq, oneMINrealnu, denom) schedule(dynamic, chunk)
+    #pragma omp parallel for default(shared) private(i, tt) schedule(dynamic, chunk)
     #endif
-    for (i = 0; i < static_cast<int>(fNSteps)/2+1; ++i) {
-      imagsq=fFFTfreq[i][1]*fFFTfreq[i][1];
-      oneMINrealnu=1.0-(par[2]*fFFTfreq[i][0]);
-      denom=oneMINrealnu*oneMINrealnu + (nusq*imagsq);
-      fFFTfreq[i][0] = (oneMINrealnu*fFFTfreq[i][0]-(par[2]*imagsq))/denom;
-      fFFTfreq[i][1] /= denom;
+    for(i = 1; i < static_cast<int>(fNSteps); ++i) {
+      tt=(double(i)-0.5)*fDt;
+      fFFTtime[i]=TMath::Sin(omegaL*tt)/(omegaL*tt)*TMath::Exp(-par[1]*tt)*fDt;
     }
 
-    // Transform back to time domain
+    double totoIntegrale(0.);
+    double w0t(1.0);
 
-    fftwf_execute(fFFTplanBACK);
+    for(i = 1; i < static_cast<int>(fNSteps); ++i) {
+      tt=double(i)*fDt;
+      totoIntegrale+=fFFTtime[i];
+      w0t = omegaL*tt;
+      fFFTtime[i]=(1.0-(coeff1*TMath::Exp(-par[1]*tt)*(TMath::Sin(w0t)-w0t*TMath::Cos(w0t))/(w0t*w0t))-(coeff2*(TMath::Sin(w0t)/(w0t)*TMath::Exp(-par[1]*tt)-1.0))-coeff3*totoIntegrale)*TMath::Exp(-(fC+par[2])*tt)*fDt;
+    }
+  }
+
+  // Transform to frequency domain
+
+  fftwf_execute_dft_r2c(fFFTplanFORW, fFFTtime, fFFTfreq);
+
+  // calculate F(s)
+
+  double nusq(par[2]*par[2]); // nu^2
+  double denom(1.0), imagsq(0.0), oneMINrealnu(1.0);
+
+  #ifdef HAVE_GOMP
+  chunk = (fNSteps/2+1)/omp_get_num_procs();
+  if (chunk < 10)
+    chunk = 10;
+  #pragma omp parallel for default(shared) private(i, imagsq, oneMINrealnu, denom) schedule(dynamic, chunk)
+  #endif
+  for (i = 0; i < static_cast<int>(fNSteps)/2+1; ++i) {
+    imagsq=fFFTfreq[i][1]*fFFTfreq[i][1];
+    oneMINrealnu=1.0-(par[2]*fFFTfreq[i][0]);
+    denom=oneMINrealnu*oneMINrealnu + (nusq*imagsq);
+    fFFTfreq[i][0] = (oneMINrealnu*fFFTfreq[i][0]-(par[2]*imagsq))/denom;
+    fFFTfreq[i][1] /= denom;
+  }
+
+  // Transform back to time domain
+
+  fftwf_execute_dft_c2r(fFFTplanBACK, fFFTfreq, fFFTtime);
 
 //    for (unsigned int i(0); i<fNSteps; i++) {
 //      fFFTtime[i]=(fDw*TMath::Exp(fC*i*fDt)/TMath::Pi()*fFFTtime[i]);
 //    }
-    fCalcNeeded=false;
-    ++fCounter;
-  }
-//  return fFFTtime[int(t/fDt)];
-  return fDw*TMath::Exp(fC*t)/TMath::Pi()*fFFTtime[static_cast<int>(t/fDt)];
+  fCalcNeeded=false;
+  ++fCounter;
 }
 
 //--------------------------------------------------------------------------
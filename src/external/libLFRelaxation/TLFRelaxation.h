@@ -43,6 +43,9 @@
 #include "fftw3.h"
 #include "BMWIntegrator.h"
 
+class TLFDynTable;
+class PPerfCacheCounter;
+
 //-----------------------------------------------------------------------------------------------------------------
 /**
  * <p>User function for a static Gaussian depolarization in a longitudinal field using direct integration through GSL
@@ -112,11 +115,16 @@ public:
   ~TLFDynGssKT();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
+  void DisableTable();
+  double GetDeltat() const { return fDt; } ///< time resolution of the Laplace transform (us)
 
 private:
   mutable std::vector<double> fPar;   ///< parameters of the function [\htmlonly &#957;<sub>L</sub>=<i>B</i>&#947;<sub>&#956;</sub>/2&#960; (MHz), &#963; (&#956;s<sup>-1</sup>), &#957; (MHz)\endhtmlonly \latexonly $\nu_{\mathrm{L}}=B\gamma_{\mu}/2\pi~(\mathrm{MHz})$, $\sigma~(\mu\mathrm{s}^{-1})$, $\nu~(\mathrm{MHz})$ \endlatexonly]
   mutable bool fCalcNeeded;           ///< flag indicating if the expensive Laplace transform has to be done (e.g. after parameters have changed)
   mutable bool fFirstCall;            ///< flag indicating if the function is evaluated for the first time
+  mutable bool fUseTable;             ///< flag indicating if the table is used for all times of the parameter set fTablePar (see Prepare)
+  mutable std::vector<double> fTablePar; ///< parameters for which fUseTable has been decided
   bool fUseWisdom;                    ///< flag showing if a FFTW3-wisdom file is used
   std::string fWisdom;                ///< path to the wisdom file
   unsigned int fNSteps;               ///< length of the Laplace transform
@@ -128,6 +136,11 @@ private:
   float *fFFTtime;                    ///< time-domain array
   fftwf_complex *fFFTfreq;            ///< frequency-domain array
   mutable unsigned int fCounter;      ///< counter determining how many Laplace transforms are done (mainly for debugging purposes)
+  TLFDynTable *fTable;                //! precomputed table in (nu_L/sigma, nu/sigma, sigma*t), used instead of the Laplace transform where available
+  PPerfCacheCounter *fPerfTable;      //! table hit/miss statistics for the performance report
+  PPerfCacheCounter *fPerfLaplace;    //! Laplace transform cache statistics for the performance report
+  void CheckParameters(const std::vector<double>&) const;
+  void CalcLaplaceTransform(const std::vector<double>&) const;
 
   ClassDef(TLFDynGssKT,2)
 };
@@ -161,11 +174,16 @@ public:
   ~TLFDynExpKT();
 
   double operator()(double, const std::vector<double>&) const;
+  void Prepare(const std::vector<double>&, const std::vector<double>&) const;
+  void DisableTable();
+  double GetDeltat() const { return fDt; } ///< time resolution of the Laplace transform (us)
 
 private:
   mutable std::vector<double> fPar;    ///< parameters of the function [\htmlonly &#957;<sub>L</sub>=<i>B</i>&#947;<sub>&#956;</sub>/2&#960; (MHz), <i>a</i> (&#956;s<sup>-1</sup>), &#957; (MHz)\endhtmlonly \latexonly $\nu_{\mathrm{L}}=B\gamma_{\mu}/2\pi~(\mathrm{MHz})$, $a~(\mu\mathrm{s}^{-1})$, $\nu~(\mathrm{MHz})$ \endlatexonly]
   mutable bool fCalcNeeded;            ///< flag indicating if the expensive Laplace transform has to be done (e.g. after parameters have changed)
   mutable bool fFirstCall;             ///< flag indicating if the function is evaluated for the first time
+  mutable bool fUseTable;              ///< flag indicating if the table is used for all times of the parameter set fTablePar (see Prepare)
+  mutable std::vector<double> fTablePar; ///< parameters for which fUseTable has been decided
   bool fUseWisdom;                     ///< flag showing if a FFTW3-wisdom file is used
   std::string fWisdom;                 ///< path to the wisdom file
   unsigned int fNSteps;                ///< length of the Laplace transform
@@ -179,6 +197,12 @@ private:
   mutable unsigned int fCounter;       ///< counter determining how many Laplace transforms are done (mainly for debugging purposes)
   mutable double fL1;                  ///< coefficient used for the high-field and high-hopping-rate approximation
   mutable double fL2;                  ///< coefficient used for the high-field and high-hopping-rate approximation
+  TLFDynTable *fTable;                 //! precomputed table in (nu_L/a, nu/a, a*t), used instead of the Laplace transform where available
+  PPerfCacheCounter *fPerfTable;       //! table hit/miss statistics for the performance report
+  PPerfCacheCounter *fPerfLaplace;     //! Laplace transform cache statistics for the performance report
+  void CheckParameters(const std::vector<double>&) const;
+  void CalcApproximation(const std::vector<double>&) const;
+  void CalcLaplaceTransform(const std::vector<double>&) const;
 
   ClassDef(TLFDynExpKT,2)
 };
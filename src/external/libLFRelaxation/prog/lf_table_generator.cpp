@@ -0,0 +1,194 @@
+/***************************************************************************
+
+  lf_table_generator.cpp
+
+  Author: Bastian M. Wojek
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2009 by Bastian M. Wojek                                *
+ *                                                                         *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include "TLFRelaxation.h"
+#include "TLFDynTable.h"
+
+//-----------------------------------------------------------------------------
+/**
+ * <p>lf_table_generator syntax console output.
+ */
+void lftg_syntax()
+{
+  std::cout << std::endl;
+  std::cout << "usage: lf_table_generator <function> --out <table> [--nx <n>] [--ny <n>] [--nt <n>] [--xmax <x>] [--ymax <y>] [--tmax <tau>] | --help" << std::endl;
+  std::cout << "   <function>    : TLFDynGssKT or TLFDynExpKT" << std::endl;
+  std::cout << "   --out <table> : table file name. Give it in BMW_startup.xml as <table_GssKT_LF> resp. <table_ExpKT_LF>." << std::endl;
+  std::cout << "   --nx <n>      : number of grid points in nu_L/sigma (default 41)" << std::endl;
+  std::cout << "   --ny <n>      : number of grid points in nu/sigma (default 51)" << std::endl;
+  std::cout << "   --nt <n>      : number of grid points in sigma*t (default 1001)" << std::endl;
+  std::cout << "   --xmax <x>    : upper limit of nu_L/sigma (default: where the analytic high-field approximation starts)" << std::endl;
+  std::cout << "   --ymax <y>    : upper limit of nu/sigma (default 5)" << std::endl;
+  std::cout << "   --tmax <tau>  : upper limit of sigma*t (default 10, at most 20)" << std::endl;
+  std::cout << "   --help        : will dump this help" << std::endl;
+  std::cout << std::endl;
+  std::cout << "   For TLFDynExpKT sigma has to be read as the static width a." << std::endl;
+  std::cout << "   The Laplace transforms are set up as in the user functions, i.e. BMW_startup.xml has to be present." << std::endl;
+  std::cout << std::endl << std::endl;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * <p>reads the value of a numeric option.
+ *
+ * @param argc number of command line arguments
+ * @param argv command line arguments
+ * @param i index of the option; incremented if the value has been consumed
+ * @param value option value
+ *
+ * @return true, if the value could be read, false otherwise.
+ */
+bool lftg_read_value(int argc, char *argv[], int &i, double &value)
+{
+  if (i >= argc-1) {
+    std::cerr << std::endl << "lf_table_generator: **ERROR** found option " << argv[i] << " without value" << std::endl;
+    return false;
+  }
+  try {
+    value = std::stod(argv[i+1]);
+  }
+  catch(std::exception& e) {
+    std::cerr << std::endl << "lf_table_generator: **ERROR** value '" << argv[i+1] << "' of option " << argv[i] << " is not a number." << std::endl;
+    return false;
+  }
+  i++;
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  std::string function("");
+  std::string outFileName("");
+  double nx(0.0), ny(0.0), nt(0.0), xmax(0.0), ymax(0.0), tmax(0.0);
+  bool show_syntax(false);
+
+  if (argc == 1) {
+    lftg_syntax();
+    return 0;
+  }
+
+  for (int i=1; i<argc; i++) {
+    if (argv[i][0] != '-') { // must be the function name
+      function = argv[i];
+    } else if (!strcmp(argv[i], "--help")) {
+      lftg_syntax();
+      return 0;
+    } else if (!strcmp(argv[i], "--out")) {
+      if (i < argc-1) {
+        outFileName = argv[i+1];
+        i++;
+      } else {
+        std::cerr << std::endl << "lf_table_generator: **ERROR** found option --out without <table>" << std::endl;
+        show_syntax = true;
+        break;
+      }
+    } else if (!strcmp(argv[i], "--nx")) {
+      show_syntax = !lftg_read_value(argc, argv, i, nx);
+    } else if (!strcmp(argv[i], "--ny")) {
+      show_syntax = !lftg_read_value(argc, argv, i, ny);
+    } else if (!strcmp(argv[i], "--nt")) {
+      show_syntax = !lftg_read_value(argc, argv, i, nt);
+    } else if (!strcmp(argv[i], "--xmax")) {
+      show_syntax = !lftg_read_value(argc, argv, i, xmax);
+    } else if (!strcmp(argv[i], "--ymax")) {
+      show_syntax = !lftg_read_value(argc, argv, i, ymax);
+    } else if (!strcmp(argv[i], "--tmax")) {
+      show_syntax = !lftg_read_value(argc, argv, i, tmax);
+    } else {
+      std::cerr << std::endl << "lf_table_generator: **ERROR** unknown option " << argv[i] << std::endl;
+      show_syntax = true;
+    }
+    if (show_syntax)
+      break;
+  }
+
+  if ((function != "TLFDynGssKT") && (function != "TLFDynExpKT")) {
+    std::cerr << std::endl << "lf_table_generator: **ERROR** unknown function '" << function << "'" << std::endl;
+    show_syntax = true;
+  }
+  if (outFileName.empty()) {
+    std::cerr << std::endl << "lf_table_generator: **ERROR** no table file name given" << std::endl;
+    show_syntax = true;
+  }
+
+  if (show_syntax) {
+    lftg_syntax();
+    return -1;
+  }
+
+  // setup the grid
+  TLFDynTableHeader grid;
+  TLFDynTable::SetDefaultGrid((function == "TLFDynExpKT") ? kLFDynExpKT : kLFDynGssKT, grid);
+  if (nx > 0.0)
+    grid.fNx = static_cast<uint32_t>(nx);
+  if (ny > 0.0)
+    grid.fNy = static_cast<uint32_t>(ny);
+  if (nt > 0.0)
+    grid.fNt = static_cast<uint32_t>(nt);
+  if (xmax > 0.0)
+    grid.fXmax = xmax;
+  if (ymax > 0.0)
+    grid.fYmax = ymax;
+  if (tmax > 0.0)
+    grid.fTmax = tmax;
+  if (grid.fTmax > 20.0) { // the user functions are only defined up to 20 us
+    std::cerr << std::endl << "lf_table_generator: **ERROR** sigma*t has to be <= 20" << std::endl;
+    return -1;
+  }
+
+  // the exact function, evaluated at sigma = 1/us, i.e. t = tau
+  bool success(false);
+  std::vector<double> par(3, 0.0);
+  par[1] = 1.0;
+  if (function == "TLFDynGssKT") {
+    TLFDynGssKT fcn;
+    fcn.DisableTable();
+    grid.fDt = fcn.GetDeltat();
+    success = TLFDynTable::Generate(outFileName, grid, [&fcn, &par](double x, double y, double tau) {
+      par[0] = x;
+      par[2] = y;
+      return fcn(tau, par);
+    });
+  } else {
+    TLFDynExpKT fcn;
+    fcn.DisableTable();
+    grid.fDt = fcn.GetDeltat();
+    success = TLFDynTable::Generate(outFileName, grid, [&fcn, &par](double x, double y, double tau) {
+      par[0] = x;
+      par[2] = y;
+      return fcn(tau, par);
+    });
+  }
+
+  return (success ? 0 : -2);
+}
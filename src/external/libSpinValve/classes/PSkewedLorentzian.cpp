@@ -123,10 +123,12 @@ PSkewedLorentzian::~PSkewedLorentzian()
 // operator()
 //--------------------------------------------------------------------------
 /**
- * <p>
+ * <p>Polarization of the skewed Lorentzian field distribution, i.e. the normalized sum of the
+ * cosines of the sampled fields. If the time has been handed over by Prepare for the same
+ * parameters, the tabulated value is returned.
  *
- * \param t
- * \param par
+ * \param t time in (us)
+ * \param par (0) B0: peak field, (1) beta: field width, (2) Delta: skewness width, (3) phi: detector phase
  */
 Double_t PSkewedLorentzian::operator()(Double_t t, const std::vector<Double_t> &par) const
 {
@@ -140,57 +142,124 @@ Double_t PSkewedLorentzian::operator()(Double_t t, const std::vector<Double_t> &
   if (fabs(par[2]-1.0) < 1.0e-4)
     return 0.0;
 
-  // calculate the field sampling points
-  PDoubleVector BB;
+  // tabulated by Prepare?
+  if (!fTable.empty() && (par == fTableParam)) {
+    Double_t dt = (fTableTime.back()-fTableTime.front())/static_cast<Double_t>(fTableTime.size()-1);
+    Int_t idx = static_cast<Int_t>(std::lround((t-fTableTime.front())/dt));
+    if ((idx >= 0) && (idx < static_cast<Int_t>(fTableTime.size())) && (fTableTime[idx] == t))
+      return fTable[idx];
+  }
+
+  // calculate the field sampling points, if the parameters have changed
+  UpdateDistribution(par);
+
+  return fDistribution.Polarization(t, fDegToRad*par[3]);
+}
+
+//--------------------------------------------------------------------------
+// Prepare
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculates the polarization for all times of the fit range at once. For an equidistant time grid
+ * the cosine sums of the many sampled fields are obtained by a chirp-z transform (see PFieldDistribution).
+ *
+ * \param t times at which the function will be evaluated next
+ * \param par (0) B0: peak field, (1) beta: field width, (2) Delta: skewness width, (3) phi: detector phase
+ */
+void PSkewedLorentzian::Prepare(const std::vector<Double_t> &t, const std::vector<Double_t> &par) const
+{
+  fTable.clear();
+
+  if ((par.size() != 4) || (t.size() < 2) || (fabs(par[2]-1.0) < 1.0e-4))
+    return;
+
+  // check that the time grid is equidistant
+  const UInt_t n = t.size();
+  const Double_t dt = (t.back()-t.front())/static_cast<Double_t>(n-1);
+  if (dt <= 0.0)
+    return;
+  for (UInt_t i=0; i<n; i++) {
+    if (fabs(t[i]-(t.front()+static_cast<Double_t>(i)*dt)) > 1.0e-6*dt)
+      return;
+  }
+
+  UpdateDistribution(par);
+
+  fDistribution.Polarization(t.front(), dt, n, fDegToRad*par[3], fTable);
+  fTableTime = t;
+  fTableParam = par;
+}
+
+//--------------------------------------------------------------------------
+// UpdateDistribution (private)
+//--------------------------------------------------------------------------
+/**
+ * <p>Samples the skewed Lorentzian field distribution, if B0, beta, or Delta have changed.
+ * The sampling points below and above B0 are equidistant, hence they form two segments of
+ * the distribution.
+ *
+ * \param par (0) B0: peak field, (1) beta: field width, (2) Delta: skewness width, (3) phi: detector phase
+ */
+void PSkewedLorentzian::UpdateDistribution(const std::vector<Double_t> &par) const
+{
+  if ((fPrevParam.size() == 3) && (fPrevParam[0] == par[0]) && (fPrevParam[1] == par[1]) && (fPrevParam[2] == par[2]))
+    return;
+
+  fPrevParam.assign(par.begin(), par.begin()+3);
+  fDistribution.Clear();
+
   Double_t fieldRangeMinus = fRange * (par[1]*(1.0-par[2])); // Bj < B0
   Double_t fieldRangePlus  = fRange * (par[1]*(1.0+par[2])); // Bj > B0
+  Double_t gammaTwoPi = fTwoPi*GAMMA_BAR_MUON;
 
+  // amplitude of the field B
+  auto ampl = [&par](const Double_t B) {
+    Double_t dval;
+    if (B < par[0]) // Bj < B0
+      dval = (B-par[0])/(par[1]*(1.0-par[2]));
+    else // Bj > B0
+      dval = (B-par[0])/(par[1]*(1.0+par[2]));
+    return 1.0/(1.0+dval*dval);
+  };
+
+  PDoubleVector aa;
   Double_t dB = 0.0;
   Double_t dval = 0.0;
+  Double_t firstB = 0.0;
   if (fNoOfFields % 2 == 0) { // even number of sampling points
     dB = fieldRangeMinus / (fNoOfFields/2 + 0.5);
     for (Int_t j=fNoOfFields/2-1; j>=0; j--) {
       dval = par[0] - dB*(static_cast<Double_t>(j)+0.5);
-      if (dval > 0.0)
-        BB.push_back(dval); // Bj = B0 - dB*(j+1/2) for Bj < B0
+      if (dval > 0.0) { // Bj = B0 - dB*(j+1/2) for Bj < B0
+        if (aa.empty())
+          firstB = dval;
+        aa.push_back(ampl(dval));
+      }
     }
+    fDistribution.AddEquidistant(gammaTwoPi*firstB, gammaTwoPi*dB, aa);
+    aa.clear();
     dB = fieldRangePlus / (fNoOfFields/2 + 0.5);
     for (Int_t j=0; j<static_cast<Int_t>(fNoOfFields/2); j++)
-      BB.push_back(par[0] + dB*(static_cast<Double_t>(j)+0.5)); // Bj = B0 + dB*(j+1/2) for Bj > B0
+      aa.push_back(ampl(par[0] + dB*(static_cast<Double_t>(j)+0.5))); // Bj = B0 + dB*(j+1/2) for Bj > B0
+    fDistribution.AddEquidistant(gammaTwoPi*(par[0]+0.5*dB), gammaTwoPi*dB, aa);
   } else { // odd number of sampling points
     Int_t halfNoOfPoints = (fNoOfFields-1)/2;
-    dB = fieldRangeMinus / halfNoOfPoints;
-    for (Int_t j=halfNoOfPoints; j>0; j--) {
-      dval = par[0] - dB*static_cast<Double_t>(j);
-      if (dval > 0.0)
-        BB.push_back(dval); // Bj = B0 - dB*j for Bj < B0
+    if (halfNoOfPoints > 0) {
+      dB = fieldRangeMinus / halfNoOfPoints;
+      for (Int_t j=halfNoOfPoints; j>0; j--) {
+        dval = par[0] - dB*static_cast<Double_t>(j);
+        if (dval > 0.0) { // Bj = B0 - dB*j for Bj < B0
+          if (aa.empty())
+            firstB = dval;
+          aa.push_back(ampl(dval));
+        }
+      }
+      fDistribution.AddEquidistant(gammaTwoPi*firstB, gammaTwoPi*dB, aa);
+      aa.clear();
+      dB = fieldRangePlus / halfNoOfPoints;
     }
-    BB.push_back(par[0]); // Bj = B0
-    dB = fieldRangePlus / halfNoOfPoints;
-    for (Int_t j=1; j<=halfNoOfPoints; j++)
-      BB.push_back(par[0] + dB*static_cast<Double_t>(j)); // Bj = B0 + dB*j for Bj > B0
-  }
-
-  // calculate the asymmetry
-  Double_t ampl_i=0.0;
-  Double_t norm=0.0;
-  Double_t result = 0.0;
-  Double_t cycl = 0.0;
-  Double_t phase = fDegToRad*par[3];
-  for (UInt_t i=0; i<BB.size(); i++) {
-    if (BB[i] < par[0]) // Bj < B0
-      dval = (BB[i]-par[0])/(par[1]*(1.0-par[2]));
-    else // Bj > 0
-      dval = (BB[i]-par[0])/(par[1]*(1.0+par[2]));
-    cycl = fTwoPi*GAMMA_BAR_MUON*BB[i];
-    ampl_i = 1.0/(1.0+dval*dval);
-    norm += ampl_i;
-    result += ampl_i*cos(cycl*t+phase);
+    for (Int_t j=0; j<=halfNoOfPoints; j++)
+      aa.push_back(ampl(par[0] + dB*static_cast<Double_t>(j))); // Bj = B0 + dB*j for Bj >= B0
+    fDistribution.AddEquidistant(gammaTwoPi*par[0], gammaTwoPi*dB, aa);
   }
-  result /= norm;
-
-  // clean up
-  BB.clear();
-
-  return result;
 }
@@ -33,6 +33,7 @@
 #include <vector>
 
 #include "PUserFcnBase.h"
+#include "PFieldDistribution.h"
 #include "PStartupHandler_SV.h"
 
 class PSkewedLorentzian : public PUserFcnBase
@@ -45,6 +46,7 @@ class PSkewedLorentzian : public PUserFcnBase
 
     // function operator
     Double_t operator()(Double_t, const std::vector<Double_t>&) const;
+    void Prepare(const std::vector<Double_t> &t, const std::vector<Double_t> &par) const;
 
   private:
     PStartupHandler_SV *fStartupHandler;
@@ -53,9 +55,17 @@ class PSkewedLorentzian : public PUserFcnBase
     UInt_t   fNoOfFields; ///< number of sampling points in field around the Lorentzian peak
     Double_t fRange;      ///< range in which the sampling points are placed, given in units of \beta(1\pm\Delta)
 
+    mutable std::vector<Double_t> fPrevParam;  //! B0, beta, Delta for which fDistribution has been calculated
+    mutable PFieldDistribution fDistribution;  //! sampled field distribution (angular frequencies and amplitudes)
+    mutable std::vector<Double_t> fTableParam; //! parameters for which fTable has been calculated
+    mutable std::vector<Double_t> fTableTime;  //! times of fTable
+    mutable std::vector<Double_t> fTable;      //! polarization at the times handed over by Prepare
+
     constexpr static const Double_t fDegToRad = 0.0174532925199432955;
     constexpr static const Double_t fTwoPi = 6.28318530717958623;
 
+    void UpdateDistribution(const std::vector<Double_t> &par) const;
+
   // definition of the class for the ROOT dictionary
   ClassDef(PSkewedLorentzian, 1)
 };
@@ -24,6 +24,7 @@
  *   v1.3   22-Apr-2003  [D. Arseneau] Add MUD_openInOut
  *          25-Nov-2009  [D. Arseneau] Handle larger size_t
  *          04-May-2016  [D. Arseneau] Edits for C++ use
+ *          19-Oct-2026  Add MUD_readFileHeader (skip histogram data)
  */
 
 
@@ -403,6 +404,20 @@ MUD_readFile( FILE* fin )
 }
 
 
+/*
+ *  MUD_readFileHeader() - read all sections of a file, except the
+ *  histogram data sections, which are skipped on disk.  Used when only
+ *  the run description/header information is needed.
+ */
+void*
+MUD_readFileHeader( FILE* fin )
+{
+    rewind( fin );
+
+    return( MUD_read( fin, MUD_HDR ) );
+}
+
+
 void*
 MUD_read( FILE* fin, MUD_IO_OPT io_opt )
 {
@@ -462,14 +477,33 @@ MUD_read( FILE* fin, MUD_IO_OPT io_opt )
 #endif /* DEBUG */
 
     if(	( pMUD_new->core.secID == MUD_SEC_GRP_ID ) &&
-        ( ( io_opt == MUD_ALL ) || ( io_opt == MUD_GRP ) ) )
+        ( ( io_opt == MUD_ALL ) || ( io_opt == MUD_GRP ) ||
+          ( io_opt == MUD_HDR ) || ( io_opt == MUD_GRP_HDR ) ) )
     {
 	/*	  
 	 *  Read the group members
 	 */	  
         for( i = 0; i < ((MUD_SEC_GRP*)pMUD_new)->num; i++ )
 	{
-	    pMUD_next = (MUD_SEC*)MUD_read( fin, MUD_GRP );
+	    if( ( io_opt == MUD_HDR ) || ( io_opt == MUD_GRP_HDR ) )
+	    {
+		/*
+		 *  Header only: skip histogram data sections on disk
+		 */
+		pMUD_next = MUD_peekCore( fin );
+		if( pMUD_next == NULL ) return( pMUD_new );
+		if( pMUD_next->core.secID == MUD_SEC_GEN_HIST_DAT_ID )
+		{
+		    if( fseek( fin, (long)pMUD_next->core.size, 1 ) == EOF ) 
+			return( pMUD_new );
+		    continue;
+		}
+		pMUD_next = (MUD_SEC*)MUD_read( fin, MUD_GRP_HDR );
+	    }
+	    else
+	    {
+		pMUD_next = (MUD_SEC*)MUD_read( fin, MUD_GRP );
+	    }
 	    if( pMUD_next == NULL )
 	    {
 		return( pMUD_new );
@@ -492,7 +526,7 @@ MUD_read( FILE* fin, MUD_IO_OPT io_opt )
     }
 
     if(	( MUD_secID( pMUD_new ) != MUD_SEC_EOF_ID ) &&
-        ( io_opt == MUD_ALL ) )
+        ( ( io_opt == MUD_ALL ) || ( io_opt == MUD_HDR ) ) )
     {
 	/*	  
 	 *  Read the next section
@@ -218,7 +218,9 @@ typedef enum {
 typedef enum {
     MUD_ONE = 1,
     MUD_ALL = 2,
-    MUD_GRP = 3
+    MUD_GRP = 3,
+    MUD_HDR = 4,       /* as MUD_ALL, but skip histogram data sections */
+    MUD_GRP_HDR = 5    /* as MUD_GRP, but skip histogram data sections */
 } MUD_IO_OPT;
 
 
@@ -505,6 +507,7 @@ void addIndex _ANSI_ARGS_(( MUD_SEC_GRP *pMUD_grp , void* pMUD ));
 BOOL MUD_writeGrpMem _ANSI_ARGS_(( FILE *fout , MUD_SEC_GRP *pMUD_grp , void* pMUD ));
 BOOL MUD_writeGrpEnd _ANSI_ARGS_(( FILE *fout , MUD_SEC_GRP *pMUD_grp ));
 void* MUD_readFile _ANSI_ARGS_(( FILE *fin ));
+void* MUD_readFileHeader _ANSI_ARGS_(( FILE *fin ));
 void* MUD_read _ANSI_ARGS_(( FILE *fin , MUD_IO_OPT io_opt ));
 UINT32 MUD_setSizes _ANSI_ARGS_(( void* pMUD ));
 MUD_SEC* MUD_peekCore _ANSI_ARGS_(( FILE *fin ));
@@ -568,6 +571,7 @@ void GMF_LOCALTIME _ANSI_ARGS_(( TIME* in , INT32 *out ));
 
 /* mud_friendly.c */
 int MUD_openRead _ANSI_ARGS_(( char* filename, UINT32* pType ));
+int MUD_openReadHeader _ANSI_ARGS_(( char* filename, UINT32* pType ));
 int MUD_openWrite _ANSI_ARGS_(( char* filename, UINT32 type ));
 int MUD_openReadWrite _ANSI_ARGS_(( char* filename, UINT32* pType ));
 int MUD_closeRead _ANSI_ARGS_(( int fd ));
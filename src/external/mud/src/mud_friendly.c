@@ -46,6 +46,7 @@
  *    Open/close files:
  * 
  *    int MUD_openRead( char* filename, UINT32* pType )
+ *    int MUD_openReadHeader( char* filename, UINT32* pType )
  *    int MUD_openWrite( char* filename, UINT32 type )
  *    int MUD_openReadWrite( char* filename, UINT32* pType )
  *    int MUD_closeRead( int fd )
@@ -265,6 +266,39 @@ MUD_openRead( char* filename, UINT32* pType )
   return( fd );
 }
 
+/*
+ *  MUD_openReadHeader() - as MUD_openRead, but the histogram data
+ *  sections are skipped. All header routines (run description, histogram
+ *  headers, scalers, independent variables) work as usual, whereas
+ *  MUD_getHistData and friends will fail on such a file handle.
+ */
+int 
+MUD_openReadHeader( char* filename, UINT32* pType )
+{
+  int fd;
+
+  for( fd = 0; fd < MUD_MAX_FILES; fd++ ) 
+  {
+    if( mud_f[fd] == NULL ) break;
+  }
+  if( fd == MUD_MAX_FILES ) return( -1 );
+
+  mud_f[fd] = MUD_openInput( filename );
+  if( mud_f[fd] == NULL ) return( -1 );
+
+  pMUD_fileGrp[fd] = (MUD_SEC_GRP*)MUD_readFileHeader( mud_f[fd] );
+  if( pMUD_fileGrp[fd] == NULL )
+  {
+    fclose( mud_f[fd] );
+    mud_f[fd] = NULL;
+    return( -1 );
+  }
+
+  *pType = MUD_instanceID( pMUD_fileGrp[fd] );
+
+  return( fd );
+}
+
 int 
 MUD_openReadWrite( char* filename, UINT32* pType )
 {
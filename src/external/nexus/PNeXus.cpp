@@ -1929,14 +1929,15 @@ PNeXus::PNeXus()
  * <p>
  *
  * \param fileName
+ * \param headerOnly if true, the histogram payload is not read (see ReadFile())
  */
-PNeXus::PNeXus(const char* fileName)
+PNeXus::PNeXus(const char* fileName, const bool headerOnly)
 {
   Init();
 
   fFileName = fileName;
 
-  if (ReadFile(fileName) != NX_OK) {
+  if (ReadFile(fileName, headerOnly) != NX_OK) {
     std::cerr << std::endl << fErrorMsg << " (error code=" << fErrorCode << ")" << std::endl << std::endl;
   } else {
     fValid = true;
@@ -2015,6 +2016,8 @@ void PNeXus::SetIdfVersion(unsigned int idf)
  * <p>Validates the NeXus data. A flag 'strict' controls the degree of validation. If 'strict' == true
  * a full NeXus validation is done, otherwise a much sloppier validation is performed. This sloppier
  * validation is needed when converting data.
+ * If only the header has been read (see ReadFile()), the histogram related checks cannot
+ * be performed, hence only the successful reading of the header is reported.
  *
  * \param strict flag if true a strict NeXus validation is performed.
  */
@@ -2022,6 +2025,9 @@ bool PNeXus::IsValid(bool strict)
 {
   bool valid = true;
 
+  if (fHeaderOnly)
+    return fValid;
+
   if (fIdfVersion == 1) // IDF Version 1
     valid = IsValidIdf1(strict);
   else if (fIdfVersion == 2) // IDF Version 2
@@ -2061,10 +2067,13 @@ std::vector<unsigned int>* PNeXus::GetGroupedHisto(unsigned int idx)
  * - NX_ERROR on error. The error code/message will give the details.
  *
  * \param fileName file name of the nexus file to be read
+ * \param headerOnly if true, all the meta information (including the 'counts' attributes
+ * and dimensions) is read, but the histogram payload itself is skipped.
  */
-int PNeXus::ReadFile(const char *fileName)
+int PNeXus::ReadFile(const char *fileName, const bool headerOnly)
 {
   fFileName = fileName;
+  fHeaderOnly = headerOnly;
 
   // open file
   NXstatus status;
@@ -2502,6 +2511,7 @@ void PNeXus::Dump(const bool counts)
 void PNeXus::Init()
 {
   fValid = false;
+  fHeaderOnly = false;
   fErrorCode = PNEXUS_NO_ERROR;
   fErrorMsg = "n/a";
   fNeXusVersion = NEXUS_VERSION;
@@ -3217,19 +3227,6 @@ int PNeXus::ReadFileIdf1()
   noOfElements = size;
   size *= GetDataSize(type);
 
-  // allocate locale memory to get the data
-  char *data_ptr = new char[size];
-  if (data_ptr == nullptr) {
-    return NX_ERROR;
-  }
-
-  // get the data
-  int *i_data_ptr = (int*) data_ptr;
-  status = NXgetdata(fFileHandle, i_data_ptr);
-  if (status != NX_OK) {
-    return NX_ERROR;
-  }
-
   // check that the amount of data is consistent with the attribute information
   if (noOfElements != noOfHistos * histoLength) {
     fErrorCode = PNEXUS_HISTO_ERROR;
@@ -3237,24 +3234,43 @@ int PNeXus::ReadFileIdf1()
     return NX_ERROR;
   }
 
-  // copy the data into the vector
   fNxEntry1->GetData()->FlushHistos();
-  std::vector<unsigned int> data;
-  for (int i=0; i<noOfElements; i++) {
-    if ((i % histoLength == 0) && (i>0)) {
-      fNxEntry1->GetData()->SetHisto(data);
-      data.clear();
-      data.push_back(*(i_data_ptr+i));
-    } else {
-      data.push_back(*(i_data_ptr+i));
+  if (!fHeaderOnly) { // header only: do not touch the histogram payload
+    // allocate locale memory to get the data
+    char *data_ptr = new char[size];
+    if (data_ptr == nullptr) {
+      return NX_ERROR;
     }
-  }
-  fNxEntry1->GetData()->SetHisto(data);
-  data.clear();
 
-  // clean up
-  if (data_ptr) {
-    delete [] data_ptr;
+    // get the data
+    int *i_data_ptr = (int*) data_ptr;
+    status = NXgetdata(fFileHandle, i_data_ptr);
+    if (status != NX_OK) {
+      return NX_ERROR;
+    }
+
+    // copy the data into the vector
+    std::vector<unsigned int> data;
+    for (int i=0; i<noOfElements; i++) {
+      if ((i % histoLength == 0) && (i>0)) {
+        fNxEntry1->GetData()->SetHisto(data);
+        data.clear();
+        data.push_back(*(i_data_ptr+i));
+      } else {
+        data.push_back(*(i_data_ptr+i));
+      }
+    }
+    fNxEntry1->GetData()->SetHisto(data);
+    data.clear();
+
+    // clean up
+    if (data_ptr) {
+      delete [] data_ptr;
+    }
+  } else { // keep empty histos as place holders, such that the number of histos is still available
+    std::vector<unsigned int> data;
+    for (int i=0; i<noOfHistos; i++)
+      fNxEntry1->GetData()->SetHisto(data);
   }
 
   if (!ErrorHandler(NXclosedata(fFileHandle), PNEXUS_CLOSE_DATA_ERROR, "couldn't close 'counts' data in NXdata group")) return NX_ERROR;
@@ -3362,7 +3378,8 @@ int PNeXus::ReadFileIdf1()
   // close file
   NXclose(&fFileHandle);
 
-  GroupHistoData();
+  if (!fHeaderOnly)
+    GroupHistoData();
 
   fValid = true;
 
@@ -3771,19 +3788,6 @@ int PNeXus::ReadFileIdf2()
   noOfElements = size;
   size *= GetDataSize(type);
 
-  // allocate locale memory to get the data
-  char *data_ptr = new char[size];
-  if (data_ptr == nullptr) {
-    return NX_ERROR;
-  }
-
-  // get the data
-  int *i_data_ptr = (int*) data_ptr;
-  status = NXgetdata(fFileHandle, i_data_ptr);
-  if (status != NX_OK) {
-    return NX_ERROR;
-  }
-
   if (rank == 3) { // i.e. np, ns, ntc
     fNxEntry2->GetInstrument()->GetDetector()->SetNoOfPeriods(dims[0]);
     fNxEntry2->GetInstrument()->GetDetector()->SetNoOfSpectra(dims[1]);
@@ -3804,15 +3808,32 @@ int PNeXus::ReadFileIdf2()
     return NX_ERROR;
   }
 
-  if (!fNxEntry2->GetInstrument()->GetDetector()->SetHistos(i_data_ptr)) {
-    std::cerr << std::endl << ">> **ERROR** " << fNxEntry2->GetInstrument()->GetDetector()->GetErrorMsg() << std::endl;
-    return NX_ERROR;
-  }
+  char *data_ptr = nullptr;
+  int *i_data_ptr = nullptr;
+  if (!fHeaderOnly) { // header only: do not touch the histogram payload
+    // allocate locale memory to get the data
+    data_ptr = new char[size];
+    if (data_ptr == nullptr) {
+      return NX_ERROR;
+    }
 
-  // clean up
-  if (data_ptr) {
-    delete [] data_ptr;
-    data_ptr = nullptr;
+    // get the data
+    i_data_ptr = (int*) data_ptr;
+    status = NXgetdata(fFileHandle, i_data_ptr);
+    if (status != NX_OK) {
+      return NX_ERROR;
+    }
+
+    if (!fNxEntry2->GetInstrument()->GetDetector()->SetHistos(i_data_ptr)) {
+      std::cerr << std::endl << ">> **ERROR** " << fNxEntry2->GetInstrument()->GetDetector()->GetErrorMsg() << std::endl;
+      return NX_ERROR;
+    }
+
+    // clean up
+    if (data_ptr) {
+      delete [] data_ptr;
+      data_ptr = nullptr;
+    }
   }
 
   if (!ErrorHandler(NXclosedata(fFileHandle), PNEXUS_CLOSE_DATA_ERROR, "couldn't close 'counts' data in NXdetector!")) return NX_ERROR;
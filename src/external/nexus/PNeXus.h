@@ -563,7 +563,7 @@ class PNeXusEntry2 {
 class PNeXus {
   public:
     PNeXus();
-    PNeXus(const char* fileName);
+    PNeXus(const char* fileName, const bool headerOnly=false);
     virtual ~PNeXus();
 
     virtual int GetIdfVersion() { return fIdfVersion; }
@@ -583,7 +583,9 @@ class PNeXus {
 
     virtual std::vector<unsigned int>* GetGroupedHisto(unsigned int idx);
 
-    virtual int ReadFile(const char *fileName);
+    virtual bool IsHeaderOnly() { return fHeaderOnly; }
+
+    virtual int ReadFile(const char *fileName, const bool headerOnly=false);
     virtual int WriteFile(const char *fileName, const char *fileType="hdf4", const unsigned int idf=2);
 
     virtual void SetCreator(std::string str) { fCreator = str; }
@@ -592,6 +594,7 @@ class PNeXus {
 
   private:
     bool fValid;
+    bool fHeaderOnly; ///< if true, the histogram payload ('counts') has not been read
     int fErrorCode;
     std::string fErrorMsg;
 
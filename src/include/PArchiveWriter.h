@@ -0,0 +1,79 @@
+/***************************************************************************
+
+  PArchiveWriter.h
+
+  Author: Andreas Suter
+  e-mail: andreas.suter@psi.ch
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2007-2023 by Andreas Suter                              *
+ *   andreas.suter@psi.ch                                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef _PARCHIVEWRITER_H_
+#define _PARCHIVEWRITER_H_
+
+#include <cstdio>
+#include <vector>
+
+#include <TString.h>
+
+//-------------------------------------------------------------
+// compression tags as used in PAny2ManyInfo::compressionTag
+#define PARCHIVE_NONE  0
+#define PARCHIVE_GZIP  1
+#define PARCHIVE_BZIP2 2
+#define PARCHIVE_ZSTD  3
+
+//-------------------------------------------------------------
+/**
+ * <p>Writes a (ustar) tar archive which is compressed on the fly, i.e.
+ * without spawning external tar/gzip/bzip2 processes. Supported compressions
+ * are gzip (zlib), bzip2 (libbz2) and, if available at build time, zstd.
+ */
+class PArchiveWriter {
+  public:
+    PArchiveWriter();
+    virtual ~PArchiveWriter();
+
+    static const char* GetExtension(const Int_t compressionTag);
+    static Bool_t IsSupported(const Int_t compressionTag);
+
+    virtual Bool_t Open(const TString fileName, const Int_t compressionTag);
+    virtual Bool_t AddFile(const TString pathFileName, const TString nameInArchive="");
+    virtual Bool_t Close();
+
+    virtual Bool_t IsOpen() { return fIsOpen; }
+
+  private:
+    Bool_t fIsOpen{false};  ///< flag showing if the archive is open
+    Int_t  fCompressionTag{PARCHIVE_NONE}; ///< 1=gzip, 2=bzip2, 3=zstd
+    FILE  *fFile{nullptr};  ///< underlying output stream (file or stdout)
+    Bool_t fOwnFile{false}; ///< true if fFile needs to be closed by the writer
+    void  *fStream{nullptr}; ///< compressor handle (gzFile, BZFILE*, or ZSTD_CCtx*)
+    std::vector<char> fBuffer; ///< read buffer for the files to be archived
+    std::vector<char> fOutBuffer; ///< compressed output buffer (zstd only)
+    Long64_t fBytesWritten{0}; ///< uncompressed number of bytes written so far
+
+    Bool_t Write(const char *data, const size_t size, const Bool_t flush=false);
+    Bool_t WriteHeader(const TString &name, const Long64_t size, const Long_t mtime, const Int_t mode);
+};
+
+#endif // _PARCHIVEWRITER_H_
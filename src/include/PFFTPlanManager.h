@@ -0,0 +1,138 @@
+/***************************************************************************
+
+  PFFTPlanManager.h
+
+  Author: Andreas Suter
+  e-mail: andreas.suter@psi.ch
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2007-2023 by Andreas Suter                              *
+ *   andreas.suter@psi.ch                                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef _PFFTPLANMANAGER_H_
+#define _PFFTPLANMANAGER_H_
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <Rtypes.h>
+
+#include "fftw3.h"
+
+class PPerfCacheCounter;
+
+//--------------------------------------------------------------------------------------------
+/**
+ * <p>Key under which a FFTW plan is cached. Besides kind, size and precision of the transform
+ * it contains everything which restricts the reuse of a plan with other arrays via the
+ * new-array execute functions (fftw_execute_dft, ...): in-place or not, and the SIMD alignment
+ * of the arrays. Plans created with a different number of threads or planner rigor are kept apart.
+ */
+struct PFFTPlanKey {
+  Int_t fKind;               ///< kind of the transform, see PFFTPlanManager::EPlanKind
+  Bool_t fSinglePrecision;   ///< true for fftwf plans
+  std::vector<Int_t> fDims;  ///< dimensions of the transform
+  std::vector<Int_t> fLayout; ///< sign resp. r2r kinds, embeddings and strides
+  Bool_t fInPlace;           ///< in-place transform
+  Int_t fAlignIn;            ///< alignment of the input array
+  Int_t fAlignOut;           ///< alignment of the output array
+  UInt_t fFlags;             ///< planner flags
+  Int_t fThreads;            ///< number of threads the plan has been created for
+
+  bool operator<(const PFFTPlanKey &key) const;
+};
+
+//--------------------------------------------------------------------------------------------
+/**
+ * <p>Process-wide FFTW service used by the core library and the user functions.
+ *
+ * <p>Plans are cached and shared between all objects asking for the same transform. The plans are
+ * owned by the manager and must not be destroyed by the caller. Since a cached plan might have been
+ * created for other arrays, it has to be executed with the new-array execute functions, e.g.
+ * fftw_execute_dft(plan, in, out), and never with fftw_execute(plan).
+ *
+ * <p>Wisdom files are imported once per file and precision, and written back once when the
+ * process ends. The number of threads used by the FFTW planner follows
+ * musrfit's --use-no-of-threads (only effective if fftw3_threads are available).
+ */
+class PFFTPlanManager
+{
+  public:
+    enum EPlanKind {kDft, kDftR2C, kDftC2R, kManyR2R};
+
+    static PFFTPlanManager* GetInstance();
+
+    // double precision
+    fftw_plan GetPlanDft(const Int_t rank, const Int_t *n, fftw_complex *in, fftw_complex *out, const Int_t sign, const UInt_t flags);
+    fftw_plan GetPlanDftR2C(const Int_t rank, const Int_t *n, Double_t *in, fftw_complex *out, const UInt_t flags);
+    fftw_plan GetPlanDftC2R(const Int_t rank, const Int_t *n, fftw_complex *in, Double_t *out, const UInt_t flags);
+    fftw_plan GetPlanManyR2R(const Int_t rank, const Int_t *n, Double_t *in, const Int_t *inembed, const Int_t istride,
+                             Double_t *out, const Int_t *onembed, const Int_t ostride, const fftw_r2r_kind *kind, const UInt_t flags);
+
+    // single precision
+    fftwf_plan GetPlanDft(const Int_t rank, const Int_t *n, fftwf_complex *in, fftwf_complex *out, const Int_t sign, const UInt_t flags);
+    fftwf_plan GetPlanDftR2C(const Int_t rank, const Int_t *n, Float_t *in, fftwf_complex *out, const UInt_t flags);
+    fftwf_plan GetPlanDftC2R(const Int_t rank, const Int_t *n, fftwf_complex *in, Float_t *out, const UInt_t flags);
+
+    Bool_t ImportWisdom(const std::string &fileName, const Bool_t singlePrecision=false);
+    void ExportWisdom();
+
+    void SetNumberOfThreads(const Int_t noOfThreads);
+    Int_t GetNumberOfThreads() const { return fNoOfThreads; }
+
+    UInt_t GetNumberOfPlans() const { return fNoOfPlans; }           ///< number of plans created so far
+    UInt_t GetNumberOfCacheHits() const { return fNoOfCacheHits; }   ///< number of plan requests served from the cache
+    Double_t GetPlanningTime() const { return fPlanningTime; }       ///< accumulated wall-clock planning time (sec)
+    void PrintStatistics() const;
+
+  private:
+    PFFTPlanManager();
+    ~PFFTPlanManager();
+    PFFTPlanManager(const PFFTPlanManager&) = delete;
+    PFFTPlanManager& operator=(const PFFTPlanManager&) = delete;
+
+    struct PFFTPlans {
+      fftw_plan fPlan{nullptr};   ///< double precision plan
+      fftwf_plan fPlanF{nullptr}; ///< single precision plan
+    };
+
+    std::mutex fMutex; ///< FFTW's planner is not thread-safe
+    std::map<PFFTPlanKey, PFFTPlans> fPlans; ///< plan cache
+    std::set<std::string> fWisdomFiles;  ///< double precision wisdom files
+    std::set<std::string> fWisdomFilesF; ///< single precision wisdom files
+    Int_t fNoOfThreads{1}; ///< number of threads the FFTW planner should use
+    Bool_t fThreadsInitialized{false};  ///< fftw3_threads initialized
+    Bool_t fThreadsInitializedF{false}; ///< fftw3f_threads initialized
+
+    UInt_t fNoOfPlans{0};
+    UInt_t fNoOfCacheHits{0};
+    PPerfCacheCounter *fPerfCache{nullptr}; ///< plan cache statistics of the performance report
+    Double_t fPlanningTime{0.0};
+
+    PFFTPlanKey MakeKey(const EPlanKind kind, const Bool_t singlePrecision, const Int_t rank, const Int_t *n,
+                        const void *in, const void *out, const Int_t alignIn, const Int_t alignOut, const UInt_t flags) const;
+    void PrepareThreads(const Bool_t singlePrecision);
+};
+
+#endif // _PFFTPLANMANAGER_H_
@@ -0,0 +1,134 @@
+/***************************************************************************
+
+  PFieldDistribution.h
+
+  Author: Andreas Suter
+  e-mail: andreas.suter@psi.ch
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2007-2023 by Andreas Suter                              *
+ *   andreas.suter@psi.ch                                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef _PFIELDDISTRIBUTION_H_
+#define _PFIELDDISTRIBUTION_H_
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <Rtypes.h>
+
+//--------------------------------------------------------------------------------------------
+/**
+ * <p>Discrete distribution of (angular) frequencies \f$\omega_j\f$ with amplitudes \f$a_j\f$,
+ * as used by user functions which sample a field distribution.
+ *
+ * <p>The distribution is made of segments of equidistant frequencies \f$\omega_j = \omega_0 + j\,\Delta\omega\f$.
+ * It is meant to be set up once per parameter set and is then evaluated either as polarization
+ * \f$P(t) = \sum_j a_j \cos(\omega_j t + \varphi) / \sum_j a_j\f$, or convolved with a line shape.
+ *
+ * <p>For equidistant frequencies the cosine sum is a polynomial in \f$e^{i\Delta\omega t}\f$ and is
+ * calculated by a Horner recurrence, i.e. without any trigonometric function per sampling point.
+ * On an equidistant time grid, large segments are calculated for all times at once by a chirp-z
+ * transform (Bluestein's algorithm), which needs three FFTs instead of N*n complex multiplications.
+ */
+class PFieldDistribution
+{
+  public:
+    PFieldDistribution() : fTotalWeight(0.0) {}
+    virtual ~PFieldDistribution() {}
+
+    virtual void Clear();
+    virtual void AddEquidistant(const Double_t omega0, const Double_t dOmega, const std::vector<Double_t> &ampl);
+
+    virtual Bool_t IsEmpty() const { return fSegment.empty(); } ///< true if no frequency has been added
+    virtual UInt_t GetNoOfPoints() const;
+    virtual Double_t GetTotalWeight() const { return fTotalWeight; } ///< returns the sum of all amplitudes
+
+    virtual Double_t Polarization(const Double_t t, const Double_t phase=0.0) const;
+    virtual void Polarization(const Double_t tStart, const Double_t dt, const UInt_t n, const Double_t phase, std::vector<Double_t> &pol) const;
+
+    template <class TShape> Double_t Convolve(const Double_t x, const TShape &shape, const Double_t cutoff=-1.0) const;
+
+    static void SetMinChirpZSize(const UInt_t size) { fMinChirpZSize = size; } ///< sets the segment size from which on the chirp-z transform is used
+    static UInt_t GetMinChirpZSize() { return fMinChirpZSize; } ///< returns the segment size from which on the chirp-z transform is used
+
+  private:
+    /**
+     * <p>Equidistant part of the distribution: omega_j = fOmega0 + j*fDOmega, amplitude fAmpl[j]
+     */
+    struct PSegment {
+      Double_t fOmega0;            ///< first frequency
+      Double_t fDOmega;            ///< frequency step
+      std::vector<Double_t> fAmpl; ///< amplitudes
+    };
+
+    std::vector<PSegment> fSegment; ///< segments of the distribution
+    Double_t fTotalWeight;          ///< sum of all amplitudes
+
+    static UInt_t fMinChirpZSize;   ///< segments with at least this number of frequencies are evaluated on a time grid by the chirp-z transform
+
+    void SumHorner(const PSegment &seg, const Double_t tStart, const Double_t dt, const UInt_t n, std::vector<std::complex<Double_t> > &sum) const;
+    Bool_t SumChirpZ(const PSegment &seg, const Double_t tStart, const Double_t dt, const UInt_t n, std::vector<std::complex<Double_t> > &sum) const;
+};
+
+//--------------------------------------------------------------------------
+// Convolve (public)
+//--------------------------------------------------------------------------
+/**
+ * <p>Convolution of the distribution with a line shape, i.e. \f$\sum_j a_j\, f(x-\omega_j)\f$.
+ * The result is not normalized.
+ *
+ * <p><b>return:</b> convolution at x
+ *
+ * \param x point at which the convolution is evaluated
+ * \param shape line shape; called as shape(x-omega_j)
+ * \param cutoff if > 0, the line shape is taken to vanish for |x-omega_j| > cutoff
+ */
+template <class TShape>
+Double_t PFieldDistribution::Convolve(const Double_t x, const TShape &shape, const Double_t cutoff) const
+{
+  Double_t result = 0.0;
+
+  for (UInt_t i=0; i<fSegment.size(); i++) {
+    const PSegment &seg = fSegment[i];
+    Int_t first = 0, last = static_cast<Int_t>(seg.fAmpl.size())-1;
+    if ((cutoff > 0.0) && (seg.fDOmega != 0.0)) { // restrict the sum to the frequencies within the cutoff
+      Double_t jLow  = (x - cutoff - seg.fOmega0)/seg.fDOmega;
+      Double_t jHigh = (x + cutoff - seg.fOmega0)/seg.fDOmega;
+      if (jLow > jHigh)
+        std::swap(jLow, jHigh);
+      if ((jHigh < 0.0) || (jLow > static_cast<Double_t>(last)))
+        continue;
+      if (jLow > 0.0)
+        first = static_cast<Int_t>(std::ceil(jLow));
+      if (jHigh < static_cast<Double_t>(last))
+        last = static_cast<Int_t>(std::floor(jHigh));
+    }
+    for (Int_t j=first; j<=last; j++)
+      result += seg.fAmpl[j] * shape(x - (seg.fOmega0 + static_cast<Double_t>(j)*seg.fDOmega));
+  }
+
+  return result;
+}
+
+#endif // _PFIELDDISTRIBUTION_H_
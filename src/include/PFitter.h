@@ -59,6 +59,10 @@
 #define PMN_USER_PARAM_STATE  18
 #define PMN_PRINT             19
 #define PMN_SECTOR            20
+#define PMN_BLOCK_MINIMIZE    21
+#define PMN_LEAST_SQUARES     22
+#define PMN_BOOTSTRAP         23
+#define PMN_MCMC              24
 
 //-----------------------------------------------------------------------------
 /**
@@ -102,6 +106,71 @@ class PSectorChisq
     PUIntVector fNDFRun; ///< NDF for the sector and run
 };
 
+//-----------------------------------------------------------------------------
+/**
+ * <p>Symmetric matrix with the block-arrow structure of a global fit: a dense block for the
+ * global parameters, a dense block for the local parameters of each run block, and the
+ * couplings between the local parameters of a run block and the global parameters. Local
+ * parameters of different run blocks do not couple. Linear systems are solved via the Schur
+ * complement of the local blocks, i.e. the effort grows only linearly with the number of run blocks.
+ */
+class PBlockArrowMatrix
+{
+  public:
+    PBlockArrowMatrix(const UInt_t noOfGlobal, const PUIntVector &noOfLocal);
+
+    UInt_t GetNoOfGlobal() { return fNoOfGlobal; }
+    UInt_t GetNoOfBlocks() { return fNoOfLocal.size(); }
+    UInt_t GetNoOfLocal(UInt_t blk) { return fNoOfLocal[blk]; }
+
+    void Zero();
+    Double_t& GlobalGlobal(UInt_t i, UInt_t j) { return fGlobalGlobal[i*fNoOfGlobal+j]; } ///< element (i,j) of the global block
+    Double_t& LocalLocal(UInt_t blk, UInt_t i, UInt_t j) { return fLocalLocal[blk][i*fNoOfLocal[blk]+j]; } ///< element (i,j) of the local block blk
+    Double_t& LocalGlobal(UInt_t blk, UInt_t i, UInt_t j) { return fLocalGlobal[blk][i*fNoOfGlobal+j]; } ///< coupling of local parameter i of block blk and global parameter j
+
+    Bool_t Solve(const PDoubleVector &rhsGlobal, const std::vector<PDoubleVector> &rhsLocal, const Double_t lambda,
+                 PDoubleVector &xGlobal, std::vector<PDoubleVector> &xLocal);
+    Bool_t InverseDiagonal(PDoubleVector &diagGlobal, std::vector<PDoubleVector> &diagLocal);
+
+    static Bool_t CholeskyDecompose(PDoubleVector &a, const UInt_t n);
+    static void CholeskySolve(const PDoubleVector &l, const UInt_t n, Double_t *x);
+
+  private:
+    UInt_t fNoOfGlobal;       ///< number of global parameters
+    PUIntVector fNoOfLocal;   ///< number of local parameters of each block
+    PDoubleVector fGlobalGlobal; ///< global block, row major
+    std::vector<PDoubleVector> fLocalLocal;  ///< local block of each run block, row major
+    std::vector<PDoubleVector> fLocalGlobal; ///< local/global couplings of each run block, row major (local index first)
+
+    Bool_t Factorize(const Double_t lambda, std::vector<PDoubleVector> &cholLocal, std::vector<PDoubleVector> &w, PDoubleVector &cholSchur);
+};
+
+//-----------------------------------------------------------------------------
+/**
+ * <p>Evaluation state of the fit function which can be used concurrently to the one of the
+ * main fit, e.g. by another thread. It holds its own msr-file handler (functions, theory),
+ * run list collection and fit function, i.e. its own PTheory and user function instances,
+ * whereas the raw run data are shared with the main run list collection, i.e. no data file is
+ * read again. Hence workers can only be evaluated concurrently if all user functions keep
+ * their state in the instance (see PUserFcnBase::IsReentrant) and have no global part.
+ */
+class PFitterWorker
+{
+  public:
+    PFitterWorker(PMsrHandler *runInfo, PRunListCollection *runListCollection, const Bool_t useChi2);
+    virtual ~PFitterWorker();
+
+    Bool_t IsValid() { return fValid; }
+    PRunListCollection* GetRunListCollection() { return fRunListCollection; }
+    PFitterFcn* GetFitterFcn() { return fFitterFcn; }
+
+  private:
+    Bool_t fValid; ///< flag. true: the evaluation state is valid
+    PMsrHandler *fRunInfo; ///< msr-file handler of the worker
+    PRunListCollection *fRunListCollection; ///< run list collection of the worker
+    PFitterFcn *fFitterFcn; ///< fit function of the worker
+};
+
 //-----------------------------------------------------------------------------
 /**
  * <p>Interface class to minuit2.
@@ -115,6 +184,7 @@ class PFitter
     Bool_t IsValid() { return fIsValid; }
     Bool_t IsScanOnly() { return fIsScanOnly; }
     Bool_t HasConverged() { return fConverged; }
+    ULong64_t GetNoOfFcnCalls() { return (fFitterFcn != nullptr) ? fFitterFcn->GetNoOfCalls() : 0; } ///< returns the number of FCN calls so far
     Bool_t DoFit();
 
   private:
@@ -166,10 +236,14 @@ class PFitter
     Bool_t CheckCommands();
     Bool_t SetParameters();
 
+    Bool_t ExecuteBlockMinimize(const Bool_t leastSquares=false);
+    Bool_t ExecuteBootstrap(UInt_t lineNo);
     Bool_t ExecuteContours();
     Bool_t ExecuteFitRange(UInt_t lineNo);
     Bool_t ExecuteFix(UInt_t lineNo);
     Bool_t ExecuteHesse();
+    Bool_t ExecuteLeastSquares();
+    Bool_t ExecuteMcmc(UInt_t lineNo);
     Bool_t ExecuteMigrad();
     Bool_t ExecuteMinimize();
     Bool_t ExecuteMinos();
@@ -183,6 +257,12 @@ class PFitter
     void   PrepareSector(PDoubleVector &param, PDoubleVector &error);
     Bool_t ExecuteSector(std::ofstream &fout);
 
+    Double_t GetRunBlockFcnValue(const PDoubleVector &par, const UInt_t idx);
+    void GetSampleStatistics(PDoubleVector &val, Double_t &mean, Double_t &sigma, PDoubleVector &percentile);
+    Double_t Int2Ext(const UInt_t idx, const Double_t val);
+    Double_t Ext2Int(const UInt_t idx, const Double_t val);
+    Double_t DInt2Ext(const UInt_t idx, const Double_t val);
+
     Double_t MilliTime();
 };
 
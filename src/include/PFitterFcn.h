@@ -30,6 +30,7 @@
 #ifndef _PFITTERFCN_H_
 #define _PFITTERFCN_H_
 
+#include <atomic>
 #include <vector>
 
 #include "Minuit2/FCNBase.h"
@@ -51,11 +52,13 @@ class PFitterFcn : public ROOT::Minuit2::FCNBase
     UInt_t GetTotalNoOfFittedBins() { return fRunListCollection->GetTotalNoOfBinsFitted(); }
     UInt_t GetNoOfFittedBins(const UInt_t idx) { return fRunListCollection->GetNoOfBinsFitted(idx); }
     void CalcExpectedChiSquare(const std::vector<Double_t> &par, Double_t &totalExpectedChisq, std::vector<Double_t> &expectedChisqPerRun);
+    ULong64_t GetNoOfCalls() const { return fNoOfCalls.load(); } ///< returns the number of function calls so far
 
   private:
     Double_t fUp;     ///< for chisq == 1.0, i.e. errors are 1 std. deviation errors. for log max-likelihood == 0.5, i.e. errors are 1 std. deviation errors (for details see the minuit2 user manual).
     Bool_t fUseChi2;  ///< true = chisq fit, false = log max-likelihood fit
     PRunListCollection *fRunListCollection; ///< pre-processed data to be fitted
+    mutable std::atomic<ULong64_t> fNoOfCalls; ///< number of function calls
 };
 
 #endif // _PFITTERFCN_H_
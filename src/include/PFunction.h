@@ -99,6 +99,7 @@ class PFunction {
     virtual Bool_t CheckMapAndParamRange(UInt_t mapSize, UInt_t paramSize);
     virtual Double_t Eval(std::vector<Double_t> param, PMetaData metaData);
     virtual void SetMap(std::vector<Int_t> map) { fMap = map; }
+    virtual Bool_t IsRunBlockIndependent() { return !FindRunBlockDependence(fFunc); }
 
     virtual TString* GetFuncString() { return &fFuncString; }
 
@@ -107,6 +108,7 @@ class PFunction {
     virtual Bool_t SetFuncNo();
 
     virtual Bool_t FindAndCheckMapAndParamRange(PFuncTreeNode &node, UInt_t mapSize, UInt_t paramSize);
+    virtual Bool_t FindRunBlockDependence(const PFuncTreeNode &node);
     virtual Bool_t GenerateFuncEvalTree();
     virtual void FillFuncEvalTree(iter_t const& i, PFuncTreeNode &node);
     virtual Double_t EvalNode(PFuncTreeNode &node);
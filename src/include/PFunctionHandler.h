@@ -55,6 +55,7 @@ class PFunctionHandler
     virtual Int_t GetFuncNo(UInt_t idx);
     virtual Int_t GetFuncIndex(Int_t funcNo);
     virtual UInt_t GetNoOfFuncs() { return fFuncs.size(); }
+    virtual Bool_t IsRunBlockIndependent(UInt_t idx);
     virtual TString GetFuncString(UInt_t idx);
 
   private:
@@ -30,6 +30,8 @@
 #ifndef _PMSRHANDLER_H_
 #define _PMSRHANDLER_H_
 
+#include <fstream>
+
 #include <TString.h>
 #include <TComplex.h>
 
@@ -46,6 +48,7 @@ class PMsrHandler
 {
   public:
     PMsrHandler(const Char_t *fileName, PStartupOptions *startupOptions=0, const Bool_t fourierOnly=false);
+    PMsrHandler(const PMsrHandler &msrHandler);
     virtual ~PMsrHandler();
 
     virtual Int_t ReadMsrFile();
@@ -70,6 +73,7 @@ class PMsrHandler
 
     virtual UInt_t GetNoOfParams() { return fParam.size(); }
     virtual const TString& GetFileName() const { return fFileName; }
+    virtual PStartupOptions* GetStartupOptions() { return fStartupOptions; }
 
     virtual void SetMsrTitle(const TString &title) { fTitle = title; }
 
@@ -87,15 +91,18 @@ class PMsrHandler
     virtual void SetMsrStatisticConverged(Bool_t converged) { fStatistic.fValid = converged; }
     virtual void SetMsrStatisticMin(Double_t min) { fStatistic.fMin = min; }
     virtual void SetMsrStatisticNdf(UInt_t ndf) { fStatistic.fNdf = ndf; }
+    virtual void SetMsrStatisticMcmc(const PStringVector &lines) { fStatistic.fMcmc = lines; }
 
     virtual Int_t GetNoOfFuncs() { return fFuncHandler->GetNoOfFuncs(); }
     virtual UInt_t GetFuncNo(Int_t idx) { return fFuncHandler->GetFuncNo(idx); }
     virtual UInt_t GetFuncIndex(Int_t funNo) { return fFuncHandler->GetFuncIndex(funNo); }
+    virtual Bool_t IsFuncRunBlockIndependent(UInt_t idx) { return fFuncHandler->IsRunBlockIndependent(idx); }
     virtual Bool_t CheckMapAndParamRange(UInt_t mapSize, UInt_t paramSize)
                        { return fFuncHandler->CheckMapAndParamRange(mapSize, paramSize); }
     virtual Double_t EvalFunc(UInt_t i, std::vector<Int_t> map, std::vector<Double_t> param, PMetaData metaData)
                        { return fFuncHandler->Eval(i, map, param, metaData); }
     virtual UInt_t GetNoOfFitParameters(UInt_t idx);
+    virtual PUIntVector GetRunBlockParameters(UInt_t idx);
     virtual Int_t ParameterInUse(UInt_t paramNo);
     virtual Bool_t CheckRunBlockIntegrity();
     virtual Bool_t CheckUniquenessOfParamNames(UInt_t &parX, UInt_t &parY);
@@ -145,6 +152,7 @@ class PMsrHandler
     virtual Bool_t HandleStatisticEntry(PMsrLines &line);
 
     virtual void FillParameterInUse(PMsrLines &theory, PMsrLines &funcs, PMsrLines &run);
+    virtual Bool_t CollectRunBlockParameters(const UInt_t idx, const Bool_t all, PUIntVector &param);
 
     virtual void InitFourierParameterStructure(PMsrFourierStructure &fourier);
     virtual void RemoveComment(const TString &str, TString &truncStr);
@@ -161,6 +169,7 @@ class PMsrHandler
     virtual TString BeautifyFourierPhaseParameterString();
 
     virtual void CheckLegacyLifetimecorrection();
+    virtual void WriteMcmcStatistic(std::ofstream &fout, const Bool_t messages);
 };
 
 #endif // _PMSRHANDLER_H_
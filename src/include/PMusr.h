@@ -263,6 +263,7 @@ class PRunData {
 
     virtual void SetTheoryValue(UInt_t i, Double_t dval);
     virtual void ReplaceTheory(const PDoubleVector &theo);
+    virtual void ReplaceData(const PDoubleVector &value, const PDoubleVector &error);
 
   private:
     // data related info
@@ -437,6 +438,7 @@ class PRawRunData {
     virtual PRawRunDataSet* GetDataSet(const UInt_t idx, Bool_t wantHistoNo = true);
     virtual const PDoubleVector* GetDataBin(const UInt_t histoNo) { return fData.GetData(histoNo); }
     virtual const PNonMusrRawRunData* GetDataNonMusr() { return &fDataNonMusr; }
+    virtual const Bool_t IsHeaderOnly() { return fHeaderOnly; }
 
     virtual void SetVersion(const TString &str) { fVersion = str; }
     virtual void SetGenericValidatorUrl(const TString &str) { fGenericValidatorURL = str; }
@@ -475,6 +477,7 @@ class PRawRunData {
     virtual void SetTimeResolution(const Double_t dval) { fTimeResolution = dval; }
     virtual void SetRedGreenOffset(PIntVector &ivec) { fRedGreenOffset = ivec; }
     virtual void SetDataSet(PRawRunDataSet &dataSet, UInt_t idx=-1) { fData.Set(dataSet, idx); }
+    virtual void SetHeaderOnly(const Bool_t flag) { fHeaderOnly = flag; }
 
     PNonMusrRawRunData fDataNonMusr; ///< keeps all ascii- or db-file info in case of nonMusr fit
 
@@ -513,6 +516,7 @@ class PRawRunData {
     PDoubleVector fRingAnode;        ///< LEM ring anode HVs (L,R[,T,B])
     Double_t fTimeResolution;        ///< time resolution of the run in (ns)
     PIntVector fRedGreenOffset;      ///< keeps the Red/Green offsets
+    Bool_t fHeaderOnly;              ///< true if only the header has been read, i.e. the data sets carry no histogram bins
 
     PRawRunDataVector fData;         ///< keeps the histos together with the histo related properties such as T0, first good bin, etc.
 };
@@ -816,6 +820,7 @@ struct PMsrStatisticStructure {
   Double_t fMinExpected; ///< expected total chi2 or max. likelihood
   PDoubleVector fMinExpectedPerHisto; ///< expected pre histo chi2 or max. likelihood
   PUIntVector fNdfPerHisto; ///< number of degrees of freedom per histo
+  PStringVector fMcmc; ///< MCMC posterior summary and convergence diagnostics (COMMANDS block: MCMC), written as 'mcmc ...' lines
 };
 
 //-------------------------------------------------------------
@@ -836,7 +841,7 @@ struct PAny2ManyInfo {
   PStringVector outPathFileName;   ///< holds the out path/file name
   TString outPath{""};             ///< holds the output path
   UInt_t rebin{1};                 ///< holds the number of bins to be packed
-  UInt_t compressionTag{0};        ///< 0=no compression, 1=gzip compression, 2=bzip2 compression
+  UInt_t compressionTag{0};        ///< 0=no compression, 1=gzip compression, 2=bzip2 compression, 3=zstd compression
   TString compressFileName{""};    ///< holds the name of the outputfile name in case of compression is used
   UInt_t idf{0};                   ///< IDF version for NeXus files.
 };
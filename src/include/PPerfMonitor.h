@@ -0,0 +1,200 @@
+/***************************************************************************
+
+  PPerfMonitor.h
+
+  Author: Andreas Suter
+  e-mail: andreas.suter@psi.ch
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2007-2023 by Andreas Suter                              *
+ *   andreas.suter@psi.ch                                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef _PPERFMONITOR_H_
+#define _PPERFMONITOR_H_
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Rtypes.h>
+
+//--------------------------------------------------------------------------------------------
+/**
+ * <p>Hit/miss counter of a cache. The counters are only incremented if the performance
+ * monitor is enabled, and may be incremented concurrently.
+ */
+class PPerfCacheCounter
+{
+  public:
+    PPerfCacheCounter() : fHits(0), fMisses(0) {}
+
+    inline void Hit(const ULong64_t n=1);
+    inline void Miss(const ULong64_t n=1);
+
+    ULong64_t GetHits() const { return fHits.load(); }     ///< returns the number of cache hits
+    ULong64_t GetMisses() const { return fMisses.load(); } ///< returns the number of cache misses
+    void Reset() { fHits = 0; fMisses = 0; }               ///< resets both counters
+
+  private:
+    std::atomic<ULong64_t> fHits;   ///< number of requests served from the cache
+    std::atomic<ULong64_t> fMisses; ///< number of requests which had to be calculated
+};
+
+//--------------------------------------------------------------------------------------------
+/**
+ * <p>Process-wide collection of timers and counters of the fit engine, written as JSON report
+ * (musrfit --perf-report). It lives in libPUserFcnBase such that user functions can report
+ * their cache statistics as well.
+ *
+ * <p>Optionally, every timed section is recorded as span with its thread, and written as timeline
+ * in the Chrome trace-event format (musrfit --trace), which can be viewed with Perfetto or
+ * chrome://tracing.
+ *
+ * <p>The instrumentation is always compiled in. If the monitor is disabled (default), a timer
+ * or counter costs one check of a static flag. Timers are meant for coarse sections (FCN call,
+ * run block, data file, ...) and not for single time bins.
+ */
+class PPerfMonitor
+{
+  public:
+    static PPerfMonitor* GetInstance();
+
+    static Bool_t IsEnabled() { return fEnabled; } ///< true if timers and counters are recorded
+    static void SetEnabled(const Bool_t enabled) { fEnabled = enabled; } ///< enables/disables the recording
+    static Bool_t IsTracing() { return fTracing; } ///< true if timed sections are recorded as spans of the timeline
+    static void SetTracing(const Bool_t tracing) { fTracing = tracing; } ///< enables/disables the timeline
+    static Bool_t IsActive() { return fEnabled || fTracing; } ///< true if either the report or the timeline is recorded
+
+    void AddTime(const std::string &name, const Double_t sec, const ULong64_t calls=1);
+    void AddSpan(const std::string &name, const std::chrono::steady_clock::time_point &start,
+                 const std::chrono::steady_clock::time_point &end, const ULong64_t calls=1);
+    void AddCount(const std::string &name, const ULong64_t n=1);
+    PPerfCacheCounter* GetCacheCounter(const std::string &name);
+    void SetInfo(const std::string &key, const std::string &value);
+
+    void Reset();
+    Bool_t WriteJson(const std::string &fileName) const;
+    Bool_t WriteTrace(const std::string &fileName, const std::string &processName) const;
+
+  private:
+    PPerfMonitor();
+    PPerfMonitor(const PPerfMonitor&) = delete;
+    PPerfMonitor& operator=(const PPerfMonitor&) = delete;
+
+    /**
+     * <p>Accumulated time of a section
+     */
+    struct PPerfTimerEntry {
+      Double_t fTime{0.0};  ///< accumulated time (sec)
+      ULong64_t fCalls{0};  ///< number of calls
+      Double_t fMin{-1.0};  ///< shortest recorded time (sec)
+      Double_t fMax{0.0};   ///< longest recorded time (sec)
+    };
+
+    /**
+     * <p>Timed section of the timeline
+     */
+    struct PPerfSpan {
+      std::string fName; ///< section name
+      Double_t fStart;   ///< start time (us)
+      Double_t fDur;     ///< duration (us)
+      UInt_t fThread;    ///< thread id, see GetThreadId()
+    };
+
+    static Bool_t fEnabled; ///< flag telling if timers and counters are recorded
+    static Bool_t fTracing; ///< flag telling if timed sections are recorded as spans
+
+    mutable std::mutex fMutex;                          ///< protects the maps
+    std::chrono::steady_clock::time_point fStart;       ///< creation (resp. reset) time of the monitor
+    std::map<std::string, std::string> fInfo;           ///< general information, e.g. msr-file name
+    std::map<std::string, PPerfTimerEntry> fTimer;      ///< timers, key: section name
+    std::map<std::string, ULong64_t> fCounter;          ///< counters, key: counter name
+    std::map<std::string, PPerfCacheCounter> fCache;    ///< cache statistics, key: cache name
+    std::vector<PPerfSpan> fSpan;                       ///< spans of the timeline
+
+    void AddTimeLocked(const std::string &name, const Double_t sec, const ULong64_t calls);
+
+    static UInt_t GetThreadId();
+    static std::string Escape(const std::string &str);
+};
+
+//--------------------------------------------------------------------------------------------
+/**
+ * <p>Scoped timer: adds the time between construction and destruction (or Stop()) to the section
+ * name of the performance monitor, if the monitor was active at construction. The name is kept
+ * by reference and hence has to outlive the timer.
+ */
+class PPerfTimer
+{
+  public:
+    PPerfTimer(const std::string &name, const ULong64_t calls=1) : fName(name), fCalls(calls), fActive(PPerfMonitor::IsActive())
+    {
+      if (fActive)
+        fStart = std::chrono::steady_clock::now();
+    }
+    ~PPerfTimer() { Stop(); }
+
+    /// records the section now rather than at destruction
+    void Stop()
+    {
+      if (fActive)
+        PPerfMonitor::GetInstance()->AddSpan(fName, fStart, std::chrono::steady_clock::now(), fCalls);
+      fActive = false;
+    }
+
+  private:
+    PPerfTimer(const PPerfTimer&) = delete;
+    PPerfTimer& operator=(const PPerfTimer&) = delete;
+
+    const std::string &fName; ///< section name
+    ULong64_t fCalls;         ///< number of calls accounted for by this timer
+    Bool_t fActive;           ///< true if the monitor was active at construction and the section is not recorded yet
+    std::chrono::steady_clock::time_point fStart; ///< start time
+};
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Counts cache hits, if the performance monitor is enabled.
+ *
+ * \param n number of hits
+ */
+inline void PPerfCacheCounter::Hit(const ULong64_t n)
+{
+  if (PPerfMonitor::IsEnabled())
+    fHits.fetch_add(n, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Counts cache misses, if the performance monitor is enabled.
+ *
+ * \param n number of misses
+ */
+inline void PPerfCacheCounter::Miss(const ULong64_t n)
+{
+  if (PPerfMonitor::IsEnabled())
+    fMisses.fetch_add(n, std::memory_order_relaxed);
+}
+
+#endif // _PPERFMONITOR_H_
@@ -32,6 +32,7 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 #include <TObject.h>
 #include <TQObject.h>
@@ -49,6 +50,9 @@ struct PRgeData {
   PDoubleVector amplitude;
   PDoubleVector nn; // normalized int n(z) dz = 1 amplitudes
   Double_t noOfParticles;
+  Double_t dzGrid; // step width (nm) of the uniform resampling grid z_k = k dzGrid
+  Double_t dzGridLast; // width (nm) of the last grid cell, which ends at zMax and hence might be shorter than dzGrid
+  PDoubleVector nnGrid; // nn resampled on the uniform grid, i.e. nnGrid[k] = n(z_k)
 };
 
 //-----------------------------------------------------------------------------
@@ -108,20 +112,24 @@ class PRgeHandler : public TObject
     PRgeHandler(std::string fln="");
     virtual ~PRgeHandler() {}
 
-    virtual bool IsValid() { return fValid; }
-    virtual UInt_t GetNoOfRgeDataSets() { return (UInt_t)fData.size(); }
-    virtual PRgeDataList GetRgeData() { return fData; }
-    virtual Double_t GetZmax(const Double_t energy);
-    virtual Double_t GetZmax(const Int_t idx);
-    virtual Double_t Get_n(const Double_t energy, const Double_t z);
-    virtual Double_t Get_n(const Int_t idx, const Double_t z);
-    virtual Int_t GetEnergyIndex(const Double_t energy);
+    virtual bool IsValid() const { return fValid; }
+    virtual UInt_t GetNoOfRgeDataSets() const { return (UInt_t)fData.size(); }
+    virtual const PRgeDataList& GetRgeData() const { return fData; }
+    virtual Double_t GetZmax(const Double_t energy) const;
+    virtual Double_t GetZmax(const Int_t idx) const;
+    virtual Double_t Get_n(const Double_t energy, const Double_t z) const;
+    virtual Double_t Get_n(const Int_t idx, const Double_t z) const;
+    virtual void Get_n(const Int_t idx, const PDoubleVector &z, PDoubleVector &nn) const;
+    virtual Int_t GetEnergyIndex(const Double_t energy) const;
 
   private:
     bool fValid{false};
     PRgeDataList fData;
+    std::unordered_map<Int_t, Int_t> fEnergyIndex; //! energy (eV) -> index into fData
 
     virtual bool ReadRgeFile(const std::string fln, PRgeData &data);
+    virtual Int_t FindEnergyIndex(const Double_t energy) const;
+    virtual void ResampleOnGrid(PRgeData &data);
 
   ClassDef(PRgeHandler, 1)
 };
@@ -44,6 +44,7 @@ class PRunAsymmetry : public PRunBase
     virtual ~PRunAsymmetry();
 
     virtual Double_t CalcChiSquare(const std::vector<Double_t>& par);
+    virtual void CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals);
     virtual Double_t CalcChiSquareExpected(const std::vector<Double_t>& par);
     virtual Double_t CalcMaxLikelihood(const std::vector<Double_t>& par);
     virtual void CalcTheory();
@@ -63,6 +64,7 @@ class PRunAsymmetry : public PRunBase
     virtual Bool_t PrepareFitData();
     virtual Bool_t PrepareViewData(PRawRunData* runData, UInt_t histoNo[2]);
     virtual Bool_t PrepareRRFViewData(PRawRunData* runData, UInt_t histoNo[2]);
+    virtual void GetFitBinRange(Int_t &start, Int_t &end) { start = fStartTimeBin; end = fEndTimeBin; } ///< returns the fitted bins [start, end[ of fData
 
   private:
     UInt_t fAlphaBetaTag; ///< \f$ 1 \to \alpha = \beta = 1\f$; \f$ 2 \to \alpha \neq 1, \beta = 1\f$; \f$ 3 \to \alpha = 1, \beta \neq 1\f$; \f$ 4 \to \alpha \neq 1, \beta \neq 1\f$.
@@ -74,6 +76,10 @@ class PRunAsymmetry : public PRunBase
     PDoubleVector fForwardErr;  ///< forward histo errors
     PDoubleVector fBackward;    ///< backward histo data
     PDoubleVector fBackwardErr; ///< backward histo errors
+    PCumulativeHisto fForwardCum;      ///< cumulative form of fForward, built once fForward is background corrected
+    PCumulativeHisto fForwardErr2Cum;  ///< cumulative form of the squared fForwardErr
+    PCumulativeHisto fBackwardCum;     ///< cumulative form of fBackward, built once fBackward is background corrected
+    PCumulativeHisto fBackwardErr2Cum; ///< cumulative form of the squared fBackwardErr
 
     Int_t fGoodBins[4];   ///< keep first/last good bins. 0=fgb, 1=lgb (forward); 2=fgb, 3=lgb (backward)
 
@@ -81,6 +87,7 @@ class PRunAsymmetry : public PRunBase
     Int_t fEndTimeBin;      ///< bin at which the fit ends
 
     Bool_t SubtractFixBkg();
+    void GetAlphaBeta(const std::vector<Double_t>& par, Double_t &a, Double_t &b);
     Bool_t SubtractEstimatedBkg();
 
     virtual Bool_t GetProperT0(PRawRunData* runData, PMsrGlobalBlock *globalBlock, PUIntVector &forwardHisto, PUIntVector &backwardHistoNo);
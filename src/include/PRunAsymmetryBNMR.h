@@ -45,6 +45,7 @@ class PRunAsymmetryBNMR : public PRunBase
     virtual ~PRunAsymmetryBNMR();
 
     virtual Double_t CalcChiSquare(const std::vector<Double_t>& par);
+    virtual void CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals);
     virtual Double_t CalcChiSquareExpected(const std::vector<Double_t>& par);
     virtual Double_t CalcMaxLikelihood(const std::vector<Double_t>& par);
     virtual void CalcTheory();
@@ -63,6 +64,7 @@ class PRunAsymmetryBNMR : public PRunBase
     virtual Bool_t PrepareData();
     virtual Bool_t PrepareFitData();
     virtual Bool_t PrepareViewData(PRawRunData* runData, UInt_t histoNo[2]);
+    virtual void GetFitBinRange(Int_t &start, Int_t &end) { start = fStartTimeBin; end = fEndTimeBin; } ///< returns the fitted bins [start, end[ of fData
 
   private:
     UInt_t fAlphaBetaTag; ///< \f$ 1 \to \alpha = \beta = 1\f$; \f$ 2 \to \alpha \neq 1, \beta = 1\f$; \f$ 3 \to \alpha = 1, \beta \neq 1\f$; \f$ 4 \to \alpha \neq 1, \beta \neq 1\f$.
@@ -78,6 +80,14 @@ class PRunAsymmetryBNMR : public PRunBase
     PDoubleVector fForwardmErr;  ///< neg hel forward histo errors
     PDoubleVector fBackwardm;    ///< neg hel backward histo data
     PDoubleVector fBackwardmErr; ///< neg hel backward histo errors
+    PCumulativeHisto fForwardpCum;      ///< cumulative form of fForwardp, built once fForwardp is background corrected
+    PCumulativeHisto fForwardpErr2Cum;  ///< cumulative form of the squared fForwardpErr
+    PCumulativeHisto fBackwardpCum;     ///< cumulative form of fBackwardp, built once fBackwardp is background corrected
+    PCumulativeHisto fBackwardpErr2Cum; ///< cumulative form of the squared fBackwardpErr
+    PCumulativeHisto fForwardmCum;      ///< cumulative form of fForwardm, built once fForwardm is background corrected
+    PCumulativeHisto fForwardmErr2Cum;  ///< cumulative form of the squared fForwardmErr
+    PCumulativeHisto fBackwardmCum;     ///< cumulative form of fBackwardm, built once fBackwardm is background corrected
+    PCumulativeHisto fBackwardmErr2Cum; ///< cumulative form of the squared fBackwardmErr
 
     Int_t fGoodBins[4];   ///< keep first/last good bins. 0=fgb, 1=lgb (forward); 2=fgb, 3=lgb (backward)
 
@@ -85,6 +95,7 @@ class PRunAsymmetryBNMR : public PRunBase
     Int_t fEndTimeBin;      ///< bin at which the fit ends
 
     Bool_t SubtractFixBkg();
+    void GetAlphaBeta(const std::vector<Double_t>& par, Double_t &a, Double_t &b);
     Bool_t SubtractEstimatedBkg();
 
     virtual Bool_t GetProperT0(PRawRunData* runData, PMsrGlobalBlock *globalBlock, PUIntVector &forwardHisto, PUIntVector &backwardHistoNo);
@@ -44,6 +44,7 @@ class PRunAsymmetryRRF : public PRunBase
     virtual ~PRunAsymmetryRRF();
 
     virtual Double_t CalcChiSquare(const std::vector<Double_t>& par);
+    virtual void CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals);
     virtual Double_t CalcChiSquareExpected(const std::vector<Double_t>& par);
     virtual Double_t CalcMaxLikelihood(const std::vector<Double_t>& par);
     virtual void CalcTheory();
@@ -61,6 +62,7 @@ class PRunAsymmetryRRF : public PRunBase
     virtual Bool_t PrepareData();
     virtual Bool_t PrepareFitData();
     virtual Bool_t PrepareViewData(PRawRunData* runData, UInt_t histoNo[2]);
+    virtual void GetFitBinRange(Int_t &start, Int_t &end) { start = fStartTimeBin; end = fEndTimeBin; } ///< returns the fitted bins [start, end[ of fData
 
   private:
     UInt_t fAlphaBetaTag; ///< \f$ 1 \to \alpha = \beta = 1\f$; \f$ 2 \to \alpha \neq 1, \beta = 1\f$; \f$ 3 \to \alpha = 1, \beta \neq 1\f$; \f$ 4 \to \alpha \neq 1, \beta \neq 1\f$.
@@ -79,6 +81,7 @@ class PRunAsymmetryRRF : public PRunBase
     Int_t fEndTimeBin;      ///< bin at which the fit ends
 
     Bool_t SubtractFixBkg();
+    void GetAlphaBeta(const std::vector<Double_t>& par, Double_t &a, Double_t &b);
     Bool_t SubtractEstimatedBkg();
 
     virtual Bool_t GetProperT0(PRawRunData* runData, PMsrGlobalBlock *globalBlock, PUIntVector &forwardHisto, PUIntVector &backwardHistoNo);
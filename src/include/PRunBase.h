@@ -30,15 +30,77 @@
 #ifndef _PRUNBASE_H_
 #define _PRUNBASE_H_
 
+#include <string>
 #include <vector>
 
 #include <TString.h>
+#include <TRandom.h>
 
 #include "PMusr.h"
 #include "PMsrHandler.h"
 #include "PRunDataHandler.h"
 #include "PTheory.h"
 
+#define PERF_THEORY_SAMPLING 100 ///< the theory time of a run is sampled every PERF_THEORY_SAMPLING-th evaluation (musrfit --perf-report)
+
+#define PRUN_RESAMPLE_MC   0 ///< replica drawn around the theory of the best fit: Poisson for counting data, Gaussian otherwise
+#define PRUN_RESAMPLE_BINS 1 ///< replica from the theory of the best fit plus the normalized residuals of randomly drawn bins
+
+//------------------------------------------------------------------------------------------
+/**
+ * <p>Cumulative (prefix sum) representation of a grouped histogram. It is built once in O(n),
+ * afterwards the sum over any bin interval, i.e. a packed bin, a data range, or a background range,
+ * is O(1). Accumulation is done in long double in order to keep the differences of large partial
+ * sums accurate.
+ */
+class PCumulativeHisto
+{
+  public:
+    PCumulativeHisto() {}
+    PCumulativeHisto(const PDoubleVector &histo, const Bool_t squared=false) { Set(histo, squared); }
+    virtual ~PCumulativeHisto() {}
+
+    virtual void Set(const PDoubleVector &histo, const Bool_t squared=false);
+    virtual void Clear() { fCumSum.clear(); } ///< releases the cumulative sums
+    virtual UInt_t GetNoOfBins() const { return (fCumSum.size() > 0) ? fCumSum.size()-1 : 0; } ///< returns the number of bins of the underlying histogram
+    virtual Double_t GetSum(Int_t start, Int_t end) const;
+    virtual Double_t GetPackedBin(const Int_t start, const Int_t packing, const UInt_t idx) const
+                       { return GetSum(start+static_cast<Int_t>(idx)*packing, start+static_cast<Int_t>(idx+1)*packing); } ///< returns the sum of the idx-th packed bin starting at start
+
+  private:
+    std::vector<long double> fCumSum; ///< fCumSum[i] = sum of the first i bins
+};
+
+//------------------------------------------------------------------------------------------
+/**
+ * <p>Values of the functions of the FUNCTIONS block which neither use maps nor meta data. They are
+ * the same for every run block and are therefore evaluated only once per parameter set and shared by
+ * all runs of a PRunListCollection. Only functions which are requested by at least one run are evaluated.
+ *
+ * <p>The cache is mutable and not locked, and the evaluation writes into the parsed functions of the
+ * msr-file handler (PFunction::Eval). Hence an instance must only be used by one thread at a time.
+ * Concurrent evaluations (e.g. PFitterWorker) need their own PRunListCollection, which owns its own
+ * instance, and their own msr-file handler.
+ */
+class PRunSharedFuncValues
+{
+  public:
+    PRunSharedFuncValues(PMsrHandler *msrInfo);
+    virtual ~PRunSharedFuncValues() {}
+
+    virtual Bool_t IsShared(const UInt_t idx) const { return (idx < fShared.size()) ? fShared[idx] : false; } ///< true if the function with index idx is run block independent
+    virtual void Request(const UInt_t idx);
+    virtual const PDoubleVector& GetValues(const std::vector<Double_t>& par);
+
+  private:
+    PMsrHandler *fMsrInfo;       ///< msr-file handler
+    PBoolVector fShared;         ///< flags of the run block independent functions, indexed by the function index
+    std::vector<UInt_t> fRequested; ///< indices of the shared functions requested by at least one run
+    PDoubleVector fPar;          ///< parameters of the last evaluation
+    Bool_t fEvaluated;           ///< true if fValues belong to fPar
+    PDoubleVector fValues;       ///< function values, indexed by the function index
+};
+
 //------------------------------------------------------------------------------------------
 /**
  * <p>The run base class is enforcing a common interface to all supported fit-types.
@@ -52,7 +114,9 @@ class PRunBase
 
     virtual Double_t CalcChiSquare(const std::vector<Double_t>& par) = 0; ///< pure virtual, i.e. needs to be implemented by the deriving class!!
     virtual Double_t CalcMaxLikelihood(const std::vector<Double_t>& par) = 0; ///< pure virtual, i.e. needs to be implemented by the deriving class!!
+    virtual void CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals) = 0; ///< pure virtual, i.e. needs to be implemented by the deriving class!!
     virtual void SetFitRange(PDoublePairVector fitRange);
+    virtual PDoublePair GetFitRange() { return PDoublePair(fFitStartTime, fFitEndTime); } ///< returns the fit range (start, end) in time
 
     virtual void CalcTheory() = 0; ///< pure virtual, i.e. needs to be implemented by the deriving class!!
 
@@ -60,6 +124,14 @@ class PRunBase
     virtual PRunData* GetData() { return &fData; } ///< returns the data to be fitted
     virtual void CleanUp();
     virtual Bool_t IsValid() { return fValid; } ///< returns if the state is valid
+    virtual Bool_t IsTheoryReentrant() const { return (fTheory == nullptr) || fTheory->IsReentrant(); } ///< true if independent instances of the theory can be evaluated concurrently
+    virtual void SetSharedFuncValues(PRunSharedFuncValues *shared);
+
+    virtual const std::string& GetPerfEvalKey() const { return fPerfEvalKey; } ///< returns the performance report section of the chisq/maxLH evaluation of this run
+    virtual void SampleTheoryTime(const std::vector<Double_t>& par);
+
+    virtual void ResampleData(const std::vector<Double_t>& par, const UInt_t mode, TRandom &rnd);
+    virtual void RestoreData();
 
   protected:
     Bool_t fValid; ///< flag showing if the state of the class is valid
@@ -81,11 +153,36 @@ class PRunBase
     Double_t fFitEndTime;       ///< fit end time
 
     PDoubleVector fFuncValues;  ///< is keeping the values of the functions from the FUNCTIONS block
+    std::vector<UInt_t> fRunFuncIdx;    ///< indices of the functions used by the theory which have to be evaluated for this run
+    std::vector<UInt_t> fSharedFuncIdx; ///< indices of the functions used by the theory which are taken from fSharedFuncValues
+    PRunSharedFuncValues *fSharedFuncValues; ///< run block independent function values (not owned)
+    PDoubleVector fTheoryTime;  ///< times of the fit range handed to the user functions, see PrepareTheory
     PTheory *fTheory;           ///< theory needed to calculate chi-square
 
     PDoubleVector fKaiserFilter; ///< stores the Kaiser filter vector (needed for the RRF).
 
+    PDoubleVector fOrigValue; ///< original data values while a resampled replica is fitted (see ResampleData)
+    PDoubleVector fOrigError; ///< original data errors while a resampled replica is fitted (see ResampleData)
+
+    std::string fPerfFuncKey;    ///< performance report section: evaluation of the FUNCTIONS block
+    std::string fPerfPrepareKey; ///< performance report section: theory preparation (user function batches)
+    std::string fPerfTheoryKey;  ///< performance report section: sampled evaluation of the theory
+    std::string fPerfEvalKey;    ///< performance report section: complete chisq/maxLH evaluation
+    UInt_t fPerfNoOfEvals;       ///< number of evaluations since the theory time was sampled the last time
+
+    virtual void InitPerfKeys();
+
     virtual Bool_t PrepareData() = 0; ///< pure virtual, i.e. needs to be implemented by the deriving class!!
+    virtual void GetFitBinRange(Int_t &start, Int_t &end) = 0; ///< pure virtual, i.e. needs to be implemented by the deriving class!!
+    virtual Double_t GetCountsNormalizer() { return 0.0; } ///< data = counts/normalizer for counting data, 0 if the data are no counts (asymmetries, non-muSR)
+
+    virtual void CalcFuncValues(const std::vector<Double_t>& par);
+    virtual void PrepareTheory(const std::vector<Double_t>& par, const Int_t startBin, const Int_t endBin);
+
+    virtual UInt_t GetNoOfPackedBins(const Int_t start, const Int_t end, const Int_t packing);
+    virtual void PackHisto(const PDoubleVector &histo, const PDoubleVector &histoErr, const PCumulativeHisto &cumHisto,
+                           const PCumulativeHisto &cumErr2, const Int_t start, const Int_t end, const Int_t packing,
+                           PRunData &packed);
 
     virtual void CalculateKaiserFilterCoeff(Double_t wc, Double_t A, Double_t dw);
     virtual void FilterTheo();
@@ -59,8 +59,10 @@ class PRunDataHandler
     virtual PRawRunData* GetRunData(const TString &runName);
     virtual PRawRunData* GetRunData(const UInt_t idx=0);
     virtual Int_t GetNoOfRunData() {return fData.size(); }
+    virtual Bool_t IsHeaderOnly() const { return fHeaderOnly; }
 
     virtual Bool_t SetRunData(PRawRunData *data, UInt_t idx=0);
+    virtual void SetHeaderOnly(const Bool_t flag) { fHeaderOnly = flag; }
 
   private:
     PMsrHandler   *fMsrInfo; ///< pointer to the msr-file handler
@@ -68,6 +70,7 @@ class PRunDataHandler
     PStringVector fDataPath; ///< vector containing all the search paths where to look for data files
 
     Bool_t fAllDataAvailable; ///< flag indicating if all data sets could be read
+    Bool_t fHeaderOnly;       ///< flag indicating that only the run header (meta data, t0's, good bins) shall be read, but no histograms
     TString fFileFormat;      ///< keeps the file format if explicitly given
     TString fRunName;         ///< current run name
     TString fRunPathName;     ///< current path file name
@@ -76,6 +79,7 @@ class PRunDataHandler
     virtual void Init(const Int_t tag=0);
     virtual Bool_t ReadFilesMsr();
     virtual Bool_t ReadWriteFilesList();
+    virtual Bool_t ReadWriteRun(const Bool_t fileNameList, const UInt_t idx, const Int_t inTag, const Int_t outTag);
     virtual Bool_t FileAlreadyRead(TString runName);
     virtual void TestFileName(TString &runName, const TString &ext);
     virtual Bool_t FileExistsCheck(PMsrRunBlock &runInfo, const UInt_t idx);
@@ -58,6 +58,11 @@ class PRunListCollection
 
     virtual void SetFitRange(const PDoublePairVector fitRange);
     virtual void SetFitRange(const TString fitRange);
+    virtual PDoublePairVector GetFitRange() const;
+
+    virtual void ResampleData(const std::vector<Double_t>& par, const UInt_t mode, TRandom &rnd);
+    virtual void RestoreData();
+    virtual Bool_t IsTheoryReentrant() const;
 
     virtual Double_t GetSingleHistoChisq(const std::vector<Double_t>& par) const;
     virtual Double_t GetSingleHistoRRFChisq(const std::vector<Double_t>& par) const;
@@ -69,6 +74,7 @@ class PRunListCollection
 
     virtual Double_t GetSingleRunChisqExpected(const std::vector<Double_t>& par, const UInt_t idx) const;
     virtual Double_t GetSingleRunChisq(const std::vector<Double_t>& par, const UInt_t idx) const;
+    virtual void GetSingleRunResiduals(const std::vector<Double_t>& par, const UInt_t idx, PDoubleVector& residuals) const;
 
     virtual Double_t GetSingleHistoMaximumLikelihood(const std::vector<Double_t>& par) const;
     virtual Double_t GetSingleHistoRRFMaximumLikelihood(const std::vector<Double_t>& par) const;
@@ -100,6 +106,8 @@ class PRunListCollection
     virtual PRunData* GetMuMinus(UInt_t index, EDataSwitch tag=kIndex);
     virtual PRunData* GetNonMusr(UInt_t index, EDataSwitch tag=kIndex);
 
+    virtual PRunDataHandler* GetDataHandler() { return fData; } ///< returns the run-data handler
+
     virtual const PDoublePairVector *GetTemp(const TString &runName) const;
     virtual Double_t GetField(const TString &runName) const;
     virtual Double_t GetEnergy(const TString &runName) const;
@@ -111,6 +119,7 @@ class PRunListCollection
     Bool_t fTheoAsData;     ///< if true: calculate theory points only at the data points
     PMsrHandler *fMsrInfo;  ///< pointer to the msr-file handler
     PRunDataHandler *fData; ///< pointer to the run-data handler
+    PRunSharedFuncValues *fSharedFuncValues; ///< run block independent function values, shared by all runs of this collection (single thread only)
 
     std::vector<PRunSingleHisto*>    fRunSingleHistoList;    ///< stores all processed single histogram data
     std::vector<PRunSingleHistoRRF*> fRunSingleHistoRRFList; ///< stores all processed single histogram RRF data
@@ -119,6 +128,8 @@ class PRunListCollection
     std::vector<PRunAsymmetryBNMR*>  fRunAsymmetryBNMRList;  ///< stores all processed asymmetry BNMR data
     std::vector<PRunMuMinus*>        fRunMuMinusList;        ///< stores all processed mu-minus data
     std::vector<PRunNonMusr*>        fRunNonMusrList;        ///< stores all processed non-muSR data
+
+    Double_t EvalRun(PRunBase *run, const std::vector<Double_t>& par, const Bool_t chisq) const;
 };
 
 #endif // _PRUNLISTCOLLECTION_H_
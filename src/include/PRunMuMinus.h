@@ -43,6 +43,7 @@ class PRunMuMinus : public PRunBase
     virtual ~PRunMuMinus();
 
     virtual Double_t CalcChiSquare(const std::vector<Double_t>& par);
+    virtual void CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals);
     virtual Double_t CalcChiSquareExpected(const std::vector<Double_t>& par);
     virtual Double_t CalcMaxLikelihood(const std::vector<Double_t>& par);
     virtual void CalcTheory();
@@ -54,6 +55,7 @@ class PRunMuMinus : public PRunBase
     virtual Int_t GetStartTimeBin() { return fStartTimeBin; }
     virtual Int_t GetEndTimeBin() { return fEndTimeBin; }
     virtual Int_t GetPacking() { return fPacking; }
+    virtual const PCumulativeHisto& GetCumulativeForward() const { return fForwardCum; } ///< returns the cumulative form of the grouped forward histo, e.g. for O(1) sums over bin ranges
 
     virtual void CalcNoOfFitBins();
 
@@ -61,6 +63,8 @@ class PRunMuMinus : public PRunBase
     virtual Bool_t PrepareData();
     virtual Bool_t PrepareFitData(PRawRunData* runData, const UInt_t histoNo);
     virtual Bool_t PrepareRawViewData(PRawRunData* runData, const UInt_t histoNo);
+    virtual void GetFitBinRange(Int_t &start, Int_t &end) { start = fStartTimeBin; end = fEndTimeBin; } ///< returns the fitted bins [start, end[ of fData
+    virtual Double_t GetCountsNormalizer() { return 1.0; } ///< the data are counts
 
   private:
     UInt_t fNoOfFitBins;    ///< number of bins to be fitted
@@ -70,6 +74,7 @@ class PRunMuMinus : public PRunBase
     Int_t fGoodBins[2];     ///< keep first/last good bins. 0=fgb, 1=lgb
 
     PDoubleVector fForward; ///< forward histo data
+    PCumulativeHisto fForwardCum; ///< cumulative form of fForward, built once fForward is final
 
     Int_t fStartTimeBin;    ///< bin at which the fit starts
     Int_t fEndTimeBin;      ///< bin at which the fit ends
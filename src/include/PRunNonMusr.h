@@ -44,6 +44,7 @@ class PRunNonMusr : public PRunBase
     virtual ~PRunNonMusr();
 
     virtual Double_t CalcChiSquare(const std::vector<Double_t>& par);
+    virtual void CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals);
     virtual Double_t CalcChiSquareExpected(const std::vector<Double_t>& par);
     virtual Double_t CalcMaxLikelihood(const std::vector<Double_t>& par);
     virtual void CalcTheory();
@@ -59,6 +60,7 @@ class PRunNonMusr : public PRunBase
     virtual Bool_t PrepareData();
     virtual Bool_t PrepareFitData();
     virtual Bool_t PrepareViewData();
+    virtual void GetFitBinRange(Int_t &start, Int_t &end) { start = fStartTimeBin; end = fEndTimeBin+1; } ///< returns the fitted bins [start, end[ of fData
 
   private:
     PRawRunData *fRawRunData; ///< raw run data handler
@@ -43,6 +43,7 @@ class PRunSingleHisto : public PRunBase
     virtual ~PRunSingleHisto();
 
     virtual Double_t CalcChiSquare(const std::vector<Double_t>& par);
+    virtual void CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals);
     virtual Double_t CalcChiSquareExpected(const std::vector<Double_t>& par);
     virtual Double_t CalcMaxLikelihood(const std::vector<Double_t>& par);
     virtual Double_t CalcMaxLikelihoodExpected(const std::vector<Double_t>& par);
@@ -58,6 +59,7 @@ class PRunSingleHisto : public PRunBase
     virtual Int_t GetEndTimeBin() { return fEndTimeBin; }
     virtual Int_t GetPacking() { return fPacking; }
     virtual Bool_t GetScaleN0AndBkg() { return fScaleN0AndBkg; }
+    virtual const PCumulativeHisto& GetCumulativeForward() const { return fForwardCum; } ///< returns the cumulative form of the grouped forward histo, e.g. for O(1) sums over bin ranges
 
     virtual void CalcNoOfFitBins();
 
@@ -66,6 +68,8 @@ class PRunSingleHisto : public PRunBase
     virtual Bool_t PrepareFitData(PRawRunData* runData, const UInt_t histoNo);
     virtual Bool_t PrepareRawViewData(PRawRunData* runData, const UInt_t histoNo);
     virtual Bool_t PrepareViewData(PRawRunData* runData, const UInt_t histoNo);
+    virtual void GetFitBinRange(Int_t &start, Int_t &end) { start = fStartTimeBin; end = fEndTimeBin; } ///< returns the fitted bins [start, end[ of fData
+    virtual Double_t GetCountsNormalizer() { return fScaleN0AndBkg ? fPacking * (fTimeResolution * 1.0e3) : 1.0; } ///< data = counts/normalizer, see PrepareFitData
 
   private:
     Bool_t fScaleN0AndBkg;  ///< true=scale N0 and background to 1/ns, otherwise 1/bin
@@ -77,10 +81,12 @@ class PRunSingleHisto : public PRunBase
     Int_t fGoodBins[2];     ///< keep first/last good bins. 0=fgb, 1=lgb
 
     PDoubleVector fForward; ///< forward histo data
+    PCumulativeHisto fForwardCum; ///< cumulative form of fForward, built once fForward is final
 
     Int_t fStartTimeBin;    ///< bin at which the fit starts
     Int_t fEndTimeBin;      ///< bin at which the fit ends
 
+    virtual void GetN0TauBkg(const std::vector<Double_t>& par, Double_t &N0, Double_t &tau, Double_t &bkg);
     virtual Bool_t GetProperT0(PRawRunData* runData, PMsrGlobalBlock *globalBlock, PUIntVector &histoNo);
     virtual Bool_t GetProperDataRange();
     virtual void GetProperFitRange(PMsrGlobalBlock *globalBlock);
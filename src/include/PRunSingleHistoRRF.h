@@ -43,6 +43,7 @@ class PRunSingleHistoRRF : public PRunBase
     virtual ~PRunSingleHistoRRF();
 
     virtual Double_t CalcChiSquare(const std::vector<Double_t>& par);
+    virtual void CalcResiduals(const std::vector<Double_t>& par, PDoubleVector& residuals);
     virtual Double_t CalcChiSquareExpected(const std::vector<Double_t>& par);
     virtual Double_t CalcMaxLikelihood(const std::vector<Double_t>& par);
     virtual void CalcTheory();
@@ -60,6 +61,7 @@ class PRunSingleHistoRRF : public PRunBase
     virtual Bool_t PrepareData();
     virtual Bool_t PrepareFitData(PRawRunData* runData, const UInt_t histoNo);
     virtual Bool_t PrepareViewData(PRawRunData* runData, const UInt_t histoNo);
+    virtual void GetFitBinRange(Int_t &start, Int_t &end) { start = fStartTimeBin; end = fEndTimeBin; } ///< returns the fitted bins [start, end[ of fData
 
   private:
     Double_t fN0EstimateEndTime; ///< end time in (us) over which N0 is estimated.
@@ -30,6 +30,8 @@
 #ifndef _PTHEORY_H_
 #define _PTHEORY_H_
 
+#include <string>
+
 #include <TSystem.h>
 #include <TString.h>
 
@@ -241,6 +243,9 @@ class PTheory
 
     virtual Bool_t IsValid();
     virtual Double_t Func(Double_t t, const PDoubleVector& paramValues, const PDoubleVector& funcValues) const;
+    virtual void Prepare(const PDoubleVector& t, const PDoubleVector& paramValues, const PDoubleVector& funcValues) const;
+    virtual void GetUsedFuncs(PBoolVector& used) const;
+    virtual Bool_t IsReentrant() const;
 
   private:
     virtual void CleanUp(PTheory *theo);
@@ -298,6 +303,7 @@ class PTheory
     TString fUserFcnClassName; ///< name of the user function class for within root
     TString fUserFcnSharedLibName; ///< name of the shared lib to which the user function belongs
     PUserFcnBase *fUserFcn;    ///< pointer to the user function object
+    std::string fPerfPrepareKey; ///< performance report section of the user function preparation
     mutable PDoubleVector fUserParam;  ///< vector holding the resolved user function parameters, i.e. map and function resolved.
 
     PMsrHandler *fMsrInfo; ///< pointer to the msr-file handler
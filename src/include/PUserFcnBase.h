@@ -48,8 +48,10 @@ class PUserFcnBase : public TObject
     virtual Bool_t NeedGlobalPart() const { return false; } ///< if a user function needs a global part this function should return true, otherwise false (default: false)
     virtual void SetGlobalPart(std::vector<void *> &globalPart, UInt_t idx) {} ///< if a user function is using a global part, this function is used to invoke and retrieve the proper global object
     virtual Bool_t GlobalPartIsValid() const { return false; } ///< if a user function is using a global part, this function returns if the global object part is valid (default: false)
+    virtual Bool_t IsReentrant() const { return false; } ///< a user function should return true if different instances of it can be evaluated concurrently, i.e. it keeps its state (caches etc.) in the instance only and uses neither static nor global data (default: false)
 
     virtual Double_t operator()(Double_t t, const std::vector<Double_t> &param) const = 0;
+    virtual void Prepare(const std::vector<Double_t> &t, const std::vector<Double_t> &param) const {} ///< called with all x-values of a non-muSR run, resp. the times of the fit range of all other fit types, before the function is evaluated at them, e.g. to calculate them in one batch (default: nothing to be done)
 
   ClassDef(PUserFcnBase, 1)
 };
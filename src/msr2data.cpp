@@ -42,6 +42,7 @@
 
 #include "PMusr.h"
 #include "PMsr2Data.h"
+#include "PPerfMonitor.h"
 
 #include <algorithm>
 #include <sstream>
@@ -127,6 +128,8 @@ void msr2data_syntax()
   std::cout << std::endl << "       -t, --title-from-data-file : if fitting is used, pass the option --title-from-data-file to musrfit";
   std::cout << std::endl << "       -e, --estimateN0: estimate N0 for single histogram fits.";
   std::cout << std::endl << "       -p, --per-run-block-chisq: will per run block chisq to the msr-file.";
+  std::cout << std::endl << "       --trace : records the timeline of the run jobs in msr2data.trace.json (Chrome trace-event";
+  std::cout << std::endl << "              format) and, if fitting is used, passes the option --trace to musrfit";
   std::cout << std::endl;
   std::cout << std::endl << "       global : switch on the global-fit mode";
   std::cout << std::endl << "              Within that mode all specified runs will be united in a single msr file!";
@@ -221,6 +224,7 @@ std::string msr2data_validArguments(const std::vector<std::string> &arg)
       || (!iter->compare("-t")) || (!iter->compare("--title-from-data-file")) \
       || (!iter->compare("-e")) || (!iter->compare("--estimateN0")) \
       || (!iter->compare("-p")) || (!iter->compare("--per-run-block-chisq")) \
+      || (!iter->compare("--trace")) \
       || (!iter->compare("data")) || (!iter->substr(0,4).compare("msr-")) || (!iter->compare("global")) \
       || (!iter->compare("global+")) || (!iter->compare("global+!")) || (!iter->compare("new")) \
       || !iter->compare("paramList") )
@@ -269,7 +273,7 @@ std::string msr2data_outputfile(std::vector<std::string> &arg, bool db = true)
       if (!iter->compare("-o")) {
         if ((iterNext != arg.end()) && (iterNext->compare("header")) && (iterNext->compare("noheader")) && (iterNext->compare("nosummary")) \
             && (iterNext->substr(0,3).compare("fit")) && (iterNext->compare("-k")) && (iterNext->compare("-t")) \
-            && (iterNext->compare("-e")) && (iterNext->compare("-p")) \
+            && (iterNext->compare("-e")) && (iterNext->compare("-p")) && (iterNext->compare("--trace")) \
             && (iterNext->compare("data")) && (iterNext->substr(0,3).compare("msr")) && (iterNext->compare("global")) \
             && (iterNext->compare("global+")) && (iterNext->compare("global+!")) && (iterNext->compare("new"))) {
           outputFile = *iterNext;
@@ -687,6 +691,10 @@ int main(int argc, char *argv[])
   // check if the output format is DB or data
   bool db(msr2data_useOption(arg, "data"));
 
+  // check if the timeline of the run jobs should be recorded
+  if (!msr2data_useOption(arg, "--trace"))
+    PPerfMonitor::SetTracing(true);
+
   // check the arguments for the "-o" option and set the output filename
   std::string outputFile(msr2data_outputfile(arg, db));
 
@@ -762,6 +770,8 @@ int main(int argc, char *argv[])
       musrfitOptions.append("-e ");
     if (!msr2data_useOption(arg, "-p") || !msr2data_useOption(arg, "--per-run-block-chisq"))
       musrfitOptions.append("-p ");
+    if (PPerfMonitor::IsTracing())
+      musrfitOptions.append("--trace ");
   }
 
   // if no fitting should be done, check if only the input files should be created
@@ -893,6 +903,8 @@ int main(int argc, char *argv[])
         std::ostringstream oss;
         oss << path << "musrfit" << " " << strInfile.str() << " " << musrfitOptions;
         std::cout << std::endl << ">> msr2data: **INFO** Calling " << oss.str() << std::endl;
+        static const std::string perfKey("job/global/fit");
+        PPerfTimer perfTimer(perfKey);
         if (system(oss.str().c_str()) == -1) {
           std::cerr << "**ERROR** cmd: " << oss.str().c_str() << " failed." << std::endl;
         }
@@ -945,6 +957,13 @@ int main(int argc, char *argv[])
       strInfile.str("");
       strInfile << msr2dataHandler->GetPresentRun() << msrExtension << ".msr";
 
+      // timeline of the run job: msr-file preparation, fit, output
+      std::string perfKey;
+      if (PPerfMonitor::IsTracing())
+        perfKey = "job/" + std::to_string(msr2dataHandler->GetPresentRun());
+      const std::string perfKeyFit(perfKey + "/fit"), perfKeyOutput(perfKey + "/output");
+      PPerfTimer perfTimer(perfKey);
+
       // if fitting should be done, prepare a new input file
       if (temp) {
         if (temp > 0) {
@@ -984,6 +1003,7 @@ int main(int argc, char *argv[])
           std::ostringstream oss;
           oss << path << "musrfit" << " " << strInfile.str() << " " << musrfitOptions;
           std::cout << std::endl << ">> msr2data: **INFO** Calling " << oss.str() << std::endl;
+          PPerfTimer perfTimerFit(perfKeyFit);
           if (system(oss.str().c_str()) == -1) {
             std::cerr << "**ERROR** cmd: " << oss.str().c_str() << " failed." << std::endl;
           }
@@ -1006,6 +1026,7 @@ int main(int argc, char *argv[])
       }
 
       // read data files
+      PPerfTimer perfTimerOutput(perfKeyOutput);
       if (writeSummary)
         status = msr2dataHandler->ReadRunDataFile();
 
@@ -1054,6 +1075,11 @@ int main(int argc, char *argv[])
 
   msr2data_cleanup(msr2dataHandler, arg);
 
+  if (PPerfMonitor::IsTracing()) {
+    if (PPerfMonitor::GetInstance()->WriteTrace("msr2data.trace.json", "msr2data"))
+      std::cout << std::endl << ">> msr2data: **INFO** timeline written to msr2data.trace.json" << std::endl;
+  }
+
   std::cout << std::endl << ">> msr2data: done ..." << std::endl;
 
   return 1;
@@ -0,0 +1,790 @@
+/***************************************************************************
+
+  musrFakeData.cpp
+
+  Author: Andreas Suter
+  e-mail: andreas.suter@psi.ch
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2007-2023 by Andreas Suter                              *
+ *   andreas.suter@psi.ch                                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef HAVE_GOMP
+#include <omp.h>
+#endif
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <TDatime.h>
+#include <TRandom3.h>
+#include <TString.h>
+
+#ifdef HAVE_GIT_REV_H
+#include "git-revision.h"
+#endif
+
+#include "PMusr.h"
+#include "PMsrHandler.h"
+#include "PRunDataHandler.h"
+#include "PTheory.h"
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Settings of musrFakeData.
+ */
+struct PFakeDataConfig {
+  TString fTemplateFileName; ///< template msr-file with the model
+  TString fOutDir;           ///< output directory
+  TString fPrefix;           ///< prefix of all generated file names
+  UInt_t fNoOfRuns;          ///< number of runs
+  UInt_t fNoOfDetectors;     ///< number of detectors (histograms) per run
+  UInt_t fNoOfBins;          ///< number of bins after t0
+  Int_t fT0;                 ///< t0 bin; the bins before t0 only contain background
+  Int_t fFirstRunNo;         ///< run number of the first run
+  Double_t fTimeResolution;  ///< time resolution (ns); <= 0 means 10 us / fNoOfBins
+  Double_t fN0;              ///< counts/ns at t0 of a detector with efficiency 1
+  Double_t fBkg;             ///< background counts/ns of a detector with efficiency 1
+  Double_t fEffSpread;       ///< relative spread of the detector efficiencies
+  Double_t fField;           ///< field (G), as given in the run header
+  Double_t fEnergy;          ///< implantation energy (keV), as given in the run header
+  Double_t fTempStart;       ///< temperature (K) of the first run
+  Double_t fTempEnd;         ///< temperature (K) of the last run; the runs are linearly spaced in between
+  UInt_t fPacking;           ///< packing of the generated msr-files
+  UInt_t fSeed;              ///< seed of the random numbers
+  UInt_t fThreads;           ///< number of threads
+  Bool_t fSingleMsr;         ///< write a msr-file per run
+  Bool_t fGlobalMsr;         ///< write the global msr-file
+  Bool_t fVerbose;           ///< if false, the output of the file writer is suppressed
+};
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Model as given by the template msr-file.
+ */
+struct PFakeDataTemplate {
+  TString fTitle;            ///< msr-file title
+  PStringVector fParam;      ///< FITPARAMETER lines
+  PStringVector fTheory;     ///< THEORY lines
+  PStringVector fFunctions;  ///< FUNCTIONS lines
+};
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Detector specific true values: phase, N0 and background. The latter two are the same
+ * for all runs.
+ */
+struct PFakeDataDetector {
+  PDoubleVector fPhase; ///< phase (deg) of each detector
+  PDoubleVector fN0;    ///< N0 (1/ns) of each detector
+  PDoubleVector fBkg;   ///< background (1/ns) of each detector
+};
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Sends the usage description to the standard output.
+ */
+void musrFakeData_syntax()
+{
+  std::cout << std::endl << "usage: musrFakeData <template-msr> [-n <runs>] [-m <detectors>] [-k <bins>] [-o <dir>] [--prefix <str>]";
+  std::cout << std::endl << "                    [--res <ns>] [--t0 <bin>] [--n0 <val>] [--bkg <val>] [--eff-spread <val>]";
+  std::cout << std::endl << "                    [--field <G>] [--energy <keV>] [--temp <K>] [--temp-end <K>] [--first-run <no>]";
+  std::cout << std::endl << "                    [--packing <n>] [--seed <n>] [--no-single] [--no-global] [-u <threads>]";
+  std::cout << std::endl << "                    [--verbose] | --help | --version";
+  std::cout << std::endl;
+  std::cout << std::endl << "       Generates synthetic MusrRoot files with Poisson distributed multi-detector histograms,";
+  std::cout << std::endl << "          N_d(t) = N0_d exp(-t/tau) [1 + P_d(t)] + Bkg_d,";
+  std::cout << std::endl << "       where the polarization P_d(t) is given by the THEORY block of the template msr-file,";
+  std::cout << std::endl << "       together with a matching msr-file for every run and a global msr-file for all runs.";
+  std::cout << std::endl << "       The data only depend on the seed and the run, not on the number of threads.";
+  std::cout << std::endl;
+  std::cout << std::endl << "       <template-msr>: provides the FITPARAMETER block (true values), the THEORY block, and";
+  std::cout << std::endl << "          optionally the FUNCTIONS block. All other blocks are ignored. The detector phase (deg)";
+  std::cout << std::endl << "          is available as map1. FUNCTIONS may use the temperature T0 and the field B. Example:";
+  std::cout << std::endl << "             FITPARAMETER";
+  std::cout << std::endl << "                     1 Asym        0.2      0.01     none";
+  std::cout << std::endl << "                     2 Rate        0.3      0.01     none";
+  std::cout << std::endl << "                     3 Field       100      0.1      none";
+  std::cout << std::endl << "             THEORY";
+  std::cout << std::endl << "             asymmetry 1";
+  std::cout << std::endl << "             simplExpo 2";
+  std::cout << std::endl << "             TFieldCos map1 fun1";
+  std::cout << std::endl << "             FUNCTIONS";
+  std::cout << std::endl << "             fun1 = gamma_mu * par3";
+  std::cout << std::endl;
+  std::cout << std::endl << "       -n <runs>: number of runs. Default: 1";
+  std::cout << std::endl << "       -m <detectors>: number of detectors per run. Their phases are equally spaced. Default: 4";
+  std::cout << std::endl << "       -k <bins>: number of bins after t0. Default: 8192";
+  std::cout << std::endl << "       -o <dir>: output directory. Default: current directory";
+  std::cout << std::endl << "       --prefix <str>: prefix of the file names: <prefix>_<run>.root, <prefix>_<run>.msr,";
+  std::cout << std::endl << "          <prefix>_global.msr. Default: fake";
+  std::cout << std::endl << "       --res <ns>: time resolution. Default: 10 us / <bins>";
+  std::cout << std::endl << "       --t0 <bin>: t0 bin. Default: 200";
+  std::cout << std::endl << "       --n0 <val>: counts/ns at t0 per detector. Default: 500";
+  std::cout << std::endl << "       --bkg <val>: background counts/ns per detector. Default: 1";
+  std::cout << std::endl << "       --eff-spread <val>: relative spread of the detector efficiencies. Default: 0.05";
+  std::cout << std::endl << "       --field <G>, --energy <keV>: run header values. Default: 100 G, undefined";
+  std::cout << std::endl << "       --temp <K>, --temp-end <K>: temperature of the first and the last run. Default: 10 K for all runs";
+  std::cout << std::endl << "       --first-run <no>: run number of the first run. Default: 1";
+  std::cout << std::endl << "       --packing <n>: packing of the generated msr-files. Default: 1";
+  std::cout << std::endl << "       --seed <n>: seed of the random numbers. Default: 1";
+  std::cout << std::endl << "       --no-single, --no-global: do not write the msr-files per run, resp. the global msr-file.";
+  std::cout << std::endl << "       -u, --use-no-of-threads <threads>: number of threads. Default: all cores.";
+  std::cout << std::endl << "       --verbose: show the output of the file writer.";
+  std::cout << std::endl << "       -v, --version: will show the current version.";
+  std::cout << std::endl << std::endl;
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Derives the seed of a random number generator from the global seed and a stream index,
+ * such that neighbouring seeds and streams give unrelated sequences (splitmix64 finalizer).
+ *
+ * <p><b>return:</b> seed, never 0 since TRandom3 would then be seeded from the clock
+ *
+ * \param seed global seed
+ * \param stream stream index, e.g. run index + 1
+ */
+UInt_t musrFakeData_seed(const UInt_t seed, const UInt_t stream)
+{
+  ULong64_t z = (static_cast<ULong64_t>(seed) << 32) + stream + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z ^= (z >> 31);
+  UInt_t result = static_cast<UInt_t>(z);
+  return (result == 0) ? 1 : result;
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Reads the FITPARAMETER, THEORY and FUNCTIONS blocks of the template msr-file.
+ *
+ * <p><b>return:</b> true on success, false otherwise
+ *
+ * \param fileName template msr-file name
+ * \param tmpl model (output)
+ */
+Bool_t musrFakeData_read_template(const TString &fileName, PFakeDataTemplate &tmpl)
+{
+  std::ifstream fin(fileName.Data());
+  if (!fin.is_open()) {
+    std::cerr << std::endl << ">> musrFakeData: **ERROR** couldn't open the template msr-file '" << fileName << "'." << std::endl;
+    return false;
+  }
+
+  enum { kNone, kParam, kTheory, kFunctions } block = kNone;
+  const char *blockTag[] = {"FITPARAMETER", "THEORY", "FUNCTIONS", "GLOBAL", "RUN", "COMMANDS", "FOURIER", "PLOT", "STATISTIC"};
+
+  std::string line;
+  Bool_t first = true;
+  while (std::getline(fin, line)) {
+    TString str(line.c_str());
+    str.ReplaceAll("\r", "");
+    if (first) { // the first line of a msr-file is the title
+      tmpl.fTitle = str.Strip(TString::kBoth);
+      first = false;
+      continue;
+    }
+
+    Bool_t isTag = false;
+    for (UInt_t i=0; i<sizeof(blockTag)/sizeof(blockTag[0]); i++) {
+      if (str.BeginsWith(blockTag[i])) {
+        isTag = true;
+        if (i == 0)
+          block = kParam;
+        else if (i == 1)
+          block = kTheory;
+        else if (i == 2)
+          block = kFunctions;
+        else
+          block = kNone;
+        break;
+      }
+    }
+    if (isTag)
+      continue;
+
+    TString stripped = str.Strip(TString::kBoth);
+    if (stripped.IsNull() || stripped.BeginsWith("#"))
+      continue;
+
+    switch (block) {
+      case kParam:
+        tmpl.fParam.push_back(str);
+        break;
+      case kTheory:
+        tmpl.fTheory.push_back(str);
+        break;
+      case kFunctions:
+        tmpl.fFunctions.push_back(str);
+        break;
+      default:
+        break;
+    }
+  }
+  fin.close();
+
+  // check the parameter numbering, since the detector parameters are appended
+  for (UInt_t i=0; i<tmpl.fParam.size(); i++) {
+    Int_t no = -1;
+    if ((sscanf(tmpl.fParam[i].Data(), "%d", &no) != 1) || (no != static_cast<Int_t>(i)+1)) {
+      std::cerr << std::endl << ">> musrFakeData: **ERROR** parameter " << i+1 << " of the template is not numbered consecutively:";
+      std::cerr << std::endl << ">>   " << tmpl.fParam[i] << std::endl;
+      return false;
+    }
+  }
+
+  if (tmpl.fTheory.empty()) {
+    std::cerr << std::endl << ">> musrFakeData: **ERROR** no THEORY block found in '" << fileName << "'." << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns the run name (as used in the RUN blocks) of a run.
+ *
+ * \param config settings
+ * \param run run index
+ */
+TString musrFakeData_run_name(const PFakeDataConfig &config, const UInt_t run)
+{
+  return TString::Format("%s_%04d", config.fPrefix.Data(), config.fFirstRunNo+static_cast<Int_t>(run));
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Writes a msr-file for the runs [firstRun, firstRun+noOfRuns[. The parameters are: the template
+ * parameters, the detector phases (shared by all runs), and N0 and background of each run and detector.
+ *
+ * <p><b>return:</b> true on success, false otherwise
+ *
+ * \param config settings
+ * \param tmpl model
+ * \param det detector specific true values
+ * \param timeRes time resolution (ns)
+ * \param fileName msr-file name
+ * \param firstRun index of the first run
+ * \param noOfRuns number of runs
+ */
+Bool_t musrFakeData_write_msr(const PFakeDataConfig &config, const PFakeDataTemplate &tmpl, const PFakeDataDetector &det,
+                              const Double_t timeRes, const TString &fileName, const UInt_t firstRun, const UInt_t noOfRuns)
+{
+  std::ofstream fout(fileName.Data());
+  if (!fout.is_open()) {
+    std::cerr << std::endl << ">> musrFakeData: **ERROR** couldn't write '" << fileName << "'." << std::endl;
+    return false;
+  }
+
+  const TString sep("###############################################################");
+  const UInt_t noOfParam = tmpl.fParam.size();
+  const UInt_t noOfDet = config.fNoOfDetectors;
+  const Double_t tEnd = std::floor(1.0e4*(config.fNoOfBins-1)*timeRes*1.0e-3)/1.0e4; // (us)
+
+  fout << tmpl.fTitle << std::endl;
+  fout << sep << std::endl;
+  fout << "FITPARAMETER" << std::endl;
+  fout << "#      Nr. Name        Value     Step      Pos_Error  Boundaries" << std::endl;
+  for (UInt_t i=0; i<noOfParam; i++)
+    fout << tmpl.fParam[i] << std::endl;
+  for (UInt_t d=0; d<noOfDet; d++)
+    fout << TString::Format("%10d %-11s %-12.6g %-12.6g none", noOfParam+d+1, TString::Format("Phase_%d", d+1).Data(), det.fPhase[d], 1.0) << std::endl;
+  for (UInt_t r=0; r<noOfRuns; r++) {
+    Int_t runNo = config.fFirstRunNo+static_cast<Int_t>(firstRun+r);
+    for (UInt_t d=0; d<noOfDet; d++) {
+      UInt_t no = noOfParam + noOfDet + 2*(r*noOfDet+d) + 1;
+      fout << TString::Format("%10d %-11s %-12.6g %-12.6g none", no, TString::Format("N0_%d_%d", runNo, d+1).Data(), det.fN0[d], 0.01*det.fN0[d]) << std::endl;
+      fout << TString::Format("%10d %-11s %-12.6g %-12.6g none", no+1, TString::Format("Bkg_%d_%d", runNo, d+1).Data(), det.fBkg[d], 0.01*det.fBkg[d]) << std::endl;
+    }
+  }
+
+  fout << std::endl << sep << std::endl;
+  fout << "THEORY" << std::endl;
+  for (UInt_t i=0; i<tmpl.fTheory.size(); i++)
+    fout << tmpl.fTheory[i] << std::endl;
+
+  if (!tmpl.fFunctions.empty()) {
+    fout << std::endl << sep << std::endl;
+    fout << "FUNCTIONS" << std::endl;
+    for (UInt_t i=0; i<tmpl.fFunctions.size(); i++)
+      fout << tmpl.fFunctions[i] << std::endl;
+  }
+
+  fout << std::endl << sep << std::endl;
+  fout << "GLOBAL" << std::endl;
+  fout << "fittype         0         (single histogram fit)" << std::endl;
+  fout << TString::Format("fit             0.0   %g", tEnd) << std::endl;
+  fout << "packing         " << config.fPacking << std::endl;
+
+  for (UInt_t r=0; r<noOfRuns; r++) {
+    for (UInt_t d=0; d<noOfDet; d++) {
+      UInt_t no = noOfParam + noOfDet + 2*(r*noOfDet+d) + 1;
+      fout << std::endl << sep << std::endl;
+      fout << "RUN " << musrFakeData_run_name(config, firstRun+r) << " FAKE PSI MUSR-ROOT   (name beamline institute data-file-format)" << std::endl;
+      fout << "norm            " << no << std::endl;
+      fout << "backgr.fit      " << no+1 << std::endl;
+      fout << TString::Format("map          %5d    0    0    0    0    0    0    0    0    0", noOfParam+d+1) << std::endl;
+      fout << "forward         " << d+1 << std::endl;
+      fout << "data            " << config.fT0 << "   " << config.fT0+static_cast<Int_t>(config.fNoOfBins)-1 << std::endl;
+      fout << "t0              " << config.fT0 << ".0" << std::endl;
+    }
+  }
+
+  fout << std::endl << sep << std::endl;
+  fout << "COMMANDS" << std::endl;
+  fout << "MINIMIZE" << std::endl;
+  fout << "HESSE" << std::endl;
+
+  fout << std::endl << sep << std::endl;
+  fout << "PLOT 0   (single histo plot)" << std::endl;
+  fout << "runs    ";
+  for (UInt_t d=0; (d<noOfDet) && (d<16); d++)
+    fout << " " << d+1;
+  fout << std::endl;
+  fout << TString::Format("range    0.0   %g", tEnd) << std::endl;
+
+  fout << std::endl << sep << std::endl;
+  fout << "STATISTIC --- " << TDatime().AsSQLString() << std::endl;
+
+  fout.close();
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Calculates the polarization of every detector for the given meta data.
+ *
+ * \param msrHandler msr-file handler of the model msr-file, whose i-th RUN block is detector i
+ * \param theory theory of every detector
+ * \param par parameters
+ * \param metaData meta data of the run (field, energy, temperature)
+ * \param time time grid (us)
+ * \param pol polarization of every detector (output)
+ */
+void musrFakeData_polarization(PMsrHandler &msrHandler, std::vector<PTheory*> &theory, const PDoubleVector &par,
+                               const PMetaData &metaData, const PDoubleVector &time, std::vector<PDoubleVector> &pol)
+{
+  pol.resize(theory.size());
+  PDoubleVector funcValues(msrHandler.GetNoOfFuncs());
+  for (UInt_t d=0; d<theory.size(); d++) {
+    PIntVector *map = msrHandler.GetMsrRunList()->at(d).GetMap();
+    for (UInt_t i=0; i<funcValues.size(); i++)
+      funcValues[i] = msrHandler.EvalFunc(msrHandler.GetFuncNo(i), *map, par, metaData);
+
+    theory[d]->Prepare(time, par, funcValues);
+    pol[d].resize(time.size());
+    for (UInt_t i=0; i<time.size(); i++)
+      pol[d][i] = theory[d]->Func(time[i], par, funcValues);
+  }
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Generates the Poisson distributed histograms of a run.
+ *
+ * \param config settings
+ * \param tmpl model
+ * \param det detector specific true values
+ * \param pol polarization of every detector
+ * \param timeRes time resolution (ns)
+ * \param run run index
+ * \param temp temperature (K)
+ * \param runData raw run data (output)
+ */
+void musrFakeData_run(const PFakeDataConfig &config, const PFakeDataTemplate &tmpl, const PFakeDataDetector &det,
+                      const std::vector<PDoubleVector> &pol, const Double_t timeRes, const UInt_t run, const Double_t temp,
+                      PRawRunData &runData)
+{
+  TRandom3 rand(musrFakeData_seed(config.fSeed, run+1));
+
+  runData.SetRunName(musrFakeData_run_name(config, run));
+  runData.SetRunNumber(config.fFirstRunNo+static_cast<Int_t>(run));
+  runData.SetRunTitle(tmpl.fTitle);
+  runData.SetGenerator("musrFakeData");
+  runData.SetFileName(musrFakeData_run_name(config, run) + ".root");
+  runData.SetSetup(TString::Format("musrFakeData, %d detectors, seed %d", config.fNoOfDetectors, config.fSeed));
+  runData.SetBeamline("FAKE");
+  runData.SetField(config.fField);
+  runData.SetEnergy(config.fEnergy);
+  runData.SetTemperature(0, temp, 0.0);
+  runData.SetTimeResolution(timeRes);
+
+  const UInt_t length = static_cast<UInt_t>(config.fT0) + config.fNoOfBins;
+  for (UInt_t d=0; d<config.fNoOfDetectors; d++) {
+    PDoubleVector data(length);
+    for (UInt_t i=0; i<length; i++) {
+      Double_t mean = det.fBkg[d];
+      if (i >= static_cast<UInt_t>(config.fT0)) {
+        const UInt_t j = i - static_cast<UInt_t>(config.fT0);
+        const Double_t t = static_cast<Double_t>(j)*timeRes*1.0e-3; // (us)
+        mean += det.fN0[d]*std::exp(-t/PMUON_LIFETIME)*(1.0+pol[d][j]);
+      }
+      mean *= timeRes;
+      data[i] = (mean > 0.0) ? static_cast<Double_t>(rand.Poisson(mean)) : 0.0;
+    }
+
+    PRawRunDataSet dataSet;
+    dataSet.SetName(TString::Format("Detector%03d", d+1));
+    dataSet.SetHistoNo(d+1);
+    dataSet.SetTimeZeroBin(config.fT0);
+    dataSet.SetTimeZeroBinEstimated(config.fT0);
+    dataSet.SetFirstGoodBin(config.fT0);
+    dataSet.SetLastGoodBin(static_cast<Int_t>(length)-1);
+    dataSet.SetData(data);
+    runData.SetDataSet(dataSet);
+  }
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Writes a run as MusrRoot file. Not thread safe (ROOT folders of gROOT are used).
+ *
+ * <p><b>return:</b> true on success, false otherwise
+ *
+ * \param config settings
+ * \param runData raw run data
+ * \param fileName MusrRoot file name
+ */
+Bool_t musrFakeData_write_run(const PFakeDataConfig &config, PRawRunData &runData, const TString &fileName)
+{
+  remove(fileName.Data()); // otherwise the writer would choose another file name
+
+  std::streambuf *coutBuf = nullptr;
+  if (!config.fVerbose)
+    coutBuf = std::cout.rdbuf(nullptr);
+
+  PAny2ManyInfo info;
+  info.outFormat = "musrroot";
+  info.outFileName = fileName;
+  PRunDataHandler dataHandler(&info);
+  Bool_t success = dataHandler.SetRunData(&runData);
+  if (success)
+    success = dataHandler.WriteData();
+
+  if (coutBuf != nullptr)
+    std::cout.rdbuf(coutBuf);
+
+  return success;
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Generates synthetic MusrRoot files and matching msr-files, see musrFakeData_syntax().
+ *
+ * <p>The theory is evaluated serially, since user functions are in general not thread safe,
+ * and only when the meta data (temperature) change. The Poisson histograms of the runs are
+ * generated in parallel, each run with its own random number generator seeded from the seed and
+ * the run, and the files are written one after the other.
+ *
+ * \param argc number of command line arguments
+ * \param argv command line arguments
+ */
+int main(int argc, char *argv[])
+{
+  PFakeDataConfig config;
+  config.fTemplateFileName = "";
+  config.fOutDir = ".";
+  config.fPrefix = "fake";
+  config.fNoOfRuns = 1;
+  config.fNoOfDetectors = 4;
+  config.fNoOfBins = 8192;
+  config.fT0 = 200;
+  config.fFirstRunNo = 1;
+  config.fTimeResolution = -1.0;
+  config.fN0 = 500.0;
+  config.fBkg = 1.0;
+  config.fEffSpread = 0.05;
+  config.fField = 100.0;
+  config.fEnergy = PMUSR_UNDEFINED;
+  config.fTempStart = 10.0;
+  config.fTempEnd = -1.0;
+  config.fPacking = 1;
+  config.fSeed = 1;
+  config.fThreads = 1;
+  config.fSingleMsr = true;
+  config.fGlobalMsr = true;
+  config.fVerbose = false;
+
+#ifdef HAVE_GOMP
+  config.fThreads = omp_get_num_procs();
+#endif
+
+  if (argc < 2) {
+    musrFakeData_syntax();
+    return PMUSR_WRONG_STARTUP_SYNTAX;
+  }
+
+  Int_t ival;
+  Double_t dval;
+  for (Int_t i=1; i<argc; i++) {
+    Bool_t hasArg = (i+1 < argc);
+    Bool_t intArg = hasArg && (sscanf(argv[i+1], "%d", &ival) == 1);
+    Bool_t dblArg = hasArg && (sscanf(argv[i+1], "%lf", &dval) == 1);
+    if (!strcmp(argv[i], "--help") || !strcmp(argv[i], "-h")) {
+      musrFakeData_syntax();
+      return PMUSR_SUCCESS;
+    } else if (!strcmp(argv[i], "--version") || !strcmp(argv[i], "-v")) {
+#ifdef HAVE_CONFIG_H
+#ifdef HAVE_GIT_REV_H
+      std::cout << std::endl << "musrFakeData version: " << PACKAGE_VERSION << ", git-branch: " << GIT_BRANCH << ", git-rev: " << GIT_CURRENT_SHA1 << " (" << BUILD_TYPE << "), ROOT version: " << ROOT_VERSION_USED << std::endl << std::endl;
+#else
+      std::cout << std::endl << "musrFakeData version: " << PACKAGE_VERSION << " (" << BUILD_TYPE << "), ROOT version: " << ROOT_VERSION_USED << std::endl << std::endl;
+#endif
+#else
+#ifdef HAVE_GIT_REV_H
+      std::cout << std::endl << "musrFakeData git-branch: " << GIT_BRANCH << ", git-rev: " << GIT_CURRENT_SHA1 << std::endl << std::endl;
+#else
+      std::cout << std::endl << "musrFakeData version: unknown" << std::endl << std::endl;
+#endif
+#endif
+      return PMUSR_SUCCESS;
+    } else if (!strcmp(argv[i], "-n") && intArg && (ival > 0)) {
+      config.fNoOfRuns = ival;
+      i++;
+    } else if (!strcmp(argv[i], "-m") && intArg && (ival > 0)) {
+      config.fNoOfDetectors = ival;
+      i++;
+    } else if (!strcmp(argv[i], "-k") && intArg && (ival > 0)) {
+      config.fNoOfBins = ival;
+      i++;
+    } else if (!strcmp(argv[i], "-o") && hasArg) {
+      config.fOutDir = argv[++i];
+    } else if (!strcmp(argv[i], "--prefix") && hasArg) {
+      config.fPrefix = argv[++i];
+    } else if (!strcmp(argv[i], "--res") && dblArg && (dval > 0.0)) {
+      config.fTimeResolution = dval;
+      i++;
+    } else if (!strcmp(argv[i], "--t0") && intArg && (ival > 0)) {
+      config.fT0 = ival;
+      i++;
+    } else if (!strcmp(argv[i], "--n0") && dblArg && (dval > 0.0)) {
+      config.fN0 = dval;
+      i++;
+    } else if (!strcmp(argv[i], "--bkg") && dblArg && (dval >= 0.0)) {
+      config.fBkg = dval;
+      i++;
+    } else if (!strcmp(argv[i], "--eff-spread") && dblArg && (dval >= 0.0) && (dval < 1.0)) {
+      config.fEffSpread = dval;
+      i++;
+    } else if (!strcmp(argv[i], "--field") && dblArg) {
+      config.fField = dval;
+      i++;
+    } else if (!strcmp(argv[i], "--energy") && dblArg) {
+      config.fEnergy = dval;
+      i++;
+    } else if (!strcmp(argv[i], "--temp") && dblArg) {
+      config.fTempStart = dval;
+      i++;
+    } else if (!strcmp(argv[i], "--temp-end") && dblArg) {
+      config.fTempEnd = dval;
+      i++;
+    } else if (!strcmp(argv[i], "--first-run") && intArg && (ival >= 0)) {
+      config.fFirstRunNo = ival;
+      i++;
+    } else if (!strcmp(argv[i], "--packing") && intArg && (ival > 0)) {
+      config.fPacking = ival;
+      i++;
+    } else if (!strcmp(argv[i], "--seed") && intArg && (ival >= 0)) {
+      config.fSeed = ival;
+      i++;
+    } else if (!strcmp(argv[i], "--no-single")) {
+      config.fSingleMsr = false;
+    } else if (!strcmp(argv[i], "--no-global")) {
+      config.fGlobalMsr = false;
+    } else if (!strcmp(argv[i], "--verbose")) {
+      config.fVerbose = true;
+    } else if ((!strcmp(argv[i], "-u") || !strcmp(argv[i], "--use-no-of-threads")) && intArg && (ival > 0)) {
+      config.fThreads = ival;
+      i++;
+    } else if ((argv[i][0] != '-') && config.fTemplateFileName.IsNull()) {
+      config.fTemplateFileName = argv[i];
+    } else {
+      std::cerr << std::endl << ">> musrFakeData: **ERROR** unknown or incomplete option '" << argv[i] << "'." << std::endl;
+      musrFakeData_syntax();
+      return PMUSR_WRONG_STARTUP_SYNTAX;
+    }
+  }
+
+  if (config.fTemplateFileName.IsNull()) {
+    std::cerr << std::endl << ">> musrFakeData: **ERROR** no template msr-file given." << std::endl;
+    musrFakeData_syntax();
+    return PMUSR_WRONG_STARTUP_SYNTAX;
+  }
+  if (config.fTempEnd < 0.0)
+    config.fTempEnd = config.fTempStart;
+
+#ifdef HAVE_GOMP
+  omp_set_num_threads(config.fThreads);
+#else
+  config.fThreads = 1;
+#endif
+
+  auto start = std::chrono::steady_clock::now();
+
+  PFakeDataTemplate tmpl;
+  if (!musrFakeData_read_template(config.fTemplateFileName, tmpl))
+    return PMUSR_MSR_FILE_NOT_FOUND;
+
+  if ((mkdir(config.fOutDir.Data(), 0755) != 0) && (errno != EEXIST)) {
+    std::cerr << std::endl << ">> musrFakeData: **ERROR** couldn't create the output directory '" << config.fOutDir << "'." << std::endl;
+    return PMUSR_MSR_FILE_WRITE_ERROR;
+  }
+  if (!config.fOutDir.EndsWith("/"))
+    config.fOutDir += "/";
+
+  const Double_t timeRes = (config.fTimeResolution > 0.0) ? config.fTimeResolution : 1.0e4/static_cast<Double_t>(config.fNoOfBins); // (ns)
+
+  // detector specific true values: equally spaced phases, and efficiencies drawn from the seed
+  PFakeDataDetector det;
+  TRandom3 detRand(musrFakeData_seed(config.fSeed, 0));
+  for (UInt_t d=0; d<config.fNoOfDetectors; d++) {
+    Double_t eff = 1.0 + config.fEffSpread*detRand.Uniform(-1.0, 1.0);
+    det.fPhase.push_back(360.0*static_cast<Double_t>(d)/static_cast<Double_t>(config.fNoOfDetectors));
+    det.fN0.push_back(config.fN0*eff);
+    det.fBkg.push_back(config.fBkg*eff);
+  }
+
+  // msr-files
+  Bool_t ok = true;
+  if (config.fGlobalMsr)
+    ok = musrFakeData_write_msr(config, tmpl, det, timeRes, config.fOutDir + config.fPrefix + "_global.msr", 0, config.fNoOfRuns);
+  for (UInt_t r=0; (r<config.fNoOfRuns) && ok && config.fSingleMsr; r++)
+    ok = musrFakeData_write_msr(config, tmpl, det, timeRes, config.fOutDir + musrFakeData_run_name(config, r) + ".msr", r, 1);
+
+  // model: msr-file of the first run, i.e. RUN block d is detector d
+  TString modelFileName = config.fOutDir + musrFakeData_run_name(config, 0) + ".msr";
+  if (!config.fSingleMsr) {
+    modelFileName = config.fOutDir + config.fPrefix + "_model.msr";
+    ok &= musrFakeData_write_msr(config, tmpl, det, timeRes, modelFileName, 0, 1);
+  }
+  if (!ok)
+    return PMUSR_MSR_FILE_WRITE_ERROR;
+
+  PMsrHandler msrHandler(modelFileName.Data());
+  Int_t status = msrHandler.ReadMsrFile();
+  if (!config.fSingleMsr)
+    remove(modelFileName.Data());
+  if (status != PMUSR_SUCCESS) {
+    std::cerr << std::endl << ">> musrFakeData: **ERROR** the model generated from '" << config.fTemplateFileName << "' is not a valid msr-file." << std::endl;
+    return status;
+  }
+
+  std::vector<PTheory*> theory;
+  for (UInt_t d=0; (d<config.fNoOfDetectors) && ok; d++) {
+    theory.push_back(new PTheory(&msrHandler, d));
+    ok = theory.back()->IsValid();
+  }
+  if (!ok) {
+    std::cerr << std::endl << ">> musrFakeData: **ERROR** couldn't set up the THEORY of '" << config.fTemplateFileName << "'." << std::endl;
+    for (UInt_t d=0; d<theory.size(); d++)
+      delete theory[d];
+    return PMUSR_MSR_SYNTAX_ERROR;
+  }
+
+  PDoubleVector par;
+  for (UInt_t i=0; i<msrHandler.GetMsrParamList()->size(); i++)
+    par.push_back(msrHandler.GetMsrParamList()->at(i).fValue);
+
+  PDoubleVector time(config.fNoOfBins);
+  for (UInt_t i=0; i<time.size(); i++)
+    time[i] = static_cast<Double_t>(i)*timeRes*1.0e-3; // (us)
+
+  PMetaData metaData;
+  metaData.fField = config.fField;
+  metaData.fEnergy = config.fEnergy;
+
+  // runs, in blocks: serial theory evaluation, parallel histogram generation
+  const UInt_t blockSize = 4*config.fThreads;
+  std::vector<std::vector<PDoubleVector> > pol; // polarizations of the current block
+  PDoubleVector polTemp;                         // temperature of each polarization
+  std::vector<UInt_t> polIdx(blockSize);
+  Int_t failed = 0;
+  for (UInt_t blockStart=0; blockStart<config.fNoOfRuns; blockStart+=blockSize) {
+    const UInt_t blockEnd = (blockStart+blockSize < config.fNoOfRuns) ? blockStart+blockSize : config.fNoOfRuns;
+
+    // keep the last polarization, since the temperature often doesn't change
+    if (pol.size() > 1) {
+      pol.erase(pol.begin(), pol.end()-1);
+      polTemp.erase(polTemp.begin(), polTemp.end()-1);
+    }
+    for (UInt_t r=blockStart; r<blockEnd; r++) {
+      Double_t temp = config.fTempStart;
+      if (config.fNoOfRuns > 1)
+        temp += (config.fTempEnd-config.fTempStart)*static_cast<Double_t>(r)/static_cast<Double_t>(config.fNoOfRuns-1);
+      if (polTemp.empty() || (polTemp.back() != temp)) {
+        metaData.fTemp.assign(1, temp);
+        pol.push_back(std::vector<PDoubleVector>());
+        musrFakeData_polarization(msrHandler, theory, par, metaData, time, pol.back());
+        polTemp.push_back(temp);
+      }
+      polIdx[r-blockStart] = pol.size()-1;
+    }
+
+    Int_t r;
+    #ifdef HAVE_GOMP
+    #pragma omp parallel for default(shared) private(r) schedule(dynamic) reduction(+:failed)
+    #endif
+    for (r=static_cast<Int_t>(blockStart); r<static_cast<Int_t>(blockEnd); r++) {
+      const UInt_t idx = polIdx[r-blockStart];
+      PRawRunData runData;
+      musrFakeData_run(config, tmpl, det, pol[idx], timeRes, r, polTemp[idx], runData);
+      const TString fileName = config.fOutDir + musrFakeData_run_name(config, r) + ".root";
+      Bool_t written;
+      #ifdef HAVE_GOMP
+      #pragma omp critical(musrFakeData_write)
+      #endif
+      written = musrFakeData_write_run(config, runData, fileName);
+      if (!written) {
+        std::cerr << std::endl << ">> musrFakeData: **ERROR** couldn't write '" << fileName << "'." << std::endl;
+        failed++;
+      }
+    }
+  }
+
+  for (UInt_t d=0; d<theory.size(); d++)
+    delete theory[d];
+  theory.clear();
+
+  const Double_t sec = std::chrono::duration<Double_t>(std::chrono::steady_clock::now()-start).count();
+  std::cout << std::endl << ">> musrFakeData: " << config.fNoOfRuns << " runs x " << config.fNoOfDetectors << " detectors x ";
+  std::cout << config.fNoOfBins << " bins written to " << config.fOutDir << " in " << sec << " s (" << config.fThreads << " threads)";
+  if (failed > 0)
+    std::cout << ", " << failed << " files FAILED";
+  std::cout << std::endl << std::endl;
+
+  return (failed == 0) ? PMUSR_SUCCESS : PMUSR_MSR_FILE_WRITE_ERROR;
+}
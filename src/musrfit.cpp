@@ -44,6 +44,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <string>
 
 #include <TSAXParser.h>
 #include <TString.h>
@@ -64,6 +65,8 @@
 #include "PRunDataHandler.h"
 #include "PRunListCollection.h"
 #include "PFitter.h"
+#include "PFFTPlanManager.h"
+#include "PPerfMonitor.h"
 
 //--------------------------------------------------------------------------
 
@@ -95,7 +98,7 @@ void musrfit_syntax()
 {
   std::cout << std::endl << "usage: musrfit [<msr-file> [-k, --keep-mn2-ouput] [-c, --chisq-only] [-t, --title-from-data-file]";
   std::cout << std::endl << "                            [-e, --estimateN0] [-p, --per-run-block-chisq]";
-  std::cout << std::endl << "                            [--dump <type>] [--timeout <timeout_tag>] |";
+  std::cout << std::endl << "                            [--dump <type>] [--timeout <timeout_tag>] [--perf-report] [--trace] |";
   std::cout << std::endl << "                            -n, --no-of-cores-avail | -u, --use-no-of-threads <number> |";
   std::cout << std::endl << "                            --nexus-support | --show-dynamic-path | --version | --help";
   std::cout << std::endl << "       <msr-file>: msr input file";
@@ -125,6 +128,12 @@ void musrfit_syntax()
   std::cout << std::endl << "       --timeout <timeout_tag>: overwrites to predefined timeout of " << timeout << " (sec).";
   std::cout << std::endl << "              <timeout_tag> <= 0 means timeout facility is not enabled. <timeout_tag> = nn";
   std::cout << std::endl << "              will set the timeout to nn (sec).";
+  std::cout << std::endl << "       --perf-report: times the fit engine (FCN calls, FUNCTIONS, theory, user functions,";
+  std::cout << std::endl << "              chisq per run block, data loading, cache hit rates) and writes the";
+  std::cout << std::endl << "              report in JSON format to <msr-file>.perf.json, e.g. 147.msr -> 147.perf.json";
+  std::cout << std::endl << "       --trace: records the timeline of the fit (msr parsing, data files, run blocks,";
+  std::cout << std::endl << "              fitter commands, FCN calls per thread) and writes it in the Chrome trace-event";
+  std::cout << std::endl << "              format to <msr-file>.trace.json (view with https://ui.perfetto.dev)";
   std::cout << std::endl;
   std::cout << std::endl << "       At the end of a fit, musrfit writes the fit results into an <mlog-file> and";
   std::cout << std::endl << "       swaps them, i.e. in the <msr-file> you will find the fit results and in the";
@@ -455,6 +464,8 @@ int main(int argc, char *argv[])
   bool chisq_only = false;
   bool title_from_data_file = false;
   bool timeout_enabled = true;
+  bool perf_report = false;
+  bool trace = false;
   PStartupOptions startup_options;
   startup_options.writeExpectedChisq = false;
   startup_options.estimateN0 = false;  
@@ -581,6 +592,10 @@ int main(int argc, char *argv[])
         show_syntax = true;
         break;
       }
+    } else if (!strcmp(argv[i], "--perf-report")) {
+      perf_report = true;
+    } else if (!strcmp(argv[i], "--trace")) {
+      trace = true;
     } else if (!strcmp(argv[i], "--timeout")) {
       if (i<argc-1) {
         TString str(argv[i+1]);
@@ -628,6 +643,15 @@ int main(int argc, char *argv[])
     }
   }
 
+  // enable the performance monitor if wished
+  if (perf_report || trace) {
+    PPerfMonitor::SetEnabled(perf_report);
+    PPerfMonitor::SetTracing(trace);
+    PPerfMonitor::GetInstance()->Reset();
+    PPerfMonitor::GetInstance()->SetInfo("msr_file", filename);
+    PPerfMonitor::GetInstance()->SetInfo("threads", std::to_string(number_of_cores));
+  }
+
   // read startup file
   char startup_path_name[128];
   TSAXParser *saxParser = new TSAXParser();
@@ -670,6 +694,8 @@ int main(int argc, char *argv[])
 #ifdef HAVE_GOMP
   // set omp_set_num_threads
   omp_set_num_threads(number_of_cores);
+  // the FFTW planner (user functions, Fourier) follows the same number of threads
+  PFFTPlanManager::GetInstance()->SetNumberOfThreads(number_of_cores);
 #endif
 
   // read msr-file
@@ -822,6 +848,31 @@ int main(int argc, char *argv[])
     }
   }
 
+  // write the performance report
+  if (perf_report) {
+    PPerfMonitor::GetInstance()->SetInfo("fit_success", success ? "true" : "false");
+    // FFTW plan cache: hits/misses are counted by the plan manager itself, add the planning time
+    PFFTPlanManager *planManager = PFFTPlanManager::GetInstance();
+    if (planManager->GetNumberOfPlans() + planManager->GetNumberOfCacheHits() > 0) {
+      planManager->PrintStatistics();
+      PPerfMonitor::GetInstance()->SetInfo("fftw_planning_time", std::to_string(planManager->GetPlanningTime()));
+    }
+    TString fln = TString(filename);
+    char ext[32];
+    strcpy(ext, ".perf.json");
+    fln.ReplaceAll(".msr", 4, ext, strlen(ext));
+    if (PPerfMonitor::GetInstance()->WriteJson(fln.Data()))
+      std::cout << std::endl << ">> performance report written to " << fln.Data() << std::endl;
+  }
+  if (trace) {
+    TString fln = TString(filename);
+    char ext[32];
+    strcpy(ext, ".trace.json");
+    fln.ReplaceAll(".msr", 4, ext, strlen(ext));
+    if (PPerfMonitor::GetInstance()->WriteTrace(fln.Data(), "musrfit"))
+      std::cout << std::endl << ">> timeline written to " << fln.Data() << std::endl;
+  }
+
   // clean up
   if (th) {
     th->Delete();
@@ -0,0 +1,1337 @@
+/***************************************************************************
+
+  musrfit_bench.cpp
+
+  Author: Andreas Suter
+  e-mail: andreas.suter@psi.ch
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2007-2023 by Andreas Suter                              *
+ *   andreas.suter@psi.ch                                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifdef HAVE_GOMP
+#include <omp.h>
+#endif
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <TDatime.h>
+#include <TRandom3.h>
+#include <TString.h>
+
+#ifdef HAVE_GIT_REV_H
+#include "git-revision.h"
+#endif
+
+#include "PMusr.h"
+#include "PMsrHandler.h"
+#include "PRunDataHandler.h"
+#include "PRunListCollection.h"
+#include "PTheory.h"
+#include "PFitter.h"
+#include "PFFTPlanManager.h"
+
+#define BENCH_SCHEMA_VERSION 1
+
+#define BENCH_T0_BIN     200    // t0 bin of the synthetic histograms
+#define BENCH_BKG_START   20    // first background bin of the synthetic histograms
+#define BENCH_BKG_END    180    // last background bin of the synthetic histograms
+#define BENCH_TIME_RANGE 10.0   // time range (us) covered by the synthetic histograms
+#define BENCH_RRF_FREQ   12.0   // RRF frequency (MHz) of the RRF fits
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Size of a macro benchmark, i.e. a global single histogram fit.
+ */
+struct PBenchMacroSize {
+  UInt_t fRuns;       ///< number of runs (RUN blocks)
+  UInt_t fBins;       ///< number of bins per run
+  UInt_t fComponents; ///< number of precessing components, each adds 3 global parameters
+};
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Settings of a benchmark session.
+ */
+struct PBenchConfig {
+  std::string fJsonFileName; ///< name of the JSON result file
+  std::string fWorkDir;      ///< directory where the generated msr-files are written to
+  std::string fFilter;       ///< only benchmarks whose name contains this string are carried out
+  Double_t fMinTime;         ///< minimal time (sec) of a single repetition of a micro benchmark
+  UInt_t fRepeats;           ///< number of repetitions of a micro benchmark
+  UInt_t fBins;              ///< number of bins used for the micro benchmarks
+  UInt_t fSeed;              ///< seed of the synthetic data
+  UInt_t fThreads;           ///< number of threads
+  Bool_t fMicro;             ///< carry out the micro benchmarks
+  Bool_t fMacro;             ///< carry out the macro benchmarks
+  Bool_t fVerbose;           ///< if false, the standard output of musrfit classes is suppressed
+  std::vector<PBenchMacroSize> fMacroSize; ///< sizes of the macro benchmarks
+};
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Result of a single benchmark. The metrics are kept sorted by name, which makes
+ * the JSON output stable.
+ */
+struct PBenchResult {
+  std::string fGroup;  ///< benchmark group: theory, user_function, functions, fcn, fit
+  std::string fName;   ///< name of the benchmark within its group
+  std::string fStatus; ///< ok, skipped, or failed
+  std::string fNote;   ///< reason if skipped or failed
+  std::map<std::string, Double_t> fMetric; ///< measured quantities
+};
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Fit parameter of a generated msr-file.
+ */
+struct PBenchParam {
+  std::string fName; ///< parameter name
+  Double_t fValue;   ///< start value
+  Double_t fStep;    ///< step
+};
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Model of the synthetic histograms:
+ * N(t) = N0 exp(-t/tau) [1 + sum_k A_k exp(-lambda_k t) cos(2 pi f_k t + phase)] + Bkg
+ */
+struct PBenchModel {
+  Double_t fN0;    ///< counts/ns at t0
+  Double_t fBkg;   ///< background counts/ns
+  Double_t fPhase; ///< phase (deg) of the forward histogram. The backward histogram is shifted by 180 deg.
+  std::vector<Double_t> fAsym; ///< asymmetry of each component
+  std::vector<Double_t> fFreq; ///< frequency (MHz) of each component
+  std::vector<Double_t> fRate; ///< exponential relaxation rate (1/us) of each component
+};
+
+static volatile Double_t gBenchSink = 0.0; ///< keeps the compiler from optimizing away the benchmarked calculations
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Sends the usage description to the standard output.
+ */
+void musrfit_bench_syntax()
+{
+  std::cout << std::endl << "usage: musrfit_bench [--json <file>] [--work-dir <dir>] [--filter <str>] [--bins <n>]";
+  std::cout << std::endl << "                     [--repeats <n>] [--min-time <sec>] [--seed <n>] [--macro <runs>x<bins>x<comp>]";
+  std::cout << std::endl << "                     [--no-micro] [--no-macro] [--quick] [-u <threads>] [--verbose] | --help";
+  std::cout << std::endl;
+  std::cout << std::endl << "       Micro benchmarks: every THEORY function of PTheory, the main user functions, the FUNCTIONS";
+  std::cout << std::endl << "       evaluation, and chisq/max.likelihood of each fit type on synthetic data.";
+  std::cout << std::endl << "       Macro benchmarks: full global single histogram fits (MIGRAD + HESSE) of synthetic data";
+  std::cout << std::endl << "       sets of increasing size (runs x bins x parameters).";
+  std::cout << std::endl;
+  std::cout << std::endl << "       --json <file>: JSON result file. Default: musrfit_bench.json";
+  std::cout << std::endl << "       --work-dir <dir>: directory for the generated msr-files. Default: musrfit_bench_work";
+  std::cout << std::endl << "       --filter <str>: only run benchmarks whose name (<group>/<name>) contains <str>.";
+  std::cout << std::endl << "       --bins <n>: number of bins of the micro benchmarks. Default: 8192";
+  std::cout << std::endl << "       --repeats <n>: number of repetitions of a micro benchmark. Default: 5";
+  std::cout << std::endl << "       --min-time <sec>: minimal duration of one repetition of a micro benchmark. Default: 0.1";
+  std::cout << std::endl << "       --seed <n>: seed of the synthetic data. Default: 12345";
+  std::cout << std::endl << "       --macro <runs>x<bins>x<comp>: add a macro benchmark of the given size, where <comp> is the";
+  std::cout << std::endl << "              number of precessing components. Can be given multiple times and replaces the";
+  std::cout << std::endl << "              default sizes.";
+  std::cout << std::endl << "       --no-micro, --no-macro: skip the micro, resp. macro benchmarks.";
+  std::cout << std::endl << "       --quick: fewer repetitions and smaller macro benchmarks, e.g. for a smoke test.";
+  std::cout << std::endl << "       -u, --use-no-of-threads <threads>: number of threads (OpenMP). Default: all cores.";
+  std::cout << std::endl << "       --verbose: do not suppress the standard output of the fit engine.";
+  std::cout << std::endl << std::endl;
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Suppresses the standard output within its scope, unless verbose output is requested.
+ */
+class PBenchMute
+{
+  public:
+    PBenchMute(const Bool_t verbose) : fBuf(nullptr) { if (!verbose) fBuf = std::cout.rdbuf(nullptr); }
+    ~PBenchMute() { if (fBuf != nullptr) std::cout.rdbuf(fBuf); }
+
+  private:
+    std::streambuf *fBuf; ///< original buffer of std::cout
+};
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Checks if a benchmark is selected by the filter.
+ *
+ * \param config benchmark settings
+ * \param group benchmark group
+ * \param name benchmark name
+ */
+Bool_t musrfit_bench_selected(const PBenchConfig &config, const std::string &group, const std::string &name)
+{
+  if (config.fFilter.empty())
+    return true;
+  return ((group + "/" + name).find(config.fFilter) != std::string::npos);
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Times a calculation. The number of calls per repetition is chosen such that a repetition
+ * takes at least config.fMinTime. The per-call statistics are added as metrics (ns) to the result.
+ *
+ * \param config benchmark settings
+ * \param body calculation to be timed; its return value is accumulated to keep it from being optimized away
+ * \param result benchmark result
+ */
+void musrfit_bench_time(const PBenchConfig &config, const std::function<Double_t()> &body, PBenchResult &result)
+{
+  auto run = [&body](const ULong64_t calls) -> Double_t {
+    Double_t sum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (ULong64_t i=0; i<calls; i++)
+      sum += body();
+    auto end = std::chrono::steady_clock::now();
+    gBenchSink = gBenchSink + sum;
+    return std::chrono::duration<Double_t>(end-start).count();
+  };
+
+  // warm up and calibrate the number of calls per repetition
+  ULong64_t calls = 1;
+  Double_t sec = run(calls);
+  while (sec < config.fMinTime) {
+    if (sec < 0.1*config.fMinTime)
+      calls *= 10;
+    else
+      calls = static_cast<ULong64_t>(std::ceil(1.2*calls*config.fMinTime/sec));
+    sec = run(calls);
+  }
+
+  std::vector<Double_t> perCall;
+  for (UInt_t i=0; i<config.fRepeats; i++)
+    perCall.push_back(run(calls)*1.0e9/static_cast<Double_t>(calls));
+  std::sort(perCall.begin(), perCall.end());
+
+  Double_t mean = 0.0, var = 0.0;
+  for (UInt_t i=0; i<perCall.size(); i++)
+    mean += perCall[i];
+  mean /= perCall.size();
+  for (UInt_t i=0; i<perCall.size(); i++)
+    var += (perCall[i]-mean)*(perCall[i]-mean);
+  if (perCall.size() > 1)
+    var /= (perCall.size()-1);
+
+  Double_t median = perCall[perCall.size()/2];
+  if (perCall.size() % 2 == 0)
+    median = 0.5*(perCall[perCall.size()/2-1] + perCall[perCall.size()/2]);
+
+  result.fMetric["calls_per_repeat"] = static_cast<Double_t>(calls);
+  result.fMetric["repeats"] = static_cast<Double_t>(config.fRepeats);
+  result.fMetric["min_ns"] = perCall.front();
+  result.fMetric["max_ns"] = perCall.back();
+  result.fMetric["median_ns"] = median;
+  result.fMetric["mean_ns"] = mean;
+  result.fMetric["stddev_ns"] = std::sqrt(var);
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Writes a msr-file.
+ *
+ * <p><b>return:</b> true on success, false otherwise
+ *
+ * \param fileName msr-file name
+ * \param title title of the msr-file
+ * \param param fit parameters
+ * \param theory THEORY block body
+ * \param functions FUNCTIONS block body, may be empty
+ * \param global GLOBAL block body, may be empty
+ * \param run RUN blocks
+ * \param commands COMMANDS block body
+ */
+Bool_t musrfit_bench_write_msr(const std::string &fileName, const std::string &title, const std::vector<PBenchParam> &param,
+                               const std::string &theory, const std::string &functions, const std::string &global,
+                               const std::vector<std::string> &run, const std::string &commands)
+{
+  std::ofstream fout(fileName.c_str());
+  if (!fout.is_open())
+    return false;
+
+  const std::string sep("###############################################################");
+
+  fout << title << std::endl;
+  fout << sep << std::endl;
+  fout << "FITPARAMETER" << std::endl;
+  fout << "#      Nr. Name        Value     Step      Pos_Error  Boundaries" << std::endl;
+  for (UInt_t i=0; i<param.size(); i++) {
+    fout << TString::Format("%9d %-11s %-12.6g %-12.6g none", i+1, param[i].fName.c_str(), param[i].fValue, param[i].fStep).Data() << std::endl;
+  }
+  fout << std::endl << sep << std::endl;
+  fout << "THEORY" << std::endl << theory << std::endl;
+  if (!functions.empty()) {
+    fout << std::endl << sep << std::endl;
+    fout << "FUNCTIONS" << std::endl << functions << std::endl;
+  }
+  if (!global.empty()) {
+    fout << std::endl << sep << std::endl;
+    fout << "GLOBAL" << std::endl << global << std::endl;
+  }
+  for (UInt_t i=0; i<run.size(); i++) {
+    fout << std::endl << sep << std::endl;
+    fout << run[i] << std::endl;
+  }
+  fout << std::endl << sep << std::endl;
+  fout << "COMMANDS" << std::endl << commands << std::endl;
+  fout << std::endl << sep << std::endl;
+  fout << "STATISTIC --- " << TDatime().AsSQLString() << std::endl;
+
+  fout.close();
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Generates the raw data of a synthetic muSR run: Poisson distributed histograms
+ * following the model, with t0 at bin BENCH_T0_BIN and background only before t0.
+ * Odd histogram numbers are forward, even ones backward histograms.
+ *
+ * \param runName run name, as given in the RUN block
+ * \param noOfHistos number of histograms
+ * \param noOfBins number of bins after t0
+ * \param model signal model
+ * \param rand random number generator
+ * \param runData raw run data (output)
+ */
+void musrfit_bench_raw_data(const std::string &runName, const UInt_t noOfHistos, const UInt_t noOfBins,
+                            const PBenchModel &model, TRandom3 &rand, PRawRunData &runData)
+{
+  const Double_t timeRes = 1.0e3*BENCH_TIME_RANGE/static_cast<Double_t>(noOfBins); // (ns)
+
+  runData.SetRunName(runName.c_str());
+  runData.SetRunTitle("musrfit_bench synthetic data");
+  runData.SetField(PMUSR_UNDEFINED);
+  runData.SetEnergy(PMUSR_UNDEFINED);
+  runData.SetTimeResolution(timeRes);
+
+  for (UInt_t h=0; h<noOfHistos; h++) {
+    const Double_t phase = model.fPhase + ((h % 2 == 0) ? 0.0 : 180.0);
+    PDoubleVector data(BENCH_T0_BIN+noOfBins);
+    for (UInt_t i=0; i<data.size(); i++) {
+      Double_t mean = model.fBkg;
+      if (i >= BENCH_T0_BIN) {
+        const Double_t t = static_cast<Double_t>(i-BENCH_T0_BIN)*timeRes*1.0e-3; // (us)
+        Double_t pol = 0.0;
+        for (UInt_t k=0; k<model.fAsym.size(); k++)
+          pol += model.fAsym[k]*std::exp(-model.fRate[k]*t)*std::cos(TWO_PI*model.fFreq[k]*t+DEG_TO_RAD*phase);
+        mean += model.fN0*std::exp(-t/PMUON_LIFETIME)*(1.0+pol);
+      }
+      data[i] = static_cast<Double_t>(rand.Poisson(mean*timeRes));
+    }
+
+    PRawRunDataSet dataSet;
+    dataSet.SetName(TString::Format("hist%d", h+1));
+    dataSet.SetHistoNo(h+1);
+    dataSet.SetTimeZeroBin(BENCH_T0_BIN);
+    dataSet.SetTimeZeroBinEstimated(BENCH_T0_BIN);
+    dataSet.SetFirstGoodBin(BENCH_T0_BIN);
+    dataSet.SetLastGoodBin(BENCH_T0_BIN+noOfBins-1);
+    dataSet.SetData(data);
+    runData.SetDataSet(dataSet);
+  }
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Generates the raw data of a synthetic non-muSR run: y(x) = A exp(-lambda x) cos(2 pi f x + phase)
+ * with Gaussian noise.
+ *
+ * \param runName run name, as given in the RUN block
+ * \param noOfPoints number of data points
+ * \param model signal model; only the first component is used
+ * \param rand random number generator
+ * \param runData raw run data (output)
+ */
+void musrfit_bench_raw_data_non_musr(const std::string &runName, const UInt_t noOfPoints, const PBenchModel &model,
+                                     TRandom3 &rand, PRawRunData &runData)
+{
+  const Double_t sigma = 0.01;
+
+  runData.SetRunName(runName.c_str());
+  runData.SetRunTitle("musrfit_bench synthetic data");
+
+  PDoubleVector x(noOfPoints), y(noOfPoints), xErr(noOfPoints, 0.0), yErr(noOfPoints, sigma);
+  for (UInt_t i=0; i<noOfPoints; i++) {
+    x[i] = BENCH_TIME_RANGE*static_cast<Double_t>(i)/static_cast<Double_t>(noOfPoints);
+    y[i] = model.fAsym[0]*std::exp(-model.fRate[0]*x[i])*std::cos(TWO_PI*model.fFreq[0]*x[i]+DEG_TO_RAD*model.fPhase);
+    y[i] += rand.Gaus(0.0, sigma);
+  }
+
+  runData.fDataNonMusr.SetFromAscii(true);
+  runData.fDataNonMusr.AppendLabel("x");
+  runData.fDataNonMusr.AppendLabel("y");
+  runData.fDataNonMusr.AppendDataTag("x");
+  runData.fDataNonMusr.AppendDataTag("y");
+  runData.fDataNonMusr.AppendData(x);
+  runData.fDataNonMusr.AppendData(y);
+  runData.fDataNonMusr.AppendErrData(xErr);
+  runData.fDataNonMusr.AppendErrData(yErr);
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Default signal model of the micro benchmarks: one precessing component.
+ */
+PBenchModel musrfit_bench_model()
+{
+  PBenchModel model;
+  model.fN0 = 500.0;
+  model.fBkg = 5.0;
+  model.fPhase = 15.0;
+  model.fAsym.push_back(0.2);
+  model.fFreq.push_back(12.5);
+  model.fRate.push_back(0.3);
+  return model;
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Returns the parameters used for a built-in THEORY function.
+ *
+ * \param name name of the function as written into the msr-file
+ * \param noOfParam number of parameters of the function
+ */
+std::vector<Double_t> musrfit_bench_theory_param(const std::string &name, const UInt_t noOfParam)
+{
+  static const std::map<std::string, std::vector<Double_t> > value = {
+    {"const", {1.0}},
+    {"asymmetry", {0.2}},
+    {"simplExpo", {0.5}},
+    {"generExpo", {0.5, 1.5}},
+    {"simpleGss", {0.3}},
+    {"statGssKt", {0.3}},
+    {"statGssKTLF", {1.0, 0.3}},
+    {"dynGssKTLF", {1.0, 0.3, 0.5}},
+    {"statExpKT", {0.3}},
+    {"statExpKTLF", {1.0, 0.3}},
+    {"dynExpKTLF", {1.0, 0.3, 0.5}},
+    {"combiLGKT", {0.2, 0.3}},
+    {"strKT", {0.3, 1.5}},
+    {"spinGlass", {0.3, 0.5, 0.7}},
+    {"rdAnisoHf", {1.0, 0.3}},
+    {"abragam", {0.3, 0.5}},
+    {"TFieldCos", {15.0, 12.5}},
+    {"internFld", {0.7, 15.0, 12.5, 0.4, 0.1}},
+    {"internFldGK", {0.7, 12.5, 0.3, 0.1, 1.0}},
+    {"internFldLL", {0.7, 12.5, 0.3, 0.1, 1.0}},
+    {"bessel", {15.0, 12.5}},
+    {"internBsl", {0.7, 15.0, 12.5, 0.4, 0.1}},
+    {"skewedGss", {15.0, 12.5, 0.3, 0.4}},
+    {"staticNKZF", {0.3, 0.5}},
+    {"staticNKTF", {15.0, 12.5, 0.3, 0.5}},
+    {"dynamicNKZF", {0.3, 0.5, 1.0}},
+    {"dynamicNKTF", {15.0, 12.5, 0.3, 0.5, 1.0}},
+    {"muMinusExpTF", {1.0, PMUON_LIFETIME, 0.2, 0.3, 15.0, 12.5}},
+    {"polynom", {0.0, 1.0, -0.1, 0.01}} // tshift p0 p1 p2
+  };
+
+  std::vector<Double_t> param;
+  std::map<std::string, std::vector<Double_t> >::const_iterator iter = value.find(name);
+  if (iter != value.end())
+    param = iter->second;
+  if ((noOfParam > 0) && (param.size() > noOfParam))
+    param.resize(noOfParam);
+  while (param.size() < noOfParam)
+    param.push_back(0.5);
+
+  return param;
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Times a single theory (built-in function or user function) on an equidistant grid, the way
+ * a run block evaluates it: Prepare() followed by Func() for all points, serially.
+ * If requested, a second benchmark alternates between two parameter sets, which forces
+ * functions with tables or caches to recalculate them for every evaluation.
+ *
+ * \param config benchmark settings
+ * \param group benchmark group
+ * \param name benchmark name
+ * \param theoryLine THEORY block entry, with the function parameters numbered 1..n
+ * \param value function parameters
+ * \param xStart first point of the grid
+ * \param xEnd end of the grid
+ * \param noOfPoints number of grid points
+ * \param paramChange add the benchmark with changing parameters
+ * \param results benchmark results
+ */
+void musrfit_bench_theory_entry(const PBenchConfig &config, const std::string &group, const std::string &name,
+                                const std::string &theoryLine, const std::vector<Double_t> &value,
+                                const Double_t xStart, const Double_t xEnd, const UInt_t noOfPoints,
+                                const Bool_t paramChange, std::vector<PBenchResult> &results)
+{
+  std::vector<std::string> benchName;
+  if (musrfit_bench_selected(config, group, name))
+    benchName.push_back(name);
+  if (paramChange && musrfit_bench_selected(config, group, name + "/param_change"))
+    benchName.push_back(name + "/param_change");
+  if (benchName.empty())
+    return;
+
+  // msr-file: function parameters, followed by norm and background of the (unused) run block
+  std::vector<PBenchParam> param;
+  for (UInt_t i=0; i<value.size(); i++)
+    param.push_back({TString::Format("p%d", i+1).Data(), value[i], 0.01});
+  param.push_back({"N0", 500.0, 1.0});
+  param.push_back({"Bkg", 5.0, 0.1});
+
+  std::string run = TString::Format("RUN bench_theory BENCH PSI MUSR-ROOT   (name beamline institute data-file-format)\n"
+                                    "fittype         0         (single histogram fit)\n"
+                                    "norm            %d\nbackgr.fit      %d\nforward         1\n"
+                                    "data            %d   %d\nt0              %d.0\nfit             0   %g\npacking         1",
+                                    static_cast<Int_t>(value.size())+1, static_cast<Int_t>(value.size())+2,
+                                    BENCH_T0_BIN, BENCH_T0_BIN+noOfPoints-1, BENCH_T0_BIN, BENCH_TIME_RANGE).Data();
+
+  std::string fileName = config.fWorkDir + "/" + group + "_";
+  for (UInt_t i=0; i<name.size(); i++)
+    fileName += (name[i] == '/') ? '_' : name[i];
+  fileName += ".msr";
+
+  std::vector<PBenchResult> entry(benchName.size());
+  for (UInt_t i=0; i<benchName.size(); i++) {
+    entry[i].fGroup = group;
+    entry[i].fName = benchName[i];
+    entry[i].fStatus = "ok";
+  }
+
+  auto failed = [&](const std::string &status, const std::string &note) {
+    for (UInt_t i=0; i<entry.size(); i++) {
+      entry[i].fStatus = status;
+      entry[i].fNote = note;
+      results.push_back(entry[i]);
+    }
+  };
+
+  if (!musrfit_bench_write_msr(fileName, "musrfit_bench: " + group + "/" + name, param, theoryLine, "", "",
+                               std::vector<std::string>(1, run), "MINIMIZE")) {
+    failed("failed", "couldn't write " + fileName);
+    return;
+  }
+
+  PBenchMute mute(config.fVerbose);
+
+  PMsrHandler msrHandler(fileName.c_str());
+  if (msrHandler.ReadMsrFile() != PMUSR_SUCCESS) {
+    failed("failed", "couldn't read " + fileName);
+    return;
+  }
+
+  PTheory theory(&msrHandler, 0);
+  if (!theory.IsValid()) {
+    failed("skipped", "theory not available, e.g. user function library not built");
+    return;
+  }
+
+  PDoubleVector x(noOfPoints);
+  for (UInt_t i=0; i<noOfPoints; i++)
+    x[i] = xStart + (xEnd-xStart)*static_cast<Double_t>(i)/static_cast<Double_t>(noOfPoints);
+  PDoubleVector par(param.size());
+  for (UInt_t i=0; i<param.size(); i++)
+    par[i] = param[i].fValue;
+  PDoubleVector funcValues;
+
+  // alternative parameter set: last function parameter slightly changed
+  PDoubleVector parAlt(par);
+  if (!value.empty()) {
+    Double_t &pp = parAlt[value.size()-1];
+    pp = (pp == 0.0) ? 1.0e-6 : pp*(1.0+1.0e-6);
+  }
+
+  for (UInt_t i=0; i<entry.size(); i++) {
+    Bool_t change = (entry[i].fName != name);
+    ULong64_t count = 0;
+    auto body = [&]() -> Double_t {
+      const PDoubleVector &pp = (change && (++count % 2 == 1)) ? parAlt : par;
+      theory.Prepare(x, pp, funcValues);
+      Double_t sum = 0.0;
+      for (UInt_t j=0; j<x.size(); j++)
+        sum += theory.Func(x[j], pp, funcValues);
+      return sum;
+    };
+    musrfit_bench_time(config, body, entry[i]);
+    entry[i].fMetric["points"] = static_cast<Double_t>(noOfPoints);
+    entry[i].fMetric["ns_per_point"] = entry[i].fMetric["median_ns"]/static_cast<Double_t>(noOfPoints);
+    results.push_back(entry[i]);
+  }
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Micro benchmarks of all built-in THEORY functions of PTheory.
+ *
+ * \param config benchmark settings
+ * \param results benchmark results
+ */
+void musrfit_bench_theory(const PBenchConfig &config, std::vector<PBenchResult> &results)
+{
+  for (UInt_t i=0; i<THEORY_MAX; i++) {
+    if (fgTheoDataBase[i].fType == THEORY_USER_FCN) // see musrfit_bench_user_fcn()
+      continue;
+
+    std::string name(fgTheoDataBase[i].fName.Data());
+    std::vector<Double_t> value = musrfit_bench_theory_param(name, fgTheoDataBase[i].fNoOfParam);
+    std::string line(name);
+    for (UInt_t j=0; j<value.size(); j++)
+      line += TString::Format(" %d", j+1).Data();
+
+    musrfit_bench_theory_entry(config, "theory", name, line, value, 0.0, BENCH_TIME_RANGE, config.fBins,
+                               fgTheoDataBase[i].fTable, results);
+  }
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Micro benchmarks of the main user-function libraries. Functions whose library is not
+ * available are reported as skipped. The superconducting gap integrals are functions of the
+ * temperature and are sampled on a coarse temperature grid.
+ *
+ * \param config benchmark settings
+ * \param results benchmark results
+ */
+void musrfit_bench_user_fcn(const PBenchConfig &config, std::vector<PBenchResult> &results)
+{
+  struct PBenchUserFcn {
+    std::string fLib;   ///< library name
+    std::string fClass; ///< class name of the user function
+    std::vector<Double_t> fParam; ///< parameters
+    Double_t fXStart;   ///< first grid point
+    Double_t fXEnd;     ///< end of the grid
+    UInt_t fNoOfPoints; ///< number of grid points; 0 means config.fBins
+  };
+
+  const std::vector<PBenchUserFcn> userFcn = {
+    {"libLFRelaxation", "TLFStatGssKT", {1.0, 0.3}, 0.0, BENCH_TIME_RANGE, 0},
+    {"libLFRelaxation", "TLFStatExpKT", {1.0, 0.3}, 0.0, BENCH_TIME_RANGE, 0},
+    {"libLFRelaxation", "TLFDynGssKT", {1.0, 0.3, 0.5}, 0.0, BENCH_TIME_RANGE, 0},
+    {"libLFRelaxation", "TLFDynExpKT", {1.0, 0.3, 0.5}, 0.0, BENCH_TIME_RANGE, 0},
+    {"libZFRelaxation", "ZFMagGss", {0.7, 12.5, 0.5, 0.3}, 0.0, BENCH_TIME_RANGE, 0},
+    {"libZFRelaxation", "ZFMagExp", {0.7, 12.5, 0.5, 0.3}, 0.0, BENCH_TIME_RANGE, 0},
+    {"libZFRelaxation", "UniaxialStatGssKT", {0.3, 0.2, 30.0}, 0.0, BENCH_TIME_RANGE, 0},
+    {"libPGbGLF", "PGbGLF", {10.0, 0.3, 0.5}, 0.0, BENCH_TIME_RANGE, 0},
+    {"libPSpinValve", "PSkewedLorentzian", {100.0, 2.0, 1.5, 0.0}, 0.0, BENCH_TIME_RANGE, 0},
+    {"libGapIntegrals", "TGapSWave", {10.0, 1.5}, 0.1, 12.0, 64},
+    {"libGapIntegrals", "TGapDWave", {10.0, 2.0}, 0.1, 12.0, 64},
+    {"libGapIntegrals", "TLambdaSWave", {10.0, 1.5}, 0.1, 12.0, 64}
+  };
+
+  for (UInt_t i=0; i<userFcn.size(); i++) {
+    std::string line = "userFcn " + userFcn[i].fLib + " " + userFcn[i].fClass;
+    for (UInt_t j=0; j<userFcn[i].fParam.size(); j++)
+      line += TString::Format(" %d", j+1).Data();
+    UInt_t noOfPoints = (userFcn[i].fNoOfPoints == 0) ? config.fBins : userFcn[i].fNoOfPoints;
+
+    musrfit_bench_theory_entry(config, "user_function", userFcn[i].fLib + "/" + userFcn[i].fClass, line,
+                               userFcn[i].fParam, userFcn[i].fXStart, userFcn[i].fXEnd, noOfPoints, true, results);
+  }
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Micro benchmarks of the FUNCTIONS block evaluation (PFunction), single functions
+ * and the whole block.
+ *
+ * \param config benchmark settings
+ * \param results benchmark results
+ */
+void musrfit_bench_functions(const PBenchConfig &config, std::vector<PBenchResult> &results)
+{
+  const std::vector<std::string> function = {
+    "fun1 = par3 * (1.0 - par4)",
+    "fun2 = map1 * gamma_mu",
+    "fun3 = sqrt(par3*par3 + par4*par4) / (1.0 + par5)",
+    "fun4 = pow(par4, 0.5) * exp(-par5/par1) + cos(pi*par1/180.0)"
+  };
+
+  std::vector<std::string> benchName;
+  for (UInt_t i=0; i<function.size(); i++)
+    benchName.push_back(TString::Format("fun%d", i+1).Data());
+  benchName.push_back("all");
+
+  Bool_t any = false;
+  for (UInt_t i=0; i<benchName.size(); i++)
+    any |= musrfit_bench_selected(config, "functions", benchName[i]);
+  if (!any)
+    return;
+
+  std::vector<PBenchParam> param = {
+    {"Phase", 15.0, 1.0}, {"Field", 100.0, 0.1}, {"Asym", 0.2, 0.01}, {"Frac", 0.7, 0.01}, {"Rate", 0.3, 0.01},
+    {"N0", 500.0, 1.0}, {"Bkg", 5.0, 0.1}
+  };
+  std::string functions;
+  for (UInt_t i=0; i<function.size(); i++)
+    functions += function[i] + "\n";
+  std::string theory = "asymmetry fun1\nsimplExpo fun3\nTFieldCos 1 fun2\n+\nasymmetry fun4";
+  std::string run = TString::Format("RUN bench_functions BENCH PSI MUSR-ROOT   (name beamline institute data-file-format)\n"
+                                    "fittype         0         (single histogram fit)\n"
+                                    "norm            6\nbackgr.fit      7\nmap             2    0    0    0    0\nforward         1\n"
+                                    "data            %d   %d\nt0              %d.0\nfit             0   %g\npacking         1",
+                                    BENCH_T0_BIN, BENCH_T0_BIN+config.fBins-1, BENCH_T0_BIN, BENCH_TIME_RANGE).Data();
+  std::string fileName = config.fWorkDir + "/functions.msr";
+
+  PBenchResult entry;
+  entry.fGroup = "functions";
+  entry.fStatus = "ok";
+
+  if (!musrfit_bench_write_msr(fileName, "musrfit_bench: functions", param, theory, functions, "",
+                               std::vector<std::string>(1, run), "MINIMIZE")) {
+    entry.fName = "all";
+    entry.fStatus = "failed";
+    entry.fNote = "couldn't write " + fileName;
+    results.push_back(entry);
+    return;
+  }
+
+  PBenchMute mute(config.fVerbose);
+
+  PMsrHandler msrHandler(fileName.c_str());
+  if (msrHandler.ReadMsrFile() != PMUSR_SUCCESS) {
+    entry.fName = "all";
+    entry.fStatus = "failed";
+    entry.fNote = "couldn't read " + fileName;
+    results.push_back(entry);
+    return;
+  }
+
+  std::vector<Int_t> map = {2};
+  std::vector<Double_t> par(param.size());
+  for (UInt_t i=0; i<param.size(); i++)
+    par[i] = param[i].fValue;
+  PMetaData metaData;
+  metaData.fField = 100.0;
+  metaData.fEnergy = PMUSR_UNDEFINED;
+  metaData.fTemp.push_back(10.0);
+
+  const Int_t noOfFuncs = msrHandler.GetNoOfFuncs();
+  for (UInt_t i=0; i<benchName.size(); i++) {
+    if (!musrfit_bench_selected(config, "functions", benchName[i]))
+      continue;
+    entry.fName = benchName[i];
+    entry.fMetric.clear();
+    Int_t first = (i < function.size()) ? static_cast<Int_t>(i) : 0;
+    Int_t last = (i < function.size()) ? static_cast<Int_t>(i)+1 : noOfFuncs;
+    auto body = [&]() -> Double_t {
+      Double_t sum = 0.0;
+      for (Int_t j=first; j<last; j++)
+        sum += msrHandler.EvalFunc(msrHandler.GetFuncNo(j), map, par, metaData);
+      return sum;
+    };
+    musrfit_bench_time(config, body, entry);
+    entry.fMetric["functions"] = static_cast<Double_t>(last-first);
+    results.push_back(entry);
+  }
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Micro benchmarks of chisq and max. likelihood of each fit type, evaluated via the run list
+ * collection as the FCN does, on synthetic data of a single run. The run blocks are set up
+ * with the full PRunListCollection::Add() path, the data are handed over in memory.
+ *
+ * \param config benchmark settings
+ * \param results benchmark results
+ */
+void musrfit_bench_fcn(const PBenchConfig &config, std::vector<PBenchResult> &results)
+{
+  typedef Double_t (PRunListCollection::*PBenchFcn)(const std::vector<Double_t>&) const;
+
+  struct PBenchFitType {
+    std::string fName;  ///< name of the fit type
+    Int_t fFitType;     ///< fit type tag
+    PBenchFcn fChisq;   ///< chisq of the run list collection
+    PBenchFcn fMaxLH;   ///< max. likelihood of the run list collection, nullptr if not implemented
+  };
+
+  const std::vector<PBenchFitType> fitType = {
+    {"single_histo", MSR_FITTYPE_SINGLE_HISTO, &PRunListCollection::GetSingleHistoChisq, &PRunListCollection::GetSingleHistoMaximumLikelihood},
+    {"single_histo_rrf", MSR_FITTYPE_SINGLE_HISTO_RRF, &PRunListCollection::GetSingleHistoRRFChisq, nullptr},
+    {"asymmetry", MSR_FITTYPE_ASYM, &PRunListCollection::GetAsymmetryChisq, nullptr},
+    {"asymmetry_rrf", MSR_FITTYPE_ASYM_RRF, &PRunListCollection::GetAsymmetryRRFChisq, nullptr},
+    {"mu_minus", MSR_FITTYPE_MU_MINUS, &PRunListCollection::GetMuMinusChisq, &PRunListCollection::GetMuMinusMaximumLikelihood},
+    {"non_musr", MSR_FITTYPE_NON_MUSR, &PRunListCollection::GetNonMusrChisq, nullptr}
+  };
+
+  const PBenchModel model = musrfit_bench_model();
+  const Double_t timeRes = 1.0e3*BENCH_TIME_RANGE/static_cast<Double_t>(config.fBins); // (ns)
+
+  // common parameter set; every fit type uses its part of it
+  const std::vector<PBenchParam> param = {
+    {"Phase", model.fPhase, 1.0}, {"Freq", model.fFreq[0], 0.001}, {"Asym", model.fAsym[0], 0.01}, {"Rate", model.fRate[0], 0.01},
+    {"N0", model.fN0, 1.0}, {"Bkg", model.fBkg, 0.1}, {"Alpha", 1.0, 0.01},
+    {"N0_mm", model.fN0*timeRes, 1.0}, {"Tau_mm", PMUON_LIFETIME, 0.001}, {"Bkg_mm", model.fBkg*timeRes, 0.1}
+  };
+  const std::string theory("asymmetry 3\nsimplExpo 4\nTFieldCos 1 2");
+  const std::string theoryMuMinus("muMinusExpTF 8 9 3 4 1 2\n+\nasymmetry 10");
+
+  for (UInt_t i=0; i<fitType.size(); i++) {
+    std::vector<std::string> benchName;
+    if (musrfit_bench_selected(config, "fcn", fitType[i].fName + "/chisq"))
+      benchName.push_back("chisq");
+    if (musrfit_bench_selected(config, "fcn", fitType[i].fName + "/max_likelihood"))
+      benchName.push_back("max_likelihood");
+    if (benchName.empty())
+      continue;
+
+    const std::string runName = "bench_" + fitType[i].fName;
+    std::string global, run;
+    std::string runHeader = "RUN " + runName + " BENCH PSI MUSR-ROOT   (name beamline institute data-file-format)\n";
+    std::string data = TString::Format("data            %d   %d", BENCH_T0_BIN, BENCH_T0_BIN+config.fBins-1).Data();
+    std::string dataFB = TString::Format("data            %d   %d   %d   %d", BENCH_T0_BIN, BENCH_T0_BIN+config.fBins-1,
+                                         BENCH_T0_BIN, BENCH_T0_BIN+config.fBins-1).Data();
+    std::string bkgFB = TString::Format("background      %d   %d   %d   %d", BENCH_BKG_START, BENCH_BKG_END,
+                                        BENCH_BKG_START, BENCH_BKG_END).Data();
+    std::string fit = TString::Format("fit             0   %g", BENCH_TIME_RANGE).Data();
+    std::string rrf = TString::Format("rrf_freq        %g MHz\nrrf_packing     10\nrrf_phase       0.0\n", BENCH_RRF_FREQ).Data();
+
+    switch (fitType[i].fFitType) {
+      case MSR_FITTYPE_SINGLE_HISTO:
+        run = runHeader + "fittype         0         (single histogram fit)\nnorm            5\nbackgr.fit      6\n"
+              "map             0    0    0    0    0\nforward         1\n" + data +
+              TString::Format("\nt0              %d.0\n", BENCH_T0_BIN).Data() + fit + "\npacking         1";
+        break;
+      case MSR_FITTYPE_SINGLE_HISTO_RRF:
+        global = "fittype         1         (single histogram RRF fit)\n" + rrf + fit;
+        run = runHeader + "map             0    0    0    0    0\nforward         1\n" +
+              TString::Format("background      %d   %d\n", BENCH_BKG_START, BENCH_BKG_END).Data() + data +
+              TString::Format("\nt0              %d.0", BENCH_T0_BIN).Data();
+        break;
+      case MSR_FITTYPE_ASYM:
+        run = runHeader + "fittype         2         (asymmetry fit)\nalpha           7\n"
+              "map             0    0    0    0    0\nforward         1\nbackward        2\n" + bkgFB + "\n" + dataFB +
+              TString::Format("\nt0              %d.0   %d.0\n", BENCH_T0_BIN, BENCH_T0_BIN).Data() + fit + "\npacking         1";
+        break;
+      case MSR_FITTYPE_ASYM_RRF:
+        global = "fittype         3         (asymmetry RRF fit)\n" + rrf + fit;
+        run = runHeader + "alpha           7\nmap             0    0    0    0    0\nforward         1\nbackward        2\n" +
+              bkgFB + "\n" + dataFB + TString::Format("\nt0              %d.0   %d.0", BENCH_T0_BIN, BENCH_T0_BIN).Data();
+        break;
+      case MSR_FITTYPE_MU_MINUS:
+        run = runHeader + "fittype         4         (mu minus fit)\nmap             0    0    0    0    0\nforward         1\n" + data +
+              TString::Format("\nt0              %d.0\n", BENCH_T0_BIN).Data() + fit + "\npacking         1";
+        break;
+      case MSR_FITTYPE_NON_MUSR:
+        run = "RUN " + runName + " BENCH PSI ASCII   (name beamline institute data-file-format)\n"
+              "fittype         8         (non muSR fit)\nmap             0    0    0    0    0\nxy-data         1    2\n" +
+              fit + "\npacking         1";
+        break;
+      default:
+        break;
+    }
+
+    std::vector<PBenchResult> entry(benchName.size());
+    for (UInt_t j=0; j<benchName.size(); j++) {
+      entry[j].fGroup = "fcn";
+      entry[j].fName = fitType[i].fName + "/" + benchName[j];
+      entry[j].fStatus = "ok";
+    }
+    auto failed = [&](const std::string &status, const std::string &note) {
+      for (UInt_t j=0; j<entry.size(); j++) {
+        entry[j].fStatus = status;
+        entry[j].fNote = note;
+        results.push_back(entry[j]);
+      }
+    };
+
+    const std::string fileName = config.fWorkDir + "/fcn_" + fitType[i].fName + ".msr";
+    if (!musrfit_bench_write_msr(fileName, "musrfit_bench: fcn/" + fitType[i].fName, param,
+                                 (fitType[i].fFitType == MSR_FITTYPE_MU_MINUS) ? theoryMuMinus : theory,
+                                 "", global, std::vector<std::string>(1, run), "MINIMIZE")) {
+      failed("failed", "couldn't write " + fileName);
+      continue;
+    }
+
+    PBenchMute mute(config.fVerbose);
+
+    PMsrHandler msrHandler(fileName.c_str());
+    if (msrHandler.ReadMsrFile() != PMUSR_SUCCESS) {
+      failed("failed", "couldn't read " + fileName);
+      continue;
+    }
+
+    TRandom3 rand(config.fSeed);
+    PRawRunData rawData;
+    if (fitType[i].fFitType == MSR_FITTYPE_NON_MUSR)
+      musrfit_bench_raw_data_non_musr(runName, config.fBins, model, rand, rawData);
+    else
+      musrfit_bench_raw_data(runName, 2, config.fBins, model, rand, rawData);
+
+    PRunDataHandler dataHandler(&msrHandler);
+    dataHandler.SetRunData(&rawData, 0);
+
+    PRunListCollection runList(&msrHandler, &dataHandler);
+    if (!runList.Add(0, kFit)) {
+      failed("failed", "couldn't set up the run block");
+      continue;
+    }
+
+    std::vector<Double_t> par(param.size());
+    for (UInt_t j=0; j<param.size(); j++)
+      par[j] = param[j].fValue;
+
+    for (UInt_t j=0; j<entry.size(); j++) {
+      PBenchFcn fcn = (benchName[j] == "chisq") ? fitType[i].fChisq : fitType[i].fMaxLH;
+      if (fcn == nullptr) {
+        entry[j].fStatus = "skipped";
+        entry[j].fNote = "not implemented for this fit type";
+        results.push_back(entry[j]);
+        continue;
+      }
+      auto body = [&]() -> Double_t { return (runList.*fcn)(par); };
+      musrfit_bench_time(config, body, entry[j]);
+      entry[j].fMetric["bins_fitted"] = static_cast<Double_t>(runList.GetTotalNoOfBinsFitted());
+      if (runList.GetTotalNoOfBinsFitted() > 0)
+        entry[j].fMetric["ns_per_bin"] = entry[j].fMetric["median_ns"]/static_cast<Double_t>(runList.GetTotalNoOfBinsFitted());
+      results.push_back(entry[j]);
+    }
+  }
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Macro benchmarks: full global single histogram fits (MIGRAD followed by HESSE) of synthetic
+ * data sets. The precession frequencies, asymmetries and rates are global parameters, N0, background
+ * and phase are run specific, i.e. #param = 3*components + 3*runs. The fits start from slightly
+ * displaced values of the true parameters.
+ *
+ * \param config benchmark settings
+ * \param results benchmark results
+ */
+void musrfit_bench_macro(const PBenchConfig &config, std::vector<PBenchResult> &results)
+{
+  for (UInt_t s=0; s<config.fMacroSize.size(); s++) {
+    const PBenchMacroSize &size = config.fMacroSize[s];
+    const UInt_t noOfParam = 3*size.fComponents + 3*size.fRuns;
+
+    PBenchResult entry;
+    entry.fGroup = "fit";
+    entry.fName = TString::Format("global_single_histo/runs_%d/bins_%d/params_%d", size.fRuns, size.fBins, noOfParam).Data();
+    entry.fStatus = "ok";
+    if (!musrfit_bench_selected(config, entry.fGroup, entry.fName))
+      continue;
+
+    entry.fMetric["runs"] = static_cast<Double_t>(size.fRuns);
+    entry.fMetric["bins"] = static_cast<Double_t>(size.fBins);
+    entry.fMetric["params"] = static_cast<Double_t>(noOfParam);
+
+    // model
+    PBenchModel model = musrfit_bench_model();
+    model.fAsym.clear();
+    model.fFreq.clear();
+    model.fRate.clear();
+    for (UInt_t k=0; k<size.fComponents; k++) {
+      model.fAsym.push_back(0.2/static_cast<Double_t>(k+1));
+      model.fFreq.push_back(12.5+7.5*k);
+      model.fRate.push_back(0.3+0.4*k);
+    }
+
+    // msr-file, start values displaced from the true values
+    std::vector<PBenchParam> param;
+    std::string theory;
+    for (UInt_t k=0; k<size.fComponents; k++) {
+      param.push_back({TString::Format("Asym_%d", k+1).Data(), model.fAsym[k]*1.05, 0.01});
+      param.push_back({TString::Format("Freq_%d", k+1).Data(), model.fFreq[k]*1.0002, 0.001});
+      param.push_back({TString::Format("Rate_%d", k+1).Data(), model.fRate[k]*0.95, 0.01});
+      if (k > 0)
+        theory += "+\n";
+      theory += TString::Format("asymmetry %d\nsimplExpo %d\nTFieldCos map1 %d\n", 3*k+1, 3*k+3, 3*k+2).Data();
+    }
+    std::vector<std::string> run;
+    for (UInt_t r=0; r<size.fRuns; r++) {
+      const UInt_t idx = 3*size.fComponents + 3*r + 1;
+      param.push_back({TString::Format("N0_%d", r+1).Data(), model.fN0*0.98, 1.0});
+      param.push_back({TString::Format("Bkg_%d", r+1).Data(), model.fBkg*1.05, 0.1});
+      param.push_back({TString::Format("Phase_%d", r+1).Data(), model.fPhase+10.0*r+2.0, 1.0});
+      run.push_back(TString::Format("RUN bench_fit_%04d BENCH PSI MUSR-ROOT   (name beamline institute data-file-format)\n"
+                                    "norm            %d\nbackgr.fit      %d\nmap             %d    0    0    0    0\n"
+                                    "forward         1\ndata            %d   %d\nt0              %d.0",
+                                    r, idx, idx+1, idx+2, BENCH_T0_BIN, BENCH_T0_BIN+size.fBins-1, BENCH_T0_BIN).Data());
+    }
+    std::string global = TString::Format("fittype         0         (single histogram fit)\nfit             0   %g\npacking         1",
+                                         BENCH_TIME_RANGE).Data();
+
+    const std::string fileName = config.fWorkDir + TString::Format("/fit_runs_%d_bins_%d_params_%d.msr", size.fRuns, size.fBins, noOfParam).Data();
+    if (!musrfit_bench_write_msr(fileName, "musrfit_bench: " + entry.fName, param, theory, "", global, run, "MIGRAD\nHESSE")) {
+      entry.fStatus = "failed";
+      entry.fNote = "couldn't write " + fileName;
+      results.push_back(entry);
+      continue;
+    }
+
+    PBenchMute mute(config.fVerbose);
+
+    PMsrHandler msrHandler(fileName.c_str());
+    if (msrHandler.ReadMsrFile() != PMUSR_SUCCESS) {
+      entry.fStatus = "failed";
+      entry.fNote = "couldn't read " + fileName;
+      results.push_back(entry);
+      continue;
+    }
+
+    // synthetic data, every run with its own phase and random sequence
+    auto start = std::chrono::steady_clock::now();
+    PRunDataHandler dataHandler(&msrHandler);
+    for (UInt_t r=0; r<size.fRuns; r++) {
+      TRandom3 rand(config.fSeed+r);
+      PBenchModel runModel(model);
+      runModel.fPhase = model.fPhase + 10.0*r;
+      PRawRunData rawData;
+      musrfit_bench_raw_data(TString::Format("bench_fit_%04d", r).Data(), 1, size.fBins, runModel, rand, rawData);
+      dataHandler.SetRunData(&rawData, r);
+    }
+    auto generated = std::chrono::steady_clock::now();
+
+    PRunListCollection runList(&msrHandler, &dataHandler);
+    Bool_t ok = true;
+    for (UInt_t r=0; r<size.fRuns; r++)
+      ok &= runList.Add(r, kFit);
+    auto prepared = std::chrono::steady_clock::now();
+    if (!ok) {
+      entry.fStatus = "failed";
+      entry.fNote = "couldn't set up the run blocks";
+      results.push_back(entry);
+      continue;
+    }
+
+    PFitter fitter(&msrHandler, &runList);
+    if (!fitter.IsValid()) {
+      entry.fStatus = "failed";
+      entry.fNote = "fitter invalid";
+      results.push_back(entry);
+      continue;
+    }
+    fitter.DoFit();
+    auto fitted = std::chrono::steady_clock::now();
+
+    const Double_t fitTime = std::chrono::duration<Double_t>(fitted-prepared).count();
+    const Double_t noOfCalls = static_cast<Double_t>(fitter.GetNoOfFcnCalls());
+    entry.fMetric["data_generation_s"] = std::chrono::duration<Double_t>(generated-start).count();
+    entry.fMetric["prepare_s"] = std::chrono::duration<Double_t>(prepared-generated).count();
+    entry.fMetric["fit_s"] = fitTime;
+    entry.fMetric["fcn_calls"] = noOfCalls;
+    entry.fMetric["bins_fitted"] = static_cast<Double_t>(runList.GetTotalNoOfBinsFitted());
+    if ((noOfCalls > 0) && (runList.GetTotalNoOfBinsFitted() > 0))
+      entry.fMetric["ns_per_fcn_bin"] = fitTime*1.0e9/(noOfCalls*runList.GetTotalNoOfBinsFitted());
+    entry.fMetric["converged"] = fitter.HasConverged() ? 1.0 : 0.0;
+    entry.fMetric["min"] = msrHandler.GetMsrStatistic()->fMin;
+    entry.fMetric["ndf"] = static_cast<Double_t>(msrHandler.GetMsrStatistic()->fNdf);
+    if (!fitter.HasConverged())
+      entry.fNote = "fit did not converge";
+    results.push_back(entry);
+  }
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Escapes a string for JSON.
+ *
+ * \param str string to be escaped
+ */
+std::string musrfit_bench_escape(const std::string &str)
+{
+  std::string result;
+  for (UInt_t i=0; i<str.size(); i++) {
+    switch (str[i]) {
+      case '"':  result += "\\\""; break;
+      case '\\': result += "\\\\"; break;
+      case '\n': result += "\\n"; break;
+      case '\t': result += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(str[i]) < 0x20)
+          result += TString::Format("\\u%04x", static_cast<unsigned char>(str[i])).Data();
+        else
+          result += str[i];
+        break;
+    }
+  }
+  return result;
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Writes the benchmark results as JSON. The layout is stable: the keys of the header and of
+ * every result are always the same and in the same order, the metrics are sorted by name, and
+ * the results are in execution order, which does not depend on the measured values.
+ *
+ * <p><b>return:</b> true on success, false otherwise
+ *
+ * \param config benchmark settings
+ * \param results benchmark results
+ */
+Bool_t musrfit_bench_write_json(const PBenchConfig &config, const std::vector<PBenchResult> &results)
+{
+  std::ofstream fout(config.fJsonFileName.c_str());
+  if (!fout.is_open())
+    return false;
+
+  std::string version("unknown"), branch("unknown"), sha1("unknown"), rootVersion("unknown"), buildType("unknown");
+#ifdef HAVE_CONFIG_H
+  version = PACKAGE_VERSION;
+  rootVersion = ROOT_VERSION_USED;
+  buildType = BUILD_TYPE;
+#endif
+#ifdef HAVE_GIT_REV_H
+  branch = GIT_BRANCH;
+  sha1 = GIT_CURRENT_SHA1;
+#endif
+
+  char host[256];
+  if (gethostname(host, sizeof(host)) != 0)
+    strcpy(host, "unknown");
+  host[sizeof(host)-1] = '\0';
+
+  auto number = [](const Double_t val) -> std::string {
+    if (!std::isfinite(val))
+      return "null";
+    return TString::Format("%.9g", val).Data();
+  };
+
+  fout << "{" << std::endl;
+  fout << "  \"schema\": \"musrfit-bench\"," << std::endl;
+  fout << "  \"schema_version\": " << BENCH_SCHEMA_VERSION << "," << std::endl;
+  fout << "  \"musrfit_version\": \"" << musrfit_bench_escape(version) << "\"," << std::endl;
+  fout << "  \"git_branch\": \"" << musrfit_bench_escape(branch) << "\"," << std::endl;
+  fout << "  \"git_sha1\": \"" << musrfit_bench_escape(sha1) << "\"," << std::endl;
+  fout << "  \"build_type\": \"" << musrfit_bench_escape(buildType) << "\"," << std::endl;
+  fout << "  \"root_version\": \"" << musrfit_bench_escape(rootVersion) << "\"," << std::endl;
+  fout << "  \"host\": \"" << musrfit_bench_escape(host) << "\"," << std::endl;
+  fout << "  \"date\": \"" << TDatime().AsSQLString() << "\"," << std::endl;
+  fout << "  \"config\": {" << std::endl;
+  fout << "    \"threads\": " << config.fThreads << "," << std::endl;
+  fout << "    \"bins\": " << config.fBins << "," << std::endl;
+  fout << "    \"repeats\": " << config.fRepeats << "," << std::endl;
+  fout << "    \"min_time_s\": " << number(config.fMinTime) << "," << std::endl;
+  fout << "    \"seed\": " << config.fSeed << "," << std::endl;
+  fout << "    \"filter\": \"" << musrfit_bench_escape(config.fFilter) << "\"" << std::endl;
+  fout << "  }," << std::endl;
+  fout << "  \"results\": [";
+  for (UInt_t i=0; i<results.size(); i++) {
+    const PBenchResult &res = results[i];
+    fout << ((i == 0) ? "" : ",") << std::endl;
+    fout << "    {\"group\": \"" << musrfit_bench_escape(res.fGroup) << "\", ";
+    fout << "\"name\": \"" << musrfit_bench_escape(res.fName) << "\", ";
+    fout << "\"status\": \"" << musrfit_bench_escape(res.fStatus) << "\", ";
+    fout << "\"note\": \"" << musrfit_bench_escape(res.fNote) << "\", ";
+    fout << "\"metrics\": {";
+    for (std::map<std::string, Double_t>::const_iterator it=res.fMetric.begin(); it!=res.fMetric.end(); ++it) {
+      fout << ((it == res.fMetric.begin()) ? "" : ", ");
+      fout << "\"" << musrfit_bench_escape(it->first) << "\": " << number(it->second);
+    }
+    fout << "}}";
+  }
+  fout << std::endl << "  ]" << std::endl;
+  fout << "}" << std::endl;
+
+  fout.close();
+
+  return true;
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Parses a macro benchmark size of the form <runs>x<bins>x<components>.
+ *
+ * <p><b>return:</b> true on success, false otherwise
+ *
+ * \param str size string
+ * \param size parsed size
+ */
+Bool_t musrfit_bench_parse_size(const char *str, PBenchMacroSize &size)
+{
+  Int_t runs=0, bins=0, comp=0;
+  Char_t rest;
+  if (sscanf(str, "%dx%dx%d%c", &runs, &bins, &comp, &rest) != 3)
+    return false;
+  if ((runs <= 0) || (bins <= 0) || (comp <= 0))
+    return false;
+  size.fRuns = runs;
+  size.fBins = bins;
+  size.fComponents = comp;
+  return true;
+}
+
+//--------------------------------------------------------------------------
+/**
+ * <p>Micro- and macro-benchmarks of the fit engine, written as JSON, see musrfit_bench_syntax().
+ *
+ * \param argc number of command line arguments
+ * \param argv command line arguments
+ */
+int main(int argc, char *argv[])
+{
+  PBenchConfig config;
+  config.fJsonFileName = "musrfit_bench.json";
+  config.fWorkDir = "musrfit_bench_work";
+  config.fFilter = "";
+  config.fMinTime = 0.1;
+  config.fRepeats = 5;
+  config.fBins = 8192;
+  config.fSeed = 12345;
+  config.fThreads = 1;
+  config.fMicro = true;
+  config.fMacro = true;
+  config.fVerbose = false;
+
+#ifdef HAVE_GOMP
+  config.fThreads = omp_get_num_procs();
+#endif
+
+  Bool_t quick = false;
+  Int_t ival;
+  for (Int_t i=1; i<argc; i++) {
+    Bool_t hasArg = (i+1 < argc);
+    if (!strcmp(argv[i], "--help") || !strcmp(argv[i], "-h")) {
+      musrfit_bench_syntax();
+      return PMUSR_SUCCESS;
+    } else if (!strcmp(argv[i], "--json") && hasArg) {
+      config.fJsonFileName = argv[++i];
+    } else if (!strcmp(argv[i], "--work-dir") && hasArg) {
+      config.fWorkDir = argv[++i];
+    } else if (!strcmp(argv[i], "--filter") && hasArg) {
+      config.fFilter = argv[++i];
+    } else if (!strcmp(argv[i], "--bins") && hasArg && (sscanf(argv[i+1], "%d", &ival) == 1) && (ival > 0)) {
+      config.fBins = ival;
+      i++;
+    } else if (!strcmp(argv[i], "--repeats") && hasArg && (sscanf(argv[i+1], "%d", &ival) == 1) && (ival > 0)) {
+      config.fRepeats = ival;
+      i++;
+    } else if (!strcmp(argv[i], "--min-time") && hasArg && (sscanf(argv[i+1], "%lf", &config.fMinTime) == 1) && (config.fMinTime > 0.0)) {
+      i++;
+    } else if (!strcmp(argv[i], "--seed") && hasArg && (sscanf(argv[i+1], "%d", &ival) == 1) && (ival >= 0)) {
+      config.fSeed = ival;
+      i++;
+    } else if (!strcmp(argv[i], "--macro") && hasArg) {
+      PBenchMacroSize size;
+      if (!musrfit_bench_parse_size(argv[i+1], size)) {
+        std::cerr << std::endl << ">> musrfit_bench: **ERROR** invalid macro size '" << argv[i+1] << "', expected <runs>x<bins>x<components>." << std::endl;
+        return PMUSR_WRONG_STARTUP_SYNTAX;
+      }
+      config.fMacroSize.push_back(size);
+      i++;
+    } else if (!strcmp(argv[i], "--no-micro")) {
+      config.fMicro = false;
+    } else if (!strcmp(argv[i], "--no-macro")) {
+      config.fMacro = false;
+    } else if (!strcmp(argv[i], "--quick")) {
+      quick = true;
+    } else if (!strcmp(argv[i], "--verbose")) {
+      config.fVerbose = true;
+    } else if ((!strcmp(argv[i], "-u") || !strcmp(argv[i], "--use-no-of-threads")) && hasArg &&
+               (sscanf(argv[i+1], "%d", &ival) == 1) && (ival > 0)) {
+      config.fThreads = ival;
+      i++;
+    } else {
+      std::cerr << std::endl << ">> musrfit_bench: **ERROR** unknown or incomplete option '" << argv[i] << "'." << std::endl;
+      musrfit_bench_syntax();
+      return PMUSR_WRONG_STARTUP_SYNTAX;
+    }
+  }
+
+  if (quick) {
+    config.fRepeats = 3;
+    config.fMinTime = 0.02;
+  }
+  if (config.fMacroSize.empty()) {
+    std::vector<UInt_t> runs = {1, 4, 16}, bins = {2048, 16384}, comp = {1, 2};
+    if (quick) {
+      runs = {1, 4};
+      bins = {2048};
+      comp = {1};
+    }
+    for (UInt_t c=0; c<comp.size(); c++)
+      for (UInt_t b=0; b<bins.size(); b++)
+        for (UInt_t r=0; r<runs.size(); r++)
+          config.fMacroSize.push_back({runs[r], bins[b], comp[c]});
+  }
+
+#ifdef HAVE_GOMP
+  omp_set_num_threads(config.fThreads);
+  PFFTPlanManager::GetInstance()->SetNumberOfThreads(config.fThreads);
+#else
+  config.fThreads = 1;
+#endif
+
+  if ((mkdir(config.fWorkDir.c_str(), 0755) != 0) && (errno != EEXIST)) {
+    std::cerr << std::endl << ">> musrfit_bench: **ERROR** couldn't create the work directory '" << config.fWorkDir << "'." << std::endl;
+    return PMUSR_MSR_FILE_WRITE_ERROR;
+  }
+
+  std::vector<PBenchResult> results;
+  if (config.fMicro) {
+    std::cout << std::endl << ">> musrfit_bench: theory functions ..." << std::endl;
+    musrfit_bench_theory(config, results);
+    std::cout << ">> musrfit_bench: user functions ..." << std::endl;
+    musrfit_bench_user_fcn(config, results);
+    std::cout << ">> musrfit_bench: FUNCTIONS block ..." << std::endl;
+    musrfit_bench_functions(config, results);
+    std::cout << ">> musrfit_bench: chisq / max. likelihood ..." << std::endl;
+    musrfit_bench_fcn(config, results);
+  }
+  if (config.fMacro) {
+    std::cout << ">> musrfit_bench: fits ..." << std::endl;
+    musrfit_bench_macro(config, results);
+  }
+
+  // short summary
+  std::cout << std::endl;
+  for (UInt_t i=0; i<results.size(); i++) {
+    const PBenchResult &res = results[i];
+    std::cout << TString::Format("%-14s %-52s %-8s", res.fGroup.c_str(), res.fName.c_str(), res.fStatus.c_str()).Data();
+    std::map<std::string, Double_t>::const_iterator it;
+    if ((it = res.fMetric.find("median_ns")) != res.fMetric.end())
+      std::cout << TString::Format(" %14.1f ns", it->second).Data();
+    else if ((it = res.fMetric.find("fit_s")) != res.fMetric.end())
+      std::cout << TString::Format(" %14.3f s ", it->second).Data();
+    if (!res.fNote.empty())
+      std::cout << "  (" << res.fNote << ")";
+    std::cout << std::endl;
+  }
+
+  if (!musrfit_bench_write_json(config, results)) {
+    std::cerr << std::endl << ">> musrfit_bench: **ERROR** couldn't write " << config.fJsonFileName << std::endl;
+    return PMUSR_MSR_FILE_WRITE_ERROR;
+  }
+  std::cout << std::endl << ">> musrfit_bench: results written to " << config.fJsonFileName << std::endl << std::endl;
+
+  return PMUSR_SUCCESS;
+}
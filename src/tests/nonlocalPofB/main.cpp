@@ -0,0 +1,105 @@
+/***************************************************************************
+
+  main.cpp
+
+  Author: Andreas Suter
+  e-mail: andreas.suter@psi.ch
+
+***************************************************************************/
+
+/***************************************************************************
+ *   Copyright (C) 2007-2023 by Andreas Suter                              *
+ *   andreas.suter@psi.ch                                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include "PNL_PippardFitter.h"
+
+//-----------------------------------------------------------------------------
+/**
+ * <p>Compares the P(B) based polarization of PNL_PippardFitter with the
+ * depth integrated one. See README.
+ */
+int main(int argc, char *argv[])
+{
+  double tol = 1.0e-3;
+  if (argc == 2)
+    tol = atof(argv[1]);
+
+  PNL_PippardFitter fitter;
+  std::vector<void*> globalPart;
+  fitter.SetGlobalPart(globalPart, 0);
+  if (!fitter.GlobalPartIsValid()) {
+    std::cout << std::endl << "**ERROR** couldn't initialize PNL_PippardFitter. Is nonlocal_startup.xml present?" << std::endl << std::endl;
+    return 2;
+  }
+  PNL_PippardFitterGlobal *global = (PNL_PippardFitterGlobal*)globalPart[0];
+
+  // param: [0] energy, [1] temp, [2] thickness, [3] meanFreePath, [4] xi0, [5] lambdaL, [6] Bext, [7] phase, [8] dead-layer
+  std::vector<std::vector<double>> paramList = {
+    {2000.0,  0.30, 5000.0, 300.0, 90.0, 35.0, 100.0,   5.0, 0.0},
+    {6000.0,  0.30, 5000.0, 300.0, 90.0, 35.0, 100.0,   5.0, 2.0},
+    {10000.0, 0.80, 5000.0, 300.0, 90.0, 35.0,  10.0, -10.0, 2.0},
+    {16000.0, 0.50,  150.0,  50.0, 40.0, 50.0, 250.0,   0.0, 1.0},
+    {22000.0, 0.50,  150.0,  50.0, 40.0, 50.0, 1000.0, 20.0, 5.0},
+    {10000.0, 0.30, 5000.0, 300.0, 90.0, 35.0, 100.0,   5.0, 2.0, 2.0}
+  };
+
+  const double tStart = 0.01, tEnd = 12.0, tStep = 0.0097;
+  bool ok = true;
+  std::vector<double> polDepth;
+  clock_t clkDepth, clkPofB;
+  for (unsigned int i=0; i<paramList.size(); i++) {
+    polDepth.clear();
+
+    // depth integration
+    global->SetPofBMode(false);
+    clkDepth = clock();
+    for (double t=tStart; t<tEnd; t+=tStep)
+      polDepth.push_back(fitter(t, paramList[i]));
+    clkDepth = clock() - clkDepth;
+
+    // via P(B)
+    global->SetPofBMode(true);
+    double diff, maxDiff = 0.0;
+    unsigned int j = 0;
+    clkPofB = clock();
+    for (double t=tStart; t<tEnd; t+=tStep, j++) {
+      diff = fabs(fitter(t, paramList[i])-polDepth[j]);
+      if (diff > maxDiff)
+        maxDiff = diff;
+    }
+    clkPofB = clock() - clkPofB;
+
+    std::cout << "param set " << i << ": E=" << paramList[i][0] << " (eV), Bext=" << paramList[i][6] << " (G)";
+    std::cout << ", max |P_pofb(t)-P_depth(t)| = " << maxDiff;
+    std::cout << ", cpu time depth/pofb = " << (double)clkDepth/CLOCKS_PER_SEC << "/" << (double)clkPofB/CLOCKS_PER_SEC << " (s)";
+    if (maxDiff > tol) {
+      std::cout << " **FAILED**";
+      ok = false;
+    }
+    std::cout << std::endl;
+  }
+
+  return ok ? 0 : 1;
+}
@@ -158,7 +158,7 @@ int main(int argc, char* argv[])
   if (dump) {
     std::cout << std::endl;
     std::cout << "RGE info from xml-startup-file " << fln << std::endl;
-    PRgeDataList list = rgeHandler->GetRgeData();
+    const PRgeDataList &list = rgeHandler->GetRgeData();
     std::cout << "number of rge data sets: " << list.size() << std::endl;
     for (int i=0; i<list.size(); i++) {
       std::cout << "rge set #" << i+1 << ": energy: " << list[i].energy << " (eV), no of particles: " << list[i].noOfParticles << std::endl;
@@ -166,7 +166,7 @@ int main(int argc, char* argv[])
     std::cout << std::endl;
   }
   if ((set_no != -1) && !cumFreq) { // dump rge-set
-    PRgeDataList list = rgeHandler->GetRgeData();
+    const PRgeDataList &list = rgeHandler->GetRgeData();
     if (set_no > list.size()) {
       std::cout << std::endl;
       std::cout << "**ERROR** requested set number " << set_no << " > number of rge-data sets (" << list.size() << ")." << std::endl;
@@ -187,7 +187,7 @@ int main(int argc, char* argv[])
     }
   }
   if ((set_no != -1) && cumFreq) { // dump cumulative frequency of rge-set
-      PRgeDataList list = rgeHandler->GetRgeData();
+      const PRgeDataList &list = rgeHandler->GetRgeData();
       if (set_no > list.size()) {
         std::cout << std::endl;
         std::cout << "**ERROR** requested set number " << set_no << " > number of rge-data sets (" << list.size() << ")." << std::endl;